@@ -0,0 +1,55 @@
+// ClusteredLights.hlsl - per-cluster light lists built by ClusteredLightGrid on the CPU
+// and bound by LightingSystem::BindLightClusters (t18-t20, b6).
+#ifndef CLUSTERED_LIGHTS_H
+#define CLUSTERED_LIGHTS_H
+
+// Mirrors LightData in LightingSystem.h
+struct ClusteredLight
+{
+    float4 Position;            // xyz: world position, w: light type
+    float4 Direction;           // xyz: direction, w: spot angle (radians)
+    float4 Color;               // rgb: color, a: intensity
+    float4 Attenuation;         // constant, linear, quadratic, range
+    float4 ShadowParams;        // enabled, bias, first shadow atlas face (-1 without tiles), face count (see ShadowAtlas.hlsl)
+    row_major float4x4 LightMatrix;
+    row_major float4x4 ShadowMatrix;
+};
+
+StructuredBuffer<ClusteredLight> ClusterLights : register(t18);
+StructuredBuffer<uint2> ClusterRanges          : register(t19);   // x: first index, y: count
+StructuredBuffer<uint> ClusterLightIndices     : register(t20);
+
+// Mirrors ClusterShaderConstants in ClusteredLightGrid.h
+cbuffer ClusterConstants : register(b6)
+{
+    uint ClusterTilesX;
+    uint ClusterTilesY;
+    uint ClusterSlices;
+    uint ClusterLightCount;
+    float2 ClusterProjScale;
+    float2 ClusterProjOffset;
+    float ClusterNear;
+    float ClusterFar;
+    float ClusterSliceScale;
+    float ClusterSliceBias;
+};
+
+// Same mapping as ClusteredLightGrid::GetClusterIndex
+uint GetClusterIndex(float3 viewPos)
+{
+    float z = max(viewPos.z, ClusterNear);
+    float2 ndc = viewPos.xy * ClusterProjScale / z + ClusterProjOffset;
+    uint tileX = (uint)clamp(floor((ndc.x * 0.5 + 0.5) * ClusterTilesX), 0.0, ClusterTilesX - 1.0);
+    uint tileY = (uint)clamp(floor((0.5 - ndc.y * 0.5) * ClusterTilesY), 0.0, ClusterTilesY - 1.0);
+    uint slice = (uint)clamp(floor(log(z) * ClusterSliceScale + ClusterSliceBias), 0.0, ClusterSlices - 1.0);
+    return (slice * ClusterTilesY + tileY) * ClusterTilesX + tileX;
+}
+
+// Usage:
+//   uint2 range = ClusterRanges[GetClusterIndex(viewPos)];
+//   for (uint i = 0; i < range.y; ++i) {
+//       ClusteredLight light = ClusterLights[ClusterLightIndices[range.x + i]];
+//       ...
+//   }
+
+#endif
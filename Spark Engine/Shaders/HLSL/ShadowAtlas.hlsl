@@ -0,0 +1,48 @@
+// ShadowAtlas.hlsl - shadow tiles of point, spot and area lights, assigned by ShadowAtlas on the CPU
+// and bound by LightingSystem (t21 faces, t22 depth).
+#ifndef SHADOW_ATLAS_H
+#define SHADOW_ATLAS_H
+
+// Mirrors ShadowAtlasFace in LightingSystem.h
+struct ShadowAtlasFace
+{
+    row_major float4x4 ViewProjection;
+    float4 Rect;                // xy: atlas UV offset, zw: tile UV size
+};
+
+StructuredBuffer<ShadowAtlasFace> ShadowAtlasFaces : register(t21);
+Texture2D<float> ShadowAtlasDepth                  : register(t22);
+
+// Cube face of a direction from a point light, in ShadowAtlas::GetFaceView order (+X, -X, +Y, -Y, +Z, -Z)
+uint GetShadowCubeFace(float3 direction)
+{
+    float3 a = abs(direction);
+    if (a.x >= a.y && a.x >= a.z) return direction.x >= 0.0 ? 0 : 1;
+    if (a.y >= a.z) return direction.y >= 0.0 ? 2 : 3;
+    return direction.z >= 0.0 ? 4 : 5;
+}
+
+// 1 when lit, 0 when shadowed. shadowParams is the light's ShadowParams: y bias, z first face (-1 without
+// tiles), w face count (6 for point lights)
+float SampleShadowAtlas(float4 shadowParams, float3 lightPos, float3 worldPos, SamplerComparisonState shadowSampler)
+{
+    if (shadowParams.x == 0.0 || shadowParams.z < 0.0) return 1.0;
+
+    uint face = (uint)shadowParams.z;
+    if (shadowParams.w > 1.0) face += GetShadowCubeFace(worldPos - lightPos);
+    ShadowAtlasFace atlasFace = ShadowAtlasFaces[face];
+
+    float4 clip = mul(float4(worldPos, 1.0), atlasFace.ViewProjection);
+    float3 ndc = clip.xyz / clip.w;
+    if (any(abs(ndc.xy) > 1.0) || ndc.z > 1.0) return 1.0;
+
+    // Stay half a texel inside the tile so filtering never reads a neighbour
+    float2 tileUV = ndc.xy * float2(0.5, -0.5) + 0.5;
+    uint width, height;
+    ShadowAtlasDepth.GetDimensions(width, height);
+    float2 halfTexel = 0.5 / float2(width, height);
+    float2 uv = atlasFace.Rect.xy + clamp(tileUV * atlasFace.Rect.zw, halfTexel, atlasFace.Rect.zw - halfTexel);
+    return ShadowAtlasDepth.SampleCmpLevelZero(shadowSampler, uv, ndc.z - shadowParams.y);
+}
+
+#endif
@@ -74,6 +74,15 @@ void SparkEngineCamera::UpdateViewMatrix() {
     m_viewMatrix = XMMatrixLookAtLH(pos, pos + fb, ub);
 }
 
+XMMATRIX SparkEngineCamera::GetViewMatrixAt(const XMFLOAT3& eye) const {
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    XMMATRIX rot = XMMatrixRotationRollPitchYaw(m_pitch, m_yaw, m_roll);
+    XMVECTOR fb = XMVector3TransformCoord(XMVectorSet(0, 0, 1, 0), rot);
+    XMVECTOR ub = XMVector3TransformCoord(XMVectorSet(0, 1, 0, 0), rot);
+    XMVECTOR pos = XMLoadFloat3(&eye);
+    return XMMatrixLookAtLH(pos, pos + fb, ub);
+}
+
 void SparkEngineCamera::UpdateProjectionMatrix() {
     // **NEW: Separate projection matrix update method**
     m_projectionMatrix = XMMatrixPerspectiveFovLH(m_defaultFov, m_aspectRatio, m_nearPlane, m_farPlane);
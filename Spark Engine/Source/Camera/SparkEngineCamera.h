@@ -205,6 +205,13 @@ public:
      */
     const XMMATRIX& GetViewMatrix()       const { return m_viewMatrix; }
 
+    /**
+     * @brief Build a view matrix for the current orientation from another eye position
+     * @param eye World-space eye position (e.g. interpolated between simulation ticks)
+     * @return 4x4 view matrix for rendering transformations
+     */
+    XMMATRIX GetViewMatrixAt(const XMFLOAT3& eye) const;
+
     /**
      * @brief Get the current projection transformation matrix
      * @return 4x4 projection matrix for rendering transformations
@@ -174,6 +174,104 @@ void RegisterAdvancedCommands(Game* game, GraphicsEngine* graphics)
         return "Physics system not available";
     }, "Set gravity");
 
+    console.RegisterCommand("physics_bench", [graphics](const std::vector<std::string>& args) -> std::string {
+        int bodies = 20000, queries = 10000;
+        try {
+            if (args.size() >= 1) bodies = std::stoi(args[0]);
+            if (args.size() >= 2) queries = std::stoi(args[1]);
+        } catch (...) {
+            return "Usage: physics_bench [colliders] [queries]";
+        }
+        if (auto physicsSystem = graphics->GetPhysicsSystem()) {
+            return physicsSystem->Console_BenchmarkQueries(bodies, queries);
+        }
+        return "Physics system not available";
+    }, "Benchmark broadphase queries (physics_bench [colliders] [queries])");
+
+    console.RegisterCommand("physics_sim_bench", [graphics](const std::vector<std::string>& args) -> std::string {
+        int stackHeight = 10, pileBodies = 256, steps = 600;
+        try {
+            if (args.size() >= 1) stackHeight = std::stoi(args[0]);
+            if (args.size() >= 2) pileBodies = std::stoi(args[1]);
+            if (args.size() >= 3) steps = std::stoi(args[2]);
+        } catch (...) {
+            return "Usage: physics_sim_bench [stackHeight] [pileBodies] [steps]";
+        }
+        if (auto physicsSystem = graphics->GetPhysicsSystem()) {
+            return physicsSystem->Console_BenchmarkSimulation(stackHeight, pileBodies, steps);
+        }
+        return "Physics system not available";
+    }, "Benchmark the rigid-body solver (physics_sim_bench [stackHeight] [pileBodies] [steps])");
+
+    console.RegisterCommand("physics_mt_bench", [graphics](const std::vector<std::string>& args) -> std::string {
+        int pileBodies = 2048, steps = 300;
+        try {
+            if (args.size() >= 1) pileBodies = std::stoi(args[0]);
+            if (args.size() >= 2) steps = std::stoi(args[1]);
+        } catch (...) {
+            return "Usage: physics_mt_bench [pileBodies] [steps]";
+        }
+        if (auto physicsSystem = graphics->GetPhysicsSystem()) {
+            return physicsSystem->Console_BenchmarkThreadScaling(pileBodies, steps);
+        }
+        return "Physics system not available";
+    }, "Benchmark solver scaling at 1-16 threads, up to the job system's thread count (physics_mt_bench [pileBodies] [steps])");
+
+    console.RegisterCommand("physics_threads", [graphics](const std::vector<std::string>& args) -> std::string {
+        auto physicsSystem = graphics->GetPhysicsSystem();
+        if (!physicsSystem) return "Physics system not available";
+        if (args.size() >= 1) {
+            try {
+                physicsSystem->SetWorkerThreadCount(std::stoi(args[0]));
+            } catch (...) {
+                return "Usage: physics_threads [count]";
+            }
+        }
+        return "Physics solver threads: " + std::to_string(physicsSystem->GetWorkerThreadCount());
+    }, "Get or set the physics solver thread count (physics_threads [count])");
+
+    console.RegisterCommand("physics_contact_bench", [graphics](const std::vector<std::string>& args) -> std::string {
+        int stackHeight = 10, steps = 600;
+        try {
+            if (args.size() >= 1) stackHeight = std::stoi(args[0]);
+            if (args.size() >= 2) steps = std::stoi(args[1]);
+        } catch (...) {
+            return "Usage: physics_contact_bench [stackHeight] [steps]";
+        }
+        if (auto physicsSystem = graphics->GetPhysicsSystem()) {
+            return physicsSystem->Console_BenchmarkContactCache(stackHeight, steps);
+        }
+        return "Physics system not available";
+    }, "Compare stack convergence with and without the contact cache (physics_contact_bench [stackHeight] [steps])");
+
+    console.RegisterCommand("physics_sweep_bench", [graphics](const std::vector<std::string>& args) -> std::string {
+        int sweeps = 4096, targets = 256;
+        try {
+            if (args.size() >= 1) sweeps = std::stoi(args[0]);
+            if (args.size() >= 2) targets = std::stoi(args[1]);
+        } catch (...) {
+            return "Usage: physics_sweep_bench [sweeps] [targets]";
+        }
+        if (auto physicsSystem = graphics->GetPhysicsSystem()) {
+            return physicsSystem->Console_BenchmarkSweeps(sweeps, targets);
+        }
+        return "Physics system not available";
+    }, "Projectile tunnelling check and batched sweep benchmark (physics_sweep_bench [sweeps] [targets])");
+
+    console.RegisterCommand("physics_bvh_bench", [graphics](const std::vector<std::string>& args) -> std::string {
+        int rays = 100000;
+        try {
+            if (args.size() >= 1) rays = std::stoi(args[0]);
+        } catch (...) {
+            return "Usage: physics_bvh_bench [rays] [directory]";
+        }
+        std::string directory = (args.size() >= 2) ? args[1] : std::string();
+        if (auto physicsSystem = graphics->GetPhysicsSystem()) {
+            return physicsSystem->Console_BenchmarkMeshRaycast(rays, directory);
+        }
+        return "Physics system not available";
+    }, "Benchmark mesh BVH ray casts on Assets/Models OBJs (physics_bvh_bench [rays] [directory])");
+
     // ========================================================================
     // UNIFIED GRAPHICS ENGINE COMMANDS
     // ========================================================================
@@ -0,0 +1,520 @@
+/**
+ * @file JobSystem.cpp
+ * @brief Implementation of the work-stealing job scheduler
+ * @author Spark Engine Team
+ * @date 2025
+ */
+
+#include "JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <sstream>
+
+namespace
+{
+    // How long an idle worker keeps looking for work before it blocks. Covers
+    // the gap between two fan-outs of the same frame without burning a core
+    // for the rest of it.
+    constexpr auto SpinDuration = std::chrono::microseconds(50);
+
+    // Registration of the calling thread: the system it works for and its slot
+    thread_local const JobSystem* t_system = nullptr;
+    thread_local int t_worker = -1;
+    thread_local uint32_t t_random = 0x9E3779B9u;
+
+    uint32_t NextRandom()
+    {
+        // xorshift32: only used to spread thieves over victims
+        uint32_t x = t_random;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        return t_random = x;
+    }
+}
+
+// ============================================================================
+// CHASE-LEV DEQUE
+// ============================================================================
+
+/**
+ * @brief Fixed-capacity Chase-Lev work-stealing deque
+ *
+ * The owning worker pushes and pops at the bottom; any thread may steal from
+ * the top. Only the last element is contended, and only then does the owner
+ * pay for a compare-and-swap. Full deques refuse the push and the submitter
+ * runs the job itself, so the ring never has to grow.
+ */
+class JobSystem::WorkStealingDeque
+{
+public:
+    bool Push(Job* job)
+    {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        const int64_t top = m_top.load(std::memory_order_acquire);
+        if (bottom - top >= static_cast<int64_t>(DequeCapacity)) return false;
+
+        m_buffer[bottom & Mask].store(job, std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    Job* Pop()
+    {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        m_bottom.store(bottom, std::memory_order_seq_cst);
+        int64_t top = m_top.load(std::memory_order_seq_cst);
+
+        if (top > bottom) {
+            m_bottom.store(bottom + 1, std::memory_order_release);
+            return nullptr;
+        }
+
+        Job* job = m_buffer[bottom & Mask].load(std::memory_order_relaxed);
+        if (top == bottom) {
+            // Last element: race the thieves for it
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                job = nullptr;
+            m_bottom.store(bottom + 1, std::memory_order_release);
+        }
+        return job;
+    }
+
+    Job* Steal()
+    {
+        int64_t top = m_top.load(std::memory_order_seq_cst);
+        const int64_t bottom = m_bottom.load(std::memory_order_seq_cst);
+        if (top >= bottom) return nullptr;
+
+        Job* job = m_buffer[top & Mask].load(std::memory_order_relaxed);
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;   // Lost to the owner or another thief
+        return job;
+    }
+
+private:
+    static constexpr int64_t Mask = DequeCapacity - 1;
+    static_assert((DequeCapacity & (DequeCapacity - 1)) == 0, "Deque capacity must be a power of two");
+
+    alignas(64) std::atomic<int64_t> m_top{ 0 };
+    alignas(64) std::atomic<int64_t> m_bottom{ 0 };
+    std::atomic<Job*> m_buffer[DequeCapacity] = {};
+};
+
+struct alignas(64) JobSystem::Worker
+{
+    WorkStealingDeque deques[JobPriorityCount];
+
+    // Written by the thread in this slot only; read by GetStats()
+    std::atomic<uint64_t> executed{ 0 };
+    std::atomic<uint64_t> stolen{ 0 };
+    std::atomic<uint64_t> inlined{ 0 };
+    std::atomic<uint64_t> sleeps{ 0 };
+};
+
+// ============================================================================
+// LIFETIME
+// ============================================================================
+
+JobSystem& JobSystem::GetInstance()
+{
+    // At least one worker, so Low jobs make progress while the main thread is
+    // busy. Never destroyed: subsystems owned by globals (g_graphics) still
+    // wait for their jobs from their destructors during static destruction.
+    static JobSystem* instance = new JobSystem(std::max(2, static_cast<int>(std::thread::hardware_concurrency())));
+    return *instance;
+}
+
+JobSystem::JobSystem(int threadCount)
+{
+    if (threadCount <= 0) threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    m_threadCount = std::clamp(threadCount, 1, MaxThreads);
+    m_workers = std::make_unique<Worker[]>(m_threadCount);
+
+    // The creating thread becomes slot 0; restored in the destructor so nested
+    // systems (the benchmark's) do not steal the main thread's registration
+    m_previousSystem = t_system;
+    m_previousWorker = t_worker;
+    t_system = this;
+    t_worker = 0;
+
+    m_threads.reserve(m_threadCount - 1);
+    for (int worker = 1; worker < m_threadCount; ++worker)
+        m_threads.emplace_back(&JobSystem::WorkerMain, this, worker);
+}
+
+JobSystem::~JobSystem()
+{
+    Shutdown();
+
+    if (t_system == this) {
+        t_system = m_previousSystem;
+        t_worker = m_previousWorker;
+    }
+}
+
+void JobSystem::Shutdown()
+{
+    if (m_shutdown.exchange(true)) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_wakeEpoch.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_wake.notify_all();
+
+    for (auto& thread : m_threads) {
+        if (thread.joinable()) thread.join();
+    }
+    m_threads.clear();
+
+    // Finish whatever was still queued so every counter reaches zero
+    while (Job* job = FindJob(-1, JobPriority::Low))
+        Execute(job);
+}
+
+// ============================================================================
+// SUBMISSION
+// ============================================================================
+
+Job* JobSystem::AllocateJob()
+{
+    if (Job* job = m_jobPool.Acquire()) {
+        job->m_pooled = true;
+        return job;
+    }
+
+    // More jobs in flight than the pool holds: fall back to the heap
+    m_heapJobs.fetch_add(1, std::memory_order_relaxed);
+    Job* job = new Job();
+    job->m_pooled = false;
+    return job;
+}
+
+void JobSystem::Submit(Job* job)
+{
+    if (m_shutdown.load(std::memory_order_acquire)) {
+        Execute(job);
+        return;
+    }
+
+    const size_t priority = static_cast<size_t>(job->m_priority);
+    const int worker = GetCurrentWorker();
+    if (worker >= 0) {
+        if (!m_workers[worker].deques[priority].Push(job)) {
+            m_workers[worker].inlined.fetch_add(1, std::memory_order_relaxed);
+            Execute(job);
+            return;
+        }
+    }
+    else {
+        {
+            std::lock_guard<std::mutex> lock(m_injectionMutex);
+            m_injected[priority].push_back(job);
+        }
+        m_injectedCount.fetch_add(1, std::memory_order_seq_cst);
+        m_injectedTotal.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    WakeWorker();
+}
+
+void JobSystem::WakeWorker()
+{
+    // Pairs with the sleeper registration in WorkerMain(): either this load
+    // sees the sleeper or the sleeper's last FindJob() sees the new job
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleepers.load(std::memory_order_seq_cst) == 0) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_wakeEpoch.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_wake.notify_one();
+}
+
+// ============================================================================
+// EXECUTION
+// ============================================================================
+
+void JobSystem::Execute(Job* job)
+{
+    job->m_invoke(*job);
+    job->m_destroy(*job);
+
+    JobCounter* counter = job->m_counter;
+    if (job->m_pooled) m_jobPool.Release(job);
+    else delete job;
+
+    const int worker = GetCurrentWorker();
+    if (worker >= 0) m_workers[worker].executed.fetch_add(1, std::memory_order_relaxed);
+
+    if (counter) FinishCounter(counter);
+}
+
+void JobSystem::FinishCounter(JobCounter* counter)
+{
+    int value = counter->m_value.load(std::memory_order_relaxed);
+    while (value > 1) {
+        if (counter->m_value.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+            return;
+    }
+
+    // Last job out: reach zero under the lock, so RunAfter() and ~JobCounter()
+    // cannot observe zero while the deferred jobs are still being collected
+    std::vector<Job*> released;
+    {
+        std::lock_guard<std::mutex> lock(counter->m_waitersMutex);
+        if (counter->m_value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            released.swap(counter->m_waiters);
+    }
+
+    for (Job* job : released)
+        Submit(job);
+}
+
+void JobSystem::Wait(const JobCounter& counter)
+{
+    const int worker = GetCurrentWorker();
+
+    // Waiting threads only help with frame work; background jobs are left to
+    // the workers unless there are none
+    const JobPriority lowest = m_threadCount > 1 ? JobPriority::Normal : JobPriority::Low;
+
+    while (!counter.IsDone()) {
+        if (Job* job = FindJob(worker, lowest)) {
+            Execute(job);
+            continue;
+        }
+        std::this_thread::yield();
+    }
+}
+
+Job* JobSystem::FindJob(int worker, JobPriority lowest)
+{
+    const size_t last = static_cast<size_t>(lowest);
+    for (size_t priority = 0; priority <= last; ++priority)
+    {
+        if (worker >= 0) {
+            if (Job* job = m_workers[worker].deques[priority].Pop())
+                return job;
+        }
+
+        if (m_injectedCount.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard<std::mutex> lock(m_injectionMutex);
+            if (!m_injected[priority].empty()) {
+                Job* job = m_injected[priority].front();
+                m_injected[priority].pop_front();
+                m_injectedCount.fetch_sub(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+
+        const int start = static_cast<int>(NextRandom() % static_cast<uint32_t>(m_threadCount));
+        for (int i = 0; i < m_threadCount; ++i)
+        {
+            const int victim = (start + i) % m_threadCount;
+            if (victim == worker) continue;
+            if (Job* job = m_workers[victim].deques[priority].Steal()) {
+                if (worker >= 0) m_workers[worker].stolen.fetch_add(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::WorkerMain(int worker)
+{
+    t_system = this;
+    t_worker = worker;
+    t_random = 0x9E3779B9u * static_cast<uint32_t>(worker + 1);
+
+    auto idleSince = std::chrono::steady_clock::now();
+    bool idle = false;
+
+    while (!m_shutdown.load(std::memory_order_acquire))
+    {
+        if (Job* job = FindJob(worker, JobPriority::Low)) {
+            Execute(job);
+            idle = false;
+            continue;
+        }
+
+        if (!idle) {
+            idle = true;
+            idleSince = std::chrono::steady_clock::now();
+        }
+        if (std::chrono::steady_clock::now() - idleSince < SpinDuration) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Register as a sleeper, then look once more before blocking
+        m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+        const uint64_t epoch = m_wakeEpoch.load(std::memory_order_seq_cst);
+        if (Job* job = FindJob(worker, JobPriority::Low)) {
+            m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+            Execute(job);
+            idle = false;
+            continue;
+        }
+
+        m_workers[worker].sleeps.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_wake.wait(lock, [&] {
+                return m_wakeEpoch.load(std::memory_order_relaxed) != epoch || m_shutdown.load(std::memory_order_relaxed);
+            });
+        }
+        m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+        idle = false;
+    }
+}
+
+int JobSystem::GetCurrentWorker() const
+{
+    return t_system == this ? t_worker : -1;
+}
+
+// ============================================================================
+// STATISTICS
+// ============================================================================
+
+JobSystemStats JobSystem::GetStats() const
+{
+    JobSystemStats stats;
+    for (int worker = 0; worker < m_threadCount; ++worker)
+    {
+        stats.executed += m_workers[worker].executed.load(std::memory_order_relaxed);
+        stats.stolen += m_workers[worker].stolen.load(std::memory_order_relaxed);
+        stats.inlined += m_workers[worker].inlined.load(std::memory_order_relaxed);
+        stats.sleeps += m_workers[worker].sleeps.load(std::memory_order_relaxed);
+    }
+    stats.injected = m_injectedTotal.load(std::memory_order_relaxed);
+    stats.heapJobs = m_heapJobs.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::string JobSystem::Console_GetStats() const
+{
+    const JobSystemStats stats = GetStats();
+
+    std::stringstream ss;
+    ss << "=== Job System ===\n";
+    ss << "Threads: " << m_threadCount << " (" << m_threadCount - 1 << " worker threads + creating thread)\n";
+    ss << "Executed on scheduler threads: " << stats.executed << ", stolen: " << stats.stolen << "\n";
+    ss << "Injected from other threads: " << stats.injected << "\n";
+    ss << "Run inline (deque full): " << stats.inlined << ", heap jobs (pool empty): " << stats.heapJobs << "\n";
+    ss << "Worker sleeps: " << stats.sleeps << "\n";
+    ss << "Job pool: " << m_jobPool.GetUsedCount() << " in use / " << m_jobPool.GetMaxSize() << "\n";
+    return ss.str();
+}
+
+// ============================================================================
+// BENCHMARK
+// ============================================================================
+
+namespace
+{
+    /// Binary fork-join tree: every node spawns one child, runs the other itself and waits
+    void ForkJoin(JobSystem& jobs, int depth, std::atomic<uint64_t>& leaves)
+    {
+        if (depth == 0) {
+            leaves.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        JobCounter counter;
+        jobs.Run([&jobs, depth, &leaves]() { ForkJoin(jobs, depth - 1, leaves); }, &counter, JobPriority::High);
+        ForkJoin(jobs, depth - 1, leaves);
+        jobs.Wait(counter);
+    }
+}
+
+std::string JobSystem::Console_Benchmark(int threadCount)
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto ns = [](auto a, auto b) { return std::chrono::duration<double, std::nano>(b - a).count(); };
+
+    threadCount = std::clamp(threadCount, 1, MaxThreads);
+    JobSystem jobs(threadCount);
+
+    std::stringstream ss;
+    ss << "=== Job System Benchmark ===\n";
+    ss << "Threads: " << threadCount << " (hardware: " << std::thread::hardware_concurrency() << ")\n";
+
+    // Spawn overhead: empty jobs submitted in batches from slot 0, which then
+    // helps to drain them
+    {
+        constexpr int Batch = 1024;
+        constexpr int Batches = 100;
+        JobCounter counter;
+        double spawnNs = 0.0, totalNs = 0.0;
+        for (int batch = 0; batch < Batches; ++batch)
+        {
+            auto start = Clock::now();
+            for (int i = 0; i < Batch; ++i)
+                jobs.Run([]() {}, &counter, JobPriority::High);
+            auto spawned = Clock::now();
+            jobs.Wait(counter);
+            auto done = Clock::now();
+            spawnNs += ns(start, spawned);
+            totalNs += ns(start, done);
+        }
+        const double count = static_cast<double>(Batch) * Batches;
+        ss << "Spawn:     " << spawnNs / count << " ns/job to submit, " << totalNs / count
+           << " ns/job submit + run (" << Batches << " batches of " << Batch << ")\n";
+    }
+
+    // Steal latency: slot 0 pushes one job and spins without helping, so the
+    // job only runs once a worker steals it
+    if (threadCount > 1)
+    {
+        constexpr int Samples = 2000;
+        std::vector<double> latencies;
+        latencies.reserve(Samples);
+        JobCounter counter;
+        for (int sample = 0; sample < Samples; ++sample)
+        {
+            Clock::time_point started;
+            const auto submitted = Clock::now();
+            jobs.Run([&started]() { started = Clock::now(); }, &counter, JobPriority::High);
+            while (!counter.IsDone())
+                std::this_thread::yield();
+            latencies.push_back(ns(submitted, started));
+        }
+        std::sort(latencies.begin(), latencies.end());
+        double sum = 0.0;
+        for (double latency : latencies) sum += latency;
+        ss << "Steal:     median " << latencies[latencies.size() / 2] << " ns, p99 "
+           << latencies[latencies.size() * 99 / 100] << " ns, mean " << sum / latencies.size()
+           << " ns (push to start on a thief)\n";
+    }
+    else
+    {
+        ss << "Steal:     n/a with one thread\n";
+    }
+
+    // Fork-join depth: full binary trees, every inner node one spawn + one wait
+    ss << "Fork-join:\n";
+    for (int depth : { 4, 8, 12, 16 })
+    {
+        std::atomic<uint64_t> leaves{ 0 };
+        auto start = Clock::now();
+        ForkJoin(jobs, depth, leaves);
+        auto end = Clock::now();
+
+        const uint64_t expected = 1ull << depth;
+        const double forks = static_cast<double>(expected - 1);
+        ss << "  depth " << depth << ": " << ns(start, end) / 1e6 << " ms, " << ns(start, end) / forks
+           << " ns/fork (" << leaves.load() << "/" << expected << " leaves"
+           << (leaves.load() == expected ? "" : " MISMATCH") << ")\n";
+    }
+
+    const JobSystemStats stats = jobs.GetStats();
+    ss << "Stolen: " << stats.stolen << ", run inline: " << stats.inlined << ", heap jobs: " << stats.heapJobs
+       << ", worker sleeps: " << stats.sleeps << "\n";
+    return ss.str();
+}
@@ -0,0 +1,333 @@
+/**
+ * @file JobSystem.h
+ * @brief Work-stealing job scheduler shared by every engine subsystem
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * Each worker owns one Chase-Lev deque per priority: it pushes and pops jobs
+ * at the bottom without locks while idle workers steal from the top. Threads
+ * that are not workers (the console pump, audio callbacks) submit through a
+ * small locked injection queue instead. Completion is tracked with counters;
+ * a job can be deferred until a counter reaches zero, and any thread waiting
+ * on a counter runs other jobs while it waits instead of blocking.
+ *
+ * The thread that creates a JobSystem takes worker slot 0, so the main thread
+ * helps with its own fan-out (ParallelFor, Wait) instead of sleeping.
+ */
+
+#pragma once
+
+#include "Utils/Assert.h"
+#include "Utils/ConcurrentObjectPool.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class JobSystem;
+
+/**
+ * @brief Scheduling class of a job, highest first
+ *
+ * Low is for background work such as file streaming. Threads waiting on a
+ * counter never pick up Low jobs while they help, so a frame waiting on its
+ * culling jobs cannot get stuck behind a texture load.
+ */
+enum class JobPriority : uint8_t
+{
+    High,
+    Normal,
+    Low
+};
+
+constexpr size_t JobPriorityCount = 3;
+
+/**
+ * @brief Counts unfinished jobs; jobs can wait for it or be deferred until it reaches zero
+ *
+ * Run() increments the counter it is given and the job decrements it when it
+ * finishes. A counter may be reused once it is back at zero.
+ */
+class JobCounter
+{
+public:
+    JobCounter() = default;
+    ~JobCounter()
+    {
+        // Lets a FinishCounter() that just brought the count to zero leave the mutex first
+        std::lock_guard<std::mutex> lock(m_waitersMutex);
+        ASSERT_MSG(IsDone(), "JobCounter destroyed with %d jobs outstanding", GetValue());
+    }
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool IsDone() const { return m_value.load(std::memory_order_acquire) == 0; }
+    int GetValue() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<int> m_value{ 0 };
+    mutable std::mutex m_waitersMutex;
+    mutable std::vector<class Job*> m_waiters;   ///< Jobs deferred until the counter reaches zero
+};
+
+/**
+ * @brief A unit of work: a type-erased callable plus its scheduling state
+ *
+ * Callables up to InlineSize bytes are stored in place; larger ones are moved
+ * to the heap. Jobs are recycled through a lock-free pool because they are
+ * usually created on one thread and finished on another.
+ */
+class Job
+{
+public:
+    static constexpr size_t InlineSize = 48;
+
+    Job() = default;
+    Job(const Job&) = delete;
+    Job& operator=(const Job&) = delete;
+
+private:
+    friend class JobSystem;
+
+    template<typename Func>
+    void Bind(Func&& func)
+    {
+        using Callable = std::decay_t<Func>;
+        if constexpr (sizeof(Callable) <= InlineSize && alignof(Callable) <= alignof(std::max_align_t))
+        {
+            ::new (static_cast<void*>(m_storage)) Callable(std::forward<Func>(func));
+            m_invoke = [](Job& job) { (*std::launder(reinterpret_cast<Callable*>(job.m_storage)))(); };
+            m_destroy = [](Job& job) { std::launder(reinterpret_cast<Callable*>(job.m_storage))->~Callable(); };
+        }
+        else
+        {
+            ::new (static_cast<void*>(m_storage)) Callable*(new Callable(std::forward<Func>(func)));
+            m_invoke = [](Job& job) { (**std::launder(reinterpret_cast<Callable**>(job.m_storage)))(); };
+            m_destroy = [](Job& job) { delete *std::launder(reinterpret_cast<Callable**>(job.m_storage)); };
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char m_storage[InlineSize];
+    void (*m_invoke)(Job&) = nullptr;
+    void (*m_destroy)(Job&) = nullptr;
+    JobCounter* m_counter = nullptr;
+    JobPriority m_priority = JobPriority::Normal;
+    bool m_pooled = false;
+};
+
+/**
+ * @brief Scheduler statistics, summed over all workers
+ */
+struct JobSystemStats
+{
+    uint64_t executed = 0;      ///< Jobs run to completion
+    uint64_t stolen = 0;        ///< Jobs taken from another worker's deque
+    uint64_t injected = 0;      ///< Jobs submitted from non-worker threads
+    uint64_t inlined = 0;       ///< Jobs run at submission because a deque was full
+    uint64_t heapJobs = 0;      ///< Jobs allocated outside the pool
+    uint64_t sleeps = 0;        ///< Times a worker ran out of work and blocked
+};
+
+/**
+ * @brief Work-stealing scheduler with priorities, counters and helping waits
+ */
+class JobSystem
+{
+public:
+    static constexpr int MaxThreads = 64;
+    static constexpr uint32_t DequeCapacity = 4096;  ///< Jobs per worker per priority before submissions run inline
+    static constexpr uint32_t JobPoolSize = 16384;
+
+    /**
+     * @brief Engine-wide scheduler, created on first use
+     *
+     * Call it once from the main thread during start-up so the main thread
+     * becomes worker slot 0. It is never destroyed, so it stays usable from
+     * destructors that run during static destruction.
+     */
+    static JobSystem& GetInstance();
+
+    /**
+     * @brief Start the scheduler
+     * @param threadCount Threads taking part including the creating thread; 0 uses every hardware thread
+     */
+    explicit JobSystem(int threadCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /**
+     * @brief Stop the workers; queued jobs are run on the calling thread first
+     *
+     * Jobs submitted afterwards run immediately on the submitting thread.
+     */
+    void Shutdown();
+
+    /**
+     * @brief Queue a job
+     * @param func Callable with signature void()
+     * @param counter Optional counter incremented now and decremented when the job finishes
+     * @param priority Scheduling class
+     */
+    template<typename Func>
+    void Run(Func&& func, JobCounter* counter = nullptr, JobPriority priority = JobPriority::Normal);
+
+    /**
+     * @brief Queue a job once every job counted by dependency has finished
+     *
+     * counter is incremented immediately, so waiting on it also covers the
+     * deferred job.
+     */
+    template<typename Func>
+    void RunAfter(const JobCounter& dependency, Func&& func, JobCounter* counter = nullptr,
+                  JobPriority priority = JobPriority::Normal);
+
+    /**
+     * @brief Block until a counter reaches zero, running High and Normal jobs meanwhile
+     */
+    void Wait(const JobCounter& counter);
+
+    /**
+     * @brief Run func(begin, end) over [0, count) in chunks of grain items and wait for all of them
+     *
+     * The calling thread runs the first chunk itself and then helps with the
+     * rest. Runs inline when the range fits in one chunk.
+     */
+    template<typename Func>
+    void ParallelFor(uint32_t count, uint32_t grain, Func&& func, JobPriority priority = JobPriority::High);
+
+    int GetThreadCount() const { return m_threadCount; }
+
+    /**
+     * @brief Worker slot of the calling thread, or -1 if it is not part of this system
+     */
+    int GetCurrentWorker() const;
+
+    JobSystemStats GetStats() const;
+
+    // ========================================================================
+    // CONSOLE INTEGRATION
+    // ========================================================================
+
+    std::string Console_GetStats() const;
+
+    /**
+     * @brief Measure spawn overhead, steal latency and fork-join depth
+     *
+     * Runs on a private scheduler so the engine's workers are not disturbed.
+     * @param threadCount Threads for the private scheduler
+     */
+    static std::string Console_Benchmark(int threadCount);
+
+private:
+    class WorkStealingDeque;
+    struct Worker;
+
+    Job* AllocateJob();
+    void Submit(Job* job);
+    void Execute(Job* job);
+    void FinishCounter(JobCounter* counter);
+
+    /**
+     * @brief Find the next job for a worker slot (-1 for outside threads)
+     * @param lowest Least urgent priority to consider
+     */
+    Job* FindJob(int worker, JobPriority lowest);
+    void WorkerMain(int worker);
+    void WakeWorker();
+
+    int m_threadCount = 1;
+    std::unique_ptr<Worker[]> m_workers;
+    std::vector<std::thread> m_threads;
+    ConcurrentObjectPool<Job> m_jobPool{ JobPoolSize };
+
+    // Submissions from threads outside the system
+    std::mutex m_injectionMutex;
+    std::deque<Job*> m_injected[JobPriorityCount];
+    std::atomic<uint32_t> m_injectedCount{ 0 };
+
+    // Idle workers block here
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::atomic<int> m_sleepers{ 0 };
+    std::atomic<uint64_t> m_wakeEpoch{ 0 };
+    std::atomic<bool> m_shutdown{ false };
+
+    std::atomic<uint64_t> m_injectedTotal{ 0 };
+    std::atomic<uint64_t> m_heapJobs{ 0 };
+
+    const JobSystem* m_previousSystem = nullptr;   ///< Registration of the creating thread before this system
+    int m_previousWorker = -1;
+};
+
+// ============================================================================
+// TEMPLATE IMPLEMENTATION
+// ============================================================================
+
+template<typename Func>
+void JobSystem::Run(Func&& func, JobCounter* counter, JobPriority priority)
+{
+    Job* job = AllocateJob();
+    job->Bind(std::forward<Func>(func));
+    job->m_priority = priority;
+    job->m_counter = counter;
+    if (counter) counter->m_value.fetch_add(1, std::memory_order_relaxed);
+    Submit(job);
+}
+
+template<typename Func>
+void JobSystem::RunAfter(const JobCounter& dependency, Func&& func, JobCounter* counter, JobPriority priority)
+{
+    Job* job = AllocateJob();
+    job->Bind(std::forward<Func>(func));
+    job->m_priority = priority;
+    job->m_counter = counter;
+    if (counter) counter->m_value.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        // FinishCounter() drains m_waiters under this lock after the count hits zero
+        std::lock_guard<std::mutex> lock(dependency.m_waitersMutex);
+        if (!dependency.IsDone()) {
+            dependency.m_waiters.push_back(job);
+            return;
+        }
+    }
+    Submit(job);
+}
+
+template<typename Func>
+void JobSystem::ParallelFor(uint32_t count, uint32_t grain, Func&& func, JobPriority priority)
+{
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+
+    const uint32_t chunks = (count + grain - 1) / grain;
+    if (chunks == 1 || m_threadCount == 1) {
+        func(0u, count);
+        return;
+    }
+
+    JobCounter counter;
+    auto* body = &func;
+    for (uint32_t chunk = 1; chunk < chunks; ++chunk)
+    {
+        const uint32_t begin = chunk * grain;
+        const uint32_t end = begin + grain < count ? begin + grain : count;
+        Run([body, begin, end]() { (*body)(begin, end); }, &counter, priority);
+    }
+    func(0u, grain);
+    Wait(counter);
+}
@@ -13,11 +13,30 @@
 #include <sstream>                    // for stringstream
 #include <chrono>                     // for timestamp in debug command
 #include <cmath>                      // for isfinite
+#include <thread>                     // for hardware_concurrency
 
 #include "../Graphics/GraphicsEngine.h"
 #include "../Game/Game.h"
+#include "../Projectiles/ProjectilePool.h"
+#include "../Physics/CollisionSystem.h"
 #include "../Input/InputManager.h"
 #include "../Utils/Timer.h"
+#include "../Utils/ObjectPool.h"
+#include "../Utils/ConcurrentObjectPool.h"
+#include "../Utils/FrameArena.h"
+#include "../Graphics/CullingSystem.h"
+#include "../SceneManager/SceneOctree.h"
+#include "../Graphics/RenderQueue.h"
+#include "../Graphics/CommandBuffer.h"
+#include "../Graphics/OcclusionCuller.h"
+#include "../Graphics/LightingSystem.h"
+#include "../Graphics/ClusteredLightGrid.h"
+#include "../Graphics/ShadowCascades.h"
+#include "../Graphics/ShadowCache.h"
+#include "../Graphics/MeshSimplifier.h"
+#include "JobSystem.h"
+#include "../Engine/ECS/TransformHierarchy.h"
+#include "../Engine/ECS/SystemScheduler.h"
 #include "../Game/Console.h"
 #include "Utils/CrashHandler.h"
 #include "Utils/D3DUtils.h"
@@ -196,6 +215,9 @@ BOOL InitInstance(HINSTANCE hInst, int nCmdShow)
     // 1. Initialize Console FIRST (before external console)
     g_console.Initialize(1280, 720);
 
+    // 1b. Start the job system from the main thread so it takes worker slot 0
+    JobSystem::GetInstance();
+
     // 2. Initialize Timer EARLY (needed by console commands)
     g_timer = std::make_unique<Timer>();
     ASSERT(g_timer);
@@ -439,6 +461,339 @@ void RegisterGameConsoleCommands()
         return "Time scale set to " + std::to_string(scale);
     }, "Set game time scale");
 
+    // Fixed simulation tick rate
+    console.RegisterCommand("game_tickrate", [](const std::vector<std::string>& args) -> std::string {
+        if (!g_game) return "Game not available";
+
+        if (!args.empty()) {
+            try {
+                g_game->SetTickRate(std::stod(args[0]));
+            } catch (...) {
+                return "Invalid tick rate value. Must be a number.";
+            }
+        }
+
+        const FixedTimestep& clock = g_game->GetSimulationClock();
+        return "Tick rate: " + std::to_string(clock.GetTickRate()) + " Hz (step " +
+               std::to_string(clock.GetStepSize() * 1000.0) + " ms, max " +
+               std::to_string(clock.GetMaxStepsPerFrame()) + " per frame)\n"
+               "Ticks: " + std::to_string(clock.GetTickCount()) +
+               ", frames: " + std::to_string(clock.GetFrameCount()) +
+               ", clamped frames: " + std::to_string(clock.GetClampedFrames()) +
+               ", dropped ticks: " + std::to_string(clock.GetDroppedTicks()) + "\n"
+               "Usage: game_tickrate [hz] (1-1000)";
+    }, "Get or set the fixed simulation tick rate");
+
+    // SIMD collision kernels against the scalar lanes and single-pair tests
+    console.RegisterCommand("collision_batch_check", [](const std::vector<std::string>& args) -> std::string {
+        int count = 10000;
+        try {
+            if (args.size() >= 1) count = std::stoi(args[0]);
+        } catch (...) {
+            return "Usage: collision_batch_check [count]";
+        }
+        return CollisionSystem::Console_CheckBatchKernels(count);
+    }, "Check SIMD batch collision kernels against the scalar path (collision_batch_check [count])");
+
+    // Projectile pool throughput
+    console.RegisterCommand("projectile_bench", [](const std::vector<std::string>& args) -> std::string {
+        int rounds = 8192, ticks = 300;
+        try {
+            if (args.size() >= 1) rounds = std::stoi(args[0]);
+            if (args.size() >= 2) ticks = std::stoi(args[1]);
+        } catch (...) {
+            return "Usage: projectile_bench [rounds] [ticks]";
+        }
+
+        std::string result = ProjectilePool::Console_Benchmark(rounds, ticks);
+        if (g_game && g_game->GetProjectilePool()) {
+            const ProjectilePool* pool = g_game->GetProjectilePool();
+            result += "Game pool: " + std::to_string(pool->GetActiveCount()) + " active, " +
+                      std::to_string(pool->GetAvailableCount()) + " available\n";
+        }
+        return result;
+    }, "Benchmark projectile spawn/update/despawn throughput (projectile_bench [rounds] [ticks])");
+
+    // Object pool acquire/release throughput
+    console.RegisterCommand("pool_bench", [](const std::vector<std::string>& args) -> std::string {
+        int threads = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+        int operations = 1000000;
+        try {
+            if (args.size() >= 1) threads = std::stoi(args[0]);
+            if (args.size() >= 2) operations = std::stoi(args[1]);
+        } catch (...) {
+            return "Usage: pool_bench [threads] [operations]";
+        }
+        return BenchmarkObjectPools(threads, operations);
+    }, "Benchmark slab object pool against the queue pool at 1 and N threads (pool_bench [threads] [operations])");
+
+    // Lock-free pool correctness under cross-thread traffic
+    console.RegisterCommand("pool_stress", [](const std::vector<std::string>& args) -> std::string {
+        int threads = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+        int operations = 200000;
+        try {
+            if (args.size() >= 1) threads = std::stoi(args[0]);
+            if (args.size() >= 2) operations = std::stoi(args[1]);
+        } catch (...) {
+            return "Usage: pool_stress [threads] [operations]";
+        }
+        return StressConcurrentObjectPool(threads, operations);
+    }, "Stress the lock-free object pool with cross-thread acquire/release (pool_stress [threads] [operations])");
+
+    // Job system
+    console.RegisterCommand("job_stats", [](const std::vector<std::string>&) -> std::string {
+        return JobSystem::GetInstance().Console_GetStats();
+    }, "Show job system threads, steals and pool usage");
+
+    console.RegisterCommand("job_bench", [](const std::vector<std::string>& args) -> std::string {
+        int threads = JobSystem::GetInstance().GetThreadCount();
+        try {
+            if (args.size() >= 1) threads = std::stoi(args[0]);
+        } catch (...) {
+            return "Usage: job_bench [threads]";
+        }
+        return JobSystem::Console_Benchmark(threads);
+    }, "Benchmark job spawn overhead, steal latency and fork-join depth (job_bench [threads])");
+
+    console.RegisterCommand("transform_bench", [](const std::vector<std::string>& args) -> std::string {
+        int entities = 100000;
+        try {
+            if (args.size() >= 1) entities = std::stoi(args[0]);
+        } catch (...) {
+            return "Usage: transform_bench [entities]";
+        }
+        return TransformHierarchy::Console_Benchmark(entities);
+    }, "Benchmark transform hierarchy propagation against a pointer scene graph (transform_bench [entities])");
+
+    console.RegisterCommand("ecs_systems", [](const std::vector<std::string>& args) -> std::string {
+        if (!g_game) return "Game not available";
+        return g_game->GetFixedSystems().Console_GetStats();
+    }, "Show the fixed-tick systems, their dependencies and last timings");
+
+    console.RegisterCommand("ecs_bench", [](const std::vector<std::string>& args) -> std::string {
+        int systems = 32;
+        int frames = 200;
+        try {
+            if (args.size() >= 1) systems = std::stoi(args[0]);
+            if (args.size() >= 2) frames = std::stoi(args[1]);
+        } catch (...) {
+            return "Usage: ecs_bench [systems] [frames]";
+        }
+        return SystemScheduler::Console_Benchmark(systems, frames);
+    }, "Benchmark serial vs parallel system scheduling and check conflicting systems never overlap (ecs_bench [systems] [frames])");
+
+    console.RegisterCommand("frame_arena", [](const std::vector<std::string>& args) -> std::string {
+        return "Per-frame arena: " + FrameArena::GetFrame().Console_GetStats() + "\n" +
+               "In-flight arena: " + FrameArena::GetInFlight().Console_GetStats();
+    }, "Show per-frame arena usage and heap allocations");
+
+    console.RegisterCommand("frame_arena_bench", [](const std::vector<std::string>& args) -> std::string {
+        int frames = 1000;
+        try {
+            if (args.size() >= 1) frames = std::stoi(args[0]);
+        } catch (...) {
+            return "Usage: frame_arena_bench [frames]";
+        }
+        return FrameArena::Console_Benchmark(frames);
+    }, "Count heap allocations and time per-frame render lists on the heap vs the frame arena (frame_arena_bench [frames])");
+
+    console.RegisterCommand("cull_bench", [](const std::vector<std::string>& args) -> std::string {
+        int objects = 100000;
+        try {
+            if (args.size() >= 1) objects = std::stoi(args[0]);
+        } catch (...) {
+            return "Usage: cull_bench [objects]";
+        }
+        return CullingSystem::Console_Benchmark(objects);
+    }, "Benchmark SIMD frustum culling against the scalar path and check they agree (cull_bench [objects])");
+
+    console.RegisterCommand("scene_index", [](const std::vector<std::string>& args) -> std::string {
+        if (!g_game) return "Game not available";
+        return g_game->GetSceneIndex().Console_GetStats();
+    }, "Show the scene octree: objects, cells, depth and relocations");
+
+    console.RegisterCommand("octree_bench", [](const std::vector<std::string>& args) -> std::string {
+        int objects = 250000;
+        try {
+            if (args.size() >= 1) objects = std::stoi(args[0]);
+        } catch (...) {
+            return "Usage: octree_bench [objects]";
+        }
+        return SceneOctree::Console_Benchmark(objects);
+    }, "Insert, move and query a synthetic city in the scene octree, checked against flat walks (octree_bench [objects])");
+
+    console.RegisterCommand("render_queue_bench", [](const std::vector<std::string>& args) -> std::string {
+        int packets = 1000000;
+        try {
+            if (args.size() >= 1) packets = std::stoi(args[0]);
+        } catch (...) {
+            return "Usage: render_queue_bench [packets]";
+        }
+        return RenderQueue::Console_Benchmark(packets);
+    }, "Check draw sort key packing and time the radix sort against std::sort (render_queue_bench [packets])");
+
+    console.RegisterCommand("render_backend", [](const std::vector<std::string>& args) -> std::string {
+        if (!g_graphics) return "Graphics engine not available";
+        if (args.size() >= 1) {
+            if (args[0] == "null") {
+                g_graphics->SetRenderBackend(RenderBackendType::Null);
+            } else if (args[0] == "d3d11") {
+                if (!g_graphics->SetRenderBackend(RenderBackendType::D3D11)) return "No D3D11 device; backend unchanged";
+            } else if (args[0] != "stats") {
+                return "Usage: render_backend [d3d11|null|stats]";
+            }
+        }
+        RenderBackend* backend = g_graphics->GetRenderBackend();
+        return backend ? backend->Console_GetStats() : "No render backend";
+    }, "Switch recorded draws between the D3D11 and null backends, or show replay counts (render_backend [d3d11|null|stats])");
+
+    console.RegisterCommand("command_buffer_bench", [](const std::vector<std::string>& args) -> std::string {
+        int draws = 200000;
+        try {
+            if (args.size() >= 1) draws = std::stoi(args[0]);
+        } catch (...) {
+            return "Usage: command_buffer_bench [draws]";
+        }
+        return CommandBuffer::Console_Benchmark(draws);
+    }, "Record draws on one thread and across the job system, replay through the null backend (command_buffer_bench [draws])");
+
+    console.RegisterCommand("occlusion", [](const std::vector<std::string>& args) -> std::string {
+        if (!g_graphics) return "Graphics engine not available";
+        if (args.size() >= 1) {
+            if (args[0] == "on" || args[0] == "off") {
+                g_graphics->Console_EnableFeature("occlusion_culling", args[0] == "on");
+            } else if (args[0] != "stats") {
+                return "Usage: occlusion [on|off|stats]";
+            }
+        }
+        const RenderStatistics stats = g_graphics->Console_GetStatistics();
+        std::stringstream ss;
+        ss << g_graphics->GetOcclusionCuller().Console_GetStats();
+        ss << "Occluded objects:    " << stats.occludedObjects << " (" << stats.occlusionTime << " ms)\n";
+        return ss.str();
+    }, "Toggle software occlusion culling against walls and other occluders, or show its buffer (occlusion [on|off|stats])");
+
+    console.RegisterCommand("occlusion_bench", [](const std::vector<std::string>& args) -> std::string {
+        int rooms = 8;
+        try {
+            if (args.size() >= 1) rooms = std::stoi(args[0]);
+        } catch (...) {
+            return "Usage: occlusion_bench [roomsPerSide]";
+        }
+        return OcclusionCuller::Console_Benchmark(rooms);
+    }, "Rasterise a synthetic grid of rooms into the occlusion buffer and cull its contents, checked per pixel (occlusion_bench [roomsPerSide])");
+
+    console.RegisterCommand("light_clusters", [](const std::vector<std::string>& args) -> std::string {
+        if (!g_graphics) return "Graphics engine not available";
+        LightingSystem* lighting = g_graphics->GetLightingSystem();
+        return lighting ? lighting->Console_GetClusterStats() : "Lighting system not available";
+    }, "Show how the last frame's lights were binned into view clusters");
+
+    console.RegisterCommand("light_cluster_bench", [](const std::vector<std::string>& args) -> std::string {
+        int lights = 4096;
+        try {
+            if (args.size() >= 1) lights = std::stoi(args[0]);
+        } catch (...) {
+            return "Usage: light_cluster_bench [lights]";
+        }
+        return ClusteredLightGrid::Console_Benchmark(lights);
+    }, "Bin point and spot lights into clusters, checked against brute force and point samples (light_cluster_bench [lights])");
+
+    console.RegisterCommand("shadow_cascades", [](const std::vector<std::string>& args) -> std::string {
+        if (!g_graphics) return "Graphics engine not available";
+        LightingSystem* lighting = g_graphics->GetLightingSystem();
+        if (!lighting) return "Lighting system not available";
+        const RenderStatistics stats = g_graphics->Console_GetStatistics();
+        std::stringstream ss;
+        ss << lighting->Console_GetCascadeStats();
+        ss << "Caster draws:     " << stats.shadowCasterDraws << " over " << stats.shadowUpdates << " shadow maps\n";
+        return ss.str();
+    }, "Show the last frame's shadow cascade splits, texel sizes and caster counts");
+
+    console.RegisterCommand("shadow_cascade_bench", [](const std::vector<std::string>& args) -> std::string {
+        int casters = 50000;
+        try {
+            if (args.size() >= 1) casters = std::stoi(args[0]);
+        } catch (...) {
+            return "Usage: shadow_cascade_bench [casters]";
+        }
+        return ShadowCascades::Console_Benchmark(casters);
+    }, "Fit cascades and cull casters in a synthetic outdoor scene, checked with shadow rays and camera moves (shadow_cascade_bench [casters])");
+
+    console.RegisterCommand("shadow_cache", [](const std::vector<std::string>& args) -> std::string {
+        if (!g_graphics) return "Graphics engine not available";
+        LightingSystem* lighting = g_graphics->GetLightingSystem();
+        if (!lighting) return "Lighting system not available";
+        ShadowCache& cache = lighting->GetShadowCache();
+        if (!args.empty() && args[0] != "stats") {
+            if (args[0] != "on" && args[0] != "off") return "Usage: shadow_cache [on|off|stats]";
+            cache.SetEnabled(args[0] == "on");
+            return std::string("Shadow map caching ") + (cache.IsEnabled() ? "enabled" : "disabled");
+        }
+        const RenderStatistics stats = g_graphics->Console_GetStatistics();
+        std::stringstream ss;
+        ss << cache.Console_GetStats();
+        ss << "Caster draws:     " << stats.shadowCasterDraws << " last frame\n";
+        return ss.str();
+    }, "Show or toggle shadow map caching of static lights and casters (shadow_cache [on|off|stats])");
+
+    console.RegisterCommand("shadow_cache_bench", [](const std::vector<std::string>& args) -> std::string {
+        int lights = 64;
+        try {
+            if (args.size() >= 1) lights = std::stoi(args[0]);
+        } catch (...) {
+            return "Usage: shadow_cache_bench [lights]";
+        }
+        return ShadowCache::Console_Benchmark(lights);
+    }, "Run moving casters and lights through the shadow cache, checking every map against a full redraw (shadow_cache_bench [lights])");
+
+    console.RegisterCommand("shadow_atlas", [](const std::vector<std::string>& args) -> std::string {
+        if (!g_graphics) return "Graphics engine not available";
+        LightingSystem* lighting = g_graphics->GetLightingSystem();
+        if (!lighting) return "Lighting system not available";
+        return lighting->GetShadowAtlas().Console_GetStats();
+    }, "Show shadow atlas tiles of point, spot and area lights");
+
+    console.RegisterCommand("shadow_atlas_bench", [](const std::vector<std::string>& args) -> std::string {
+        int lights = 512;
+        try {
+            if (args.size() >= 1) lights = std::stoi(args[0]);
+        } catch (...) {
+            return "Usage: shadow_atlas_bench [lights]";
+        }
+        return ShadowAtlas::Console_Benchmark(lights);
+    }, "Allocate shadow atlas tiles for many lights around a moving camera, checking packing and stability (shadow_atlas_bench [lights])");
+
+    console.RegisterCommand("lod", [](const std::vector<std::string>& args) -> std::string {
+        if (!g_graphics) return "Graphics engine not available";
+        if (args.size() >= 1) {
+            if (args[0] == "on" || args[0] == "off") {
+                g_graphics->Console_EnableFeature("level_of_detail", args[0] == "on");
+            } else if (args[0] != "stats") {
+                try {
+                    g_graphics->Console_SetSetting("lod_pixel_error", std::stof(args[0]));
+                } catch (...) {
+                    return "Usage: lod [on|off|stats|<pixelError>]";
+                }
+            }
+        }
+        const RenderStatistics stats = g_graphics->Console_GetStatistics();
+        const GraphicsSettings settings = g_graphics->Console_GetSettings();
+        std::stringstream ss;
+        ss << "Level of detail:  " << (settings.levelOfDetail ? "on" : "off") << ", " << settings.lodPixelError << " pixel error\n";
+        ss << "Reduced objects:  " << stats.lodReducedObjects << " of " << stats.visibleObjects << " visible\n";
+        ss << "Triangles saved:  " << stats.lodTrianglesSaved << "\n";
+        return ss.str();
+    }, "Toggle mesh LOD selection by screen size, set its pixel error, or show how many objects drew a simplified mesh (lod [on|off|stats|<pixelError>])");
+
+    console.RegisterCommand("lod_bench", [](const std::vector<std::string>& args) -> std::string {
+        return MeshSimplifier::Console_Benchmark(args.size() >= 1 ? args[0] : "Assets/Models");
+    }, "Check simplifier error bounds, seams, borders, LOD hysteresis and the cache, then time simplification of every .obj model (lod_bench [directory])");
+
+    console.RegisterCommand("lod_bake", [](const std::vector<std::string>& args) -> std::string {
+        return MeshSimplifier::Console_BakeLods(args.size() >= 1 ? args[0] : "Assets/Models", MeshLodSettings{});
+    }, "Build the LOD chain of every .obj model and cache it beside the model as .lod, read when the model loads (lod_bake [directory])");
+
     // Player teleport
     console.RegisterCommand("player_tp", [](const std::vector<std::string>& args) -> std::string {
         if (args.size() < 3) return "Usage: player_tp <x> <y> <z>";
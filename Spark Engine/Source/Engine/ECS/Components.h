@@ -45,6 +45,7 @@ struct Transform {
     DirectX::XMFLOAT3 rotation{0,0,0};
     DirectX::XMFLOAT3 scale{1,1,1};
     EntityID parent = entt::null;
+    uint32_t hierarchyNode = 0xFFFFFFFF;  // TransformHierarchy node, resolved by the transform system
     
     DirectX::XMMATRIX GetWorldMatrix() const;
 };
@@ -0,0 +1,528 @@
+/**
+ * @file TransformHierarchy.cpp
+ * @brief Implementation of the depth-sorted transform hierarchy
+ * @author Spark Engine Team
+ * @date 2025
+ */
+
+#include "TransformHierarchy.h"
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <sstream>
+
+using namespace DirectX;
+
+namespace
+{
+    const XMFLOAT4X4 IdentityMatrix(1.0f, 0.0f, 0.0f, 0.0f,
+                                    0.0f, 1.0f, 0.0f, 0.0f,
+                                    0.0f, 0.0f, 1.0f, 0.0f,
+                                    0.0f, 0.0f, 0.0f, 1.0f);
+
+    XMMATRIX ComposeLocal(const LocalTransform& local)
+    {
+        return XMMatrixScaling(local.scale.x, local.scale.y, local.scale.z)
+             * XMMatrixRotationRollPitchYaw(local.rotation.x, local.rotation.y, local.rotation.z)
+             * XMMatrixTranslation(local.position.x, local.position.y, local.position.z);
+    }
+
+    bool SameFloat3(const XMFLOAT3& a, const XMFLOAT3& b)
+    {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+}
+
+// ============================================================================
+// STRUCTURE
+// ============================================================================
+
+TransformHierarchy::Node TransformHierarchy::Create(Node parent, const LocalTransform& local)
+{
+    ASSERT_MSG(parent == InvalidNode || IsValid(parent), "TransformHierarchy parent %u is not a live node", parent);
+
+    Node node;
+    if (!m_freeNodes.empty()) {
+        node = m_freeNodes.back();
+        m_freeNodes.pop_back();
+    }
+    else {
+        node = static_cast<Node>(m_parent.size());
+        m_parent.push_back(InvalidNode);
+        m_firstChild.push_back(InvalidNode);
+        m_nextSibling.push_back(InvalidNode);
+        m_alive.push_back(0);
+        m_denseOfNode.push_back(InvalidNode);
+    }
+
+    m_parent[node] = parent;
+    m_firstChild[node] = InvalidNode;
+    m_nextSibling[node] = InvalidNode;
+    m_alive[node] = 1;
+    if (parent != InvalidNode) {
+        m_nextSibling[node] = m_firstChild[parent];
+        m_firstChild[parent] = node;
+    }
+
+    // Appended out of order; RebuildOrder() moves it to its level
+    const uint32_t dense = static_cast<uint32_t>(m_nodeOfDense.size());
+    m_denseOfNode[node] = dense;
+    m_nodeOfDense.push_back(node);
+    m_parentDense.push_back(InvalidNode);
+    m_depth.push_back(0);
+    m_local.push_back(local);
+    m_world.push_back(IdentityMatrix);
+    m_dirty.push_back(0);
+    m_updatedStamp.push_back(0);
+
+    ++m_nodeCount;
+    m_orderDirty = true;
+    MarkDirty(dense);
+    return node;
+}
+
+void TransformHierarchy::Destroy(Node node)
+{
+    ASSERT_MSG(IsValid(node), "TransformHierarchy::Destroy given dead node %u", node);
+    if (!IsValid(node)) return;
+
+    m_orderDirty = true;
+    UnlinkFromParent(node);
+
+    // Orphans become roots; their world matrices lose the parent's contribution
+    for (Node child = m_firstChild[node]; child != InvalidNode;)
+    {
+        const Node next = m_nextSibling[child];
+        m_parent[child] = InvalidNode;
+        m_nextSibling[child] = InvalidNode;
+        MarkDirty(DenseOf(child));
+        child = next;
+    }
+    m_firstChild[node] = InvalidNode;
+
+    m_nodeOfDense[m_denseOfNode[node]] = InvalidNode;
+    m_denseOfNode[node] = InvalidNode;
+    m_alive[node] = 0;
+    m_freeNodes.push_back(node);
+    --m_nodeCount;
+}
+
+void TransformHierarchy::SetParent(Node node, Node parent)
+{
+    ASSERT_MSG(IsValid(node), "TransformHierarchy::SetParent given dead node %u", node);
+    ASSERT_MSG(parent == InvalidNode || IsValid(parent), "TransformHierarchy parent %u is not a live node", parent);
+    if (m_parent[node] == parent) return;
+
+    for (Node ancestor = parent; ancestor != InvalidNode; ancestor = m_parent[ancestor])
+    {
+        ASSERT_MSG(ancestor != node, "TransformHierarchy::SetParent would make node %u its own ancestor", node);
+        if (ancestor == node) return;
+    }
+
+    m_orderDirty = true;
+    UnlinkFromParent(node);
+    m_parent[node] = parent;
+    if (parent != InvalidNode) {
+        m_nextSibling[node] = m_firstChild[parent];
+        m_firstChild[parent] = node;
+    }
+    MarkDirty(DenseOf(node));
+}
+
+TransformHierarchy::Node TransformHierarchy::GetParent(Node node) const
+{
+    ASSERT_MSG(IsValid(node), "TransformHierarchy::GetParent given dead node %u", node);
+    return m_parent[node];
+}
+
+void TransformHierarchy::Clear()
+{
+    m_parent.clear();
+    m_firstChild.clear();
+    m_nextSibling.clear();
+    m_alive.clear();
+    m_denseOfNode.clear();
+    m_freeNodes.clear();
+    m_nodeCount = 0;
+
+    m_nodeOfDense.clear();
+    m_parentDense.clear();
+    m_depth.clear();
+    m_local.clear();
+    m_world.clear();
+    m_dirty.clear();
+    m_updatedStamp.clear();
+
+    m_levelStart.clear();
+    m_levelDirty.clear();
+    m_orderDirty = false;
+    m_minDirtyDepth = NoDirtyDepth;
+    m_lastUpdated = 0;
+}
+
+uint32_t TransformHierarchy::DenseOf(Node node) const
+{
+    ASSERT_MSG(IsValid(node), "TransformHierarchy node %u is not live", node);
+    return m_denseOfNode[node];
+}
+
+void TransformHierarchy::MarkDirty(uint32_t dense)
+{
+    if (m_dirty[dense]) return;
+    m_dirty[dense] = 1;
+
+    // Depths are stale until the next RebuildOrder(), which recounts
+    if (m_orderDirty) return;
+    const uint32_t depth = m_depth[dense];
+    ++m_levelDirty[depth];
+    m_minDirtyDepth = std::min(m_minDirtyDepth, depth);
+}
+
+void TransformHierarchy::UnlinkFromParent(Node node)
+{
+    const Node parent = m_parent[node];
+    if (parent == InvalidNode) return;
+
+    Node* link = &m_firstChild[parent];
+    while (*link != node)
+    {
+        ASSERT_MSG(*link != InvalidNode, "TransformHierarchy node %u missing from its parent's children", node);
+        link = &m_nextSibling[*link];
+    }
+    *link = m_nextSibling[node];
+    m_nextSibling[node] = InvalidNode;
+    m_parent[node] = InvalidNode;
+}
+
+void TransformHierarchy::RebuildOrder()
+{
+    // Breadth-first from the roots: the result is sorted by depth
+    std::vector<Node> order;
+    order.reserve(m_nodeCount);
+    for (Node node = 0; node < static_cast<Node>(m_alive.size()); ++node)
+        if (m_alive[node] && m_parent[node] == InvalidNode) order.push_back(node);
+
+    m_levelStart.assign(1, 0);
+    for (size_t levelBegin = 0; levelBegin < order.size();)
+    {
+        const size_t levelEnd = order.size();
+        for (size_t i = levelBegin; i < levelEnd; ++i)
+            for (Node child = m_firstChild[order[i]]; child != InvalidNode; child = m_nextSibling[child])
+                order.push_back(child);
+        m_levelStart.push_back(static_cast<uint32_t>(levelEnd));
+        levelBegin = levelEnd;
+    }
+    ASSERT_MSG(order.size() == m_nodeCount, "TransformHierarchy reached %zu of its nodes", order.size());
+
+    // Gather the dense arrays into the new order. A parent precedes its
+    // children, so its m_denseOfNode entry is already the new index.
+    const size_t count = order.size();
+    std::vector<uint32_t> parentDense(count), depth(count), updatedStamp(count);
+    std::vector<LocalTransform> local(count);
+    std::vector<XMFLOAT4X4> world(count);
+    std::vector<uint8_t> dirty(count);
+
+    m_levelDirty.assign(GetDepthCount(), 0);
+    m_minDirtyDepth = NoDirtyDepth;
+
+    uint32_t level = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        while (i >= m_levelStart[level + 1]) ++level;
+
+        const Node node = order[i];
+        const uint32_t previous = m_denseOfNode[node];
+        m_denseOfNode[node] = i;
+
+        const Node parent = m_parent[node];
+        parentDense[i] = parent == InvalidNode ? InvalidNode : m_denseOfNode[parent];
+        depth[i] = level;
+        local[i] = m_local[previous];
+        world[i] = m_world[previous];
+        updatedStamp[i] = m_updatedStamp[previous];
+        dirty[i] = m_dirty[previous];
+        if (dirty[i]) {
+            ++m_levelDirty[level];
+            m_minDirtyDepth = std::min(m_minDirtyDepth, level);
+        }
+    }
+
+    m_nodeOfDense = std::move(order);
+    m_parentDense = std::move(parentDense);
+    m_depth = std::move(depth);
+    m_local = std::move(local);
+    m_world = std::move(world);
+    m_dirty = std::move(dirty);
+    m_updatedStamp = std::move(updatedStamp);
+    m_orderDirty = false;
+}
+
+// ============================================================================
+// LOCAL TRANSFORMS
+// ============================================================================
+
+void TransformHierarchy::SetLocal(Node node, const LocalTransform& local)
+{
+    const uint32_t dense = DenseOf(node);
+    LocalTransform& current = m_local[dense];
+    if (SameFloat3(current.position, local.position) && SameFloat3(current.rotation, local.rotation) &&
+        SameFloat3(current.scale, local.scale))
+        return;
+
+    current = local;
+    MarkDirty(dense);
+}
+
+void TransformHierarchy::SetPosition(Node node, const XMFLOAT3& position)
+{
+    const uint32_t dense = DenseOf(node);
+    if (SameFloat3(m_local[dense].position, position)) return;
+    m_local[dense].position = position;
+    MarkDirty(dense);
+}
+
+void TransformHierarchy::SetRotation(Node node, const XMFLOAT3& rotation)
+{
+    const uint32_t dense = DenseOf(node);
+    if (SameFloat3(m_local[dense].rotation, rotation)) return;
+    m_local[dense].rotation = rotation;
+    MarkDirty(dense);
+}
+
+void TransformHierarchy::SetScale(Node node, const XMFLOAT3& scale)
+{
+    const uint32_t dense = DenseOf(node);
+    if (SameFloat3(m_local[dense].scale, scale)) return;
+    m_local[dense].scale = scale;
+    MarkDirty(dense);
+}
+
+const LocalTransform& TransformHierarchy::GetLocal(Node node) const
+{
+    return m_local[DenseOf(node)];
+}
+
+// ============================================================================
+// PROPAGATION
+// ============================================================================
+
+void TransformHierarchy::Update()
+{
+    if (m_orderDirty) RebuildOrder();
+
+    m_lastUpdated = 0;
+    if (m_minDirtyDepth == NoDirtyDepth) return;
+
+    if (++m_updateStamp == 0) {
+        std::fill(m_updatedStamp.begin(), m_updatedStamp.end(), 0u);
+        m_updateStamp = 1;
+    }
+    const uint32_t stamp = m_updateStamp;
+
+    // A level has work if nodes in it were marked or its parent level changed
+    size_t remainingMarked = 0;
+    for (uint32_t level = m_minDirtyDepth; level < GetDepthCount(); ++level)
+        remainingMarked += m_levelDirty[level];
+
+    JobSystem& jobs = JobSystem::GetInstance();
+    uint32_t parentLevelUpdated = 0;
+    for (uint32_t level = m_minDirtyDepth; level < GetDepthCount(); ++level)
+    {
+        if (remainingMarked == 0 && parentLevelUpdated == 0) break;
+        if (m_levelDirty[level] == 0 && parentLevelUpdated == 0) continue;
+        remainingMarked -= m_levelDirty[level];
+        m_levelDirty[level] = 0;
+
+        const uint32_t begin = m_levelStart[level];
+        const uint32_t count = m_levelStart[level + 1] - begin;
+        std::atomic<uint32_t> levelUpdated{ 0 };
+
+        jobs.ParallelFor(count, NodesPerJob, [&](uint32_t chunkBegin, uint32_t chunkEnd) {
+            uint32_t updated = 0;
+            for (uint32_t i = begin + chunkBegin; i < begin + chunkEnd; ++i)
+            {
+                // The parent level finished before this one started
+                const uint32_t parent = m_parentDense[i];
+                const bool parentMoved = parent != InvalidNode && m_updatedStamp[parent] == stamp;
+                if (!m_dirty[i] && !parentMoved) continue;
+
+                XMMATRIX world = ComposeLocal(m_local[i]);
+                if (parent != InvalidNode)
+                    world = XMMatrixMultiply(world, XMLoadFloat4x4(&m_world[parent]));
+                XMStoreFloat4x4(&m_world[i], world);
+
+                m_dirty[i] = 0;
+                m_updatedStamp[i] = stamp;
+                ++updated;
+            }
+            if (updated) levelUpdated.fetch_add(updated, std::memory_order_relaxed);
+        });
+
+        parentLevelUpdated = levelUpdated.load(std::memory_order_relaxed);
+        m_lastUpdated += parentLevelUpdated;
+    }
+
+    m_minDirtyDepth = NoDirtyDepth;
+}
+
+const XMFLOAT4X4& TransformHierarchy::GetWorldMatrix(Node node) const
+{
+    return m_world[DenseOf(node)];
+}
+
+// ============================================================================
+// BENCHMARK
+// ============================================================================
+
+namespace
+{
+    /// Classic scene-graph node: one heap allocation per entity, children by pointer
+    struct PointerNode
+    {
+        LocalTransform local;
+        XMFLOAT4X4 world;
+        std::vector<PointerNode*> children;
+    };
+
+    void ResolvePointerTree(PointerNode* node, const XMFLOAT4X4* parentWorld)
+    {
+        XMMATRIX world = ComposeLocal(node->local);
+        if (parentWorld) world = XMMatrixMultiply(world, XMLoadFloat4x4(parentWorld));
+        XMStoreFloat4x4(&node->world, world);
+        for (PointerNode* child : node->children)
+            ResolvePointerTree(child, &node->world);
+    }
+
+    struct HierarchyShape
+    {
+        const char* name;
+        int chainLength;        ///< > 0: chains of this many nodes; 0: random parents
+        int maxDepth;           ///< Random parents: deepest level allowed
+    };
+}
+
+std::string TransformHierarchy::Console_Benchmark(int entities)
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto ms = [](auto a, auto b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+
+    entities = std::max(16, entities);
+    const HierarchyShape shapes[] = {
+        { "flat",        1,  1 },   // Every entity a root
+        { "props",       0,  4 },   // Random parents, at most 4 levels
+        { "vehicles",   16, 16 },   // 16-node attachment chains
+        { "deep",       64, 64 },   // 64-node chains
+    };
+
+    std::stringstream ss;
+    ss << "=== Transform Hierarchy Benchmark ===\n";
+    ss << entities << " entities per shape, " << JobSystem::GetInstance().GetThreadCount() << " job threads\n";
+    ss << "Times in ms: pointer = heap scene graph walked from the roots, full = every node dirty,\n";
+    ss << "1% = random 1% of nodes moved (with their subtrees), idle = nothing changed\n";
+
+    for (const HierarchyShape& shape : shapes)
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        auto randomLocal = [&]() {
+            LocalTransform local;
+            local.position = XMFLOAT3(unit(rng) * 2.0f, unit(rng) * 2.0f, unit(rng) * 2.0f);
+            local.rotation = XMFLOAT3(unit(rng) * 0.3f, unit(rng) * 0.3f, unit(rng) * 0.3f);
+            return local;
+        };
+
+        // Parents and locals first, so both representations get the same tree
+        std::vector<int> parents(entities, -1);
+        std::vector<int> depths(entities, 0);
+        std::vector<LocalTransform> locals(entities);
+        for (int i = 0; i < entities; ++i)
+        {
+            locals[i] = randomLocal();
+            if (shape.chainLength > 0) {
+                if (i % shape.chainLength != 0) parents[i] = i - 1;
+            }
+            else if (i > 0 && rng() % 8 != 0) {
+                const int candidate = static_cast<int>(rng() % i);
+                if (depths[candidate] + 1 < shape.maxDepth) parents[i] = candidate;
+            }
+            depths[i] = parents[i] < 0 ? 0 : depths[parents[i]] + 1;
+        }
+
+        // Pointer scene graph, allocated in shuffled order as a long-running game would
+        std::vector<int> allocationOrder(entities);
+        for (int i = 0; i < entities; ++i) allocationOrder[i] = i;
+        std::shuffle(allocationOrder.begin(), allocationOrder.end(), rng);
+        std::vector<std::unique_ptr<PointerNode>> pointerNodes(entities);
+        for (int i : allocationOrder) pointerNodes[i] = std::make_unique<PointerNode>();
+        std::vector<PointerNode*> pointerRoots;
+        for (int i = 0; i < entities; ++i)
+        {
+            pointerNodes[i]->local = locals[i];
+            if (parents[i] < 0) pointerRoots.push_back(pointerNodes[i].get());
+            else pointerNodes[parents[i]]->children.push_back(pointerNodes[i].get());
+        }
+
+        auto pointerStart = Clock::now();
+        for (PointerNode* root : pointerRoots) ResolvePointerTree(root, nullptr);
+        auto pointerEnd = Clock::now();
+
+        // Hierarchy
+        auto buildStart = Clock::now();
+        TransformHierarchy hierarchy;
+        std::vector<Node> nodes(entities);
+        for (int i = 0; i < entities; ++i)
+            nodes[i] = hierarchy.Create(parents[i] < 0 ? InvalidNode : nodes[parents[i]], locals[i]);
+        hierarchy.Update();
+        auto buildEnd = Clock::now();
+
+        float maxError = 0.0f;
+        for (int i = 0; i < entities; ++i)
+        {
+            const XMFLOAT4X4& a = hierarchy.GetWorldMatrix(nodes[i]);
+            const XMFLOAT4X4& b = pointerNodes[i]->world;
+            for (int r = 0; r < 4; ++r)
+                for (int c = 0; c < 4; ++c)
+                    maxError = std::max(maxError, std::fabs(a.m[r][c] - b.m[r][c]));
+        }
+
+        // Full update: move every node
+        for (int i = 0; i < entities; ++i)
+        {
+            XMFLOAT3 position = locals[i].position;
+            position.y += 0.01f;
+            hierarchy.SetPosition(nodes[i], position);
+        }
+        auto fullStart = Clock::now();
+        hierarchy.Update();
+        auto fullEnd = Clock::now();
+        const size_t fullUpdated = hierarchy.GetLastUpdatedCount();
+
+        // Partial update: move a random 1%
+        for (int i = 0; i < entities / 100; ++i)
+        {
+            const Node node = nodes[rng() % entities];
+            XMFLOAT3 position = hierarchy.GetLocal(node).position;
+            position.x += 0.5f;
+            hierarchy.SetPosition(node, position);
+        }
+        auto partialStart = Clock::now();
+        hierarchy.Update();
+        auto partialEnd = Clock::now();
+        const size_t partialUpdated = hierarchy.GetLastUpdatedCount();
+
+        auto idleStart = Clock::now();
+        hierarchy.Update();
+        auto idleEnd = Clock::now();
+
+        ss << shape.name << " (" << hierarchy.GetDepthCount() << " levels): pointer " << ms(pointerStart, pointerEnd)
+           << ", build " << ms(buildStart, buildEnd) << ", full " << ms(fullStart, fullEnd) << " (" << fullUpdated
+           << " nodes), 1% " << ms(partialStart, partialEnd) << " (" << partialUpdated << " nodes), idle "
+           << ms(idleStart, idleEnd) << ", max error vs pointer " << maxError << "\n";
+    }
+    return ss.str();
+}
@@ -0,0 +1,168 @@
+/**
+ * @file TransformHierarchy.h
+ * @brief Depth-sorted transform hierarchy with parallel dirty propagation
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * Parent/child transforms (vehicles and their wheels, weapons attached to
+ * hands, props stacked on props) are stored breadth-first: every node of
+ * depth d sits after every node of depth d - 1, so a node's parent has always
+ * been resolved before the node itself. World matrices are then computed one
+ * depth level at a time, each level split into chunks that run as jobs,
+ * streaming through flat arrays instead of chasing parent pointers.
+ *
+ * Only dirty subtrees are recomputed: setting a local transform marks the
+ * node, and a node whose parent was recomputed this update is recomputed too.
+ * Levels above the shallowest change are skipped outright.
+ */
+
+#pragma once
+
+#include "Utils/Assert.h"
+#include <DirectXMath.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Local position, Euler rotation (radians) and scale of one node
+ *
+ * Composed as scale, then rotation (roll-pitch-yaw), then translation, the
+ * same order GameObject uses.
+ */
+struct LocalTransform
+{
+    DirectX::XMFLOAT3 position{ 0.0f, 0.0f, 0.0f };
+    DirectX::XMFLOAT3 rotation{ 0.0f, 0.0f, 0.0f };
+    DirectX::XMFLOAT3 scale{ 1.0f, 1.0f, 1.0f };
+};
+
+/**
+ * @brief Transform hierarchy that resolves world matrices level by level
+ *
+ * Nodes are addressed by stable IDs; their storage is re-sorted by depth
+ * whenever the structure changes (create, destroy, reparent), lazily on the
+ * next Update(). World matrices are valid after Update() and until the next
+ * structural change or setter call on an ancestor.
+ *
+ * Not thread safe: build and modify from one thread, Update() spreads the
+ * work over the JobSystem itself.
+ */
+class TransformHierarchy
+{
+public:
+    using Node = uint32_t;
+    static constexpr Node InvalidNode = 0xFFFFFFFFu;
+
+    TransformHierarchy() = default;
+
+    // ========================================================================
+    // STRUCTURE
+    // ========================================================================
+
+    /**
+     * @brief Add a node
+     * @param parent Parent node, or InvalidNode for a root
+     */
+    Node Create(Node parent = InvalidNode, const LocalTransform& local = {});
+
+    /**
+     * @brief Remove a node; its children become roots keeping their local transforms
+     */
+    void Destroy(Node node);
+
+    /**
+     * @brief Move a node (and its subtree) under another parent, or to the root with InvalidNode
+     */
+    void SetParent(Node node, Node parent);
+
+    bool IsValid(Node node) const { return node < m_alive.size() && m_alive[node]; }
+    Node GetParent(Node node) const;
+
+    /**
+     * @brief Destroy every node
+     */
+    void Clear();
+
+    // ========================================================================
+    // LOCAL TRANSFORMS
+    // ========================================================================
+
+    /**
+     * @brief Replace a node's local transform; marks it dirty only if a value changed
+     */
+    void SetLocal(Node node, const LocalTransform& local);
+    void SetPosition(Node node, const DirectX::XMFLOAT3& position);
+    void SetRotation(Node node, const DirectX::XMFLOAT3& rotation);
+    void SetScale(Node node, const DirectX::XMFLOAT3& scale);
+
+    const LocalTransform& GetLocal(Node node) const;
+
+    // ========================================================================
+    // PROPAGATION
+    // ========================================================================
+
+    /**
+     * @brief Re-sort if the structure changed, then recompute the world matrix of every dirty subtree
+     */
+    void Update();
+
+    const DirectX::XMFLOAT4X4& GetWorldMatrix(Node node) const;
+
+    size_t GetNodeCount() const { return m_nodeCount; }
+    uint32_t GetDepthCount() const { return static_cast<uint32_t>(m_levelStart.empty() ? 0 : m_levelStart.size() - 1); }
+
+    /**
+     * @brief World matrices recomputed by the last Update()
+     */
+    size_t GetLastUpdatedCount() const { return m_lastUpdated; }
+
+    // ========================================================================
+    // CONSOLE INTEGRATION
+    // ========================================================================
+
+    /**
+     * @brief Build hierarchies of several shapes and time full, partial and idle updates
+     *
+     * Each shape is also built as a heap-allocated pointer scene graph and
+     * resolved recursively from its roots, both as a baseline and to check
+     * the propagated matrices.
+     *
+     * @param entities Nodes per hierarchy
+     */
+    static std::string Console_Benchmark(int entities);
+
+private:
+    static constexpr uint32_t NoDirtyDepth = 0xFFFFFFFFu;
+    static constexpr uint32_t NodesPerJob = 1024;
+
+    uint32_t DenseOf(Node node) const;
+    void MarkDirty(uint32_t dense);
+    void UnlinkFromParent(Node node);
+    void RebuildOrder();
+
+    // Per node ID
+    std::vector<Node>      m_parent;
+    std::vector<Node>      m_firstChild;
+    std::vector<Node>      m_nextSibling;
+    std::vector<uint8_t>   m_alive;
+    std::vector<uint32_t>  m_denseOfNode;
+    std::vector<Node>      m_freeNodes;
+    size_t                 m_nodeCount = 0;
+
+    // Dense storage: sorted by depth after RebuildOrder(), appended to in between
+    std::vector<Node>                   m_nodeOfDense;
+    std::vector<uint32_t>               m_parentDense;    ///< Dense index of the parent, or InvalidNode
+    std::vector<uint32_t>               m_depth;
+    std::vector<LocalTransform>         m_local;
+    std::vector<DirectX::XMFLOAT4X4>    m_world;
+    std::vector<uint8_t>                m_dirty;          ///< Local transform changed since the last Update()
+    std::vector<uint32_t>               m_updatedStamp;   ///< m_updateStamp of the last recompute
+
+    std::vector<uint32_t>  m_levelStart;      ///< Dense range of depth d is [m_levelStart[d], m_levelStart[d + 1])
+    std::vector<uint32_t>  m_levelDirty;      ///< Nodes marked dirty per depth since the last Update()
+    bool                   m_orderDirty = false;
+    uint32_t               m_minDirtyDepth = NoDirtyDepth;
+    uint32_t               m_updateStamp = 0;
+    size_t                 m_lastUpdated = 0;
+};
@@ -28,6 +28,7 @@
 #include "..\SceneManager\SceneManager.h"
 #include "..\Utils\SparkConsole.h"
 #include "..\Console\AdvancedConsoleCommands.h"
+#include "..\Core\JobSystem.h"
 
 // Pull in globals defined in SparkEngine.cpp
 extern std::unique_ptr<GraphicsEngine> g_graphics;
@@ -145,6 +146,9 @@ HRESULT Game::Initialize(GraphicsEngine* graphics,
 
     /* Scene objects ----------------------------------------*/
     CreateTestObjects();
+
+    /* Fixed-tick systems -----------------------------------*/
+    if (m_fixedSystems.GetSystemCount() == 0) RegisterFixedSystems();
     LOG_TO_CONSOLE_IMMEDIATE(L"Game initialization complete - unified rendering ready", L"SUCCESS");
 
     /* Register Advanced Console Commands */
@@ -183,12 +187,15 @@ void Game::Update(float dt)
         return;
     }
 
+    // Look, zoom and edge-triggered actions run every frame so they stay
+    // responsive and are never dropped or repeated by the tick count
     HandleInput(dt);
-    UpdateCamera(dt);
-    UpdateGameObjects(dt);
+    if (m_player) m_player->HandleInput(dt);
 
-    if (m_player)         m_player->Update(dt);
-    if (m_projectilePool) m_projectilePool->Update(dt);
+    // Simulation runs at a fixed rate; time scale stretches wall time
+    m_simulationClock.Advance(static_cast<double>(dt) * m_timeScale,
+        [this](float step) { FixedUpdate(step); });
+    GameObject::SetInterpolationAlpha(m_simulationClock.GetAlpha());
 
     // **UPDATE: Update advanced systems through main GraphicsEngine**
     if (m_graphics) {
@@ -198,10 +205,59 @@ void Game::Update(float dt)
         if (auto assetPipeline = m_graphics->GetAssetPipeline()) {
             assetPipeline->Update(dt);
         }
+    }
+}
+
+/*-------------------------------------------------------------
+  One fixed simulation tick
+--------------------------------------------------------------*/
+void Game::FixedUpdate(float step)
+{
+    m_fixedSystems.Run(step);
+}
+
+/*-------------------------------------------------------------
+  Fixed-tick systems, in serial order
+--------------------------------------------------------------*/
+void Game::RegisterFixedSystems()
+{
+    // Snapshot the state this tick starts from for render interpolation
+    m_fixedSystems.AddSystem("CameraSnapshot", SystemAccess().Read<SparkEngineCamera>(), [this](float) {
+        if (!m_camera) return;
+        m_previousCameraPosition = m_camera->GetPosition();
+        m_hasPreviousCameraPosition = true;
+    });
+    m_fixedSystems.AddSystem("ObjectSnapshot", SystemAccess().Write<GameObject>(), [this](float) {
+        for (auto& obj : m_gameObjects)
+            if (obj) obj->SavePreviousTransform();
+        if (m_sceneManager) {
+            for (auto& obj : m_sceneManager->GetObjects())
+                if (obj) obj->SavePreviousTransform();
+        }
+    });
+
+    // Camera and player chain; runs alongside the game objects
+    m_fixedSystems.AddSystem("MovementInput", SystemAccess().Read<InputManager>().Write<SparkEngineCamera>(),
+        [this](float step) { HandleMovementInput(step); });
+    m_fixedSystems.AddSystem("Camera", SystemAccess().Write<SparkEngineCamera>(),
+        [this](float step) { UpdateCamera(step); });
+    m_fixedSystems.AddSystem("GameObjects", SystemAccess().Write<GameObject>(),
+        [this](float step) { UpdateGameObjects(step); });
+    m_fixedSystems.AddSystem("Player", SystemAccess().Read<InputManager>().Write<Player, SparkEngineCamera>(),
+        [this](float step) { if (m_player) m_player->Update(step); });
+
+    m_fixedSystems.AddSystem("ProjectileColliders", SystemAccess().Read<GameObject>().Write<ProjectilePool>(),
+        [this](float) { if (m_projectilePool) UpdateProjectileColliders(); });
+    m_fixedSystems.AddSystem("Projectiles", SystemAccess().Write<ProjectilePool>(),
+        [this](float step) { if (m_projectilePool) m_projectilePool->Update(step); });
+
+    // Contact callbacks can reach any game state
+    m_fixedSystems.AddSystem("Physics", SystemAccess::Exclusive(), [this](float step) {
+        if (!m_graphics) return;
         if (auto physicsSystem = m_graphics->GetPhysicsSystem()) {
-            physicsSystem->Update(dt);
+            physicsSystem->Update(step);
         }
-    }
+    });
 }
 
 /*-------------------------------------------------------------
@@ -219,28 +275,41 @@ void Game::Render()
     try {
         m_graphics->BeginFrame();
         
-        // Collect all renderable objects for unified rendering
-        std::vector<GameObject*> renderableObjects;
-        
-        // Add game objects
-        for (auto& obj : m_gameObjects) {
-            if (obj && obj->IsActive() && obj->IsVisible()) {
-                renderableObjects.push_back(obj.get());
-            }
+        // **UNIFIED RENDERING: Use the complete modern graphics pipeline**
+        XMMATRIX view = m_camera->GetViewMatrix();
+        if (m_hasPreviousCameraPosition) {
+            XMFLOAT3 eye;
+            XMFLOAT3 current = m_camera->GetPosition();
+            XMStoreFloat3(&eye, XMVectorLerp(XMLoadFloat3(&m_previousCameraPosition), XMLoadFloat3(&current),
+                m_simulationClock.GetAlpha()));
+            view = m_camera->GetViewMatrixAt(eye);
         }
+        XMMATRIX proj = m_camera->GetProjectionMatrix();
 
-        // Add scene manager objects
-        if (m_sceneManager) {
-            for (auto& obj : m_sceneManager->GetObjects()) {
-                if (obj && obj->IsActive() && obj->IsVisible()) {
-                    renderableObjects.push_back(obj.get());
-                }
+        // Collect all renderable objects for unified rendering; the list only
+        // lives for this frame, so it comes from the frame arena
+        UpdateSceneIndex();
+        FrameVector<GameObject*> renderableObjects;
+        renderableObjects.reserve(m_sceneIndex.GetCount());
+
+        auto addRenderable = [&renderableObjects](GameObject* obj) {
+            if (obj && obj->IsActive() && obj->IsVisible()) {
+                renderableObjects.push_back(obj);
+            }
+        };
+        if (m_graphics->GetGraphicsSettings().frustumCulling) {
+            // Whole octree cells outside the view are skipped; the renderer culls the survivors per object
+            m_sceneIndex.QueryFrustum(Frustum::FromViewProjection(XMMatrixMultiply(view, proj)),
+                [&](SceneOctree::Handle handle) {
+                    addRenderable(static_cast<GameObject*>(m_sceneIndex.GetUserData(handle)));
+                    return true;
+                });
+        } else {
+            for (auto& obj : m_gameObjects) addRenderable(obj.get());
+            if (m_sceneManager) {
+                for (auto& obj : m_sceneManager->GetObjects()) addRenderable(obj.get());
             }
         }
-
-        // **UNIFIED RENDERING: Use the complete modern graphics pipeline**
-        XMMATRIX view = m_camera->GetViewMatrix();
-        XMMATRIX proj = m_camera->GetProjectionMatrix();
         
         // Call the unified RenderScene method
         m_graphics->RenderScene(view, proj, renderableObjects);
@@ -302,12 +371,107 @@ void Game::UpdateGameObjects(float dt)
 {
     // No logging for per-frame operations
     ASSERT(dt >= 0.0f);
+
+    // Update() only touches the object's own state, so chunks of objects run
+    // as jobs; small scenes fit in one chunk and stay on this thread
+    constexpr uint32_t ObjectsPerJob = 64;
+    JobSystem::GetInstance().ParallelFor(static_cast<uint32_t>(m_gameObjects.size()), ObjectsPerJob,
+        [this, dt](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                auto& obj = m_gameObjects[i];
+                if (obj && obj->IsActive()) obj->Update(dt);
+            }
+        });
+}
+
+/*-------------------------------------------------------------
+  World colliders for projectile sweeps
+--------------------------------------------------------------*/
+void Game::UpdateProjectileColliders()
+{
+    auto forEachObject = [this](auto&& visit) {
+        for (auto& obj : m_gameObjects)
+            if (obj && obj->IsActive()) visit(obj.get());
+        if (m_sceneManager) {
+            for (auto& obj : m_sceneManager->GetObjects())
+                if (obj && obj->IsActive()) visit(obj.get());
+        }
+    };
+
+    // Objects are visited in the same order every tick, so while the set is
+    // unchanged only the boxes of objects that moved are rewritten
+    size_t next = 0;
+    bool rebuild = false;
+    forEachObject([&](GameObject* obj) {
+        if (rebuild) return;
+        if (next >= m_colliderObjects.size() || m_colliderObjects[next] != obj) {
+            rebuild = true;
+            return;
+        }
+        const uint32_t box = m_colliderBoxes[next++];
+        if (!obj->ConsumeWorldBoundsChanged()) return;
+
+        XMFLOAT3 minimum, maximum;
+        const bool bounded = obj->GetWorldBounds(minimum, maximum);
+        if (bounded != (box != NoColliderBox)) rebuild = true;
+        else if (bounded) m_projectilePool->SetWorldBox(box, BoundingBox(minimum, maximum));
+    });
+    if (!rebuild && next == m_colliderObjects.size()) return;
+
+    m_projectilePool->ClearWorldColliders();
+    m_colliderObjects.clear();
+    m_colliderBoxes.clear();
+    forEachObject([this](GameObject* obj) {
+        obj->ConsumeWorldBoundsChanged();
+        XMFLOAT3 minimum, maximum;
+        m_colliderObjects.push_back(obj);
+        m_colliderBoxes.push_back(obj->GetWorldBounds(minimum, maximum)
+                                  ? m_projectilePool->AddWorldBox(BoundingBox(minimum, maximum)) : NoColliderBox);
+    });
+}
+
+/*-------------------------------------------------------------
+  Scene spatial index
+--------------------------------------------------------------*/
+void Game::UpdateSceneIndex()
+{
+    // Objects that did not move since the last frame return at their dirty flag
     for (auto& obj : m_gameObjects)
-        if (obj && obj->IsActive()) obj->Update(dt);
+        if (obj) obj->UpdateSceneIndex(m_sceneIndex);
+    if (m_sceneManager) {
+        for (auto& obj : m_sceneManager->GetObjects())
+            if (obj) obj->UpdateSceneIndex(m_sceneIndex);
+    }
+}
+
+size_t Game::QueryObjectsInRadius(const XMFLOAT3& center, float radius, std::vector<GameObject*>& results) const
+{
+    ASSERT_MSG(radius >= 0.0f, "Query radius must be non-negative (got %f)", radius);
+    results.clear();
+    m_sceneIndex.QuerySphere(center, radius, [&](SceneOctree::Handle handle) {
+        auto* obj = static_cast<GameObject*>(m_sceneIndex.GetUserData(handle));
+        if (obj->IsActive()) results.push_back(obj);
+        return true;
+    });
+    return results.size();
+}
+
+GameObject* Game::PickObject(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance, float* hitDistance) const
+{
+    GameObject* closest = nullptr;
+    m_sceneIndex.RayCast(origin, direction, maxDistance,
+        [&](SceneOctree::Handle handle, float distance, float clip) {
+            auto* obj = static_cast<GameObject*>(m_sceneIndex.GetUserData(handle));
+            if (!obj->IsActive() || !obj->IsVisible()) return clip;
+            closest = obj;
+            if (hitDistance) *hitDistance = distance;
+            return distance;
+        });
+    return closest;
 }
 
 /*-------------------------------------------------------------
-  WASD + mouse look, zoom, and shooting input handling
+  Mouse look, zoom, and shooting input handling (per frame)
 --------------------------------------------------------------*/
 void Game::HandleInput(float dt)
 {
@@ -324,14 +488,6 @@ void Game::HandleInput(float dt)
         m_camera->Pitch(-dy * mouseSens);
     }
 
-    float moveSpeed = 10.0f * dt;
-    if (m_input->IsKeyDown('W'))         m_camera->MoveForward(moveSpeed);
-    if (m_input->IsKeyDown('S'))         m_camera->MoveForward(-moveSpeed);
-    if (m_input->IsKeyDown('A'))         m_camera->MoveRight(-moveSpeed);
-    if (m_input->IsKeyDown('D'))         m_camera->MoveRight(moveSpeed);
-    if (m_input->IsKeyDown(VK_SPACE))    m_camera->MoveUp(moveSpeed);
-    if (m_input->IsKeyDown(VK_LCONTROL)) m_camera->MoveUp(-moveSpeed);
-
     m_camera->SetZoom(m_input->IsMouseButtonDown(1));
 
     if (m_input->WasMouseButtonPressed(0) && m_projectilePool)
@@ -345,6 +501,25 @@ void Game::HandleInput(float dt)
     }
 }
 
+/*-------------------------------------------------------------
+  WASD movement input handling (per simulation tick)
+--------------------------------------------------------------*/
+void Game::HandleMovementInput(float dt)
+{
+    ASSERT(dt >= 0.0f);
+    if (!m_input || !m_camera) {
+        return;
+    }
+
+    float moveSpeed = 10.0f * dt;
+    if (m_input->IsKeyDown('W'))         m_camera->MoveForward(moveSpeed);
+    if (m_input->IsKeyDown('S'))         m_camera->MoveForward(-moveSpeed);
+    if (m_input->IsKeyDown('A'))         m_camera->MoveRight(-moveSpeed);
+    if (m_input->IsKeyDown('D'))         m_camera->MoveRight(moveSpeed);
+    if (m_input->IsKeyDown(VK_SPACE))    m_camera->MoveUp(moveSpeed);
+    if (m_input->IsKeyDown(VK_LCONTROL)) m_camera->MoveUp(-moveSpeed);
+}
+
 /*-------------------------------------------------------------
   Spawn placeholder objects
 --------------------------------------------------------------*/
@@ -664,6 +839,18 @@ void Game::SetTimeScale(float scale)
     LOG_TO_CONSOLE_IMMEDIATE(scaleMsg, L"SUCCESS");
 }
 
+void Game::SetTickRate(double ticksPerSecond)
+{
+    if (ticksPerSecond < FixedTimestep::MinTickRate || ticksPerSecond > FixedTimestep::MaxTickRate) {
+        LOG_TO_CONSOLE_IMMEDIATE(L"Tick rate out of range (1-1000), clamping", L"WARNING");
+    }
+
+    m_simulationClock.SetTickRate(ticksPerSecond);
+
+    std::wstring rateMsg = L"Simulation tick rate set to " + std::to_wstring(m_simulationClock.GetTickRate()) + L" Hz";
+    LOG_TO_CONSOLE_IMMEDIATE(rateMsg, L"SUCCESS");
+}
+
 // ============================================================================
 // ENHANCED GRAPHICS INTEGRATION METHODS - Full Implementation
 // ============================================================================
@@ -31,6 +31,9 @@ class ProjectilePool;
 #include "PlaneObject.h"
 #include "SphereObject.h"
 #include "SceneManager/SceneManager.h"
+#include "SceneManager/SceneOctree.h"
+#include "Utils/FixedTimestep.h"
+#include "Engine/ECS/SystemScheduler.h"
 
 /**
  * @brief Main game controller class managing the game loop and scene
@@ -204,6 +207,33 @@ public:
      * @return Current time scale multiplier
      */
     float GetTimeScale() const { return m_timeScale; }
+
+    /**
+     * @brief Set the fixed simulation tick rate
+     * @param ticksPerSecond Simulation ticks per second (clamped to 1-1000)
+     *
+     * Rendering is decoupled from the tick rate; objects are drawn at a blend
+     * of their last two simulated states.
+     */
+    void SetTickRate(double ticksPerSecond);
+
+    /**
+     * @brief Get the fixed simulation tick rate
+     * @return Simulation ticks per second
+     */
+    double GetTickRate() const { return m_simulationClock.GetTickRate(); }
+
+    /**
+     * @brief Get the fixed-step simulation clock for statistics
+     * @return Reference to the simulation clock
+     */
+    const FixedTimestep& GetSimulationClock() const { return m_simulationClock; }
+
+    /**
+     * @brief Get the scheduler running the fixed-tick systems, for statistics
+     * @return Reference to the fixed-tick scheduler
+     */
+    const SystemScheduler& GetFixedSystems() const { return m_fixedSystems; }
     
     // ============================================================================
     // ENHANCED ACCESSOR METHODS - Full System Integration
@@ -248,6 +278,34 @@ public:
         return (index < m_gameObjects.size()) ? m_gameObjects[index].get() : nullptr;
     }
 
+    // ============================================================================
+    // SPATIAL QUERIES
+    // ============================================================================
+
+    /**
+     * @brief Loose octree over the world bounds of every game and scene object
+     *
+     * Brought up to date at the start of Render(), so queries see the
+     * transforms of the last rendered frame.
+     */
+    const SceneOctree& GetSceneIndex() const { return m_sceneIndex; }
+
+    /**
+     * @brief Active objects whose world bounds come within radius of centre
+     * @param results Cleared, then filled with the objects found
+     * @return Number of objects found
+     */
+    size_t QueryObjectsInRadius(const XMFLOAT3& center, float radius, std::vector<GameObject*>& results) const;
+
+    /**
+     * @brief Closest active object whose world bounds the ray hits, for editor picking
+     * @param direction Normalized ray direction
+     * @param hitDistance Receives the distance to the object's bounds, if not null
+     * @return The object, or null if nothing is hit within maxDistance
+     */
+    GameObject* PickObject(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance,
+                           float* hitDistance = nullptr) const;
+
     // ============================================================================
     // ENHANCED GRAPHICS INTEGRATION METHODS
     // ============================================================================
@@ -304,6 +362,24 @@ public:
     void CreateTestScene(const std::string& sceneType);
 
 private:
+    /**
+     * @brief Advance the simulation by one fixed tick
+     * @param step Tick length in seconds
+     *
+     * Runs the systems registered by RegisterFixedSystems(): saving the
+     * previous transforms used for render interpolation, then movement, game
+     * objects, player, projectiles and physics.
+     */
+    void FixedUpdate(float step);
+
+    /**
+     * @brief Register the fixed-tick systems with their data access
+     *
+     * Registration order is the serial order; systems touching disjoint data
+     * (game objects versus the camera and player) run at the same time.
+     */
+    void RegisterFixedSystems();
+
     /**
      * @brief Update the camera based on input and game state
      * @param dt Delta time for frame-rate independent movement
@@ -317,11 +393,27 @@ private:
     void UpdateGameObjects(float dt);
 
     /**
-     * @brief Process input and translate to game actions
-     * @param dt Delta time for frame-rate independent input handling
+     * @brief Bring the projectile pool's world colliders up to date with the scene objects
+     *
+     * Runs every tick before projectiles are swept. Only the boxes of objects
+     * that moved are rewritten; the set is rebuilt when objects are spawned,
+     * removed, or gain or lose bounds.
+     */
+    void UpdateProjectileColliders();
+    static constexpr uint32_t NoColliderBox = 0xFFFFFFFF;
+
+    /**
+     * @brief Process per-frame input: mouse look, zoom and shooting
+     * @param dt Frame delta time
      */
     void HandleInput(float dt);
 
+    /**
+     * @brief Process held movement keys for one simulation tick
+     * @param dt Tick length in seconds
+     */
+    void HandleMovementInput(float dt);
+
     /**
      * @brief Create initial test objects for the scene
      * 
@@ -330,20 +422,36 @@ private:
      */
     void CreateTestObjects();
 
+    /**
+     * @brief Add new game and scene objects to m_sceneIndex and relocate the ones that moved
+     */
+    void UpdateSceneIndex();
+
     // Engine-side pointers (not owned)
     GraphicsEngine* m_graphics{ nullptr }; ///< Reference to graphics engine
     InputManager* m_input{ nullptr };      ///< Reference to input manager
 
+    // Declared before every object owner: objects remove themselves from it on destruction
+    SceneOctree m_sceneIndex;                           ///< Spatial index of game and scene objects
+
     // Sub-systems owned by Game (unified system - no separate shader management)
     std::unique_ptr<SparkEngineCamera> m_camera;        ///< First-person camera system
     std::unique_ptr<Player>            m_player;        ///< Player controller
     std::unique_ptr<ProjectilePool>    m_projectilePool; ///< Projectile object pool
+    std::vector<GameObject*>           m_colliderObjects; ///< Active objects behind the pool's world boxes, in visit order; compared, never dereferenced
+    std::vector<uint32_t>              m_colliderBoxes;  ///< World box of each m_colliderObjects entry, or NoColliderBox
     std::unique_ptr<SceneManager>      m_sceneManager;  ///< Scene management
 
     // Scene objects
     std::vector<std::unique_ptr<GameObject>> m_gameObjects; ///< All game objects in the scene
 
     bool m_isPaused{ false }; ///< Current pause state of the game
+
+    // Fixed-step simulation
+    FixedTimestep m_simulationClock;            ///< Accumulator driving FixedUpdate()
+    SystemScheduler m_fixedSystems;             ///< Systems run by FixedUpdate()
+    XMFLOAT3 m_previousCameraPosition{ 0, 0, 0 }; ///< Camera position at the previous tick
+    bool m_hasPreviousCameraPosition{ false };  ///< False until the first tick has run
     
     // Console integration state
     float m_timeScale{ 1.0f };     ///< Global time scale multiplier for console control
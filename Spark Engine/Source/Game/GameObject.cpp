@@ -7,12 +7,22 @@
 #include "..\Utils\MathUtils.h"
 #include "Utils/Assert.h"
 #include "../Graphics/GraphicsEngine.h"  // ✅ ADD: For shader access
+#include "../Graphics/CullingSystem.h"
+#include "../SceneManager/SceneOctree.h"
+#include "../Graphics/MaterialSystem.h"
+#include "../Graphics/RenderQueue.h"
+#include "../Graphics/CommandBuffer.h"
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
 #include <iostream>
 
 using namespace DirectX;
 
-// Definition and initialization of the static member
+// Definition and initialization of the static members
 UINT GameObject::s_nextID = 1;
+float GameObject::s_interpolationAlpha = 1.0f;
 
 GameObject::GameObject()
     : m_position{ 0,0,0 }
@@ -31,6 +41,8 @@ GameObject::GameObject()
 GameObject::~GameObject()
 {
     std::wcout << L"[INFO] GameObject destructor called. ID=" << m_id << L" Name=" << m_name.c_str() << std::endl;
+    if (m_cullHandle != CullingSystem::InvalidHandle) CullingSystem::GetInstance().Unregister(m_cullHandle);
+    if (m_sceneIndex) m_sceneIndex->Remove(m_sceneIndexHandle);
     Shutdown();
 }
 
@@ -51,6 +63,10 @@ HRESULT GameObject::Initialize(ID3D11Device* device, ID3D11DeviceContext* contex
         return hr;
     }
     CreateMesh();
+    m_localBoundsValid = false;
+    m_cullBoundsDirty = true;
+    m_sceneBoundsDirty = true;
+    m_worldBoundsChanged = true;
     std::wcout << L"[INFO] GameObject::Initialize complete. ID=" << m_id << L" Name=" << m_name.c_str() << std::endl;
     return S_OK;
 }
@@ -71,9 +87,11 @@ void GameObject::Update(float dt)
     if (m_worldMatrixDirty) UpdateWorldMatrix();
     
     // **ONLY log update statistics occasionally for debugging**
-    static int updateCallCount = 0;
-    if (++updateCallCount % 7200 == 0) { // Every 2 minutes at 60fps
-        std::wcout << L"[DEBUG] GameObject updated " << updateCallCount << L" times. ID=" << m_id 
+    // Atomic: Game::UpdateGameObjects() updates objects from several jobs at once
+    static std::atomic<int> updateCallCount{ 0 };
+    const int updateCount = ++updateCallCount;
+    if (updateCount % 7200 == 0) { // Every 2 minutes at 60fps
+        std::wcout << L"[DEBUG] GameObject updated " << updateCount << L" times. ID=" << m_id 
                    << L" Name=" << m_name.c_str() << std::endl;
     }
 }
@@ -86,31 +104,45 @@ void GameObject::Render(const XMMATRIX& view, const XMMATRIX& projection)
         return; // No logging for performance - this happens frequently
     }
     
-    if (m_worldMatrixDirty) UpdateWorldMatrix();
-    
-    ASSERT(m_mesh);
-    ASSERT_MSG(m_device != nullptr, "GameObject::Render - device is null");
-    ASSERT_MSG(m_context != nullptr, "GameObject::Render - context is null");
-    ASSERT_MSG(m_mesh->GetVertexCount() > 0 && m_mesh->GetIndexCount() > 0, "Mesh has no vertices or indices to render");
-    
-    // ✅ ENHANCED: Get graphics engine reference and set up shaders
+    // ✅ ENHANCED: Record shaders, material and draw, then replay through the engine's backend
     extern std::unique_ptr<GraphicsEngine> g_graphics;
     GraphicsEngine* graphics = g_graphics.get();
-    
-    if (graphics) {
-        // Set up basic shaders and constant buffers
-        graphics->SetBasicShaders();
-        graphics->UpdateBasicConstants(m_worldMatrix, view, projection);
+    if (!graphics) {
+        return;
     }
+
+    thread_local CommandBuffer buffer;
+    buffer.Begin(view, projection);
+    buffer.BindBasicShaders();
+    buffer.BindMaterial(m_material.get());
+    FlushWorldMatrix();
+    Record(buffer);
+    graphics->ExecuteCommands(buffer);
+}
+
+void GameObject::Record(CommandBuffer& buffer) const
+{
+    if (!m_visible || !m_mesh) return;
+
+    ASSERT_MSG(m_mesh->GetVertexCount() > 0 && m_mesh->GetIndexCount() > 0, "Mesh has no vertices or indices to render");
+    
+    buffer.SetObjectConstants(GetRenderWorldMatrix());
+    const MeshLodLevel lod = m_mesh->GetLod(m_lod);
+    buffer.DrawMesh(m_mesh.get(), lod.indexCount, lod.firstIndex);
     
     // **ONLY log rendering statistics occasionally for debugging**
-    static int renderCallCount = 0;
-    if (++renderCallCount % 3600 == 0) { // Every 60 seconds at 60fps
-        std::wcout << L"[DEBUG] GameObject rendered " << renderCallCount << L" times. ID=" << m_id 
+    // Atomic: GraphicsEngine records draws from several jobs at once
+    static std::atomic<int> renderCallCount{ 0 };
+    const int renderCount = ++renderCallCount;
+    if (renderCount % 3600 == 0) { // Every 60 seconds at 60fps
+        std::wcout << L"[DEBUG] GameObject rendered " << renderCount << L" times. ID=" << m_id 
                    << L" verts=" << m_mesh->GetVertexCount() << L" inds=" << m_mesh->GetIndexCount() << std::endl;
     }
-    
-    m_mesh->Render(m_context);
+}
+
+uint32_t GameObject::GetShaderVariant() const
+{
+    return RenderShader::Basic;
 }
 
 void GameObject::SetPosition(const XMFLOAT3& pos)
@@ -168,6 +200,48 @@ XMMATRIX GameObject::GetWorldMatrix()
     return m_worldMatrix;
 }
 
+void GameObject::SavePreviousTransform()
+{
+    m_previousPosition = m_position;
+    m_previousRotation = m_rotation;
+    m_previousScale = m_scale;
+    m_hasPreviousTransform = true;
+}
+
+void GameObject::SetInterpolationAlpha(float alpha)
+{
+    ASSERT_MSG(std::isfinite(alpha), "Interpolation alpha must be finite (got %f)", alpha);
+    s_interpolationAlpha = std::clamp(alpha, 0.0f, 1.0f);
+}
+
+XMMATRIX GameObject::GetRenderWorldMatrix() const
+{
+    const float alpha = s_interpolationAlpha;
+    if (!m_hasPreviousTransform || alpha >= 1.0f) {
+        ASSERT_MSG(!m_worldMatrixDirty, "GameObject %u rendered with a stale world matrix; call FlushWorldMatrix() first", m_id);
+        return m_worldMatrix;
+    }
+
+    // Blend translation and scale linearly; slerp the rotation so large turns stay rigid
+    const XMVECTOR position = XMVectorLerp(XMLoadFloat3(&m_previousPosition), XMLoadFloat3(&m_position), alpha);
+    const XMVECTOR scale = XMVectorLerp(XMLoadFloat3(&m_previousScale), XMLoadFloat3(&m_scale), alpha);
+    const XMVECTOR previousRotation = XMQuaternionRotationRollPitchYaw(m_previousRotation.x, m_previousRotation.y, m_previousRotation.z);
+    const XMVECTOR currentRotation = XMQuaternionRotationRollPitchYaw(m_rotation.x, m_rotation.y, m_rotation.z);
+    const XMVECTOR rotation = XMQuaternionSlerp(previousRotation, currentRotation, alpha);
+
+    return XMMatrixScalingFromVector(scale) * XMMatrixRotationQuaternion(rotation) * XMMatrixTranslationFromVector(position);
+}
+
+XMFLOAT3 GameObject::GetRenderPosition() const
+{
+    if (!m_hasPreviousTransform || s_interpolationAlpha >= 1.0f)
+        return m_position;
+
+    XMFLOAT3 out;
+    XMStoreFloat3(&out, XMVectorLerp(XMLoadFloat3(&m_previousPosition), XMLoadFloat3(&m_position), s_interpolationAlpha));
+    return out;
+}
+
 XMFLOAT3 GameObject::GetForward() const
 {
     XMMATRIX rot = XMMatrixRotationRollPitchYaw(m_rotation.x, m_rotation.y, m_rotation.z);
@@ -206,6 +280,81 @@ float GameObject::GetDistanceFrom(const XMFLOAT3& pos) const
     return sqrtf(dx * dx + dy * dy + dz * dz);
 }
 
+bool GameObject::GetWorldBounds(XMFLOAT3& minimum, XMFLOAT3& maximum)
+{
+    if (!m_localBoundsValid)
+        m_localBoundsValid = m_mesh && m_mesh->GetLocalBounds(m_localBoundsMin, m_localBoundsMax);
+    if (!m_localBoundsValid)
+        return false;
+    const XMFLOAT3& localMin = m_localBoundsMin;
+    const XMFLOAT3& localMax = m_localBoundsMax;
+
+    // Transform the eight local corners; rotated objects get a looser box
+    const XMMATRIX world = GetWorldMatrix();
+    XMVECTOR lo = XMVectorReplicate(FLT_MAX);
+    XMVECTOR hi = XMVectorReplicate(-FLT_MAX);
+    for (int i = 0; i < 8; ++i)
+    {
+        const XMVECTOR corner = XMVectorSet((i & 1) ? localMax.x : localMin.x,
+                                            (i & 2) ? localMax.y : localMin.y,
+                                            (i & 4) ? localMax.z : localMin.z, 1.0f);
+        const XMVECTOR p = XMVector3TransformCoord(corner, world);
+        lo = XMVectorMin(lo, p);
+        hi = XMVectorMax(hi, p);
+    }
+    XMStoreFloat3(&minimum, lo);
+    XMStoreFloat3(&maximum, hi);
+    return true;
+}
+
+bool GameObject::ConsumeWorldBoundsChanged()
+{
+    FlushWorldMatrix();
+    const bool changed = m_worldBoundsChanged;
+    m_worldBoundsChanged = false;
+    return changed;
+}
+
+uint32_t GameObject::UpdateCullingBounds()
+{
+    CullingSystem& culling = CullingSystem::GetInstance();
+    if (m_cullHandle == CullingSystem::InvalidHandle) {
+        m_cullHandle = culling.Register(this);
+        m_cullBoundsDirty = true;
+    }
+    if (m_worldMatrixDirty) UpdateWorldMatrix();
+    if (!m_cullBoundsDirty) return m_cullHandle;
+
+    // Scanning the vertices is the expensive part; only redo it when the mesh changes
+    if (!m_localBoundsValid)
+        m_localBoundsValid = m_mesh && m_mesh->GetLocalBounds(m_localBoundsMin, m_localBoundsMax);
+
+    if (m_localBoundsValid) culling.SetBounds(m_cullHandle, m_localBoundsMin, m_localBoundsMax, GetWorldMatrix());
+    else culling.SetUnbounded(m_cullHandle);
+    m_cullBoundsDirty = false;
+    return m_cullHandle;
+}
+
+void GameObject::UpdateSceneIndex(SceneOctree& index)
+{
+    ASSERT_MSG(!m_sceneIndex || m_sceneIndex == &index, "GameObject %u already belongs to another scene index", m_id);
+    const uint32_t cullHandle = UpdateCullingBounds();
+    if (m_sceneIndex && !m_sceneBoundsDirty) return;
+
+    if (!m_sceneIndex) {
+        m_sceneIndexHandle = index.Insert(this);
+        m_sceneIndex = &index;
+    }
+    if (m_localBoundsValid) {
+        XMFLOAT3 minimum, maximum;
+        CullingSystem::GetInstance().GetWorldBox(cullHandle, minimum, maximum);
+        index.SetBounds(m_sceneIndexHandle, minimum, maximum);
+    } else {
+        index.SetUnbounded(m_sceneIndexHandle);
+    }
+    m_sceneBoundsDirty = false;
+}
+
 void GameObject::CreateMesh()
 {
     // **FIXED: Reduced excessive logging**
@@ -251,4 +400,7 @@ void GameObject::UpdateWorldMatrix()
     XMMATRIX T = XMMatrixTranslation(m_position.x, m_position.y, m_position.z);
     m_worldMatrix = S * R * T;
     m_worldMatrixDirty = false;
+    m_cullBoundsDirty = true;
+    m_sceneBoundsDirty = true;
+    m_worldBoundsChanged = true;
 }
\ No newline at end of file
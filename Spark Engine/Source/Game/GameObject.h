@@ -21,6 +21,9 @@
 // Forward‐declare Projectile to avoid include cycles
 namespace Projectiles { class Projectile; }
 using Projectiles::Projectile;
+class SceneOctree;
+class Material;
+class CommandBuffer;
 
 /**
  * @brief Base class for all game objects in the world
@@ -87,6 +90,32 @@ public:
      */
     virtual void    Render(const XMMATRIX& view, const XMMATRIX& projection);
 
+    /**
+     * @brief Record the object constants and mesh draw, assuming the caller recorded the basic shaders and GetMaterial()
+     *
+     * Used by the sorted render queue, which binds state once per group. Only
+     * reads the object, so different objects may be recorded on different threads
+     * once FlushWorldMatrix() has run on the owning thread.
+     */
+    void            Record(CommandBuffer& buffer) const;
+
+    /**
+     * @brief Rebuild the cached world matrix if the transform changed
+     *
+     * Call before handing the object to a recording job: Record() reads the
+     * cached matrix and must not rebuild it from a worker thread.
+     */
+    void            FlushWorldMatrix() { if (m_worldMatrixDirty) UpdateWorldMatrix(); }
+
+    /**
+     * @brief Shader variant for draw sorting
+     * @return RenderShader::Basic, or RenderShader::Custom if Render() binds its own state
+     */
+    virtual uint32_t GetShaderVariant() const;
+
+    void      SetMaterial(std::shared_ptr<Material> material) { m_material = std::move(material); }
+    Material* GetMaterial() const { return m_material.get(); }
+
     /**
      * @brief Clean up all resources used by the game object
      * 
@@ -222,6 +251,33 @@ public:
      */
     void SetVisible(bool v) { m_visible = v; }
 
+    /**
+     * @brief Mark the object as an occluder for software occlusion culling
+     *
+     * Occluders are rasterised into the occlusion buffer before other objects
+     * are tested against it, so they should be large, opaque and cheap.
+     */
+    void SetOccluder(bool occluder) { m_occluder = occluder; }
+    bool IsOccluder() const { return m_occluder; }
+
+    /**
+     * @brief Mark the object as static scenery that rarely moves
+     *
+     * Static objects are drawn into the cached static layer of shadow maps;
+     * moving one is still correct but redraws every shadow map it is in.
+     */
+    void SetStatic(bool isStatic) { m_static = isStatic; }
+    bool IsStatic() const { return m_static; }
+
+    /**
+     * @brief Set the mesh level of detail Record() draws
+     *
+     * Chosen by the renderer each frame from the object's size on screen;
+     * levels past the mesh's last level draw the last level.
+     */
+    void SetLod(uint32_t lod) { m_lod = lod; }
+    uint32_t GetLod() const { return m_lod; }
+
     /**
      * @brief Get the unique identifier of the object
      * @return Unique ID assigned during construction
@@ -260,6 +316,78 @@ public:
      */
     float GetDistanceFrom(const XMFLOAT3& p) const;
 
+    /**
+     * @brief World-space axis-aligned bounds of the object's mesh
+     * @param minimum Receives the smallest corner
+     * @param maximum Receives the largest corner
+     * @return false if the object has no mesh data
+     *
+     * Transforms the local box cached with the mesh, so only the first call after a mesh change scans vertices.
+     */
+    bool GetWorldBounds(XMFLOAT3& minimum, XMFLOAT3& maximum);
+
+    /**
+     * @brief Whether GetWorldBounds() changed since the previous call, clearing the flag
+     *
+     * For a single consumer that keeps a copy of the bounds, such as Game's projectile colliders.
+     */
+    bool ConsumeWorldBoundsChanged();
+
+    /**
+     * @brief Register with CullingSystem::GetInstance() and refresh the world bounds there if the transform or mesh changed
+     * @return The object's culling handle
+     *
+     * Called by the renderer on its own thread; the object unregisters itself on destruction.
+     */
+    uint32_t UpdateCullingBounds();
+
+    /**
+     * @brief Add the object to a scene index, or move its entry there if the transform or mesh changed
+     *
+     * Reuses the world box UpdateCullingBounds() keeps. An object belongs to
+     * at most one index and removes itself from it on destruction.
+     */
+    void UpdateSceneIndex(SceneOctree& index);
+
+    // ========================================================================
+    // RENDER INTERPOLATION
+    // ========================================================================
+
+    /**
+     * @brief Record the current transform as the start of the next simulation tick
+     *
+     * Called at the top of every fixed tick. Rendering blends from this
+     * snapshot towards the transform the tick produces.
+     */
+    void SavePreviousTransform();
+
+    /**
+     * @brief Forget the previous transform so the next frame renders without blending
+     *
+     * Use after teleporting or respawning so the object does not streak
+     * across the screen from its old location.
+     */
+    void ResetInterpolation() { m_hasPreviousTransform = false; }
+
+    /**
+     * @brief Set the blend factor used by every object's Render()
+     * @param alpha Fraction of a tick elapsed past the latest simulated state, in [0, 1]
+     */
+    static void SetInterpolationAlpha(float alpha);
+    static float GetInterpolationAlpha() { return s_interpolationAlpha; }
+
+    /**
+     * @brief World matrix blended between the previous and current tick
+     * @return Interpolated world matrix, or the cached world matrix when there is nothing to blend
+     * @note Reads the cached matrix as-is; call FlushWorldMatrix() first after moving the object
+     */
+    XMMATRIX GetRenderWorldMatrix() const;
+
+    /**
+     * @brief Position blended between the previous and current tick
+     */
+    XMFLOAT3 GetRenderPosition() const;
+
 protected:
     /**
      * @brief Create or set up the mesh for this object
@@ -284,6 +412,29 @@ protected:
     XMMATRIX             m_worldMatrix{};        ///< Cached world transformation matrix
     bool                 m_worldMatrixDirty{ true }; ///< Flag indicating if world matrix needs recalculation
 
+    // Frustum culling
+    uint32_t             m_cullHandle{ 0xFFFFFFFF }; ///< CullingSystem handle, registered on first cull
+    bool                 m_cullBoundsDirty{ true };  ///< World matrix or mesh changed since the bounds were pushed
+    bool                 m_localBoundsValid{ false }; ///< m_localBoundsMin/Max match the current mesh
+    XMFLOAT3             m_localBoundsMin{};
+    XMFLOAT3             m_localBoundsMax{};
+
+    std::shared_ptr<Material> m_material;           ///< Optional; bound before the mesh is drawn
+
+    // Scene spatial index
+    SceneOctree*         m_sceneIndex{ nullptr };           ///< Index holding this object, if any
+    uint32_t             m_sceneIndexHandle{ 0xFFFFFFFF };
+    bool                 m_sceneBoundsDirty{ true };        ///< World matrix or mesh changed since the index was updated
+
+    bool                 m_worldBoundsChanged{ true };      ///< World matrix or mesh changed since ConsumeWorldBoundsChanged()
+
+    // Transform at the start of the current simulation tick
+    XMFLOAT3             m_previousPosition{};
+    XMFLOAT3             m_previousRotation{};
+    XMFLOAT3             m_previousScale{ 1,1,1 };
+    bool                 m_hasPreviousTransform{ false };
+    static float         s_interpolationAlpha;   ///< Shared render blend factor for the current frame
+
     // Rendering
     std::unique_ptr<Mesh> m_mesh;               ///< 3D mesh for rendering
     ID3D11Device* m_device{ nullptr };         ///< DirectX device reference
@@ -292,6 +443,9 @@ protected:
     // Visibility/activation
     bool m_active{ true };  ///< Whether object should be updated
     bool m_visible{ true }; ///< Whether object should be rendered
+    bool m_occluder{ false }; ///< Rasterised into the occlusion buffer when occlusion culling is on
+    bool m_static{ false };   ///< Drawn into the static layer of cached shadow maps
+    uint32_t m_lod{ 0 };      ///< Mesh level of detail to draw, 0 is the full mesh
 
     // Identification
     static UINT   s_nextID; ///< Static counter for unique ID generation
@@ -7,6 +7,7 @@
 
 #include "ModelObject.h"
 #include "Utils/Assert.h"
+#include "../Graphics/RenderQueue.h"
 #include <iostream>
 
 ModelObject::ModelObject(const std::wstring& modelPath)
@@ -34,6 +35,11 @@ HRESULT ModelObject::Initialize(ID3D11Device* device, ID3D11DeviceContext* conte
     return GameObject::Initialize(device, context);
 }
 
+uint32_t ModelObject::GetShaderVariant() const
+{
+    return RenderShader::Custom;
+}
+
 void ModelObject::Render(const DirectX::XMMATRIX& view, const DirectX::XMMATRIX& proj)
 {
     if (!IsVisible() || !m_model) {
@@ -46,7 +52,7 @@ void ModelObject::Render(const DirectX::XMMATRIX& view, const DirectX::XMMATRIX&
     DirectX::XMMATRIX world = DirectX::XMMatrixIdentity();
     
     // Apply position (access m_position from GameObject base class)
-    DirectX::XMFLOAT3 pos = GetPosition();
+    DirectX::XMFLOAT3 pos = GetRenderPosition();
     world = DirectX::XMMatrixTranslation(pos.x, pos.y, pos.z);
     
     // ? ENHANCED: Get graphics engine reference (you may need to adjust this based on how you access it)
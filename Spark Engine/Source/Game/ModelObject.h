@@ -44,6 +44,9 @@ public:
      */
     void Render(const DirectX::XMMATRIX& view, const DirectX::XMMATRIX& proj) override;
 
+    /// The model binds its own shaders and textures
+    uint32_t GetShaderVariant() const override;
+
     /**
      * @brief Update the model object
      * @param deltaTime Time elapsed since last update
@@ -9,6 +9,7 @@ PlaneObject::PlaneObject(float width, float depth)
     std::wcout << L"[INFO] PlaneObject constructed. width=" << width << L" depth=" << depth << std::endl;
     ASSERT_MSG(width > 0.f && depth > 0.f, "Plane dimensions must be positive");
     SetName("Plane_" + std::to_string(GetID()));
+    SetStatic(true);
 }
 
 HRESULT PlaneObject::Initialize(ID3D11Device* d, ID3D11DeviceContext* c)
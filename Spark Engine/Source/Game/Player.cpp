@@ -120,7 +120,6 @@ void Player::Update(float dt)
     ASSERT_MSG(dt >= 0.0f && std::isfinite(dt), "Delta time must be non-negative and finite");
     if (!IsAlive()) return;
 
-    HandleInput(dt);
     UpdateMovement(dt);
     UpdateCombat(dt);
     UpdatePhysics(dt);
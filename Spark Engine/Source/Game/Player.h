@@ -92,6 +92,15 @@ public:
      */
     void Update(float dt) override;
 
+    /**
+     * @brief Process input for movement and actions
+     * @param dt Delta time for frame-rate independent input
+     *
+     * Called once per rendered frame so edge-triggered keys are never missed
+     * or repeated; Update() runs on the fixed simulation tick.
+     */
+    void HandleInput(float dt);
+
     /**
      * @brief Render the player (typically no visual representation in first-person)
      * 
@@ -443,12 +452,6 @@ private:
     BoundingSphere m_collisionSphere;            ///< Collision bounds for player
     float          m_bobTimer{ 0 }, m_footstepTimer{ 0 }; ///< Animation timers
 
-    /**
-     * @brief Process input for movement and actions
-     * @param dt Delta time for frame-rate independent input
-     */
-    void HandleInput(float dt);
-
     /**
      * @brief Update movement based on input and physics
      * @param dt Delta time for frame-rate independent movement
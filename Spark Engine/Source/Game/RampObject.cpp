@@ -10,6 +10,7 @@ RampObject::RampObject(float length, float height)
     std::wcout << L"[INFO] RampObject constructed. length=" << length << L" height=" << height << std::endl;
     ASSERT_MSG(length > 0.f && height > 0.f, "Ramp dimensions must be positive");
     SetName("Ramp_" + std::to_string(GetID()));
+    SetStatic(true);
 }
 
 HRESULT RampObject::Initialize(ID3D11Device* device, ID3D11DeviceContext* context)
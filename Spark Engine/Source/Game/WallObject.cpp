@@ -8,6 +8,8 @@ WallObject::WallObject(float width, float height)
     std::wcout << L"[INFO] WallObject constructed. width=" << width << L" height=" << height << std::endl;
     ASSERT_MSG(width > 0.f && height > 0.f, "Wall dimensions must be positive");
     SetName("Wall_" + std::to_string(GetID()));
+    SetOccluder(true);
+    SetStatic(true);
 }
 
 HRESULT WallObject::Initialize(ID3D11Device* device, ID3D11DeviceContext* context)
@@ -59,6 +59,7 @@ HRESULT MeshAsset::Load(ID3D11Device* device)
         // Bottom face
         4, 1, 0, 1, 4, 5
     };
+    LoadLods();
     
     // Create vertex buffer
     D3D11_BUFFER_DESC vbDesc = {};
@@ -72,14 +73,17 @@ HRESULT MeshAsset::Load(ID3D11Device* device)
     HRESULT hr = device->CreateBuffer(&vbDesc, &vbData, &m_vertexBuffer);
     if (FAILED(hr)) return hr;
     
-    // Create index buffer
+    // Create index buffer: the full mesh, then every simplified level
+    std::vector<uint32_t> indices = m_meshData.indices;
+    indices.insert(indices.end(), m_meshData.lodIndices.begin(), m_meshData.lodIndices.end());
+
     D3D11_BUFFER_DESC ibDesc = {};
     ibDesc.Usage = D3D11_USAGE_DEFAULT;
-    ibDesc.ByteWidth = static_cast<UINT>(m_meshData.indices.size() * sizeof(uint32_t));
+    ibDesc.ByteWidth = static_cast<UINT>(indices.size() * sizeof(uint32_t));
     ibDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
     
     D3D11_SUBRESOURCE_DATA ibData = {};
-    ibData.pSysMem = m_meshData.indices.data();
+    ibData.pSysMem = indices.data();
     
     hr = device->CreateBuffer(&ibDesc, &ibData, &m_indexBuffer);
     if (FAILED(hr)) return hr;
@@ -94,13 +98,31 @@ void MeshAsset::Unload()
     m_indexBuffer.Reset();
     m_meshData.vertices.clear();
     m_meshData.indices.clear();
+    m_meshData.lodIndices.clear();
+    m_meshData.lods.clear();
     m_loaded = false;
 }
 
 size_t MeshAsset::GetMemoryUsage() const
 {
     return m_meshData.vertices.size() * sizeof(MeshAssetData::Vertex) +
-           m_meshData.indices.size() * sizeof(uint32_t);
+           (m_meshData.indices.size() + m_meshData.lodIndices.size()) * sizeof(uint32_t);
+}
+
+void MeshAsset::LoadLods()
+{
+    m_meshData.lodIndices.clear();
+    m_meshData.lods.clear();
+    if (m_meshData.vertices.empty() || m_meshData.indices.empty()) return;
+
+    // The cache is keyed by positions and indices only, so no attributes are needed
+    SimplifierMesh source;
+    source.positions = &m_meshData.vertices[0].position.x;
+    source.positionStride = sizeof(MeshAssetData::Vertex);
+    source.vertexCount = m_meshData.vertices.size();
+    source.indices = m_meshData.indices.data();
+    source.indexCount = m_meshData.indices.size();
+    MeshSimplifier::LoadLodCache(MeshSimplifier::GetLodCachePath(m_path), source, m_meshData.lodIndices, m_meshData.lods);
 }
 
 // ============================================================================
@@ -327,7 +349,8 @@ HRESULT AssetPipeline::Initialize(ID3D11Device* device, ID3D11DeviceContext* con
     // Initialize metrics
     memset(&m_metrics, 0, sizeof(m_metrics));
     
-    // Start loading threads
+    // Load jobs run on the JobSystem, at most two at a time
+    m_shouldStop = false;
     SetStreamingThreadCount(2);
     
     Spark::SimpleConsole::GetInstance().LogSuccess("AssetPipeline initialized successfully");
@@ -336,15 +359,12 @@ HRESULT AssetPipeline::Initialize(ID3D11Device* device, ID3D11DeviceContext* con
 
 void AssetPipeline::Shutdown()
 {
-    // Stop loading threads
-    m_shouldStop = true;
-    m_queueCondition.notify_all();
-    
-    for (auto& thread : m_loadingThreads) {
-        if (thread.joinable()) {
-            thread.join();
-        }
+    // Stop loading: running jobs finish their current asset and exit
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_shouldStop = true;
     }
+    JobSystem::GetInstance().Wait(m_loadJobs);
     
     // Clear assets
     {
@@ -443,12 +463,13 @@ std::shared_ptr<AudioAsset> AssetPipeline::LoadAudio(const std::string& path)
 
 void AssetPipeline::LoadAssetAsync(const AssetLoadRequest& request)
 {
+    int jobs = 0;
     {
         std::lock_guard<std::mutex> lock(m_queueMutex);
         m_loadQueue.push(request);
+        jobs = ClaimLoadJobs();
     }
-    
-    m_queueCondition.notify_one();
+    StartLoadJobs(jobs);
 }
 
 void AssetPipeline::LoadMeshAsync(const std::string& path, std::function<void(std::shared_ptr<MeshAsset>)> callback)
@@ -556,23 +577,20 @@ void AssetPipeline::EnableBackgroundStreaming(bool enabled)
 
 void AssetPipeline::SetStreamingThreadCount(int count)
 {
-    // Stop existing threads
-    m_shouldStop = true;
-    m_queueCondition.notify_all();
-    
-    for (auto& thread : m_loadingThreads) {
-        if (thread.joinable()) {
-            thread.join();
-        }
-    }
-    
-    m_loadingThreads.clear();
-    m_shouldStop = false;
-    
-    // Start new threads
-    for (int i = 0; i < count; ++i) {
-        m_loadingThreads.emplace_back(&AssetPipeline::LoadingThreadFunction, this);
+    // Jobs over a lowered cap exit after their current asset
+    int jobs = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_maxLoadJobs = std::max(0, count);
+        jobs = ClaimLoadJobs();
     }
+    StartLoadJobs(jobs);
+}
+
+int AssetPipeline::GetStreamingThreadCount() const
+{
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    return m_maxLoadJobs;
 }
 
 std::vector<std::string> AssetPipeline::ScanDirectory(const std::string& directory, AssetType type)
@@ -749,35 +767,50 @@ int AssetPipeline::Console_ReloadAllAssets()
 }
 
 // Private helper methods
-void AssetPipeline::LoadingThreadFunction()
+int AssetPipeline::ClaimLoadJobs()
+{
+    // One job per queued request, up to the cap; each drains the queue until it is empty
+    int jobs = 0;
+    while (!m_shouldStop && m_activeLoadJobs < m_maxLoadJobs &&
+           m_activeLoadJobs < static_cast<int>(m_loadQueue.size())) {
+        ++m_activeLoadJobs;
+        ++jobs;
+    }
+    return jobs;
+}
+
+void AssetPipeline::StartLoadJobs(int count)
 {
-    while (!m_shouldStop) {
+    for (int i = 0; i < count; ++i) {
+        JobSystem::GetInstance().Run([this]() { LoadingJobFunction(); }, &m_loadJobs, JobPriority::Low);
+    }
+}
+
+void AssetPipeline::LoadingJobFunction()
+{
+    for (;;) {
         AssetLoadRequest request;
-        bool hasRequest = false;
         
-        // Get next request
+        // Get next request; the job retires under the same lock LoadAssetAsync()
+        // pushes under, so a request is never left queued without a job
         {
-            std::unique_lock<std::mutex> lock(m_queueMutex);
-            m_queueCondition.wait(lock, [this] { return !m_loadQueue.empty() || m_shouldStop; });
-            
-            if (m_shouldStop) break;
-            
-            if (!m_loadQueue.empty()) {
-                request = m_loadQueue.front();
-                m_loadQueue.pop();
-                hasRequest = true;
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            if (m_shouldStop || m_loadQueue.empty() || m_activeLoadJobs > m_maxLoadJobs) {
+                --m_activeLoadJobs;
+                return;
             }
+            
+            request = m_loadQueue.front();
+            m_loadQueue.pop();
         }
         
-        if (hasRequest) {
-            // Load asset
-            auto asset = LoadAsset(request.assetPath, request.expectedType);
-            
-            if (asset && request.onLoaded) {
-                request.onLoaded(asset);
-            } else if (!asset && request.onError) {
-                request.onError("Failed to load asset: " + request.assetPath);
-            }
+        // Load asset
+        auto asset = LoadAsset(request.assetPath, request.expectedType);
+        
+        if (asset && request.onLoaded) {
+            request.onLoaded(asset);
+        } else if (!asset && request.onError) {
+            request.onError("Failed to load asset: " + request.assetPath);
         }
     }
 }
@@ -836,7 +869,7 @@ void AssetPipeline::UpdateMetrics()
     }
     
     // Update other metrics
-    m_metrics.streamingThreads = static_cast<uint32_t>(m_loadingThreads.size());
+    m_metrics.streamingThreads = static_cast<uint32_t>(GetStreamingThreadCount());
     m_metrics.backgroundLoading = m_backgroundStreaming;
     
     if (m_cache) {
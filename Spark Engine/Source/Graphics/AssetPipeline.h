@@ -11,6 +11,8 @@
 #pragma once
 
 #include "Utils/Assert.h"
+#include "Core/JobSystem.h"
+#include "MeshSimplifier.h"
 #include <d3d11.h>
 #include <wrl/client.h>
 #include <DirectXMath.h>
@@ -87,6 +89,8 @@ struct MeshAssetData
     std::vector<Vertex> vertices;
     std::vector<uint32_t> indices;
     std::vector<uint32_t> submeshes;     // Submesh start indices
+    std::vector<uint32_t> lodIndices;    // Simplified levels, placed after indices in the index buffer
+    std::vector<MeshLodLevel> lods;      // Level 0 is indices itself; empty for a single level
     XMFLOAT3 boundingBoxMin;
     XMFLOAT3 boundingBoxMax;
     float boundingSphereRadius;
@@ -193,8 +197,15 @@ public:
     ID3D11Buffer* GetIndexBuffer() const { return m_indexBuffer.Get(); }
     uint32_t GetVertexCount() const { return static_cast<uint32_t>(m_meshData.vertices.size()); }
     uint32_t GetIndexCount() const { return static_cast<uint32_t>(m_meshData.indices.size()); }
+    uint32_t GetLodCount() const { return m_meshData.lods.empty() ? 1u : static_cast<uint32_t>(m_meshData.lods.size()); }
+    const MeshLodLevel* GetLods() const { return m_meshData.lods.empty() ? nullptr : m_meshData.lods.data(); }
 
 private:
+    /**
+     * @brief Read the LOD chain baked beside the asset; the mesh keeps a single level without one
+     */
+    void LoadLods();
+
     MeshAssetData m_meshData;
     ComPtr<ID3D11Buffer> m_vertexBuffer;
     ComPtr<ID3D11Buffer> m_indexBuffer;
@@ -352,8 +363,11 @@ public:
     // Streaming
     void EnableBackgroundStreaming(bool enabled);
     bool IsBackgroundStreamingEnabled() const { return m_backgroundStreaming; }
+    /**
+     * @brief Cap the number of load jobs running on the JobSystem at once
+     */
     void SetStreamingThreadCount(int count);
-    int GetStreamingThreadCount() const { return static_cast<int>(m_loadingThreads.size()); }
+    int GetStreamingThreadCount() const;
 
     // Asset discovery
     std::vector<std::string> ScanDirectory(const std::string& directory, AssetType type = AssetType::Unknown);
@@ -451,10 +465,11 @@ private:
 
     // Loading system
     bool m_backgroundStreaming = true;
-    std::vector<std::thread> m_loadingThreads;
     std::queue<AssetLoadRequest> m_loadQueue;
     mutable std::mutex m_queueMutex;
-    std::condition_variable m_queueCondition;
+    int m_maxLoadJobs = 0;                  ///< Guarded by m_queueMutex
+    int m_activeLoadJobs = 0;               ///< Guarded by m_queueMutex
+    JobCounter m_loadJobs;
     std::atomic<bool> m_shouldStop{false};
 
     // Hot reloading
@@ -466,7 +481,9 @@ private:
     AssetMetrics m_metrics;
 
     // Helper methods
-    void LoadingThreadFunction();
+    int ClaimLoadJobs();                ///< Call with m_queueMutex held; returns how many jobs to start
+    void StartLoadJobs(int count);      ///< Call without m_queueMutex (Run() may execute inline)
+    void LoadingJobFunction();
     AssetType DetectAssetTypeFromExtension(const std::string& extension);
     std::string CalculateChecksum(const std::string& filePath);
     uint64_t GetFileTimestamp(const std::string& filePath);
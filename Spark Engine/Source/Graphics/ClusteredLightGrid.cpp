@@ -0,0 +1,506 @@
+/**
+ * @file ClusteredLightGrid.cpp
+ * @brief Implementation of the froxel light binner
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * The cluster test is written once against a lane abstraction, as in
+ * CullingSystem.cpp, and instantiated for SSE and plain floats. The
+ * benchmark's brute-force reference runs the scalar instantiation over every
+ * cluster and light, so the binned lists must match it exactly.
+ */
+
+#include "ClusteredLightGrid.h"
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define SPARK_CLUSTERS_SSE 1
+#endif
+
+using namespace DirectX;
+
+namespace
+{
+    // Light fields, one array of floats each
+    enum LightField
+    {
+        SphereX, SphereY, SphereZ, Radius, RadiusSq,
+        ApexX, ApexY, ApexZ, AxisX, AxisY, AxisZ, ConeCos, ConeSin, ConeRange,
+        LightFloats
+    };
+
+    // Cluster fields, stored per cluster
+    enum ClusterField
+    {
+        MinX, MaxX, MinY, MaxY, MinZ, MaxZ, CenterX, CenterY, CenterZ, CenterRadius,
+        ClusterFloats
+    };
+
+    constexpr float BoundsInflation = 1e-5f;    ///< Relative growth of cluster boxes, covering rounding in the shader's cluster lookup
+
+    /**
+     * @brief Widening of a light's sphere for the per-slice and per-row prefilters, so they never reject a pair the exact test accepts
+     */
+    float PrefilterMargin(float radius) { return 1e-3f * (1.0f + radius); }
+
+    struct ScalarLane
+    {
+        using Type = float;
+        using Mask = bool;
+        static constexpr int Width = 1;
+
+        static Type Load(const float* p) { return *p; }
+        static Type Set(float v) { return v; }
+        static Type Add(Type a, Type b) { return a + b; }
+        static Type Sub(Type a, Type b) { return a - b; }
+        static Type Mul(Type a, Type b) { return a * b; }
+        static Type Max(Type a, Type b) { return a > b ? a : b; }
+        static Type Sqrt(Type a) { return std::sqrt(a); }
+        static Mask LessEq(Type a, Type b) { return a <= b; }
+        static Mask And(Mask a, Mask b) { return a && b; }
+        static uint32_t Bits(Mask m) { return m ? 1u : 0u; }
+    };
+
+#if SPARK_CLUSTERS_SSE
+    struct SseLane
+    {
+        using Type = __m128;
+        using Mask = __m128;
+        static constexpr int Width = 4;
+
+        static Type Load(const float* p) { return _mm_loadu_ps(p); }
+        static Type Set(float v) { return _mm_set1_ps(v); }
+        static Type Add(Type a, Type b) { return _mm_add_ps(a, b); }
+        static Type Sub(Type a, Type b) { return _mm_sub_ps(a, b); }
+        static Type Mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+        static Type Max(Type a, Type b) { return _mm_max_ps(a, b); }
+        static Type Sqrt(Type a) { return _mm_sqrt_ps(a); }
+        static Mask LessEq(Type a, Type b) { return _mm_cmple_ps(a, b); }
+        static Mask And(Mask a, Mask b) { return _mm_and_ps(a, b); }
+        static uint32_t Bits(Mask m) { return static_cast<uint32_t>(_mm_movemask_ps(m)); }
+    };
+#endif
+
+    struct LightArrays
+    {
+        const float* field[LightFloats];
+    };
+
+    /**
+     * Sphere against the cluster box: squared distance from the centre to the
+     * box is at most r^2. Cone against the cluster's bounding sphere: the
+     * sphere is within the cone angle and between the apex and the range.
+     * Point lights have a zero axis and zero cone terms, which pass the cone test.
+     */
+    template<typename L>
+    uint32_t TestBlock(const LightArrays& a, size_t i, const float* cluster)
+    {
+        const auto zero = L::Set(0.0f);
+        const auto sx = L::Load(a.field[SphereX] + i), sy = L::Load(a.field[SphereY] + i), sz = L::Load(a.field[SphereZ] + i);
+        const auto dx = L::Max(L::Max(L::Sub(L::Set(cluster[MinX]), sx), L::Sub(sx, L::Set(cluster[MaxX]))), zero);
+        const auto dy = L::Max(L::Max(L::Sub(L::Set(cluster[MinY]), sy), L::Sub(sy, L::Set(cluster[MaxY]))), zero);
+        const auto dz = L::Max(L::Max(L::Sub(L::Set(cluster[MinZ]), sz), L::Sub(sz, L::Set(cluster[MaxZ]))), zero);
+        const auto distanceSq = L::Add(L::Add(L::Mul(dx, dx), L::Mul(dy, dy)), L::Mul(dz, dz));
+        const auto sphereHit = L::LessEq(distanceSq, L::Load(a.field[RadiusSq] + i));
+        if (L::Bits(sphereHit) == 0) return 0;
+
+        const auto vx = L::Sub(L::Set(cluster[CenterX]), L::Load(a.field[ApexX] + i));
+        const auto vy = L::Sub(L::Set(cluster[CenterY]), L::Load(a.field[ApexY] + i));
+        const auto vz = L::Sub(L::Set(cluster[CenterZ]), L::Load(a.field[ApexZ] + i));
+        const auto lengthSq = L::Add(L::Add(L::Mul(vx, vx), L::Mul(vy, vy)), L::Mul(vz, vz));
+        const auto along = L::Add(L::Add(L::Mul(vx, L::Load(a.field[AxisX] + i)), L::Mul(vy, L::Load(a.field[AxisY] + i))),
+                                  L::Mul(vz, L::Load(a.field[AxisZ] + i)));
+        const auto across = L::Sqrt(L::Max(L::Sub(lengthSq, L::Mul(along, along)), zero));
+        const auto closest = L::Sub(L::Mul(L::Load(a.field[ConeCos] + i), across), L::Mul(along, L::Load(a.field[ConeSin] + i)));
+        const auto radius = L::Set(cluster[CenterRadius]);
+        const auto coneHit = L::And(L::And(L::LessEq(closest, radius), L::LessEq(along, L::Add(radius, L::Load(a.field[ConeRange] + i)))),
+                                    L::LessEq(L::Set(-cluster[CenterRadius]), along));
+        return L::Bits(L::And(sphereHit, coneHit));
+    }
+
+    template<typename L>
+    void RunKernel(const LightArrays& arrays, size_t paddedCount, const float* cluster, const uint32_t* lightIndices,
+                   std::vector<uint32_t>& out)
+    {
+        for (size_t i = 0; i < paddedCount; i += L::Width) {
+            for (uint32_t bits = TestBlock<L>(arrays, i, cluster); bits != 0; bits &= bits - 1) {
+                out.push_back(lightIndices[i + static_cast<size_t>(std::countr_zero(bits))]);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// GRID
+// ============================================================================
+
+ClusteredLightGrid::ClusteredLightGrid(uint32_t tilesX, uint32_t tilesY, uint32_t slices)
+{
+    SetGrid(tilesX, tilesY, slices);
+}
+
+void ClusteredLightGrid::SetGrid(uint32_t tilesX, uint32_t tilesY, uint32_t slices)
+{
+    ASSERT_MSG(tilesX > 0 && tilesY > 0 && slices > 0 && tilesX * tilesY * slices <= 65536,
+               "Light cluster grid %u tiles wide out of range", tilesX);
+    m_constants.tilesX = tilesX;
+    m_constants.tilesY = tilesY;
+    m_constants.slices = slices;
+    m_clusterBounds.assign(size_t(GetClusterCount()) * ClusterFloats, 0.0f);
+    m_ranges.assign(GetClusterCount(), ClusterRange{ 0, 0 });
+    m_scratch.resize(slices);
+    m_sliceMinZ.assign(slices, 0.0f);
+    m_sliceMaxZ.assign(slices, 0.0f);
+    m_lightIndices.clear();
+}
+
+uint32_t ClusteredLightGrid::GetClusterIndex(const XMFLOAT3& viewPosition) const
+{
+    const ClusterShaderConstants& c = m_constants;
+    const float z = std::max(viewPosition.z, c.nearPlane);
+    const float ndcX = viewPosition.x * c.projScaleX / z + c.projOffsetX;
+    const float ndcY = viewPosition.y * c.projScaleY / z + c.projOffsetY;
+    const float tileX = std::clamp(std::floor((ndcX * 0.5f + 0.5f) * c.tilesX), 0.0f, static_cast<float>(c.tilesX - 1));
+    const float tileY = std::clamp(std::floor((0.5f - ndcY * 0.5f) * c.tilesY), 0.0f, static_cast<float>(c.tilesY - 1));
+    const float slice = std::clamp(std::floor(std::log(z) * c.sliceScale + c.sliceBias), 0.0f, static_cast<float>(c.slices - 1));
+    return (static_cast<uint32_t>(slice) * c.tilesY + static_cast<uint32_t>(tileY)) * c.tilesX + static_cast<uint32_t>(tileX);
+}
+
+// ============================================================================
+// BINNING
+// ============================================================================
+
+void ClusteredLightGrid::Build(const ClusterLight* lights, size_t count, FXMMATRIX view, CXMMATRIX projection)
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+    ASSERT_MSG(lights || count == 0, "Null light array with %zu lights", count);
+
+    XMFLOAT4X4 p;
+    XMStoreFloat4x4(&p, projection);
+    ASSERT_MSG(p._34 > 0.5f && std::fabs(p._44) < 1e-6f, "Light clusters need a left-handed perspective projection (_34 = %f)", p._34);
+
+    ClusterShaderConstants& c = m_constants;
+    const uint32_t tilesX = c.tilesX, tilesY = c.tilesY, slices = c.slices;
+    c.lightCount = static_cast<uint32_t>(count);
+    c.projScaleX = p._11;
+    c.projScaleY = p._22;
+    c.projOffsetX = p._31;
+    c.projOffsetY = p._32;
+    c.nearPlane = -p._43 / p._33;
+    c.farPlane = p._43 / (1.0f - p._33);
+    c.sliceScale = static_cast<float>(slices) / std::log(c.farPlane / c.nearPlane);
+    c.sliceBias = -std::log(c.nearPlane) * c.sliceScale;
+
+    // Cluster boxes: a tile spans [ndc0, ndc1], so view x = (ndc - offset) * z / scale between the slice's depths
+    for (uint32_t slice = 0; slice < slices; ++slice) {
+        const float z0 = slice == 0 ? c.nearPlane : std::exp((slice - c.sliceBias) / c.sliceScale);
+        const float z1 = slice + 1 == slices ? c.farPlane : std::exp((slice + 1 - c.sliceBias) / c.sliceScale);
+        m_sliceMinZ[slice] = z0 * (1.0f - BoundsInflation);
+        m_sliceMaxZ[slice] = z1 * (1.0f + BoundsInflation);
+        const float grow = z1 * BoundsInflation;
+
+        for (uint32_t y = 0; y < tilesY; ++y) {
+            const float top = 1.0f - 2.0f * y / tilesY - c.projOffsetY;
+            const float bottom = 1.0f - 2.0f * (y + 1) / tilesY - c.projOffsetY;
+            for (uint32_t x = 0; x < tilesX; ++x) {
+                const float left = 2.0f * x / tilesX - 1.0f - c.projOffsetX;
+                const float right = 2.0f * (x + 1) / tilesX - 1.0f - c.projOffsetX;
+                float* box = &m_clusterBounds[size_t((slice * tilesY + y) * tilesX + x) * ClusterFloats];
+                box[MinX] = std::min(left * z0, left * z1) / c.projScaleX - grow;
+                box[MaxX] = std::max(right * z0, right * z1) / c.projScaleX + grow;
+                box[MinY] = std::min(bottom * z0, bottom * z1) / c.projScaleY - grow;
+                box[MaxY] = std::max(top * z0, top * z1) / c.projScaleY + grow;
+                box[MinZ] = m_sliceMinZ[slice];
+                box[MaxZ] = m_sliceMaxZ[slice];
+                box[CenterX] = (box[MinX] + box[MaxX]) * 0.5f;
+                box[CenterY] = (box[MinY] + box[MaxY]) * 0.5f;
+                box[CenterZ] = (box[MinZ] + box[MaxZ]) * 0.5f;
+                const float ex = box[MaxX] - box[CenterX], ey = box[MaxY] - box[CenterY], ez = box[MaxZ] - box[CenterZ];
+                box[CenterRadius] = std::sqrt(ex * ex + ey * ey + ez * ez);
+            }
+        }
+    }
+
+    // Light bounds in view space; spot lights get the tightest sphere around their cone
+    m_lightCount = count;
+    m_lights.resize(size_t(LightFloats) * count);
+    m_lightSliceFirst.resize(count);
+    m_lightSliceLast.resize(count);
+    float* f[LightFloats];
+    for (int field = 0; field < LightFloats; ++field) f[field] = m_lights.data() + size_t(field) * count;
+
+    for (size_t i = 0; i < count; ++i) {
+        const ClusterLight& light = lights[i];
+        const float range = std::max(light.range, 0.0f);
+        XMFLOAT3 apex, axis(0.0f, 0.0f, 0.0f), center;
+        XMStoreFloat3(&apex, XMVector3TransformCoord(XMLoadFloat3(&light.position), view));
+        center = apex;
+        float radius = range, coneCos = 0.0f, coneSin = 0.0f, coneRange = 0.0f;
+
+        const XMVECTOR direction = XMVector3TransformNormal(XMLoadFloat3(&light.direction), view);
+        const float halfAngle = light.spotAngle * 0.5f;
+        if (halfAngle > 0.0f && halfAngle < XM_PIDIV2 && XMVectorGetX(XMVector3LengthSq(direction)) > 1e-12f) {
+            XMStoreFloat3(&axis, XMVector3Normalize(direction));
+            coneCos = std::cos(halfAngle);
+            coneSin = std::sin(halfAngle);
+            coneRange = range;
+            const float offset = halfAngle > XM_PIDIV4 ? range * coneCos : range / (2.0f * coneCos);
+            radius = halfAngle > XM_PIDIV4 ? range * coneSin : offset;
+            center = XMFLOAT3(apex.x + axis.x * offset, apex.y + axis.y * offset, apex.z + axis.z * offset);
+        }
+
+        f[SphereX][i] = center.x;
+        f[SphereY][i] = center.y;
+        f[SphereZ][i] = center.z;
+        f[Radius][i] = radius;
+        f[RadiusSq][i] = radius * radius;
+        f[ApexX][i] = apex.x;
+        f[ApexY][i] = apex.y;
+        f[ApexZ][i] = apex.z;
+        f[AxisX][i] = axis.x;
+        f[AxisY][i] = axis.y;
+        f[AxisZ][i] = axis.z;
+        f[ConeCos][i] = coneCos;
+        f[ConeSin][i] = coneSin;
+        f[ConeRange][i] = coneRange;
+
+        // Slices the sphere's depth range touches
+        const float margin = PrefilterMargin(radius);
+        const float nearest = center.z - radius - margin, farthest = center.z + radius + margin;
+        m_lightSliceFirst[i] = static_cast<uint32_t>(std::lower_bound(m_sliceMaxZ.begin(), m_sliceMaxZ.end(), nearest) - m_sliceMaxZ.begin());
+        m_lightSliceLast[i] = static_cast<uint32_t>(std::upper_bound(m_sliceMinZ.begin(), m_sliceMinZ.end(), farthest) - m_sliceMinZ.begin());
+        // upper_bound gives one past the last slice starting in front of the far end; 0 means none
+        if (m_lightSliceLast[i] == 0) m_lightSliceFirst[i] = slices;
+        else m_lightSliceLast[i]--;
+    }
+
+    JobSystem::GetInstance().ParallelFor(slices, 1, [this](uint32_t begin, uint32_t end) {
+        for (uint32_t slice = begin; slice < end; ++slice) BinSlice(slice);
+    });
+
+    // Concatenate the slices' lists; cluster offsets were slice-relative
+    size_t total = 0;
+    for (const SliceScratch& scratch : m_scratch) total += scratch.indices.size();
+    m_lightIndices.resize(total);
+    m_lightAssigned.assign(count, 0);
+    m_maxLightsPerCluster = 0;
+    uint32_t base = 0;
+    for (uint32_t slice = 0; slice < slices; ++slice) {
+        const std::vector<uint32_t>& indices = m_scratch[slice].indices;
+        std::copy(indices.begin(), indices.end(), m_lightIndices.begin() + base);
+        for (uint32_t cluster = slice * tilesX * tilesY; cluster < (slice + 1) * tilesX * tilesY; ++cluster) {
+            m_ranges[cluster].offset += base;
+            m_maxLightsPerCluster = std::max(m_maxLightsPerCluster, m_ranges[cluster].count);
+        }
+        for (uint32_t light : indices) m_lightAssigned[light] = 1;
+        base += static_cast<uint32_t>(indices.size());
+    }
+    m_assignedLights = static_cast<uint32_t>(std::count(m_lightAssigned.begin(), m_lightAssigned.end(), uint8_t(1)));
+
+    m_buildTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+void ClusteredLightGrid::BinSlice(uint32_t slice)
+{
+    const uint32_t tilesX = m_constants.tilesX, tilesY = m_constants.tilesY;
+    SliceScratch& s = m_scratch[slice];
+    s.indices.clear();
+
+    s.candidates.clear();
+    for (uint32_t i = 0; i < m_lightCount; ++i) {
+        if (m_lightSliceFirst[i] <= slice && slice <= m_lightSliceLast[i]) s.candidates.push_back(i);
+    }
+
+    const float* all[LightFloats];
+    for (int field = 0; field < LightFloats; ++field) all[field] = m_lights.data() + size_t(field) * m_lightCount;
+
+    for (uint32_t y = 0; y < tilesY; ++y) {
+        const uint32_t rowFirstCluster = (slice * tilesY + y) * tilesX;
+
+        // Every box in a row shares its y range
+        const float* rowBox = &m_clusterBounds[size_t(rowFirstCluster) * ClusterFloats];
+        s.rowIndices.clear();
+        for (uint32_t light : s.candidates) {
+            const float reach = all[Radius][light] + PrefilterMargin(all[Radius][light]);
+            if (all[SphereY][light] + reach >= rowBox[MinY] && all[SphereY][light] - reach <= rowBox[MaxY]) {
+                s.rowIndices.push_back(light);
+            }
+        }
+        if (s.rowIndices.empty()) {
+            for (uint32_t x = 0; x < tilesX; ++x) m_ranges[rowFirstCluster + x] = { static_cast<uint32_t>(s.indices.size()), 0 };
+            continue;
+        }
+
+        // Pack the row's lights into padded SoA; padding lanes have a negative squared radius and never pass
+        const size_t count = s.rowIndices.size();
+        const size_t padded = (count + 3) & ~size_t(3);
+        s.rowLights.resize(size_t(LightFloats) * padded);
+        LightArrays arrays;
+        for (int field = 0; field < LightFloats; ++field) {
+            float* out = s.rowLights.data() + size_t(field) * padded;
+            for (size_t i = 0; i < count; ++i) out[i] = all[field][s.rowIndices[i]];
+            std::fill(out + count, out + padded, field == RadiusSq ? -1.0f : 0.0f);
+            arrays.field[field] = out;
+        }
+        s.rowIndices.resize(padded, 0u);
+
+        for (uint32_t x = 0; x < tilesX; ++x) {
+            const uint32_t cluster = rowFirstCluster + x;
+            const float* box = &m_clusterBounds[size_t(cluster) * ClusterFloats];
+            const size_t first = s.indices.size();
+#if SPARK_CLUSTERS_SSE
+            if (!m_forceScalar) RunKernel<SseLane>(arrays, padded, box, s.rowIndices.data(), s.indices);
+            else RunKernel<ScalarLane>(arrays, padded, box, s.rowIndices.data(), s.indices);
+#else
+            RunKernel<ScalarLane>(arrays, padded, box, s.rowIndices.data(), s.indices);
+#endif
+            m_ranges[cluster] = { static_cast<uint32_t>(first), static_cast<uint32_t>(s.indices.size() - first) };
+        }
+    }
+}
+
+bool ClusteredLightGrid::TestReference(uint32_t cluster, uint32_t light) const
+{
+    LightArrays arrays;
+    for (int field = 0; field < LightFloats; ++field) arrays.field[field] = m_lights.data() + size_t(field) * m_lightCount;
+    return TestBlock<ScalarLane>(arrays, light, &m_clusterBounds[size_t(cluster) * ClusterFloats]) != 0;
+}
+
+// ============================================================================
+// CONSOLE INTEGRATION
+// ============================================================================
+
+std::string ClusteredLightGrid::Console_GetStats() const
+{
+    uint32_t occupied = 0;
+    for (const ClusterRange& range : m_ranges) {
+        if (range.count > 0) occupied++;
+    }
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "=== Light Clusters ===\n";
+    ss << "Grid:             " << m_constants.tilesX << "x" << m_constants.tilesY << "x" << m_constants.slices
+       << " (" << GetClusterCount() << " clusters)\n";
+    ss << "Depth range:      " << m_constants.nearPlane << " - " << m_constants.farPlane << "\n";
+    ss << "Lights:           " << m_assignedLights << "/" << m_constants.lightCount << " assigned\n";
+    ss << "Index entries:    " << m_lightIndices.size() << " (" << (GetClusterCount() ? double(m_lightIndices.size()) / GetClusterCount() : 0.0)
+       << " per cluster, max " << m_maxLightsPerCluster << ")\n";
+    ss << "Occupied:         " << occupied << "/" << GetClusterCount() << " clusters\n";
+    ss << "Build time:       " << m_buildTime << " ms\n";
+#if SPARK_CLUSTERS_SSE
+    ss << "Kernel:           " << (m_forceScalar ? "scalar (forced)" : "SSE") << "\n";
+#else
+    ss << "Kernel:           scalar\n";
+#endif
+    return ss.str();
+}
+
+std::string ClusteredLightGrid::Console_Benchmark(int lightCount)
+{
+    using Clock = std::chrono::high_resolution_clock;
+    lightCount = std::clamp(lightCount, 1, 1 << 16);
+    constexpr int Repeats = 5;
+    constexpr int Samples = 20000;
+
+    // A 200 m yard of point and spot lights in front of the camera
+    std::mt19937 rng(21);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<ClusterLight> lights(lightCount);
+    for (ClusterLight& light : lights) {
+        light.position = XMFLOAT3(-100.0f + 200.0f * unit(rng), 20.0f * unit(rng), 200.0f * unit(rng));
+        light.range = 2.0f + 10.0f * unit(rng);
+        XMStoreFloat3(&light.direction, XMVector3Normalize(XMVectorSet(unit(rng) - 0.5f, unit(rng) - 0.8f, unit(rng) - 0.5f, 0.0f)));
+        light.spotAngle = unit(rng) < 0.5f ? 0.0f : XMConvertToRadians(20.0f + 100.0f * unit(rng));
+    }
+
+    const XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(0.0f, 8.0f, -5.0f, 1.0f), XMVectorSet(10.0f, 4.0f, 100.0f, 1.0f), XMVectorSet(0, 1, 0, 0));
+    const XMMATRIX projection = XMMatrixPerspectiveFovLH(XMConvertToRadians(70.0f), 16.0f / 9.0f, 0.1f, 300.0f);
+
+    ClusteredLightGrid grid, scalar;
+    scalar.SetForceScalar(true);
+    double gridMs = 1e30, scalarMs = 1e30;
+    for (int r = 0; r < Repeats; ++r) {
+        auto startTime = Clock::now();
+        grid.Build(lights.data(), lights.size(), view, projection);
+        gridMs = std::min(gridMs, std::chrono::duration<double, std::milli>(Clock::now() - startTime).count());
+        startTime = Clock::now();
+        scalar.Build(lights.data(), lights.size(), view, projection);
+        scalarMs = std::min(scalarMs, std::chrono::duration<double, std::milli>(Clock::now() - startTime).count());
+    }
+    const bool kernelsMatch = grid.m_lightIndices == scalar.m_lightIndices &&
+        std::equal(grid.m_ranges.begin(), grid.m_ranges.end(), scalar.m_ranges.begin(),
+                   [](const ClusterRange& a, const ClusterRange& b) { return a.offset == b.offset && a.count == b.count; });
+
+    // Brute force: every cluster against every light with the scalar test
+    uint32_t missing = 0, extra = 0;
+    const auto bruteStart = Clock::now();
+    for (uint32_t cluster = 0; cluster < grid.GetClusterCount(); ++cluster) {
+        const ClusterRange range = grid.m_ranges[cluster];
+        const uint32_t* listed = grid.m_lightIndices.data() + range.offset;
+        uint32_t next = 0;
+        for (uint32_t light = 0; light < static_cast<uint32_t>(lights.size()); ++light) {
+            const bool expected = grid.TestReference(cluster, light);
+            const bool found = next < range.count && listed[next] == light;
+            if (found) next++;
+            if (expected && !found) missing++;
+            if (!expected && found) extra++;
+        }
+        extra += range.count - next;
+    }
+    const double bruteMs = std::chrono::duration<double, std::milli>(Clock::now() - bruteStart).count();
+
+    // Point samples: every light that actually reaches a point must be listed in its cluster
+    std::vector<XMFLOAT3> apexes(lights.size()), axes(lights.size());
+    for (size_t i = 0; i < lights.size(); ++i) {
+        XMStoreFloat3(&apexes[i], XMVector3TransformCoord(XMLoadFloat3(&lights[i].position), view));
+        XMStoreFloat3(&axes[i], XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&lights[i].direction), view)));
+    }
+    const ClusterShaderConstants& c = grid.GetShaderConstants();
+    uint32_t sampleMisses = 0;
+    uint64_t reachingPairs = 0;
+    for (int sample = 0; sample < Samples; ++sample) {
+        const float z = c.nearPlane * std::pow(c.farPlane / c.nearPlane, unit(rng));
+        const float ndcX = unit(rng) * 2.0f - 1.0f, ndcY = unit(rng) * 2.0f - 1.0f;
+        const XMFLOAT3 point((ndcX - c.projOffsetX) * z / c.projScaleX, (ndcY - c.projOffsetY) * z / c.projScaleY, z);
+        const ClusterRange range = grid.m_ranges[grid.GetClusterIndex(point)];
+        const uint32_t* begin = grid.m_lightIndices.data() + range.offset;
+
+        for (uint32_t light = 0; light < static_cast<uint32_t>(lights.size()); ++light) {
+            const float vx = point.x - apexes[light].x, vy = point.y - apexes[light].y, vz = point.z - apexes[light].z;
+            const float distance = std::sqrt(vx * vx + vy * vy + vz * vz);
+            if (distance > lights[light].range * 0.999f) continue;
+            if (lights[light].spotAngle > 0.0f && distance > 0.0f &&
+                (vx * axes[light].x + vy * axes[light].y + vz * axes[light].z) / distance < std::cos(lights[light].spotAngle * 0.5f) + 1e-3f) {
+                continue;
+            }
+            reachingPairs++;
+            if (!std::binary_search(begin, begin + range.count, light)) sampleMisses++;
+        }
+    }
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "=== Clustered Light Benchmark ===\n";
+    ss << lights.size() << " lights (half spot), " << grid.GetTilesX() << "x" << grid.GetTilesY() << "x" << grid.GetSlices()
+       << " clusters, best of " << Repeats << "\n";
+    ss << "Build:        " << gridMs << " ms\n";
+    ss << "  scalar:     " << scalarMs << " ms (" << scalarMs / gridMs << "x), lists " << (kernelsMatch ? "identical" : "DIFFER") << "\n";
+    ss << "  brute force: " << bruteMs << " ms (" << bruteMs / gridMs << "x)\n";
+    ss << "Assigned:     " << grid.GetAssignedLightCount() << " lights, " << grid.GetLightIndices().size() << " index entries\n";
+    ss << "Per cluster:  " << double(grid.GetLightIndices().size()) / grid.GetClusterCount() << " mean, "
+       << grid.GetMaxLightsPerCluster() << " max\n";
+    ss << "Brute force:  " << (missing == 0 && extra == 0 ? "matched" : "MISMATCH") << " (" << missing << " missing, "
+       << extra << " extra)\n";
+    ss << "Point samples: " << Samples << ", " << reachingPairs << " lit pairs, " << sampleMisses << " missed ("
+       << (sampleMisses == 0 ? "passed" : "FAILED") << ")\n";
+    return ss.str();
+}
@@ -0,0 +1,152 @@
+/**
+ * @file ClusteredLightGrid.h
+ * @brief CPU light binning into view-frustum clusters for Forward+ and deferred shading
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * The view frustum is cut into screen tiles and exponentially spaced depth
+ * slices. Every point, spot and area light is bounded by a sphere (the
+ * tightest sphere around the cone for spot lights), and is assigned to the
+ * clusters whose view-space box the sphere touches; spot lights must also
+ * reach the cluster's bounding sphere with their cone. The result is a
+ * compact list of light indices plus an offset and count per cluster, which
+ * the lighting system uploads as structured buffers, so a pixel only loops
+ * over the lights of its own cluster and the scene has no fixed light cap.
+ *
+ * Slices are binned in parallel on the job system. Within a slice, each
+ * cluster is tested against four lights per SSE instruction, with a scalar
+ * kernel that evaluates the same expressions in the same order.
+ */
+
+#pragma once
+
+#include "Utils/Assert.h"
+#include <DirectXMath.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Point or spot light as seen by the binner
+ */
+struct ClusterLight
+{
+    DirectX::XMFLOAT3 position;     ///< World space
+    float range;                    ///< Distance the light reaches
+    DirectX::XMFLOAT3 direction;    ///< World space; ignored for point lights
+    float spotAngle;                ///< Full cone angle in radians; 0 for point lights
+};
+
+/**
+ * @brief Slice of the light index list belonging to one cluster
+ */
+struct ClusterRange
+{
+    uint32_t offset;
+    uint32_t count;
+};
+
+/**
+ * @brief Constants the shaders need to find a pixel's cluster; mirrors ClusterConstants in ClusteredLights.hlsl
+ *
+ * From a view-space position p: ndc = p.xy * projScale / p.z + projOffset,
+ * slice = floor(log(p.z) * sliceScale + sliceBias).
+ */
+struct ClusterShaderConstants
+{
+    uint32_t tilesX, tilesY, slices, lightCount;
+    float projScaleX, projScaleY, projOffsetX, projOffsetY;
+    float nearPlane, farPlane, sliceScale, sliceBias;
+};
+
+/**
+ * @brief Froxel grid with per-cluster light lists, rebuilt every frame
+ */
+class ClusteredLightGrid
+{
+public:
+    static constexpr uint32_t DefaultTilesX = 16;
+    static constexpr uint32_t DefaultTilesY = 9;
+    static constexpr uint32_t DefaultSlices = 24;
+
+    explicit ClusteredLightGrid(uint32_t tilesX = DefaultTilesX, uint32_t tilesY = DefaultTilesY, uint32_t slices = DefaultSlices);
+
+    void SetGrid(uint32_t tilesX, uint32_t tilesY, uint32_t slices);
+    uint32_t GetTilesX() const { return m_constants.tilesX; }
+    uint32_t GetTilesY() const { return m_constants.tilesY; }
+    uint32_t GetSlices() const { return m_constants.slices; }
+    uint32_t GetClusterCount() const { return m_constants.tilesX * m_constants.tilesY * m_constants.slices; }
+
+    /**
+     * @brief Assign lights to the clusters of a camera
+     * @param projection Left-handed perspective projection; its near and far planes bound the slices
+     *
+     * Light indices in the output are positions in @p lights.
+     */
+    void Build(const ClusterLight* lights, size_t count, DirectX::FXMMATRIX view, DirectX::CXMMATRIX projection);
+
+    /**
+     * @brief Cluster containing a view-space point, computed the way the shaders do
+     */
+    uint32_t GetClusterIndex(const DirectX::XMFLOAT3& viewPosition) const;
+
+    const std::vector<ClusterRange>& GetRanges() const { return m_ranges; }
+    const std::vector<uint32_t>& GetLightIndices() const { return m_lightIndices; }
+    const ClusterShaderConstants& GetShaderConstants() const { return m_constants; }
+
+    /**
+     * @brief Lights assigned to at least one cluster in the last build
+     */
+    uint32_t GetAssignedLightCount() const { return m_assignedLights; }
+    uint32_t GetMaxLightsPerCluster() const { return m_maxLightsPerCluster; }
+    float GetBuildTime() const { return m_buildTime; }
+
+    /**
+     * @brief Use the plain-float kernel even where SSE is available, as a reference
+     */
+    void SetForceScalar(bool enabled) { m_forceScalar = enabled; }
+
+    std::string Console_GetStats() const;
+
+    /**
+     * @brief Bin a synthetic scene, checked against brute-force cluster tests and point samples
+     */
+    static std::string Console_Benchmark(int lightCount);
+
+private:
+    /**
+     * @brief Per-slice working set, reused across frames
+     */
+    struct SliceScratch
+    {
+        std::vector<uint32_t> candidates;   ///< Lights whose depth range overlaps the slice
+        std::vector<float> rowLights;       ///< SoA of the lights overlapping one tile row
+        std::vector<uint32_t> rowIndices;
+        std::vector<uint32_t> indices;      ///< Light indices of the slice's clusters, in cluster order
+    };
+
+    void BinSlice(uint32_t slice);
+    bool TestReference(uint32_t cluster, uint32_t light) const;
+
+    ClusterShaderConstants m_constants{};
+    std::vector<float> m_sliceMinZ, m_sliceMaxZ;    ///< Depth range of each slice, slightly widened
+
+    // Cluster view-space boxes and bounding spheres
+    std::vector<float> m_clusterBounds;      ///< ClusterFloats floats per cluster
+
+    // Light spheres and cones in view space, structure of arrays
+    size_t m_lightCount = 0;
+    std::vector<float> m_lights;             ///< LightFloats arrays of m_lightCount floats
+    std::vector<uint32_t> m_lightSliceFirst, m_lightSliceLast;
+
+    std::vector<SliceScratch> m_scratch;
+    std::vector<ClusterRange> m_ranges;
+    std::vector<uint32_t> m_lightIndices;
+    std::vector<uint8_t> m_lightAssigned;
+
+    uint32_t m_assignedLights = 0;
+    uint32_t m_maxLightsPerCluster = 0;
+    float m_buildTime = 0.0f;
+    bool m_forceScalar = false;
+};
@@ -0,0 +1,138 @@
+/**
+ * @file CommandBuffer.h
+ * @brief Backend-agnostic recorded draw commands
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * Render paths record what they want drawn (bind shaders, bind material,
+ * set object constants, draw mesh) into a CommandBuffer instead of calling
+ * the D3D11 context. A RenderBackend replays the buffers later: the D3D11
+ * backend turns them into context calls, the null backend only counts them.
+ *
+ * Recording touches no graphics API, so several threads can each fill their
+ * own buffer at once, and this header compiles without the Windows SDK. The
+ * per-object matrix work (world-view-projection, inverse transpose) is done
+ * while recording, so replay is reduced to copies and API calls.
+ */
+
+#pragma once
+
+#include "Utils/Assert.h"
+#include <DirectXMath.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Material;
+class Mesh;
+class GameObject;
+
+/**
+ * @brief Kind of a recorded command
+ */
+enum class RenderCommandType : uint8_t
+{
+    BindBasicShaders,       ///< GraphicsEngine's basic shaders, samplers and constant buffers
+    BindMaterial,           ///< resource: const Material*
+    SetObjectConstants,     ///< arg: index into GetObjectConstants()
+    DrawMesh,               ///< resource: const Mesh*, arg: index count, first: first index (LOD range)
+    DrawObject              ///< resource: GameObject* whose Render() binds its own state; D3D11 immediate context only
+};
+
+/**
+ * @brief One recorded command; what arg and resource mean depends on type
+ */
+struct RenderCommand
+{
+    RenderCommandType type;
+    uint32_t arg;
+    const void* resource;
+    uint32_t first = 0;
+};
+
+/**
+ * @brief Per-object constants in GPU layout (already transposed)
+ */
+struct ObjectConstants
+{
+    DirectX::XMFLOAT4X4 world;
+    DirectX::XMFLOAT4X4 worldViewProjection;
+    DirectX::XMFLOAT4X4 worldInverseTranspose;
+
+    static ObjectConstants FromMatrices(DirectX::FXMMATRIX world, DirectX::CXMMATRIX view, DirectX::CXMMATRIX projection);
+};
+
+/**
+ * @brief List of recorded commands for one camera
+ *
+ * Redundant shader and material binds are dropped while recording. Each
+ * buffer starts with nothing bound, so a backend can replay it on any
+ * context. One thread records a buffer at a time; buffers keep their storage
+ * between frames.
+ */
+class CommandBuffer
+{
+public:
+    CommandBuffer() = default;
+
+    /**
+     * @brief Drop all commands and bound state and start recording for a camera
+     */
+    void Begin(DirectX::FXMMATRIX view, DirectX::CXMMATRIX projection);
+
+    void BindBasicShaders();
+
+    /**
+     * @brief Bind a material unless it is already bound
+     * @return True if a bind was recorded
+     */
+    bool BindMaterial(const Material* material);
+
+    void SetObjectConstants(DirectX::FXMMATRIX world);
+
+    /**
+     * @brief Draw a range of a mesh's index buffer, e.g. one of its LODs
+     */
+    void DrawMesh(const Mesh* mesh, uint32_t indexCount, uint32_t firstIndex = 0);
+
+    /**
+     * @brief Let the object draw itself; forgets bound state since the object changes it
+     */
+    void DrawObject(GameObject* object);
+
+    const std::vector<RenderCommand>& GetCommands() const { return m_commands; }
+    const ObjectConstants& GetObjectConstants(uint32_t index) const
+    {
+        ASSERT_MSG(index < m_constants.size(), "Object constants index %u out of range", index);
+        return m_constants[index];
+    }
+
+    DirectX::XMMATRIX GetView() const { return DirectX::XMLoadFloat4x4(&m_view); }
+    DirectX::XMMATRIX GetProjection() const { return DirectX::XMLoadFloat4x4(&m_projection); }
+
+    uint32_t GetDrawCount() const { return m_drawCount; }
+    bool HasObjectDraws() const { return m_objectDrawCount > 0; }
+    bool IsEmpty() const { return m_commands.empty(); }
+
+    // ========================================================================
+    // CONSOLE INTEGRATION
+    // ========================================================================
+
+    /**
+     * @brief Record synthetic draws on one thread and across the job system and replay both through a null backend
+     * @param drawCount Draws per recording
+     */
+    static std::string Console_Benchmark(int drawCount);
+
+private:
+    std::vector<RenderCommand> m_commands;
+    std::vector<ObjectConstants> m_constants;
+    DirectX::XMFLOAT4X4 m_view{};
+    DirectX::XMFLOAT4X4 m_projection{};
+
+    // Recording state
+    bool m_basicShadersBound = false;
+    const Material* m_boundMaterial = nullptr;
+    uint32_t m_drawCount = 0;
+    uint32_t m_objectDrawCount = 0;
+};
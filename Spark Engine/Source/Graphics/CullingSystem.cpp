@@ -0,0 +1,475 @@
+/**
+ * @file CullingSystem.cpp
+ * @brief Implementation of the SoA frustum culling kernels
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * The kernel is written once against a lane abstraction, as in
+ * CollisionSystemBatch.cpp, and instantiated for AVX, SSE and plain floats.
+ * All three evaluate the same expressions in the same order, so their
+ * results match the scalar reference exactly.
+ */
+
+#include "CullingSystem.h"
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define SPARK_CULLING_SSE 1
+#endif
+
+// MSVC accepts AVX intrinsics without /arch:AVX; the kernel is then picked at run time
+#if defined(__AVX__) || (defined(_MSC_VER) && SPARK_CULLING_SSE)
+#define SPARK_CULLING_AVX 1
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+using namespace DirectX;
+
+namespace
+{
+    constexpr float UnboundedSize = 1e30f;      ///< Sphere radius and box extent of objects without bounds
+    constexpr float DeadRadius = -1e30f;        ///< Fails every plane: free and padding slots
+
+    size_t PaddedSize(size_t count) { return (count + 7) & ~size_t(7); }
+
+    // ------------------------------------------------------------------------
+    // Lanes
+    // ------------------------------------------------------------------------
+
+    struct ScalarLane
+    {
+        using Type = float;
+        using Mask = bool;
+        static constexpr int Width = 1;
+
+        static Type Load(const float* p) { return *p; }
+        static Type Set(float v) { return v; }
+        static Type Add(Type a, Type b) { return a + b; }
+        static Type Mul(Type a, Type b) { return a * b; }
+        static Type Neg(Type a) { return -a; }
+        static Mask GreaterEq(Type a, Type b) { return a >= b; }
+        static Mask And(Mask a, Mask b) { return a && b; }
+        static Mask True() { return true; }
+        static uint32_t Bits(Mask m) { return m ? 1u : 0u; }
+    };
+
+#if SPARK_CULLING_SSE
+    struct SseLane
+    {
+        using Type = __m128;
+        using Mask = __m128;
+        static constexpr int Width = 4;
+
+        static Type Load(const float* p) { return _mm_loadu_ps(p); }
+        static Type Set(float v) { return _mm_set1_ps(v); }
+        static Type Add(Type a, Type b) { return _mm_add_ps(a, b); }
+        static Type Mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+        static Type Neg(Type a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+        static Mask GreaterEq(Type a, Type b) { return _mm_cmpge_ps(a, b); }
+        static Mask And(Mask a, Mask b) { return _mm_and_ps(a, b); }
+        static Mask True() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+        static uint32_t Bits(Mask m) { return static_cast<uint32_t>(_mm_movemask_ps(m)); }
+    };
+#endif
+
+#if SPARK_CULLING_AVX
+    struct AvxLane
+    {
+        using Type = __m256;
+        using Mask = __m256;
+        static constexpr int Width = 8;
+
+        static Type Load(const float* p) { return _mm256_loadu_ps(p); }
+        static Type Set(float v) { return _mm256_set1_ps(v); }
+        static Type Add(Type a, Type b) { return _mm256_add_ps(a, b); }
+        static Type Mul(Type a, Type b) { return _mm256_mul_ps(a, b); }
+        static Type Neg(Type a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+        static Mask GreaterEq(Type a, Type b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+        static Mask And(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+        static Mask True() { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+        static uint32_t Bits(Mask m) { return static_cast<uint32_t>(_mm256_movemask_ps(m)); }
+    };
+#endif
+
+#if SPARK_CULLING_SSE
+    using NarrowLane = SseLane;
+#else
+    using NarrowLane = ScalarLane;
+#endif
+
+    bool CpuSupportsAvx()
+    {
+#if defined(__AVX__)
+        return true;
+#elif SPARK_CULLING_AVX
+        int info[4];
+        __cpuid(info, 1);
+        const bool osSavesYmm = (info[2] & (1 << 27)) != 0;
+        const bool hasAvx = (info[2] & (1 << 28)) != 0;
+        return osSavesYmm && hasAvx && (_xgetbv(0) & 0x6) == 0x6;
+#else
+        return false;
+#endif
+    }
+
+    const bool g_useAvx = CpuSupportsAvx();
+
+    struct BoundsArrays
+    {
+        const float* sphereX; const float* sphereY; const float* sphereZ; const float* sphereRadius;
+        const float* boxX; const float* boxY; const float* boxZ;
+        const float* extentX; const float* extentY; const float* extentZ;
+    };
+
+    /**
+     * Sphere: n.c + d >= -r. Box: n.c + d + |n|.e >= 0 (the corner furthest
+     * along the normal is inside). Visible when both hold for all six planes.
+     */
+    template<typename L>
+    uint32_t TestBlock(const Frustum& frustum, const BoundsArrays& a, uint32_t i)
+    {
+        const auto sx = L::Load(a.sphereX + i), sy = L::Load(a.sphereY + i), sz = L::Load(a.sphereZ + i);
+        const auto negRadius = L::Neg(L::Load(a.sphereRadius + i));
+        const auto bx = L::Load(a.boxX + i), by = L::Load(a.boxY + i), bz = L::Load(a.boxZ + i);
+        const auto ex = L::Load(a.extentX + i), ey = L::Load(a.extentY + i), ez = L::Load(a.extentZ + i);
+        const auto zero = L::Set(0.0f);
+
+        auto inside = L::True();
+        for (const XMFLOAT4& plane : frustum.planes)
+        {
+            const auto nx = L::Set(plane.x), ny = L::Set(plane.y), nz = L::Set(plane.z), d = L::Set(plane.w);
+            const auto sphereDistance = L::Add(L::Add(L::Add(L::Mul(nx, sx), L::Mul(ny, sy)), L::Mul(nz, sz)), d);
+            const auto boxDistance = L::Add(L::Add(L::Add(L::Mul(nx, bx), L::Mul(ny, by)), L::Mul(nz, bz)), d);
+            const auto reach = L::Add(L::Add(L::Mul(L::Set(std::fabs(plane.x)), ex), L::Mul(L::Set(std::fabs(plane.y)), ey)),
+                                      L::Mul(L::Set(std::fabs(plane.z)), ez));
+            inside = L::And(inside, L::And(L::GreaterEq(sphereDistance, negRadius),
+                                           L::GreaterEq(L::Add(boxDistance, reach), zero)));
+            if (L::Bits(inside) == 0) return 0;
+        }
+        return L::Bits(inside);
+    }
+
+    template<typename L>
+    uint32_t RunKernel(const Frustum& frustum, const BoundsArrays& arrays, uint32_t begin, uint32_t end,
+                       CullingSystem::Handle* out)
+    {
+        uint32_t written = 0;
+        uint32_t i = begin;
+        for (; i + L::Width <= end; i += L::Width)
+        {
+            for (uint32_t bits = TestBlock<L>(frustum, arrays, i); bits != 0; bits &= bits - 1)
+                out[written++] = i + static_cast<uint32_t>(std::countr_zero(bits));
+        }
+        for (; i < end; ++i)
+            if (TestBlock<ScalarLane>(frustum, arrays, i)) out[written++] = i;
+
+#if SPARK_CULLING_AVX && !defined(__AVX__)
+        if constexpr (L::Width == 8) _mm256_zeroupper();
+#endif
+        return written;
+    }
+}
+
+// ============================================================================
+// FRUSTUM
+// ============================================================================
+
+Frustum Frustum::FromViewProjection(FXMMATRIX viewProjection)
+{
+    // Row vectors: clip = v * M, so each plane combines columns of M
+    const XMMATRIX columns = XMMatrixTranspose(viewProjection);
+    const XMVECTOR planes[6] = {
+        XMVectorAdd(columns.r[3], columns.r[0]),        // Left:   -w <= x
+        XMVectorSubtract(columns.r[3], columns.r[0]),   // Right:   x <= w
+        XMVectorAdd(columns.r[3], columns.r[1]),        // Bottom: -w <= y
+        XMVectorSubtract(columns.r[3], columns.r[1]),   // Top:     y <= w
+        columns.r[2],                                   // Near:    0 <= z
+        XMVectorSubtract(columns.r[3], columns.r[2]),   // Far:     z <= w
+    };
+
+    Frustum frustum;
+    for (int i = 0; i < 6; ++i)
+        XMStoreFloat4(&frustum.planes[i], XMPlaneNormalize(planes[i]));
+    return frustum;
+}
+
+// ============================================================================
+// REGISTRATION
+// ============================================================================
+
+CullingSystem& CullingSystem::GetInstance()
+{
+    static CullingSystem* instance = new CullingSystem();
+    return *instance;
+}
+
+CullingSystem::Handle CullingSystem::Register(void* userData)
+{
+    Handle handle;
+    if (!m_freeHandles.empty()) {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    }
+    else {
+        handle = static_cast<Handle>(m_userData.size());
+        m_userData.push_back(nullptr);
+        m_live.push_back(0);
+
+        const size_t padded = PaddedSize(m_userData.size());
+        if (padded > m_sphereRadius.size()) {
+            for (std::vector<float>* array : { &m_sphereX, &m_sphereY, &m_sphereZ, &m_boxX, &m_boxY, &m_boxZ,
+                                               &m_extentX, &m_extentY, &m_extentZ })
+                array->resize(padded, 0.0f);
+            m_sphereRadius.resize(padded, DeadRadius);
+        }
+    }
+
+    m_userData[handle] = userData;
+    m_live[handle] = 1;
+    ++m_liveCount;
+    SetUnbounded(handle);
+    return handle;
+}
+
+void CullingSystem::Unregister(Handle handle)
+{
+    ASSERT_MSG(IsValid(handle), "CullingSystem::Unregister given dead handle %u", handle);
+    if (!IsValid(handle)) return;
+
+    SetSlotDead(handle);
+    m_userData[handle] = nullptr;
+    m_live[handle] = 0;
+    m_freeHandles.push_back(handle);
+    --m_liveCount;
+}
+
+void CullingSystem::SetSlotDead(Handle handle)
+{
+    m_sphereX[handle] = m_sphereY[handle] = m_sphereZ[handle] = 0.0f;
+    m_sphereRadius[handle] = DeadRadius;
+    m_boxX[handle] = m_boxY[handle] = m_boxZ[handle] = 0.0f;
+    m_extentX[handle] = m_extentY[handle] = m_extentZ[handle] = 0.0f;
+}
+
+void CullingSystem::SetBounds(Handle handle, const XMFLOAT3& localMin, const XMFLOAT3& localMax, FXMMATRIX world)
+{
+    ASSERT_MSG(IsValid(handle), "CullingSystem::SetBounds given dead handle %u", handle);
+
+    const XMVECTOR localCenter = XMVectorScale(XMVectorAdd(XMLoadFloat3(&localMin), XMLoadFloat3(&localMax)), 0.5f);
+    const XMVECTOR localExtent = XMVectorScale(XMVectorSubtract(XMLoadFloat3(&localMax), XMLoadFloat3(&localMin)), 0.5f);
+    XMFLOAT3 e;
+    XMStoreFloat3(&e, localExtent);
+
+    // Exact box of the transformed box: each world axis gathers |row| * extent
+    XMFLOAT3 center, extent;
+    XMStoreFloat3(&center, XMVector3TransformCoord(localCenter, world));
+    const XMVECTOR worldExtent = XMVectorAdd(XMVectorAdd(
+        XMVectorScale(XMVectorAbs(world.r[0]), e.x),
+        XMVectorScale(XMVectorAbs(world.r[1]), e.y)),
+        XMVectorScale(XMVectorAbs(world.r[2]), e.z));
+    XMStoreFloat3(&extent, worldExtent);
+
+    // Sphere: around the oriented box, or around the world box if that is smaller
+    const float maxAxisScale = std::max({ XMVectorGetX(XMVector3Length(world.r[0])),
+                                          XMVectorGetX(XMVector3Length(world.r[1])),
+                                          XMVectorGetX(XMVector3Length(world.r[2])) });
+    const float radius = std::min(XMVectorGetX(XMVector3Length(localExtent)) * maxAxisScale,
+                                  XMVectorGetX(XMVector3Length(worldExtent)));
+
+    m_sphereX[handle] = m_boxX[handle] = center.x;
+    m_sphereY[handle] = m_boxY[handle] = center.y;
+    m_sphereZ[handle] = m_boxZ[handle] = center.z;
+    m_sphereRadius[handle] = radius;
+    m_extentX[handle] = extent.x;
+    m_extentY[handle] = extent.y;
+    m_extentZ[handle] = extent.z;
+}
+
+void CullingSystem::SetUnbounded(Handle handle)
+{
+    ASSERT_MSG(IsValid(handle), "CullingSystem::SetUnbounded given dead handle %u", handle);
+    m_sphereX[handle] = m_sphereY[handle] = m_sphereZ[handle] = 0.0f;
+    m_sphereRadius[handle] = UnboundedSize;
+    m_boxX[handle] = m_boxY[handle] = m_boxZ[handle] = 0.0f;
+    m_extentX[handle] = m_extentY[handle] = m_extentZ[handle] = UnboundedSize;
+}
+
+void* CullingSystem::GetUserData(Handle handle) const
+{
+    ASSERT_MSG(IsValid(handle), "CullingSystem::GetUserData given dead handle %u", handle);
+    return m_userData[handle];
+}
+
+void CullingSystem::GetWorldSphere(Handle handle, XMFLOAT3& center, float& radius) const
+{
+    ASSERT_MSG(IsValid(handle), "CullingSystem::GetWorldSphere given dead handle %u", handle);
+    center = XMFLOAT3(m_sphereX[handle], m_sphereY[handle], m_sphereZ[handle]);
+    radius = m_sphereRadius[handle];
+}
+
+void CullingSystem::GetWorldBox(Handle handle, XMFLOAT3& minimum, XMFLOAT3& maximum) const
+{
+    ASSERT_MSG(IsValid(handle), "CullingSystem::GetWorldBox given dead handle %u", handle);
+    minimum = XMFLOAT3(m_boxX[handle] - m_extentX[handle], m_boxY[handle] - m_extentY[handle], m_boxZ[handle] - m_extentZ[handle]);
+    maximum = XMFLOAT3(m_boxX[handle] + m_extentX[handle], m_boxY[handle] + m_extentY[handle], m_boxZ[handle] + m_extentZ[handle]);
+}
+
+// ============================================================================
+// CULLING
+// ============================================================================
+
+int CullingSystem::GetSimdWidth()
+{
+#if SPARK_CULLING_AVX
+    if (g_useAvx) return 8;
+#endif
+    return NarrowLane::Width;
+}
+
+uint32_t CullingSystem::CullRange(const Frustum& frustum, uint32_t begin, uint32_t end, Handle* out) const
+{
+    ASSERT_MSG(end <= m_userData.size(), "CullRange end %u is past the registry", end);
+    const BoundsArrays arrays{ m_sphereX.data(), m_sphereY.data(), m_sphereZ.data(), m_sphereRadius.data(),
+                               m_boxX.data(), m_boxY.data(), m_boxZ.data(),
+                               m_extentX.data(), m_extentY.data(), m_extentZ.data() };
+#if SPARK_CULLING_AVX
+    if (g_useAvx) return RunKernel<AvxLane>(frustum, arrays, begin, end, out);
+#endif
+    return RunKernel<NarrowLane>(frustum, arrays, begin, end, out);
+}
+
+uint32_t CullingSystem::CullRangeScalar(const Frustum& frustum, uint32_t begin, uint32_t end, Handle* out) const
+{
+    ASSERT_MSG(end <= m_userData.size(), "CullRangeScalar end %u is past the registry", end);
+    const BoundsArrays arrays{ m_sphereX.data(), m_sphereY.data(), m_sphereZ.data(), m_sphereRadius.data(),
+                               m_boxX.data(), m_boxY.data(), m_boxZ.data(),
+                               m_extentX.data(), m_extentY.data(), m_extentZ.data() };
+    return RunKernel<ScalarLane>(frustum, arrays, begin, end, out);
+}
+
+void CullingSystem::Cull(const Frustum& frustum, std::vector<Handle>& visible) const
+{
+    const uint32_t count = static_cast<uint32_t>(m_userData.size());
+    visible.resize(count);
+    if (count <= ObjectsPerJob) {
+        visible.resize(CullRange(frustum, 0, count, visible.data()));
+        return;
+    }
+
+    // Each chunk writes at its own offset, then the results slide down in order
+    const uint32_t chunks = (count + ObjectsPerJob - 1) / ObjectsPerJob;
+    std::vector<uint32_t> written(chunks);
+    JobSystem::GetInstance().ParallelFor(chunks, 1, [&](uint32_t chunkBegin, uint32_t chunkEnd) {
+        for (uint32_t chunk = chunkBegin; chunk < chunkEnd; ++chunk)
+        {
+            const uint32_t begin = chunk * ObjectsPerJob;
+            const uint32_t end = std::min(begin + ObjectsPerJob, count);
+            written[chunk] = CullRange(frustum, begin, end, visible.data() + begin);
+        }
+    });
+
+    size_t total = 0;
+    for (uint32_t chunk = 0; chunk < chunks; ++chunk)
+    {
+        const Handle* source = visible.data() + static_cast<size_t>(chunk) * ObjectsPerJob;
+        std::copy(source, source + written[chunk], visible.data() + total);
+        total += written[chunk];
+    }
+    visible.resize(total);
+}
+
+// ============================================================================
+// CONSOLE INTEGRATION
+// ============================================================================
+
+std::string CullingSystem::Console_Benchmark(int objectCount)
+{
+    using Clock = std::chrono::high_resolution_clock;
+    objectCount = std::clamp(objectCount, 8, 10000000);
+    constexpr int Repeats = 10;
+
+    // A camera at the origin looking down +Z over objects scattered through a 1 km cube
+    const XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(0, 0, 0, 1), XMVectorSet(0, 0, 1, 1), XMVectorSet(0, 1, 0, 0));
+    const XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.1f, 1000.0f);
+    const Frustum frustum = Frustum::FromViewProjection(XMMatrixMultiply(view, projection));
+
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> size(0.1f, 3.0f);
+    std::uniform_real_distribution<float> angle(-XM_PI, XM_PI);
+
+    CullingSystem culling;
+    std::vector<XMFLOAT3> positions(objectCount);
+    for (int i = 0; i < objectCount; ++i)
+    {
+        const Handle handle = culling.Register(nullptr);
+        positions[i] = XMFLOAT3(position(rng), position(rng), position(rng));
+        const XMFLOAT3 half(size(rng), size(rng) * ((i % 5 == 0) ? 6.0f : 1.0f), size(rng));
+        const XMMATRIX world = XMMatrixRotationRollPitchYaw(0.0f, angle(rng), 0.0f) *
+                               XMMatrixTranslation(positions[i].x, positions[i].y, positions[i].z);
+        culling.SetBounds(handle, XMFLOAT3(-half.x, -half.y, -half.z), half, world);
+    }
+
+    auto best = [&](auto&& body) {
+        double bestMs = 1e30;
+        for (int repeat = 0; repeat < Repeats; ++repeat)
+        {
+            auto start = Clock::now();
+            body();
+            bestMs = std::min(bestMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+        return bestMs;
+    };
+
+    // What CullObjects() did before: every object a 5-unit sphere at its position, one at a time
+    XMVECTOR planes[6];
+    for (int i = 0; i < 6; ++i) planes[i] = XMLoadFloat4(&frustum.planes[i]);
+    uint32_t legacyVisible = 0;
+    const double legacyMs = best([&]() {
+        legacyVisible = 0;
+        for (const XMFLOAT3& p : positions)
+        {
+            const XMVECTOR center = XMLoadFloat3(&p);
+            bool isVisible = true;
+            for (const XMVECTOR& plane : planes)
+                if (XMVectorGetX(XMPlaneDotCoord(plane, center)) < -5.0f) { isVisible = false; break; }
+            legacyVisible += isVisible ? 1 : 0;
+        }
+    });
+
+    const uint32_t count = static_cast<uint32_t>(culling.GetCapacity());
+    std::vector<Handle> scalarVisible(count), simdVisible(count), parallelVisible;
+    uint32_t scalarCount = 0, simdCount = 0;
+    const double scalarMs = best([&]() { scalarCount = culling.CullRangeScalar(frustum, 0, count, scalarVisible.data()); });
+    const double simdMs = best([&]() { simdCount = culling.CullRange(frustum, 0, count, simdVisible.data()); });
+    const double parallelMs = best([&]() { culling.Cull(frustum, parallelVisible); });
+    scalarVisible.resize(scalarCount);
+    simdVisible.resize(simdCount);
+
+    const bool simdMatches = simdVisible == scalarVisible;
+    const bool parallelMatches = parallelVisible == scalarVisible;
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "=== Frustum Culling Benchmark ===\n";
+    ss << objectCount << " objects, " << GetSimdWidth() << "-wide kernel, " << JobSystem::GetInstance().GetThreadCount()
+       << " job threads, best of " << Repeats << "\n";
+    ss << "Legacy (5-unit sphere per object): " << legacyMs << " ms, " << legacyVisible << " visible\n";
+    ss << "Scalar SoA (sphere + box):         " << scalarMs << " ms, " << scalarCount << " visible\n";
+    ss << "SIMD:                              " << simdMs << " ms (" << scalarMs / simdMs << "x scalar)\n";
+    ss << "SIMD + jobs:                       " << parallelMs << " ms (" << scalarMs / parallelMs << "x scalar)\n";
+    ss << "SIMD matches scalar: " << (simdMatches ? "yes" : "NO") << ", parallel matches scalar: "
+       << (parallelMatches ? "yes" : "NO") << "\n";
+    return ss.str();
+}
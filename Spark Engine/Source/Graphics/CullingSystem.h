@@ -0,0 +1,156 @@
+/**
+ * @file CullingSystem.h
+ * @brief SIMD frustum culling over structure-of-arrays world bounds
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * Every registered object keeps a world bounding sphere and a world AABB
+ * (centre and half extents) in parallel float arrays. Bounds are only
+ * recomputed when the owner reports a transform or mesh change. Culling
+ * streams through the arrays testing 8 objects per AVX iteration (4 with
+ * SSE) against all six planes: the sphere test rejects most objects cheaply
+ * and the box test tightens the result for long or flat meshes. The output is
+ * a compact list of visible handles in ascending order.
+ *
+ * The AVX kernel is compiled whenever the compiler accepts AVX intrinsics
+ * and is chosen at run time when the CPU and OS support it, so builds without
+ * /arch:AVX still get 8-wide culling.
+ */
+
+#pragma once
+
+#include "Utils/Assert.h"
+#include <DirectXMath.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Six normalized planes, normals pointing inward: left, right, bottom, top, near, far
+ */
+struct Frustum
+{
+    DirectX::XMFLOAT4 planes[6];
+
+    /**
+     * @brief Extract the planes of a Direct3D view-projection matrix (row vectors, clip z in [0, w])
+     */
+    static Frustum FromViewProjection(DirectX::FXMMATRIX viewProjection);
+};
+
+/**
+ * @brief Registry of world bounds with batched frustum tests
+ *
+ * Register, SetBounds and Unregister must not overlap with Cull(); Cull()
+ * itself may be called from several threads at once.
+ */
+class CullingSystem
+{
+public:
+    using Handle = uint32_t;
+    static constexpr Handle InvalidHandle = 0xFFFFFFFFu;
+    static constexpr uint32_t ObjectsPerJob = 4096;
+
+    CullingSystem() = default;
+
+    /**
+     * @brief Engine-wide registry used by GraphicsEngine for scene objects
+     *
+     * Never destroyed, so objects released during static destruction can still unregister.
+     */
+    static CullingSystem& GetInstance();
+
+    // ========================================================================
+    // REGISTRATION
+    // ========================================================================
+
+    /**
+     * @brief Add an object; it is unbounded (always visible) until SetBounds()
+     * @param userData Returned by GetUserData() for the handle
+     */
+    Handle Register(void* userData);
+    void Unregister(Handle handle);
+
+    /**
+     * @brief Recompute the world sphere and box from local bounds and a world matrix
+     */
+    void SetBounds(Handle handle, const DirectX::XMFLOAT3& localMin, const DirectX::XMFLOAT3& localMax,
+                   DirectX::FXMMATRIX world);
+
+    /**
+     * @brief Mark an object as having no usable bounds; it always passes the test
+     */
+    void SetUnbounded(Handle handle);
+
+    bool IsValid(Handle handle) const { return handle < m_userData.size() && m_live[handle]; }
+    void* GetUserData(Handle handle) const;
+    size_t GetCount() const { return m_liveCount; }
+
+    /**
+     * @brief Slots in the arrays, live or free; handles are always below this
+     */
+    size_t GetCapacity() const { return m_userData.size(); }
+
+    void GetWorldSphere(Handle handle, DirectX::XMFLOAT3& center, float& radius) const;
+    void GetWorldBox(Handle handle, DirectX::XMFLOAT3& minimum, DirectX::XMFLOAT3& maximum) const;
+
+    /**
+     * @brief World sphere arrays indexed by handle, GetCapacity() long; free slots have a negative radius
+     */
+    const float* GetSphereX() const { return m_sphereX.data(); }
+    const float* GetSphereY() const { return m_sphereY.data(); }
+    const float* GetSphereZ() const { return m_sphereZ.data(); }
+    const float* GetSphereRadius() const { return m_sphereRadius.data(); }
+
+    // ========================================================================
+    // CULLING
+    // ========================================================================
+
+    /**
+     * @brief Handles of every live object intersecting the frustum, in ascending order
+     *
+     * Large registries are split over the JobSystem.
+     * @param visible Receives the handles; resized to the result
+     */
+    void Cull(const Frustum& frustum, std::vector<Handle>& visible) const;
+
+    /**
+     * @brief Test handles [begin, end) on the calling thread with the widest available kernel
+     * @param out Receives up to end - begin handles
+     * @return Number of handles written
+     */
+    uint32_t CullRange(const Frustum& frustum, uint32_t begin, uint32_t end, Handle* out) const;
+
+    /**
+     * @brief Same test one object at a time, as the reference for the SIMD kernels
+     */
+    uint32_t CullRangeScalar(const Frustum& frustum, uint32_t begin, uint32_t end, Handle* out) const;
+
+    /**
+     * @brief Lane width of the kernel CullRange() uses on this machine (8, 4 or 1)
+     */
+    static int GetSimdWidth();
+
+    // ========================================================================
+    // CONSOLE INTEGRATION
+    // ========================================================================
+
+    /**
+     * @brief Time the old per-object test, the scalar, SIMD and parallel paths, and compare results
+     * @param objectCount Objects scattered around the camera
+     */
+    static std::string Console_Benchmark(int objectCount);
+
+private:
+    void SetSlotDead(Handle handle);
+
+    // Structure of arrays, padded to a multiple of 8 with dead slots
+    std::vector<float> m_sphereX, m_sphereY, m_sphereZ, m_sphereRadius;
+    std::vector<float> m_boxX, m_boxY, m_boxZ;              ///< Box centre
+    std::vector<float> m_extentX, m_extentY, m_extentZ;     ///< Box half extents
+
+    std::vector<void*> m_userData;
+    std::vector<uint8_t> m_live;
+    std::vector<Handle> m_freeHandles;
+    size_t m_liveCount = 0;
+};
@@ -0,0 +1,138 @@
+/**
+ * @file D3D11RenderBackend.cpp
+ * @brief Implementation of command buffer replay on D3D11
+ * @author Spark Engine Team
+ * @date 2025
+ */
+
+#include "D3D11RenderBackend.h"
+#include "GraphicsEngine.h"
+#include "MaterialSystem.h"
+#include "Mesh.h"
+#include "../Game/GameObject.h"
+#include "../Utils/SparkConsole.h"
+#include "Core/JobSystem.h"
+
+using Microsoft::WRL::ComPtr;
+
+D3D11RenderBackend::D3D11RenderBackend(GraphicsEngine& engine, ID3D11Device* device, ID3D11DeviceContext* immediateContext)
+    : m_engine(engine)
+    , m_device(device)
+    , m_immediateContext(immediateContext)
+{
+    ASSERT_MSG(device && immediateContext, "D3D11RenderBackend needs a device and context (device %p)", static_cast<void*>(device));
+
+    D3D11_FEATURE_DATA_THREADING threading = {};
+    if (SUCCEEDED(m_device->CheckFeatureSupport(D3D11_FEATURE_THREADING, &threading, sizeof(threading)))) {
+        m_driverCommandLists = threading.DriverCommandLists != FALSE;
+    }
+}
+
+void D3D11RenderBackend::Execute(const CommandBuffer* const* buffers, size_t count)
+{
+    bool deferred = m_useDeferredContexts && count > 1;
+    for (size_t i = 0; i < count && deferred; ++i) {
+        deferred = !buffers[i]->HasObjectDraws();
+    }
+
+    if (deferred) {
+        ExecuteDeferred(buffers, count);
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            Replay(*buffers[i], m_immediateContext.Get());
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        CountCommands(*buffers[i]);
+    }
+}
+
+void D3D11RenderBackend::Replay(const CommandBuffer& buffer, ID3D11DeviceContext* context)
+{
+    for (const RenderCommand& command : buffer.GetCommands()) {
+        switch (command.type) {
+        case RenderCommandType::BindBasicShaders:
+            m_engine.SetBasicShaders(context);
+            break;
+        case RenderCommandType::BindMaterial:
+            static_cast<const Material*>(command.resource)->BindToShader(context);
+            break;
+        case RenderCommandType::SetObjectConstants:
+            m_engine.UploadObjectConstants(context, buffer.GetObjectConstants(command.arg));
+            break;
+        case RenderCommandType::DrawMesh:
+            static_cast<const Mesh*>(command.resource)->Render(context, command.arg, command.first);
+            break;
+        case RenderCommandType::DrawObject:
+            ASSERT_MSG(context == m_immediateContext.Get(), "DrawObject replayed on a deferred context (%p)",
+                       static_cast<void*>(context));
+            static_cast<GameObject*>(const_cast<void*>(command.resource))->Render(buffer.GetView(), buffer.GetProjection());
+            break;
+        }
+    }
+}
+
+void D3D11RenderBackend::ExecuteDeferred(const CommandBuffer* const* buffers, size_t count)
+{
+    while (m_deferredContexts.size() < count) {
+        ComPtr<ID3D11DeviceContext> context;
+        if (FAILED(m_device->CreateDeferredContext(0, &context))) {
+            Spark::SimpleConsole::GetInstance().LogWarning("CreateDeferredContext failed; replaying on the immediate context");
+            m_useDeferredContexts = false;
+            for (size_t i = 0; i < count; ++i) {
+                Replay(*buffers[i], m_immediateContext.Get());
+            }
+            return;
+        }
+        m_deferredContexts.push_back(context);
+    }
+    m_commandLists.resize(m_deferredContexts.size());
+
+    // Output-merger and rasterizer state every deferred context starts from
+    ID3D11RenderTargetView* renderTargets[D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT] = {};
+    ComPtr<ID3D11DepthStencilView> depthStencilView;
+    m_immediateContext->OMGetRenderTargets(D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT, renderTargets, &depthStencilView);
+    UINT viewportCount = D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
+    D3D11_VIEWPORT viewports[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
+    m_immediateContext->RSGetViewports(&viewportCount, viewports);
+    ComPtr<ID3D11RasterizerState> rasterState;
+    m_immediateContext->RSGetState(&rasterState);
+    ComPtr<ID3D11DepthStencilState> depthState;
+    UINT stencilRef = 0;
+    m_immediateContext->OMGetDepthStencilState(&depthState, &stencilRef);
+    ComPtr<ID3D11BlendState> blendState;
+    FLOAT blendFactor[4] = {};
+    UINT sampleMask = 0xFFFFFFFF;
+    m_immediateContext->OMGetBlendState(&blendState, blendFactor, &sampleMask);
+
+    JobSystem::GetInstance().ParallelFor(static_cast<uint32_t>(count), 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            ID3D11DeviceContext* context = m_deferredContexts[i].Get();
+            context->OMSetRenderTargets(D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT, renderTargets, depthStencilView.Get());
+            context->RSSetViewports(viewportCount, viewports);
+            context->RSSetState(rasterState.Get());
+            context->OMSetDepthStencilState(depthState.Get(), stencilRef);
+            context->OMSetBlendState(blendState.Get(), blendFactor, sampleMask);
+
+            Replay(*buffers[i], context);
+            if (FAILED(context->FinishCommandList(FALSE, &m_commandLists[i]))) {
+                m_commandLists[i].Reset();
+            }
+        }
+    });
+
+    for (ID3D11RenderTargetView* view : renderTargets) {
+        if (view) view->Release();
+    }
+
+    // Command lists run in buffer order; keep the immediate context's state for the next pass
+    for (size_t i = 0; i < count; ++i) {
+        if (m_commandLists[i]) {
+            m_immediateContext->ExecuteCommandList(m_commandLists[i].Get(), TRUE);
+            m_commandLists[i].Reset();
+        } else {
+            Spark::SimpleConsole::GetInstance().LogWarning("FinishCommandList failed; a command buffer was dropped");
+        }
+    }
+}
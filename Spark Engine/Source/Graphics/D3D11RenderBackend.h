@@ -0,0 +1,64 @@
+/**
+ * @file D3D11RenderBackend.h
+ * @brief Replays command buffers on a D3D11 device
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * By default every buffer is replayed on the immediate context in order.
+ * With deferred contexts enabled, a batch of buffers is replayed on one
+ * deferred context each across the job system, and the resulting command
+ * lists are executed on the immediate context in buffer order. A deferred
+ * context starts with no state, so before replay it is given the immediate
+ * context's render targets, viewport, rasterizer, depth-stencil and blend
+ * state; anything else the pass relies on has to be recorded in the buffer.
+ */
+
+#pragma once
+
+#include "RenderBackend.h"
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <vector>
+
+class GraphicsEngine;
+
+class D3D11RenderBackend : public RenderBackend
+{
+public:
+    /**
+     * @param engine Supplies the basic shaders and the per-object constant buffer
+     */
+    D3D11RenderBackend(GraphicsEngine& engine, ID3D11Device* device, ID3D11DeviceContext* immediateContext);
+
+    RenderBackendType GetType() const override { return RenderBackendType::D3D11; }
+    const char* GetName() const override { return "d3d11"; }
+
+    void Execute(const CommandBuffer* const* buffers, size_t count) override;
+    using RenderBackend::Execute;
+
+    /**
+     * @brief Replay batches of buffers through deferred contexts
+     *
+     * Batches containing DrawObject commands always use the immediate
+     * context, since those objects draw through it themselves.
+     */
+    void SetUseDeferredContexts(bool enabled) { m_useDeferredContexts = enabled; }
+    bool GetUseDeferredContexts() const { return m_useDeferredContexts; }
+
+    /**
+     * @brief True if the driver builds command lists natively rather than through runtime emulation
+     */
+    bool HasDriverCommandLists() const { return m_driverCommandLists; }
+
+private:
+    void Replay(const CommandBuffer& buffer, ID3D11DeviceContext* context);
+    void ExecuteDeferred(const CommandBuffer* const* buffers, size_t count);
+
+    GraphicsEngine& m_engine;
+    Microsoft::WRL::ComPtr<ID3D11Device> m_device;
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext> m_immediateContext;
+    std::vector<Microsoft::WRL::ComPtr<ID3D11DeviceContext>> m_deferredContexts;
+    std::vector<Microsoft::WRL::ComPtr<ID3D11CommandList>> m_commandLists;
+    bool m_useDeferredContexts = false;
+    bool m_driverCommandLists = false;
+};
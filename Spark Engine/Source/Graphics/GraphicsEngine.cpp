@@ -17,6 +17,10 @@
 #include "RenderTarget.h"
 #include "../Physics/PhysicsSystem.h"
 #include "../Game/GameObject.h"
+#include "CullingSystem.h"
+#include "MeshSimplifier.h"
+#include "D3D11RenderBackend.h"
+#include "../Core/JobSystem.h"
 
 // Include Windows headers for DirectX
 #include <Windows.h>
@@ -133,6 +137,9 @@ GraphicsEngine::GraphicsEngine()
     // Initialize statistics
     m_statistics = {};
 
+    // Recorded commands have somewhere to go before the device exists
+    m_backend = std::make_unique<NullRenderBackend>();
+
     // Create advanced systems
     try {
         m_textureSystem = std::make_unique<TextureSystem>();
@@ -323,6 +330,8 @@ HRESULT GraphicsEngine::Initialize(HWND hWnd)
     } else {
         LOG_TO_CONSOLE_IMMEDIATE(L"Basic shaders initialized successfully", L"SUCCESS");
     }
+
+    SetRenderBackend(m_backendType);
     
     return S_OK;  // ✅ FIXED: Missing return statement
 }
@@ -381,6 +390,9 @@ void GraphicsEngine::Shutdown()
         LOG_TO_CONSOLE_IMMEDIATE(L"TemporalEffects shutdown complete", L"INFO");
     }
 
+    // The D3D11 backend holds device references
+    m_backend = std::make_unique<NullRenderBackend>();
+
     // Release DirectX resources
     m_hdrSRV.Reset();
     m_hdrRTV.Reset();
@@ -420,6 +432,10 @@ void GraphicsEngine::BeginFrame()
     
     m_frameStartTime = std::chrono::high_resolution_clock::now();
 
+    // Transient per-frame allocations from the previous frame are dead now
+    FrameArena::GetFrame().BeginFrame();
+    FrameArena::GetInFlight().BeginFrame();
+
     ASSERT(m_context && m_renderTargetView && m_depthStencilView);
     
     if (!m_context || !m_renderTargetView || !m_depthStencilView) {
@@ -499,14 +515,16 @@ void GraphicsEngine::EndFrame()
 // ============================================================================
 
 void GraphicsEngine::RenderScene(const DirectX::XMMATRIX& viewMatrix, const DirectX::XMMATRIX& projMatrix,
-    const std::vector<GameObject*>& objects)
+    const FrameVector<GameObject*>& objects)
 {
-    std::vector<GameObject*> visibleObjects;
+    FrameVector<GameObject*> visibleObjects;
     
     if (m_settings.frustumCulling) {
         CullObjects(objects, viewMatrix, projMatrix, visibleObjects);
     } else {
         visibleObjects = objects;
+        // Shadow casters are still culled through the registry
+        if (m_settings.shadows) MarkCullCandidates(objects);
     }
 
     // Update statistics
@@ -549,7 +567,7 @@ void GraphicsEngine::RenderScene(const DirectX::XMMATRIX& viewMatrix, const Dire
 // RENDERING PIPELINE IMPLEMENTATIONS
 // ============================================================================
 
-void GraphicsEngine::RenderForward(const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix, const std::vector<GameObject*>& objects)
+void GraphicsEngine::RenderForward(const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix, const FrameVector<GameObject*>& objects)
 {
     // ✅ ENHANCED: Update per-frame constants at the start of rendering
     if (m_basicFrameConstantBuffer) {
@@ -561,60 +579,37 @@ void GraphicsEngine::RenderForward(const XMMATRIX& viewMatrix, const XMMATRIX& p
         UpdateFrameConstants(viewMatrix, projMatrix, cameraPos);
     }
 
-    uint32_t drawCalls = 0;
-    uint32_t triangles = 0;
-    uint32_t vertices = 0;
-    
-    for (auto* obj : objects) {
-        if (obj && obj->IsActive() && obj->IsVisible()) {
-            try {
-                obj->Render(viewMatrix, projMatrix);
-                drawCalls++;
-                triangles += 12;
-                vertices += 36;
-            } catch (...) {
-                static int errorCount = 0;
-                if (++errorCount <= 5) {
-                    LOG_TO_CONSOLE_IMMEDIATE(L"Warning: Object rendering error", L"WARNING");
-                }
-            }
-        }
-    }
+    // Opaque groups front to back, then blended objects back to front
+    QueueDraws(objects, viewMatrix, projMatrix, RenderPass::Opaque);
+    uint32_t materialSwitches = 0;
+    uint32_t drawCalls = SubmitDraws(objects, viewMatrix, projMatrix, RenderPass::Opaque, materialSwitches);
+    drawCalls += SubmitDraws(objects, viewMatrix, projMatrix, RenderPass::Transparent, materialSwitches);
 
     // Update statistics
     {
         std::lock_guard<std::mutex> lock(m_metricsMutex);
         m_statistics.drawCalls = drawCalls;
-        m_statistics.triangles = triangles;
-        m_statistics.vertices = vertices;
+        m_statistics.triangles = drawCalls * 12;
+        m_statistics.vertices = drawCalls * 36;
+        m_statistics.materialSwitches = materialSwitches;
     }
 }
 
-void GraphicsEngine::RenderDeferred(const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix, const std::vector<GameObject*>& objects)
+void GraphicsEngine::RenderDeferred(const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix, const FrameVector<GameObject*>& objects)
 {
     LOG_TO_CONSOLE_IMMEDIATE(L"Starting deferred rendering pass", L"INFO");
     
     // Phase 1: Fill G-Buffer
+    QueueDraws(objects, viewMatrix, projMatrix, RenderPass::GBuffer);
     FillGBuffer(objects, viewMatrix, projMatrix);
     
     // Phase 2: Lighting pass
     LightingPass(viewMatrix, projMatrix);
     
-    // Phase 3: Forward rendering for transparent objects
-    uint32_t transparentDrawCalls = 0;
-    for (auto* obj : objects) {
-        if (obj && obj->IsActive() && obj->IsVisible()) {
-            try {
-                obj->Render(viewMatrix, projMatrix);
-                transparentDrawCalls++;
-            } catch (...) {
-                static int errorCount = 0;
-                if (++errorCount <= 3) {
-                    LOG_TO_CONSOLE_IMMEDIATE(L"Warning: Transparent object rendering error in deferred pass", L"WARNING");
-                }
-            }
-        }
-    }
+    // Phase 3: Forward rendering for transparent objects, back to front
+    uint32_t materialSwitches = 0;
+    const uint32_t transparentDrawCalls =
+        SubmitDraws(objects, viewMatrix, projMatrix, RenderPass::Transparent, materialSwitches);
     
     // Update statistics
     {
@@ -622,55 +617,39 @@ void GraphicsEngine::RenderDeferred(const XMMATRIX& viewMatrix, const XMMATRIX&
         m_statistics.drawCalls += transparentDrawCalls;
         m_statistics.triangles += transparentDrawCalls * 12;
         m_statistics.vertices += transparentDrawCalls * 36;
+        m_statistics.materialSwitches += materialSwitches;
     }
     
     LOG_TO_CONSOLE_IMMEDIATE(L"Deferred rendering pass complete", L"INFO");
 }
 
-void GraphicsEngine::RenderForwardPlus(const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix, const std::vector<GameObject*>& objects)
+void GraphicsEngine::RenderForwardPlus(const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix, const FrameVector<GameObject*>& objects)
 {
     LOG_TO_CONSOLE_IMMEDIATE(L"Starting Forward+ rendering pass", L"INFO");
     
-    // Phase 1: Depth pre-pass
-    uint32_t depthDrawCalls = 0;
-    for (auto* obj : objects) {
-        if (obj && obj->IsActive() && obj->IsVisible()) {
-            depthDrawCalls++;
-        }
-    }
+    // Phase 1: Depth pre-pass over the opaque packets
+    QueueDraws(objects, viewMatrix, projMatrix, RenderPass::Opaque);
+    const uint32_t depthDrawCalls = static_cast<uint32_t>(
+        m_renderQueue.FindPass(RenderPass::Transparent) - m_renderQueue.FindPass(RenderPass::Opaque));
     
-    // Phase 2: Light culling
+    // Phase 2: Light culling: bin lights into clusters, then upload the lists with the rest of the lighting data
     if (m_lightingSystem) {
+        m_lightingSystem->CullLights(viewMatrix, projMatrix);
         m_lightingSystem->BindLightingData(m_context.Get());
     }
     
     // Phase 3: Shading pass
-    uint32_t shadingDrawCalls = 0;
-    uint32_t triangles = 0;
-    uint32_t vertices = 0;
-    
-    for (auto* obj : objects) {
-        if (obj && obj->IsActive() && obj->IsVisible()) {
-            try {
-                obj->Render(viewMatrix, projMatrix);
-                shadingDrawCalls++;
-                triangles += 12;
-                vertices += 36;
-            } catch (...) {
-                static int errorCount = 0;
-                if (++errorCount <= 3) {
-                    LOG_TO_CONSOLE_IMMEDIATE(L"Warning: Forward+ shading pass rendering error", L"WARNING");
-                }
-            }
-        }
-    }
+    uint32_t materialSwitches = 0;
+    uint32_t shadingDrawCalls = SubmitDraws(objects, viewMatrix, projMatrix, RenderPass::Opaque, materialSwitches);
+    shadingDrawCalls += SubmitDraws(objects, viewMatrix, projMatrix, RenderPass::Transparent, materialSwitches);
     
     // Update statistics
     {
         std::lock_guard<std::mutex> lock(m_metricsMutex);
         m_statistics.drawCalls = depthDrawCalls + shadingDrawCalls;
-        m_statistics.triangles = triangles;
-        m_statistics.vertices = vertices;
+        m_statistics.triangles = shadingDrawCalls * 12;
+        m_statistics.vertices = shadingDrawCalls * 36;
+        m_statistics.materialSwitches = materialSwitches;
     }
     
     LOG_TO_CONSOLE_IMMEDIATE(L"Forward+ rendering pass complete", L"INFO");
@@ -680,40 +659,25 @@ void GraphicsEngine::RenderForwardPlus(const XMMATRIX& viewMatrix, const XMMATRI
 // ADVANCED RENDERING METHODS
 // ============================================================================
 
-void GraphicsEngine::FillGBuffer(const std::vector<GameObject*>& objects, const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix)
+void GraphicsEngine::FillGBuffer(const FrameVector<GameObject*>& objects, const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix)
 {
     LOG_TO_CONSOLE_IMMEDIATE(L"Filling G-Buffer for deferred rendering", L"INFO");
     
-    uint32_t gBufferDrawCalls = 0;
-    uint32_t totalTriangles = 0;
-    uint32_t totalVertices = 0;
-    
     if (m_context && m_solidRasterState) {
         m_context->RSSetState(m_solidRasterState.Get());
     }
     
-    for (auto* obj : objects) {
-        if (obj && obj->IsActive() && obj->IsVisible()) {
-            try {
-                obj->Render(viewMatrix, projMatrix);
-                gBufferDrawCalls++;
-                totalTriangles += 12;
-                totalVertices += 36;
-            } catch (...) {
-                static int errorCount = 0;
-                if (++errorCount <= 3) {
-                    LOG_TO_CONSOLE_IMMEDIATE(L"Warning: G-Buffer object rendering error", L"WARNING");
-                }
-            }
-        }
-    }
+    // RenderDeferred() queued the opaque objects in the G-buffer pass
+    uint32_t materialSwitches = 0;
+    const uint32_t gBufferDrawCalls = SubmitDraws(objects, viewMatrix, projMatrix, RenderPass::GBuffer, materialSwitches);
     
     // Update statistics
     {
         std::lock_guard<std::mutex> lock(m_metricsMutex);
         m_statistics.drawCalls += gBufferDrawCalls;
-        m_statistics.triangles += totalTriangles;
-        m_statistics.vertices += totalVertices;
+        m_statistics.triangles += gBufferDrawCalls * 12;
+        m_statistics.vertices += gBufferDrawCalls * 36;
+        m_statistics.materialSwitches += materialSwitches;
     }
     
     LOG_TO_CONSOLE_IMMEDIATE(L"G-Buffer fill complete with " + std::to_wstring(gBufferDrawCalls) + L" draw calls", L"INFO");
@@ -724,6 +688,7 @@ void GraphicsEngine::LightingPass(const XMMATRIX& viewMatrix, const XMMATRIX& pr
     LOG_TO_CONSOLE_IMMEDIATE(L"Starting deferred lighting pass", L"INFO");
     
     auto lightingStartTime = std::chrono::high_resolution_clock::now();
+    ShadowCasterAdapter shadowCasters(*this);
     
     if (m_context && m_renderTargetView) {
         m_context->OMSetRenderTargets(1, m_renderTargetView.GetAddressOf(), nullptr);
@@ -731,20 +696,22 @@ void GraphicsEngine::LightingPass(const XMMATRIX& viewMatrix, const XMMATRIX& pr
     
     if (m_lightingSystem) {
         try {
+            // Update lighting system with current frame parameters; this also bins the lights into clusters
+            m_lightingSystem->Update(0.016f, viewMatrix, projMatrix);
+
+            // Cull shadow casters per cascade first: it settles the cascade depth ranges the shaders get
+            if (m_settings.shadows) {
+                m_lightingSystem->CullShadowCasters(CullingSystem::GetInstance());
+            }
+            
             // Bind lighting data to shaders
             m_lightingSystem->BindLightingData(m_context.Get());
             
-            // Update lighting system with current frame parameters
-            m_lightingSystem->Update(0.016f, viewMatrix, projMatrix);
-            
-            // Render shadow maps if shadows are enabled
+            // Render shadow maps if shadows are enabled; each cascade only draws the casters that can shadow
+            // its receivers, and maps whose light and casters did not change are kept from last frame
             if (m_settings.shadows) {
                 try {
-                    m_lightingSystem->RenderShadowMaps([this](const XMMATRIX& lightView, const XMMATRIX& lightProj) {
-                        LOG_TO_CONSOLE_IMMEDIATE(L"Rendering shadow map for light", L"INFO");
-                        // Here we would render shadow casters from the light's perspective
-                        // The callback provides the light's view and projection matrices
-                    });
+                    m_lightingSystem->RenderShadowMaps(shadowCasters);
                 } catch (const std::exception& e) {
                     LOG_TO_CONSOLE_IMMEDIATE(L"Warning: Shadow map rendering failed: " + 
                         std::wstring(e.what(), e.what() + strlen(e.what())), L"WARNING");
@@ -763,7 +730,8 @@ void GraphicsEngine::LightingPass(const XMMATRIX& viewMatrix, const XMMATRIX& pr
         LOG_TO_CONSOLE_IMMEDIATE(L"Warning: LightingSystem not available for lighting pass", L"WARNING");
     }
     
-    uint32_t lightingDrawCalls = 1;
+    const uint32_t shadowCasterDraws = shadowCasters.GetDrawCount();
+    uint32_t lightingDrawCalls = 1 + shadowCasterDraws;
     
     auto lightingEndTime = std::chrono::high_resolution_clock::now();
     auto lightingTime = std::chrono::duration_cast<std::chrono::microseconds>(lightingEndTime - lightingStartTime);
@@ -772,6 +740,7 @@ void GraphicsEngine::LightingPass(const XMMATRIX& viewMatrix, const XMMATRIX& pr
     {
         std::lock_guard<std::mutex> lock(m_metricsMutex);
         m_statistics.drawCalls += lightingDrawCalls;
+        m_statistics.shadowCasterDraws = shadowCasterDraws;
         
         if (m_lightingSystem) {
             try {
@@ -804,109 +773,192 @@ void GraphicsEngine::LightingPass(const XMMATRIX& viewMatrix, const XMMATRIX& pr
         std::to_wstring(lightingTime.count() / 1000.0f) + L"ms", L"INFO");
 }
 
-void GraphicsEngine::CullObjects(const std::vector<GameObject*>& objects, const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix, std::vector<GameObject*>& visibleObjects)
+void GraphicsEngine::QueueDraws(const FrameVector<GameObject*>& objects, const XMMATRIX& viewMatrix,
+    const XMMATRIX& projMatrix, RenderPass opaquePass)
+{
+    // Depth range from the D3D perspective matrix: _33 = f/(f-n), _43 = -n*f/(f-n)
+    XMFLOAT4X4 proj;
+    XMStoreFloat4x4(&proj, projMatrix);
+    float nearPlane = 0.1f, farPlane = 1000.0f;
+    if (proj._34 != 0.0f && proj._33 != 0.0f && proj._33 != 1.0f) {
+        nearPlane = -proj._43 / proj._33;
+        farPlane = proj._43 / (1.0f - proj._33);
+    }
+
+    // Pixels per world unit at distance 1: half the viewport height times the y scale
+    const float pixelScale = 0.5f * static_cast<float>(m_windowHeight) * m_settings.renderScale * proj._22;
+    const CullingSystem& culling = CullingSystem::GetInstance();
+    uint32_t lodReducedObjects = 0;
+    uint32_t lodTrianglesSaved = 0;
+
+    m_renderQueue.Clear();
+    m_renderQueue.Reserve(objects.size());
+    for (uint32_t i = 0; i < static_cast<uint32_t>(objects.size()); ++i) {
+        GameObject* obj = objects[i];
+        if (!obj || !obj->IsActive() || !obj->IsVisible()) continue;
+
+        const Material* material = obj->GetMaterial();
+        const bool blended = material && material->GetRenderState().blendMode != BlendMode::Opaque &&
+                             material->GetRenderState().blendMode != BlendMode::AlphaTest;
+        const Mesh* mesh = obj->GetMesh();
+        const XMFLOAT3 position = obj->GetRenderPosition();
+        const float viewDepth = XMVectorGetZ(XMVector3TransformCoord(XMLoadFloat3(&position), viewMatrix));
+
+        // Level of detail from the bounding sphere's projected radius; the
+        // camera inside the sphere (or an unbounded object) draws the full mesh
+        uint32_t lod = 0;
+        if (m_settings.levelOfDetail && mesh && mesh->GetLodCount() > 1) {
+            const CullingSystem::Handle handle = obj->UpdateCullingBounds();
+            const XMVECTOR center = XMVectorSet(culling.GetSphereX()[handle], culling.GetSphereY()[handle],
+                                                culling.GetSphereZ()[handle], 1.0f);
+            const float radius = culling.GetSphereRadius()[handle];
+            const float distance = XMVectorGetX(XMVector3Length(XMVector3TransformCoord(center, viewMatrix)));
+            if (distance > radius) {
+                lod = MeshSimplifier::SelectLod(mesh->GetLods(), mesh->GetLodCount(), radius * pixelScale / distance,
+                                                obj->GetLod(), m_settings.lodPixelError);
+            }
+            if (lod > 0) {
+                ++lodReducedObjects;
+                lodTrianglesSaved += (mesh->GetIndexCount() - mesh->GetLod(lod).indexCount) / 3;
+            }
+        }
+        obj->SetLod(lod);
+        obj->FlushWorldMatrix();
+
+        m_renderQueue.Push(RenderKey::Make(blended ? RenderPass::Transparent : opaquePass, obj->GetShaderVariant(),
+                                           material ? material->GetSortId() + 1 : 0, mesh ? mesh->GetSortId() : 0,
+                                           viewDepth, nearPlane, farPlane), i);
+    }
+    m_renderQueue.Sort();
+
+    {
+        std::lock_guard<std::mutex> lock(m_metricsMutex);
+        m_statistics.lodReducedObjects = lodReducedObjects;
+        m_statistics.lodTrianglesSaved = lodTrianglesSaved;
+    }
+}
+
+uint32_t GraphicsEngine::SubmitDraws(const FrameVector<GameObject*>& objects, const XMMATRIX& viewMatrix,
+    const XMMATRIX& projMatrix, RenderPass pass, uint32_t& materialSwitches)
+{
+    const std::vector<DrawPacket>& packets = m_renderQueue.GetPackets();
+    const size_t begin = m_renderQueue.FindPass(pass);
+    const size_t end = m_renderQueue.FindPass(static_cast<RenderPass>(static_cast<int>(pass) + 1), begin);
+    if (begin == end || !m_backend) {
+        return 0;
+    }
+
+    const uint32_t count = static_cast<uint32_t>(end - begin);
+    const uint32_t bufferCount = (count + DrawsPerCommandBuffer - 1) / DrawsPerCommandBuffer;
+    if (m_commandBuffers.size() < bufferCount) {
+        m_commandBuffers.resize(bufferCount);
+    }
+
+    // QueueDraws flushed every queued transform, so recording only reads the
+    // objects and chunks can be recorded on any worker.
+    // Binds are tracked by pointer, not key fields: sort IDs wrap at their field width.
+    JobSystem::GetInstance().ParallelFor(bufferCount, 1, [&](uint32_t chunkBegin, uint32_t chunkEnd) {
+        for (uint32_t chunk = chunkBegin; chunk < chunkEnd; ++chunk) {
+            CommandBuffer& buffer = m_commandBuffers[chunk];
+            buffer.Begin(viewMatrix, projMatrix);
+
+            const size_t first = begin + size_t(chunk) * DrawsPerCommandBuffer;
+            const size_t last = std::min(end, first + DrawsPerCommandBuffer);
+            for (size_t i = first; i < last; ++i) {
+                GameObject* obj = objects[packets[i].payload];
+                if (obj->GetShaderVariant() == RenderShader::Custom) {
+                    buffer.DrawObject(obj);
+                } else {
+                    buffer.BindBasicShaders();
+                    buffer.BindMaterial(obj->GetMaterial());
+                    obj->Record(buffer);
+                }
+            }
+        }
+    });
+
+    m_submitBuffers.clear();
+    uint32_t drawCalls = 0;
+    for (uint32_t chunk = 0; chunk < bufferCount; ++chunk) {
+        m_submitBuffers.push_back(&m_commandBuffers[chunk]);
+        drawCalls += m_commandBuffers[chunk].GetDrawCount();
+    }
+
+    if (m_backend->GetType() == RenderBackendType::D3D11) {
+        static_cast<D3D11RenderBackend*>(m_backend.get())->SetUseDeferredContexts(m_settings.deferredContexts);
+    }
+    const uint64_t materialBindsBefore = m_backend->GetStats().materialBinds;
+    try {
+        m_backend->Execute(m_submitBuffers.data(), m_submitBuffers.size());
+    } catch (...) {
+        static int errorCount = 0;
+        if (++errorCount <= 5) {
+            LOG_TO_CONSOLE_IMMEDIATE(L"Warning: Command buffer replay error", L"WARNING");
+        }
+    }
+    materialSwitches += static_cast<uint32_t>(m_backend->GetStats().materialBinds - materialBindsBefore);
+    return drawCalls;
+}
+
+void GraphicsEngine::ExecuteCommands(const CommandBuffer& buffer)
+{
+    if (m_backend) {
+        m_backend->Execute(buffer);
+    }
+}
+
+bool GraphicsEngine::SetRenderBackend(RenderBackendType type)
+{
+    m_backendType = type;
+    if (type == RenderBackendType::Null) {
+        m_backend = std::make_unique<NullRenderBackend>();
+        LOG_TO_CONSOLE_IMMEDIATE(L"Render backend: null (draws are counted, not issued)", L"INFO");
+        return true;
+    }
+
+    if (!m_device || !m_context) {
+        // Initialize() creates it once the device exists
+        return false;
+    }
+    auto backend = std::make_unique<D3D11RenderBackend>(*this, m_device.Get(), m_context.Get());
+    backend->SetUseDeferredContexts(m_settings.deferredContexts);
+    m_backend = std::move(backend);
+    LOG_TO_CONSOLE_IMMEDIATE(L"Render backend: d3d11", L"INFO");
+    return true;
+}
+
+void GraphicsEngine::CullObjects(const FrameVector<GameObject*>& objects, const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix, FrameVector<GameObject*>& visibleObjects)
 {
     auto cullingStartTime = std::chrono::high_resolution_clock::now();
     
     visibleObjects.clear();
     visibleObjects.reserve(objects.size());
     
-    // Extract frustum planes from view-projection matrix
-    XMMATRIX viewProjMatrix = XMMatrixMultiply(viewMatrix, projMatrix);
-    
-    XMVECTOR frustumPlanes[6];
-    
-    // Left plane
-    frustumPlanes[0] = XMVectorSet(
-        XMVectorGetX(viewProjMatrix.r[3]) + XMVectorGetX(viewProjMatrix.r[0]),
-        XMVectorGetY(viewProjMatrix.r[3]) + XMVectorGetY(viewProjMatrix.r[0]),
-        XMVectorGetZ(viewProjMatrix.r[3]) + XMVectorGetZ(viewProjMatrix.r[0]),
-        XMVectorGetW(viewProjMatrix.r[3]) + XMVectorGetW(viewProjMatrix.r[0])
-    );
-    
-    // Right plane
-    frustumPlanes[1] = XMVectorSet(
-        XMVectorGetX(viewProjMatrix.r[3]) - XMVectorGetX(viewProjMatrix.r[0]),
-        XMVectorGetY(viewProjMatrix.r[3]) - XMVectorGetY(viewProjMatrix.r[0]),
-        XMVectorGetZ(viewProjMatrix.r[3]) - XMVectorGetZ(viewProjMatrix.r[0]),
-        XMVectorGetW(viewProjMatrix.r[3]) - XMVectorGetW(viewProjMatrix.r[0])
-    );
-    
-    // Top plane
-    frustumPlanes[2] = XMVectorSet(
-        XMVectorGetX(viewProjMatrix.r[3]) - XMVectorGetX(viewProjMatrix.r[1]),
-        XMVectorGetY(viewProjMatrix.r[3]) - XMVectorGetY(viewProjMatrix.r[1]),
-        XMVectorGetZ(viewProjMatrix.r[3]) - XMVectorGetZ(viewProjMatrix.r[1]),
-        XMVectorGetW(viewProjMatrix.r[3]) - XMVectorGetW(viewProjMatrix.r[1])
-    );
-    
-    // Bottom plane
-    frustumPlanes[3] = XMVectorSet(
-        XMVectorGetX(viewProjMatrix.r[3]) + XMVectorGetX(viewProjMatrix.r[1]),
-        XMVectorGetY(viewProjMatrix.r[3]) + XMVectorGetY(viewProjMatrix.r[1]),
-        XMVectorGetZ(viewProjMatrix.r[3]) + XMVectorGetZ(viewProjMatrix.r[1]),
-        XMVectorGetW(viewProjMatrix.r[3]) + XMVectorGetW(viewProjMatrix.r[1])
-    );
-    
-    // Near plane
-    frustumPlanes[4] = XMVectorSet(
-        XMVectorGetX(viewProjMatrix.r[3]) + XMVectorGetX(viewProjMatrix.r[2]),
-        XMVectorGetY(viewProjMatrix.r[3]) + XMVectorGetY(viewProjMatrix.r[2]),
-        XMVectorGetZ(viewProjMatrix.r[3]) + XMVectorGetZ(viewProjMatrix.r[2]),
-        XMVectorGetW(viewProjMatrix.r[3]) + XMVectorGetW(viewProjMatrix.r[2])
-    );
-    
-    // Far plane
-    frustumPlanes[5] = XMVectorSet(
-        XMVectorGetX(viewProjMatrix.r[3]) - XMVectorGetX(viewProjMatrix.r[2]),
-        XMVectorGetY(viewProjMatrix.r[3]) - XMVectorGetY(viewProjMatrix.r[2]),
-        XMVectorGetZ(viewProjMatrix.r[3]) - XMVectorGetZ(viewProjMatrix.r[2]),
-        XMVectorGetW(viewProjMatrix.r[3]) - XMVectorGetW(viewProjMatrix.r[2])
-    );
-    
-    // Normalize frustum planes
-    for (int i = 0; i < 6; i++) {
-        frustumPlanes[i] = XMPlaneNormalize(frustumPlanes[i]);
-    }
-    
-    uint32_t totalObjects = 0;
+    const Frustum frustum = Frustum::FromViewProjection(XMMatrixMultiply(viewMatrix, projMatrix));
+    CullingSystem& culling = CullingSystem::GetInstance();
+
+    uint32_t totalObjects = MarkCullCandidates(objects);
     uint32_t culledObjects = 0;
     uint32_t visibleObjectCount = 0;
-    
-    // Test each object against frustum
-    for (auto* obj : objects) {
-        if (!obj) continue;
-        
-        totalObjects++;
-        
-        if (!obj->IsActive() || !obj->IsVisible()) {
-            culledObjects++;
-            continue;
-        }
-        
-        XMFLOAT3 objPos = obj->GetPosition();
-        XMVECTOR objectPosition = XMLoadFloat3(&objPos);
-        float boundingRadius = 5.0f;
-        
-        bool isVisible = true;
-        
-        // Test against all frustum planes
-        for (int i = 0; i < 6; i++) {
-            float distance = XMVectorGetX(XMPlaneDotCoord(frustumPlanes[i], objectPosition));
-            
-            if (distance < -boundingRadius) {
-                isVisible = false;
-                break;
-            }
-        }
-        
-        if (isVisible) {
-            visibleObjects.push_back(obj);
-            visibleObjectCount++;
-        } else {
-            culledObjects++;
-        }
+
+    // SIMD sphere and box test over the whole registry; visible objects come
+    // out in handle order
+    culling.Cull(frustum, m_cullVisible);
+    for (CullingSystem::Handle handle : m_cullVisible) {
+        if (handle >= m_cullCandidateFrame.size() || m_cullCandidateFrame[handle] != m_cullFrame) continue;
+        visibleObjects.push_back(static_cast<GameObject*>(culling.GetUserData(handle)));
     }
+
+    uint32_t occludedObjects = 0;
+    float occlusionTime = 0.0f;
+    if (m_settings.occlusionCulling && !visibleObjects.empty()) {
+        const auto occlusionStartTime = std::chrono::high_resolution_clock::now();
+        occludedObjects = CullOccluded(visibleObjects, viewMatrix, projMatrix);
+        occlusionTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - occlusionStartTime).count();
+    }
+
+    visibleObjectCount = static_cast<uint32_t>(visibleObjects.size());
+    culledObjects = totalObjects - visibleObjectCount;
     
     auto cullingEndTime = std::chrono::high_resolution_clock::now();
     auto cullingTime = std::chrono::duration_cast<std::chrono::microseconds>(cullingEndTime - cullingStartTime);
@@ -918,6 +970,8 @@ void GraphicsEngine::CullObjects(const std::vector<GameObject*>& objects, const
         m_statistics.visibleObjects = visibleObjectCount;
         m_statistics.culledObjects = culledObjects;
         m_statistics.cullingTime = cullingTime.count() / 1000.0f;
+        m_statistics.occludedObjects = occludedObjects;
+        m_statistics.occlusionTime = occlusionTime;
     }
     
     if (cullingTime.count() > 1000) {
@@ -927,6 +981,142 @@ void GraphicsEngine::CullObjects(const std::vector<GameObject*>& objects, const
     }
 }
 
+uint32_t GraphicsEngine::MarkCullCandidates(const FrameVector<GameObject*>& objects)
+{
+    CullingSystem& culling = CullingSystem::GetInstance();
+    uint32_t totalObjects = 0;
+
+    // Refresh the bounds of objects that moved and flag this frame's
+    // candidates: the registry also holds objects not submitted this frame
+    if (++m_cullFrame == 0) {
+        std::fill(m_cullCandidateFrame.begin(), m_cullCandidateFrame.end(), 0u);
+        m_cullFrame = 1;
+    }
+    for (GameObject* obj : objects) {
+        if (!obj) continue;
+
+        totalObjects++;
+        if (!obj->IsActive() || !obj->IsVisible()) continue;
+
+        const CullingSystem::Handle handle = obj->UpdateCullingBounds();
+        if (handle >= m_cullCandidateFrame.size()) m_cullCandidateFrame.resize(culling.GetCapacity(), 0u);
+        m_cullCandidateFrame[handle] = m_cullFrame;
+    }
+    return totalObjects;
+}
+
+template <typename Visit>
+void GraphicsEngine::ForEachShadowCaster(const std::vector<uint32_t>* casters, Visit&& visit)
+{
+    const CullingSystem& culling = CullingSystem::GetInstance();
+    auto candidate = [&](CullingSystem::Handle handle) {
+        if (handle >= m_cullCandidateFrame.size() || m_cullCandidateFrame[handle] != m_cullFrame || !culling.IsValid(handle)) return;
+        GameObject* obj = static_cast<GameObject*>(culling.GetUserData(handle));
+        if (obj->IsVisible() && obj->GetMesh()) visit(handle, obj);
+    };
+    if (casters) {
+        for (CullingSystem::Handle handle : *casters) candidate(handle);
+    } else {
+        for (CullingSystem::Handle handle = 0; handle < m_cullCandidateFrame.size(); ++handle) candidate(handle);
+    }
+}
+
+void GraphicsEngine::ShadowCasterAdapter::HashCasters(const std::vector<uint32_t>* casters, uint64_t& staticHash, uint64_t& dynamicHash)
+{
+    // Everything Record() draws with: the mesh, its index count, level of detail and the world matrix
+    ShadowHash staticCasters, dynamicCasters;
+    m_engine.ForEachShadowCaster(casters, [&](uint32_t handle, GameObject* obj) {
+        ShadowHash& hash = obj->IsStatic() ? staticCasters : dynamicCasters;
+        hash.Add(handle);
+        hash.AddPointer(obj->GetMesh());
+        hash.Add(obj->GetMesh()->GetIndexCount());
+        hash.Add(obj->GetLod());
+        obj->FlushWorldMatrix();
+        hash.AddMatrix(obj->GetRenderWorldMatrix());
+    });
+    staticHash = staticCasters.Get();
+    dynamicHash = dynamicCasters.Get();
+}
+
+uint32_t GraphicsEngine::ShadowCasterAdapter::DrawCasters(FXMMATRIX view, CXMMATRIX projection,
+                                                          const std::vector<uint32_t>* casters, ShadowCasterLayer layer)
+{
+    const uint32_t draws = m_engine.RenderShadowCasters(view, projection, casters, layer);
+    m_drawCount += draws;
+    return draws;
+}
+
+uint32_t GraphicsEngine::RenderShadowCasters(const XMMATRIX& lightView, const XMMATRIX& lightProj,
+    const std::vector<uint32_t>* casters, ShadowCasterLayer layer)
+{
+    if (!m_backend) {
+        return 0;
+    }
+
+    // Depth only: the shadow map is bound without colour targets, so no material is needed
+    const bool staticLayer = layer == ShadowCasterLayer::Static;
+    m_shadowCommands.Begin(lightView, lightProj);
+    m_shadowCommands.BindBasicShaders();
+    ForEachShadowCaster(casters, [&](uint32_t, GameObject* obj) {
+        if (obj->IsStatic() != staticLayer) return;
+        obj->FlushWorldMatrix();
+        obj->Record(m_shadowCommands);
+    });
+
+    try {
+        m_backend->Execute(m_shadowCommands);
+    } catch (...) {
+        static int errorCount = 0;
+        if (++errorCount <= 5) {
+            LOG_TO_CONSOLE_IMMEDIATE(L"Warning: Shadow caster replay error", L"WARNING");
+        }
+    }
+    return m_shadowCommands.GetDrawCount();
+}
+
+uint32_t GraphicsEngine::CullOccluded(FrameVector<GameObject*>& visibleObjects, const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix)
+{
+    CullingSystem& culling = CullingSystem::GetInstance();
+    m_occlusionCuller.Begin(XMMatrixMultiply(viewMatrix, projMatrix));
+
+    // Nearest occluders first: they hide the most for their triangles
+    XMFLOAT3 eye;
+    XMStoreFloat3(&eye, XMMatrixInverse(nullptr, viewMatrix).r[3]);
+    m_occluders.clear();
+    for (GameObject* obj : visibleObjects) {
+        if (!obj->IsOccluder() || !obj->GetMesh() || obj->GetMesh()->GetIndices().empty()) continue;
+
+        XMFLOAT3 minimum, maximum;
+        culling.GetWorldBox(obj->UpdateCullingBounds(), minimum, maximum);
+        const float dx = std::max({ minimum.x - eye.x, 0.0f, eye.x - maximum.x });
+        const float dy = std::max({ minimum.y - eye.y, 0.0f, eye.y - maximum.y });
+        const float dz = std::max({ minimum.z - eye.z, 0.0f, eye.z - maximum.z });
+        m_occluders.emplace_back(dx * dx + dy * dy + dz * dz, obj);
+    }
+    std::sort(m_occluders.begin(), m_occluders.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    uint32_t triangles = 0;
+    for (const auto& occluder : m_occluders) {
+        const Mesh* mesh = occluder.second->GetMesh();
+        const uint32_t meshTriangles = static_cast<uint32_t>(mesh->GetIndices().size() / 3);
+        if (triangles > 0 && triangles + meshTriangles > OccluderTriangleBudget) break;
+
+        m_occlusionCuller.RasterizeMesh(&mesh->GetVertices()[0].Position.x, sizeof(Vertex), mesh->GetVertices().size(),
+            mesh->GetIndices().data(), mesh->GetIndices().size(), occluder.second->GetWorldMatrix());
+        triangles += meshTriangles;
+    }
+    if (triangles == 0) return 0;
+
+    const size_t before = visibleObjects.size();
+    visibleObjects.erase(std::remove_if(visibleObjects.begin(), visibleObjects.end(), [&](GameObject* obj) {
+        XMFLOAT3 minimum, maximum;
+        culling.GetWorldBox(obj->UpdateCullingBounds(), minimum, maximum);
+        return !m_occlusionCuller.IsVisible(minimum, maximum);
+    }), visibleObjects.end());
+    return static_cast<uint32_t>(before - visibleObjects.size());
+}
+
 // ============================================================================
 // DEVICE CREATION METHODS
 // ============================================================================
@@ -1533,49 +1723,59 @@ HRESULT GraphicsEngine::CreateBasicConstantBuffer()
 
 void GraphicsEngine::SetBasicShaders()
 {
-    if (!m_context) {
+    SetBasicShaders(m_context.Get());
+}
+
+void GraphicsEngine::SetBasicShaders(ID3D11DeviceContext* context)
+{
+    if (!context) {
         return;
     }
     
     // Set shaders
-    m_context->VSSetShader(m_basicVertexShader.Get(), nullptr, 0);
-    m_context->PSSetShader(m_basicPixelShader.Get(), nullptr, 0);
+    context->VSSetShader(m_basicVertexShader.Get(), nullptr, 0);
+    context->PSSetShader(m_basicPixelShader.Get(), nullptr, 0);
     
     // Set input layout
-    m_context->IASetInputLayout(m_basicInputLayout.Get());
+    context->IASetInputLayout(m_basicInputLayout.Get());
     
     // Set constant buffers (per-object at slot 0, per-frame at slot 1)
-    m_context->VSSetConstantBuffers(0, 1, m_basicConstantBuffer.GetAddressOf());
-    m_context->VSSetConstantBuffers(1, 1, m_basicFrameConstantBuffer.GetAddressOf());
-    m_context->PSSetConstantBuffers(0, 1, m_basicConstantBuffer.GetAddressOf());
-    m_context->PSSetConstantBuffers(1, 1, m_basicFrameConstantBuffer.GetAddressOf());
+    context->VSSetConstantBuffers(0, 1, m_basicConstantBuffer.GetAddressOf());
+    context->VSSetConstantBuffers(1, 1, m_basicFrameConstantBuffer.GetAddressOf());
+    context->PSSetConstantBuffers(0, 1, m_basicConstantBuffer.GetAddressOf());
+    context->PSSetConstantBuffers(1, 1, m_basicFrameConstantBuffer.GetAddressOf());
     
     // Set sampler state and default texture
-    m_context->PSSetSamplers(0, 1, m_basicSamplerState.GetAddressOf());
+    context->PSSetSamplers(0, 1, m_basicSamplerState.GetAddressOf());
     if (m_defaultSRV) {
-        m_context->PSSetShaderResources(0, 1, m_defaultSRV.GetAddressOf());
+        context->PSSetShaderResources(0, 1, m_defaultSRV.GetAddressOf());
     }
 }
 
 void GraphicsEngine::UpdateBasicConstants(const XMMATRIX& world, const XMMATRIX& view, const XMMATRIX& proj)
 {
-    if (!m_basicConstantBuffer || !m_context) {
+    UploadObjectConstants(m_context.Get(), ObjectConstants::FromMatrices(world, view, proj));
+}
+
+void GraphicsEngine::UploadObjectConstants(ID3D11DeviceContext* context, const ObjectConstants& objectConstants)
+{
+    if (!m_basicConstantBuffer || !context) {
         return;
     }
     
     PerObjectConstants constants = {};
-    constants.WorldMatrix = XMMatrixTranspose(world);
-    constants.WorldViewProjectionMatrix = XMMatrixTranspose(world * view * proj);
-    constants.WorldInverseTransposeMatrix = XMMatrixTranspose(XMMatrixInverse(nullptr, world));
+    constants.WorldMatrix = XMLoadFloat4x4(&objectConstants.world);
+    constants.WorldViewProjectionMatrix = XMLoadFloat4x4(&objectConstants.worldViewProjection);
+    constants.WorldInverseTransposeMatrix = XMLoadFloat4x4(&objectConstants.worldInverseTranspose);
     constants.ObjectColor = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
     constants.MaterialProperties = XMFLOAT4(0.0f, 0.5f, 0.0f, 1.0f); // Default material
     constants.UVTiling = XMFLOAT4(1.0f, 1.0f, 0.0f, 0.0f); // Default UV tiling
     
     D3D11_MAPPED_SUBRESOURCE mappedResource;
-    HRESULT hr = m_context->Map(m_basicConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
+    HRESULT hr = context->Map(m_basicConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
     if (SUCCEEDED(hr)) {
         memcpy(mappedResource.pData, &constants, sizeof(PerObjectConstants));
-        m_context->Unmap(m_basicConstantBuffer.Get(), 0);
+        context->Unmap(m_basicConstantBuffer.Get(), 0);
     }
 }
 
@@ -1954,6 +2154,12 @@ void GraphicsEngine::Console_EnableFeature(const std::string& feature, bool enab
         m_hdrEnabled = enabled;
     } else if (feature == "frustum_culling") {
         m_settings.frustumCulling = enabled;
+    } else if (feature == "deferred_contexts") {
+        m_settings.deferredContexts = enabled;
+    } else if (feature == "occlusion_culling") {
+        m_settings.occlusionCulling = enabled;
+    } else if (feature == "level_of_detail") {
+        m_settings.levelOfDetail = enabled;
     }
     
     std::wstring featureName(feature.begin(), feature.end());
@@ -1975,6 +2181,8 @@ void GraphicsEngine::Console_SetSetting(const std::string& setting, float value)
         m_settings.msaaSamples = static_cast<uint32_t>(value);
     } else if (setting == "render_scale") {
         m_settings.renderScale = value;
+    } else if (setting == "lod_pixel_error") {
+        m_settings.lodPixelError = value;
     }
     
     std::wstring settingName(setting.begin(), setting.end());
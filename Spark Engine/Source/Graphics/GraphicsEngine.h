@@ -13,6 +13,12 @@
 #pragma once
 
 #include "../Utils/Assert.h"
+#include "../Utils/FrameArena.h"
+#include "RenderQueue.h"
+#include "CommandBuffer.h"
+#include "RenderBackend.h"
+#include "OcclusionCuller.h"
+#include "ShadowCache.h"
 #include <windows.h>
 #include <wrl/client.h>
 #include <d3d11_1.h>
@@ -173,7 +179,9 @@ struct GraphicsSettings
     bool frustumCulling = true;
     bool occlusionCulling = false;
     bool levelOfDetail = true;
+    float lodPixelError = 1.0f;         ///< Largest simplification error allowed on screen, in pixels
     uint32_t maxDrawCalls = 1000;
+    bool deferredContexts = false;      ///< Replay recorded draws through D3D11 deferred contexts
     
     // Legacy compatibility
     bool wireframeMode = false;
@@ -207,6 +215,10 @@ struct RenderStatistics
     uint32_t visibleObjects;       ///< Objects after culling
     uint32_t culledObjects;        ///< Objects culled
     float cullingTime;             ///< Culling time (ms)
+    uint32_t occludedObjects;      ///< Objects hidden by occluders (after frustum culling)
+    float occlusionTime;           ///< Occluder rasterisation and testing time (ms)
+    uint32_t lodReducedObjects;    ///< Queued objects drawn below their full mesh
+    uint32_t lodTrianglesSaved;    ///< Triangles those objects skipped
     
     // Memory
     size_t textureMemory;          ///< Texture memory usage (bytes)
@@ -216,6 +228,7 @@ struct RenderStatistics
     // Lighting
     uint32_t activeLights;         ///< Active lights
     uint32_t shadowUpdates;        ///< Shadow map updates
+    uint32_t shadowCasterDraws;    ///< Caster draws into shadow maps, summed over cascades
     float lightCullingTime;        ///< Light culling time (ms)
     
     // Post-processing
@@ -296,7 +309,7 @@ public:
      * @param objects List of objects to render
      */
     void RenderScene(const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix,
-                    const std::vector<GameObject*>& objects);
+                    const FrameVector<GameObject*>& objects);
 
     /**
      * @brief Handle window resize events with advanced buffer management
@@ -600,6 +613,43 @@ public:
      */
     void UpdateFrameConstants(const XMMATRIX& view, const XMMATRIX& proj, const XMFLOAT3& cameraPos);
 
+    /**
+     * @brief Bind the basic shaders, samplers and constant buffers on a given context
+     *
+     * Used by command buffer replay, which may target a deferred context.
+     */
+    void SetBasicShaders(ID3D11DeviceContext* context);
+
+    /**
+     * @brief Upload recorded per-object constants into the basic constant buffer
+     */
+    void UploadObjectConstants(ID3D11DeviceContext* context, const ObjectConstants& constants);
+
+    // ========================================================================
+    // COMMAND SUBMISSION
+    // ========================================================================
+
+    /**
+     * @brief Replay a recorded command buffer through the active backend
+     */
+    void ExecuteCommands(const CommandBuffer& buffer);
+
+    /**
+     * @brief Choose where recorded commands go
+     *
+     * The null backend counts draws and issues nothing, for profiling the CPU
+     * side of a frame. May be called before Initialize(); D3D11 then takes
+     * effect once the device exists.
+     * @return False if D3D11 was requested without a device
+     */
+    bool SetRenderBackend(RenderBackendType type);
+    RenderBackend* GetRenderBackend() const { return m_backend.get(); }
+
+    /**
+     * @brief Software occlusion buffer of the last culled frame
+     */
+    const OcclusionCuller& GetOcclusionCuller() const { return m_occlusionCuller; }
+
 private:
     // ========================================================================
     // ADVANCED RENDERING SUBSYSTEMS
@@ -705,6 +755,46 @@ private:
     // **CRITICAL FIX: Added atomic frame state for thread-safe frame management**
     std::atomic<bool> m_frameInProgress;
 
+    // Frustum culling scratch, indexed by CullingSystem handle
+    std::vector<uint32_t> m_cullCandidateFrame;    ///< m_cullFrame of the last frame the object was submitted
+    std::vector<uint32_t> m_cullVisible;           ///< Handles passing the frustum test
+    uint32_t m_cullFrame = 0;
+
+    // Software occlusion; occluders are rasterised nearest first up to the budget
+    static constexpr uint32_t OccluderTriangleBudget = 16384;
+    OcclusionCuller m_occlusionCuller;
+    std::vector<std::pair<float, GameObject*>> m_occluders;
+
+    // Draw submission; packet payloads index the object list being rendered
+    RenderQueue m_renderQueue;
+
+    // Command recording; one buffer per chunk of DrawsPerCommandBuffer packets
+    static constexpr uint32_t DrawsPerCommandBuffer = 512;
+    std::vector<CommandBuffer> m_commandBuffers;
+    std::vector<const CommandBuffer*> m_submitBuffers;
+    CommandBuffer m_shadowCommands;                 ///< Caster draws of one shadow map
+
+    /**
+     * @brief This frame's cull candidates as shadow casters, split by GameObject::IsStatic()
+     */
+    class ShadowCasterAdapter : public ShadowCasterSource
+    {
+    public:
+        explicit ShadowCasterAdapter(GraphicsEngine& engine) : m_engine(engine) {}
+
+        void HashCasters(const std::vector<uint32_t>* casters, uint64_t& staticHash, uint64_t& dynamicHash) override;
+        uint32_t DrawCasters(DirectX::FXMMATRIX view, DirectX::CXMMATRIX projection,
+                             const std::vector<uint32_t>* casters, ShadowCasterLayer layer) override;
+
+        uint32_t GetDrawCount() const { return m_drawCount; }
+
+    private:
+        GraphicsEngine& m_engine;
+        uint32_t m_drawCount = 0;
+    };
+    std::unique_ptr<RenderBackend> m_backend;
+    RenderBackendType m_backendType = RenderBackendType::D3D11;
+
     // Resource tracking
     size_t m_textureMemoryUsage;
     size_t m_bufferMemoryUsage;
@@ -742,17 +832,61 @@ private:
     
     // Advanced rendering methods
     void RenderForward(const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix,
-                      const std::vector<GameObject*>& objects);
+                      const FrameVector<GameObject*>& objects);
     void RenderDeferred(const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix,
-                       const std::vector<GameObject*>& objects);
+                       const FrameVector<GameObject*>& objects);
     void RenderForwardPlus(const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix,
-                          const std::vector<GameObject*>& objects);
-    void FillGBuffer(const std::vector<GameObject*>& objects,
+                          const FrameVector<GameObject*>& objects);
+    void FillGBuffer(const FrameVector<GameObject*>& objects,
                     const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix);
     void LightingPass(const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix);
-    void CullObjects(const std::vector<GameObject*>& objects,
+
+    /**
+     * @brief Fill m_renderQueue with one packet per drawable object and sort it
+     *
+     * Also picks each object's mesh LOD from its projected size when levelOfDetail is on.
+     * @param opaquePass Pass for objects without a blended material; blended ones go to RenderPass::Transparent
+     */
+    void QueueDraws(const FrameVector<GameObject*>& objects, const XMMATRIX& viewMatrix,
+                    const XMMATRIX& projMatrix, RenderPass opaquePass);
+
+    /**
+     * @brief Record the sorted packets of one pass into command buffers and replay them through the backend
+     *
+     * Large passes are split into chunks recorded in parallel on the job
+     * system. Shaders and materials are bound only when they change within a chunk.
+     * @param materialSwitches Incremented per material bind
+     * @return Draw calls issued
+     */
+    uint32_t SubmitDraws(const FrameVector<GameObject*>& objects, const XMMATRIX& viewMatrix,
+                         const XMMATRIX& projMatrix, RenderPass pass, uint32_t& materialSwitches);
+
+    void CullObjects(const FrameVector<GameObject*>& objects,
                     const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix,
-                    std::vector<GameObject*>& visibleObjects);
+                    FrameVector<GameObject*>& visibleObjects);
+
+    /**
+     * @brief Refresh the culling bounds of this frame's active objects and flag them as candidates
+     * @return Non-null objects in the list
+     */
+    uint32_t MarkCullCandidates(const FrameVector<GameObject*>& objects);
+
+    /**
+     * @brief Call for each shadow caster of a list that Record() would draw
+     * @param casters CullingSystem handles, or null for every candidate of the frame
+     */
+    template <typename Visit>
+    void ForEachShadowCaster(const std::vector<uint32_t>* casters, Visit&& visit);
+
+    /**
+     * @brief Record and replay depth draws of one layer of shadow casters for one shadow map
+     * @param casters CullingSystem handles to draw, or null for every candidate of the frame
+     * @return Draw calls issued
+     */
+    uint32_t RenderShadowCasters(const XMMATRIX& lightView, const XMMATRIX& lightProj,
+                                 const std::vector<uint32_t>* casters, ShadowCasterLayer layer);
+    uint32_t CullOccluded(FrameVector<GameObject*>& visibleObjects,
+                          const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix);
     void RenderGeometryPass();
     void RenderLightingPass();
     void RenderPostProcessing();
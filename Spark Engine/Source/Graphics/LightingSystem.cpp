@@ -4,13 +4,29 @@
  */
 
 #include "LightingSystem.h"
+#include "CullingSystem.h"
 #include "Utils/Assert.h"
 #include "../Utils/SparkConsole.h"
 #include <sstream>
 #include <algorithm>
 #include <chrono>
+#include <bit>
 #include <cmath>
 #include <DirectXColors.h>
+#include <d3dcompiler.h>
+
+namespace
+{
+    /**
+     * @brief Layout of the shadow data constant buffer: cascade view-projections, then the far split of each cascade
+     */
+    struct CascadeConstants
+    {
+        XMMATRIX viewProjection[ShadowCascades::MaxCascades];
+        XMFLOAT4 splitFar;
+        XMFLOAT4 params;                // x: cascade count, 0 without a cascaded light
+    };
+}
 
 // ============================================================================
 // LIGHT CLASS IMPLEMENTATION
@@ -182,10 +198,28 @@ void LightingSystem::Shutdown()
     // Clear shadow maps
     m_shadowMaps.clear();
     m_csmShadowMap.reset();
+    m_cascadeLight = nullptr;
+    m_shadowCache.Clear();
+    ConfigureShadowAtlas();
+    m_shadowAtlasMap = ShadowMap{};
+    m_atlasFaces.clear();
+    m_atlasLightFaces.clear();
+    m_atlasFaceBuffer.Reset();
+    m_atlasFaceSRV.Reset();
+    m_atlasFaceCapacity = 0;
+    m_tileClearVS.Reset();
+    m_tileClearDepthState.Reset();
+    m_tileClearRasterState.Reset();
     
     // Reset DirectX resources
     m_lightBuffer.Reset();
     m_lightBufferSRV.Reset();
+    m_clusterRangeBuffer.Reset();
+    m_clusterRangeSRV.Reset();
+    m_clusterIndexBuffer.Reset();
+    m_clusterIndexSRV.Reset();
+    m_clusterConstantBuffer.Reset();
+    m_lightBufferCapacity = m_clusterRangeCapacity = m_clusterIndexCapacity = 0;
     m_lightDataBuffer.Reset();
     m_environmentBuffer.Reset();
     m_shadowDataBuffer.Reset();
@@ -208,6 +242,14 @@ void LightingSystem::Update(float deltaTime, const XMMATRIX& viewMatrix, const X
     m_metrics.activeLights = static_cast<uint32_t>(m_lights.size());
     m_metrics.shadowCastingLights = 0;
     m_metrics.visibleLights = 0;
+
+    // Assign atlas tiles first: the light data says where each light's shadow is
+    if (m_shadowsEnabled) {
+        UpdateShadowAtlas(viewMatrix, projMatrix);
+    } else {
+        m_atlasFaces.clear();
+        m_atlasLightFaces.clear();
+    }
     
     // Count shadow casting lights and update light data
     m_lightDataArray.clear();
@@ -216,19 +258,25 @@ void LightingSystem::Update(float deltaTime, const XMMATRIX& viewMatrix, const X
     for (const auto& light : m_lights) {
         if (light && light->IsEnabled()) {
             m_lightDataArray.push_back(light->GetShaderData());
+            ApplyShadowAtlas(*light, m_lightDataArray.back());
             m_metrics.visibleLights++;
             
             if (light->GetCastShadows()) {
                 m_metrics.shadowCastingLights++;
             }
             
-            // Mark light as clean after processing
+            // Mark light as clean after processing; its shadow maps are redrawn even if
+            // the change (a bias, say) does not show in the light matrices
+            if (light->IsDirty()) {
+                m_shadowCache.Invalidate(light.get());
+            }
             light->SetClean();
         }
     }
     
     // Update light buffer
     UpdateLightBuffer();
+    CullLights(viewMatrix, projMatrix);
     
     // Update shadow maps if shadows are enabled
     if (m_shadowsEnabled) {
@@ -255,6 +303,13 @@ void LightingSystem::SetGlobalShadowQuality(uint32_t size)
             CreateShadowMap(size, *pair.second);
         }
     }
+    if (m_csmShadowMap) {
+        for (auto& cascade : m_csmShadowMap->cascades) {
+            CreateShadowMap(size, cascade);
+        }
+    }
+    ConfigureShadowAtlas();
+    m_shadowCache.Clear();
     
     Spark::SimpleConsole::GetInstance().LogInfo("Shadow map quality set to " + std::to_string(size) + "x" + std::to_string(size));
 }
@@ -308,43 +363,159 @@ void LightingSystem::BindLightingData(ID3D11DeviceContext* context)
         }
         
         // Bind constant buffers
+        if (m_shadowDataBuffer) {
+            CascadeConstants cascades = {};
+            const uint32_t cascadeCount = m_cascadeLight ? m_shadowCascades.GetCascadeCount() : 0;
+            float splitFar[ShadowCascades::MaxCascades] = {};
+            for (uint32_t i = 0; i < cascadeCount; ++i) {
+                cascades.viewProjection[i] = XMLoadFloat4x4(&m_shadowCascades.GetCascade(i).viewProjection);
+                splitFar[i] = m_shadowCascades.GetCascade(i).splitFar;
+            }
+            cascades.splitFar = XMFLOAT4(splitFar[0], splitFar[1], splitFar[2], splitFar[3]);
+            cascades.params = XMFLOAT4(static_cast<float>(cascadeCount), 0.0f, 0.0f, 0.0f);
+
+            D3D11_MAPPED_SUBRESOURCE mapped;
+            if (SUCCEEDED(context->Map(m_shadowDataBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
+                memcpy(mapped.pData, &cascades, sizeof(cascades));
+                context->Unmap(m_shadowDataBuffer.Get(), 0);
+            }
+        }
+        
         ID3D11Buffer* buffers[] = { m_lightDataBuffer.Get(), m_environmentBuffer.Get(), m_shadowDataBuffer.Get() };
         context->VSSetConstantBuffers(1, 3, buffers);
         context->PSSetConstantBuffers(1, 3, buffers);
+
+        BindLightClusters(context);
+        BindShadowAtlas(context);
         
         Spark::SimpleConsole::GetInstance().LogInfo("Lighting data bound to shaders");
     }
 }
 
-void LightingSystem::RenderShadowMaps(std::function<void(const XMMATRIX&, const XMMATRIX&)> renderCallback)
+void LightingSystem::RenderShadowMaps(ShadowCasterSource& casters)
 {
-    if (!renderCallback || !m_shadowsEnabled) return;
+    if (!m_shadowsEnabled) return;
     
     m_metrics.shadowMapUpdates = 0;
-    
+    m_shadowCache.BeginFrame();
+
+    // Keep the caller's targets and viewport to put back afterwards
+    ComPtr<ID3D11RenderTargetView> savedTargets[D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT];
+    ComPtr<ID3D11DepthStencilView> savedDepth;
+    D3D11_VIEWPORT savedViewports[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
+    UINT savedViewportCount = D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
+    if (m_context) {
+        ID3D11RenderTargetView* targets[D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT] = {};
+        m_context->OMGetRenderTargets(D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT, targets, savedDepth.GetAddressOf());
+        for (UINT i = 0; i < D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT; ++i) {
+            savedTargets[i].Attach(targets[i]);
+        }
+        m_context->RSGetViewports(&savedViewportCount, savedViewports);
+
+        // The atlas is read by last frame's shading; it cannot be a depth target while bound
+        ID3D11ShaderResourceView* nullView = nullptr;
+        m_context->PSSetShaderResources(ShadowAtlasResourceSlot + 1, 1, &nullView);
+    }
+
     for (const auto& light : m_lights) {
         if (light && light->IsEnabled() && light->GetCastShadows()) {
             try {
-                XMMATRIX lightView = light->GetLightMatrix();
-                XMMATRIX lightProj = light->GetShadowMatrix();
-                
-                // Set up shadow map render target if it exists
-                auto it = m_shadowMaps.find(light.get());
-                if (it != m_shadowMaps.end() && it->second) {
-                    m_context->OMSetRenderTargets(0, nullptr, it->second->dsv.Get());
-                    m_context->ClearDepthStencilView(it->second->dsv.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
+                // The cascaded light draws each cascade with its own casters
+                if (light.get() == m_cascadeLight && m_csmShadowMap) {
+                    for (uint32_t i = 0; i < m_shadowCascades.GetCascadeCount(); ++i) {
+                        const ShadowCascade& cascade = m_shadowCascades.GetCascade(i);
+                        RenderShadowMap(&m_csmShadowMap->cascades[i], light.get(), i, XMLoadFloat4x4(&cascade.view),
+                                        XMLoadFloat4x4(&cascade.projection), &m_shadowCascades.GetCasters(i), casters);
+                    }
+                    continue;
                 }
-                
-                renderCallback(lightView, lightProj);
-                m_metrics.shadowMapUpdates++;
+                if (light->GetType() != LightType::Directional) {
+                    RenderShadowAtlasFaces(*light, casters);
+                    continue;
+                }
+
+                auto it = m_shadowMaps.find(light.get());
+                RenderShadowMap(it != m_shadowMaps.end() ? it->second.get() : nullptr, light.get(), ShadowCascades::MaxCascades,
+                                light->GetLightMatrix(), light->GetShadowMatrix(), nullptr, casters);
                 
             } catch (...) {
-                Spark::SimpleConsole::GetInstance().LogWarning("Error in shadow map render callback for light");
+                // The map may be half drawn; make sure it is redrawn next frame
+                m_shadowCache.Invalidate(light.get());
+                Spark::SimpleConsole::GetInstance().LogWarning("Error rendering shadow map for light");
             }
         }
     }
+    m_metrics.shadowMapsSkipped = static_cast<uint32_t>(m_shadowCache.GetFrameCounters().skipped);
+    m_metrics.shadowMapsComposited = static_cast<uint32_t>(m_shadowCache.GetFrameCounters().composited);
+
+    if (m_context) {
+        ID3D11RenderTargetView* targets[D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT];
+        for (UINT i = 0; i < D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT; ++i) {
+            targets[i] = savedTargets[i].Get();
+        }
+        m_context->OMSetRenderTargets(D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT, targets, savedDepth.Get());
+        if (savedViewportCount > 0) {
+            m_context->RSSetViewports(savedViewportCount, savedViewports);
+        }
+
+        // Only now that the atlas is no longer a depth target can shaders read it
+        if (m_shadowAtlasMap.srv) {
+            m_context->PSSetShaderResources(ShadowAtlasResourceSlot + 1, 1, m_shadowAtlasMap.srv.GetAddressOf());
+        }
+    }
     
-    Spark::SimpleConsole::GetInstance().LogInfo("Shadow maps rendered: " + std::to_string(m_metrics.shadowMapUpdates) + " updates");
+    Spark::SimpleConsole::GetInstance().LogInfo("Shadow maps rendered: " + std::to_string(m_metrics.shadowMapUpdates) + " updates, " +
+                                                std::to_string(m_metrics.shadowMapsSkipped) + " cached");
+}
+
+void LightingSystem::RenderShadowMap(ShadowMap* shadowMap, const Light* owner, uint32_t index, FXMMATRIX lightView,
+                                     CXMMATRIX lightProj, const std::vector<uint32_t>* casterList, ShadowCasterSource& casters)
+{
+    // Without a map of its own there is nothing to keep between frames
+    if (!shadowMap || !shadowMap->dsv || !m_context) {
+        casters.DrawCasters(lightView, lightProj, casterList, ShadowCasterLayer::Static);
+        casters.DrawCasters(lightView, lightProj, casterList, ShadowCasterLayer::Dynamic);
+        m_metrics.shadowMapUpdates++;
+        return;
+    }
+
+    // The texture is hashed too, so a recreated map is always redrawn
+    ShadowHash lightHash;
+    lightHash.AddMatrix(lightView);
+    lightHash.AddMatrix(lightProj);
+    lightHash.Add(shadowMap->size);
+    lightHash.AddPointer(shadowMap->texture.Get());
+    ShadowMapInputs inputs;
+    inputs.lightHash = lightHash.Get();
+    casters.HashCasters(casterList, inputs.staticHash, inputs.dynamicHash);
+
+    ShadowMapPlan plan = m_shadowCache.Plan(ShadowCache::MakeKey(owner, index), owner, inputs);
+    if (plan.IsSkipped()) return;
+    if ((plan.saveStatic || plan.restoreStatic) && FAILED(EnsureStaticLayer(*shadowMap))) {
+        // No layer to copy to or from: draw everything, and forget the map so the cache does not rely on it
+        m_shadowCache.Invalidate(owner);
+        plan = ShadowMapPlan{};
+        plan.drawStatic = true;
+        plan.drawDynamic = inputs.dynamicHash != 0;
+    }
+
+    if (plan.restoreStatic) {
+        m_context->CopyResource(shadowMap->texture.Get(), shadowMap->staticTexture.Get());
+    }
+    const D3D11_VIEWPORT viewport = { 0.0f, 0.0f, static_cast<float>(shadowMap->size), static_cast<float>(shadowMap->size), 0.0f, 1.0f };
+    m_context->OMSetRenderTargets(0, nullptr, shadowMap->dsv.Get());
+    m_context->RSSetViewports(1, &viewport);
+    if (plan.drawStatic) {
+        m_context->ClearDepthStencilView(shadowMap->dsv.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
+        casters.DrawCasters(lightView, lightProj, casterList, ShadowCasterLayer::Static);
+    }
+    if (plan.saveStatic) {
+        m_context->CopyResource(shadowMap->staticTexture.Get(), shadowMap->texture.Get());
+    }
+    if (plan.drawDynamic) {
+        casters.DrawCasters(lightView, lightProj, casterList, ShadowCasterLayer::Dynamic);
+    }
+    m_metrics.shadowMapUpdates++;
 }
 
 LightingSystem::LightingMetrics LightingSystem::Console_GetMetrics() const
@@ -361,8 +532,8 @@ std::shared_ptr<Light> LightingSystem::CreateLight(LightType type)
     auto light = std::make_shared<Light>(type);
     m_lights.push_back(light);
     
-    // Create shadow map for this light if shadows are enabled
-    if (light->GetCastShadows() && m_shadowsEnabled) {
+    // Directional lights get a shadow map of their own; the others share the shadow atlas
+    if (type == LightType::Directional && light->GetCastShadows() && m_shadowsEnabled) {
         auto shadowMap = std::make_unique<ShadowMap>();
         if (SUCCEEDED(CreateShadowMap(m_shadowMapSize, *shadowMap))) {
             m_shadowMaps[light.get()] = std::move(shadowMap);
@@ -378,8 +549,8 @@ void LightingSystem::AddLight(std::shared_ptr<Light> light)
     if (light) {
         m_lights.push_back(light);
         
-        // Create shadow map if needed
-        if (light->GetCastShadows() && m_shadowsEnabled) {
+        // Create shadow map if needed; lights other than directional ones use the shadow atlas
+        if (light->GetType() == LightType::Directional && light->GetCastShadows() && m_shadowsEnabled) {
             auto shadowMap = std::make_unique<ShadowMap>();
             if (SUCCEEDED(CreateShadowMap(m_shadowMapSize, *shadowMap))) {
                 m_shadowMaps[light.get()] = std::move(shadowMap);
@@ -397,6 +568,12 @@ void LightingSystem::RemoveLight(std::shared_ptr<Light> light)
             m_shadowMaps.erase(it);
         }
         
+        if (light.get() == m_cascadeLight) {
+            m_cascadeLight = nullptr;
+        }
+        m_shadowCache.Invalidate(light.get());
+        m_shadowAtlas.Release(light.get());
+        
         // Remove from lights vector
         m_lights.erase(std::remove(m_lights.begin(), m_lights.end(), light), m_lights.end());
     }
@@ -405,6 +582,9 @@ void LightingSystem::RemoveLight(std::shared_ptr<Light> light)
 void LightingSystem::RemoveAllLights()
 {
     m_shadowMaps.clear();
+    m_cascadeLight = nullptr;
+    m_shadowCache.Clear();
+    ConfigureShadowAtlas();
     m_lights.clear();
     
     // Recreate default directional light
@@ -566,6 +746,22 @@ void LightingSystem::Console_ReloadIBL()
     Spark::SimpleConsole::GetInstance().LogSuccess("IBL textures reloaded");
 }
 
+std::string LightingSystem::Console_GetClusterStats() const
+{
+    std::stringstream ss;
+    ss << m_lightGrid.Console_GetStats();
+    ss << "Light culling:    " << (m_lightCullingEnabled ? "enabled" : "disabled") << "\n";
+    return ss.str();
+}
+
+std::string LightingSystem::Console_GetCascadeStats() const
+{
+    if (!m_cascadeLight) {
+        return "No enabled directional light casts cascaded shadows\n";
+    }
+    return m_shadowCascades.Console_GetStats();
+}
+
 // ============================================================================
 // PRIVATE HELPER METHODS
 // ============================================================================
@@ -593,6 +789,11 @@ HRESULT LightingSystem::CreateConstantBuffers()
     bufferDesc.ByteWidth = sizeof(XMMATRIX) * 16; // Up to 16 shadow matrices
     hr = m_device->CreateBuffer(&bufferDesc, nullptr, &m_shadowDataBuffer);
     if (FAILED(hr)) return hr;
+
+    // Create light cluster constants
+    bufferDesc.ByteWidth = sizeof(ClusterShaderConstants);
+    hr = m_device->CreateBuffer(&bufferDesc, nullptr, &m_clusterConstantBuffer);
+    if (FAILED(hr)) return hr;
     
     return S_OK;
 }
@@ -602,6 +803,7 @@ HRESULT LightingSystem::CreateShadowMap(uint32_t size, ShadowMap& shadowMap)
     if (!m_device) return E_FAIL;
     
     shadowMap.size = size;
+    shadowMap.staticTexture.Reset();
     
     // Create shadow map texture
     D3D11_TEXTURE2D_DESC texDesc = {};
@@ -637,6 +839,18 @@ HRESULT LightingSystem::CreateShadowMap(uint32_t size, ShadowMap& shadowMap)
     return S_OK;
 }
 
+HRESULT LightingSystem::EnsureStaticLayer(ShadowMap& shadowMap)
+{
+    if (shadowMap.staticTexture) return S_OK;
+    if (!m_device || !shadowMap.texture) return E_FAIL;
+
+    // Same format and size as the map, so CopyResource works both ways; never bound
+    D3D11_TEXTURE2D_DESC texDesc;
+    shadowMap.texture->GetDesc(&texDesc);
+    texDesc.BindFlags = 0;
+    return m_device->CreateTexture2D(&texDesc, nullptr, &shadowMap.staticTexture);
+}
+
 HRESULT LightingSystem::CreateCascadedShadowMap()
 {
     if (!m_device) return E_FAIL;
@@ -662,9 +876,21 @@ void LightingSystem::UpdateLightBuffer()
     auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastUpdate);
     
     if (elapsed.count() >= 100) { // Update every 100ms
-        m_metrics.lightCullingTime = elapsed.count() / 1000.0f;
         m_metrics.shadowRenderTime = m_metrics.shadowMapUpdates * 0.5f; // Estimate
-        m_metrics.shadowMapMemory = m_shadowMaps.size() * (m_shadowMapSize * m_shadowMapSize * 4) / (1024.0f * 1024.0f);
+        // Cached static layers take as much as the maps they belong to
+        size_t textures = m_shadowMaps.size();
+        for (const auto& pair : m_shadowMaps) {
+            if (pair.second && pair.second->staticTexture) textures++;
+        }
+        if (m_csmShadowMap) {
+            for (const ShadowMap& cascade : m_csmShadowMap->cascades) {
+                textures += cascade.staticTexture ? 2 : 1;
+            }
+        }
+        m_metrics.shadowMapMemory = textures * (m_shadowMapSize * m_shadowMapSize * 4) / (1024.0f * 1024.0f);
+        if (m_shadowAtlasMap.texture) {
+            m_metrics.shadowMapMemory += static_cast<float>(ShadowAtlasSize) * ShadowAtlasSize * 4 / (1024.0f * 1024.0f);
+        }
         lastUpdate = now;
     }
 }
@@ -672,8 +898,14 @@ void LightingSystem::UpdateLightBuffer()
 void LightingSystem::UpdateShadowMaps(const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix)
 {
     // Update shadow map matrices and culling
+    m_cascadeLight = nullptr;
     for (const auto& light : m_lights) {
         if (light && light->IsEnabled() && light->GetCastShadows()) {
+            // The first shadowed directional light gets the cascades
+            if (!m_cascadeLight && light->GetType() == LightType::Directional) {
+                m_cascadeLight = light.get();
+            }
+
             auto it = m_shadowMaps.find(light.get());
             if (it != m_shadowMaps.end() && it->second) {
                 it->second->lightMatrix = light->GetLightMatrix();
@@ -681,40 +913,367 @@ void LightingSystem::UpdateShadowMaps(const XMMATRIX& viewMatrix, const XMMATRIX
             }
         }
     }
+
+    if (!m_cascadeLight) return;
+    if (!m_csmShadowMap && FAILED(CreateCascadedShadowMap())) {
+        m_csmShadowMap.reset();
+        m_cascadeLight = nullptr;
+        return;
+    }
+
+    // Fit the cascades to the camera; CullShadowCasters() tightens their depth ranges
+    m_shadowCascades.Configure(m_csmShadowMap->cascadeCount, m_csmShadowMap->splitLambda, m_shadowMapSize);
+    m_shadowCascades.Update(viewMatrix, projMatrix, m_cascadeLight->GetDirection());
+    StoreCascadeMatrices();
+}
+
+void LightingSystem::CullShadowCasters(const CullingSystem& culling)
+{
+    if (!m_shadowsEnabled || !m_cascadeLight || !m_csmShadowMap) return;
+
+    m_shadowCascades.CullCasters(culling.GetSphereX(), culling.GetSphereY(), culling.GetSphereZ(),
+                                 culling.GetSphereRadius(), culling.GetCapacity());
+    StoreCascadeMatrices();
+}
+
+void LightingSystem::StoreCascadeMatrices()
+{
+    CascadedShadowMap& csm = *m_csmShadowMap;
+    const uint32_t count = m_shadowCascades.GetCascadeCount();
+    csm.splitDistances.assign(m_shadowCascades.GetSplits(), m_shadowCascades.GetSplits() + count + 1);
+    csm.lightMatrices.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const ShadowCascade& cascade = m_shadowCascades.GetCascade(i);
+        csm.lightMatrices[i] = XMLoadFloat4x4(&cascade.viewProjection);
+        csm.cascades[i].lightMatrix = XMLoadFloat4x4(&cascade.view);
+        csm.cascades[i].shadowMatrix = XMLoadFloat4x4(&cascade.projection);
+    }
+}
+
+void LightingSystem::ConfigureShadowAtlas()
+{
+    // The largest tile matches the per-light maps of the current quality; frees every tile
+    const uint32_t maxTile = std::clamp(std::bit_floor(std::max(m_shadowMapSize, 1u)), ShadowAtlasMinTile, ShadowAtlasSize / 4);
+    m_shadowAtlas.Configure(ShadowAtlasSize, ShadowAtlasMinTile, maxTile);
+}
+
+void LightingSystem::UpdateShadowAtlas(const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix)
+{
+    m_atlasFaces.clear();
+    m_atlasLightFaces.clear();
+
+    m_atlasRequests.clear();
+    for (const auto& light : m_lights) {
+        if (!light || !light->IsEnabled() || !light->GetCastShadows()) continue;
+        const LightType type = light->GetType();
+        if (type == LightType::Directional || type == LightType::Environment) continue;
+
+        ShadowAtlasRequest request;
+        request.owner = light.get();
+        request.position = light->GetPosition();
+        request.range = light->GetRange();
+        request.faceCount = type == LightType::Point ? 6 : 1;
+        m_atlasRequests.push_back(request);
+    }
+    if (m_atlasRequests.empty() && !m_shadowAtlasMap.texture) return;
+
+    // Without the atlas texture every local light goes unshadowed
+    if (!m_shadowAtlasMap.dsv && FAILED(CreateShadowMap(ShadowAtlasSize, m_shadowAtlasMap))) {
+        m_shadowAtlasMap = ShadowMap{};
+        return;
+    }
+
+    m_shadowAtlas.Update(m_atlasRequests.data(), m_atlasRequests.size(), viewMatrix, projMatrix);
+
+    for (const ShadowAtlasRequest& request : m_atlasRequests) {
+        const ShadowAtlasAllocation* allocation = m_shadowAtlas.Find(request.owner);
+        if (!allocation || allocation->tileSize == 0) continue;
+
+        // Tiles given out this frame may hold another light's depth from the same spot
+        const Light& light = *static_cast<const Light*>(request.owner);
+        if (allocation->placed) {
+            m_shadowCache.Invalidate(&light);
+        }
+
+        m_atlasLightFaces[&light] = { static_cast<uint32_t>(m_atlasFaces.size()), allocation->faceCount };
+        for (uint32_t face = 0; face < allocation->faceCount; ++face) {
+            XMMATRIX view, projection;
+            GetShadowAtlasFace(light, face, view, projection);
+            ShadowAtlasFace atlasFace;
+            atlasFace.viewProjection = XMMatrixMultiply(view, projection);
+            atlasFace.rect = m_shadowAtlas.GetTileRect(allocation->tiles[face]);
+            m_atlasFaces.push_back(atlasFace);
+        }
+    }
+}
+
+void LightingSystem::ApplyShadowAtlas(const Light& light, LightData& data) const
+{
+    const LightType type = light.GetType();
+    if (type == LightType::Directional || type == LightType::Environment) return;
+
+    // Lights without tiles (shadows off, off screen, or no room) are drawn unshadowed
+    auto it = m_atlasLightFaces.find(&light);
+    if (it == m_atlasLightFaces.end()) {
+        data.shadowParams.x = 0.0f;
+        data.shadowParams.z = -1.0f;
+        data.shadowParams.w = 0.0f;
+        return;
+    }
+    data.shadowParams.z = static_cast<float>(it->second.first);
+    data.shadowParams.w = static_cast<float>(it->second.second);
+}
+
+void LightingSystem::GetShadowAtlasFace(const Light& light, uint32_t face, XMMATRIX& view, XMMATRIX& projection) const
+{
+    // Point lights look down each cube axis with a 90 degree projection
+    view = light.GetType() == LightType::Point ? ShadowAtlas::GetFaceView(light.GetPosition(), face) : light.GetLightMatrix();
+    projection = light.GetShadowMatrix();
+}
+
+void LightingSystem::RenderShadowAtlasFaces(const Light& light, ShadowCasterSource& casters)
+{
+    // Dropped lights have no tiles and are unshadowed this frame
+    const ShadowAtlasAllocation* allocation = m_shadowAtlas.Find(&light);
+    if (!allocation || allocation->tileSize == 0 || !m_shadowAtlasMap.dsv || !m_context) return;
+    if (!m_tileClearVS && FAILED(CreateTileClear())) return;
+
+    // Tiles share one texture, so there is no static layer to copy back: a tile is redrawn in full when anything changed
+    uint64_t staticHash = 0, dynamicHash = 0;
+    casters.HashCasters(nullptr, staticHash, dynamicHash);
+    ShadowHash casterHash;
+    casterHash.Add(staticHash);
+    casterHash.Add(dynamicHash);
+
+    for (uint32_t face = 0; face < allocation->faceCount; ++face) {
+        XMMATRIX view, projection;
+        GetShadowAtlasFace(light, face, view, projection);
+        const ShadowAtlasTile& tile = allocation->tiles[face];
+
+        ShadowHash lightHash;
+        lightHash.AddMatrix(view);
+        lightHash.AddMatrix(projection);
+        lightHash.Add(tile.x);
+        lightHash.Add(tile.y);
+        lightHash.Add(tile.size);
+        lightHash.AddPointer(m_shadowAtlasMap.texture.Get());
+        ShadowMapInputs inputs;
+        inputs.lightHash = lightHash.Get();
+        inputs.staticHash = casterHash.Get();
+        if (m_shadowCache.Plan(ShadowCache::MakeKey(&light, face), &light, inputs).IsSkipped()) continue;
+
+        const D3D11_VIEWPORT viewport = { static_cast<float>(tile.x), static_cast<float>(tile.y),
+                                          static_cast<float>(tile.size), static_cast<float>(tile.size), 0.0f, 1.0f };
+        m_context->OMSetRenderTargets(0, nullptr, m_shadowAtlasMap.dsv.Get());
+        m_context->RSSetViewports(1, &viewport);
+        ClearShadowTile();
+        casters.DrawCasters(view, projection, nullptr, ShadowCasterLayer::Static);
+        casters.DrawCasters(view, projection, nullptr, ShadowCasterLayer::Dynamic);
+        m_metrics.shadowMapUpdates++;
+    }
+}
+
+void LightingSystem::BindShadowAtlas(ID3D11DeviceContext* context)
+{
+    if (!m_device || !m_shadowAtlasMap.srv) return;
+
+    if (FAILED(EnsureStructuredBuffer(m_atlasFaceBuffer, m_atlasFaceSRV, sizeof(ShadowAtlasFace),
+                                      static_cast<UINT>(std::max<size_t>(m_atlasFaces.size(), 1)), m_atlasFaceCapacity))) {
+        Spark::SimpleConsole::GetInstance().LogError("Failed to create shadow atlas face buffer");
+        return;
+    }
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (!m_atlasFaces.empty() && SUCCEEDED(context->Map(m_atlasFaceBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
+        memcpy(mapped.pData, m_atlasFaces.data(), m_atlasFaces.size() * sizeof(ShadowAtlasFace));
+        context->Unmap(m_atlasFaceBuffer.Get(), 0);
+    }
+
+    // The atlas depth itself is bound after RenderShadowMaps(), once it is no longer a depth target
+    context->PSSetShaderResources(ShadowAtlasResourceSlot, 1, m_atlasFaceSRV.GetAddressOf());
+}
+
+HRESULT LightingSystem::CreateTileClear()
+{
+    if (!m_device) return E_FAIL;
+
+    // A full-screen triangle at the far plane with no pixel shader: clears the depth inside the viewport only
+    const char* source = R"(
+        float4 main(uint id : SV_VertexID) : SV_Position
+        {
+            float2 uv = float2((id << 1) & 2, id & 2);
+            return float4(uv * float2(2.0, -2.0) + float2(-1.0, 1.0), 1.0, 1.0);
+        }
+    )";
+    ComPtr<ID3DBlob> blob;
+    ComPtr<ID3DBlob> errors;
+    HRESULT hr = D3DCompile(source, strlen(source), "ShadowTileClear", nullptr, nullptr, "main", "vs_5_0",
+                            D3DCOMPILE_ENABLE_STRICTNESS, 0, &blob, &errors);
+    if (FAILED(hr)) {
+        Spark::SimpleConsole::GetInstance().LogError("Shadow tile clear shader failed to compile" +
+            (errors ? ": " + std::string(static_cast<const char*>(errors->GetBufferPointer())) : std::string()));
+        return hr;
+    }
+    hr = m_device->CreateVertexShader(blob->GetBufferPointer(), blob->GetBufferSize(), nullptr, &m_tileClearVS);
+    if (FAILED(hr)) return hr;
+
+    D3D11_DEPTH_STENCIL_DESC depthDesc = {};
+    depthDesc.DepthEnable = TRUE;
+    depthDesc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
+    depthDesc.DepthFunc = D3D11_COMPARISON_ALWAYS;
+    hr = m_device->CreateDepthStencilState(&depthDesc, &m_tileClearDepthState);
+    if (FAILED(hr)) return hr;
+
+    D3D11_RASTERIZER_DESC rasterDesc = {};
+    rasterDesc.FillMode = D3D11_FILL_SOLID;
+    rasterDesc.CullMode = D3D11_CULL_NONE;
+    rasterDesc.DepthClipEnable = TRUE;
+    return m_device->CreateRasterizerState(&rasterDesc, &m_tileClearRasterState);
+}
+
+void LightingSystem::ClearShadowTile()
+{
+    // Keep the state the caster draws rely on
+    ComPtr<ID3D11VertexShader> savedVS;
+    ComPtr<ID3D11PixelShader> savedPS;
+    ComPtr<ID3D11InputLayout> savedLayout;
+    ComPtr<ID3D11DepthStencilState> savedDepthState;
+    ComPtr<ID3D11RasterizerState> savedRasterState;
+    D3D11_PRIMITIVE_TOPOLOGY savedTopology;
+    UINT stencilRef = 0;
+    m_context->VSGetShader(&savedVS, nullptr, nullptr);
+    m_context->PSGetShader(&savedPS, nullptr, nullptr);
+    m_context->IAGetInputLayout(&savedLayout);
+    m_context->IAGetPrimitiveTopology(&savedTopology);
+    m_context->OMGetDepthStencilState(&savedDepthState, &stencilRef);
+    m_context->RSGetState(&savedRasterState);
+
+    m_context->VSSetShader(m_tileClearVS.Get(), nullptr, 0);
+    m_context->PSSetShader(nullptr, nullptr, 0);
+    m_context->IASetInputLayout(nullptr);
+    m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    m_context->OMSetDepthStencilState(m_tileClearDepthState.Get(), 0);
+    m_context->RSSetState(m_tileClearRasterState.Get());
+    m_context->Draw(3, 0);
+
+    m_context->VSSetShader(savedVS.Get(), nullptr, 0);
+    m_context->PSSetShader(savedPS.Get(), nullptr, 0);
+    m_context->IASetInputLayout(savedLayout.Get());
+    m_context->IASetPrimitiveTopology(savedTopology);
+    m_context->OMSetDepthStencilState(savedDepthState.Get(), stencilRef);
+    m_context->RSSetState(savedRasterState.Get());
 }
 
 void LightingSystem::CullLights(const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix)
 {
-    // Simple frustum culling for lights
-    // This is a simplified implementation
-    uint32_t visibleCount = 0;
-    
+    if (!m_lightCullingEnabled) return;
+
+    // Directional and environment lights reach every pixel; the rest go into clusters
+    m_clusterLights.clear();
+    m_clusterLightData.clear();
+    uint32_t globalLights = 0;
     for (const auto& light : m_lights) {
-        if (light && light->IsEnabled()) {
-            // For now, consider all lights visible
-            // In a real implementation, this would test against view frustum
-            visibleCount++;
+        if (!light || !light->IsEnabled()) continue;
+
+        const LightType type = light->GetType();
+        if (type == LightType::Directional || type == LightType::Environment) {
+            globalLights++;
+            continue;
         }
+
+        ClusterLight bounds;
+        bounds.position = light->GetPosition();
+        bounds.range = light->GetRange();
+        bounds.direction = light->GetDirection();
+        bounds.spotAngle = type == LightType::Spot ? XMConvertToRadians(light->GetSpotAngle()) : 0.0f;
+        m_clusterLights.push_back(bounds);
+        m_clusterLightData.push_back(light->GetShaderData());
+        ApplyShadowAtlas(*light, m_clusterLightData.back());
     }
-    
-    m_metrics.visibleLights = visibleCount;
-    m_metrics.culledLights = m_metrics.activeLights - visibleCount;
+
+    m_lightGrid.Build(m_clusterLights.data(), m_clusterLights.size(), viewMatrix, projMatrix);
+
+    m_metrics.visibleLights = globalLights + m_lightGrid.GetAssignedLightCount();
+    m_metrics.culledLights = m_metrics.activeLights - m_metrics.visibleLights;
+    m_metrics.lightCullingTime = m_lightGrid.GetBuildTime();
+}
+
+void LightingSystem::BindLightClusters(ID3D11DeviceContext* context)
+{
+    if (!m_lightCullingEnabled || !m_device || !m_clusterConstantBuffer) return;
+
+    const std::vector<ClusterRange>& ranges = m_lightGrid.GetRanges();
+    const std::vector<uint32_t>& indices = m_lightGrid.GetLightIndices();
+
+    // Grown on demand and never shrunk; empty lists still get a valid one-element buffer
+    if (FAILED(EnsureStructuredBuffer(m_lightBuffer, m_lightBufferSRV, sizeof(LightData),
+                                      static_cast<UINT>(std::max<size_t>(m_clusterLightData.size(), 1)), m_lightBufferCapacity)) ||
+        FAILED(EnsureStructuredBuffer(m_clusterRangeBuffer, m_clusterRangeSRV, sizeof(ClusterRange),
+                                      static_cast<UINT>(std::max<size_t>(ranges.size(), 1)), m_clusterRangeCapacity)) ||
+        FAILED(EnsureStructuredBuffer(m_clusterIndexBuffer, m_clusterIndexSRV, sizeof(uint32_t),
+                                      static_cast<UINT>(std::max<size_t>(indices.size(), 1)), m_clusterIndexCapacity))) {
+        Spark::SimpleConsole::GetInstance().LogError("Failed to create light cluster buffers");
+        return;
+    }
+
+    auto upload = [context](ID3D11Buffer* buffer, const void* data, size_t bytes) {
+        if (bytes == 0) return;
+        D3D11_MAPPED_SUBRESOURCE mapped;
+        if (SUCCEEDED(context->Map(buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
+            memcpy(mapped.pData, data, bytes);
+            context->Unmap(buffer, 0);
+        }
+    };
+    upload(m_lightBuffer.Get(), m_clusterLightData.data(), m_clusterLightData.size() * sizeof(LightData));
+    upload(m_clusterRangeBuffer.Get(), ranges.data(), ranges.size() * sizeof(ClusterRange));
+    upload(m_clusterIndexBuffer.Get(), indices.data(), indices.size() * sizeof(uint32_t));
+    upload(m_clusterConstantBuffer.Get(), &m_lightGrid.GetShaderConstants(), sizeof(ClusterShaderConstants));
+
+    ID3D11ShaderResourceView* views[] = { m_lightBufferSRV.Get(), m_clusterRangeSRV.Get(), m_clusterIndexSRV.Get() };
+    context->PSSetShaderResources(ClusterResourceSlot, 3, views);
+    context->PSSetConstantBuffers(ClusterConstantSlot, 1, m_clusterConstantBuffer.GetAddressOf());
+}
+
+HRESULT LightingSystem::EnsureStructuredBuffer(ComPtr<ID3D11Buffer>& buffer, ComPtr<ID3D11ShaderResourceView>& view,
+                                               UINT stride, UINT count, UINT& capacity)
+{
+    if (buffer && count <= capacity) return S_OK;
+
+    const UINT newCapacity = std::max({ count, capacity * 2, 64u });
+    buffer.Reset();
+    view.Reset();
+    capacity = 0;
+
+    D3D11_BUFFER_DESC bufferDesc = {};
+    bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+    bufferDesc.ByteWidth = stride * newCapacity;
+    bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    bufferDesc.StructureByteStride = stride;
+
+    HRESULT hr = m_device->CreateBuffer(&bufferDesc, nullptr, &buffer);
+    if (FAILED(hr)) return hr;
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    srvDesc.Buffer.FirstElement = 0;
+    srvDesc.Buffer.NumElements = newCapacity;
+
+    hr = m_device->CreateShaderResourceView(buffer.Get(), &srvDesc, &view);
+    if (FAILED(hr)) {
+        buffer.Reset();
+        return hr;
+    }
+
+    capacity = newCapacity;
+    return S_OK;
 }
 
 void LightingSystem::CalculateCSMSplits(float nearPlane, float farPlane, CascadedShadowMap& csm)
 {
-    csm.splitDistances.clear();
     csm.splitDistances.resize(csm.cascadeCount + 1);
-    
-    for (uint32_t i = 0; i < csm.cascadeCount; ++i) {
-        float p = static_cast<float>(i + 1) / static_cast<float>(csm.cascadeCount);
-        float log = nearPlane * std::pow(farPlane / nearPlane, p);
-        float uniform = nearPlane + (farPlane - nearPlane) * p;
-        float d = csm.splitLambda * (log - uniform) + uniform;
-        csm.splitDistances[i + 1] = d;
-    }
-    
-    csm.splitDistances[0] = nearPlane;
+    ShadowCascades::ComputeSplits(nearPlane, farPlane, csm.cascadeCount, csm.splitLambda, csm.splitDistances.data());
 }
 
 XMMATRIX LightingSystem::CalculateLightMatrix(const Light& light, const XMMATRIX& viewMatrix, float nearPlane, float farPlane)
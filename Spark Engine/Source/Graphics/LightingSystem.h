@@ -12,6 +12,10 @@
 #pragma once
 
 #include "Utils/Assert.h"
+#include "ClusteredLightGrid.h"
+#include "ShadowCascades.h"
+#include "ShadowCache.h"
+#include "ShadowAtlas.h"
 #include <d3d11.h>
 #include <wrl/client.h>
 #include <DirectXMath.h>
@@ -24,6 +28,8 @@
 using Microsoft::WRL::ComPtr;
 using namespace DirectX;
 
+class CullingSystem;
+
 /**
  * @brief Light types supported by the system
  */
@@ -58,11 +64,20 @@ struct LightData
     XMFLOAT4 direction;          ///< Light direction (w = spot angle)
     XMFLOAT4 color;              ///< Light color (w = intensity)
     XMFLOAT4 attenuation;        ///< Attenuation factors (constant, linear, quadratic, range)
-    XMFLOAT4 shadowParams;       ///< Shadow parameters (enabled, bias, normal bias, split)
+    XMFLOAT4 shadowParams;       ///< Shadow parameters (enabled, bias, first shadow atlas face or -1, atlas face count)
     XMMATRIX lightMatrix;        ///< Light space transformation matrix
     XMMATRIX shadowMatrix;       ///< Shadow projection matrix
 };
 
+/**
+ * @brief One face of a light's shadow in the shadow atlas, for shaders
+ */
+struct ShadowAtlasFace
+{
+    XMMATRIX viewProjection;     ///< World to the face's clip space
+    XMFLOAT4 rect;               ///< Atlas UV offset (xy) and size (zw) of the face's tile
+};
+
 /**
  * @brief Light component
  */
@@ -207,6 +222,7 @@ struct ShadowMap
     ComPtr<ID3D11Texture2D> texture;                   ///< Shadow map texture
     ComPtr<ID3D11DepthStencilView> dsv;                ///< Depth stencil view
     ComPtr<ID3D11ShaderResourceView> srv;              ///< Shader resource view
+    ComPtr<ID3D11Texture2D> staticTexture;             ///< Depth of the static casters alone, created when the cache first needs it
     uint32_t size;                                      ///< Shadow map size
     XMMATRIX lightMatrix;                              ///< Light projection matrix
     XMMATRIX shadowMatrix;                             ///< Shadow transformation matrix
@@ -239,7 +255,9 @@ public:
     {
         uint32_t activeLights;                         ///< Number of active lights
         uint32_t shadowCastingLights;                  ///< Number of shadow casting lights
-        uint32_t shadowMapUpdates;                     ///< Shadow map updates per frame
+        uint32_t shadowMapUpdates;                     ///< Shadow maps drawn or composited this frame
+        uint32_t shadowMapsSkipped = 0;                ///< Shadow maps left as they were, nothing in them changed
+        uint32_t shadowMapsComposited = 0;             ///< Shadow maps rebuilt from the static layer and moving casters
         float shadowMapMemory;                         ///< Shadow map memory usage (MB)
         float lightCullingTime;                        ///< Light culling time (ms)
         float shadowRenderTime;                        ///< Shadow rendering time (ms)
@@ -267,8 +285,18 @@ public:
 
     /**
      * @brief Render shadow maps
+     *
+     * The cascaded directional light renders one map per cascade with that
+     * cascade's casters; other directional lights render their single map.
+     * Point, spot and area lights render into their tiles of the shadow
+     * atlas, one tile per cube face for point lights. Each map goes through
+     * the shadow cache: unchanged maps are skipped, and maps where only moving
+     * casters changed are rebuilt from their saved static layer. Atlas tiles
+     * have no static layer and are redrawn in full when anything changed.
+     * The render targets and viewport bound before the call are restored
+     * afterwards.
      */
-    void RenderShadowMaps(std::function<void(const XMMATRIX&, const XMMATRIX&)> renderCallback);
+    void RenderShadowMaps(ShadowCasterSource& casters);
 
     /**
      * @brief Bind lighting data to shaders
@@ -294,11 +322,39 @@ public:
     void EnableShadows(bool enabled);
     bool AreShadowsEnabled() const { return m_shadowsEnabled; }
 
+    /**
+     * @brief Build the caster list of each shadow cascade from the registry's world spheres
+     *
+     * Call after Update(), which fits the cascades to the camera, and before
+     * RenderShadowMaps().
+     */
+    void CullShadowCasters(const CullingSystem& culling);
+    ShadowCascades& GetShadowCascades() { return m_shadowCascades; }
+    const ShadowCascades& GetShadowCascades() const { return m_shadowCascades; }
+    ShadowCache& GetShadowCache() { return m_shadowCache; }
+    const ShadowCache& GetShadowCache() const { return m_shadowCache; }
+
+    /**
+     * @brief Tiles of the shadowed point, spot and area lights, assigned by Update()
+     */
+    ShadowAtlas& GetShadowAtlas() { return m_shadowAtlas; }
+    const ShadowAtlas& GetShadowAtlas() const { return m_shadowAtlas; }
+
     // Light culling
     void EnableLightCulling(bool enabled) { m_lightCullingEnabled = enabled; }
     bool IsLightCullingEnabled() const { return m_lightCullingEnabled; }
     void SetMaxLightsPerTile(uint32_t count) { m_maxLightsPerTile = count; }
 
+    /**
+     * @brief Bin the enabled point, spot and area lights into the camera's clusters
+     *
+     * Directional and environment lights reach every pixel and are not
+     * binned. BindLightingData() uploads the result; the list holds every
+     * light, so there is no per-scene light cap.
+     */
+    void CullLights(const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix);
+    const ClusteredLightGrid& GetLightGrid() const { return m_lightGrid; }
+
     // Metrics
     const LightingMetrics& GetMetrics() const { return m_metrics; }
 
@@ -366,6 +422,16 @@ public:
      */
     void Console_ReloadIBL();
 
+    /**
+     * @brief Light cluster grid statistics of the last CullLights()
+     */
+    std::string Console_GetClusterStats() const;
+
+    /**
+     * @brief Cascade fit and caster counts of the last frame
+     */
+    std::string Console_GetCascadeStats() const;
+
 private:
     ID3D11Device* m_device;
     ID3D11DeviceContext* m_context;
@@ -382,12 +448,44 @@ private:
     uint32_t m_shadowMapSize = 1024;
     std::unordered_map<Light*, std::unique_ptr<ShadowMap>> m_shadowMaps;
     std::unique_ptr<CascadedShadowMap> m_csmShadowMap;
-
-    // Light culling
+    ShadowCascades m_shadowCascades;
+    Light* m_cascadeLight = nullptr;                        ///< Directional light using m_csmShadowMap this frame
+    ShadowCache m_shadowCache;
+
+    // Shadow atlas for point, spot and area lights; faces at t21, depth at t22 (see ShadowAtlas.hlsl)
+    static constexpr UINT ShadowAtlasResourceSlot = 21;
+    static constexpr uint32_t ShadowAtlasSize = 4096;
+    static constexpr uint32_t ShadowAtlasMinTile = 64;
+    ShadowAtlas m_shadowAtlas;
+    ShadowMap m_shadowAtlasMap;                             ///< Depth of every tile; created on first use
+    std::vector<ShadowAtlasRequest> m_atlasRequests;
+    std::vector<ShadowAtlasFace> m_atlasFaces;              ///< Faces of the lights holding tiles this frame
+    std::unordered_map<const Light*, std::pair<uint32_t, uint32_t>> m_atlasLightFaces;   ///< First face and count
+    ComPtr<ID3D11Buffer> m_atlasFaceBuffer;                 ///< StructuredBuffer<ShadowAtlasFace>
+    ComPtr<ID3D11ShaderResourceView> m_atlasFaceSRV;
+    UINT m_atlasFaceCapacity = 0;
+    ComPtr<ID3D11VertexShader> m_tileClearVS;               ///< Full-screen triangle at depth 1
+    ComPtr<ID3D11DepthStencilState> m_tileClearDepthState;
+    ComPtr<ID3D11RasterizerState> m_tileClearRasterState;
+
+    // Light culling; the cluster buffers are bound at t18-t20 and b6 (see ClusteredLights.hlsl)
+    static constexpr UINT ClusterResourceSlot = 18;
+    static constexpr UINT ClusterConstantSlot = 6;
     bool m_lightCullingEnabled = true;
     uint32_t m_maxLightsPerTile = 64;
-    ComPtr<ID3D11Buffer> m_lightBuffer;
+    ClusteredLightGrid m_lightGrid;
+    std::vector<ClusterLight> m_clusterLights;
+    std::vector<LightData> m_clusterLightData;              ///< Shading data of m_clusterLights, same order
+    ComPtr<ID3D11Buffer> m_lightBuffer;                     ///< StructuredBuffer<LightData> of the binned lights
     ComPtr<ID3D11ShaderResourceView> m_lightBufferSRV;
+    ComPtr<ID3D11Buffer> m_clusterRangeBuffer;              ///< StructuredBuffer<uint2>: offset and count per cluster
+    ComPtr<ID3D11ShaderResourceView> m_clusterRangeSRV;
+    ComPtr<ID3D11Buffer> m_clusterIndexBuffer;              ///< StructuredBuffer<uint>: light indices
+    ComPtr<ID3D11ShaderResourceView> m_clusterIndexSRV;
+    ComPtr<ID3D11Buffer> m_clusterConstantBuffer;
+    UINT m_lightBufferCapacity = 0;
+    UINT m_clusterRangeCapacity = 0;
+    UINT m_clusterIndexCapacity = 0;
 
     // Constant buffers
     ComPtr<ID3D11Buffer> m_lightDataBuffer;
@@ -401,9 +499,23 @@ private:
     HRESULT CreateConstantBuffers();
     HRESULT CreateShadowMap(uint32_t size, ShadowMap& shadowMap);
     HRESULT CreateCascadedShadowMap();
+    HRESULT EnsureStaticLayer(ShadowMap& shadowMap);
+    void RenderShadowMap(ShadowMap* shadowMap, const Light* owner, uint32_t index, FXMMATRIX lightView,
+                         CXMMATRIX lightProj, const std::vector<uint32_t>* casterList, ShadowCasterSource& casters);
     void UpdateLightBuffer();
     void UpdateShadowMaps(const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix);
-    void CullLights(const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix);
+    void ConfigureShadowAtlas();
+    void UpdateShadowAtlas(const XMMATRIX& viewMatrix, const XMMATRIX& projMatrix);
+    void ApplyShadowAtlas(const Light& light, LightData& data) const;
+    void GetShadowAtlasFace(const Light& light, uint32_t face, XMMATRIX& view, XMMATRIX& projection) const;
+    void RenderShadowAtlasFaces(const Light& light, ShadowCasterSource& casters);
+    void BindShadowAtlas(ID3D11DeviceContext* context);
+    HRESULT CreateTileClear();
+    void ClearShadowTile();
+    void StoreCascadeMatrices();
+    void BindLightClusters(ID3D11DeviceContext* context);
+    HRESULT EnsureStructuredBuffer(ComPtr<ID3D11Buffer>& buffer, ComPtr<ID3D11ShaderResourceView>& view,
+                                   UINT stride, UINT count, UINT& capacity);
     void CalculateCSMSplits(float nearPlane, float farPlane, CascadedShadowMap& csm);
     XMMATRIX CalculateLightMatrix(const Light& light, const XMMATRIX& viewMatrix, float nearPlane, float farPlane);
 
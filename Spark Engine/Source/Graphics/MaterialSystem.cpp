@@ -13,6 +13,7 @@
 #include <sstream>
 #include <filesystem>
 #include <algorithm>
+#include <atomic>
 #include <iomanip>
 #include <chrono>
 
@@ -32,6 +33,9 @@ Material::Material(const std::string& name)
     m_renderState = {};
 	m_variants = {};
 	m_activeVariant = "";
+
+    static std::atomic<uint32_t> s_nextSortId{ 0 };
+    m_sortId = s_nextSortId.fetch_add(1, std::memory_order_relaxed);
 }
 
 const MaterialTexture& Material::GetTexture(MaterialTextureType type) const
@@ -273,7 +277,7 @@ void Material::BindToShader(ID3D11DeviceContext* context) const
     
     // Log binding for debugging in debug builds
     #ifdef _DEBUG
-    static int bindCount = 0;
+    static std::atomic<int> bindCount{ 0 };
     if (++bindCount % 100 == 0) { // Log every 100 binds to avoid spam
         Spark::SimpleConsole::GetInstance().LogInfo(
             "Material '" + m_name + "' bound with " + std::to_string(boundTextures) + " textures"
@@ -183,6 +183,7 @@ public:
 
     // Getters
     const std::string& GetName() const { return m_name; }
+    uint32_t GetSortId() const { return m_sortId; }    ///< Process-unique ID used to group draws
     const PBRProperties& GetPBRProperties() const { return m_pbrProperties; }
     const AdvancedProperties& GetAdvancedProperties() const { return m_advancedProperties; }
     const MaterialRenderState& GetRenderState() const { return m_renderState; }
@@ -226,6 +227,7 @@ private:
     std::unordered_map<MaterialTextureType, MaterialTexture> m_textures;
     std::unordered_map<std::string, std::vector<std::string>> m_variants;
     std::string m_activeVariant;
+    uint32_t m_sortId = 0;
 };
 
 /**
@@ -6,12 +6,17 @@
 #include <DirectXMath.h>
 #include <fstream>
 #include <filesystem>   // C++17 for path handling
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstddef>
 #include <iostream>
 
 using namespace DirectX;
 
 Mesh::Mesh() {
+    static std::atomic<uint32_t> s_nextSortId{ 0 };
+    m_sortId = s_nextSortId.fetch_add(1, std::memory_order_relaxed);
     std::wcout << L"[INFO] Mesh constructed." << std::endl;
 }
 Mesh::~Mesh() {
@@ -34,6 +39,8 @@ void Mesh::Shutdown() {
     if (m_vb) { m_vb->Release(); m_vb = nullptr; }
     m_vertices.clear();
     m_indices.clear();
+    m_lodIndices.clear();
+    m_lods.clear();
     m_vertexCount = m_indexCount = 0;
     m_device = nullptr;
     m_context = nullptr;
@@ -159,6 +166,14 @@ bool Mesh::LoadFromFile(const std::wstring& path) {
         return false;
     }
 
+    // LODs come from the cache baked beside the model; without one the mesh keeps a single level
+    if (MeshSimplifier::LoadLodCache(MeshSimplifier::GetLodCachePath(std::filesystem::path(path)), DescribeForSimplifier(nullptr),
+                                     m_lodIndices, m_lods))
+    {
+        hr = CreateIndexBuffer();
+        if (FAILED(hr)) return false;
+    }
+
     std::wcout << L"[INFO] Mesh loaded from file: " << path << std::endl;
     return true;
 }
@@ -497,17 +512,10 @@ HRESULT Mesh::CreateBuffers() {
     ASSERT_MSG(SUCCEEDED(hr), "CreateBuffer (VB) failed");
     if (FAILED(hr)) return hr;
 
-    // Index buffer
-    D3D11_BUFFER_DESC ibd{};
-    ibd.Usage = D3D11_USAGE_DEFAULT;
-    ibd.ByteWidth = static_cast<UINT>(m_indices.size() * sizeof(unsigned int));
-    ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-    ibd.CPUAccessFlags = 0;
-    D3D11_SUBRESOURCE_DATA isd{};
-    isd.pSysMem = m_indices.data();
-
-    hr = m_device->CreateBuffer(&ibd, &isd, &m_ib);
-    ASSERT_MSG(SUCCEEDED(hr), "CreateBuffer (IB) failed");
+    // Index buffer; new geometry starts with a single level until LODs are loaded or generated
+    m_lodIndices.clear();
+    m_lods.clear();
+    hr = CreateIndexBuffer();
     if (FAILED(hr)) return hr;
 
     // **ONLY log buffer creation occasionally for debugging**
@@ -519,9 +527,93 @@ HRESULT Mesh::CreateBuffers() {
     return S_OK;
 }
 
-void Mesh::Render(ID3D11DeviceContext* ctx) {
+HRESULT Mesh::CreateIndexBuffer() {
+    ASSERT(m_device);
+    if (m_ib) { m_ib->Release(); m_ib = nullptr; }
+
+    std::vector<unsigned int> combined;
+    const std::vector<unsigned int>* indices = &m_indices;
+    if (!m_lodIndices.empty()) {
+        combined.reserve(m_indices.size() + m_lodIndices.size());
+        combined.insert(combined.end(), m_indices.begin(), m_indices.end());
+        combined.insert(combined.end(), m_lodIndices.begin(), m_lodIndices.end());
+        indices = &combined;
+    }
+
+    D3D11_BUFFER_DESC ibd{};
+    ibd.Usage = D3D11_USAGE_DEFAULT;
+    ibd.ByteWidth = static_cast<UINT>(indices->size() * sizeof(unsigned int));
+    ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
+    ibd.CPUAccessFlags = 0;
+    D3D11_SUBRESOURCE_DATA isd{};
+    isd.pSysMem = indices->data();
+
+    HRESULT hr = m_device->CreateBuffer(&ibd, &isd, &m_ib);
+    ASSERT_MSG(SUCCEEDED(hr), "CreateBuffer (IB) failed");
+    return hr;
+}
+
+SimplifierMesh Mesh::DescribeForSimplifier(const float* attributeWeights) const {
+    // Normal and texture coordinate sit next to each other, so they are read as one run of five floats
+    static_assert(offsetof(Vertex, TexCoord) == offsetof(Vertex, Normal) + sizeof(XMFLOAT3), "Vertex attributes must be contiguous");
+    static_assert(sizeof(unsigned int) == sizeof(uint32_t), "Mesh indices must be 32-bit");
+
+    SimplifierMesh source;
+    if (m_vertices.empty() || m_indices.empty()) return source;
+    source.positions = &m_vertices[0].Position.x;
+    source.positionStride = sizeof(Vertex);
+    source.attributes = &m_vertices[0].Normal.x;
+    source.attributeStride = sizeof(Vertex);
+    source.attributeCount = 5;
+    source.attributeWeights = attributeWeights;
+    source.vertexCount = m_vertices.size();
+    source.indices = reinterpret_cast<const uint32_t*>(m_indices.data());
+    source.indexCount = m_indices.size();
+    return source;
+}
+
+void Mesh::BuildLods(const MeshLodSettings& settings) {
+    m_lodIndices.clear();
+    m_lods.clear();
+    if (m_vertices.empty() || m_indices.empty()) return;
+
+    const float weights[5] = { settings.normalWeight, settings.normalWeight, settings.normalWeight,
+                               settings.texCoordWeight, settings.texCoordWeight };
+    MeshSimplifier simplifier;
+    simplifier.BuildLodChain(DescribeForSimplifier(weights), settings, m_lodIndices, m_lods);
+}
+
+HRESULT Mesh::GenerateLods(const MeshLodSettings& settings) {
+    ASSERT_MSG(m_device && !m_indices.empty(), "GenerateLods before the mesh has data (%u indices)", m_indexCount);
+    if (!m_device || m_indices.empty()) return E_FAIL;
+    BuildLods(settings);
+    return CreateIndexBuffer();
+}
+
+MeshLodLevel Mesh::GetLod(uint32_t lod) const {
+    if (m_lods.empty()) return { 0, m_indexCount, 0.0f };
+    return m_lods[std::min<size_t>(lod, m_lods.size() - 1)];
+}
+
+bool Mesh::GetLocalBounds(XMFLOAT3& minimum, XMFLOAT3& maximum) const {
+    if (m_vertices.empty()) return false;
+
+    minimum = maximum = m_vertices.front().Position;
+    for (const Vertex& v : m_vertices) {
+        minimum.x = std::min(minimum.x, v.Position.x); maximum.x = std::max(maximum.x, v.Position.x);
+        minimum.y = std::min(minimum.y, v.Position.y); maximum.y = std::max(maximum.y, v.Position.y);
+        minimum.z = std::min(minimum.z, v.Position.z); maximum.z = std::max(maximum.z, v.Position.z);
+    }
+    return true;
+}
+
+void Mesh::Render(ID3D11DeviceContext* ctx) const {
+    Render(ctx, m_indexCount, 0);
+}
+
+void Mesh::Render(ID3D11DeviceContext* ctx, UINT indexCount, UINT startIndex) const {
     // **FIXED: Removed per-frame logging that was causing severe performance issues**
-    ASSERT(ctx && m_vb && m_ib && m_indexCount > 0);
+    ASSERT(ctx && m_vb && m_ib && indexCount > 0);
 
     UINT stride = sizeof(Vertex), offset = 0;
     ctx->IASetVertexBuffers(0, 1, &m_vb, &stride, &offset);
@@ -529,11 +621,12 @@ void Mesh::Render(ID3D11DeviceContext* ctx) {
     ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
     
     // **ENSURE PROPER RENDERING STATE**
-    ctx->DrawIndexed(m_indexCount, 0, 0);
+    ctx->DrawIndexed(indexCount, startIndex, 0);
 
     // **ONLY log rendering statistics occasionally for debugging**
-    static int renderCallCount = 0;
-    if (++renderCallCount % 3600 == 0) { // Every 60 seconds at 60fps
-        std::wcout << L"[DEBUG] Mesh rendered " << renderCallCount << L" times. IndexCount=" << m_indexCount << std::endl;
+    static std::atomic<int> s_renderCallCount{ 0 };
+    const int renderCallCount = ++s_renderCallCount;
+    if (renderCallCount % 3600 == 0) { // Every 60 seconds at 60fps
+        std::wcout << L"[DEBUG] Mesh rendered " << renderCallCount << L" times. IndexCount=" << indexCount << std::endl;
     }
 }
\ No newline at end of file
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "Utils/Assert.h"
+#include "MeshSimplifier.h"
 #include <d3d11.h>
 #include <DirectXMath.h>
 #include <vector>
@@ -214,9 +215,47 @@ public:
      * Binds vertex and index buffers and issues draw calls to render the mesh.
      * 
      * @param ctx DirectX 11 device context for rendering
-     * @note Shaders must be set before calling this method
+     * @note Shaders must be set before calling this method. Safe to call from
+     *       several threads at once as long as each uses its own context.
      */
-    void Render(ID3D11DeviceContext* ctx);
+    void Render(ID3D11DeviceContext* ctx) const;
+
+    /**
+     * @brief Render a range of the index buffer, e.g. one LOD from GetLod()
+     * @param ctx DirectX 11 device context for rendering
+     * @param indexCount Number of indices to draw
+     * @param startIndex First index to draw
+     */
+    void Render(ID3D11DeviceContext* ctx, UINT indexCount, UINT startIndex) const;
+
+    /**
+     * @brief Build a LOD chain now and upload the new index buffer
+     *
+     * Meshes loaded from a file use the chain baked beside the model (see
+     * MeshSimplifier::BakeObjLods() and the lod_bake command) and otherwise
+     * have a single level. This runs the full simplifier on the calling
+     * thread, so it is meant for tools and procedural meshes, not loading.
+     *
+     * @param settings Error thresholds and attribute weights of the chain
+     * @return HRESULT of the index buffer creation
+     */
+    HRESULT GenerateLods(const MeshLodSettings& settings);
+
+    /**
+     * @brief Number of LODs, including the full mesh as LOD 0
+     */
+    uint32_t GetLodCount() const { return m_lods.empty() ? 1u : static_cast<uint32_t>(m_lods.size()); }
+
+    /**
+     * @brief Index range and error of a LOD; coarser LODs follow the full mesh in the index buffer
+     * @param lod LOD to look up, clamped to the coarsest
+     */
+    MeshLodLevel GetLod(uint32_t lod) const;
+
+    /**
+     * @brief All LODs, for MeshSimplifier::SelectLod(); null when the mesh has a single level
+     */
+    const MeshLodLevel* GetLods() const { return m_lods.empty() ? nullptr : m_lods.data(); }
 
     /**
      * @brief Get the number of vertices in the mesh
@@ -230,6 +269,29 @@ public:
      */
     UINT GetIndexCount()  const { return m_indexCount; }
 
+    /**
+     * @brief Compute the axis-aligned bounds of the CPU vertex data
+     * @param minimum Receives the smallest vertex coordinates
+     * @param maximum Receives the largest vertex coordinates
+     * @return false if the mesh has no vertices
+     */
+    bool GetLocalBounds(XMFLOAT3& minimum, XMFLOAT3& maximum) const;
+
+    /**
+     * @brief CPU copy of the vertex data, kept for CPU-side passes such as software occlusion
+     */
+    const std::vector<Vertex>& GetVertices() const { return m_vertices; }
+
+    /**
+     * @brief CPU copy of the index data
+     */
+    const std::vector<unsigned int>& GetIndices() const { return m_indices; }
+
+    /**
+     * @brief Process-unique ID the render queue uses to group draws of this mesh
+     */
+    uint32_t GetSortId() const { return m_sortId; }
+
 private:
     /**
      * @brief Create DirectX vertex and index buffers from mesh data
@@ -237,6 +299,21 @@ private:
      */
     HRESULT CreateBuffers();
 
+    /**
+     * @brief Create the index buffer: the full index list followed by the LOD indices
+     */
+    HRESULT CreateIndexBuffer();
+
+    /**
+     * @brief View of the CPU mesh for the simplifier; empty when the mesh has no data
+     */
+    SimplifierMesh DescribeForSimplifier(const float* attributeWeights) const;
+
+    /**
+     * @brief Simplify the CPU mesh into m_lods and m_lodIndices
+     */
+    void    BuildLods(const MeshLodSettings& settings);
+
     /**
      * @brief Calculate vertex normals for the mesh
      * 
@@ -252,7 +329,10 @@ private:
 
     std::vector<Vertex>       m_vertices;    ///< CPU vertex data
     std::vector<unsigned int> m_indices;     ///< CPU index data
+    std::vector<unsigned int> m_lodIndices;  ///< Indices of LODs 1 and up, uploaded after m_indices
+    std::vector<MeshLodLevel> m_lods;        ///< LOD 0 is the full mesh; empty for a single level
     unsigned int              m_vertexCount{ 0 }; ///< Number of vertices
     unsigned int              m_indexCount{ 0 };  ///< Number of indices
     bool                      m_placeholder{ false }; ///< Placeholder mesh flag
+    uint32_t                  m_sortId{ 0 };          ///< Assigned at construction
 };
\ No newline at end of file
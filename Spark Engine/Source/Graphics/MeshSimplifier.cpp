@@ -0,0 +1,1208 @@
+/**
+ * @file MeshSimplifier.cpp
+ * @brief Implementation of the quadric error mesh simplifier
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * Simplification runs in passes. Each pass gathers every edge that may
+ * collapse, with the cheaper of its two directions, sorts them by error and
+ * performs them in order, skipping any that touch a position already changed
+ * in the pass or that would flip a triangle. Vertices with identical
+ * position and attributes are welded first, so unwelded input (one vertex per
+ * corner, as the OBJ loader produces) simplifies like indexed input. The
+ * benchmark measures the real distance from the original surface to every
+ * level, so the reported errors are checked rather than trusted.
+ *
+ * A .lod cache is a header (magic, version, source hash and counts), the
+ * levels, then the LOD indices. The source hash covers positions and indices
+ * only: the chain stays a valid index list over the model whatever its
+ * attributes, and Mesh may recompute normals after loading.
+ */
+
+#include "MeshSimplifier.h"
+#include <tiny_obj_loader.h>
+#include <algorithm>
+#include <cctype>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <tuple>
+
+using namespace DirectX;
+
+namespace
+{
+    constexpr uint32_t InvalidVertex = 0xFFFFFFFFu;
+    constexpr uint32_t MultipleVertices = 0xFFFFFFFEu;
+    constexpr float BorderEdgeWeight = 10.0f;           ///< Keeps open borders in place
+    constexpr float SeamEdgeWeight = 1.0f;              ///< Keeps attribute seams straight
+    constexpr float MaxFlipCosine = 0.25f;              ///< Smallest cosine between a face's normals before and after a collapse
+
+    const float* ReadFloats(const float* base, size_t stride, size_t index)
+    {
+        return reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(base) + stride * index);
+    }
+
+    XMFLOAT3 Subtract(const XMFLOAT3& a, const XMFLOAT3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    float Dot(const XMFLOAT3& a, const XMFLOAT3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    XMFLOAT3 Cross(const XMFLOAT3& a, const XMFLOAT3& b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+
+    void ComputeBounds(const SimplifierMesh& mesh, XMFLOAT3& lo, XMFLOAT3& hi)
+    {
+        lo = { FLT_MAX, FLT_MAX, FLT_MAX };
+        hi = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for (size_t i = 0; i < mesh.vertexCount; ++i) {
+            const float* p = ReadFloats(mesh.positions, mesh.positionStride, i);
+            lo = { std::min(lo.x, p[0]), std::min(lo.y, p[1]), std::min(lo.z, p[2]) };
+            hi = { std::max(hi.x, p[0]), std::max(hi.y, p[1]), std::max(hi.z, p[2]) };
+        }
+    }
+}
+
+// ============================================================================
+// SIMPLIFICATION
+// ============================================================================
+
+float MeshSimplifier::Simplify(const SimplifierMesh& mesh, size_t targetIndexCount, float targetError,
+                               std::vector<uint32_t>& result, bool lockBorders)
+{
+    Prepare(mesh, lockBorders, result);
+
+    const float errorLimit = targetError * targetError;
+    float error = 0.0f;
+    while (result.size() > targetIndexCount) {
+        if (RunPass(result, targetIndexCount, errorLimit, error) == 0) break;
+    }
+    m_currentIndices = nullptr;
+    return std::sqrt(error);
+}
+
+void MeshSimplifier::BuildLodChain(const SimplifierMesh& mesh, const MeshLodSettings& settings, std::vector<uint32_t>& lodIndices,
+                                   std::vector<MeshLodLevel>& levels)
+{
+    levels.clear();
+    lodIndices.clear();
+    levels.push_back({ 0, static_cast<uint32_t>(mesh.indexCount), 0.0f });
+    if (mesh.indexCount / 3 < settings.minTriangles) return;
+
+    // One run with a rising limit; the quadrics keep measuring against the full mesh, so a
+    // snapshot at each threshold is the same as simplifying the full mesh to that threshold
+    Prepare(mesh, settings.lockBorders, m_chainScratch);
+    size_t previousCount = mesh.indexCount;
+    float error = 0.0f;
+    for (float threshold : settings.errorThresholds) {
+        if (levels.size() >= MeshLodSettings::MaxLevels) break;
+
+        while (RunPass(m_chainScratch, 0, threshold * threshold, error) != 0) {}
+        if (m_chainScratch.empty()) break;
+        if (m_chainScratch.size() > previousCount * (1.0f - settings.minReduction)) continue;
+
+        MeshLodLevel level;
+        level.firstIndex = static_cast<uint32_t>(mesh.indexCount + lodIndices.size());
+        level.indexCount = static_cast<uint32_t>(m_chainScratch.size());
+        level.error = std::sqrt(error);
+        levels.push_back(level);
+        lodIndices.insert(lodIndices.end(), m_chainScratch.begin(), m_chainScratch.end());
+        previousCount = m_chainScratch.size();
+    }
+    m_currentIndices = nullptr;
+}
+
+uint32_t MeshSimplifier::SelectLod(const MeshLodLevel* levels, uint32_t levelCount, float screenRadius, uint32_t currentLod,
+                                   float pixelError, float hysteresis)
+{
+    if (levelCount <= 1) return 0;
+    currentLod = std::min(currentLod, levelCount - 1);
+
+    uint32_t lod = 0;
+    for (uint32_t i = 1; i < levelCount; ++i) {
+        const float limit = i > currentLod ? pixelError * (1.0f - hysteresis) : pixelError;
+        if (levels[i].error * screenRadius > limit) break;
+        lod = i;
+    }
+    return lod;
+}
+
+float MeshSimplifier::GetBoundingRadius(const SimplifierMesh& mesh)
+{
+    if (mesh.vertexCount == 0) return 0.0f;
+    XMFLOAT3 lo, hi;
+    ComputeBounds(mesh, lo, hi);
+    const XMFLOAT3 extent = Subtract(hi, lo);
+    return 0.5f * std::sqrt(Dot(extent, extent));
+}
+
+// ============================================================================
+// LOD CACHE
+// ============================================================================
+
+namespace
+{
+    constexpr uint32_t LodCacheMagic = 0x444F4C53u;     ///< "SLOD"
+    constexpr uint32_t LodCacheVersion = 1;
+
+    struct LodCacheHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t sourceHash;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint32_t levelCount;
+        uint32_t lodIndexCount;
+    };
+}
+
+std::filesystem::path MeshSimplifier::GetLodCachePath(const std::filesystem::path& modelPath)
+{
+    std::filesystem::path path = modelPath;
+    path += ".lod";
+    return path;
+}
+
+uint64_t MeshSimplifier::HashLodSource(const SimplifierMesh& mesh)
+{
+    // FNV-1a over 32-bit words: the counts, every position, every index
+    uint64_t hash = 14695981039346656037ull;
+    auto add = [&hash](uint32_t word) { hash = (hash ^ word) * 1099511628211ull; };
+    add(static_cast<uint32_t>(mesh.vertexCount));
+    add(static_cast<uint32_t>(mesh.indexCount));
+    for (size_t i = 0; i < mesh.vertexCount; ++i) {
+        uint32_t bits[3];
+        std::memcpy(bits, ReadFloats(mesh.positions, mesh.positionStride, i), sizeof(bits));
+        add(bits[0]);
+        add(bits[1]);
+        add(bits[2]);
+    }
+    for (size_t i = 0; i < mesh.indexCount; ++i) add(mesh.indices[i]);
+    return hash;
+}
+
+bool MeshSimplifier::SaveLodCache(const std::filesystem::path& path, const SimplifierMesh& mesh,
+                                  const std::vector<uint32_t>& lodIndices, const std::vector<MeshLodLevel>& levels)
+{
+    ASSERT_MSG(!levels.empty() && levels[0].indexCount == mesh.indexCount, "LOD chain does not start with the full mesh (%zu indices)",
+               mesh.indexCount);
+    const LodCacheHeader header{ LodCacheMagic, LodCacheVersion, HashLodSource(mesh), static_cast<uint32_t>(mesh.vertexCount),
+                                 static_cast<uint32_t>(mesh.indexCount), static_cast<uint32_t>(levels.size()),
+                                 static_cast<uint32_t>(lodIndices.size()) };
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(levels.data()), std::streamsize(levels.size() * sizeof(MeshLodLevel)));
+    file.write(reinterpret_cast<const char*>(lodIndices.data()), std::streamsize(lodIndices.size() * sizeof(uint32_t)));
+    return static_cast<bool>(file);
+}
+
+bool MeshSimplifier::LoadLodCache(const std::filesystem::path& path, const SimplifierMesh& mesh,
+                                  std::vector<uint32_t>& lodIndices, std::vector<MeshLodLevel>& levels)
+{
+    lodIndices.clear();
+    levels.clear();
+    std::ifstream file(path, std::ios::binary);
+    LodCacheHeader header{};
+    if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+
+    // Cheap checks first; hashing reads the whole mesh
+    if (header.magic != LodCacheMagic || header.version != LodCacheVersion || header.vertexCount != mesh.vertexCount ||
+        header.indexCount != mesh.indexCount || header.levelCount == 0 || header.levelCount > MeshLodSettings::MaxLevels ||
+        uint64_t(header.lodIndexCount) > uint64_t(header.indexCount) * MeshLodSettings::MaxLevels ||
+        header.sourceHash != HashLodSource(mesh)) {
+        return false;
+    }
+
+    levels.resize(header.levelCount);
+    lodIndices.resize(header.lodIndexCount);
+    file.read(reinterpret_cast<char*>(levels.data()), std::streamsize(levels.size() * sizeof(MeshLodLevel)));
+    file.read(reinterpret_cast<char*>(lodIndices.data()), std::streamsize(lodIndices.size() * sizeof(uint32_t)));
+    char extra;
+    bool valid = file && !file.read(&extra, 1);
+
+    // Level 0 is the mesh itself; the others lie inside the LOD indices and index real vertices
+    valid = valid && levels[0].firstIndex == 0 && levels[0].indexCount == header.indexCount;
+    for (uint32_t i = 1; valid && i < header.levelCount; ++i) {
+        const MeshLodLevel& level = levels[i];
+        valid = level.firstIndex >= header.indexCount && level.indexCount > 0 && level.indexCount % 3 == 0 &&
+                uint64_t(level.firstIndex - header.indexCount) + level.indexCount <= header.lodIndexCount &&
+                std::isfinite(level.error) && level.error >= 0.0f;
+    }
+    for (size_t i = 0; valid && i < lodIndices.size(); ++i) valid = lodIndices[i] < header.vertexCount;
+
+    if (!valid) {
+        lodIndices.clear();
+        levels.clear();
+    }
+    return valid;
+}
+
+// ============================================================================
+// SETUP
+// ============================================================================
+
+void MeshSimplifier::Prepare(const SimplifierMesh& mesh, bool lockBorders, std::vector<uint32_t>& indices)
+{
+    ASSERT_MSG(mesh.positions && mesh.positionStride >= 3 * sizeof(float), "Simplifier needs positions (stride %u)",
+               static_cast<unsigned>(mesh.positionStride));
+    ASSERT_MSG(mesh.attributeCount <= SimplifierMesh::MaxAttributes, "Too many simplifier attributes (%u)", mesh.attributeCount);
+    ASSERT_MSG(mesh.indexCount % 3 == 0, "Simplifier needs a triangle list (%u indices)", static_cast<unsigned>(mesh.indexCount));
+
+    const uint32_t n = static_cast<uint32_t>(mesh.vertexCount);
+
+    // Center on the bounds and divide by the radius, so errors are fractions of the radius
+    XMFLOAT3 lo{}, hi{};
+    ComputeBounds(mesh, lo, hi);
+    const XMFLOAT3 center = { 0.5f * (lo.x + hi.x), 0.5f * (lo.y + hi.y), 0.5f * (lo.z + hi.z) };
+    const float radius = GetBoundingRadius(mesh);
+    const float inverseRadius = radius > 0.0f ? 1.0f / radius : 1.0f;
+
+    m_positions.resize(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        const float* p = ReadFloats(mesh.positions, mesh.positionStride, i);
+        m_positions[i] = { (p[0] - center.x) * inverseRadius, (p[1] - center.y) * inverseRadius, (p[2] - center.z) * inverseRadius };
+    }
+
+    m_attributeCount = mesh.attributes ? mesh.attributeCount : 0;
+    m_attributes.resize(size_t(n) * m_attributeCount);
+    for (uint32_t k = 0; k < m_attributeCount; ++k) {
+        const float scale = std::sqrt(mesh.attributeWeights ? std::max(mesh.attributeWeights[k], 0.0f) : 1.0f);
+        for (uint32_t i = 0; i < n; ++i) {
+            // + 0 turns -0 into +0: zero-weight attributes must compare equal byte for byte below
+            m_attributes[size_t(i) * m_attributeCount + k] = ReadFloats(mesh.attributes, mesh.attributeStride, i)[k] * scale + 0.0f;
+        }
+    }
+
+    // Weld identical vertices, then group positions; the lowest index of a group stands for it
+    auto samePosition = [this](uint32_t a, uint32_t b) { return std::memcmp(&m_positions[a], &m_positions[b], sizeof(XMFLOAT3)); };
+    auto sameVertex = [&](uint32_t a, uint32_t b) {
+        const int order = samePosition(a, b);
+        if (order != 0 || m_attributeCount == 0) return order;
+        return std::memcmp(&m_attributes[size_t(a) * m_attributeCount], &m_attributes[size_t(b) * m_attributeCount],
+                           m_attributeCount * sizeof(float));
+    };
+
+    m_order.resize(n);
+    m_vertexRemap.resize(n);
+    std::iota(m_order.begin(), m_order.end(), 0u);
+    std::sort(m_order.begin(), m_order.end(), [&](uint32_t a, uint32_t b) {
+        const int order = sameVertex(a, b);
+        return order != 0 ? order < 0 : a < b;
+    });
+    for (uint32_t i = 0; i < n; ++i) {
+        const uint32_t v = m_order[i];
+        m_vertexRemap[v] = (i > 0 && sameVertex(m_order[i - 1], v) == 0) ? m_vertexRemap[m_order[i - 1]] : v;
+    }
+
+    m_positionRemap.resize(n);
+    m_wedge.resize(n);
+    std::iota(m_wedge.begin(), m_wedge.end(), 0u);
+    std::sort(m_order.begin(), m_order.end(), [&](uint32_t a, uint32_t b) {
+        const int order = samePosition(a, b);
+        return order != 0 ? order < 0 : a < b;
+    });
+    for (uint32_t begin = 0, end; begin < n; begin = end) {
+        const uint32_t leader = m_order[begin];
+        uint32_t first = InvalidVertex, last = InvalidVertex;
+        for (end = begin; end < n && samePosition(leader, m_order[end]) == 0; ++end) {
+            const uint32_t v = m_order[end];
+            m_positionRemap[v] = leader;
+            if (m_vertexRemap[v] != v) continue;
+            if (first == InvalidVertex) first = v; else m_wedge[last] = v;
+            last = v;
+        }
+        m_wedge[last] = first;
+    }
+
+    // Welded triangle list without triangles that are already degenerate
+    indices.clear();
+    indices.reserve(mesh.indexCount);
+    for (size_t i = 0; i < mesh.indexCount; i += 3) {
+        uint32_t corner[3];
+        for (int j = 0; j < 3; ++j) {
+            ASSERT_MSG(mesh.indices[i + j] < n, "Simplifier index out of range (%u)", mesh.indices[i + j]);
+            corner[j] = m_vertexRemap[mesh.indices[i + j]];
+        }
+        const uint32_t p0 = m_positionRemap[corner[0]], p1 = m_positionRemap[corner[1]], p2 = m_positionRemap[corner[2]];
+        if (p0 == p1 || p1 == p2 || p0 == p2) continue;
+        indices.insert(indices.end(), corner, corner + 3);
+    }
+
+    BuildAdjacency(indices);
+    ClassifyVertices(lockBorders);
+    FillQuadrics(indices);
+}
+
+void MeshSimplifier::BuildAdjacency(const std::vector<uint32_t>& indices)
+{
+    const size_t n = m_positions.size();
+
+    // Directed edges by source vertex, counted then filled in place and shifted back
+    m_edgeOffsets.assign(n + 1, 0);
+    m_triangleOffsets.assign(n + 1, 0);
+    for (uint32_t index : indices) {
+        m_edgeOffsets[index + 1]++;
+        m_triangleOffsets[m_positionRemap[index] + 1]++;
+    }
+    for (size_t i = 1; i <= n; ++i) {
+        m_edgeOffsets[i] += m_edgeOffsets[i - 1];
+        m_triangleOffsets[i] += m_triangleOffsets[i - 1];
+    }
+
+    m_edgeTargets.resize(indices.size());
+    m_triangles.resize(indices.size());
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        for (size_t j = 0; j < 3; ++j) {
+            const uint32_t from = indices[i + j], to = indices[i + (j + 1) % 3];
+            m_edgeTargets[m_edgeOffsets[from]++] = to;
+            m_triangles[m_triangleOffsets[m_positionRemap[from]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+    for (size_t i = n; i > 0; --i) {
+        m_edgeOffsets[i] = m_edgeOffsets[i - 1];
+        m_triangleOffsets[i] = m_triangleOffsets[i - 1];
+    }
+    m_edgeOffsets[0] = 0;
+    m_triangleOffsets[0] = 0;
+}
+
+bool MeshSimplifier::HasEdge(uint32_t a, uint32_t b) const
+{
+    for (uint32_t e = m_edgeOffsets[a]; e < m_edgeOffsets[a + 1]; ++e) {
+        if (m_edgeTargets[e] == b) return true;
+    }
+    return false;
+}
+
+bool MeshSimplifier::HasPositionEdge(uint32_t a, uint32_t b) const
+{
+    uint32_t wa = a;
+    do {
+        uint32_t wb = b;
+        do {
+            if (HasEdge(wa, wb)) return true;
+            wb = m_wedge[wb];
+        } while (wb != b);
+        wa = m_wedge[wa];
+    } while (wa != a);
+    return false;
+}
+
+void MeshSimplifier::ClassifyVertices(bool lockBorders)
+{
+    const uint32_t n = static_cast<uint32_t>(m_positions.size());
+
+    // An edge is open in vertex space when no triangle uses it the other way round with the same vertices
+    m_openOut.assign(n, InvalidVertex);
+    m_openIn.assign(n, InvalidVertex);
+    for (uint32_t v = 0; v < n; ++v) {
+        for (uint32_t e = m_edgeOffsets[v]; e < m_edgeOffsets[v + 1]; ++e) {
+            const uint32_t w = m_edgeTargets[e];
+            if (HasEdge(w, v)) continue;
+            m_openOut[v] = m_openOut[v] == InvalidVertex ? w : MultipleVertices;
+            m_openIn[w] = m_openIn[w] == InvalidVertex ? v : MultipleVertices;
+        }
+    }
+
+    auto single = [](uint32_t v) { return v < MultipleVertices; };
+
+    m_kind.assign(n, KindLocked);
+    for (uint32_t v = 0; v < n; ++v) {
+        if (m_vertexRemap[v] != v) continue;
+
+        const uint32_t twin = m_wedge[v];
+        const uint32_t in = m_openIn[v], out = m_openOut[v];
+        if (twin == v) {
+            // One wedge: interior, or on exactly one border that is open in position space too
+            if (in == InvalidVertex && out == InvalidVertex) {
+                m_kind[v] = KindManifold;
+            } else if (single(in) && single(out) && !HasPositionEdge(v, in) && !HasPositionEdge(out, v)) {
+                m_kind[v] = lockBorders ? KindLocked : KindBorder;
+            }
+        } else if (m_wedge[twin] == v) {
+            // Two wedges whose open edges are the two sides of one seam
+            const uint32_t twinIn = m_openIn[twin], twinOut = m_openOut[twin];
+            if (single(in) && single(out) && single(twinIn) && single(twinOut) &&
+                m_positionRemap[in] == m_positionRemap[twinOut] && m_positionRemap[out] == m_positionRemap[twinIn]) {
+                m_kind[v] = KindSeam;
+            }
+        }
+    }
+}
+
+void MeshSimplifier::FillQuadrics(const std::vector<uint32_t>& indices)
+{
+    const size_t n = m_positions.size();
+    m_positionQuadrics.assign(n, Quadric{});
+    m_attributeQuadrics.assign(n, Quadric{});
+    m_gradients.assign(n * m_attributeCount, QuadricGradient{});
+
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        const uint32_t corner[3] = { indices[i], indices[i + 1], indices[i + 2] };
+        const XMFLOAT3& p0 = m_positions[corner[0]];
+        const XMFLOAT3 e1 = Subtract(m_positions[corner[1]], p0), e2 = Subtract(m_positions[corner[2]], p0);
+        const XMFLOAT3 normal = Cross(e1, e2);
+        const float length = std::sqrt(Dot(normal, normal));
+        if (length == 0.0f) continue;
+
+        // Plane of the triangle, weighted by its area; only triangles count towards the weight
+        const float area = 0.5f * length;
+        const XMFLOAT3 n1 = { normal.x / length, normal.y / length, normal.z / length };
+        for (uint32_t v : corner) {
+            Quadric& q = m_positionQuadrics[m_positionRemap[v]];
+            AddPlane(q, n1.x, n1.y, n1.z, -Dot(n1, p0), area);
+            q.weight += area;
+        }
+
+        // Attributes vary linearly over the triangle: a(p) = g.p + d with g in the triangle's plane
+        if (m_attributeCount > 0) {
+            const float a00 = Dot(e1, e1), a01 = Dot(e1, e2), a11 = Dot(e2, e2);
+            const float inverseDet = 1.0f / (a00 * a11 - a01 * a01);
+
+            Quadric q;
+            q.weight = area;
+            QuadricGradient gradients[SimplifierMesh::MaxAttributes];
+            for (uint32_t k = 0; k < m_attributeCount; ++k) {
+                const float s0 = m_attributes[size_t(corner[0]) * m_attributeCount + k];
+                const float d1 = m_attributes[size_t(corner[1]) * m_attributeCount + k] - s0;
+                const float d2 = m_attributes[size_t(corner[2]) * m_attributeCount + k] - s0;
+                const float u = (a11 * d1 - a01 * d2) * inverseDet, w = (a00 * d2 - a01 * d1) * inverseDet;
+                const XMFLOAT3 g = { e1.x * u + e2.x * w, e1.y * u + e2.y * w, e1.z * u + e2.z * w };
+                const float d = s0 - Dot(g, p0);
+
+                q.a00 += area * g.x * g.x; q.a11 += area * g.y * g.y; q.a22 += area * g.z * g.z;
+                q.a10 += area * g.y * g.x; q.a20 += area * g.z * g.x; q.a21 += area * g.z * g.y;
+                q.b0 += area * g.x * d; q.b1 += area * g.y * d; q.b2 += area * g.z * d;
+                q.c += area * d * d;
+                gradients[k] = { area * g.x, area * g.y, area * g.z, area * d };
+            }
+            for (uint32_t v : corner) {
+                AddQuadric(m_attributeQuadrics[v], q);
+                for (uint32_t k = 0; k < m_attributeCount; ++k) {
+                    QuadricGradient& target = m_gradients[size_t(v) * m_attributeCount + k];
+                    target.gx += gradients[k].gx; target.gy += gradients[k].gy;
+                    target.gz += gradients[k].gz; target.gw += gradients[k].gw;
+                }
+            }
+        }
+
+        // Open edges add a plane through the edge, perpendicular to the triangle
+        for (int j = 0; j < 3; ++j) {
+            const uint32_t a = corner[j], b = corner[(j + 1) % 3];
+            if (HasEdge(b, a)) continue;
+
+            const XMFLOAT3 edge = Subtract(m_positions[b], m_positions[a]);
+            const XMFLOAT3 side = Cross(edge, n1);
+            const float edgeLength = std::sqrt(Dot(edge, edge)), sideLength = std::sqrt(Dot(side, side));
+            if (sideLength == 0.0f) continue;
+
+            const float weight = (HasPositionEdge(b, a) ? SeamEdgeWeight : BorderEdgeWeight) * edgeLength * edgeLength;
+            const XMFLOAT3 plane = { side.x / sideLength, side.y / sideLength, side.z / sideLength };
+            const float d = -Dot(plane, m_positions[a]);
+            AddPlane(m_positionQuadrics[m_positionRemap[a]], plane.x, plane.y, plane.z, d, weight);
+            AddPlane(m_positionQuadrics[m_positionRemap[b]], plane.x, plane.y, plane.z, d, weight);
+        }
+    }
+}
+
+// ============================================================================
+// COLLAPSES
+// ============================================================================
+
+bool MeshSimplifier::CanCollapse(uint32_t v0, uint32_t v1) const
+{
+    if (m_positionRemap[v0] == m_positionRemap[v1]) return false;
+
+    const uint8_t target = m_kind[v1];
+    const bool alongOpenEdge = m_openOut[v0] == v1 || m_openIn[v0] == v1;
+    switch (m_kind[v0]) {
+    case KindManifold:
+        return true;
+    case KindBorder:
+        return alongOpenEdge && (target == KindBorder || target == KindLocked);
+    case KindSeam:
+        return alongOpenEdge && (target == KindSeam || target == KindLocked) && SeamTarget(v0, v1) != InvalidVertex;
+    default:
+        return false;
+    }
+}
+
+uint32_t MeshSimplifier::SeamTarget(uint32_t v0, uint32_t v1) const
+{
+    // The twin side runs the seam the other way round
+    const uint32_t s0 = m_wedge[v0];
+    const uint32_t s1 = m_openOut[v0] == v1 ? m_openIn[s0] : m_openOut[s0];
+    if (s1 >= MultipleVertices || m_positionRemap[s1] != m_positionRemap[v1]) return InvalidVertex;
+    return s1;
+}
+
+float MeshSimplifier::AttributeError(uint32_t vertex, const XMFLOAT3& position, uint32_t target) const
+{
+    const Quadric& q = m_attributeQuadrics[vertex];
+    if (m_attributeCount == 0 || q.weight <= 0.0f) return 0.0f;
+
+    float r = EvaluateQuadric(q, position);
+    for (uint32_t k = 0; k < m_attributeCount; ++k) {
+        const float s = m_attributes[size_t(target) * m_attributeCount + k];
+        const QuadricGradient& g = m_gradients[size_t(vertex) * m_attributeCount + k];
+        r += s * s * q.weight - 2.0f * s * (g.gx * position.x + g.gy * position.y + g.gz * position.z + g.gw);
+    }
+    return std::max(r, 0.0f) / q.weight;
+}
+
+float MeshSimplifier::CollapseError(uint32_t v0, uint32_t v1) const
+{
+    const XMFLOAT3& position = m_positions[v1];
+    const Quadric& q = m_positionQuadrics[m_positionRemap[v0]];
+    const float r = std::max(EvaluateQuadric(q, position), 0.0f);
+
+    float error = q.weight > 0.0f ? r / q.weight : r;
+    error += AttributeError(v0, position, v1);
+    if (m_kind[v0] == KindSeam) error += AttributeError(m_wedge[v0], position, SeamTarget(v0, v1));
+    return error;
+}
+
+bool MeshSimplifier::HasTriangleFlip(uint32_t v0, uint32_t v1) const
+{
+    const std::vector<uint32_t>& indices = *m_currentIndices;
+    const uint32_t r0 = m_positionRemap[v0], r1 = m_positionRemap[v1];
+    const XMFLOAT3& target = m_positions[v1];
+
+    for (uint32_t t = m_triangleOffsets[r0]; t < m_triangleOffsets[r0 + 1]; ++t) {
+        const size_t base = size_t(m_triangles[t]) * 3;
+        uint32_t corner[3], position[3];
+        int moving = -1;
+        for (int j = 0; j < 3; ++j) {
+            corner[j] = m_collapseRemap[indices[base + j]];
+            position[j] = m_positionRemap[corner[j]];
+            if (position[j] == r0) moving = j;
+        }
+        // Triangles on the collapsing edge disappear, and so do ones already degenerate
+        if (moving < 0 || position[0] == r1 || position[1] == r1 || position[2] == r1) continue;
+        if (position[0] == position[1] || position[1] == position[2] || position[0] == position[2]) continue;
+
+        const XMFLOAT3& a = m_positions[corner[0]];
+        const XMFLOAT3& b = m_positions[corner[1]];
+        const XMFLOAT3& c = m_positions[corner[2]];
+        const XMFLOAT3 before = Cross(Subtract(b, a), Subtract(c, a));
+        const XMFLOAT3& a1 = moving == 0 ? target : a;
+        const XMFLOAT3& b1 = moving == 1 ? target : b;
+        const XMFLOAT3& c1 = moving == 2 ? target : c;
+        const XMFLOAT3 after = Cross(Subtract(b1, a1), Subtract(c1, a1));
+
+        // Turning a face by more than about 75 degrees folds it over or stands it on edge
+        const float d = Dot(before, after);
+        if (d <= 0.0f || d * d <= MaxFlipCosine * MaxFlipCosine * Dot(before, before) * Dot(after, after)) return true;
+    }
+    return false;
+}
+
+size_t MeshSimplifier::RunPass(std::vector<uint32_t>& indices, size_t targetIndexCount, float errorLimit, float& resultError)
+{
+    const uint32_t n = static_cast<uint32_t>(m_positions.size());
+    const size_t triangleCount = indices.size() / 3;
+    const size_t triangleGoal = triangleCount - std::min(triangleCount, targetIndexCount / 3);
+    if (triangleGoal == 0) return 0;
+
+    BuildAdjacency(indices);
+    m_currentIndices = &indices;
+
+    // Every edge once, in its cheaper allowed direction
+    m_collapses.clear();
+    for (uint32_t v = 0; v < n; ++v) {
+        for (uint32_t e = m_edgeOffsets[v]; e < m_edgeOffsets[v + 1]; ++e) {
+            const uint32_t w = m_edgeTargets[e];
+            if (w < v && HasEdge(w, v)) continue;
+
+            const float forward = CanCollapse(v, w) ? CollapseError(v, w) : FLT_MAX;
+            const float backward = CanCollapse(w, v) ? CollapseError(w, v) : FLT_MAX;
+            const Collapse collapse = forward <= backward ? Collapse{ v, w, forward } : Collapse{ w, v, backward };
+            if (collapse.error <= errorLimit) m_collapses.push_back(collapse);
+        }
+    }
+    SortCollapses();
+
+    // Cheapest first; a position changed in this pass is locked until the next one
+    m_collapseRemap.resize(n);
+    std::iota(m_collapseRemap.begin(), m_collapseRemap.end(), 0u);
+    m_collapseLocked.assign(n, 0);
+
+    size_t removed = 0, performed = 0;
+    for (const Collapse& collapse : m_collapses) {
+        if (removed >= triangleGoal) break;
+
+        const uint32_t v0 = collapse.v0, v1 = collapse.v1;
+        const uint32_t r0 = m_positionRemap[v0], r1 = m_positionRemap[v1];
+        if (m_collapseLocked[r0] || m_collapseLocked[r1] || HasTriangleFlip(v0, v1)) continue;
+
+        AddQuadric(m_positionQuadrics[r1], m_positionQuadrics[r0]);
+        auto moveAttributes = [this](uint32_t from, uint32_t to) {
+            AddQuadric(m_attributeQuadrics[to], m_attributeQuadrics[from]);
+            for (uint32_t k = 0; k < m_attributeCount; ++k) {
+                const QuadricGradient& g = m_gradients[size_t(from) * m_attributeCount + k];
+                QuadricGradient& target = m_gradients[size_t(to) * m_attributeCount + k];
+                target.gx += g.gx; target.gy += g.gy; target.gz += g.gz; target.gw += g.gw;
+            }
+            m_collapseRemap[from] = to;
+        };
+        moveAttributes(v0, v1);
+        if (m_kind[v0] == KindSeam) {
+            const uint32_t s0 = m_wedge[v0];
+            moveAttributes(s0, SeamTarget(v0, v1));
+        }
+
+        m_collapseLocked[r0] = 1;
+        m_collapseLocked[r1] = 1;
+        removed += m_kind[v0] == KindBorder ? 1 : 2;
+        resultError = std::max(resultError, collapse.error);
+        performed++;
+    }
+
+    size_t write = 0;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        const uint32_t a = m_collapseRemap[indices[i]], b = m_collapseRemap[indices[i + 1]], c = m_collapseRemap[indices[i + 2]];
+        const uint32_t pa = m_positionRemap[a], pb = m_positionRemap[b], pc = m_positionRemap[c];
+        if (pa == pb || pb == pc || pa == pc) continue;
+        indices[write++] = a;
+        indices[write++] = b;
+        indices[write++] = c;
+    }
+    indices.resize(write);
+
+    RemapEdgeLoops(m_openOut, m_collapseRemap, m_order);
+    RemapEdgeLoops(m_openIn, m_collapseRemap, m_order);
+    return performed;
+}
+
+void MeshSimplifier::SortCollapses()
+{
+    // Counting sort on the top 16 bits of the error; errors are not negative, so their bits
+    // order like their values, and ties within 1% of each other do not matter
+    constexpr uint32_t Buckets = 1u << 16;
+    auto keyOf = [](float error) {
+        uint32_t bits;
+        std::memcpy(&bits, &error, sizeof(bits));
+        return bits >> 16;
+    };
+
+    m_histogram.assign(Buckets + 1, 0);
+    for (const Collapse& collapse : m_collapses) m_histogram[keyOf(collapse.error) + 1]++;
+    for (uint32_t i = 1; i <= Buckets; ++i) m_histogram[i] += m_histogram[i - 1];
+
+    m_sortedCollapses.resize(m_collapses.size());
+    for (const Collapse& collapse : m_collapses) m_sortedCollapses[m_histogram[keyOf(collapse.error)]++] = collapse;
+    m_collapses.swap(m_sortedCollapses);
+}
+
+void MeshSimplifier::RemapEdgeLoops(std::vector<uint32_t>& loops, const std::vector<uint32_t>& remap, std::vector<uint32_t>& scratch)
+{
+    // A neighbour that collapsed along the loop is replaced by its target; one that collapsed onto
+    // this vertex is skipped, so the loop continues to the neighbour's own neighbour
+    scratch.assign(loops.begin(), loops.end());
+    for (size_t v = 0; v < loops.size(); ++v) {
+        const uint32_t next = scratch[v];
+        if (next >= MultipleVertices) continue;
+        if (remap[next] != v) {
+            loops[v] = remap[next];
+        } else {
+            const uint32_t skipped = scratch[next];
+            loops[v] = skipped < MultipleVertices ? remap[skipped] : skipped;
+        }
+    }
+}
+
+// ============================================================================
+// QUADRICS
+// ============================================================================
+
+void MeshSimplifier::AddPlane(Quadric& q, float nx, float ny, float nz, float d, float weight)
+{
+    q.a00 += weight * nx * nx; q.a11 += weight * ny * ny; q.a22 += weight * nz * nz;
+    q.a10 += weight * ny * nx; q.a20 += weight * nz * nx; q.a21 += weight * nz * ny;
+    q.b0 += weight * nx * d; q.b1 += weight * ny * d; q.b2 += weight * nz * d;
+    q.c += weight * d * d;
+}
+
+void MeshSimplifier::AddQuadric(Quadric& q, const Quadric& r)
+{
+    q.a00 += r.a00; q.a11 += r.a11; q.a22 += r.a22;
+    q.a10 += r.a10; q.a20 += r.a20; q.a21 += r.a21;
+    q.b0 += r.b0; q.b1 += r.b1; q.b2 += r.b2;
+    q.c += r.c;
+    q.weight += r.weight;
+}
+
+float MeshSimplifier::EvaluateQuadric(const Quadric& q, const XMFLOAT3& p)
+{
+    const float rx = q.a00 * p.x + q.a10 * p.y + q.a20 * p.z + 2.0f * q.b0;
+    const float ry = q.a10 * p.x + q.a11 * p.y + q.a21 * p.z + 2.0f * q.b1;
+    const float rz = q.a20 * p.x + q.a21 * p.y + q.a22 * p.z + 2.0f * q.b2;
+    return rx * p.x + ry * p.y + rz * p.z + q.c;
+}
+
+// ============================================================================
+// CONSOLE INTEGRATION
+// ============================================================================
+
+namespace
+{
+    struct BenchVertex
+    {
+        float position[3];
+        float normal[3];
+        float texCoord[2];
+    };
+
+    const float BenchWeights[5] = { 0.5f, 0.5f, 0.5f, 1.0f, 1.0f };
+
+    struct BenchMesh
+    {
+        std::string name;
+        std::vector<BenchVertex> vertices;
+        std::vector<uint32_t> indices;
+
+        SimplifierMesh View() const
+        {
+            SimplifierMesh mesh;
+            mesh.positions = vertices[0].position;
+            mesh.positionStride = sizeof(BenchVertex);
+            mesh.attributes = vertices[0].normal;
+            mesh.attributeStride = sizeof(BenchVertex);
+            mesh.attributeCount = 5;
+            mesh.attributeWeights = BenchWeights;
+            mesh.vertexCount = vertices.size();
+            mesh.indices = indices.data();
+            mesh.indexCount = indices.size();
+            return mesh;
+        }
+    };
+
+    // Square of cells on [0, 1] in x and z, with random heights and texture coordinates following x and z
+    BenchMesh MakeGrid(uint32_t cells, float noise, uint32_t seed)
+    {
+        BenchMesh mesh;
+        mesh.name = "grid";
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> height(-noise, noise);
+        for (uint32_t z = 0; z <= cells; ++z) {
+            for (uint32_t x = 0; x <= cells; ++x) {
+                const float u = float(x) / cells, v = float(z) / cells;
+                mesh.vertices.push_back({ { u, noise > 0.0f ? height(rng) : 0.0f, v }, { 0.0f, 1.0f, 0.0f }, { u, v } });
+            }
+        }
+        for (uint32_t z = 0; z < cells; ++z) {
+            for (uint32_t x = 0; x < cells; ++x) {
+                const uint32_t i = z * (cells + 1) + x;
+                mesh.indices.insert(mesh.indices.end(), { i, i + cells + 1, i + 1, i + 1, i + cells + 1, i + cells + 2 });
+            }
+        }
+        return mesh;
+    }
+
+    // Unit sphere with a texture seam at u = 0 and a wedge per slice at each pole
+    BenchMesh MakeSphere(uint32_t stacks, uint32_t slices)
+    {
+        BenchMesh mesh;
+        mesh.name = "sphere";
+        const float pi = 3.14159265f;
+        for (uint32_t s = 0; s <= stacks; ++s) {
+            const float v = float(s) / stacks, theta = v * pi;
+            for (uint32_t l = 0; l <= slices; ++l) {
+                const float u = float(l) / slices, phi = u * 2.0f * pi;
+                float p[3] = { std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) };
+                if (s == 0 || s == stacks) p[0] = p[2] = 0.0f;
+                if (l == slices) { p[0] = mesh.vertices[s * (slices + 1)].position[0]; p[2] = mesh.vertices[s * (slices + 1)].position[2]; }
+                mesh.vertices.push_back({ { p[0], p[1], p[2] }, { p[0], p[1], p[2] }, { u, v } });
+            }
+        }
+        for (uint32_t s = 0; s < stacks; ++s) {
+            for (uint32_t l = 0; l < slices; ++l) {
+                const uint32_t i = s * (slices + 1) + l, j = i + slices + 1;
+                if (s > 0) mesh.indices.insert(mesh.indices.end(), { i, i + 1, j });
+                if (s + 1 < stacks) mesh.indices.insert(mesh.indices.end(), { i + 1, j + 1, j });
+            }
+        }
+        return mesh;
+    }
+
+    // Cube with a separate vertex per face corner, so every corner is a hard edge
+    BenchMesh MakeCube()
+    {
+        BenchMesh mesh;
+        mesh.name = "cube";
+        const float axes[6][3] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+        for (uint32_t f = 0; f < 6; ++f) {
+            const float* n = axes[f];
+            const float t[3] = { n[1] != 0.0f ? 1.0f : 0.0f, n[1] != 0.0f ? 0.0f : 1.0f, 0.0f };
+            const float b[3] = { n[1] * t[2] - n[2] * t[1], n[2] * t[0] - n[0] * t[2], n[0] * t[1] - n[1] * t[0] };
+            const uint32_t first = static_cast<uint32_t>(mesh.vertices.size());
+            for (uint32_t c = 0; c < 4; ++c) {
+                const float su = (c == 1 || c == 2) ? 1.0f : -1.0f, sv = c >= 2 ? 1.0f : -1.0f;
+                mesh.vertices.push_back({ { n[0] + su * t[0] + sv * b[0], n[1] + su * t[1] + sv * b[1], n[2] + su * t[2] + sv * b[2] },
+                                          { n[0], n[1], n[2] }, { su * 0.5f + 0.5f, sv * 0.5f + 0.5f } });
+            }
+            mesh.indices.insert(mesh.indices.end(), { first, first + 2, first + 1, first, first + 3, first + 2 });
+        }
+        return mesh;
+    }
+
+    // Triangles unwelded, one vertex per corner, the way Mesh::LoadFromFile reads them
+    bool LoadObjMesh(const std::filesystem::path& path, BenchMesh& mesh)
+    {
+        tinyobj::ObjReader reader;
+        tinyobj::ObjReaderConfig config;
+        config.mtl_search_path = path.parent_path().string();
+        if (!reader.ParseFromFile(path.string(), config)) return false;
+
+        const tinyobj::attrib_t& attrib = reader.GetAttrib();
+        mesh.name = path.filename().string();
+        for (const tinyobj::shape_t& shape : reader.GetShapes()) {
+            for (const tinyobj::index_t& index : shape.mesh.indices) {
+                BenchVertex v{ { attrib.vertices[3 * index.vertex_index], attrib.vertices[3 * index.vertex_index + 1],
+                                 attrib.vertices[3 * index.vertex_index + 2] }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f } };
+                if (index.normal_index >= 0) {
+                    for (int k = 0; k < 3; ++k) v.normal[k] = attrib.normals[3 * index.normal_index + k];
+                }
+                if (index.texcoord_index >= 0) {
+                    v.texCoord[0] = attrib.texcoords[2 * index.texcoord_index];
+                    v.texCoord[1] = 1.0f - attrib.texcoords[2 * index.texcoord_index + 1];
+                }
+                mesh.indices.push_back(static_cast<uint32_t>(mesh.vertices.size()));
+                mesh.vertices.push_back(v);
+            }
+        }
+        return mesh.indices.size() >= 3;
+    }
+
+    XMFLOAT3 PositionOf(const BenchMesh& mesh, uint32_t index)
+    {
+        const float* p = mesh.vertices[index].position;
+        return { p[0], p[1], p[2] };
+    }
+
+    // Closest point on a triangle (Ericson, Real-Time Collision Detection 5.1.5), returned as a distance
+    float PointTriangleDistance(const XMFLOAT3& p, const XMFLOAT3& a, const XMFLOAT3& b, const XMFLOAT3& c)
+    {
+        auto distance = [&](const XMFLOAT3& q) { const XMFLOAT3 d = Subtract(p, q); return std::sqrt(Dot(d, d)); };
+        auto along = [](const XMFLOAT3& o, const XMFLOAT3& e, float t) { return XMFLOAT3{ o.x + e.x * t, o.y + e.y * t, o.z + e.z * t }; };
+
+        const XMFLOAT3 ab = Subtract(b, a), ac = Subtract(c, a), ap = Subtract(p, a);
+        const float d1 = Dot(ab, ap), d2 = Dot(ac, ap);
+        if (d1 <= 0.0f && d2 <= 0.0f) return distance(a);
+        const XMFLOAT3 bp = Subtract(p, b);
+        const float d3 = Dot(ab, bp), d4 = Dot(ac, bp);
+        if (d3 >= 0.0f && d4 <= d3) return distance(b);
+        const float vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return distance(along(a, ab, d1 / (d1 - d3)));
+        const XMFLOAT3 cp = Subtract(p, c);
+        const float d5 = Dot(ab, cp), d6 = Dot(ac, cp);
+        if (d6 >= 0.0f && d5 <= d6) return distance(c);
+        const float vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return distance(along(a, ac, d2 / (d2 - d6)));
+        const float va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) return distance(along(b, Subtract(c, b), (d4 - d3) / ((d4 - d3) + (d5 - d6))));
+        const float denominator = 1.0f / (va + vb + vc);
+        const XMFLOAT3 q = along(along(a, ab, vb * denominator), ac, vc * denominator);
+        return distance(q);
+    }
+
+    // Largest distance from sampled vertices of the full mesh to a simplified surface, relative to the bounding radius
+    float MeasureDeviation(const BenchMesh& mesh, const uint32_t* indices, size_t count, float radius)
+    {
+        const size_t step = std::max<size_t>(1, mesh.vertices.size() / 1500);
+        float worst = 0.0f;
+        for (size_t v = 0; v < mesh.vertices.size(); v += step) {
+            const XMFLOAT3 p = PositionOf(mesh, static_cast<uint32_t>(v));
+            float nearest = FLT_MAX;
+            for (size_t i = 0; i < count && nearest > 0.0f; i += 3) {
+                nearest = std::min(nearest, PointTriangleDistance(p, PositionOf(mesh, indices[i]), PositionOf(mesh, indices[i + 1]),
+                                                                  PositionOf(mesh, indices[i + 2])));
+            }
+            worst = std::max(worst, nearest);
+        }
+        return worst / radius;
+    }
+
+    // Directed edges, by position, that no triangle uses the other way round
+    std::vector<std::pair<uint32_t, uint32_t>> FindOpenEdges(const BenchMesh& mesh, const uint32_t* indices, size_t count)
+    {
+        std::map<std::tuple<float, float, float>, uint32_t> ids;
+        auto idOf = [&](uint32_t v) {
+            const float* p = mesh.vertices[v].position;
+            return ids.emplace(std::make_tuple(p[0], p[1], p[2]), static_cast<uint32_t>(ids.size())).first->second;
+        };
+
+        struct EdgeUse { int count = 0; uint32_t from = 0, to = 0; };
+        std::map<std::pair<uint32_t, uint32_t>, EdgeUse> edges;
+        for (size_t i = 0; i < count; i += 3) {
+            for (size_t j = 0; j < 3; ++j) {
+                const uint32_t from = indices[i + j], to = indices[i + (j + 1) % 3];
+                EdgeUse& use = edges[{ idOf(from), idOf(to) }];
+                use.count++;
+                use.from = from;
+                use.to = to;
+            }
+        }
+
+        std::vector<std::pair<uint32_t, uint32_t>> open;
+        for (const auto& [key, use] : edges) {
+            const auto reverse = edges.find({ key.second, key.first });
+            if (use.count > (reverse == edges.end() ? 0 : reverse->second.count)) open.push_back({ use.from, use.to });
+        }
+        return open;
+    }
+}
+
+std::string MeshSimplifier::Console_Benchmark(const std::string& directory)
+{
+    MeshSimplifier simplifier;
+    const MeshLodSettings settings;
+    std::vector<uint32_t> result;
+
+    // A flat textured grid has no error to give: it must fall to two triangles and keep its corners
+    const BenchMesh plane = MakeGrid(32, 0.0f, 1);
+    const float planeError = simplifier.Simplify(plane.View(), 6, 0.001f, result);
+    uint32_t corners = 0;
+    for (uint32_t index : result) {
+        const float* p = plane.vertices[index].position;
+        if ((p[0] == 0.0f || p[0] == 1.0f) && (p[2] == 0.0f || p[2] == 1.0f)) corners++;
+    }
+    const size_t planeTriangles = result.size() / 3;
+    const bool planeOk = result.size() == 6 && planeError < 1e-3f && corners == 6;
+
+    // Sphere chain: each level within its threshold, checked against the measured distance,
+    // still closed, and no triangle stretched across the texture seam
+    const BenchMesh sphere = MakeSphere(48, 96);
+    std::vector<uint32_t> lodIndices;
+    std::vector<MeshLodLevel> levels;
+    simplifier.BuildLodChain(sphere.View(), settings, lodIndices, levels);
+    std::vector<uint32_t> combined = sphere.indices;
+    combined.insert(combined.end(), lodIndices.begin(), lodIndices.end());
+
+    const float sphereRadius = GetBoundingRadius(sphere.View());
+    std::vector<float> deviations(levels.size(), 0.0f);
+    uint32_t boundFaults = 0, openEdges = 0, seamFaults = 0;
+    for (size_t i = 1; i < levels.size(); ++i) {
+        const MeshLodLevel& level = levels[i];
+        const uint32_t* indices = combined.data() + level.firstIndex;
+        if (level.indexCount >= levels[i - 1].indexCount || level.error > settings.errorThresholds.back()) boundFaults++;
+        deviations[i] = MeasureDeviation(sphere, indices, level.indexCount, sphereRadius);
+        if (deviations[i] > 1.5f * level.error + 1e-4f) boundFaults++;
+        openEdges += static_cast<uint32_t>(FindOpenEdges(sphere, indices, level.indexCount).size());
+        for (uint32_t t = 0; t < level.indexCount; t += 3) {
+            const float u0 = sphere.vertices[indices[t]].texCoord[0], u1 = sphere.vertices[indices[t + 1]].texCoord[0],
+                        u2 = sphere.vertices[indices[t + 2]].texCoord[0];
+            if (std::max({ u0, u1, u2 }) - std::min({ u0, u1, u2 }) > 0.5f) seamFaults++;
+        }
+    }
+    const bool sphereOk = levels.size() >= 4 && boundFaults == 0 && openEdges == 0 && seamFaults == 0;
+    const std::vector<MeshLodLevel> sphereLevels = levels;
+
+    // Cache: the sphere chain survives a round trip, and is refused for other geometry or once cut short
+    std::error_code cacheError;
+    const std::filesystem::path cachePath = std::filesystem::temp_directory_path(cacheError) / "spark_lod_bench.obj.lod";
+    std::vector<uint32_t> cachedIndices;
+    std::vector<MeshLodLevel> cachedLevels;
+    bool cacheOk = SaveLodCache(cachePath, sphere.View(), lodIndices, levels) &&
+                   LoadLodCache(cachePath, sphere.View(), cachedIndices, cachedLevels) && cachedIndices == lodIndices &&
+                   cachedLevels.size() == levels.size();
+    for (size_t i = 0; cacheOk && i < levels.size(); ++i) {
+        cacheOk = cachedLevels[i].firstIndex == levels[i].firstIndex && cachedLevels[i].indexCount == levels[i].indexCount &&
+                  cachedLevels[i].error == levels[i].error;
+    }
+    const BenchMesh otherSphere = MakeSphere(48, 95);
+    cacheOk = cacheOk && !LoadLodCache(cachePath, otherSphere.View(), cachedIndices, cachedLevels) && cachedLevels.empty();
+    std::filesystem::resize_file(cachePath, std::filesystem::file_size(cachePath, cacheError) - sizeof(uint32_t), cacheError);
+    cacheOk = cacheOk && !cacheError && !LoadLodCache(cachePath, sphere.View(), cachedIndices, cachedLevels);
+    std::filesystem::remove(cachePath, cacheError);
+    const size_t lodIndexBytes = lodIndices.size() * sizeof(uint32_t);
+
+    // Noisy terrain patch: open edges may only join vertices of the original border (corners may
+    // be cut within the error), so no hole opens inside, and locked borders keep every border edge
+    const BenchMesh terrain = MakeGrid(64, 0.003f, 7);
+    auto onBorder = [](const float* p) { return p[0] == 0.0f || p[0] == 1.0f || p[2] == 0.0f || p[2] == 1.0f; };
+    simplifier.Simplify(terrain.View(), terrain.indices.size() / 10, 0.1f, result);
+    const size_t terrainIndices = result.size();
+    uint32_t borderFaults = 0;
+    for (const auto& [from, to] : FindOpenEdges(terrain, result.data(), result.size())) {
+        if (!onBorder(terrain.vertices[from].position) || !onBorder(terrain.vertices[to].position)) borderFaults++;
+    }
+
+    // Seen from above, triangles folded over by a collapse cover ground twice
+    float coveredArea = 0.0f, signedArea = 0.0f;
+    for (size_t i = 0; i < result.size(); i += 3) {
+        const XMFLOAT3 a = PositionOf(terrain, result[i]);
+        const float up = 0.5f * Cross(Subtract(PositionOf(terrain, result[i + 1]), a), Subtract(PositionOf(terrain, result[i + 2]), a)).y;
+        coveredArea += std::fabs(up);
+        signedArea += up;
+    }
+    const float foldedArea = 0.5f * (coveredArea - signedArea);
+    simplifier.Simplify(terrain.View(), terrain.indices.size() / 10, 0.1f, result, true);
+    const size_t lockedIndices = result.size();
+    const size_t lockedOpen = FindOpenEdges(terrain, result.data(), result.size()).size();
+    const bool terrainOk = borderFaults == 0 && foldedArea < 0.0025f && terrainIndices < terrain.indices.size() / 4 && lockedOpen == 4 * 64;
+
+    // Hard-edged cube: every corner is a junction of three wedges, so nothing may move
+    const BenchMesh cube = MakeCube();
+    simplifier.Simplify(cube.View(), 0, 1.0f, result);
+    const size_t cubeTriangles = result.size() / 3;
+    const bool cubeOk = result.size() == cube.indices.size();
+
+    // Selection: sweep the screen size down and back up, then jitter it at every switch point
+    const MeshLodLevel selectLevels[5] = { { 0, 0, 0.0f }, { 0, 0, 0.01f }, { 0, 0, 0.02f }, { 0, 0, 0.04f }, { 0, 0, 0.08f } };
+    uint32_t lod = 0, switches = 0, overBudget = 0, reversals = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int step = 0; step < 300; ++step) {
+            const float radius = 400.0f * std::pow(0.98f, float(pass == 0 ? step : 299 - step));
+            const uint32_t next = SelectLod(selectLevels, 5, radius, lod, 1.0f);
+            if (selectLevels[next].error * radius > 1.0f) overBudget++;
+            if (pass == 0 ? next < lod : next > lod) reversals++;
+            if (next != lod) switches++;
+            lod = next;
+        }
+    }
+    uint32_t flickers = 0, flickersWithout = 0;
+    for (uint32_t i = 1; i < 5; ++i) {
+        for (float limit : { 0.75f, 1.0f }) {
+            const float center = limit / selectLevels[i].error;
+            uint32_t held = SelectLod(selectLevels, 5, center, 0, 1.0f), bare = SelectLod(selectLevels, 5, center, 0, 1.0f, 0.0f);
+            for (uint32_t frame = 0; frame < 50; ++frame) {
+                const float radius = center * (1.0f + 0.04f * std::sin(frame * 0.7f));
+                const uint32_t next = SelectLod(selectLevels, 5, radius, held, 1.0f);
+                const uint32_t nextBare = SelectLod(selectLevels, 5, radius, bare, 1.0f, 0.0f);
+                if (next != held) flickers++;
+                if (nextBare != bare) flickersWithout++;
+                held = next;
+                bare = nextBare;
+            }
+        }
+    }
+    const bool selectionOk = overBudget == 0 && reversals == 0 && switches == 8 && flickers <= 8;
+
+    // Throughput on the models directory, or on generated meshes when it has none
+    std::vector<BenchMesh> models;
+    std::error_code ec;
+    if (std::filesystem::is_directory(directory, ec)) {
+        for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+            std::string extension = entry.path().extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+            BenchMesh model;
+            if (extension == ".obj" && LoadObjMesh(entry.path(), model)) models.push_back(std::move(model));
+        }
+    }
+    const bool generated = models.empty();
+    if (generated) {
+        models.push_back(MakeSphere(128, 256));
+        models.push_back(MakeGrid(256, 0.01f, 3));
+        models.back().name = "terrain";
+    }
+
+    std::stringstream rows;
+    rows << std::fixed;
+    double totalTriangles = 0.0, totalSeconds = 0.0;
+    for (const BenchMesh& model : models) {
+        const SimplifierMesh view = model.View();
+        auto start = std::chrono::high_resolution_clock::now();
+        const float error = simplifier.Simplify(view, model.indices.size() / 4, 1.0f, result);
+        const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+        start = std::chrono::high_resolution_clock::now();
+        simplifier.BuildLodChain(view, settings, lodIndices, levels);
+        const double chainMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+        const size_t triangles = model.indices.size() / 3;
+        totalTriangles += double(triangles);
+        totalSeconds += seconds;
+        rows << "  " << model.name << ": " << triangles << " -> " << result.size() / 3 << " triangles in " << std::setprecision(2)
+             << seconds * 1000.0 << " ms (" << double(triangles) / seconds / 1e6 << " M/s, error " << std::setprecision(4) << error
+             << "), " << levels.size() << " LODs in " << std::setprecision(2) << chainMs << " ms:";
+        for (const MeshLodLevel& level : levels) rows << " " << level.indexCount / 3;
+        rows << "\n";
+    }
+
+    const bool passed = planeOk && sphereOk && terrainOk && cubeOk && selectionOk && cacheOk;
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(4);
+    ss << "=== Mesh Simplifier Benchmark ===\n";
+    ss << "Plane:        " << plane.indices.size() / 3 << " -> " << planeTriangles << " triangles, error " << planeError << ", corners "
+       << (corners == 6 ? "kept" : "MOVED") << "\n";
+    ss << "Sphere:       " << sphere.indices.size() / 3 << " triangles, " << sphereLevels.size() << " levels, " << boundFaults
+       << " bound faults, " << openEdges << " open edges, " << seamFaults << " triangles across the seam\n";
+    for (size_t i = 1; i < sphereLevels.size(); ++i) {
+        ss << "  LOD " << i << ": " << sphereLevels[i].indexCount / 3 << " triangles, error " << sphereLevels[i].error << ", measured "
+           << deviations[i] << "\n";
+    }
+    ss << "Terrain:      " << terrain.indices.size() / 3 << " -> " << terrainIndices / 3 << " triangles, " << borderFaults
+       << " open edges inside, " << std::setprecision(2) << foldedArea * 100.0f
+       << "% of the area folded over; locked borders " << lockedIndices / 3 << " triangles, " << lockedOpen << " of " << 4 * 64
+       << " border edges\n";
+    ss << "Cube:         " << cubeTriangles << " of 12 triangles kept\n";
+    ss << "Cache:        " << sphereLevels.size() << " levels, " << lodIndexBytes << " bytes of LOD indices, "
+       << (cacheOk ? "round trip exact, other geometry and truncated file refused" : "FAILED") << "\n";
+    ss << "Selection:    " << switches << " switches over a zoom out and back, " << flickers << " while jittering at the 8 switch points ("
+       << flickersWithout << " without hysteresis)\n";
+    ss << "Throughput:   " << (generated ? "no .obj models in '" + directory + "', generated meshes" : directory) << ", "
+       << std::setprecision(2) << totalTriangles / totalSeconds / 1e6 << " M triangles/s to a quarter\n";
+    ss << rows.str();
+    ss << "Checks:       plane " << (planeOk ? "ok" : "FAILED") << ", error bounds " << (sphereOk ? "ok" : "FAILED") << ", borders "
+       << (terrainOk ? "ok" : "FAILED") << ", hard edges " << (cubeOk ? "ok" : "FAILED") << ", selection "
+       << (selectionOk ? "ok" : "FAILED") << ", cache " << (cacheOk ? "ok" : "FAILED") << " (" << (passed ? "passed" : "FAILED")
+       << ")\n";
+    return ss.str();
+}
+
+uint32_t MeshSimplifier::BakeObjLods(const std::filesystem::path& objPath, const MeshLodSettings& settings)
+{
+    BenchMesh model;
+    if (!LoadObjMesh(objPath, model)) return 0;
+
+    const float weights[5] = { settings.normalWeight, settings.normalWeight, settings.normalWeight,
+                               settings.texCoordWeight, settings.texCoordWeight };
+    SimplifierMesh view = model.View();
+    view.attributeWeights = weights;
+
+    std::vector<uint32_t> lodIndices;
+    std::vector<MeshLodLevel> levels;
+    BuildLodChain(view, settings, lodIndices, levels);
+    return SaveLodCache(GetLodCachePath(objPath), view, lodIndices, levels) ? static_cast<uint32_t>(levels.size()) : 0u;
+}
+
+std::string MeshSimplifier::Console_BakeLods(const std::string& directory, const MeshLodSettings& settings)
+{
+    std::error_code ec;
+    if (!std::filesystem::is_directory(directory, ec)) return "Not a directory: " + directory;
+
+    MeshSimplifier simplifier;
+    std::stringstream rows;
+    rows << std::fixed << std::setprecision(2);
+    uint32_t models = 0, baked = 0;
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        std::string extension = entry.path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+        if (extension != ".obj") continue;
+
+        models++;
+        const auto modelStart = std::chrono::high_resolution_clock::now();
+        const uint32_t levels = simplifier.BakeObjLods(entry.path(), settings);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - modelStart).count();
+        if (levels > 0) baked++;
+        rows << "  " << entry.path().filename().string() << ": "
+             << (levels > 0 ? std::to_string(levels) + " levels" : std::string("FAILED")) << " in " << ms << " ms\n";
+    }
+    const double totalMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    ss << "Baked LOD caches for " << baked << " of " << models << " .obj models in '" << directory << "' in " << totalMs << " ms\n";
+    ss << rows.str();
+    return ss.str();
+}
@@ -0,0 +1,253 @@
+/**
+ * @file MeshSimplifier.h
+ * @brief Quadric error mesh simplification, LOD chains and screen-size LOD selection
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * The simplifier collapses edges in order of quadric error (Garland-Heckbert)
+ * until a triangle count or an error limit is reached. Every collapse moves a
+ * vertex onto one of its neighbours, so a simplified mesh is a new index list
+ * over the original vertices: attributes are never interpolated, and all
+ * levels of a mesh share one vertex buffer.
+ *
+ * Attributes take part through attribute quadrics (Hoppe): a collapse that
+ * would distort normals or texture coordinates across the surface costs as
+ * much as moving the surface. Vertices on an attribute seam may only slide
+ * along the seam, together with their twin on the other side, and vertices on
+ * an open border only along the border; corners and anything non-manifold
+ * stay where they are. Errors are fractions of the mesh's bounding radius.
+ *
+ * Chains are built offline: BakeObjLods() writes one next to the model as a
+ * .lod cache, keyed by the model's positions and indices, and Mesh reads it
+ * when it loads the model. A cache baked from other geometry is ignored.
+ *
+ * Everything here is plain CPU code with no graphics API, so it runs and
+ * benchmarks headless; Mesh and the asset pipeline upload the results.
+ */
+
+#pragma once
+
+#include "Utils/Assert.h"
+#include <DirectXMath.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Vertex and index data to simplify; positions and attributes are read through strides
+ */
+struct SimplifierMesh
+{
+    static constexpr uint32_t MaxAttributes = 8;
+
+    const float* positions = nullptr;           ///< x, y, z of vertex 0
+    size_t positionStride = 0;                  ///< Bytes from one position to the next
+    const float* attributes = nullptr;          ///< First attribute float of vertex 0, or null
+    size_t attributeStride = 0;                 ///< Bytes from one vertex's attributes to the next
+    uint32_t attributeCount = 0;                ///< Consecutive floats per vertex, at most MaxAttributes
+    const float* attributeWeights = nullptr;    ///< Error weight of each attribute float; null weighs them all 1
+    size_t vertexCount = 0;
+    const uint32_t* indices = nullptr;          ///< Triangle list
+    size_t indexCount = 0;
+};
+
+/**
+ * @brief One level of a LOD chain: a range of the combined index list
+ */
+struct MeshLodLevel
+{
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    float error = 0.0f;                 ///< Deviation from the full mesh, as a fraction of its bounding radius
+};
+
+/**
+ * @brief How LOD chains are built
+ */
+struct MeshLodSettings
+{
+    static constexpr uint32_t MaxLevels = 8;
+
+    std::vector<float> errorThresholds = { 0.005f, 0.01f, 0.02f, 0.04f, 0.08f };   ///< One level per threshold, ascending
+    float minReduction = 0.2f;          ///< A level must drop at least this fraction of the previous level's triangles
+    uint32_t minTriangles = 256;        ///< Meshes with fewer triangles keep a single level
+    float normalWeight = 0.5f;          ///< Error weight of normals in the engine's vertex formats
+    float texCoordWeight = 1.0f;        ///< Error weight of texture coordinates
+    bool lockBorders = false;           ///< Keep every open-border vertex, e.g. for meshes that tile with neighbours
+};
+
+/**
+ * @brief Edge-collapse simplifier; keeps its scratch memory between calls, one thread per instance
+ */
+class MeshSimplifier
+{
+public:
+    static constexpr float DefaultHysteresis = 0.25f;
+
+    /**
+     * @brief Simplify towards a triangle count without exceeding an error
+     * @param targetIndexCount Stop once the mesh has at most this many indices
+     * @param targetError Largest error allowed, as a fraction of the bounding radius
+     * @param result Receives the simplified triangle list, indexing the original vertices
+     * @param lockBorders Keep every vertex on an open border
+     * @return Largest error of the collapses made
+     */
+    float Simplify(const SimplifierMesh& mesh, size_t targetIndexCount, float targetError, std::vector<uint32_t>& result,
+                   bool lockBorders = false);
+
+    /**
+     * @brief Build one level per error threshold, each within its threshold of the full mesh
+     * @param lodIndices Receives the indices of levels 1 and up, back to back
+     * @param levels Receives every level; level 0 is the mesh itself, the others start at
+     *        mesh.indexCount, as if lodIndices followed the mesh's own indices in one buffer
+     *
+     * Levels that do not remove at least minReduction of the previous level's
+     * triangles are skipped.
+     */
+    void BuildLodChain(const SimplifierMesh& mesh, const MeshLodSettings& settings, std::vector<uint32_t>& lodIndices,
+                       std::vector<MeshLodLevel>& levels);
+
+    /**
+     * @brief Coarsest level whose error stays under a pixel limit at the object's projected size
+     * @param screenRadius Radius of the object's bounding sphere on screen, in pixels
+     * @param currentLod Level drawn last frame; moving to a coarser level needs the error
+     *        to fall @p hysteresis below the limit, so objects near a boundary do not flicker
+     */
+    static uint32_t SelectLod(const MeshLodLevel* levels, uint32_t levelCount, float screenRadius, uint32_t currentLod,
+                              float pixelError, float hysteresis = DefaultHysteresis);
+
+    /**
+     * @brief Bounding radius the errors are relative to: half the diagonal of the vertex bounds
+     */
+    static float GetBoundingRadius(const SimplifierMesh& mesh);
+
+    // ========================================================================
+    // LOD CACHE
+    // ========================================================================
+
+    /**
+     * @brief Where the chain of a model is cached: the model path with ".lod" appended
+     */
+    static std::filesystem::path GetLodCachePath(const std::filesystem::path& modelPath);
+
+    /**
+     * @brief Write a chain built by BuildLodChain(), keyed by the mesh's positions and indices
+     */
+    static bool SaveLodCache(const std::filesystem::path& path, const SimplifierMesh& mesh,
+                             const std::vector<uint32_t>& lodIndices, const std::vector<MeshLodLevel>& levels);
+
+    /**
+     * @brief Read a chain written by SaveLodCache()
+     * @return false, with both outputs cleared, if the file is missing or damaged or was baked from other geometry
+     */
+    static bool LoadLodCache(const std::filesystem::path& path, const SimplifierMesh& mesh,
+                             std::vector<uint32_t>& lodIndices, std::vector<MeshLodLevel>& levels);
+
+    /**
+     * @brief Build the chain of an .obj model, read the way Mesh::LoadFromFile reads it, and cache it beside the model
+     * @return Levels written including the full mesh, or 0 if the model could not be read or the cache written
+     */
+    uint32_t BakeObjLods(const std::filesystem::path& objPath, const MeshLodSettings& settings);
+
+    // ========================================================================
+    // CONSOLE INTEGRATION
+    // ========================================================================
+
+    /**
+     * @brief Check error bounds, seams, borders, LOD selection and the cache on generated meshes,
+     *        then time simplification of every .obj model in a directory
+     */
+    static std::string Console_Benchmark(const std::string& directory);
+
+    /**
+     * @brief Bake the LOD cache of every .obj model in a directory
+     */
+    static std::string Console_BakeLods(const std::string& directory, const MeshLodSettings& settings);
+
+private:
+    enum VertexKind : uint8_t
+    {
+        KindManifold,       ///< Interior vertex: collapses anywhere
+        KindBorder,         ///< On one open border: collapses along it
+        KindSeam,           ///< On one attribute seam with a twin: collapses along the seam with the twin
+        KindLocked          ///< Corner, junction or non-manifold: never moves
+    };
+
+    /**
+     * @brief Plane distance quadric; error(p) = (p'Ap + 2b'p + c) / weight
+     */
+    struct Quadric
+    {
+        float a00 = 0, a11 = 0, a22 = 0, a10 = 0, a20 = 0, a21 = 0;
+        float b0 = 0, b1 = 0, b2 = 0, c = 0;
+        float weight = 0;
+    };
+
+    /**
+     * @brief Part of an attribute quadric that depends on the target attribute value
+     */
+    struct QuadricGradient
+    {
+        float gx = 0, gy = 0, gz = 0, gw = 0;
+    };
+
+    struct Collapse
+    {
+        uint32_t v0;
+        uint32_t v1;
+        float error;
+    };
+
+    void Prepare(const SimplifierMesh& mesh, bool lockBorders, std::vector<uint32_t>& indices);
+    void BuildAdjacency(const std::vector<uint32_t>& indices);
+    bool HasEdge(uint32_t a, uint32_t b) const;
+    bool HasPositionEdge(uint32_t a, uint32_t b) const;
+    void ClassifyVertices(bool lockBorders);
+    void FillQuadrics(const std::vector<uint32_t>& indices);
+    bool CanCollapse(uint32_t v0, uint32_t v1) const;
+    uint32_t SeamTarget(uint32_t v0, uint32_t v1) const;
+    float CollapseError(uint32_t v0, uint32_t v1) const;
+    float AttributeError(uint32_t vertex, const DirectX::XMFLOAT3& position, uint32_t target) const;
+    bool HasTriangleFlip(uint32_t v0, uint32_t v1) const;
+    size_t RunPass(std::vector<uint32_t>& indices, size_t targetIndexCount, float errorLimit, float& resultError);
+    void SortCollapses();
+
+    static void AddPlane(Quadric& q, float nx, float ny, float nz, float d, float weight);
+    static void AddQuadric(Quadric& q, const Quadric& r);
+    static float EvaluateQuadric(const Quadric& q, const DirectX::XMFLOAT3& p);
+    static void RemapEdgeLoops(std::vector<uint32_t>& loops, const std::vector<uint32_t>& remap, std::vector<uint32_t>& scratch);
+    static uint64_t HashLodSource(const SimplifierMesh& mesh);
+
+    // Per input vertex
+    std::vector<DirectX::XMFLOAT3> m_positions; ///< Centered and divided by the bounding radius
+    std::vector<float> m_attributes;            ///< Multiplied by the square roots of the weights
+    std::vector<uint32_t> m_vertexRemap;        ///< First vertex with identical position and attributes
+    std::vector<uint32_t> m_positionRemap;      ///< First vertex with the same position
+    std::vector<uint32_t> m_wedge;              ///< Next vertex with the same position, circular
+    std::vector<uint8_t> m_kind;
+    std::vector<uint32_t> m_openOut;            ///< Target of the vertex's only open edge out, or a marker for none or several
+    std::vector<uint32_t> m_openIn;             ///< Source of the vertex's only open edge in
+    std::vector<Quadric> m_positionQuadrics;    ///< Indexed by position (m_positionRemap)
+    std::vector<Quadric> m_attributeQuadrics;   ///< Indexed by vertex
+    std::vector<QuadricGradient> m_gradients;   ///< m_attributeCount per vertex
+    uint32_t m_attributeCount = 0;
+
+    // Vertex-space edges (CSR) and position-space triangle lists, rebuilt as the mesh shrinks
+    std::vector<uint32_t> m_edgeOffsets;
+    std::vector<uint32_t> m_edgeTargets;
+    std::vector<uint32_t> m_triangleOffsets;
+    std::vector<uint32_t> m_triangles;
+    const std::vector<uint32_t>* m_currentIndices = nullptr;
+
+    // Per pass
+    std::vector<Collapse> m_collapses;
+    std::vector<Collapse> m_sortedCollapses;
+    std::vector<uint32_t> m_histogram;
+    std::vector<uint32_t> m_collapseRemap;
+    std::vector<uint8_t> m_collapseLocked;
+
+    std::vector<uint32_t> m_order;
+    std::vector<uint32_t> m_chainScratch;
+};
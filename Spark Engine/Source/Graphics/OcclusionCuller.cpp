@@ -0,0 +1,673 @@
+/**
+ * @file OcclusionCuller.cpp
+ * @brief Implementation of the masked software occlusion rasteriser
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * The span kernel is written twice, once with SSE and once with plain
+ * floats, evaluating the same expressions in the same order so both fill the
+ * buffer identically; the benchmark checks this.
+ */
+
+#include "OcclusionCuller.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define SPARK_OCCLUSION_SSE 1
+#endif
+
+using namespace DirectX;
+
+namespace
+{
+    constexpr uint32_t FullRow = 0xFFFFFFFFu;
+    constexpr float DepthBias = 1e-6f;      ///< Pushes rasterised depth back to absorb rounding in the depth plane
+    constexpr float GuardBand = 4.0f;       ///< Triangles are clipped to this many half-screens around the centre
+    constexpr int SpanChunk = 64;           ///< Rows whose spans are computed per kernel call
+
+    /**
+     * @brief Non-horizontal triangle edge as x(y) = x0 + (y - y0) * invSlope
+     */
+    struct SpanEdge
+    {
+        float x0, y0, invSlope;
+        bool left;              ///< Pixels right of the edge are inside
+    };
+
+    void ComputeSpansScalar(const SpanEdge* edges, int edgeCount, float minX, float maxX, int rowBegin, int rowCount,
+                            float* left, float* right)
+    {
+        for (int i = 0; i < rowCount; ++i) {
+            const float y = static_cast<float>(rowBegin + i) + 0.5f;
+            float l = minX, r = maxX;
+            for (int e = 0; e < edgeCount; ++e) {
+                const float x = edges[e].x0 + (y - edges[e].y0) * edges[e].invSlope;
+                if (edges[e].left) l = std::max(l, x);
+                else r = std::min(r, x);
+            }
+            left[i] = l;
+            right[i] = r;
+        }
+    }
+
+#if SPARK_OCCLUSION_SSE
+    void ComputeSpansSse(const SpanEdge* edges, int edgeCount, float minX, float maxX, int rowBegin, int rowCount,
+                         float* left, float* right)
+    {
+        int i = 0;
+        for (; i + 4 <= rowCount; i += 4) {
+            const int row = rowBegin + i;
+            const __m128 y = _mm_add_ps(_mm_cvtepi32_ps(_mm_setr_epi32(row, row + 1, row + 2, row + 3)), _mm_set1_ps(0.5f));
+            __m128 l = _mm_set1_ps(minX), r = _mm_set1_ps(maxX);
+            for (int e = 0; e < edgeCount; ++e) {
+                const __m128 x = _mm_add_ps(_mm_set1_ps(edges[e].x0),
+                    _mm_mul_ps(_mm_sub_ps(y, _mm_set1_ps(edges[e].y0)), _mm_set1_ps(edges[e].invSlope)));
+                if (edges[e].left) l = _mm_max_ps(l, x);
+                else r = _mm_min_ps(r, x);
+            }
+            _mm_storeu_ps(left + i, l);
+            _mm_storeu_ps(right + i, r);
+        }
+        ComputeSpansScalar(edges, edgeCount, minX, maxX, rowBegin + i, rowCount - i, left + i, right + i);
+    }
+#endif
+
+    /**
+     * @brief Signed distances of a clip-space vertex to the near plane and the guard-band sides
+     */
+    void ClipDistances(const XMFLOAT4& v, float d[5])
+    {
+        d[0] = v.z;
+        d[1] = GuardBand * v.w + v.x;
+        d[2] = GuardBand * v.w - v.x;
+        d[3] = GuardBand * v.w + v.y;
+        d[4] = GuardBand * v.w - v.y;
+    }
+
+    XMFLOAT4 Lerp(const XMFLOAT4& a, const XMFLOAT4& b, float t)
+    {
+        return XMFLOAT4(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t);
+    }
+
+    XMFLOAT4 TransformPoint(float x, float y, float z, FXMMATRIX m)
+    {
+        XMFLOAT4 result;
+        XMStoreFloat4(&result, XMVector4Transform(XMVectorSet(x, y, z, 1.0f), m));
+        return result;
+    }
+}
+
+// ============================================================================
+// SETUP
+// ============================================================================
+
+OcclusionCuller::OcclusionCuller(uint32_t width, uint32_t height)
+{
+    Resize(width, height);
+    Begin(XMMatrixIdentity());
+}
+
+void OcclusionCuller::Resize(uint32_t width, uint32_t height)
+{
+    ASSERT_MSG(width > 0 && height > 0 && width <= 4096 && height <= 4096, "Occlusion buffer size %u out of range", width);
+    m_tilesX = (width + TileWidth - 1) / TileWidth;
+    m_tilesY = (height + TileHeight - 1) / TileHeight;
+    m_width = m_tilesX * TileWidth;
+    m_height = m_tilesY * TileHeight;
+
+    const size_t tiles = size_t(m_tilesX) * m_tilesY;
+    m_zMax0.assign(tiles, 1.0f);
+    m_zMax1.assign(tiles, 0.0f);
+    m_masks.assign(tiles * TileHeight, 0u);
+    m_spanFirst.assign(m_height, 0);
+    m_spanLast.assign(m_height, -1);
+}
+
+void OcclusionCuller::Begin(FXMMATRIX viewProjection)
+{
+    XMStoreFloat4x4(&m_viewProjection, viewProjection);
+    std::fill(m_zMax0.begin(), m_zMax0.end(), 1.0f);
+    std::fill(m_zMax1.begin(), m_zMax1.end(), 0.0f);
+    std::fill(m_masks.begin(), m_masks.end(), 0u);
+    m_trianglesRasterized = 0;
+    m_trianglesRejected = 0;
+}
+
+// ============================================================================
+// RASTERISATION
+// ============================================================================
+
+uint32_t OcclusionCuller::RasterizeMesh(const float* positions, size_t stride, size_t vertexCount, const uint32_t* indices,
+                                        size_t indexCount, FXMMATRIX world)
+{
+    ASSERT_MSG(positions && indices && indexCount % 3 == 0, "Occluder mesh needs whole triangles (%zu indices)", indexCount);
+    const XMMATRIX worldViewProjection = XMMatrixMultiply(world, XMLoadFloat4x4(&m_viewProjection));
+
+    m_clipVertices.resize(vertexCount);
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(positions);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        const float* p = reinterpret_cast<const float*>(bytes + i * stride);
+        m_clipVertices[i] = TransformPoint(p[0], p[1], p[2], worldViewProjection);
+    }
+
+    uint32_t rasterized = 0;
+    for (size_t i = 0; i < indexCount; i += 3) {
+        ASSERT_MSG(indices[i] < vertexCount && indices[i + 1] < vertexCount && indices[i + 2] < vertexCount,
+                   "Occluder index out of range at %zu", i);
+        if (RasterizeClipTriangle(m_clipVertices[indices[i]], m_clipVertices[indices[i + 1]], m_clipVertices[indices[i + 2]])) {
+            rasterized++;
+        }
+    }
+    return rasterized;
+}
+
+bool OcclusionCuller::RasterizeTriangle(const XMFLOAT3& a, const XMFLOAT3& b, const XMFLOAT3& c)
+{
+    const XMMATRIX viewProjection = XMLoadFloat4x4(&m_viewProjection);
+    return RasterizeClipTriangle(TransformPoint(a.x, a.y, a.z, viewProjection), TransformPoint(b.x, b.y, b.z, viewProjection),
+                                 TransformPoint(c.x, c.y, c.z, viewProjection));
+}
+
+bool OcclusionCuller::RasterizeClipTriangle(const XMFLOAT4& a, const XMFLOAT4& b, const XMFLOAT4& c)
+{
+    // Outcodes against the near plane and guard band, plus the far and screen planes for rejection
+    auto outcode = [](const XMFLOAT4& v) {
+        float d[5];
+        ClipDistances(v, d);
+        uint32_t code = 0;
+        for (int i = 0; i < 5; ++i) {
+            if (d[i] < 0.0f) code |= 1u << i;
+        }
+        if (v.z > v.w) code |= 1u << 5;
+        if (v.x > v.w) code |= 1u << 6;
+        if (v.x < -v.w) code |= 1u << 7;
+        if (v.y > v.w) code |= 1u << 8;
+        if (v.y < -v.w) code |= 1u << 9;
+        return code;
+    };
+    const uint32_t codeA = outcode(a), codeB = outcode(b), codeC = outcode(c);
+    if (codeA & codeB & codeC) {
+        m_trianglesRejected++;
+        return false;
+    }
+
+    // Sutherland-Hodgman against the planes some vertex is outside of; each adds at most one vertex
+    XMFLOAT4 polygon[8] = { a, b, c };
+    int count = 3;
+    const uint32_t clipPlanes = (codeA | codeB | codeC) & 0x1Fu;
+    for (int plane = 0; plane < 5 && count >= 3; ++plane) {
+        if (!(clipPlanes & (1u << plane))) continue;
+
+        XMFLOAT4 clipped[8];
+        int clippedCount = 0;
+        for (int i = 0; i < count; ++i) {
+            const XMFLOAT4& current = polygon[i];
+            const XMFLOAT4& next = polygon[(i + 1) % count];
+            float dc[5], dn[5];
+            ClipDistances(current, dc);
+            ClipDistances(next, dn);
+            if (dc[plane] >= 0.0f) clipped[clippedCount++] = current;
+            if ((dc[plane] >= 0.0f) != (dn[plane] >= 0.0f)) {
+                clipped[clippedCount++] = Lerp(current, next, dc[plane] / (dc[plane] - dn[plane]));
+            }
+        }
+        std::copy(clipped, clipped + clippedCount, polygon);
+        count = clippedCount;
+    }
+    if (count < 3) {
+        m_trianglesRejected++;
+        return false;
+    }
+
+    ScreenVertex screen[8];
+    for (int i = 0; i < count; ++i) {
+        const float w = std::max(polygon[i].w, 1e-6f);
+        screen[i].x = (polygon[i].x / w * 0.5f + 0.5f) * static_cast<float>(m_width);
+        screen[i].y = (0.5f - polygon[i].y / w * 0.5f) * static_cast<float>(m_height);
+        screen[i].z = std::clamp(polygon[i].z / w, 0.0f, 1.0f);
+    }
+
+    bool reached = false;
+    for (int i = 1; i + 1 < count; ++i) {
+        reached = RasterizeScreenTriangle(screen[0], screen[i], screen[i + 1]) || reached;
+    }
+    if (reached) m_trianglesRasterized++;
+    else m_trianglesRejected++;
+    return reached;
+}
+
+bool OcclusionCuller::RasterizeScreenTriangle(ScreenVertex a, ScreenVertex b, ScreenVertex c)
+{
+    // Positive area is clockwise on screen, which D3D11 treats as front facing
+    float area = (b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y);
+    if (m_backfaceCulling && !(area > 0.0f)) return false;
+    if (!(std::fabs(area) > 1e-8f)) return false;
+    if (area < 0.0f) {
+        std::swap(b, c);
+        area = -area;
+    }
+
+    const float minX = std::max(std::min({ a.x, b.x, c.x }), -1.0f);
+    const float maxX = std::min(std::max({ a.x, b.x, c.x }), static_cast<float>(m_width) + 1.0f);
+    const float minY = std::max(std::min({ a.y, b.y, c.y }), -1.0f);
+    const float maxY = std::min(std::max({ a.y, b.y, c.y }), static_cast<float>(m_height) + 1.0f);
+    const int rowBegin = std::max(0, static_cast<int>(std::ceil(minY - 0.5f)));
+    const int rowEnd = std::min(static_cast<int>(m_height) - 1, static_cast<int>(std::floor(maxY - 0.5f)));
+    if (rowBegin > rowEnd || maxX < 0.0f || minX > static_cast<float>(m_width)) return false;
+
+    // With positive area the inside is left of an edge going up the screen and right of one going down
+    SpanEdge edges[3];
+    int edgeCount = 0;
+    const ScreenVertex* v[3] = { &a, &b, &c };
+    for (int i = 0; i < 3; ++i) {
+        const ScreenVertex& p = *v[i];
+        const ScreenVertex& q = *v[(i + 1) % 3];
+        const float dy = q.y - p.y;
+        if (std::fabs(dy) < 1e-12f) continue;   // Horizontal: rows outside it are already excluded
+        edges[edgeCount++] = { p.x, p.y, (q.x - p.x) / dy, dy < 0.0f };
+    }
+
+    // Covered pixel span of every row: centres in [left, right]
+    float left[SpanChunk], right[SpanChunk];
+    for (int chunk = rowBegin; chunk <= rowEnd; chunk += SpanChunk) {
+        const int rows = std::min(SpanChunk, rowEnd - chunk + 1);
+#if SPARK_OCCLUSION_SSE
+        if (!m_forceScalar) ComputeSpansSse(edges, edgeCount, minX, maxX, chunk, rows, left, right);
+        else ComputeSpansScalar(edges, edgeCount, minX, maxX, chunk, rows, left, right);
+#else
+        ComputeSpansScalar(edges, edgeCount, minX, maxX, chunk, rows, left, right);
+#endif
+        for (int i = 0; i < rows; ++i) {
+            const float l = std::min(left[i], static_cast<float>(m_width));
+            const float r = std::max(right[i], -1.0f);
+            m_spanFirst[chunk + i] = std::max(0, static_cast<int>(std::ceil(l - 0.5f)));
+            m_spanLast[chunk + i] = std::min(static_cast<int>(m_width) - 1, static_cast<int>(std::floor(r - 0.5f)));
+        }
+    }
+
+    // Depth is linear in screen space: z = a.z + dzdx (x - a.x) + dzdy (y - a.y)
+    const float dzdx = ((b.z - a.z) * (c.y - a.y) - (c.z - a.z) * (b.y - a.y)) / area;
+    const float dzdy = ((c.z - a.z) * (b.x - a.x) - (b.z - a.z) * (c.x - a.x)) / area;
+    const float maxZ = std::max({ a.z, b.z, c.z });
+
+    bool reached = false;
+    for (int tileY = rowBegin / static_cast<int>(TileHeight); tileY <= rowEnd / static_cast<int>(TileHeight); ++tileY) {
+        const int rowFirst = std::max(rowBegin, tileY * static_cast<int>(TileHeight));
+        const int rowLast = std::min(rowEnd, tileY * static_cast<int>(TileHeight) + static_cast<int>(TileHeight) - 1);
+
+        int columnFirst = static_cast<int>(m_width), columnLast = -1;
+        for (int row = rowFirst; row <= rowLast; ++row) {
+            if (m_spanFirst[row] > m_spanLast[row]) continue;
+            columnFirst = std::min(columnFirst, m_spanFirst[row]);
+            columnLast = std::max(columnLast, m_spanLast[row]);
+        }
+        if (columnFirst > columnLast) continue;
+
+        for (int tileX = columnFirst / static_cast<int>(TileWidth); tileX <= columnLast / static_cast<int>(TileWidth); ++tileX) {
+            const int x0 = tileX * static_cast<int>(TileWidth);
+            uint32_t rowMasks[TileHeight] = {};
+            int coveredLeft = x0 + static_cast<int>(TileWidth), coveredRight = -1, coveredTop = -1, coveredBottom = -1;
+            for (int row = rowFirst; row <= rowLast; ++row) {
+                const int first = std::max(m_spanFirst[row], x0);
+                const int last = std::min(m_spanLast[row], x0 + static_cast<int>(TileWidth) - 1);
+                if (first > last) continue;
+                rowMasks[row - tileY * static_cast<int>(TileHeight)] = (FullRow >> (31 - (last - x0))) & (FullRow << (first - x0));
+                coveredLeft = std::min(coveredLeft, first);
+                coveredRight = std::max(coveredRight, last);
+                if (coveredTop < 0) coveredTop = row;
+                coveredBottom = row;
+            }
+            if (coveredRight < 0) continue;
+
+            // Farthest depth over the covered pixel centres is at a corner of their bounding rectangle
+            const float x = static_cast<float>(dzdx > 0.0f ? coveredRight : coveredLeft) + 0.5f;
+            const float y = static_cast<float>(dzdy > 0.0f ? coveredBottom : coveredTop) + 0.5f;
+            const float planeZ = a.z + dzdx * (x - a.x) + dzdy * (y - a.y);
+            const float tileZ = std::min(1.0f, std::min(maxZ, planeZ) + DepthBias);
+
+            UpdateTile(static_cast<uint32_t>(tileY) * m_tilesX + static_cast<uint32_t>(tileX), rowMasks, tileZ);
+            reached = true;
+        }
+    }
+    return reached;
+}
+
+void OcclusionCuller::UpdateTile(uint32_t tile, const uint32_t rowMasks[TileHeight], float triangleDepth)
+{
+    float& zMax0 = m_zMax0[tile];
+    float& zMax1 = m_zMax1[tile];
+    uint32_t* mask = &m_masks[size_t(tile) * TileHeight];
+
+    // Behind everything already known to cover the tile: adds nothing
+    if (triangleDepth >= zMax0) return;
+
+    bool triangleFull = true;
+    for (uint32_t row = 0; row < TileHeight; ++row) triangleFull = triangleFull && rowMasks[row] == FullRow;
+    if (triangleFull) {
+        zMax0 = triangleDepth;
+        if (zMax1 >= triangleDepth) {
+            zMax1 = 0.0f;
+            std::fill(mask, mask + TileHeight, 0u);
+        }
+        return;
+    }
+
+    // A triangle far in front of the working layer starts a new one
+    if (zMax1 - triangleDepth > zMax0 - zMax1) {
+        zMax1 = 0.0f;
+        std::fill(mask, mask + TileHeight, 0u);
+    }
+
+    bool full = true;
+    for (uint32_t row = 0; row < TileHeight; ++row) {
+        mask[row] |= rowMasks[row];
+        full = full && mask[row] == FullRow;
+    }
+    zMax1 = std::max(zMax1, triangleDepth);
+
+    if (full) {
+        zMax0 = zMax1;
+        zMax1 = 0.0f;
+        std::fill(mask, mask + TileHeight, 0u);
+    }
+}
+
+// ============================================================================
+// OCCLUDEE TESTS
+// ============================================================================
+
+OcclusionCuller::Visibility OcclusionCuller::TestBox(const XMFLOAT3& worldMin, const XMFLOAT3& worldMax) const
+{
+    const XMMATRIX viewProjection = XMLoadFloat4x4(&m_viewProjection);
+    float minX = std::numeric_limits<float>::max(), maxX = -std::numeric_limits<float>::max();
+    float minY = minX, maxY = maxX, minZ = 1.0f;
+    int behind = 0;
+    for (int corner = 0; corner < 8; ++corner) {
+        const XMFLOAT4 v = TransformPoint((corner & 1) ? worldMax.x : worldMin.x, (corner & 2) ? worldMax.y : worldMin.y,
+                                          (corner & 4) ? worldMax.z : worldMin.z, viewProjection);
+        if (!(v.z >= 0.0f) || !(v.w > 0.0f)) {
+            behind++;
+            continue;
+        }
+        const float x = (v.x / v.w * 0.5f + 0.5f) * static_cast<float>(m_width);
+        const float y = (0.5f - v.y / v.w * 0.5f) * static_cast<float>(m_height);
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        minZ = std::min(minZ, v.z / v.w);
+    }
+    if (behind == 8) return Visibility::Offscreen;
+    if (behind > 0) return Visibility::Visible;     // Crosses the near plane
+    if (maxX < 0.0f || minX > static_cast<float>(m_width) || maxY < 0.0f || minY > static_cast<float>(m_height)) {
+        return Visibility::Offscreen;
+    }
+    minZ = std::max(minZ, 0.0f);
+
+    // Every pixel the rectangle touches
+    const int left = std::max(0, static_cast<int>(std::floor(std::max(minX, -1.0f))));
+    const int right = std::min(static_cast<int>(m_width) - 1, static_cast<int>(std::floor(std::min(maxX, static_cast<float>(m_width)))));
+    const int top = std::max(0, static_cast<int>(std::floor(std::max(minY, -1.0f))));
+    const int bottom = std::min(static_cast<int>(m_height) - 1, static_cast<int>(std::floor(std::min(maxY, static_cast<float>(m_height)))));
+
+    // A tile whose reference layer is nearer than the box can still hide it if
+    // the box only touches masked pixels of a working layer that is nearer
+    auto hiddenByWorkingLayer = [&](int tileX, int tileY) {
+        const uint32_t tile = static_cast<uint32_t>(tileY) * m_tilesX + static_cast<uint32_t>(tileX);
+        if (minZ < m_zMax1[tile]) return false;
+        const int x0 = tileX * static_cast<int>(TileWidth);
+        const int first = std::max(left, x0) - x0;
+        const int last = std::min(right, x0 + static_cast<int>(TileWidth) - 1) - x0;
+        const uint32_t columns = (FullRow >> (31 - last)) & (FullRow << first);
+        const int rowFirst = std::max(top, tileY * static_cast<int>(TileHeight));
+        const int rowLast = std::min(bottom, tileY * static_cast<int>(TileHeight) + static_cast<int>(TileHeight) - 1);
+        const uint32_t* mask = &m_masks[size_t(tile) * TileHeight];
+        for (int row = rowFirst; row <= rowLast; ++row) {
+            if (columns & ~mask[row - tileY * static_cast<int>(TileHeight)]) return false;
+        }
+        return true;
+    };
+
+    const int tileLeft = left / static_cast<int>(TileWidth), tileRight = right / static_cast<int>(TileWidth);
+    for (int tileY = top / static_cast<int>(TileHeight); tileY <= bottom / static_cast<int>(TileHeight); ++tileY) {
+        const float* depths = &m_zMax0[size_t(tileY) * m_tilesX];
+        int tileX = tileLeft;
+#if SPARK_OCCLUSION_SSE
+        const __m128 boxDepth = _mm_set1_ps(minZ);
+        for (; tileX + 3 <= tileRight; tileX += 4) {
+            uint32_t nearer = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmplt_ps(boxDepth, _mm_loadu_ps(depths + tileX))));
+            while (nearer) {
+                const int lane = static_cast<int>(std::countr_zero(nearer));
+                if (!hiddenByWorkingLayer(tileX + lane, tileY)) return Visibility::Visible;
+                nearer &= nearer - 1;
+            }
+        }
+#endif
+        for (; tileX <= tileRight; ++tileX) {
+            if (minZ < depths[tileX] && !hiddenByWorkingLayer(tileX, tileY)) return Visibility::Visible;
+        }
+    }
+    return Visibility::Occluded;
+}
+
+float OcclusionCuller::GetPixelDepth(uint32_t x, uint32_t y) const
+{
+    ASSERT_MSG(x < m_width && y < m_height, "Pixel %u outside the occlusion buffer", x);
+    const uint32_t tile = (y / TileHeight) * m_tilesX + x / TileWidth;
+    const uint32_t mask = m_masks[size_t(tile) * TileHeight + y % TileHeight];
+    return (mask >> (x % TileWidth)) & 1u ? m_zMax1[tile] : m_zMax0[tile];
+}
+
+// ============================================================================
+// CONSOLE INTEGRATION
+// ============================================================================
+
+std::string OcclusionCuller::Console_GetStats() const
+{
+    uint32_t coveredTiles = 0;
+    double depthSum = 0.0;
+    for (float depth : m_zMax0) {
+        if (depth < 1.0f) coveredTiles++;
+        depthSum += depth;
+    }
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(4);
+    ss << "=== Occlusion Culler ===\n";
+    ss << "Buffer:              " << m_width << "x" << m_height << " (" << m_tilesX << "x" << m_tilesY << " tiles)\n";
+    ss << "Triangles:           " << m_trianglesRasterized << " rasterised, " << m_trianglesRejected << " rejected\n";
+    ss << "Fully covered tiles: " << coveredTiles << "/" << m_zMax0.size() << "\n";
+    ss << "Mean tile depth:     " << (m_zMax0.empty() ? 1.0 : depthSum / m_zMax0.size()) << "\n";
+#if SPARK_OCCLUSION_SSE
+    ss << "Span kernel:         " << (m_forceScalar ? "scalar (forced)" : "SSE") << "\n";
+#else
+    ss << "Span kernel:         scalar\n";
+#endif
+    return ss.str();
+}
+
+std::string OcclusionCuller::Console_Benchmark(int roomsPerSide)
+{
+    using Clock = std::chrono::high_resolution_clock;
+    roomsPerSide = std::clamp(roomsPerSide, 2, 32);
+    constexpr float RoomSize = 8.0f, WallHeight = 3.0f, WallThickness = 0.2f, DoorWidth = 1.2f;
+    constexpr int ObjectsPerRoom = 24;
+    constexpr int Repeats = 5;
+    const float levelSize = roomsPerSide * RoomSize;
+
+    // Walls on every grid line, each room side split by a doorway
+    struct Box { XMFLOAT3 min, max; };
+    std::vector<Box> walls;
+    for (int line = 0; line <= roomsPerSide; ++line) {
+        for (int segment = 0; segment < roomsPerSide; ++segment) {
+            const float start = segment * RoomSize, middle = start + RoomSize * 0.5f, end = start + RoomSize;
+            const float at = line * RoomSize;
+            const float pieces[2][2] = { { start, middle - DoorWidth * 0.5f }, { middle + DoorWidth * 0.5f, end } };
+            for (const auto& piece : pieces) {
+                walls.push_back({ { piece[0], 0.0f, at - WallThickness * 0.5f }, { piece[1], WallHeight, at + WallThickness * 0.5f } });
+                walls.push_back({ { at - WallThickness * 0.5f, 0.0f, piece[0] }, { at + WallThickness * 0.5f, WallHeight, piece[1] } });
+            }
+        }
+    }
+
+    std::mt19937 rng(20);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<Box> objects;
+    for (int room = 0; room < roomsPerSide * roomsPerSide; ++room) {
+        const float roomX = (room % roomsPerSide) * RoomSize, roomZ = (room / roomsPerSide) * RoomSize;
+        for (int i = 0; i < ObjectsPerRoom; ++i) {
+            const float size = 0.2f + 0.8f * unit(rng);
+            const XMFLOAT3 min(roomX + 0.5f + (RoomSize - 1.0f - size) * unit(rng), 2.0f * unit(rng) * (1.0f - size * 0.5f),
+                               roomZ + 0.5f + (RoomSize - 1.0f - size) * unit(rng));
+            objects.push_back({ min, { min.x + size, min.y + size, min.z + size } });
+        }
+    }
+
+    // Unit cube occluder mesh, scaled onto each wall
+    const float cubePositions[8][3] = { {0,0,0}, {1,0,0}, {1,1,0}, {0,1,0}, {0,0,1}, {1,0,1}, {1,1,1}, {0,1,1} };
+    const uint32_t cubeIndices[36] = { 0,2,1, 0,3,2, 4,5,6, 4,6,7, 0,1,5, 0,5,4, 3,7,6, 3,6,2, 0,4,7, 0,7,3, 1,2,6, 1,6,5 };
+    auto wallWorld = [](const Box& box) {
+        return XMMatrixMultiply(XMMatrixScaling(box.max.x - box.min.x, box.max.y - box.min.y, box.max.z - box.min.z),
+                                XMMatrixTranslation(box.min.x, box.min.y, box.min.z));
+    };
+
+    // Standing in a corner room looking diagonally across the level
+    OcclusionCuller culler;
+    const float aspect = static_cast<float>(culler.GetWidth()) / culler.GetHeight();
+    const XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(RoomSize * 0.5f, 1.7f, RoomSize * 0.3f, 1.0f),
+                                           XMVectorSet(levelSize, 1.2f, levelSize * 0.8f, 1.0f), XMVectorSet(0, 1, 0, 0));
+    const XMMATRIX projection = XMMatrixPerspectiveFovLH(XMConvertToRadians(70.0f), aspect, 0.1f, 500.0f);
+    const XMMATRIX viewProjection = XMMatrixMultiply(view, projection);
+
+    auto rasterize = [&](OcclusionCuller& target) {
+        target.Begin(viewProjection);
+        for (const Box& wall : walls) {
+            target.RasterizeMesh(&cubePositions[0][0], sizeof(cubePositions[0]), 8, cubeIndices, 36, wallWorld(wall));
+        }
+    };
+
+    double rasterMs = 1e30, scalarMs = 1e30, testMs = 1e30;
+    OcclusionCuller scalar;
+    scalar.SetForceScalar(true);
+    for (int r = 0; r < Repeats; ++r) {
+        auto start = Clock::now();
+        rasterize(culler);
+        rasterMs = std::min(rasterMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        start = Clock::now();
+        rasterize(scalar);
+        scalarMs = std::min(scalarMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    const bool kernelsMatch = culler.m_zMax0 == scalar.m_zMax0 && culler.m_zMax1 == scalar.m_zMax1 && culler.m_masks == scalar.m_masks;
+
+    std::vector<Visibility> results(objects.size());
+    for (int r = 0; r < Repeats; ++r) {
+        const auto start = Clock::now();
+        for (size_t i = 0; i < objects.size(); ++i) results[i] = culler.TestBox(objects[i].min, objects[i].max);
+        testMs = std::min(testMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+
+    // Reference: exact depth at every pixel centre by casting a ray against every wall
+    const uint32_t width = culler.GetWidth(), height = culler.GetHeight();
+    std::vector<float> exactDepth(size_t(width) * height, 1.0f);
+    const XMMATRIX inverse = XMMatrixInverse(nullptr, viewProjection);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            const float ndcX = (x + 0.5f) / width * 2.0f - 1.0f, ndcY = 1.0f - (y + 0.5f) / height * 2.0f;
+            const XMVECTOR origin = XMVector3TransformCoord(XMVectorSet(ndcX, ndcY, 0.0f, 1.0f), inverse);
+            const XMVECTOR direction = XMVectorSubtract(XMVector3TransformCoord(XMVectorSet(ndcX, ndcY, 1.0f, 1.0f), inverse), origin);
+            XMFLOAT3 o, d;
+            XMStoreFloat3(&o, origin);
+            XMStoreFloat3(&d, direction);
+
+            float nearest = 2.0f;
+            for (const Box& wall : walls) {
+                float tMin = 0.0f, tMax = nearest;
+                const float os[3] = { o.x, o.y, o.z }, ds[3] = { d.x, d.y, d.z };
+                const float mins[3] = { wall.min.x, wall.min.y, wall.min.z }, maxs[3] = { wall.max.x, wall.max.y, wall.max.z };
+                for (int axis = 0; axis < 3 && tMin <= tMax; ++axis) {
+                    if (std::fabs(ds[axis]) < 1e-12f) {
+                        if (os[axis] < mins[axis] || os[axis] > maxs[axis]) tMax = -1.0f;
+                        continue;
+                    }
+                    float t0 = (mins[axis] - os[axis]) / ds[axis], t1 = (maxs[axis] - os[axis]) / ds[axis];
+                    if (t0 > t1) std::swap(t0, t1);
+                    tMin = std::max(tMin, t0);
+                    tMax = std::min(tMax, t1);
+                }
+                if (tMin <= tMax) nearest = tMin;
+            }
+            if (nearest <= 1.0f) {
+                const XMFLOAT3 hit(o.x + d.x * nearest, o.y + d.y * nearest, o.z + d.z * nearest);
+                const XMFLOAT4 clip = TransformPoint(hit.x, hit.y, hit.z, viewProjection);
+                exactDepth[size_t(y) * width + x] = clip.z / clip.w;
+            }
+        }
+    }
+
+    // The masked buffer must never claim a pixel is nearer than it is
+    constexpr float Tolerance = 1e-5f;
+    uint32_t depthViolations = 0;
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            if (exactDepth[size_t(y) * width + x] > culler.GetPixelDepth(x, y) + Tolerance) depthViolations++;
+        }
+    }
+
+    // Per-pixel version of the same rectangle test on the exact buffer
+    uint32_t onScreen = 0, occluded = 0, exactOccluded = 0, falseCulls = 0;
+    for (size_t i = 0; i < objects.size(); ++i) {
+        if (results[i] == Visibility::Offscreen) continue;
+        onScreen++;
+        bool exactHidden = true;
+        float minX = 1e30f, maxX = -1e30f, minY = 1e30f, maxY = -1e30f, minZ = 1.0f;
+        for (int corner = 0; corner < 8 && exactHidden; ++corner) {
+            const XMFLOAT4 v = TransformPoint((corner & 1) ? objects[i].max.x : objects[i].min.x, (corner & 2) ? objects[i].max.y : objects[i].min.y,
+                                              (corner & 4) ? objects[i].max.z : objects[i].min.z, viewProjection);
+            if (!(v.z >= 0.0f) || !(v.w > 0.0f)) { exactHidden = false; break; }
+            minX = std::min(minX, (v.x / v.w * 0.5f + 0.5f) * width);
+            maxX = std::max(maxX, (v.x / v.w * 0.5f + 0.5f) * width);
+            minY = std::min(minY, (0.5f - v.y / v.w * 0.5f) * height);
+            maxY = std::max(maxY, (0.5f - v.y / v.w * 0.5f) * height);
+            minZ = std::min(minZ, v.z / v.w);
+        }
+        if (exactHidden) {
+            const int x0 = std::max(0, static_cast<int>(std::floor(minX))), x1 = std::min(static_cast<int>(width) - 1, static_cast<int>(std::floor(maxX)));
+            const int y0 = std::max(0, static_cast<int>(std::floor(minY))), y1 = std::min(static_cast<int>(height) - 1, static_cast<int>(std::floor(maxY)));
+            for (int y = y0; y <= y1 && exactHidden; ++y) {
+                for (int x = x0; x <= x1 && exactHidden; ++x) {
+                    exactHidden = exactDepth[size_t(y) * width + x] <= minZ;
+                }
+            }
+        }
+        if (exactHidden) exactOccluded++;
+        if (results[i] == Visibility::Occluded) {
+            occluded++;
+            if (!exactHidden) falseCulls++;
+        }
+    }
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "=== Occlusion Culling Benchmark ===\n";
+    ss << roomsPerSide << "x" << roomsPerSide << " rooms, " << walls.size() << " wall boxes, " << objects.size()
+       << " objects, " << width << "x" << height << " buffer, best of " << Repeats << "\n";
+    ss << "Rasterise:  " << rasterMs << " ms (" << culler.GetTrianglesRasterized() << " triangles in, "
+       << culler.GetTrianglesRejected() << " rejected)\n";
+    ss << "  scalar:   " << scalarMs << " ms (" << scalarMs / rasterMs << "x), buffers "
+       << (kernelsMatch ? "identical" : "DIFFER") << "\n";
+    ss << "Test boxes: " << testMs << " ms (" << objects.size() / testMs / 1000.0 << " M boxes/s)\n";
+    ss << "On screen:  " << onScreen << "/" << objects.size() << "\n";
+    ss << "Occluded:   " << occluded << " (" << (onScreen ? 100.0 * occluded / onScreen : 0.0) << "% cull rate), exact "
+       << exactOccluded << "\n";
+    ss << "Conservative: " << (depthViolations == 0 && falseCulls == 0 ? "passed" : "FAILED") << " ("
+       << depthViolations << " pixel violations, " << falseCulls << " false culls)\n";
+    return ss.str();
+}
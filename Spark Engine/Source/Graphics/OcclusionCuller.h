@@ -0,0 +1,169 @@
+/**
+ * @file OcclusionCuller.h
+ * @brief CPU masked software occlusion culling
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * Occluder triangles are rasterised into a small depth buffer made of 32x8
+ * pixel tiles. Instead of a depth per pixel, a tile keeps a coverage mask and
+ * two conservative far depths: the reference layer covers the whole tile, and
+ * the working layer covers the masked pixels. A triangle is merged into the
+ * working layer; once the mask is full the working depth becomes the new
+ * reference. If a triangle is far in front of the working layer compared
+ * with the gap between the two layers, the working layer is dropped and
+ * restarted from the triangle, so a tile never needs more than two depths.
+ *
+ * Triangles are walked by scanline: the covered span of each pixel row is
+ * computed four rows at a time with SSE (plain floats elsewhere, with
+ * identical results), and turned into 32-bit row masks per tile with shifts.
+ *
+ * Occludees are tested by their world box: the box's nearest depth is
+ * compared against the reference depth of every tile its screen rectangle
+ * touches, four tiles per SSE compare. The test is conservative, so an
+ * object reported hidden is hidden; the reverse is not guaranteed.
+ *
+ * Nothing here uses a graphics API, so the culler runs and benchmarks headless.
+ */
+
+#pragma once
+
+#include "Utils/Assert.h"
+#include <DirectXMath.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Low-resolution masked depth buffer with occluder rasterisation and box tests
+ *
+ * Not thread-safe while rasterising; IsVisible() may run on several threads
+ * at once once the occluders are in.
+ */
+class OcclusionCuller
+{
+public:
+    static constexpr uint32_t TileWidth = 32;
+    static constexpr uint32_t TileHeight = 8;
+
+    /**
+     * @brief Result of a box test
+     */
+    enum class Visibility
+    {
+        Visible,        ///< Some part of the box may be in front of the occluders
+        Occluded,       ///< Every tile under the box is covered by nearer occluders
+        Offscreen,      ///< The box projects outside the buffer
+    };
+
+    /**
+     * @param width Buffer width in pixels, rounded up to a multiple of TileWidth
+     * @param height Buffer height in pixels, rounded up to a multiple of TileHeight
+     */
+    explicit OcclusionCuller(uint32_t width = 320, uint32_t height = 192);
+
+    void Resize(uint32_t width, uint32_t height);
+    uint32_t GetWidth() const { return m_width; }
+    uint32_t GetHeight() const { return m_height; }
+
+    /**
+     * @brief Empty the buffer and set the camera for the next occluders and tests
+     * @param viewProjection Direct3D view-projection matrix (row vectors, clip z in [0, w])
+     */
+    void Begin(DirectX::FXMMATRIX viewProjection);
+
+    /**
+     * @brief Rasterise an indexed triangle list
+     * @param positions First vertex position; x, y, z floats
+     * @param stride Bytes between consecutive positions
+     * @param world Object-to-world transform
+     * @return Triangles that reached the buffer
+     */
+    uint32_t RasterizeMesh(const float* positions, size_t stride, size_t vertexCount, const uint32_t* indices,
+                           size_t indexCount, DirectX::FXMMATRIX world);
+
+    /**
+     * @brief Rasterise one triangle given in world space
+     * @return True if it reached the buffer
+     */
+    bool RasterizeTriangle(const DirectX::XMFLOAT3& a, const DirectX::XMFLOAT3& b, const DirectX::XMFLOAT3& c);
+
+    /**
+     * @brief Conservative test of a world-space box against the occluders rasterised so far
+     */
+    Visibility TestBox(const DirectX::XMFLOAT3& worldMin, const DirectX::XMFLOAT3& worldMax) const;
+
+    bool IsVisible(const DirectX::XMFLOAT3& worldMin, const DirectX::XMFLOAT3& worldMax) const
+    {
+        return TestBox(worldMin, worldMax) != Visibility::Occluded;
+    }
+
+    /**
+     * @brief Skip triangles facing away from the camera (clockwise front faces, as D3D11 by default)
+     *
+     * Off by default: only safe for occluders with consistent winding.
+     */
+    void SetBackfaceCulling(bool enabled) { m_backfaceCulling = enabled; }
+
+    /**
+     * @brief Use the plain-float span kernel even where SSE is available, as a reference
+     */
+    void SetForceScalar(bool enabled) { m_forceScalar = enabled; }
+
+    // ========================================================================
+    // INSPECTION
+    // ========================================================================
+
+    uint32_t GetTilesX() const { return m_tilesX; }
+    uint32_t GetTilesY() const { return m_tilesY; }
+
+    /**
+     * @brief Depth every pixel of the tile is known to be at or in front of; 1 if nothing covers it fully
+     */
+    float GetTileDepth(uint32_t tileX, uint32_t tileY) const { return m_zMax0[tileY * m_tilesX + tileX]; }
+
+    /**
+     * @brief Conservative far depth of one pixel: the working depth if its mask bit is set, else the tile depth
+     */
+    float GetPixelDepth(uint32_t x, uint32_t y) const;
+
+    uint32_t GetTrianglesRasterized() const { return m_trianglesRasterized; }
+    uint32_t GetTrianglesRejected() const { return m_trianglesRejected; }
+
+    std::string Console_GetStats() const;
+
+    /**
+     * @brief Rasterise a synthetic indoor level and cull its contents, checked against an exact depth buffer
+     * @param roomsPerSide The level is a grid of roomsPerSide x roomsPerSide walled rooms
+     */
+    static std::string Console_Benchmark(int roomsPerSide);
+
+private:
+    struct ScreenVertex
+    {
+        float x, y, z;
+    };
+
+    bool RasterizeClipTriangle(const DirectX::XMFLOAT4& a, const DirectX::XMFLOAT4& b, const DirectX::XMFLOAT4& c);
+    bool RasterizeScreenTriangle(ScreenVertex a, ScreenVertex b, ScreenVertex c);
+    void UpdateTile(uint32_t tile, const uint32_t rowMasks[TileHeight], float triangleDepth);
+
+    uint32_t m_width = 0, m_height = 0;
+    uint32_t m_tilesX = 0, m_tilesY = 0;
+
+    // Per tile, structure of arrays
+    std::vector<float> m_zMax0;         ///< Reference layer: far depth covering the whole tile
+    std::vector<float> m_zMax1;         ///< Working layer: far depth of the masked pixels
+    std::vector<uint32_t> m_masks;      ///< TileHeight row masks per tile; bit x covers pixel column x
+
+    // Scratch: first and last covered pixel of each row of the current triangle
+    std::vector<int32_t> m_spanFirst, m_spanLast;
+    std::vector<DirectX::XMFLOAT4> m_clipVertices;
+
+    DirectX::XMFLOAT4X4 m_viewProjection{};
+    bool m_backfaceCulling = false;
+    bool m_forceScalar = false;
+
+    uint32_t m_trianglesRasterized = 0;
+    uint32_t m_trianglesRejected = 0;
+};
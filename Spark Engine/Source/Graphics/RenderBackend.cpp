@@ -0,0 +1,58 @@
+/**
+ * @file RenderBackend.cpp
+ * @brief Command statistics and the null backend
+ * @author Spark Engine Team
+ * @date 2025
+ */
+
+#include "RenderBackend.h"
+#include <sstream>
+
+void RenderBackend::CountCommands(const CommandBuffer& buffer)
+{
+    m_stats.buffers++;
+    m_stats.commands += buffer.GetCommands().size();
+    for (const RenderCommand& command : buffer.GetCommands()) {
+        switch (command.type) {
+        case RenderCommandType::BindBasicShaders:
+            m_stats.shaderBinds++;
+            break;
+        case RenderCommandType::BindMaterial:
+            m_stats.materialBinds++;
+            break;
+        case RenderCommandType::SetObjectConstants:
+            m_stats.constantUploads++;
+            m_stats.constantBytes += sizeof(ObjectConstants);
+            break;
+        case RenderCommandType::DrawMesh:
+            m_stats.draws++;
+            m_stats.indices += command.arg;
+            break;
+        case RenderCommandType::DrawObject:
+            m_stats.draws++;
+            m_stats.objectDraws++;
+            break;
+        }
+    }
+}
+
+std::string RenderBackend::Console_GetStats() const
+{
+    std::stringstream ss;
+    ss << "=== Render Backend: " << GetName() << " ===\n";
+    ss << "Buffers:          " << m_stats.buffers << "\n";
+    ss << "Commands:         " << m_stats.commands << "\n";
+    ss << "Draws:            " << m_stats.draws << " (" << m_stats.objectDraws << " self-drawn)\n";
+    ss << "Triangles:        " << m_stats.indices / 3 << "\n";
+    ss << "Shader binds:     " << m_stats.shaderBinds << "\n";
+    ss << "Material binds:   " << m_stats.materialBinds << "\n";
+    ss << "Constant uploads: " << m_stats.constantUploads << " (" << m_stats.constantBytes / 1024 << " KB)\n";
+    return ss.str();
+}
+
+void NullRenderBackend::Execute(const CommandBuffer* const* buffers, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        CountCommands(*buffers[i]);
+    }
+}
@@ -0,0 +1,93 @@
+/**
+ * @file RenderBackend.h
+ * @brief Replay targets for recorded command buffers, plus the null backend
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * GraphicsEngine hands every frame's command buffers to one RenderBackend.
+ * D3D11RenderBackend issues them on the device; NullRenderBackend only counts
+ * them, so the whole CPU side of a frame (culling, sorting, recording) can be
+ * profiled without a GPU. Neither this header nor the null backend needs the
+ * Windows SDK.
+ */
+
+#pragma once
+
+#include "CommandBuffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Available backends
+ */
+enum class RenderBackendType
+{
+    D3D11,      ///< Replay on the D3D11 device
+    Null        ///< Count the work and drop it
+};
+
+/**
+ * @brief Work replayed since the last ResetStats()
+ */
+struct RenderBackendStats
+{
+    uint64_t buffers = 0;
+    uint64_t commands = 0;
+    uint64_t draws = 0;             ///< DrawMesh and DrawObject commands
+    uint64_t objectDraws = 0;       ///< DrawObject commands
+    uint64_t indices = 0;           ///< Indices submitted by DrawMesh
+    uint64_t shaderBinds = 0;
+    uint64_t materialBinds = 0;
+    uint64_t constantUploads = 0;
+    uint64_t constantBytes = 0;
+};
+
+/**
+ * @brief Replays command buffers; only called from the render thread
+ */
+class RenderBackend
+{
+public:
+    virtual ~RenderBackend() = default;
+
+    virtual RenderBackendType GetType() const = 0;
+    virtual const char* GetName() const = 0;
+
+    /**
+     * @brief Replay buffers in order; their effects on the target are as if replayed one after another
+     */
+    virtual void Execute(const CommandBuffer* const* buffers, size_t count) = 0;
+
+    void Execute(const CommandBuffer& buffer)
+    {
+        const CommandBuffer* single = &buffer;
+        Execute(&single, 1);
+    }
+
+    const RenderBackendStats& GetStats() const { return m_stats; }
+    void ResetStats() { m_stats = RenderBackendStats{}; }
+
+    std::string Console_GetStats() const;
+
+protected:
+    /**
+     * @brief Add a buffer's commands to the statistics
+     */
+    void CountCommands(const CommandBuffer& buffer);
+
+    RenderBackendStats m_stats;
+};
+
+/**
+ * @brief Backend that counts commands and issues nothing
+ */
+class NullRenderBackend : public RenderBackend
+{
+public:
+    RenderBackendType GetType() const override { return RenderBackendType::Null; }
+    const char* GetName() const override { return "null"; }
+
+    void Execute(const CommandBuffer* const* buffers, size_t count) override;
+    using RenderBackend::Execute;
+};
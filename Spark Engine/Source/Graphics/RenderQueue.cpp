@@ -0,0 +1,306 @@
+/**
+ * @file RenderQueue.cpp
+ * @brief Implementation of render sort key packing and the radix sort
+ * @author Spark Engine Team
+ * @date 2025
+ */
+
+#include "RenderQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+// ============================================================================
+// KEY PACKING
+// ============================================================================
+
+uint32_t RenderKey::QuantizeDepth(float viewDepth, float nearPlane, float farPlane, int bits)
+{
+    ASSERT_MSG(bits > 0 && bits <= 24, "Depth quantisation supports 1 to 24 bits (got %d)", bits);
+    if (!(farPlane > nearPlane)) return 0;
+
+    // Double precision keeps every 24-bit step representable; NaN lands on 0
+    double t = (static_cast<double>(viewDepth) - nearPlane) / (static_cast<double>(farPlane) - nearPlane);
+    if (!(t > 0.0)) t = 0.0;
+    if (t > 1.0) t = 1.0;
+    const uint32_t maxValue = static_cast<uint32_t>(Mask(bits));
+    return std::min(maxValue, static_cast<uint32_t>(t * maxValue + 0.5));
+}
+
+uint64_t RenderKey::Pack(const RenderKeyFields& fields)
+{
+    ASSERT_MSG(fields.pass < RenderPass::Count, "Invalid render pass %u", static_cast<unsigned>(fields.pass));
+    const uint64_t pass = static_cast<uint64_t>(fields.pass) << PassShift;
+
+    if (fields.pass == RenderPass::Transparent) {
+        const uint64_t invertedDepth = ~static_cast<uint64_t>(fields.depth) & Mask(TransparentDepthBits);
+        return pass | (invertedDepth << TransparentDepthShift) |
+               ((fields.shader & Mask(8)) << TransparentShaderShift) |
+               ((fields.material & Mask(TransparentIdBits)) << TransparentMaterialShift) |
+               (fields.mesh & Mask(TransparentIdBits));
+    }
+    return pass | ((fields.shader & Mask(8)) << OpaqueShaderShift) | ((fields.material & Mask(16)) << OpaqueMaterialShift) |
+           ((fields.mesh & Mask(16)) << OpaqueMeshShift) | (fields.depth & Mask(OpaqueDepthBits));
+}
+
+RenderKeyFields RenderKey::Unpack(uint64_t key)
+{
+    RenderKeyFields fields;
+    fields.pass = GetPass(key);
+    if (fields.pass == RenderPass::Transparent) {
+        fields.depth = static_cast<uint32_t>(~(key >> TransparentDepthShift) & Mask(TransparentDepthBits));
+        fields.shader = static_cast<uint32_t>((key >> TransparentShaderShift) & Mask(8));
+        fields.material = static_cast<uint32_t>((key >> TransparentMaterialShift) & Mask(TransparentIdBits));
+        fields.mesh = static_cast<uint32_t>(key & Mask(TransparentIdBits));
+    } else {
+        fields.shader = static_cast<uint32_t>((key >> OpaqueShaderShift) & Mask(8));
+        fields.material = static_cast<uint32_t>((key >> OpaqueMaterialShift) & Mask(16));
+        fields.mesh = static_cast<uint32_t>((key >> OpaqueMeshShift) & Mask(16));
+        fields.depth = static_cast<uint32_t>(key & Mask(OpaqueDepthBits));
+    }
+    return fields;
+}
+
+uint64_t RenderKey::Make(RenderPass pass, uint32_t shader, uint32_t material, uint32_t mesh, float viewDepth,
+                         float nearPlane, float farPlane)
+{
+    RenderKeyFields fields;
+    fields.pass = pass;
+    fields.shader = shader;
+    fields.material = material;
+    fields.mesh = mesh;
+    fields.depth = QuantizeDepth(viewDepth, nearPlane, farPlane,
+                                 pass == RenderPass::Transparent ? TransparentDepthBits : OpaqueDepthBits);
+    return Pack(fields);
+}
+
+uint64_t RenderKey::GetStateBits(uint64_t key)
+{
+    if (GetPass(key) == RenderPass::Transparent) {
+        const uint64_t stateMask = (Mask(4) << PassShift) | (Mask(8) << TransparentShaderShift) |
+                                   (Mask(TransparentIdBits) << TransparentMaterialShift);
+        return key & stateMask;
+    }
+    return key & ~Mask(OpaqueMeshShift + 16);
+}
+
+// ============================================================================
+// RENDER QUEUE
+// ============================================================================
+
+void RenderQueue::Sort()
+{
+    RadixSort(m_packets, m_scratch);
+}
+
+size_t RenderQueue::FindPass(RenderPass pass, size_t begin) const
+{
+    const uint64_t firstKey = static_cast<uint64_t>(pass) << RenderKey::PassShift;
+    return std::lower_bound(m_packets.begin() + begin, m_packets.end(), firstKey,
+        [](const DrawPacket& packet, uint64_t key) { return packet.key < key; }) - m_packets.begin();
+}
+
+namespace
+{
+    constexpr int RadixBits = 11;
+    constexpr uint32_t RadixBuckets = 1u << RadixBits;
+    constexpr int RadixDigits = (64 + RadixBits - 1) / RadixBits;
+
+    std::vector<uint32_t>& RadixHistograms()
+    {
+        thread_local std::vector<uint32_t> histograms(RadixDigits * RadixBuckets);
+        return histograms;
+    }
+}
+
+void RenderQueue::RadixSort(std::vector<DrawPacket>& packets, std::vector<DrawPacket>& scratch)
+{
+    const size_t count = packets.size();
+    if (count < 2) return;
+
+    // Tiny queues are not worth six histograms
+    if (count <= 64) {
+        for (size_t i = 1; i < count; ++i) {
+            const DrawPacket packet = packets[i];
+            size_t j = i;
+            for (; j > 0 && packets[j - 1].key > packet.key; --j) packets[j] = packets[j - 1];
+            packets[j] = packet;
+        }
+        return;
+    }
+
+    // One read builds every digit's histogram
+    std::vector<uint32_t>& histograms = RadixHistograms();
+    std::fill(histograms.begin(), histograms.end(), 0u);
+    for (const DrawPacket& packet : packets)
+        for (int digit = 0; digit < RadixDigits; ++digit)
+            ++histograms[digit * RadixBuckets + ((packet.key >> (digit * RadixBits)) & (RadixBuckets - 1))];
+
+    scratch.resize(count);
+    DrawPacket* source = packets.data();
+    DrawPacket* destination = scratch.data();
+    for (int digit = 0; digit < RadixDigits; ++digit)
+    {
+        const int shift = digit * RadixBits;
+        uint32_t* histogram = histograms.data() + digit * RadixBuckets;
+
+        // Digits covering the pass and shader are often shared by the whole frame
+        if (histogram[(source[0].key >> shift) & (RadixBuckets - 1)] == count) continue;
+
+        uint32_t offset = 0;
+        for (uint32_t bucket = 0; bucket < RadixBuckets; ++bucket) {
+            const uint32_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+        for (size_t i = 0; i < count; ++i)
+            destination[histogram[(source[i].key >> shift) & (RadixBuckets - 1)]++] = source[i];
+        std::swap(source, destination);
+    }
+
+    if (source != packets.data()) packets.swap(scratch);
+}
+
+// ============================================================================
+// CONSOLE INTEGRATION
+// ============================================================================
+
+namespace
+{
+    bool SamePackets(const std::vector<DrawPacket>& a, const std::vector<DrawPacket>& b)
+    {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i)
+            if (a[i].key != b[i].key || a[i].payload != b[i].payload) return false;
+        return true;
+    }
+
+    uint32_t CountStateChanges(const std::vector<DrawPacket>& packets)
+    {
+        uint32_t changes = 0;
+        for (size_t i = 0; i < packets.size(); ++i)
+            if (i == 0 || RenderKey::GetStateBits(packets[i].key) != RenderKey::GetStateBits(packets[i - 1].key)) ++changes;
+        return changes;
+    }
+
+    /// Draws of a plausible frame: mostly opaque, a few materials per shader, many meshes
+    std::vector<DrawPacket> MakePackets(size_t count, std::mt19937& rng)
+    {
+        std::uniform_int_distribution<uint32_t> shader(0, 11), material(0, 399), mesh(0, 2999), pass(0, 99);
+        std::uniform_real_distribution<float> depth(0.1f, 1000.0f);
+        std::vector<DrawPacket> packets(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint32_t roll = pass(rng);
+            const RenderPass renderPass = roll < 30 ? RenderPass::DepthPrepass
+                                        : roll < 85 ? RenderPass::Opaque
+                                        : roll < 90 ? RenderPass::GBuffer : RenderPass::Transparent;
+            packets[i].key = RenderKey::Make(renderPass, shader(rng), material(rng), mesh(rng), depth(rng), 0.1f, 1000.0f);
+            packets[i].payload = static_cast<uint32_t>(i);
+            packets[i].reserved = 0;
+        }
+        return packets;
+    }
+}
+
+std::string RenderQueue::Console_Benchmark(int packetCount)
+{
+    using Clock = std::chrono::high_resolution_clock;
+    packetCount = std::clamp(packetCount, 1000, 16000000);
+    std::mt19937 rng(18);
+    int checks = 0, failures = 0;
+    auto check = [&](bool passed) { ++checks; if (!passed) ++failures; };
+
+    // Packing: every field survives a round trip once masked to its width
+    std::uniform_int_distribution<uint32_t> any(0, 0xFFFFFFFFu);
+    for (int i = 0; i < 10000; ++i)
+    {
+        RenderKeyFields fields;
+        fields.pass = static_cast<RenderPass>(i % static_cast<int>(RenderPass::Count));
+        const bool transparent = fields.pass == RenderPass::Transparent;
+        const int idBits = transparent ? RenderKey::TransparentIdBits : 16;
+        const int depthBits = transparent ? RenderKey::TransparentDepthBits : RenderKey::OpaqueDepthBits;
+        fields.shader = any(rng) & 0xFF;
+        fields.material = any(rng) & RenderKey::Mask(idBits);
+        fields.mesh = any(rng) & RenderKey::Mask(idBits);
+        fields.depth = any(rng) & RenderKey::Mask(depthBits);
+
+        const RenderKeyFields unpacked = RenderKey::Unpack(RenderKey::Pack(fields));
+        check(unpacked.pass == fields.pass && unpacked.shader == fields.shader && unpacked.material == fields.material &&
+              unpacked.mesh == fields.mesh && unpacked.depth == fields.depth);
+    }
+
+    // Ordering: passes first, opaque front to back, transparent back to front
+    std::uniform_real_distribution<float> depth(0.1f, 1000.0f);
+    for (int i = 0; i < 10000; ++i)
+    {
+        float nearer = depth(rng), farther = depth(rng);
+        if (nearer > farther) std::swap(nearer, farther);
+        const uint32_t shader = any(rng) & 0xFF, material = any(rng) & 0x3FFF, mesh = any(rng) & 0x3FFF;
+        const uint64_t opaqueNear = RenderKey::Make(RenderPass::Opaque, shader, material, mesh, nearer, 0.1f, 1000.0f);
+        const uint64_t opaqueFar = RenderKey::Make(RenderPass::Opaque, shader, material, mesh, farther, 0.1f, 1000.0f);
+        const uint64_t blendNear = RenderKey::Make(RenderPass::Transparent, shader, material, mesh, nearer, 0.1f, 1000.0f);
+        const uint64_t blendFar = RenderKey::Make(RenderPass::Transparent, any(rng) & 0xFF, any(rng) & 0x3FFF,
+                                                  any(rng) & 0x3FFF, farther, 0.1f, 1000.0f);
+        check(opaqueNear <= opaqueFar);
+        check(blendFar <= blendNear || RenderKey::Unpack(blendFar).depth == RenderKey::Unpack(blendNear).depth);
+        check(RenderKey::Make(RenderPass::DepthPrepass, 255, 0xFFFF, 0xFFFF, 1000.0f, 0.1f, 1000.0f) < opaqueNear);
+        check(opaqueFar < blendFar && opaqueFar < blendNear);
+    }
+    check(RenderKey::QuantizeDepth(-5.0f, 0.1f, 1000.0f, 20) == 0);
+    check(RenderKey::QuantizeDepth(5000.0f, 0.1f, 1000.0f, 20) == RenderKey::Mask(20));
+    check(RenderKey::QuantizeDepth(1000.0f, 0.1f, 1000.0f, 24) == RenderKey::Mask(24));
+    check(RenderKey::QuantizeDepth(std::nanf(""), 0.1f, 1000.0f, 20) == 0);
+
+    // Sorting: radix matches std::stable_sort at awkward sizes, including equal keys
+    auto byKey = [](const DrawPacket& a, const DrawPacket& b) { return a.key < b.key; };
+    std::vector<DrawPacket> scratch;
+    for (size_t size : { size_t(0), size_t(1), size_t(2), size_t(63), size_t(64), size_t(65), size_t(1000), size_t(4097) })
+    {
+        std::vector<DrawPacket> packets = MakePackets(size, rng);
+        for (size_t i = 0; i + 1 < packets.size(); i += 3) packets[i + 1].key = packets[i].key;
+        std::vector<DrawPacket> expected = packets;
+        std::stable_sort(expected.begin(), expected.end(), byKey);
+        RadixSort(packets, scratch);
+        check(SamePackets(packets, expected));
+    }
+
+    // Throughput on a full frame's worth of packets
+    const std::vector<DrawPacket> input = MakePackets(static_cast<size_t>(packetCount), rng);
+    constexpr int Repeats = 5;
+    auto best = [&](auto&& sort, std::vector<DrawPacket>& output) {
+        double bestMs = 1e30;
+        for (int repeat = 0; repeat < Repeats; ++repeat)
+        {
+            output = input;
+            const auto start = Clock::now();
+            sort(output);
+            bestMs = std::min(bestMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+        return bestMs;
+    };
+
+    std::vector<DrawPacket> radixSorted, stdSorted, stableSorted;
+    const double radixMs = best([&](std::vector<DrawPacket>& packets) { RadixSort(packets, scratch); }, radixSorted);
+    const double stdMs = best([&](std::vector<DrawPacket>& packets) { std::sort(packets.begin(), packets.end(), byKey); },
+                              stdSorted);
+    const double stableMs = best([&](std::vector<DrawPacket>& packets) {
+        std::stable_sort(packets.begin(), packets.end(), byKey);
+    }, stableSorted);
+    check(SamePackets(radixSorted, stableSorted));
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "=== Render Queue Benchmark ===\n";
+    ss << "Key checks: " << checks - failures << "/" << checks << " passed\n";
+    ss << packetCount << " packets, best of " << Repeats << "\n";
+    ss << "Radix sort:       " << radixMs << " ms (" << packetCount / radixMs / 1000.0 << " M packets/s)\n";
+    ss << "std::sort:        " << stdMs << " ms (" << stdMs / radixMs << "x radix)\n";
+    ss << "std::stable_sort: " << stableMs << " ms (" << stableMs / radixMs << "x radix)\n";
+    ss << "State changes: " << CountStateChanges(input) << " in push order, " << CountStateChanges(radixSorted)
+       << " sorted\n";
+    return ss.str();
+}
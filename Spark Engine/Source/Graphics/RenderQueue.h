@@ -0,0 +1,166 @@
+/**
+ * @file RenderQueue.h
+ * @brief Draw packets with 64-bit sort keys and a radix-sorted submission queue
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * Each render path pushes one small packet per draw instead of drawing
+ * objects in the order they arrive. The packet's key orders the frame: pass
+ * first, then for opaque passes shader variant, material and mesh with
+ * front-to-back depth breaking ties, so state changes happen once per group
+ * and near objects fill the depth buffer early. Transparent draws put
+ * inverted depth right after the pass so they blend back to front.
+ *
+ * Keys are assembled with shifts and masks only (no bitfields, no type
+ * punning) and sorted by an LSD radix sort that extracts digits by shifting,
+ * so the same inputs produce the same order on every compiler and
+ * architecture. The sort is stable: equal keys keep their push order.
+ */
+
+#pragma once
+
+#include "Utils/Assert.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Render passes in submission order; occupies the top 4 key bits
+ */
+enum class RenderPass : uint8_t
+{
+    DepthPrepass = 0,
+    GBuffer = 1,
+    Opaque = 2,
+    Transparent = 3,
+    Count
+};
+
+/**
+ * @brief Shader variants known to the sort; occupies 8 key bits
+ */
+namespace RenderShader
+{
+    constexpr uint32_t Basic = 0;       ///< GraphicsEngine::SetBasicShaders(), bound once per group
+    constexpr uint32_t Custom = 255;    ///< Object binds its own state in Render(); sorted last within a pass
+}
+
+/**
+ * @brief Unpacked fields of a sort key
+ */
+struct RenderKeyFields
+{
+    RenderPass pass = RenderPass::Opaque;
+    uint32_t shader = 0;
+    uint32_t material = 0;
+    uint32_t mesh = 0;
+    uint32_t depth = 0;     ///< Quantised depth, smaller is nearer
+};
+
+/**
+ * @brief 64-bit draw sort key layout
+ *
+ * Opaque passes:  pass:4 | shader:8 | material:16 | mesh:16 | depth:20
+ * Transparent:    pass:4 | ~depth:24 | shader:8 | material:14 | mesh:14
+ *
+ * Material and mesh IDs wider than their field wrap; that can only merge
+ * groups, never reorder passes or depth within a group.
+ */
+namespace RenderKey
+{
+    constexpr int PassShift = 60;
+
+    constexpr int OpaqueShaderShift = 52;
+    constexpr int OpaqueMaterialShift = 36;
+    constexpr int OpaqueMeshShift = 20;
+    constexpr int OpaqueDepthBits = 20;
+
+    constexpr int TransparentDepthShift = 36;
+    constexpr int TransparentDepthBits = 24;
+    constexpr int TransparentShaderShift = 28;
+    constexpr int TransparentMaterialShift = 14;
+    constexpr int TransparentIdBits = 14;
+
+    constexpr uint64_t Mask(int bits) { return (uint64_t(1) << bits) - 1; }
+
+    /**
+     * @brief Map a view-space depth to [0, 2^bits - 1], clamping outside [nearPlane, farPlane]
+     */
+    uint32_t QuantizeDepth(float viewDepth, float nearPlane, float farPlane, int bits);
+
+    uint64_t Pack(const RenderKeyFields& fields);
+    RenderKeyFields Unpack(uint64_t key);
+
+    inline RenderPass GetPass(uint64_t key) { return static_cast<RenderPass>(key >> PassShift); }
+
+    /**
+     * @brief Key for a draw at a view-space depth; picks the layout from the pass
+     */
+    uint64_t Make(RenderPass pass, uint32_t shader, uint32_t material, uint32_t mesh, float viewDepth, float nearPlane,
+                  float farPlane);
+
+    /**
+     * @brief Pass, shader and material bits: draws sharing them need no state change
+     */
+    uint64_t GetStateBits(uint64_t key);
+}
+
+/**
+ * @brief One draw: sort key plus an index into the submitter's object list
+ */
+struct DrawPacket
+{
+    uint64_t key;
+    uint32_t payload;
+    uint32_t reserved;
+};
+
+/**
+ * @brief Per-frame list of draw packets, sorted in place by key
+ *
+ * Storage is kept between frames, so a steady scene sorts without allocating.
+ * Not thread-safe.
+ */
+class RenderQueue
+{
+public:
+    RenderQueue() = default;
+
+    void Clear() { m_packets.clear(); }
+    void Reserve(size_t count) { m_packets.reserve(count); }
+
+    void Push(uint64_t key, uint32_t payload) { m_packets.push_back({ key, payload, 0u }); }
+
+    /**
+     * @brief Stable ascending sort by key
+     */
+    void Sort();
+
+    const std::vector<DrawPacket>& GetPackets() const { return m_packets; }
+    size_t GetCount() const { return m_packets.size(); }
+
+    /**
+     * @brief Index of the first packet at or after begin whose pass is not before the given pass
+     */
+    size_t FindPass(RenderPass pass, size_t begin = 0) const;
+
+    /**
+     * @brief Stable LSD radix sort on 11-bit digits; digits equal in every key are skipped
+     * @param scratch Resized to match packets and used as the ping-pong buffer
+     */
+    static void RadixSort(std::vector<DrawPacket>& packets, std::vector<DrawPacket>& scratch);
+
+    // ========================================================================
+    // CONSOLE INTEGRATION
+    // ========================================================================
+
+    /**
+     * @brief Check key packing and ordering, then time the radix sort against std::sort
+     * @param packetCount Packets per sort
+     */
+    static std::string Console_Benchmark(int packetCount);
+
+private:
+    std::vector<DrawPacket> m_packets;
+    std::vector<DrawPacket> m_scratch;
+};
@@ -0,0 +1,652 @@
+/**
+ * @file ShadowAtlas.cpp
+ * @brief Implementation of the shadow atlas allocator
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * The quadtree keeps a state per node and a free list per level. Allocating
+ * takes a free node of the requested level or splits one from the level
+ * above; freeing merges four free siblings back into their parent. The
+ * benchmark checks after every frame that no two tiles overlap and that the
+ * atlas budget and importance order hold.
+ */
+
+#include "ShadowAtlas.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+using namespace DirectX;
+
+ShadowAtlas::ShadowAtlas()
+{
+    Configure(m_atlasSize, m_minTileSize, m_maxTileSize);
+}
+
+void ShadowAtlas::Configure(uint32_t atlasSize, uint32_t minTileSize, uint32_t maxTileSize)
+{
+    ASSERT_MSG(std::has_single_bit(atlasSize) && std::has_single_bit(minTileSize) && std::has_single_bit(maxTileSize),
+               "Shadow atlas sizes must be powers of two (atlas %u)", atlasSize);
+    ASSERT_MSG(minTileSize <= maxTileSize && maxTileSize <= atlasSize, "Shadow atlas tile sizes out of order (atlas %u)", atlasSize);
+
+    m_atlasSize = atlasSize;
+    m_minTileSize = minTileSize;
+    m_maxTileSize = maxTileSize;
+    m_levelCount = static_cast<uint32_t>(std::countr_zero(atlasSize / minTileSize)) + 1;
+    ASSERT_MSG(m_levelCount <= MaxLevels, "Shadow atlas has too many levels (%u)", m_levelCount);
+
+    for (uint32_t level = 0; level < MaxLevels; ++level) {
+        const size_t nodes = level < m_levelCount ? size_t(1) << (2 * level) : 0;
+        m_nodeState[level].assign(nodes, NodeAbsent);
+        m_freeSlot[level].assign(nodes, 0);
+        m_freeList[level].clear();
+    }
+    m_slots.clear();
+    m_slotIndex.clear();
+    m_sizeScale = 1.0f;
+    ResetTree();
+}
+
+// ============================================================================
+// QUADTREE
+// ============================================================================
+
+void ShadowAtlas::ResetTree()
+{
+    for (uint32_t level = 0; level < m_levelCount; ++level) {
+        std::fill(m_nodeState[level].begin(), m_nodeState[level].end(), NodeAbsent);
+        m_freeList[level].clear();
+    }
+    PushFree(0, 0);
+}
+
+void ShadowAtlas::PushFree(uint32_t level, uint32_t index)
+{
+    m_nodeState[level][index] = NodeFree;
+    m_freeSlot[level][index] = static_cast<uint32_t>(m_freeList[level].size());
+    m_freeList[level].push_back(index);
+}
+
+void ShadowAtlas::RemoveFree(uint32_t level, uint32_t index)
+{
+    std::vector<uint32_t>& list = m_freeList[level];
+    const uint32_t slot = m_freeSlot[level][index];
+    list[slot] = list.back();
+    m_freeSlot[level][list[slot]] = slot;
+    list.pop_back();
+}
+
+uint32_t ShadowAtlas::AllocateNode(uint32_t level)
+{
+    ASSERT_MSG(level < m_levelCount, "Shadow atlas level %u out of range", level);
+    if (!m_freeList[level].empty()) {
+        const uint32_t index = m_freeList[level].back();
+        m_freeList[level].pop_back();
+        m_nodeState[level][index] = NodeUsed;
+        return (level << LevelShift) | index;
+    }
+    if (level == 0) return InvalidNode;
+
+    // Split a node of the level above: hand out its first child, free the other three
+    const uint32_t parent = AllocateNode(level - 1);
+    if (parent == InvalidNode) return InvalidNode;
+    const uint32_t parentIndex = parent & IndexMask;
+    m_nodeState[level - 1][parentIndex] = NodeSplit;
+
+    const uint32_t parentDim = 1u << (level - 1), dim = parentDim * 2;
+    const uint32_t first = (parentIndex / parentDim) * 2 * dim + (parentIndex % parentDim) * 2;
+    PushFree(level, first + dim + 1);
+    PushFree(level, first + dim);
+    PushFree(level, first + 1);
+    m_nodeState[level][first] = NodeUsed;
+    return (level << LevelShift) | first;
+}
+
+void ShadowAtlas::FreeNode(uint32_t node)
+{
+    uint32_t level = node >> LevelShift, index = node & IndexMask;
+    ASSERT_MSG(level < m_levelCount && m_nodeState[level][index] == NodeUsed, "Freeing shadow atlas node %u that is not in use", node);
+
+    // Merge with the three siblings for as long as they are all free
+    while (level > 0) {
+        const uint32_t dim = 1u << level;
+        const uint32_t first = (index / dim & ~1u) * dim + (index % dim & ~1u);
+        const uint32_t siblings[4] = { first, first + 1, first + dim, first + dim + 1 };
+        bool allFree = true;
+        for (uint32_t sibling : siblings) {
+            allFree = allFree && (sibling == index || m_nodeState[level][sibling] == NodeFree);
+        }
+        if (!allFree) break;
+
+        for (uint32_t sibling : siblings) {
+            if (sibling != index) RemoveFree(level, sibling);
+            m_nodeState[level][sibling] = NodeAbsent;
+        }
+        index = (index / dim / 2) * (dim / 2) + index % dim / 2;
+        level--;
+    }
+    PushFree(level, index);
+}
+
+uint32_t ShadowAtlas::LevelOf(uint32_t tileSize) const
+{
+    return static_cast<uint32_t>(std::countr_zero(m_atlasSize / tileSize));
+}
+
+ShadowAtlasTile ShadowAtlas::TileOf(uint32_t node) const
+{
+    const uint32_t level = node >> LevelShift, index = node & IndexMask;
+    const uint32_t dim = 1u << level, size = m_atlasSize >> level;
+    return ShadowAtlasTile{ (index % dim) * size, (index / dim) * size, size };
+}
+
+// ============================================================================
+// SCORING AND ASSIGNMENT
+// ============================================================================
+
+float ShadowAtlas::ScoreImportance(const XMFLOAT3& position, float range, FXMMATRIX view, CXMMATRIX projection)
+{
+    if (range <= 0.0f) return 0.0f;
+
+    XMFLOAT3 c;
+    XMStoreFloat3(&c, XMVector3TransformCoord(XMLoadFloat3(&position), view));
+    XMFLOAT4X4 p;
+    XMStoreFloat4x4(&p, projection);
+
+    const float distanceSq = c.x * c.x + c.y * c.y + c.z * c.z;
+    if (distanceSq <= range * range) return 1.0f;
+
+    // Behind the camera, or past a side plane of the frustum (x * scale = z, through the eye)
+    if (c.z < -range) return 0.0f;
+    if (std::fabs(c.x) * p._11 - c.z > range * std::sqrt(p._11 * p._11 + 1.0f)) return 0.0f;
+    if (std::fabs(c.y) * p._22 - c.z > range * std::sqrt(p._22 * p._22 + 1.0f)) return 0.0f;
+
+    // Tangent of the sphere's angular radius over the tangent of half the vertical field of view
+    return std::min(1.0f, range * p._22 / std::sqrt(distanceSq - range * range));
+}
+
+uint32_t ShadowAtlas::ChooseSize(float idealSize, uint32_t currentSize) const
+{
+    // A light keeps its size until the ideal leaves [current, 2 * current) by more than the hysteresis
+    if (currentSize != 0 && idealSize >= currentSize / (1.0f + m_hysteresis) &&
+        idealSize < 2.0f * currentSize * (1.0f + m_hysteresis)) {
+        return currentSize;
+    }
+    uint32_t size = m_minTileSize;
+    while (size < m_maxTileSize && 2.0f * size <= idealSize) size *= 2;
+    return size;
+}
+
+void ShadowAtlas::Update(const ShadowAtlasRequest* requests, size_t count, FXMMATRIX view, CXMMATRIX projection)
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+    m_frameIndex++;
+    m_stats = Stats{};
+    m_stats.requested = static_cast<uint32_t>(count);
+    for (Slot& slot : m_slots) {
+        slot.allocation.placed = false;
+        slot.desiredSize = 0;
+    }
+
+    // Score, most important first
+    m_scores.resize(count);
+    m_order.resize(count);
+    m_current.resize(count);
+    m_sizes.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const ShadowAtlasRequest& request = requests[i];
+        ASSERT_MSG(request.owner != nullptr && request.faceCount >= 1 && request.faceCount <= ShadowAtlasAllocation::MaxFaces,
+                   "Invalid shadow atlas request %u", static_cast<uint32_t>(i));
+        m_scores[i] = ScoreImportance(request.position, request.range, view, projection) * std::max(request.priority, 0.0f);
+        m_order[i] = static_cast<uint32_t>(i);
+        auto it = m_slotIndex.find(request.owner);
+        const ShadowAtlasAllocation* held = it != m_slotIndex.end() ? &m_slots[it->second].allocation : nullptr;
+        m_current[i] = held && held->faceCount == request.faceCount ? held->tileSize : 0;
+    }
+    std::sort(m_order.begin(), m_order.end(), [this](uint32_t a, uint32_t b) {
+        return m_scores[a] != m_scores[b] ? m_scores[a] > m_scores[b] : a < b;
+    });
+
+    // Ideal sizes follow screen coverage times a scale shared by every light. The scale creeps back
+    // up while the sizes fit and drops as soon as they do not, so sizes settle instead of flickering
+    const uint64_t budget = uint64_t(m_atlasSize) * m_atlasSize;
+    auto area = [&](size_t i) { return uint64_t(requests[i].faceCount) * m_sizes[i] * m_sizes[i]; };
+    auto computeDemand = [&](float scale) {
+        uint64_t total = 0;
+        for (size_t i = 0; i < count; ++i) {
+            m_sizes[i] = m_scores[i] > 0.0f ? ChooseSize(m_scores[i] * static_cast<float>(m_maxTileSize) * scale, m_current[i]) : 0;
+            total += area(i);
+        }
+        return total;
+    };
+    const float minScale = 0.5f * static_cast<float>(m_minTileSize) / static_cast<float>(m_maxTileSize);
+    float scale = std::min(1.0f, m_sizeScale * 1.1f);
+    uint64_t demand = computeDemand(scale);
+    if (demand > budget && scale > m_sizeScale) {
+        scale = m_sizeScale;
+        demand = computeDemand(scale);
+    }
+    for (int iteration = 0; iteration < 8 && demand > budget && scale > minScale; ++iteration) {
+        scale = std::max(minScale, scale * static_cast<float>(std::sqrt(static_cast<double>(budget) / static_cast<double>(demand))));
+        demand = computeDemand(scale);
+    }
+    m_sizeScale = scale;
+    m_stats.sizeScale = scale;
+
+    // Whatever still does not fit is halved, then dropped, least important first
+    while (demand > budget) {
+        bool shrunk = false;
+        for (auto it = m_order.rbegin(); it != m_order.rend() && demand > budget; ++it) {
+            if (m_sizes[*it] > m_minTileSize) {
+                demand -= area(*it);
+                m_sizes[*it] /= 2;
+                demand += area(*it);
+                shrunk = true;
+            }
+        }
+        if (shrunk) continue;
+        for (auto it = m_order.rbegin(); it != m_order.rend() && demand > budget; ++it) {
+            demand -= area(*it);
+            m_sizes[*it] = 0;
+        }
+    }
+
+    // Lights keep their tiles unless they shrink; growing lights move only if there is room
+    for (size_t i = 0; i < count; ++i) {
+        const ShadowAtlasRequest& request = requests[i];
+        auto [it, inserted] = m_slotIndex.try_emplace(request.owner, static_cast<uint32_t>(m_slots.size()));
+        if (inserted) {
+            m_slots.emplace_back();
+            m_slots.back().allocation.owner = request.owner;
+        }
+        Slot& slot = m_slots[it->second];
+        ASSERT_MSG(slot.allocation.lastFrame != m_frameIndex, "Light requested twice in one shadow atlas update (%u)",
+                   static_cast<uint32_t>(i));
+        if (slot.allocation.faceCount != request.faceCount || m_sizes[i] < slot.allocation.tileSize) {
+            FreeSlotTiles(slot);
+        }
+        slot.allocation.faceCount = request.faceCount;
+        slot.allocation.importance = m_scores[i];
+        slot.allocation.lastFrame = m_frameIndex;
+        slot.desiredSize = m_sizes[i];
+    }
+
+    // Lights not requested for a while give their tiles back
+    for (uint32_t s = 0; s < m_slots.size();) {
+        if (m_frameIndex - m_slots[s].allocation.lastFrame > m_evictFrames) {
+            if (m_slots[s].allocation.tileSize != 0) m_stats.evicted++;
+            FreeSlotTiles(m_slots[s]);
+            EraseSlot(s);
+        } else {
+            ++s;
+        }
+    }
+
+    // Place lights without tiles first, then growing ones; largest first within each
+    m_pending.clear();
+    for (uint32_t s = 0; s < m_slots.size(); ++s) {
+        if (m_slots[s].desiredSize != 0 && m_slots[s].allocation.tileSize != m_slots[s].desiredSize) m_pending.push_back(s);
+    }
+    std::sort(m_pending.begin(), m_pending.end(), [this](uint32_t a, uint32_t b) {
+        const Slot& slotA = m_slots[a];
+        const Slot& slotB = m_slots[b];
+        if ((slotA.allocation.tileSize == 0) != (slotB.allocation.tileSize == 0)) return slotA.allocation.tileSize == 0;
+        if (slotA.desiredSize != slotB.desiredSize) return slotA.desiredSize > slotB.desiredSize;
+        return slotA.allocation.importance != slotB.allocation.importance ? slotA.allocation.importance > slotB.allocation.importance : a < b;
+    });
+    bool reclaimed = false;
+    for (uint32_t s : m_pending) {
+        Slot& slot = m_slots[s];
+        bool placed = PlaceSlot(slot, slot.desiredSize);
+        if (!placed && !reclaimed) {
+            // Take back the tiles of lights that were not requested this frame, then try again
+            reclaimed = true;
+            for (Slot& other : m_slots) {
+                if (other.allocation.lastFrame != m_frameIndex && other.allocation.tileSize != 0) {
+                    FreeSlotTiles(other);
+                    m_stats.evicted++;
+                }
+            }
+            placed = PlaceSlot(slot, slot.desiredSize);
+        }
+        if (placed || slot.allocation.tileSize != 0) continue;
+
+        // Fragmented: settle for a smaller tile this frame, and lay everything out again if even that fails
+        for (uint32_t size = slot.desiredSize / 2; !placed && size >= m_minTileSize; size /= 2) {
+            placed = PlaceSlot(slot, size);
+        }
+        if (!placed) {
+            Repack();
+            break;
+        }
+    }
+
+    for (const Slot& slot : m_slots) {
+        const ShadowAtlasAllocation& allocation = slot.allocation;
+        if (allocation.placed) m_stats.placed++;
+        if (allocation.lastFrame != m_frameIndex) continue;
+        if (allocation.tileSize != 0) {
+            m_stats.shadowed++;
+            m_stats.usedTexels += uint64_t(allocation.faceCount) * allocation.tileSize * allocation.tileSize;
+        } else if (allocation.importance > 0.0f) {
+            m_stats.dropped++;
+        } else {
+            m_stats.offscreen++;
+        }
+    }
+
+    m_updateTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+void ShadowAtlas::Repack()
+{
+    ResetTree();
+    m_pending.clear();
+    for (uint32_t s = 0; s < m_slots.size(); ++s) {
+        ShadowAtlasAllocation& allocation = m_slots[s].allocation;
+        if (allocation.tileSize != 0 && m_slots[s].desiredSize == 0) m_stats.evicted++;
+        allocation.tileSize = 0;
+        if (m_slots[s].desiredSize != 0) m_pending.push_back(s);
+    }
+    std::sort(m_pending.begin(), m_pending.end(), [this](uint32_t a, uint32_t b) {
+        return m_slots[a].desiredSize != m_slots[b].desiredSize ? m_slots[a].desiredSize > m_slots[b].desiredSize : a < b;
+    });
+
+    // Power-of-two tiles placed largest first into an empty quadtree fill it without gaps
+    // and cannot fail while the sizes fit the budget; if they somehow do not, the
+    // light settles for a smaller tile or goes unshadowed and is counted as dropped
+    for (uint32_t s : m_pending) {
+        bool placed = PlaceSlot(m_slots[s], m_slots[s].desiredSize);
+        ASSERT_MSG(placed, "Shadow atlas repack failed at a %u texel tile", m_slots[s].desiredSize);
+        for (uint32_t size = m_slots[s].desiredSize / 2; !placed && size >= m_minTileSize; size /= 2) {
+            placed = PlaceSlot(m_slots[s], size);
+        }
+    }
+    m_stats.repacks = 1;
+    m_totalRepacks++;
+}
+
+bool ShadowAtlas::PlaceSlot(Slot& slot, uint32_t tileSize)
+{
+    // New tiles are taken before the old ones are let go, so a failed move leaves the light as it was
+    ShadowAtlasAllocation& allocation = slot.allocation;
+    const uint32_t level = LevelOf(tileSize);
+    uint32_t nodes[ShadowAtlasAllocation::MaxFaces];
+    for (uint32_t face = 0; face < allocation.faceCount; ++face) {
+        nodes[face] = AllocateNode(level);
+        if (nodes[face] == InvalidNode) {
+            while (face > 0) FreeNode(nodes[--face]);
+            return false;
+        }
+    }
+    FreeSlotTiles(slot);
+    for (uint32_t face = 0; face < allocation.faceCount; ++face) {
+        slot.nodes[face] = nodes[face];
+        allocation.tiles[face] = TileOf(nodes[face]);
+    }
+    allocation.tileSize = tileSize;
+    allocation.placed = true;
+    return true;
+}
+
+void ShadowAtlas::FreeSlotTiles(Slot& slot)
+{
+    ShadowAtlasAllocation& allocation = slot.allocation;
+    if (allocation.tileSize == 0) return;
+    for (uint32_t face = 0; face < allocation.faceCount; ++face) {
+        FreeNode(slot.nodes[face]);
+        allocation.tiles[face] = ShadowAtlasTile{};
+    }
+    allocation.tileSize = 0;
+}
+
+void ShadowAtlas::EraseSlot(uint32_t slotIndex)
+{
+    m_slotIndex.erase(m_slots[slotIndex].allocation.owner);
+    if (slotIndex + 1 != m_slots.size()) {
+        m_slots[slotIndex] = m_slots.back();
+        m_slotIndex[m_slots[slotIndex].allocation.owner] = slotIndex;
+    }
+    m_slots.pop_back();
+}
+
+const ShadowAtlasAllocation* ShadowAtlas::Find(const void* owner) const
+{
+    auto it = m_slotIndex.find(owner);
+    return it != m_slotIndex.end() ? &m_slots[it->second].allocation : nullptr;
+}
+
+void ShadowAtlas::Release(const void* owner)
+{
+    auto it = m_slotIndex.find(owner);
+    if (it == m_slotIndex.end()) return;
+    const uint32_t slotIndex = it->second;
+    FreeSlotTiles(m_slots[slotIndex]);
+    EraseSlot(slotIndex);
+}
+
+XMFLOAT4 ShadowAtlas::GetTileRect(const ShadowAtlasTile& tile) const
+{
+    const float texel = 1.0f / static_cast<float>(m_atlasSize);
+    return XMFLOAT4(tile.x * texel, tile.y * texel, tile.size * texel, tile.size * texel);
+}
+
+XMMATRIX ShadowAtlas::GetFaceView(const XMFLOAT3& position, uint32_t face)
+{
+    static const XMFLOAT3 directions[ShadowAtlasAllocation::MaxFaces] = {
+        { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }
+    };
+    static const XMFLOAT3 ups[ShadowAtlasAllocation::MaxFaces] = {
+        { 0, 1, 0 }, { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 }, { 0, 1, 0 }, { 0, 1, 0 }
+    };
+    ASSERT_MSG(face < ShadowAtlasAllocation::MaxFaces, "Cube face %u out of range", face);
+    return XMMatrixLookToLH(XMLoadFloat3(&position), XMLoadFloat3(&directions[face]), XMLoadFloat3(&ups[face]));
+}
+
+// ============================================================================
+// CONSOLE INTEGRATION
+// ============================================================================
+
+std::string ShadowAtlas::Console_GetStats() const
+{
+    const double atlasTexels = double(m_atlasSize) * m_atlasSize;
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "=== Shadow Atlas ===\n";
+    ss << "Atlas:            " << m_atlasSize << "^2, tiles " << m_minTileSize << " - " << m_maxTileSize << "\n";
+    ss << "Lights:           " << m_stats.requested << " requested, " << m_stats.shadowed << " shadowed, " << m_stats.offscreen
+       << " off screen, " << m_stats.dropped << " dropped\n";
+    ss << "Placement:        " << m_stats.placed << " placed, " << m_stats.evicted << " evicted, " << m_totalRepacks << " repacks in total\n";
+    ss << "Used:             " << std::setprecision(1) << 100.0 * static_cast<double>(m_stats.usedTexels) / atlasTexels
+       << "% of the atlas, size scale " << std::setprecision(3) << m_stats.sizeScale << "\n";
+    ss << "Update time:      " << m_updateTime << " ms\n";
+    return ss.str();
+}
+
+std::string ShadowAtlas::Console_Benchmark(int lightCount)
+{
+    lightCount = std::clamp(lightCount, 16, 4096);
+    constexpr uint32_t AtlasSize = 4096, MinTile = 64, MaxTile = 1024;
+    constexpr uint32_t Frames = 300;
+    constexpr uint32_t StillBegin = 120, StillEnd = 180;       // Camera holds still, lights keep flickering
+    constexpr uint32_t AwayBegin = 200, AwayEnd = 230;         // A quarter of the lights are not requested
+    constexpr uint32_t Cells = AtlasSize / MinTile;
+
+    // Every minimum-size cell of the atlas must be covered by exactly one free or used node
+    auto checkTree = [](const ShadowAtlas& atlas, const std::vector<uint32_t>& used) {
+        const uint32_t cells = atlas.m_atlasSize / atlas.m_minTileSize;
+        std::vector<uint8_t> cover(size_t(cells) * cells, 0);
+        uint32_t faults = 0;
+        auto stamp = [&](uint32_t node) {
+            const ShadowAtlasTile tile = atlas.TileOf(node);
+            for (uint32_t y = tile.y / atlas.m_minTileSize; y < (tile.y + tile.size) / atlas.m_minTileSize; ++y) {
+                for (uint32_t x = tile.x / atlas.m_minTileSize; x < (tile.x + tile.size) / atlas.m_minTileSize; ++x) {
+                    if (cover[size_t(y) * cells + x]++ != 0) faults++;
+                }
+            }
+        };
+        for (uint32_t node : used) stamp(node);
+        for (uint32_t level = 0; level < atlas.m_levelCount; ++level) {
+            for (uint32_t index : atlas.m_freeList[level]) stamp((level << LevelShift) | index);
+        }
+        for (uint8_t c : cover) {
+            if (c == 0) faults++;
+        }
+        return faults;
+    };
+
+    // Allocator: fill with minimum tiles, free them all, then random traffic
+    ShadowAtlas tree;
+    tree.Configure(AtlasSize, MinTile, MaxTile);
+    const uint32_t minLevel = tree.LevelOf(MaxTile), maxLevel = tree.LevelOf(MinTile);
+    std::vector<uint32_t> held;
+    for (uint32_t node; (node = tree.AllocateNode(maxLevel)) != InvalidNode;) held.push_back(node);
+    const bool filled = held.size() == size_t(Cells) * Cells && checkTree(tree, held) == 0;
+    for (uint32_t node : held) tree.FreeNode(node);
+    held.clear();
+    bool merged = tree.m_freeList[0].size() == 1;
+    for (uint32_t level = 1; level < tree.m_levelCount; ++level) merged = merged && tree.m_freeList[level].empty();
+
+    std::mt19937 rng(41);
+    uint32_t treeFaults = 0, failedAllocations = 0;
+    for (int op = 0; op < 20000; ++op) {
+        if (held.empty() || rng() % 100 < 55) {
+            const uint32_t node = tree.AllocateNode(minLevel + rng() % (maxLevel - minLevel + 1));
+            if (node != InvalidNode) held.push_back(node); else failedAllocations++;
+        } else {
+            const size_t pick = rng() % held.size();
+            tree.FreeNode(held[pick]);
+            held[pick] = held.back();
+            held.pop_back();
+        }
+        if (op % 1000 == 999) treeFaults += checkTree(tree, held);
+    }
+
+    // Scoring: camera at the origin looking down +z
+    const XMMATRIX identity = XMMatrixIdentity();
+    const XMMATRIX projection = XMMatrixPerspectiveFovLH(XMConvertToRadians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+    const float inside = ScoreImportance({ 1, 0, 2 }, 5.0f, identity, projection);
+    const float near50 = ScoreImportance({ 0, 0, 50 }, 5.0f, identity, projection);
+    const float far100 = ScoreImportance({ 0, 0, 100 }, 5.0f, identity, projection);
+    const float behind = ScoreImportance({ 0, 0, -20 }, 5.0f, identity, projection);
+    const float aside = ScoreImportance({ 200, 0, 10 }, 5.0f, identity, projection);
+    const float edge = ScoreImportance({ 104, 0, 100 }, 5.0f, identity, projection);     // Centre just outside, sphere overlaps
+    const bool scoring = inside == 1.0f && behind == 0.0f && aside == 0.0f && edge > 0.0f &&
+                         std::fabs(near50 / far100 - 2.0f) < 0.05f;
+
+    // Scene: spot and point lights over a town-sized area, the camera circling through it
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    struct SceneLight
+    {
+        XMFLOAT3 position;
+        float range;
+        uint32_t faces;
+    };
+    std::vector<SceneLight> lights(lightCount);
+    for (SceneLight& light : lights) {
+        light.position = XMFLOAT3(400.0f * unit(rng) - 200.0f, 0.5f + 7.5f * unit(rng), 400.0f * unit(rng) - 200.0f);
+        light.range = 4.0f + 16.0f * unit(rng);
+        light.faces = unit(rng) < 0.3f ? 6 : 1;
+    }
+
+    ShadowAtlas atlas;
+    atlas.Configure(AtlasSize, MinTile, MaxTile);
+    std::vector<ShadowAtlasRequest> requests;
+    std::vector<uint16_t> cover(size_t(Cells) * Cells);
+    double totalMs = 0.0, worstMs = 0.0;
+    uint64_t overlaps = 0, overBudget = 0, inversions = 0, stillPlacements = 0, movingPlacements = 0, usedTexels = 0;
+    uint64_t shadowed = 0, dropped = 0, offscreen = 0;
+    uint32_t returnedWithTiles = 0, returned = 0;
+    float angle = 0.0f;
+    for (uint32_t frame = 0; frame < Frames; ++frame) {
+        if (frame < StillBegin || frame >= StillEnd) angle += 0.01f;
+        const XMVECTOR eye = XMVectorSet(120.0f * std::cos(angle), 6.0f, 120.0f * std::sin(angle), 1.0f);
+        const XMVECTOR forward = XMVectorSet(-std::sin(angle), -0.05f, std::cos(angle), 0.0f);
+        const XMMATRIX view = XMMatrixLookToLH(eye, forward, XMVectorSet(0, 1, 0, 0));
+
+        // Lights flicker a little in position every frame
+        requests.clear();
+        for (uint32_t i = 0; i < static_cast<uint32_t>(lightCount); ++i) {
+            lights[i].position.x += 0.01f * (unit(rng) - 0.5f);
+            if (i % 4 == 0 && frame >= AwayBegin && frame < AwayEnd) continue;
+            requests.push_back({ &lights[i], lights[i].position, lights[i].range, lights[i].faces, 1.0f });
+        }
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        atlas.Update(requests.data(), requests.size(), view, projection);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        totalMs += ms;
+        worstMs = std::max(worstMs, ms);
+
+        // Tiles inside the atlas and disjoint; the dropped lights the least important ones
+        std::fill(cover.begin(), cover.end(), 0);
+        float minShadowed = 2.0f, maxDropped = -1.0f;
+        for (const ShadowAtlasRequest& request : requests) {
+            const ShadowAtlasAllocation* allocation = atlas.Find(request.owner);
+            if (!allocation) continue;
+            if (allocation->tileSize != 0) {
+                minShadowed = std::min(minShadowed, allocation->importance);
+                for (uint32_t face = 0; face < allocation->faceCount; ++face) {
+                    const ShadowAtlasTile& tile = allocation->tiles[face];
+                    if (tile.x + tile.size > AtlasSize || tile.y + tile.size > AtlasSize) overlaps++;
+                    for (uint32_t y = tile.y / MinTile; y < std::min(Cells, (tile.y + tile.size) / MinTile); ++y) {
+                        for (uint32_t x = tile.x / MinTile; x < std::min(Cells, (tile.x + tile.size) / MinTile); ++x) {
+                            if (cover[size_t(y) * Cells + x]++ != 0) overlaps++;
+                        }
+                    }
+                }
+            } else if (allocation->importance > 0.0f) {
+                maxDropped = std::max(maxDropped, allocation->importance);
+            }
+            if (frame == AwayEnd && allocation->importance > 0.0f && (static_cast<const SceneLight*>(request.owner) - &lights[0]) % 4 == 0) {
+                returned++;
+                if (allocation->tileSize != 0 && !allocation->placed) returnedWithTiles++;
+            }
+        }
+        if (maxDropped > minShadowed) inversions++;
+
+        const Stats& stats = atlas.GetStats();
+        if (stats.usedTexels > uint64_t(AtlasSize) * AtlasSize) overBudget++;
+        if (frame > StillBegin && frame < StillEnd) stillPlacements += stats.placed;
+        else if (frame > 0) movingPlacements += stats.placed;
+        usedTexels += stats.usedTexels;
+        shadowed += stats.shadowed;
+        dropped += stats.dropped;
+        offscreen += stats.offscreen;
+    }
+
+    // Releasing every light must give the whole atlas back as one free tile
+    for (const SceneLight& light : lights) atlas.Release(&light);
+    const bool drained = atlas.m_slots.empty() && atlas.m_freeList[0].size() == 1;
+
+    const uint32_t movingFrames = Frames - 1 - (StillEnd - StillBegin - 1);
+    const bool passed = filled && merged && treeFaults == 0 && scoring && overlaps == 0 && overBudget == 0 && inversions == 0 &&
+                        stillPlacements == 0 && drained;
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "=== Shadow Atlas Benchmark ===\n";
+    ss << lightCount << " lights (30% point), atlas " << AtlasSize << "^2, tiles " << MinTile << " - " << MaxTile << ", "
+       << Frames << " frames\n";
+    ss << "Update:       " << totalMs / Frames << " ms average, " << worstMs << " ms worst\n";
+    ss << std::setprecision(1);
+    ss << "Lights:       " << static_cast<double>(shadowed) / Frames << " shadowed, " << static_cast<double>(offscreen) / Frames
+       << " off screen, " << static_cast<double>(dropped) / Frames << " dropped per frame\n";
+    ss << "Used:         " << 100.0 * static_cast<double>(usedTexels) / Frames / (double(AtlasSize) * AtlasSize) << "% of the atlas\n";
+    ss << "Placements:   " << static_cast<double>(movingPlacements) / movingFrames << " per moving frame, " << stillPlacements
+       << " while the camera held still, " << atlas.GetTotalRepacks() << " repacks\n";
+    ss << "Returning:    " << returnedWithTiles << " of " << returned << " lights back on screen after " << (AwayEnd - AwayBegin)
+       << " frames still had their tiles\n";
+    ss << "Allocator:    fill " << (filled ? "ok" : "FAILED") << ", merge " << (merged ? "ok" : "FAILED") << ", "
+       << treeFaults << " faults in 20000 random operations (" << failedAllocations << " full)\n";
+    ss << std::setprecision(3);
+    ss << "Scoring:      inside " << inside << ", 50 m " << near50 << ", 100 m " << far100 << ", behind " << behind
+       << ", aside " << aside << ", edge " << edge << " (" << (scoring ? "ok" : "FAILED") << ")\n";
+    ss << "Checks:       " << overlaps << " overlaps, " << overBudget << " frames over budget, " << inversions
+       << " importance inversions, release " << (drained ? "ok" : "LEAKED") << " (" << (passed ? "passed" : "FAILED") << ")\n";
+    return ss.str();
+}
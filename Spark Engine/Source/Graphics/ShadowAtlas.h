@@ -0,0 +1,229 @@
+/**
+ * @file ShadowAtlas.h
+ * @brief Quadtree shadow atlas for spot and point lights, sized by screen-space importance
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * All local lights share one depth texture. Each frame every shadowed light
+ * is scored by how much of the screen its range sphere covers (zero when the
+ * sphere is outside the view frustum), and the score picks a power-of-two
+ * tile size between the minimum and maximum tile. When the requests do not
+ * fit, every size is scaled down together; what still does not fit is
+ * halved, then dropped, from the least important light up. Point lights take
+ * six tiles, one per cube face.
+ *
+ * Tiles come from a quadtree (buddy) allocator over the atlas. A light keeps
+ * its tiles while its size stays within a hysteresis band, so placement is
+ * stable from frame to frame and cached shadow maps stay valid; only lights
+ * whose size changes are moved, and a growing light only moves when a larger
+ * tile is free. Lights that stop being requested keep their tiles for a few
+ * frames unless the space is needed. If fragmentation leaves no room for a
+ * light even at a smaller tile, the whole atlas is repacked largest first,
+ * which always fits because the sizes are powers of two within the budget.
+ *
+ * Scoring and packing are plain CPU code with no graphics API, so they run
+ * and benchmark headless.
+ */
+
+#pragma once
+
+#include "Utils/Assert.h"
+#include <DirectXMath.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief A light asking for shadow tiles this frame
+ */
+struct ShadowAtlasRequest
+{
+    const void* owner = nullptr;            ///< Light the tiles belong to; the same object every frame
+    DirectX::XMFLOAT3 position{};           ///< World position of the light
+    float range = 0.0f;                     ///< Radius of influence
+    uint32_t faceCount = 1;                 ///< 1 for spot lights, 6 for point lights (one per cube face)
+    float priority = 1.0f;                  ///< Multiplies the screen-space importance
+};
+
+/**
+ * @brief Square region of the atlas, in texels
+ */
+struct ShadowAtlasTile
+{
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t size = 0;
+};
+
+/**
+ * @brief Tiles of one light
+ */
+struct ShadowAtlasAllocation
+{
+    static constexpr uint32_t MaxFaces = 6;
+
+    const void* owner = nullptr;
+    uint32_t faceCount = 0;
+    uint32_t tileSize = 0;                  ///< 0 when the light has no tiles (dropped, off screen, or evicted)
+    ShadowAtlasTile tiles[MaxFaces];
+    float importance = 0.0f;                ///< Score of the last frame the light was requested
+    uint32_t lastFrame = 0;                 ///< Last frame the light was requested
+    bool placed = false;                    ///< Tiles given or moved this frame; their depth is undefined
+};
+
+/**
+ * @brief Shadow atlas allocator; Update() once per frame with every shadowed local light
+ */
+class ShadowAtlas
+{
+public:
+    static constexpr uint32_t MaxLevels = 12;
+    static constexpr uint32_t DefaultEvictFrames = 60;
+    static constexpr float DefaultHysteresis = 0.25f;
+
+    /**
+     * @brief Counts of the last Update()
+     */
+    struct Stats
+    {
+        uint32_t requested = 0;             ///< Lights asking for tiles
+        uint32_t shadowed = 0;              ///< Lights holding tiles
+        uint32_t offscreen = 0;             ///< Lights whose range misses the view frustum
+        uint32_t dropped = 0;               ///< On screen, but the atlas had no room left
+        uint32_t placed = 0;                ///< Lights given new tiles (new, resized, or repacked)
+        uint32_t evicted = 0;               ///< Lights no longer requested whose tiles were freed
+        uint32_t repacks = 0;               ///< 1 if fragmentation forced a full repack
+        uint64_t usedTexels = 0;            ///< Texels held by requested lights
+        float sizeScale = 1.0f;             ///< Applied to every tile size to fit the budget
+    };
+
+    ShadowAtlas();
+
+    /**
+     * @brief Set the atlas and tile sizes, all powers of two; frees every tile
+     */
+    void Configure(uint32_t atlasSize, uint32_t minTileSize, uint32_t maxTileSize);
+
+    uint32_t GetAtlasSize() const { return m_atlasSize; }
+    uint32_t GetMinTileSize() const { return m_minTileSize; }
+    uint32_t GetMaxTileSize() const { return m_maxTileSize; }
+
+    /**
+     * @brief Frames a light that is no longer requested keeps its tiles when the space is not needed
+     */
+    void SetEvictFrames(uint32_t frames) { m_evictFrames = frames; }
+
+    /**
+     * @brief How far past a size boundary the ideal size must move before a light changes tile size
+     */
+    void SetHysteresis(float fraction) { m_hysteresis = fraction; }
+
+    /**
+     * @brief Fraction of the screen height covered by a light's range sphere
+     * @return 1 when the camera is inside the sphere, 0 when the sphere is outside the view frustum
+     */
+    static float ScoreImportance(const DirectX::XMFLOAT3& position, float range, DirectX::FXMMATRIX view,
+                                 DirectX::CXMMATRIX projection);
+
+    /**
+     * @brief Score the requests against the camera and assign tiles
+     * @param projection Left-handed perspective projection of the camera
+     */
+    void Update(const ShadowAtlasRequest* requests, size_t count, DirectX::FXMMATRIX view, DirectX::CXMMATRIX projection);
+
+    /**
+     * @brief Tiles of a light, or null if it has never been requested or was evicted
+     */
+    const ShadowAtlasAllocation* Find(const void* owner) const;
+
+    /**
+     * @brief Free a light's tiles at once, e.g. when the light is removed
+     */
+    void Release(const void* owner);
+
+    /**
+     * @brief Atlas UV rectangle of a tile: x, y offset and width, height
+     */
+    DirectX::XMFLOAT4 GetTileRect(const ShadowAtlasTile& tile) const;
+
+    /**
+     * @brief View matrix of a cube face: +X, -X, +Y, -Y, +Z, -Z, for a 90 degree projection
+     */
+    static DirectX::XMMATRIX GetFaceView(const DirectX::XMFLOAT3& position, uint32_t face);
+
+    const Stats& GetStats() const { return m_stats; }
+    uint32_t GetTotalRepacks() const { return m_totalRepacks; }
+    float GetUpdateTime() const { return m_updateTime; }
+
+    std::string Console_GetStats() const;
+
+    /**
+     * @brief Allocate for a moving camera among many lights, with allocator, scoring and stability checks
+     */
+    static std::string Console_Benchmark(int lightCount);
+
+private:
+    static constexpr uint32_t InvalidNode = 0xFFFFFFFFu;
+    static constexpr uint32_t LevelShift = 24;
+    static constexpr uint32_t IndexMask = (1u << LevelShift) - 1;
+
+    enum NodeState : uint8_t
+    {
+        NodeAbsent,     ///< Inside a larger free or used node
+        NodeFree,
+        NodeUsed,
+        NodeSplit       ///< Divided into four children
+    };
+
+    struct Slot
+    {
+        ShadowAtlasAllocation allocation;
+        uint32_t nodes[ShadowAtlasAllocation::MaxFaces];
+        uint32_t desiredSize = 0;           ///< Tile size chosen this frame; 0 if not requested or no room
+    };
+
+    // Quadtree
+    void ResetTree();
+    uint32_t AllocateNode(uint32_t level);
+    void FreeNode(uint32_t node);
+    void PushFree(uint32_t level, uint32_t index);
+    void RemoveFree(uint32_t level, uint32_t index);
+    uint32_t LevelOf(uint32_t tileSize) const;
+    ShadowAtlasTile TileOf(uint32_t node) const;
+
+    // Slots
+    bool PlaceSlot(Slot& slot, uint32_t tileSize);
+    void FreeSlotTiles(Slot& slot);
+    void EraseSlot(uint32_t slotIndex);
+    uint32_t ChooseSize(float idealSize, uint32_t currentSize) const;
+    void Repack();
+
+    uint32_t m_atlasSize = 4096;
+    uint32_t m_minTileSize = 64;
+    uint32_t m_maxTileSize = 1024;
+    uint32_t m_levelCount = 0;
+    uint32_t m_evictFrames = DefaultEvictFrames;
+    float m_hysteresis = DefaultHysteresis;
+    float m_sizeScale = 1.0f;                       ///< Shared tile size scale, kept between frames
+
+    std::vector<uint8_t> m_nodeState[MaxLevels];
+    std::vector<uint32_t> m_freeList[MaxLevels];
+    std::vector<uint32_t> m_freeSlot[MaxLevels];    ///< Position of each free node in its free list
+
+    std::vector<Slot> m_slots;
+    std::unordered_map<const void*, uint32_t> m_slotIndex;
+    uint32_t m_frameIndex = 0;
+
+    // Per-frame scratch
+    std::vector<float> m_scores;
+    std::vector<uint32_t> m_order;
+    std::vector<uint32_t> m_current;
+    std::vector<uint32_t> m_sizes;
+    std::vector<uint32_t> m_pending;
+
+    Stats m_stats;
+    uint32_t m_totalRepacks = 0;
+    float m_updateTime = 0.0f;
+};
@@ -0,0 +1,355 @@
+/**
+ * @file ShadowCache.cpp
+ * @brief Implementation of shadow map dirty tracking
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * The benchmark drives the cache with a synthetic scene and carries out every
+ * plan against a model that records which light, static casters and dynamic
+ * casters each map and static layer were drawn with. A map that differs from
+ * a full redraw after its plan is counted as stale.
+ */
+
+#include "ShadowCache.h"
+#include "CommandBuffer.h"
+#include "RenderBackend.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+using namespace DirectX;
+
+// ============================================================================
+// HASHING
+// ============================================================================
+
+void ShadowHash::Add(uint64_t value)
+{
+    // splitmix64 finalizer over the running value and the new word
+    uint64_t x = m_value ^ (value + 0x9E3779B97F4A7C15ull + (m_value << 6) + (m_value >> 2));
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    m_value = x;
+    m_count++;
+}
+
+void ShadowHash::AddFloats(const float* values, size_t count)
+{
+    size_t i = 0;
+    for (; i + 1 < count; i += 2) {
+        uint64_t bits;
+        std::memcpy(&bits, values + i, sizeof(bits));
+        Add(bits);
+    }
+    if (i < count) {
+        uint32_t bits;
+        std::memcpy(&bits, values + i, sizeof(bits));
+        Add(bits);
+    }
+}
+
+void ShadowHash::AddMatrix(FXMMATRIX matrix)
+{
+    XMFLOAT4X4 stored;
+    XMStoreFloat4x4(&stored, matrix);
+    AddFloats(&stored.m[0][0], 16);
+}
+
+// ============================================================================
+// PLANNING
+// ============================================================================
+
+uint64_t ShadowCache::MakeKey(const void* owner, uint32_t index)
+{
+    ShadowHash hash;
+    hash.AddPointer(owner);
+    hash.Add(index);
+    return hash.Get();
+}
+
+void ShadowCache::SetEnabled(bool enabled)
+{
+    if (m_enabled != enabled) {
+        m_entries.clear();
+    }
+    m_enabled = enabled;
+}
+
+void ShadowCache::BeginFrame()
+{
+    m_frameIndex++;
+    m_frame = Counters{};
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (m_frameIndex - it->second.lastFrame > m_evictFrames) {
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+ShadowMapPlan ShadowCache::Plan(uint64_t key, const void* owner, const ShadowMapInputs& inputs)
+{
+    ShadowMapPlan plan;
+    const bool hasDynamic = inputs.dynamicHash != 0;
+    if (!m_enabled) {
+        plan.drawStatic = true;
+        plan.drawDynamic = hasDynamic;
+        m_frame.rendered++;
+        m_total.rendered++;
+        return plan;
+    }
+
+    auto [it, inserted] = m_entries.try_emplace(key);
+    Entry& entry = it->second;
+    if (inserted || entry.inputs.lightHash != inputs.lightHash || entry.inputs.staticHash != inputs.staticHash) {
+        // The static layer is only worth saving when dynamic casters are drawn over it
+        plan.drawStatic = true;
+        plan.saveStatic = hasDynamic;
+        plan.drawDynamic = hasDynamic;
+        entry.staticLayerSaved = hasDynamic;
+        m_frame.rendered++;
+        m_total.rendered++;
+    } else if (entry.inputs.dynamicHash != inputs.dynamicHash) {
+        if (entry.inputs.dynamicHash != 0) {
+            // Old dynamic casters are in the map; the layer was saved when they were drawn
+            ASSERT_MSG(entry.staticLayerSaved, "Shadow map %llu has dynamic casters but no static layer",
+                       static_cast<unsigned long long>(key));
+            plan.restoreStatic = true;
+        } else if (!entry.staticLayerSaved) {
+            // The map holds only static casters: it is the static layer
+            plan.saveStatic = true;
+            entry.staticLayerSaved = true;
+        }
+        plan.drawDynamic = hasDynamic;
+        m_frame.composited++;
+        m_total.composited++;
+    } else {
+        m_frame.skipped++;
+        m_total.skipped++;
+    }
+
+    entry.inputs = inputs;
+    entry.owner = owner;
+    entry.lastFrame = m_frameIndex;
+    return plan;
+}
+
+void ShadowCache::Invalidate(const void* owner)
+{
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->second.owner == owner) {
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ShadowCache::Clear()
+{
+    m_entries.clear();
+}
+
+// ============================================================================
+// CONSOLE INTEGRATION
+// ============================================================================
+
+std::string ShadowCache::Console_GetStats() const
+{
+    const uint64_t frameMaps = m_frame.skipped + m_frame.composited + m_frame.rendered;
+    const uint64_t totalMaps = m_total.skipped + m_total.composited + m_total.rendered;
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    ss << "=== Shadow Cache ===\n";
+    ss << "Enabled:          " << (m_enabled ? "yes" : "no") << "\n";
+    ss << "Cached maps:      " << m_entries.size() << " (evicted after " << m_evictFrames << " frames unused)\n";
+    ss << "Last frame:       " << frameMaps << " maps: " << m_frame.skipped << " skipped, " << m_frame.composited
+       << " composited, " << m_frame.rendered << " rendered\n";
+    ss << "Total:            " << totalMaps << " maps: " << m_total.skipped << " skipped, " << m_total.composited
+       << " composited, " << m_total.rendered << " rendered";
+    if (totalMaps > 0) {
+        ss << " (" << 100.0 * static_cast<double>(m_total.skipped) / static_cast<double>(totalMaps) << "% skipped)";
+    }
+    ss << "\n";
+    return ss.str();
+}
+
+std::string ShadowCache::Console_Benchmark(int lightCount)
+{
+    using Clock = std::chrono::high_resolution_clock;
+    lightCount = std::clamp(lightCount, 1, 1024);
+    constexpr uint32_t Frames = 240;
+    constexpr uint32_t StaticCasters = 4000, DynamicCasters = 200;
+    constexpr uint32_t Cascades = 4;
+    constexpr uint32_t CameraMoveBegin = 60, CameraMoveEnd = 90;    // Cascades follow the camera
+    constexpr uint32_t BiasChangeFrame = 150;                       // A change the hashes cannot see
+    constexpr uint32_t HideFrame = 180, HiddenEvictFrames = 30;     // Some lights leave the view for good
+    constexpr uint32_t VisitFrames = 25;                            // Moving casters come and go in thirds of this
+
+    // Light 0 is directional with a map per cascade, the others have one map each.
+    // Casters are ids, static first; a version per caster stands in for its transform.
+    struct SyntheticMap
+    {
+        uint32_t light;
+        uint32_t index;
+        std::vector<uint32_t> casters;
+    };
+    std::mt19937 sceneRng(29);
+    std::vector<SyntheticMap> maps;
+    for (uint32_t light = 0; light < static_cast<uint32_t>(lightCount); ++light) {
+        const uint32_t mapCount = light == 0 ? Cascades : 1;
+        for (uint32_t index = 0; index < mapCount; ++index) {
+            SyntheticMap map{ light, index, {} };
+            const uint32_t staticCount = 20 + sceneRng() % 180;
+            for (uint32_t i = 0; i < staticCount; ++i) map.casters.push_back(sceneRng() % StaticCasters);
+            if (sceneRng() % 10 < 6) {
+                const uint32_t dynamicCount = 1 + sceneRng() % 6;
+                for (uint32_t i = 0; i < dynamicCount; ++i) map.casters.push_back(StaticCasters + sceneRng() % DynamicCasters);
+            }
+            std::sort(map.casters.begin(), map.casters.end());
+            map.casters.erase(std::unique(map.casters.begin(), map.casters.end()), map.casters.end());
+            maps.push_back(std::move(map));
+        }
+    }
+
+    // What a map or static layer was drawn with
+    struct Content
+    {
+        uint64_t light = 0, casters = 0, dynamic = 0;
+        bool operator==(const Content& other) const
+        {
+            return light == other.light && casters == other.casters && dynamic == other.dynamic;
+        }
+    };
+
+    struct RunResult
+    {
+        Counters counters;
+        uint64_t draws = 0;
+        uint32_t staleMaps = 0;
+        uint32_t layerMisuses = 0;
+        double planMs = 0.0;
+        size_t peakEntries = 0;
+        size_t finalEntries = 0;
+    };
+
+    auto run = [&](bool enabled) {
+        RunResult result;
+        ShadowCache cache;
+        cache.SetEnabled(enabled);
+        cache.SetEvictFrames(HiddenEvictFrames);
+        NullRenderBackend backend;
+        CommandBuffer buffer;
+        const XMMATRIX identity = XMMatrixIdentity();
+
+        std::vector<uint32_t> casterVersion(StaticCasters + DynamicCasters, 0);
+        std::vector<uint32_t> lightVersion(lightCount, 0), biasVersion(lightCount, 0);
+        uint32_t cameraVersion = 0;
+        std::vector<Content> mapContent(maps.size()), layerContent(maps.size());
+
+        auto recordCasters = [&](const SyntheticMap& map, bool dynamic) {
+            buffer.BindBasicShaders();
+            for (uint32_t id : map.casters) {
+                if ((id >= StaticCasters) != dynamic) continue;
+                buffer.SetObjectConstants(identity);
+                buffer.DrawMesh(reinterpret_cast<const Mesh*>(uintptr_t(0x100000) + (id % 256) * 16), 36);
+            }
+        };
+
+        std::mt19937 eventRng(31);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        for (uint32_t frame = 0; frame < Frames; ++frame) {
+            for (uint32_t i = StaticCasters; i < StaticCasters + DynamicCasters; ++i) {
+                if (unit(eventRng) < 0.3f) casterVersion[i]++;
+            }
+            if (frame % 40 == 39) casterVersion[eventRng() % StaticCasters]++;
+            for (uint32_t light = 1; light < static_cast<uint32_t>(lightCount); ++light) {
+                if (unit(eventRng) < 0.01f) lightVersion[light]++;
+            }
+            if (frame >= CameraMoveBegin && frame < CameraMoveEnd) cameraVersion++;
+            if (frame == BiasChangeFrame) {
+                const uint32_t light = 1 % lightCount;
+                biasVersion[light]++;
+                cache.Invalidate(&lightVersion[light]);
+            }
+
+            cache.BeginFrame();
+            buffer.Begin(identity, identity);
+            for (size_t m = 0; m < maps.size(); ++m) {
+                const SyntheticMap& map = maps[m];
+                if (frame >= HideFrame && map.light % 8 == 7) continue;
+                const bool visited = (frame / VisitFrames + m) % 3 != 0;
+
+                const auto planStart = Clock::now();
+                ShadowHash lightHash, staticHash, dynamicHash;
+                lightHash.Add(map.light);
+                lightHash.Add(map.index);
+                lightHash.Add(lightVersion[map.light]);
+                if (map.light == 0) lightHash.Add(cameraVersion);
+                for (uint32_t id : map.casters) {
+                    if (id >= StaticCasters && !visited) continue;
+                    ShadowHash& hash = id < StaticCasters ? staticHash : dynamicHash;
+                    hash.Add(id);
+                    hash.Add(casterVersion[id]);
+                }
+                const ShadowMapInputs inputs{ lightHash.Get(), staticHash.Get(), dynamicHash.Get() };
+                const ShadowMapPlan plan = cache.Plan(MakeKey(&lightVersion[map.light], map.index), &lightVersion[map.light], inputs);
+                result.planMs += std::chrono::duration<double, std::milli>(Clock::now() - planStart).count();
+
+                const Content truth{ inputs.lightHash + biasVersion[map.light], inputs.staticHash, inputs.dynamicHash };
+                Content& content = mapContent[m];
+                if (plan.drawStatic) {
+                    content = Content{ truth.light, truth.casters, 0 };
+                    recordCasters(map, false);
+                }
+                if (plan.saveStatic) {
+                    if (content.dynamic != 0) result.layerMisuses++;
+                    layerContent[m] = content;
+                }
+                if (plan.restoreStatic) {
+                    content = layerContent[m];
+                }
+                if (plan.drawDynamic) {
+                    if (content.dynamic != 0) result.layerMisuses++;
+                    content.dynamic = truth.dynamic;
+                    recordCasters(map, true);
+                }
+                if (!(content == truth)) result.staleMaps++;
+            }
+            backend.Execute(buffer);
+            result.peakEntries = std::max(result.peakEntries, cache.GetEntryCount());
+        }
+        result.counters = cache.GetTotalCounters();
+        result.draws = backend.GetStats().draws;
+        result.finalEntries = cache.GetEntryCount();
+        return result;
+    };
+
+    const RunResult cached = run(true);
+    const RunResult uncached = run(false);
+    const uint64_t mapFrames = cached.counters.skipped + cached.counters.composited + cached.counters.rendered;
+    const bool passed = cached.staleMaps == 0 && cached.layerMisuses == 0 && uncached.staleMaps == 0 && uncached.layerMisuses == 0;
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    ss << "=== Shadow Cache Benchmark ===\n";
+    ss << lightCount << " lights (" << maps.size() << " maps), " << StaticCasters << " static + " << DynamicCasters
+       << " moving casters, " << Frames << " frames\n";
+    ss << "Maps:         " << mapFrames << ": " << cached.counters.skipped << " skipped, " << cached.counters.composited
+       << " composited, " << cached.counters.rendered << " rendered\n";
+    ss << "Caster draws: " << cached.draws << " cached, " << uncached.draws << " redrawing every map ("
+       << (uncached.draws > 0 ? 100.0 * static_cast<double>(cached.draws) / static_cast<double>(uncached.draws) : 0.0) << "%)\n";
+    ss << std::setprecision(3);
+    ss << "Planning:     " << 1000.0 * cached.planMs / Frames << " us per frame (hashing included)\n";
+    ss << "Eviction:     " << cached.peakEntries << " maps cached at peak, " << cached.finalEntries << " after hidden lights expired\n";
+    ss << "Content:      " << cached.staleMaps << " stale maps, " << cached.layerMisuses << " layer misuses (uncached: "
+       << uncached.staleMaps << ", " << uncached.layerMisuses << ") (" << (passed ? "passed" : "FAILED") << ")\n";
+    return ss.str();
+}
@@ -0,0 +1,193 @@
+/**
+ * @file ShadowCache.h
+ * @brief Dirty tracking for shadow maps with static and dynamic caster layers
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * Every shadow map (one per light, or one per cascade) is keyed by its owner
+ * and index. Each frame the renderer hashes what decides the map's content:
+ * the light's view and projection, the static casters, and the dynamic
+ * casters, each caster with its transform and mesh. Comparing with the
+ * previous hashes gives a plan:
+ *
+ * - nothing changed: skip the map and keep last frame's depth;
+ * - only dynamic casters changed: copy the saved static layer back into the
+ *   map and draw the dynamic casters on top;
+ * - the light or a static caster changed, or the light is dirty: clear and
+ *   draw the static casters, save them as the static layer if dynamic
+ *   casters follow, then draw the dynamic casters.
+ *
+ * Static layers are only kept for maps that have dynamic casters, so maps lit
+ * by purely static scenery cost no extra memory. The planning is plain CPU
+ * code; LightingSystem carries the plans out with D3D11 copies and draws, and
+ * the benchmark carries them out against a null backend.
+ */
+
+#pragma once
+
+#include "Utils/Assert.h"
+#include <DirectXMath.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Which casters a draw covers
+ */
+enum class ShadowCasterLayer : uint8_t
+{
+    Static,         ///< Objects marked static: they do not move once placed
+    Dynamic         ///< Everything else
+};
+
+/**
+ * @brief Order-dependent 64-bit hash of a shadow map's inputs; 0 only when nothing was added
+ */
+class ShadowHash
+{
+public:
+    void Add(uint64_t value);
+    void AddFloats(const float* values, size_t count);
+    void AddPointer(const void* pointer) { Add(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer))); }
+    void AddMatrix(DirectX::FXMMATRIX matrix);
+
+    uint64_t Get() const { return m_count == 0 ? 0 : (m_value | 1); }
+    uint32_t GetCount() const { return m_count; }
+
+private:
+    uint64_t m_value = 0;
+    uint32_t m_count = 0;
+};
+
+/**
+ * @brief What decides one shadow map's content this frame
+ */
+struct ShadowMapInputs
+{
+    uint64_t lightHash = 0;         ///< Light view, projection and map size
+    uint64_t staticHash = 0;        ///< Static casters with transforms; 0 when there are none
+    uint64_t dynamicHash = 0;       ///< Dynamic casters with transforms; 0 when there are none
+};
+
+/**
+ * @brief Steps that bring a shadow map up to date, carried out in this order
+ */
+struct ShadowMapPlan
+{
+    bool drawStatic = false;        ///< Clear the map and draw the static casters
+    bool saveStatic = false;        ///< Copy the map into the static layer
+    bool restoreStatic = false;     ///< Copy the static layer into the map
+    bool drawDynamic = false;       ///< Draw the dynamic casters over the map
+
+    bool IsSkipped() const { return !drawStatic && !saveStatic && !restoreStatic && !drawDynamic; }
+};
+
+/**
+ * @brief Supplies and draws the casters of a shadow map
+ *
+ * Caster lists are CullingSystem handles in ascending order; null means every
+ * caster of the frame.
+ */
+class ShadowCasterSource
+{
+public:
+    virtual ~ShadowCasterSource() = default;
+
+    /**
+     * @brief Hash the static and dynamic casters of a list, each with what its depth depends on
+     */
+    virtual void HashCasters(const std::vector<uint32_t>* casters, uint64_t& staticHash, uint64_t& dynamicHash) = 0;
+
+    /**
+     * @brief Draw one layer of the casters into the bound depth target
+     * @return Draw calls issued
+     */
+    virtual uint32_t DrawCasters(DirectX::FXMMATRIX view, DirectX::CXMMATRIX projection,
+                                 const std::vector<uint32_t>* casters, ShadowCasterLayer layer) = 0;
+};
+
+/**
+ * @brief Previous inputs of every shadow map, and the plans that follow from them
+ */
+class ShadowCache
+{
+public:
+    static constexpr uint32_t DefaultEvictFrames = 300;
+
+    /**
+     * @brief Maps handled in a frame, by outcome
+     */
+    struct Counters
+    {
+        uint64_t skipped = 0;       ///< Left untouched
+        uint64_t composited = 0;    ///< Static layer restored (or kept) and dynamic casters redrawn
+        uint64_t rendered = 0;      ///< Static casters redrawn
+    };
+
+    static uint64_t MakeKey(const void* owner, uint32_t index);
+
+    /**
+     * @brief When off, every map is redrawn in full each frame and nothing is remembered
+     */
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const { return m_enabled; }
+
+    /**
+     * @brief Forget maps not planned for this many frames
+     */
+    void SetEvictFrames(uint32_t frames) { m_evictFrames = frames; }
+
+    /**
+     * @brief Start a frame: clears the frame counters and evicts stale maps
+     */
+    void BeginFrame();
+
+    /**
+     * @brief Compare a map's inputs with last time and record them
+     * @param owner Light the map belongs to, for Invalidate()
+     *
+     * The caller must carry out the whole plan: the cache assumes the map
+     * (and its static layer) now match @p inputs.
+     */
+    ShadowMapPlan Plan(uint64_t key, const void* owner, const ShadowMapInputs& inputs);
+
+    /**
+     * @brief Redraw every map of an owner next time, e.g. when the light is dirty or removed
+     */
+    void Invalidate(const void* owner);
+    void Clear();
+
+    size_t GetEntryCount() const { return m_entries.size(); }
+    const Counters& GetFrameCounters() const { return m_frame; }
+    const Counters& GetTotalCounters() const { return m_total; }
+
+    std::string Console_GetStats() const;
+
+    /**
+     * @brief Run a synthetic scene of lights, static and moving casters through the cache
+     *
+     * The plans are carried out against a model of each map's content and the
+     * caster draws are replayed through a null backend; every map is compared
+     * with what a full redraw would produce.
+     */
+    static std::string Console_Benchmark(int lightCount);
+
+private:
+    struct Entry
+    {
+        ShadowMapInputs inputs;
+        const void* owner = nullptr;
+        uint32_t lastFrame = 0;
+        bool staticLayerSaved = false;      ///< The static layer holds inputs.lightHash and inputs.staticHash
+    };
+
+    std::unordered_map<uint64_t, Entry> m_entries;
+    uint32_t m_frameIndex = 0;
+    uint32_t m_evictFrames = DefaultEvictFrames;
+    bool m_enabled = true;
+
+    Counters m_frame;
+    Counters m_total;
+};
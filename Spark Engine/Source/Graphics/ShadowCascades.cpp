@@ -0,0 +1,557 @@
+/**
+ * @file ShadowCascades.cpp
+ * @brief Implementation of cascade fitting and shadow caster culling
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * The caster test is written once against a lane abstraction, as in
+ * CullingSystem.cpp, and instantiated for SSE and plain floats. The
+ * benchmark traces rays from receivers toward the light, so a caster that
+ * shadows a receiver but is missing from its cascade's list is reported.
+ */
+
+#include "ShadowCascades.h"
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <bit>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define SPARK_CASCADES_SSE 1
+#endif
+
+using namespace DirectX;
+
+namespace
+{
+    struct ScalarLane
+    {
+        using Type = float;
+        using Mask = bool;
+        static constexpr int Width = 1;
+
+        static Type Load(const float* p) { return *p; }
+        static void Store(float* p, Type v) { *p = v; }
+        static Type Set(float v) { return v; }
+        static Type Add(Type a, Type b) { return a + b; }
+        static Type Sub(Type a, Type b) { return a - b; }
+        static Type Mul(Type a, Type b) { return a * b; }
+        static Type Max(Type a, Type b) { return a > b ? a : b; }
+        static Mask LessEq(Type a, Type b) { return a <= b; }
+        static Mask And(Mask a, Mask b) { return a && b; }
+        static uint32_t Bits(Mask m) { return m ? 1u : 0u; }
+    };
+
+#if SPARK_CASCADES_SSE
+    struct SseLane
+    {
+        using Type = __m128;
+        using Mask = __m128;
+        static constexpr int Width = 4;
+
+        static Type Load(const float* p) { return _mm_loadu_ps(p); }
+        static void Store(float* p, Type v) { _mm_storeu_ps(p, v); }
+        static Type Set(float v) { return _mm_set1_ps(v); }
+        static Type Add(Type a, Type b) { return _mm_add_ps(a, b); }
+        static Type Sub(Type a, Type b) { return _mm_sub_ps(a, b); }
+        static Type Mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+        static Type Max(Type a, Type b) { return _mm_max_ps(a, b); }
+        static Mask LessEq(Type a, Type b) { return _mm_cmple_ps(a, b); }
+        static Mask And(Mask a, Mask b) { return _mm_and_ps(a, b); }
+        static uint32_t Bits(Mask m) { return static_cast<uint32_t>(_mm_movemask_ps(m)); }
+    };
+#endif
+
+    /**
+     * @brief Receiver box of one cascade in light space, extruded toward the light by the caster reach
+     */
+    struct CasterVolume
+    {
+        float minX, maxX, minY, maxY, minZ, maxZ;
+    };
+
+    struct SphereArrays
+    {
+        const float* x;
+        const float* y;
+        const float* z;
+        const float* radius;
+    };
+
+    /**
+     * Spheres are rotated into light space (the rotation has no translation),
+     * then tested against each volume: squared distance from the centre to the
+     * box is at most r^2, and r is not negative.
+     */
+    template<typename L>
+    void TestBlock(const SphereArrays& spheres, size_t i, const XMFLOAT4X4& rotation, const CasterVolume* volumes,
+                   uint32_t volumeCount, float* lightZ, uint32_t* bits)
+    {
+        const auto zero = L::Set(0.0f);
+        const auto x = L::Load(spheres.x + i), y = L::Load(spheres.y + i), z = L::Load(spheres.z + i);
+        const auto r = L::Load(spheres.radius + i);
+        const auto lx = L::Add(L::Add(L::Mul(x, L::Set(rotation._11)), L::Mul(y, L::Set(rotation._21))), L::Mul(z, L::Set(rotation._31)));
+        const auto ly = L::Add(L::Add(L::Mul(x, L::Set(rotation._12)), L::Mul(y, L::Set(rotation._22))), L::Mul(z, L::Set(rotation._32)));
+        const auto lz = L::Add(L::Add(L::Mul(x, L::Set(rotation._13)), L::Mul(y, L::Set(rotation._23))), L::Mul(z, L::Set(rotation._33)));
+        L::Store(lightZ, lz);
+
+        const auto radiusSq = L::Mul(r, r);
+        const auto live = L::LessEq(zero, r);
+        for (uint32_t c = 0; c < volumeCount; ++c) {
+            const CasterVolume& v = volumes[c];
+            const auto dx = L::Max(L::Max(L::Sub(L::Set(v.minX), lx), L::Sub(lx, L::Set(v.maxX))), zero);
+            const auto dy = L::Max(L::Max(L::Sub(L::Set(v.minY), ly), L::Sub(ly, L::Set(v.maxY))), zero);
+            const auto dz = L::Max(L::Max(L::Sub(L::Set(v.minZ), lz), L::Sub(lz, L::Set(v.maxZ))), zero);
+            const auto distanceSq = L::Add(L::Add(L::Mul(dx, dx), L::Mul(dy, dy)), L::Mul(dz, dz));
+            bits[c] = L::Bits(L::And(L::LessEq(distanceSq, radiusSq), live));
+        }
+    }
+
+    /**
+     * @brief Light-space corners of the camera frustum between two view depths
+     */
+    void GetSliceCorners(const XMFLOAT4X4& projection, CXMMATRIX viewToLight, float nearDepth, float farDepth, XMFLOAT3 corners[8])
+    {
+        for (int i = 0; i < 8; ++i) {
+            const float depth = (i & 4) ? farDepth : nearDepth;
+            const float ndcX = (i & 1) ? 1.0f : -1.0f;
+            const float ndcY = (i & 2) ? 1.0f : -1.0f;
+            const XMVECTOR viewPoint = XMVectorSet((ndcX - projection._31) * depth / projection._11,
+                                                   (ndcY - projection._32) * depth / projection._22, depth, 1.0f);
+            XMStoreFloat3(&corners[i], XMVector3TransformCoord(viewPoint, viewToLight));
+        }
+    }
+}
+
+ShadowCascades::ShadowCascades()
+{
+    XMStoreFloat4x4(&m_lightRotation, XMMatrixIdentity());
+    for (ShadowCascade& cascade : m_cascades) {
+        XMStoreFloat4x4(&cascade.view, XMMatrixIdentity());
+        XMStoreFloat4x4(&cascade.projection, XMMatrixIdentity());
+        XMStoreFloat4x4(&cascade.viewProjection, XMMatrixIdentity());
+    }
+}
+
+void ShadowCascades::Configure(uint32_t cascadeCount, float splitLambda, uint32_t resolution)
+{
+    m_cascadeCount = std::clamp(cascadeCount, 1u, MaxCascades);
+    m_splitLambda = std::clamp(splitLambda, 0.0f, 1.0f);
+    m_resolution = std::max(resolution, 16u);
+}
+
+void ShadowCascades::SetReceiverBounds(const XMFLOAT3& worldMin, const XMFLOAT3& worldMax)
+{
+    m_receiverWorldMin = worldMin;
+    m_receiverWorldMax = worldMax;
+    m_hasReceiverBounds = true;
+}
+
+void ShadowCascades::ComputeSplits(float nearPlane, float farPlane, uint32_t count, float lambda, float* splits)
+{
+    ASSERT_MSG(count > 0 && nearPlane > 0.0f, "Cascade splits need a positive near plane and at least one cascade (got %u)", count);
+
+    splits[0] = nearPlane;
+    for (uint32_t i = 1; i < count; ++i) {
+        const float p = static_cast<float>(i) / static_cast<float>(count);
+        const float logarithmic = nearPlane * std::pow(farPlane / nearPlane, p);
+        const float uniform = nearPlane + (farPlane - nearPlane) * p;
+        splits[i] = lambda * (logarithmic - uniform) + uniform;
+    }
+    splits[count] = farPlane;
+}
+
+void ShadowCascades::Update(FXMMATRIX cameraView, CXMMATRIX cameraProjection, const XMFLOAT3& lightDirection)
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    XMFLOAT4X4 projection;
+    XMStoreFloat4x4(&projection, cameraProjection);
+    const float nearPlane = -projection._43 / projection._33;
+    const float farPlane = std::min(projection._43 / (1.0f - projection._33), std::max(m_shadowDistance, nearPlane * 2.0f));
+    ComputeSplits(nearPlane, farPlane, m_cascadeCount, m_splitLambda, m_splits);
+
+    // Light space: +z along the light, no translation
+    XMVECTOR direction = XMLoadFloat3(&lightDirection);
+    direction = XMVectorGetX(XMVector3LengthSq(direction)) > 1e-12f ? XMVector3Normalize(direction) : XMVectorSet(0.0f, -1.0f, 0.0f, 0.0f);
+    const XMVECTOR up = std::fabs(XMVectorGetY(direction)) > 0.99f ? XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f) : XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+    const XMMATRIX rotation = XMMatrixLookToLH(XMVectorZero(), direction, up);
+    XMStoreFloat4x4(&m_lightRotation, rotation);
+
+    const XMMATRIX viewToWorld = XMMatrixInverse(nullptr, cameraView);
+    const XMMATRIX viewToLight = XMMatrixMultiply(viewToWorld, rotation);
+
+    // Scene receiver box in light space
+    XMFLOAT3 sceneMin(-FLT_MAX, -FLT_MAX, -FLT_MAX), sceneMax(FLT_MAX, FLT_MAX, FLT_MAX);
+    if (m_hasReceiverBounds) {
+        sceneMin = XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX);
+        sceneMax = XMFLOAT3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        for (int i = 0; i < 8; ++i) {
+            const XMVECTOR corner = XMVectorSet((i & 1) ? m_receiverWorldMax.x : m_receiverWorldMin.x,
+                                                (i & 2) ? m_receiverWorldMax.y : m_receiverWorldMin.y,
+                                                (i & 4) ? m_receiverWorldMax.z : m_receiverWorldMin.z, 1.0f);
+            XMFLOAT3 p;
+            XMStoreFloat3(&p, XMVector3TransformCoord(corner, rotation));
+            sceneMin = XMFLOAT3(std::min(sceneMin.x, p.x), std::min(sceneMin.y, p.y), std::min(sceneMin.z, p.z));
+            sceneMax = XMFLOAT3(std::max(sceneMax.x, p.x), std::max(sceneMax.y, p.y), std::max(sceneMax.z, p.z));
+        }
+    }
+
+    // Widest corner ray of the frustum, as (x^2 + y^2) / z^2
+    float spread = 0.0f;
+    for (float ndcX : { -1.0f, 1.0f }) {
+        for (float ndcY : { -1.0f, 1.0f }) {
+            const float tx = (ndcX - projection._31) / projection._11, ty = (ndcY - projection._32) / projection._22;
+            spread = std::max(spread, tx * tx + ty * ty);
+        }
+    }
+
+    for (uint32_t c = 0; c < m_cascadeCount; ++c) {
+        ShadowCascade& cascade = m_cascades[c];
+        cascade.splitNear = m_splits[c];
+        cascade.splitFar = m_splits[c + 1];
+
+        // Smallest sphere on the view axis around the slice. It only depends on
+        // the split depths and the projection, so it is the same every frame.
+        const float n = cascade.splitNear, f = cascade.splitFar;
+        const float centerDepth = std::min(0.5f * (n + f) * (1.0f + spread), f);
+        float radiusSq = 0.0f;
+        for (float depth : { n, f }) {
+            for (float ndcX : { -1.0f, 1.0f }) {
+                for (float ndcY : { -1.0f, 1.0f }) {
+                    const float x = (ndcX - projection._31) * depth / projection._11;
+                    const float y = (ndcY - projection._32) * depth / projection._22;
+                    radiusSq = std::max(radiusSq, x * x + y * y + (depth - centerDepth) * (depth - centerDepth));
+                }
+            }
+        }
+        cascade.radius = std::sqrt(radiusSq);
+
+        // Two spare texels cover the half texel the snapped centre can move
+        const float halfWidth = cascade.radius * static_cast<float>(m_resolution) / static_cast<float>(m_resolution - 2);
+        cascade.texelSize = 2.0f * halfWidth / static_cast<float>(m_resolution);
+
+        XMFLOAT3 center;
+        XMStoreFloat3(&center, XMVector3TransformCoord(XMVectorSet(0.0f, 0.0f, centerDepth, 1.0f), viewToLight));
+        cascade.center = XMFLOAT2(std::floor(center.x / cascade.texelSize) * cascade.texelSize,
+                                  std::floor(center.y / cascade.texelSize) * cascade.texelSize);
+
+        XMFLOAT3 corners[8];
+        GetSliceCorners(projection, viewToLight, n, f, corners);
+        XMFLOAT3 minimum = corners[0], maximum = corners[0];
+        for (const XMFLOAT3& p : corners) {
+            minimum = XMFLOAT3(std::min(minimum.x, p.x), std::min(minimum.y, p.y), std::min(minimum.z, p.z));
+            maximum = XMFLOAT3(std::max(maximum.x, p.x), std::max(maximum.y, p.y), std::max(maximum.z, p.z));
+        }
+        cascade.receiverMin = XMFLOAT3(std::max(minimum.x, sceneMin.x), std::max(minimum.y, sceneMin.y), std::max(minimum.z, sceneMin.z));
+        cascade.receiverMax = XMFLOAT3(std::min(maximum.x, sceneMax.x), std::min(maximum.y, sceneMax.y), std::min(maximum.z, sceneMax.z));
+        cascade.hasReceivers = cascade.receiverMin.x <= cascade.receiverMax.x && cascade.receiverMin.y <= cascade.receiverMax.y &&
+                               cascade.receiverMin.z <= cascade.receiverMax.z;
+        if (!cascade.hasReceivers) {
+            cascade.receiverMin = minimum;
+            cascade.receiverMax = maximum;
+        }
+
+        XMStoreFloat4x4(&cascade.view, rotation);
+        cascade.depthFar = cascade.receiverMax.z + cascade.texelSize;
+        FinishProjection(cascade, cascade.receiverMin.z - m_casterReach);
+        m_casters[c].clear();
+    }
+
+    m_updateTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+void ShadowCascades::FinishProjection(ShadowCascade& cascade, float depthNear)
+{
+    const float halfWidth = 0.5f * cascade.texelSize * static_cast<float>(m_resolution);
+    cascade.depthNear = depthNear;
+    const XMMATRIX projection = XMMatrixOrthographicOffCenterLH(cascade.center.x - halfWidth, cascade.center.x + halfWidth,
+                                                                cascade.center.y - halfWidth, cascade.center.y + halfWidth,
+                                                                cascade.depthNear, cascade.depthFar);
+    XMStoreFloat4x4(&cascade.projection, projection);
+    XMStoreFloat4x4(&cascade.viewProjection, XMMatrixMultiply(XMLoadFloat4x4(&cascade.view), projection));
+}
+
+void ShadowCascades::CullCasters(const float* x, const float* y, const float* z, const float* radius, size_t count)
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    // Only cascades with receivers take part
+    CasterVolume volumes[MaxCascades];
+    uint32_t volumeCascade[MaxCascades];
+    uint32_t volumeCount = 0;
+    for (uint32_t c = 0; c < m_cascadeCount; ++c) {
+        m_casters[c].clear();
+        const ShadowCascade& cascade = m_cascades[c];
+        if (!cascade.hasReceivers) continue;
+        volumes[volumeCount] = { cascade.receiverMin.x, cascade.receiverMax.x, cascade.receiverMin.y, cascade.receiverMax.y,
+                                 cascade.receiverMin.z - m_casterReach, cascade.receiverMax.z };
+        volumeCascade[volumeCount++] = c;
+    }
+
+    const uint32_t chunkCount = static_cast<uint32_t>((count + SpheresPerJob - 1) / SpheresPerJob);
+    if (m_chunks.size() < chunkCount) m_chunks.resize(chunkCount);
+
+    const SphereArrays spheres{ x, y, z, radius };
+    const XMFLOAT4X4 rotation = m_lightRotation;
+    JobSystem::GetInstance().ParallelFor(chunkCount, 1, [&](uint32_t chunkBegin, uint32_t chunkEnd) {
+        for (uint32_t chunk = chunkBegin; chunk < chunkEnd; ++chunk) {
+            ChunkScratch& scratch = m_chunks[chunk];
+            const size_t first = size_t(chunk) * SpheresPerJob;
+            const size_t last = std::min(count, first + SpheresPerJob);
+            for (uint32_t v = 0; v < volumeCount; ++v) {
+                scratch.casters[v].clear();
+                scratch.nearest[v] = FLT_MAX;
+            }
+
+            uint32_t bits[MaxCascades];
+            float lightZ[4];
+            auto collect = [&](size_t i) {
+                for (uint32_t v = 0; v < volumeCount; ++v) {
+                    for (uint32_t b = bits[v]; b != 0; b &= b - 1) {
+                        const uint32_t lane = static_cast<uint32_t>(std::countr_zero(b));
+                        scratch.casters[v].push_back(static_cast<uint32_t>(i + lane));
+                        scratch.nearest[v] = std::min(scratch.nearest[v], lightZ[lane] - radius[i + lane]);
+                    }
+                }
+            };
+
+            size_t i = first;
+#if SPARK_CASCADES_SSE
+            if (!m_forceScalar) {
+                for (; i + SseLane::Width <= last; i += SseLane::Width) {
+                    TestBlock<SseLane>(spheres, i, rotation, volumes, volumeCount, lightZ, bits);
+                    collect(i);
+                }
+            }
+#endif
+            for (; i < last; ++i) {
+                TestBlock<ScalarLane>(spheres, i, rotation, volumes, volumeCount, lightZ, bits);
+                collect(i);
+            }
+        }
+    });
+
+    // Chunks are in index order, so the lists come out ascending
+    for (uint32_t v = 0; v < volumeCount; ++v) {
+        const uint32_t c = volumeCascade[v];
+        ShadowCascade& cascade = m_cascades[c];
+        float nearest = FLT_MAX;
+        for (uint32_t chunk = 0; chunk < chunkCount; ++chunk) {
+            m_casters[c].insert(m_casters[c].end(), m_chunks[chunk].casters[v].begin(), m_chunks[chunk].casters[v].end());
+            nearest = std::min(nearest, m_chunks[chunk].nearest[v]);
+        }
+
+        // Pull the near plane in to the nearest caster, never past the receivers or the reach. It moves
+        // in steps of DepthSnapTexels so a caster moving a little does not change the projection
+        const float step = DepthSnapTexels * cascade.texelSize;
+        const float depthNear = std::clamp(std::floor((nearest - cascade.texelSize) / step) * step, cascade.receiverMin.z - m_casterReach,
+                                           cascade.receiverMin.z - cascade.texelSize);
+        FinishProjection(cascade, depthNear);
+    }
+
+    m_cullTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// ============================================================================
+// CONSOLE INTEGRATION
+// ============================================================================
+
+std::string ShadowCascades::Console_GetStats() const
+{
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "=== Shadow Cascades ===\n";
+    ss << "Cascades:         " << m_cascadeCount << " x " << m_resolution << "^2, lambda " << m_splitLambda << "\n";
+    ss << "Shadow distance:  " << m_shadowDistance << ", caster reach " << m_casterReach << "\n";
+    for (uint32_t c = 0; c < m_cascadeCount; ++c) {
+        const ShadowCascade& cascade = m_cascades[c];
+        ss << "  [" << c << "] " << cascade.splitNear << " - " << cascade.splitFar << ": radius " << cascade.radius
+           << ", texel " << cascade.texelSize << ", depth " << cascade.depthNear << " - " << cascade.depthFar << ", "
+           << m_casters[c].size() << " casters" << (cascade.hasReceivers ? "" : " (no receivers)") << "\n";
+    }
+    ss << "Update time:      " << m_updateTime << " ms\n";
+    ss << "Cull time:        " << m_cullTime << " ms\n";
+#if SPARK_CASCADES_SSE
+    ss << "Kernel:           " << (m_forceScalar ? "scalar (forced)" : "SSE") << "\n";
+#else
+    ss << "Kernel:           scalar\n";
+#endif
+    return ss.str();
+}
+
+std::string ShadowCascades::Console_Benchmark(int casterCount)
+{
+    using Clock = std::chrono::high_resolution_clock;
+    casterCount = std::clamp(casterCount, 1, 1 << 20);
+    constexpr int Repeats = 5;
+    constexpr int SamplesPerCascade = 1000;
+    constexpr int CameraMoves = 64;
+
+    // A 1 km field of props on the ground and canopies above it; only the bottom 4 m receives shadows.
+    // Every 16th slot is free, as in CullingSystem.
+    std::mt19937 rng(22);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<float> x(casterCount), y(casterCount), z(casterCount), r(casterCount);
+    uint32_t liveCasters = 0;
+    for (int i = 0; i < casterCount; ++i) {
+        const float u = unit(rng);
+        r[i] = 0.5f + 7.5f * u * u * u;
+        x[i] = -500.0f + 1000.0f * unit(rng);
+        z[i] = -500.0f + 1000.0f * unit(rng);
+        y[i] = unit(rng) < 0.25f ? 10.0f + 30.0f * unit(rng) : r[i] * (0.5f + 0.5f * unit(rng));
+        if (i % 16 == 15) r[i] = -1e30f;
+        else liveCasters++;
+    }
+    const XMFLOAT3 sceneMin(-500.0f, -1.0f, -500.0f), sceneMax(500.0f, 4.0f, 500.0f);
+
+    const XMFLOAT3 lightDirection(0.4f, -0.8f, 0.45f);
+    XMVECTOR eye = XMVectorSet(0.0f, 3.0f, 0.0f, 1.0f);
+    const XMMATRIX view = XMMatrixLookAtLH(eye, XMVectorSet(40.0f, 0.0f, 100.0f, 1.0f), XMVectorSet(0, 1, 0, 0));
+    const XMMATRIX projection = XMMatrixPerspectiveFovLH(XMConvertToRadians(70.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+
+    ShadowCascades cascades, scalar;
+    for (ShadowCascades* setup : { &cascades, &scalar }) {
+        setup->Configure(4, 0.75f, 2048);
+        setup->SetReceiverBounds(sceneMin, sceneMax);
+    }
+    scalar.SetForceScalar(true);
+
+    double updateMs = 1e30, cullMs = 1e30, scalarMs = 1e30;
+    for (int repeat = 0; repeat < Repeats; ++repeat) {
+        auto startTime = Clock::now();
+        cascades.Update(view, projection, lightDirection);
+        updateMs = std::min(updateMs, std::chrono::duration<double, std::milli>(Clock::now() - startTime).count());
+        startTime = Clock::now();
+        cascades.CullCasters(x.data(), y.data(), z.data(), r.data(), x.size());
+        cullMs = std::min(cullMs, std::chrono::duration<double, std::milli>(Clock::now() - startTime).count());
+
+        scalar.Update(view, projection, lightDirection);
+        startTime = Clock::now();
+        scalar.CullCasters(x.data(), y.data(), z.data(), r.data(), x.size());
+        scalarMs = std::min(scalarMs, std::chrono::duration<double, std::milli>(Clock::now() - startTime).count());
+    }
+    const uint32_t cascadeCount = cascades.GetCascadeCount();
+    bool kernelsMatch = true;
+    for (uint32_t c = 0; c < cascadeCount; ++c) {
+        kernelsMatch = kernelsMatch && cascades.m_casters[c] == scalar.m_casters[c] &&
+            std::memcmp(&cascades.m_cascades[c].viewProjection, &scalar.m_cascades[c].viewProjection, sizeof(XMFLOAT4X4)) == 0;
+    }
+
+    // Caster spheres in light space, for the checks below
+    const XMMATRIX rotation = XMLoadFloat4x4(&cascades.m_lightRotation);
+    std::vector<XMFLOAT3> lightSpace(x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        XMStoreFloat3(&lightSpace[i], XMVector3TransformCoord(XMVectorSet(x[i], y[i], z[i], 1.0f), rotation));
+    }
+
+    // Coverage: every slice corner inside its cascade's square; receiver samples inside the depth range too.
+    // Rays from the samples toward the light must only hit casters the cascade lists.
+    const XMMATRIX viewToWorld = XMMatrixInverse(nullptr, view);
+    XMFLOAT4X4 p;
+    XMStoreFloat4x4(&p, projection);
+    uint32_t uncoveredCorners = 0, uncoveredSamples = 0, missedCasters = 0;
+    uint64_t shadowingPairs = 0, orthoCasters = 0, listedCasters = 0;
+    for (uint32_t c = 0; c < cascadeCount; ++c) {
+        const ShadowCascade& cascade = cascades.m_cascades[c];
+        const XMMATRIX viewProjection = XMLoadFloat4x4(&cascade.viewProjection);
+        const std::vector<uint32_t>& listed = cascades.m_casters[c];
+        listedCasters += listed.size();
+
+        XMFLOAT3 corners[8];
+        GetSliceCorners(p, XMMatrixMultiply(viewToWorld, viewProjection), cascade.splitNear, cascade.splitFar, corners);
+        for (const XMFLOAT3& corner : corners) {
+            if (std::fabs(corner.x) > 1.0f || std::fabs(corner.y) > 1.0f) uncoveredCorners++;
+        }
+
+        // What culling to the cascade's projection alone would keep
+        const float halfWidth = 0.5f * cascade.texelSize * cascades.GetResolution();
+        for (size_t i = 0; i < x.size(); ++i) {
+            if (r[i] < 0.0f) continue;
+            const float dx = std::max(std::fabs(lightSpace[i].x - cascade.center.x) - halfWidth, 0.0f);
+            const float dy = std::max(std::fabs(lightSpace[i].y - cascade.center.y) - halfWidth, 0.0f);
+            if (dx * dx + dy * dy <= r[i] * r[i] && lightSpace[i].z - r[i] <= cascade.depthFar) orthoCasters++;
+        }
+
+        for (int sample = 0; sample < SamplesPerCascade; ++sample) {
+            const float depth = cascade.splitNear + (cascade.splitFar - cascade.splitNear) * unit(rng);
+            const float ndcX = unit(rng) * 2.0f - 1.0f, ndcY = unit(rng) * 2.0f - 1.0f;
+            XMFLOAT3 world;
+            XMStoreFloat3(&world, XMVector3TransformCoord(
+                XMVectorSet((ndcX - p._31) * depth / p._11, (ndcY - p._32) * depth / p._22, depth, 1.0f), viewToWorld));
+            if (world.x < sceneMin.x || world.y < sceneMin.y || world.z < sceneMin.z ||
+                world.x > sceneMax.x || world.y > sceneMax.y || world.z > sceneMax.z) {
+                continue;
+            }
+
+            XMFLOAT3 clip, receiver;
+            XMStoreFloat3(&clip, XMVector3TransformCoord(XMLoadFloat3(&world), viewProjection));
+            XMStoreFloat3(&receiver, XMVector3TransformCoord(XMLoadFloat3(&world), rotation));
+            if (std::fabs(clip.x) > 1.0f || std::fabs(clip.y) > 1.0f || clip.z < 0.0f || clip.z > 1.0f) uncoveredSamples++;
+
+            for (uint32_t i = 0; i < static_cast<uint32_t>(x.size()); ++i) {
+                if (r[i] < 0.0f) continue;
+                // The ray runs from the receiver toward the light (-z) for the caster reach
+                const float inner = r[i] * 0.999f;
+                const float dx = lightSpace[i].x - receiver.x, dy = lightSpace[i].y - receiver.y;
+                const float offAxisSq = dx * dx + dy * dy;
+                if (offAxisSq > inner * inner) continue;
+                const float halfChord = std::sqrt(inner * inner - offAxisSq);
+                const float ahead = receiver.z - lightSpace[i].z;
+                if (ahead < -halfChord || ahead > cascades.GetCasterReach() + halfChord) continue;
+                shadowingPairs++;
+                if (!std::binary_search(listed.begin(), listed.end(), i)) missedCasters++;
+            }
+        }
+    }
+
+    // Stability: move and turn the camera; radii must not change and centres must stay on whole texels
+    uint32_t unstable = 0;
+    ShadowCascades moving;
+    moving.Configure(4, 0.75f, 2048);
+    moving.SetReceiverBounds(sceneMin, sceneMax);
+    for (int move = 0; move < CameraMoves; ++move) {
+        eye = XMVectorAdd(eye, XMVectorSet(unit(rng) - 0.5f, 0.0f, unit(rng) - 0.5f, 0.0f));
+        const float yaw = XM_2PI * unit(rng), pitch = -0.4f * unit(rng);
+        const XMVECTOR forward = XMVectorSet(std::sin(yaw) * std::cos(pitch), std::sin(pitch), std::cos(yaw) * std::cos(pitch), 0.0f);
+        moving.Update(XMMatrixLookToLH(eye, forward, XMVectorSet(0, 1, 0, 0)), projection, lightDirection);
+        for (uint32_t c = 0; c < cascadeCount; ++c) {
+            const ShadowCascade& cascade = moving.m_cascades[c];
+            const float u = cascade.center.x / cascade.texelSize, v = cascade.center.y / cascade.texelSize;
+            if (cascade.radius != cascades.m_cascades[c].radius || cascade.texelSize != cascades.m_cascades[c].texelSize ||
+                std::fabs(u - std::round(u)) > 1e-3f || std::fabs(v - std::round(v)) > 1e-3f) {
+                unstable++;
+            }
+        }
+    }
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "=== Shadow Cascade Benchmark ===\n";
+    ss << liveCasters << " casters, " << cascadeCount << " cascades of " << cascades.GetResolution() << "^2 to "
+       << cascades.GetShadowDistance() << " m, best of " << Repeats << "\n";
+    ss << "Fit:          " << updateMs << " ms\n";
+    ss << "Cull:         " << cullMs << " ms\n";
+    ss << "  scalar:     " << scalarMs << " ms (" << scalarMs / cullMs << "x), lists " << (kernelsMatch ? "identical" : "DIFFER") << "\n";
+    for (uint32_t c = 0; c < cascadeCount; ++c) {
+        const ShadowCascade& cascade = cascades.m_cascades[c];
+        ss << "  [" << c << "] " << std::setw(8) << cascade.splitNear << " - " << std::setw(8) << cascade.splitFar << " m: "
+           << std::setw(6) << cascades.m_casters[c].size() << " casters, texel " << cascade.texelSize << " m\n";
+    }
+    ss << "Caster draws: " << listedCasters << " (cascade projections only: " << orthoCasters << ", every caster in every cascade: "
+       << uint64_t(liveCasters) * cascadeCount << ")\n";
+    ss << "Coverage:     " << uncoveredCorners << " corners, " << uncoveredSamples << " receiver samples outside ("
+       << (uncoveredCorners == 0 && uncoveredSamples == 0 ? "passed" : "FAILED") << ")\n";
+    ss << "Shadow rays:  " << shadowingPairs << " caster hits, " << missedCasters << " missed ("
+       << (missedCasters == 0 ? "passed" : "FAILED") << ")\n";
+    ss << "Stability:    " << CameraMoves << " camera moves, " << unstable << " unsnapped cascades ("
+       << (unstable == 0 ? "passed" : "FAILED") << ")\n";
+    return ss.str();
+}
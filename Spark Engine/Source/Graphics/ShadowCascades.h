@@ -0,0 +1,188 @@
+/**
+ * @file ShadowCascades.h
+ * @brief Cascade fitting and per-cascade shadow caster culling for directional lights
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * The camera frustum up to the shadow distance is cut at practical split
+ * distances (a blend of logarithmic and uniform). Each slice gets an
+ * orthographic projection fitted to the bounding sphere of its corners: the
+ * sphere does not change as the camera turns, and its centre is snapped to
+ * whole shadow texels in light space, so shadow edges do not shimmer when the
+ * camera moves or rotates.
+ *
+ * Casters are culled per cascade against its receivers: the light-space box
+ * around the slice's corners (clipped to the scene's receiver bounds when
+ * known), extruded toward the light. Caster spheres are moved into light
+ * space and tested four at a time with SSE against every cascade, with a
+ * scalar kernel that evaluates the same expressions in the same order. The
+ * nearest caster of each cascade then pulls in its depth range.
+ *
+ * Nothing here uses a graphics API, so fitting and culling run and benchmark headless.
+ */
+
+#pragma once
+
+#include "Utils/Assert.h"
+#include <DirectXMath.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Projection and receiver volume of one cascade
+ *
+ * The view is a pure rotation into light space (+z along the light); the
+ * translation lives in the off-centre projection, which keeps texel snapping
+ * exact.
+ */
+struct ShadowCascade
+{
+    DirectX::XMFLOAT4X4 view;
+    DirectX::XMFLOAT4X4 projection;
+    DirectX::XMFLOAT4X4 viewProjection;
+    float splitNear = 0.0f;                 ///< Camera view depth the cascade starts at
+    float splitFar = 0.0f;                  ///< Camera view depth the cascade ends at
+    float radius = 0.0f;                    ///< Bounding sphere of the slice; constant while the camera projection is
+    DirectX::XMFLOAT2 center{};             ///< Light-space xy of the projection centre, a whole number of texels
+    float texelSize = 0.0f;                 ///< World units per shadow map texel
+    DirectX::XMFLOAT3 receiverMin{};        ///< Light-space box of the shadow receivers
+    DirectX::XMFLOAT3 receiverMax{};
+    bool hasReceivers = false;              ///< False if the slice lies outside the receiver bounds; it gets no casters
+    float depthNear = 0.0f;                 ///< Light-space depth range of the projection
+    float depthFar = 0.0f;
+};
+
+/**
+ * @brief Cascaded shadow map setup for one directional light
+ *
+ * Update() once per frame with the camera, then CullCasters() with the scene's
+ * bounding spheres. Not thread-safe; CullCasters() spreads its own work over
+ * the job system.
+ */
+class ShadowCascades
+{
+public:
+    static constexpr uint32_t MaxCascades = 4;
+    static constexpr uint32_t SpheresPerJob = 4096;
+    static constexpr float DepthSnapTexels = 64.0f;     ///< The near depth is a multiple of this many texels
+
+    ShadowCascades();
+
+    /**
+     * @param cascadeCount Clamped to [1, MaxCascades]
+     * @param splitLambda 0 = uniform splits, 1 = logarithmic
+     * @param resolution Shadow map size of each cascade in texels
+     */
+    void Configure(uint32_t cascadeCount, float splitLambda, uint32_t resolution);
+
+    uint32_t GetCascadeCount() const { return m_cascadeCount; }
+    float GetSplitLambda() const { return m_splitLambda; }
+    uint32_t GetResolution() const { return m_resolution; }
+
+    /**
+     * @brief Furthest camera distance that receives shadows; the camera's far plane is used if nearer
+     */
+    void SetShadowDistance(float distance) { m_shadowDistance = distance; }
+    float GetShadowDistance() const { return m_shadowDistance; }
+
+    /**
+     * @brief How far toward the light, past the receivers, casters are looked for
+     */
+    void SetCasterReach(float distance) { m_casterReach = distance; }
+    float GetCasterReach() const { return m_casterReach; }
+
+    /**
+     * @brief World box that holds every shadow receiver; cascades ignore space outside it
+     */
+    void SetReceiverBounds(const DirectX::XMFLOAT3& worldMin, const DirectX::XMFLOAT3& worldMax);
+    void ClearReceiverBounds() { m_hasReceiverBounds = false; }
+
+    /**
+     * @brief Practical split distances: splits[0] = nearPlane, splits[count] = farPlane
+     * @param splits Receives count + 1 distances
+     */
+    static void ComputeSplits(float nearPlane, float farPlane, uint32_t count, float lambda, float* splits);
+
+    /**
+     * @brief Fit the cascades to a camera
+     * @param cameraView Camera view matrix
+     * @param cameraProjection Left-handed perspective projection of the camera
+     * @param lightDirection Direction the light travels, world space
+     *
+     * The depth range starts at the caster reach; CullCasters() tightens it.
+     */
+    void Update(DirectX::FXMMATRIX cameraView, DirectX::CXMMATRIX cameraProjection, const DirectX::XMFLOAT3& lightDirection);
+
+    /**
+     * @brief Build each cascade's caster list from world bounding spheres
+     *
+     * Spheres with a negative radius are skipped, so CullingSystem's arrays
+     * can be passed as they are. Indices in the lists are positions in the
+     * arrays, ascending.
+     */
+    void CullCasters(const float* x, const float* y, const float* z, const float* radius, size_t count);
+
+    const ShadowCascade& GetCascade(uint32_t index) const
+    {
+        ASSERT_MSG(index < m_cascadeCount, "Cascade %u out of range", index);
+        return m_cascades[index];
+    }
+
+    const std::vector<uint32_t>& GetCasters(uint32_t index) const
+    {
+        ASSERT_MSG(index < m_cascadeCount, "Cascade %u out of range", index);
+        return m_casters[index];
+    }
+
+    /**
+     * @brief Split distances of the last Update(), GetCascadeCount() + 1 of them
+     */
+    const float* GetSplits() const { return m_splits; }
+
+    float GetUpdateTime() const { return m_updateTime; }
+    float GetCullTime() const { return m_cullTime; }
+
+    /**
+     * @brief Use the plain-float kernel even where SSE is available, as a reference
+     */
+    void SetForceScalar(bool enabled) { m_forceScalar = enabled; }
+
+    std::string Console_GetStats() const;
+
+    /**
+     * @brief Fit and cull a synthetic outdoor scene, checked for coverage, texel stability and missed casters
+     */
+    static std::string Console_Benchmark(int casterCount);
+
+private:
+    void FinishProjection(ShadowCascade& cascade, float depthNear);
+
+    uint32_t m_cascadeCount = 3;
+    float m_splitLambda = 0.5f;
+    uint32_t m_resolution = 2048;
+    float m_shadowDistance = 200.0f;
+    float m_casterReach = 1000.0f;
+
+    bool m_hasReceiverBounds = false;
+    DirectX::XMFLOAT3 m_receiverWorldMin{}, m_receiverWorldMax{};
+
+    DirectX::XMFLOAT4X4 m_lightRotation;     ///< World to light space
+    ShadowCascade m_cascades[MaxCascades];
+    float m_splits[MaxCascades + 1] = {};
+    std::vector<uint32_t> m_casters[MaxCascades];
+
+    // Per job chunk: caster lists of each cascade and the nearest caster depth
+    struct ChunkScratch
+    {
+        std::vector<uint32_t> casters[MaxCascades];
+        float nearest[MaxCascades];
+        std::vector<float> lightZ;
+    };
+    std::vector<ChunkScratch> m_chunks;
+
+    float m_updateTime = 0.0f;
+    float m_cullTime = 0.0f;
+    bool m_forceScalar = false;
+};
@@ -359,7 +359,8 @@ HRESULT TextureSystem::Initialize(ID3D11Device* device, ID3D11DeviceContext* con
         return hr;
     }
     
-    // Start streaming threads
+    // Streaming jobs run on the JobSystem, at most two at a time
+    m_shouldStop = false;
     SetStreamingThreadCount(2);
     
     Spark::SimpleConsole::GetInstance().LogSuccess("TextureSystem initialized successfully");
@@ -368,15 +369,12 @@ HRESULT TextureSystem::Initialize(ID3D11Device* device, ID3D11DeviceContext* con
 
 void TextureSystem::Shutdown()
 {
-    // Stop streaming threads
-    m_shouldStop = true;
-    m_streamingCondition.notify_all();
-    
-    for (auto& thread : m_streamingThreads) {
-        if (thread.joinable()) {
-            thread.join();
-        }
+    // Stop streaming: running jobs finish their current texture and exit
+    {
+        std::lock_guard<std::mutex> lock(m_streamingMutex);
+        m_shouldStop = true;
     }
+    JobSystem::GetInstance().Wait(m_streamingJobs);
     
     // Clear all textures
     {
@@ -468,12 +466,13 @@ void TextureSystem::LoadTextureAsync(const std::string& filePath,
     request.priority = 0;
     request.urgent = false;
     
+    int jobs = 0;
     {
         std::lock_guard<std::mutex> lock(m_streamingMutex);
         m_streamingQueue.push(request);
+        jobs = ClaimStreamingJobs();
     }
-    
-    m_streamingCondition.notify_one();
+    StartStreamingJobs(jobs);
 }
 
 std::shared_ptr<Texture> TextureSystem::GetTexture(const std::string& name) const
@@ -534,23 +533,14 @@ void TextureSystem::GarbageCollect()
 
 void TextureSystem::SetStreamingThreadCount(int count)
 {
-    // Stop existing threads
-    m_shouldStop = true;
-    m_streamingCondition.notify_all();
-    
-    for (auto& thread : m_streamingThreads) {
-        if (thread.joinable()) {
-            thread.join();
-        }
-    }
-    
-    m_streamingThreads.clear();
-    m_shouldStop = false;
-    
-    // Start new threads
-    for (int i = 0; i < count; ++i) {
-        m_streamingThreads.emplace_back(&TextureSystem::StreamingThreadFunction, this);
+    // Jobs over a lowered cap exit after their current texture
+    int jobs = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_streamingMutex);
+        m_maxStreamingJobs = std::max(0, count);
+        jobs = ClaimStreamingJobs();
     }
+    StartStreamingJobs(jobs);
 }
 
 // Console integration methods
@@ -711,49 +701,64 @@ HRESULT TextureSystem::CreateDefaultTextures()
     return S_OK;
 }
 
-void TextureSystem::StreamingThreadFunction()
+int TextureSystem::ClaimStreamingJobs()
+{
+    // One job per queued request, up to the cap; each drains the queue until it is empty
+    int jobs = 0;
+    while (!m_shouldStop && m_activeStreamingJobs < m_maxStreamingJobs &&
+           m_activeStreamingJobs < static_cast<int>(m_streamingQueue.size())) {
+        ++m_activeStreamingJobs;
+        ++jobs;
+    }
+    return jobs;
+}
+
+void TextureSystem::StartStreamingJobs(int count)
+{
+    for (int i = 0; i < count; ++i) {
+        JobSystem::GetInstance().Run([this]() { StreamingJobFunction(); }, &m_streamingJobs, JobPriority::Low);
+    }
+}
+
+void TextureSystem::StreamingJobFunction()
 {
-    while (!m_shouldStop) {
+    for (;;) {
         StreamingRequest request;
-        bool hasRequest = false;
         
-        // Get next request
+        // Get next request; the job retires under the same lock LoadTextureAsync()
+        // pushes under, so a request is never left queued without a job
         {
-            std::unique_lock<std::mutex> lock(m_streamingMutex);
-            m_streamingCondition.wait(lock, [this] { return !m_streamingQueue.empty() || m_shouldStop; });
-            
-            if (m_shouldStop) break;
-            
-            if (!m_streamingQueue.empty()) {
-                request = m_streamingQueue.front();
-                m_streamingQueue.pop();
-                hasRequest = true;
+            std::lock_guard<std::mutex> lock(m_streamingMutex);
+            if (m_shouldStop || m_streamingQueue.empty() || m_activeStreamingJobs > m_maxStreamingJobs) {
+                --m_activeStreamingJobs;
+                return;
             }
+            
+            request = m_streamingQueue.front();
+            m_streamingQueue.pop();
         }
         
-        if (hasRequest) {
-            // Load texture
-            auto texture = LoadTextureFromFile(request.filePath, request.desc);
+        // Load texture
+        auto texture = LoadTextureFromFile(request.filePath, request.desc);
+        
+        if (texture) {
+            // Add to cache
+            {
+                std::lock_guard<std::mutex> lock(m_texturesMutex);
+                m_textures[request.filePath] = texture;
+            }
+            
+            // Call callback
+            if (request.callback) {
+                request.callback(texture);
+            }
             
-            if (texture) {
-                // Add to cache
-                {
-                    std::lock_guard<std::mutex> lock(m_texturesMutex);
-                    m_textures[request.filePath] = texture;
-                }
-                
-                // Call callback
-                if (request.callback) {
-                    request.callback(texture);
-                }
-                
-                std::lock_guard<std::mutex> metricsLock(m_metricsMutex);
-                m_metrics.loadedTextures++;
-            } else {
-                // Call callback with null on failure
-                if (request.callback) {
-                    request.callback(nullptr);
-                }
+            std::lock_guard<std::mutex> metricsLock(m_metricsMutex);
+            m_metrics.loadedTextures++;
+        } else {
+            // Call callback with null on failure
+            if (request.callback) {
+                request.callback(nullptr);
             }
         }
     }
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "Utils/Assert.h"
+#include "Core/JobSystem.h"
 #include <d3d11.h>
 #include <wrl/client.h>
 #include <DirectXMath.h>
@@ -239,6 +240,9 @@ public:
     // Streaming
     void EnableStreaming(bool enabled) { m_streamingEnabled = enabled; }
     bool IsStreamingEnabled() const { return m_streamingEnabled; }
+    /**
+     * @brief Cap the number of streaming jobs running on the JobSystem at once
+     */
     void SetStreamingThreadCount(int count);
     
     // Console integration
@@ -271,10 +275,11 @@ private:
     
     // Streaming
     bool m_streamingEnabled = true;
-    std::vector<std::thread> m_streamingThreads;
     std::queue<StreamingRequest> m_streamingQueue;
     mutable std::mutex m_streamingMutex;
-    std::condition_variable m_streamingCondition;
+    int m_maxStreamingJobs = 0;             ///< Guarded by m_streamingMutex
+    int m_activeStreamingJobs = 0;          ///< Guarded by m_streamingMutex
+    JobCounter m_streamingJobs;
     std::atomic<bool> m_shouldStop{false};
     
     // Metrics
@@ -283,7 +288,9 @@ private:
     
     // Helper methods
     HRESULT CreateDefaultTextures();
-    void StreamingThreadFunction();
+    int ClaimStreamingJobs();           ///< Call with m_streamingMutex held; returns how many jobs to start
+    void StartStreamingJobs(int count); ///< Call without m_streamingMutex (Run() may execute inline)
+    void StreamingJobFunction();
     void UpdateMetrics();
     TextureDesc AdjustDescForQuality(const TextureDesc& desc) const;
     std::shared_ptr<Texture> LoadTextureFromFile(const std::string& filePath, const TextureDesc& desc);
@@ -1,5 +1,6 @@
 ﻿// CollisionSystem.cpp
 #include "CollisionSystem.h"
+#include "TriangleBVH.h"
 #include "Utils/Assert.h"
 #include <DirectXMath.h>
 #include <algorithm>
@@ -269,6 +270,263 @@ CollisionResult CollisionSystem::RayVsTriangle(const Ray& ray, const XMFLOAT3& v
     return res;
 }
 
+// Ray-vs-Mesh
+CollisionResult CollisionSystem::RayVsMesh(const Ray& ray, const TriangleBVH& mesh, float maxDistance)
+{
+    CollisionResult res;
+    TriangleBVHHit hit;
+    if (!mesh.Raycast(ray, maxDistance, hit)) return res;
+
+    res.Hit = true;
+    res.Distance = hit.distance;
+    res.Point = hit.point;
+    res.Normal = hit.normal;
+    return res;
+}
+
+// Swept-sphere helpers
+namespace
+{
+    XMFLOAT3 Add3(const XMFLOAT3& a, const XMFLOAT3& b) { return XMFLOAT3(a.x + b.x, a.y + b.y, a.z + b.z); }
+    XMFLOAT3 Sub3(const XMFLOAT3& a, const XMFLOAT3& b) { return XMFLOAT3(a.x - b.x, a.y - b.y, a.z - b.z); }
+    XMFLOAT3 Scale3(const XMFLOAT3& a, float s) { return XMFLOAT3(a.x * s, a.y * s, a.z * s); }
+    float Dot3(const XMFLOAT3& a, const XMFLOAT3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+    /**
+     * @brief Earliest t in [0, 1] at which o + t*d lies within radius of center
+     */
+    bool SegmentSphereTime(const XMFLOAT3& o, const XMFLOAT3& d, const XMFLOAT3& center, float radius, float& t)
+    {
+        const XMFLOAT3 m = Sub3(o, center);
+        const float c = Dot3(m, m) - radius * radius;
+        if (c <= 0.0f) { t = 0.0f; return true; }
+
+        const float a = Dot3(d, d);
+        const float b = Dot3(m, d);
+        if (b >= 0.0f || a <= 1e-12f) return false;   // Moving away or not moving
+
+        const float disc = b * b - a * c;
+        if (disc < 0.0f) return false;
+
+        t = (-b - std::sqrt(disc)) / a;
+        return t <= 1.0f;
+    }
+
+    /**
+     * @brief Earliest t in [0, 1] at which o + t*d lies within radius of the segment p-q
+     */
+    bool SegmentCapsuleTime(const XMFLOAT3& o, const XMFLOAT3& d, const XMFLOAT3& p, const XMFLOAT3& q,
+                            float radius, float& t)
+    {
+        const XMFLOAT3 axis = Sub3(q, p);
+        const float axisLengthSq = Dot3(axis, axis);
+        if (axisLengthSq <= 1e-12f) return SegmentSphereTime(o, d, p, radius, t);
+
+        // Cylinder part: remove the axis component and solve the 2D circle problem
+        const XMFLOAT3 m = Sub3(o, p);
+        const float md = Dot3(m, axis) / axisLengthSq;
+        const float dd = Dot3(d, axis) / axisLengthSq;
+        const XMFLOAT3 mPerp = Sub3(m, Scale3(axis, md));
+        const XMFLOAT3 dPerp = Sub3(d, Scale3(axis, dd));
+
+        float best = FLT_MAX;
+        const float c = Dot3(mPerp, mPerp) - radius * radius;
+        if (c <= 0.0f)
+        {
+            if (md >= 0.0f && md <= 1.0f) { t = 0.0f; return true; }
+        }
+        else
+        {
+            const float a = Dot3(dPerp, dPerp);
+            const float b = Dot3(mPerp, dPerp);
+            const float disc = b * b - a * c;
+            if (a > 1e-12f && b < 0.0f && disc >= 0.0f)
+            {
+                const float tc = (-b - std::sqrt(disc)) / a;
+                const float s = md + tc * dd;
+                if (tc <= 1.0f && s >= 0.0f && s <= 1.0f) best = tc;
+            }
+        }
+
+        // End caps
+        float te;
+        if (SegmentSphereTime(o, d, p, radius, te) && te < best) best = te;
+        if (SegmentSphereTime(o, d, q, radius, te) && te < best) best = te;
+
+        if (best == FLT_MAX) return false;
+        t = best;
+        return true;
+    }
+
+    XMFLOAT3 ClosestPointOnSegment(const XMFLOAT3& point, const XMFLOAT3& p, const XMFLOAT3& q)
+    {
+        const XMFLOAT3 axis = Sub3(q, p);
+        const float lengthSq = Dot3(axis, axis);
+        const float s = lengthSq > 1e-12f ? std::clamp(Dot3(Sub3(point, p), axis) / lengthSq, 0.0f, 1.0f) : 0.0f;
+        return Add3(p, Scale3(axis, s));
+    }
+
+    /**
+     * @brief Fill in the contact for a sweep that stops at time t against surface point 'contact'
+     */
+    CollisionResult MakeSweepResult(const BoundingSphere& sphere, const XMFLOAT3& displacement, float t,
+                                    const XMFLOAT3& contact)
+    {
+        CollisionResult res;
+        res.Hit = true;
+        res.Distance = t;
+        res.Point = contact;
+
+        const XMFLOAT3 center = Add3(sphere.Center, Scale3(displacement, t));
+        XMFLOAT3 n = Sub3(center, contact);
+        float lengthSq = Dot3(n, n);
+        if (lengthSq <= 1e-12f) {
+            // Center on the surface (started embedded): push back against the motion
+            n = Scale3(displacement, -1.0f);
+            lengthSq = Dot3(n, n);
+        }
+        res.Normal = lengthSq > 1e-12f ? Scale3(n, 1.0f / std::sqrt(lengthSq)) : XMFLOAT3(0, 1, 0);
+        return res;
+    }
+}
+
+// Sweep-Sphere-vs-Sphere
+CollisionResult CollisionSystem::SweepSphereVsSphere(const BoundingSphere& sphere, const XMFLOAT3& displacement,
+    const BoundingSphere& target)
+{
+    float t;
+    if (!SegmentSphereTime(sphere.Center, displacement, target.Center, sphere.Radius + target.Radius, t))
+        return CollisionResult();
+
+    const XMFLOAT3 center = Add3(sphere.Center, Scale3(displacement, t));
+    return MakeSweepResult(sphere, displacement, t, ClosestPointOnSphere(center, target));
+}
+
+// Sweep-Sphere-vs-Box
+CollisionResult CollisionSystem::SweepSphereVsBox(const BoundingSphere& sphere, const XMFLOAT3& displacement,
+    const BoundingBox& box)
+{
+    const float r = sphere.Radius;
+    const XMFLOAT3& o = sphere.Center;
+    const XMFLOAT3& d = displacement;
+
+    // Slab test against the box grown by r: exact in face regions, a lower bound elsewhere
+    const float origin[3] = { o.x, o.y, o.z };
+    const float dir[3] = { d.x, d.y, d.z };
+    const float mn[3] = { box.Min.x - r, box.Min.y - r, box.Min.z - r };
+    const float mx[3] = { box.Max.x + r, box.Max.y + r, box.Max.z + r };
+    float tmin = 0.0f, tmax = 1.0f;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (std::fabs(dir[axis]) < 1e-12f) {
+            if (origin[axis] < mn[axis] || origin[axis] > mx[axis]) return CollisionResult();
+            continue;
+        }
+        const float inv = 1.0f / dir[axis];
+        float t1 = (mn[axis] - origin[axis]) * inv;
+        float t2 = (mx[axis] - origin[axis]) * inv;
+        if (t1 > t2) std::swap(t1, t2);
+        tmin = std::max(tmin, t1);
+        tmax = std::min(tmax, t2);
+        if (tmin > tmax) return CollisionResult();
+    }
+
+    // Which Voronoi region of the original box the entry point lies in
+    const XMFLOAT3 p = Add3(o, Scale3(d, tmin));
+    int below = 0, above = 0;
+    if (p.x < box.Min.x) below |= 1; else if (p.x > box.Max.x) above |= 1;
+    if (p.y < box.Min.y) below |= 2; else if (p.y > box.Max.y) above |= 2;
+    if (p.z < box.Min.z) below |= 4; else if (p.z > box.Max.z) above |= 4;
+    const int outside = below | above;
+
+    auto corner = [&box](int bits) {
+        return XMFLOAT3((bits & 1) ? box.Max.x : box.Min.x,
+                        (bits & 2) ? box.Max.y : box.Min.y,
+                        (bits & 4) ? box.Max.z : box.Min.z);
+    };
+
+    float t = tmin;
+    if (outside == 7)
+    {
+        // Vertex region: the sphere can only first touch one of the three edges at this corner
+        const XMFLOAT3 v = corner(above);
+        float best = FLT_MAX, te;
+        for (int bit = 1; bit <= 4; bit <<= 1) {
+            if (SegmentCapsuleTime(o, d, v, corner(above ^ bit), r, te) && te < best) best = te;
+        }
+        if (best == FLT_MAX) return CollisionResult();
+        t = best;
+    }
+    else if (outside & (outside - 1))
+    {
+        // Edge region: the edge running along the one axis that is inside the slab
+        if (!SegmentCapsuleTime(o, d, corner(below ^ 7), corner(above), r, t)) return CollisionResult();
+    }
+
+    const XMFLOAT3 center = Add3(o, Scale3(d, t));
+    return MakeSweepResult(sphere, displacement, t, ClosestPointOnBox(center, box));
+}
+
+// Sweep-Sphere-vs-Triangle
+CollisionResult CollisionSystem::SweepSphereVsTriangle(const BoundingSphere& sphere, const XMFLOAT3& displacement,
+    const XMFLOAT3& v0, const XMFLOAT3& v1, const XMFLOAT3& v2)
+{
+    const float r = sphere.Radius;
+    const XMFLOAT3& o = sphere.Center;
+    const XMFLOAT3& d = displacement;
+
+    const XMFLOAT3 e1 = Sub3(v1, v0), e2 = Sub3(v2, v0);
+    XMFLOAT3 n = Vector3Cross(e1, e2);
+    const float area = Vector3Length(n);
+
+    if (area > 1e-12f)
+    {
+        n = Scale3(n, 1.0f / area);
+        const float distance = Dot3(Sub3(o, v0), n);
+        const float side = distance >= 0.0f ? 1.0f : -1.0f;
+        const float approach = Dot3(d, n);
+
+        // First time the sphere touches the plane, and where
+        float tPlane = -1.0f;
+        if (std::fabs(distance) <= r) tPlane = 0.0f;
+        else if (approach * side < 0.0f) tPlane = (side * r - distance) / approach;
+
+        if (tPlane >= 0.0f && tPlane <= 1.0f)
+        {
+            const XMFLOAT3 center = Add3(o, Scale3(d, tPlane));
+            const XMFLOAT3 q = Sub3(center, Scale3(n, Dot3(Sub3(center, v0), n)));
+
+            // Inside test: q on the inner side of all three edges
+            const bool inside =
+                Dot3(Vector3Cross(Sub3(v1, v0), Sub3(q, v0)), n) >= 0.0f &&
+                Dot3(Vector3Cross(Sub3(v2, v1), Sub3(q, v1)), n) >= 0.0f &&
+                Dot3(Vector3Cross(Sub3(v0, v2), Sub3(q, v2)), n) >= 0.0f;
+            if (inside) return MakeSweepResult(sphere, displacement, tPlane, q);
+        }
+        else
+        {
+            // Never reaches the plane this step, so it cannot reach an edge either
+            return CollisionResult();
+        }
+    }
+
+    // The face was missed (or the triangle is degenerate): the first contact is on an edge or vertex
+    const XMFLOAT3* edges[3][2] = { { &v0, &v1 }, { &v1, &v2 }, { &v2, &v0 } };
+    float best = FLT_MAX, te;
+    int bestEdge = -1;
+    for (int i = 0; i < 3; ++i) {
+        if (SegmentCapsuleTime(o, d, *edges[i][0], *edges[i][1], r, te) && te < best) {
+            best = te;
+            bestEdge = i;
+        }
+    }
+    if (bestEdge < 0) return CollisionResult();
+
+    const XMFLOAT3 center = Add3(o, Scale3(d, best));
+    return MakeSweepResult(sphere, displacement, best,
+        ClosestPointOnSegment(center, *edges[bestEdge][0], *edges[bestEdge][1]));
+}
+
 // Utility
 XMFLOAT3 CollisionSystem::ClosestPointOnBox(const XMFLOAT3& pt, const BoundingBox& b)
 {
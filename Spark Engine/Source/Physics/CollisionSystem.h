@@ -13,15 +13,21 @@
 #pragma once
 
 #include "Utils/Assert.h"
+#ifdef _WIN32
 #include "..\Core\framework.h"
+#endif
 #include <DirectXMath.h>
 #include <vector>
 #include <cfloat>
 #include <cmath>
+#include <cstdint>
+#include <string>
 
 using DirectX::XMFLOAT3;
 using DirectX::XMMATRIX;
 
+class TriangleBVH;
+
 /**
  * @brief Axis-aligned bounding box for collision detection
  * 
@@ -173,6 +179,131 @@ struct CollisionResult
     }
 };
 
+/**
+ * @brief Structure-of-arrays sphere set for batched collision queries
+ *
+ * Keeping each component in its own array lets the batch kernels load
+ * 4 (SSE) or 8 (AVX) spheres per instruction.
+ */
+struct SphereSoA
+{
+    std::vector<float> CenterX, CenterY, CenterZ, Radius;
+
+    void Add(const BoundingSphere& sphere);
+    void Reserve(size_t count);
+    void Clear();
+    size_t Size() const { return Radius.size(); }
+};
+
+/**
+ * @brief Structure-of-arrays axis-aligned box set for batched collision queries
+ */
+struct BoxSoA
+{
+    std::vector<float> MinX, MinY, MinZ, MaxX, MaxY, MaxZ;
+
+    void Add(const BoundingBox& box);
+    void Set(size_t index, const BoundingBox& box);
+    void Reserve(size_t count);
+    void Clear();
+    size_t Size() const { return MinX.size(); }
+};
+
+/**
+ * @brief Structure-of-arrays triangle set for batched ray queries
+ *
+ * Triangles are stored as a base vertex plus the two edges from it, which is
+ * the form the Moller-Trumbore test consumes directly.
+ */
+struct TriangleSoA
+{
+    std::vector<float> V0X, V0Y, V0Z;
+    std::vector<float> E1X, E1Y, E1Z;
+    std::vector<float> E2X, E2Y, E2Z;
+
+    void Add(const XMFLOAT3& v0, const XMFLOAT3& v1, const XMFLOAT3& v2);
+    void Reserve(size_t count);
+    void Clear();
+    size_t Size() const { return V0X.size(); }
+};
+
+/**
+ * @brief Per-primitive output of a batched collision query
+ *
+ * Bit i of the hit mask is set when primitive i was hit. Distances hold the
+ * ray parameter for ray queries and the signed separation for overlap
+ * queries (negative when penetrating); misses on ray queries report FLT_MAX.
+ */
+struct BatchHitResult
+{
+    std::vector<uint32_t> HitMask;   ///< One bit per primitive, 32 primitives per word
+    std::vector<float>    Distances; ///< One distance per primitive
+
+    void   Resize(size_t count);
+    bool   IsHit(size_t index) const { return (HitMask[index >> 5] >> (index & 31)) & 1u; }
+    size_t CountHits() const;
+
+    /**
+     * @brief Index of the hit primitive with the smallest distance
+     * @return Primitive index, or -1 if nothing was hit
+     */
+    int    ClosestHit() const;
+};
+
+/**
+ * @brief Structure-of-arrays set of moving spheres for batched sweeps
+ *
+ * Each sweep is a sphere moving from its start center along a displacement
+ * over one step. The reciprocal displacement is cached for the slab tests.
+ */
+struct SphereSweepSoA
+{
+    std::vector<float> StartX, StartY, StartZ;
+    std::vector<float> DeltaX, DeltaY, DeltaZ;
+    std::vector<float> InvDeltaX, InvDeltaY, InvDeltaZ;
+    std::vector<float> Radius;
+
+    void Add(const XMFLOAT3& start, const XMFLOAT3& displacement, float radius);
+    void Reserve(size_t count);
+    void Clear();
+    size_t Size() const { return Radius.size(); }
+};
+
+/**
+ * @brief Static geometry a batch of sweeps is resolved against (any set may be null)
+ */
+struct SweepTargets
+{
+    const SphereSoA*   Spheres = nullptr;
+    const BoxSoA*      Boxes = nullptr;
+    const TriangleSoA* Triangles = nullptr;
+};
+
+/**
+ * @brief Kind of primitive a sweep stopped against
+ */
+enum class SweepTargetType : uint8_t
+{
+    None,
+    Sphere,
+    Box,
+    Triangle
+};
+
+/**
+ * @brief Earliest impact of one sweep in a batch
+ */
+struct SweepHit
+{
+    float           Time = 1.0f;                ///< Time of impact as a fraction of the displacement
+    XMFLOAT3        Point = { 0, 0, 0 };        ///< Contact point on the target surface
+    XMFLOAT3        Normal = { 0, 1, 0 };       ///< Target surface normal facing the sphere
+    SweepTargetType Target = SweepTargetType::None;
+    uint32_t        Index = 0;                  ///< Index into the target set
+
+    bool IsHit() const { return Target != SweepTargetType::None; }
+};
+
 /**
  * @brief Static collision detection and physics utility class
  * 
@@ -262,6 +393,48 @@ public:
      */
     static CollisionResult RayVsTriangle(const Ray& ray, const XMFLOAT3& v0, const XMFLOAT3& v1, const XMFLOAT3& v2);
 
+    /**
+     * @brief Cast a ray against a triangle mesh through its BVH
+     * @param ray Ray to cast
+     * @param mesh Hierarchy built over the mesh triangles
+     * @param maxDistance Hits beyond this distance are ignored
+     * @return CollisionResult for the closest triangle hit
+     */
+    static CollisionResult RayVsMesh(const Ray& ray, const TriangleBVH& mesh, float maxDistance = FLT_MAX);
+
+    // ========================================================================
+    // SWEPT QUERIES (continuous collision)
+    // ========================================================================
+
+    /**
+     * @brief Sweep a moving sphere against a static sphere
+     * @param sphere Moving sphere at the start of the motion
+     * @param displacement Motion of the sphere center over the step
+     * @param target Static sphere
+     * @return Distance holds the time of impact as a fraction of the displacement
+     *         in [0, 1]; Point is the contact on the target surface and Normal
+     *         points from the target toward the moving sphere. A sphere that
+     *         starts overlapping reports a hit at time 0.
+     */
+    static CollisionResult SweepSphereVsSphere(const BoundingSphere& sphere, const XMFLOAT3& displacement, const BoundingSphere& target);
+
+    /**
+     * @brief Sweep a moving sphere against an axis-aligned box
+     *
+     * Exact against the rounded box (the box grown by the sphere radius), so
+     * edges and corners are not treated as sharp.
+     *
+     * @return Same conventions as SweepSphereVsSphere()
+     */
+    static CollisionResult SweepSphereVsBox(const BoundingSphere& sphere, const XMFLOAT3& displacement, const BoundingBox& box);
+
+    /**
+     * @brief Sweep a moving sphere against a double-sided triangle
+     * @return Same conventions as SweepSphereVsSphere()
+     */
+    static CollisionResult SweepSphereVsTriangle(const BoundingSphere& sphere, const XMFLOAT3& displacement,
+                                                 const XMFLOAT3& v0, const XMFLOAT3& v1, const XMFLOAT3& v2);
+
     /**
      * @brief Find the closest point on a box to a given point
      * @param point Point to find closest position to
@@ -356,4 +529,85 @@ public:
      * @return Interpolated vector
      */
     static XMFLOAT3 Vector3Lerp(const XMFLOAT3& a, const XMFLOAT3& b, float t);
+
+    // ========================================================================
+    // BATCHED QUERIES (SSE/AVX with scalar fallback)
+    // ========================================================================
+
+    /**
+     * @brief Test one sphere against a set of spheres
+     * @param query Query sphere
+     * @param spheres Target spheres
+     * @param out Hit mask and center separation (distance minus radii) per sphere
+     */
+    static void SphereVsSphereBatch(const BoundingSphere& query, const SphereSoA& spheres, BatchHitResult& out);
+
+    /**
+     * @brief Test one sphere against a set of axis-aligned boxes
+     * @param query Query sphere
+     * @param boxes Target boxes
+     * @param out Hit mask and distance from the sphere surface to each box
+     */
+    static void SphereVsBoxBatch(const BoundingSphere& query, const BoxSoA& boxes, BatchHitResult& out);
+
+    /**
+     * @brief Cast one ray against a set of spheres
+     * @param ray Ray to cast
+     * @param spheres Target spheres
+     * @param out Hit mask and hit distance per sphere
+     */
+    static void RayVsSphereBatch(const Ray& ray, const SphereSoA& spheres, BatchHitResult& out);
+
+    /**
+     * @brief Cast one ray against a set of axis-aligned boxes
+     * @param ray Ray to cast
+     * @param boxes Target boxes
+     * @param out Hit mask and entry distance per box
+     */
+    static void RayVsBoxBatch(const Ray& ray, const BoxSoA& boxes, BatchHitResult& out);
+
+    /**
+     * @brief Cast one ray against a set of triangles
+     * @param ray Ray to cast
+     * @param triangles Target triangles
+     * @param out Hit mask and hit distance per triangle
+     */
+    static void RayVsTriangleBatch(const Ray& ray, const TriangleSoA& triangles, BatchHitResult& out);
+
+    /**
+     * @brief Resolve the earliest impact of every sweep against a set of static targets
+     *
+     * The SIMD lanes run across sweeps: each target is broadcast and tested
+     * against a block of sweeps with a conservative slab test on its grown
+     * bounds, and only surviving (sweep, target) pairs run the exact scalar
+     * SweepSphereVs*() test. A whole volley of projectiles is resolved in a
+     * single pass with no per-projectile dispatch.
+     *
+     * @param sweeps Moving spheres
+     * @param targets Static geometry
+     * @param out One entry per sweep; misses keep Target == SweepTargetType::None
+     */
+    static void SweepSpheresBatch(const SphereSweepSoA& sweeps, const SweepTargets& targets, std::vector<SweepHit>& out);
+
+    /**
+     * @brief Number of primitives the batch kernels process per instruction (8 AVX, 4 SSE, 1 scalar)
+     */
+    static int GetBatchWidth();
+
+    // ========================================================================
+    // CONSOLE INTEGRATION
+    // ========================================================================
+
+    /**
+     * @brief Check the batch kernels on random primitives
+     *
+     * Runs every batch query through the dispatched SIMD kernels and again
+     * through the scalar lanes, which must agree bit for bit, and compares
+     * both with the single-pair tests above. Sphere sweeps are compared with
+     * a brute-force search over the same targets.
+     *
+     * @param count Spheres, boxes and triangles per set
+     * @return Per-query agreement and an overall PASS/FAIL
+     */
+    static std::string Console_CheckBatchKernels(int count);
 };
\ No newline at end of file
@@ -0,0 +1,910 @@
+/**
+ * @file CollisionSystemBatch.cpp
+ * @brief Structure-of-arrays batch variants of the CollisionSystem primitive tests
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * Each kernel is written once against a small lane abstraction and
+ * instantiated for AVX (8 wide), SSE (4 wide) and plain floats. AVX is
+ * picked at run time from CPUID, as in CullingSystem.cpp, so it is used
+ * without /arch:AVX; otherwise SSE handles full blocks. The scalar lane
+ * handles the tail. Comparisons, clamping and early-out conditions mirror the
+ * single-pair functions in CollisionSystem.cpp, so hit masks agree with them
+ * up to floating-point rounding of the dot products.
+ *
+ * The sphere sweeps invert the layout: lanes run across moving spheres and
+ * each static target is broadcast, so the vector pass acts as a filter in
+ * front of the exact scalar time-of-impact tests.
+ */
+
+#include "CollisionSystem.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <sstream>
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define SPARK_COLLISION_SSE 1
+#endif
+
+// MSVC accepts AVX intrinsics without /arch:AVX; the kernels are then picked at run time
+#if defined(__AVX__) || (defined(_MSC_VER) && SPARK_COLLISION_SSE)
+#define SPARK_COLLISION_AVX 1
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// ============================================================================
+// SOA CONTAINERS
+// ============================================================================
+
+void SphereSoA::Add(const BoundingSphere& sphere)
+{
+    CenterX.push_back(sphere.Center.x);
+    CenterY.push_back(sphere.Center.y);
+    CenterZ.push_back(sphere.Center.z);
+    Radius.push_back(sphere.Radius);
+}
+
+void SphereSoA::Reserve(size_t count)
+{
+    CenterX.reserve(count); CenterY.reserve(count); CenterZ.reserve(count); Radius.reserve(count);
+}
+
+void SphereSoA::Clear()
+{
+    CenterX.clear(); CenterY.clear(); CenterZ.clear(); Radius.clear();
+}
+
+void BoxSoA::Add(const BoundingBox& box)
+{
+    MinX.push_back(box.Min.x); MinY.push_back(box.Min.y); MinZ.push_back(box.Min.z);
+    MaxX.push_back(box.Max.x); MaxY.push_back(box.Max.y); MaxZ.push_back(box.Max.z);
+}
+
+void BoxSoA::Set(size_t index, const BoundingBox& box)
+{
+    ASSERT_MSG(index < Size(), "Box index %zu out of range", index);
+    MinX[index] = box.Min.x; MinY[index] = box.Min.y; MinZ[index] = box.Min.z;
+    MaxX[index] = box.Max.x; MaxY[index] = box.Max.y; MaxZ[index] = box.Max.z;
+}
+
+void BoxSoA::Reserve(size_t count)
+{
+    MinX.reserve(count); MinY.reserve(count); MinZ.reserve(count);
+    MaxX.reserve(count); MaxY.reserve(count); MaxZ.reserve(count);
+}
+
+void BoxSoA::Clear()
+{
+    MinX.clear(); MinY.clear(); MinZ.clear();
+    MaxX.clear(); MaxY.clear(); MaxZ.clear();
+}
+
+void TriangleSoA::Add(const XMFLOAT3& v0, const XMFLOAT3& v1, const XMFLOAT3& v2)
+{
+    V0X.push_back(v0.x); V0Y.push_back(v0.y); V0Z.push_back(v0.z);
+    E1X.push_back(v1.x - v0.x); E1Y.push_back(v1.y - v0.y); E1Z.push_back(v1.z - v0.z);
+    E2X.push_back(v2.x - v0.x); E2Y.push_back(v2.y - v0.y); E2Z.push_back(v2.z - v0.z);
+}
+
+void TriangleSoA::Reserve(size_t count)
+{
+    V0X.reserve(count); V0Y.reserve(count); V0Z.reserve(count);
+    E1X.reserve(count); E1Y.reserve(count); E1Z.reserve(count);
+    E2X.reserve(count); E2Y.reserve(count); E2Z.reserve(count);
+}
+
+void TriangleSoA::Clear()
+{
+    V0X.clear(); V0Y.clear(); V0Z.clear();
+    E1X.clear(); E1Y.clear(); E1Z.clear();
+    E2X.clear(); E2Y.clear(); E2Z.clear();
+}
+
+void SphereSweepSoA::Add(const XMFLOAT3& start, const XMFLOAT3& displacement, float radius)
+{
+    // A huge finite reciprocal keeps the slab test free of 0 * inf for axis-parallel motion
+    auto reciprocal = [](float v) { return std::fabs(v) > 1e-20f ? 1.0f / v : 1e20f; };
+
+    StartX.push_back(start.x); StartY.push_back(start.y); StartZ.push_back(start.z);
+    DeltaX.push_back(displacement.x); DeltaY.push_back(displacement.y); DeltaZ.push_back(displacement.z);
+    InvDeltaX.push_back(reciprocal(displacement.x));
+    InvDeltaY.push_back(reciprocal(displacement.y));
+    InvDeltaZ.push_back(reciprocal(displacement.z));
+    Radius.push_back(radius);
+}
+
+void SphereSweepSoA::Reserve(size_t count)
+{
+    StartX.reserve(count); StartY.reserve(count); StartZ.reserve(count);
+    DeltaX.reserve(count); DeltaY.reserve(count); DeltaZ.reserve(count);
+    InvDeltaX.reserve(count); InvDeltaY.reserve(count); InvDeltaZ.reserve(count);
+    Radius.reserve(count);
+}
+
+void SphereSweepSoA::Clear()
+{
+    StartX.clear(); StartY.clear(); StartZ.clear();
+    DeltaX.clear(); DeltaY.clear(); DeltaZ.clear();
+    InvDeltaX.clear(); InvDeltaY.clear(); InvDeltaZ.clear();
+    Radius.clear();
+}
+
+void BatchHitResult::Resize(size_t count)
+{
+    HitMask.assign((count + 31) / 32, 0u);
+    Distances.resize(count);
+}
+
+size_t BatchHitResult::CountHits() const
+{
+    size_t hits = 0;
+    for (uint32_t word : HitMask) {
+        while (word) {
+            word &= word - 1;
+            ++hits;
+        }
+    }
+    return hits;
+}
+
+int BatchHitResult::ClosestHit() const
+{
+    int best = -1;
+    float bestDistance = FLT_MAX;
+    for (size_t i = 0; i < Distances.size(); ++i) {
+        if (IsHit(i) && Distances[i] < bestDistance) {
+            bestDistance = Distances[i];
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+// ============================================================================
+// LANE ABSTRACTIONS
+// ============================================================================
+
+namespace
+{
+    struct ScalarLane
+    {
+        using Type = float;
+        using Mask = bool;
+        static constexpr int Width = 1;
+
+        static Type Load(const float* p) { return *p; }
+        static void Store(float* p, Type v) { *p = v; }
+        static Type Set(float v) { return v; }
+        static Type Add(Type a, Type b) { return a + b; }
+        static Type Sub(Type a, Type b) { return a - b; }
+        static Type Mul(Type a, Type b) { return a * b; }
+        static Type Div(Type a, Type b) { return a / b; }
+        static Type Min(Type a, Type b) { return std::min(a, b); }
+        static Type Max(Type a, Type b) { return std::max(a, b); }
+        static Type Sqrt(Type a) { return std::sqrt(a); }
+        static Type Abs(Type a) { return std::fabs(a); }
+        static Mask Less(Type a, Type b) { return a < b; }
+        static Mask LessEq(Type a, Type b) { return a <= b; }
+        static Mask Greater(Type a, Type b) { return a > b; }
+        static Mask And(Mask a, Mask b) { return a && b; }
+        static Mask Or(Mask a, Mask b) { return a || b; }
+        static Mask Not(Mask a) { return !a; }
+        static Type Select(Mask m, Type a, Type b) { return m ? a : b; }
+        static uint32_t Bits(Mask m) { return m ? 1u : 0u; }
+    };
+
+#if SPARK_COLLISION_SSE
+    struct SseLane
+    {
+        using Type = __m128;
+        using Mask = __m128;
+        static constexpr int Width = 4;
+
+        static Type Load(const float* p) { return _mm_loadu_ps(p); }
+        static void Store(float* p, Type v) { _mm_storeu_ps(p, v); }
+        static Type Set(float v) { return _mm_set1_ps(v); }
+        static Type Add(Type a, Type b) { return _mm_add_ps(a, b); }
+        static Type Sub(Type a, Type b) { return _mm_sub_ps(a, b); }
+        static Type Mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+        static Type Div(Type a, Type b) { return _mm_div_ps(a, b); }
+        static Type Min(Type a, Type b) { return _mm_min_ps(b, a); }   // std::min(a, b) returns a unless b < a
+        static Type Max(Type a, Type b) { return _mm_max_ps(b, a); }   // std::max(a, b) returns a unless a < b
+        static Type Sqrt(Type a) { return _mm_sqrt_ps(a); }
+        static Type Abs(Type a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+        static Mask Less(Type a, Type b) { return _mm_cmplt_ps(a, b); }
+        static Mask LessEq(Type a, Type b) { return _mm_cmple_ps(a, b); }
+        static Mask Greater(Type a, Type b) { return _mm_cmpgt_ps(a, b); }
+        static Mask And(Mask a, Mask b) { return _mm_and_ps(a, b); }
+        static Mask Or(Mask a, Mask b) { return _mm_or_ps(a, b); }
+        static Mask Not(Mask a) { return _mm_xor_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+        static Type Select(Mask m, Type a, Type b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+        static uint32_t Bits(Mask m) { return static_cast<uint32_t>(_mm_movemask_ps(m)); }
+    };
+#endif
+
+#if SPARK_COLLISION_AVX
+    struct AvxLane
+    {
+        using Type = __m256;
+        using Mask = __m256;
+        static constexpr int Width = 8;
+
+        static Type Load(const float* p) { return _mm256_loadu_ps(p); }
+        static void Store(float* p, Type v) { _mm256_storeu_ps(p, v); }
+        static Type Set(float v) { return _mm256_set1_ps(v); }
+        static Type Add(Type a, Type b) { return _mm256_add_ps(a, b); }
+        static Type Sub(Type a, Type b) { return _mm256_sub_ps(a, b); }
+        static Type Mul(Type a, Type b) { return _mm256_mul_ps(a, b); }
+        static Type Div(Type a, Type b) { return _mm256_div_ps(a, b); }
+        static Type Min(Type a, Type b) { return _mm256_min_ps(b, a); }
+        static Type Max(Type a, Type b) { return _mm256_max_ps(b, a); }
+        static Type Sqrt(Type a) { return _mm256_sqrt_ps(a); }
+        static Type Abs(Type a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+        static Mask Less(Type a, Type b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        static Mask LessEq(Type a, Type b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+        static Mask Greater(Type a, Type b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+        static Mask And(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+        static Mask Or(Mask a, Mask b) { return _mm256_or_ps(a, b); }
+        static Mask Not(Mask a) { return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+        static Type Select(Mask m, Type a, Type b) { return _mm256_blendv_ps(b, a, m); }
+        static uint32_t Bits(Mask m) { return static_cast<uint32_t>(_mm256_movemask_ps(m)); }
+    };
+#endif
+
+#if SPARK_COLLISION_SSE
+    using NarrowLane = SseLane;
+#else
+    using NarrowLane = ScalarLane;
+#endif
+
+    bool CpuSupportsAvx()
+    {
+#if defined(__AVX__)
+        return true;
+#elif SPARK_COLLISION_AVX
+        int info[4];
+        __cpuid(info, 1);
+        const bool osSavesYmm = (info[2] & (1 << 27)) != 0;
+        const bool hasAvx = (info[2] & (1 << 28)) != 0;
+        return osSavesYmm && hasAvx && (_xgetbv(0) & 0x6) == 0x6;
+#else
+        return false;
+#endif
+    }
+
+    const bool g_useAvx = CpuSupportsAvx();
+
+    /**
+     * @brief Clear the upper YMM halves before returning to non-VEX code
+     *
+     * Only needed when AVX was selected at run time: the rest of the file is
+     * then compiled as legacy SSE, which stalls on dirty upper registers.
+     */
+    template<typename L>
+    void LeaveLanes()
+    {
+#if SPARK_COLLISION_AVX && !defined(__AVX__)
+        if constexpr (L::Width == 8) _mm256_zeroupper();
+#endif
+    }
+
+    /**
+     * @brief Run a kernel over every primitive, L lanes first and scalar for the tail
+     *
+     * Kernels expose template<class L> static uint32_t Run(const Ctx&, size_t i, float* dist)
+     * returning one hit bit per lane. Blocks start on multiples of the lane
+     * width, and 32 is a multiple of every width, so a block never straddles
+     * two mask words.
+     */
+    template<typename L, typename Kernel, typename Context>
+    void RunBatchWith(const Context& ctx, size_t count, BatchHitResult& out)
+    {
+        out.Resize(count);
+        float* distances = out.Distances.data();
+
+        size_t i = 0;
+        if constexpr (L::Width > 1)
+        {
+            for (; i + L::Width <= count; i += L::Width) {
+                const uint32_t bits = Kernel::template Run<L>(ctx, i, distances + i);
+                out.HitMask[i >> 5] |= bits << (i & 31);
+            }
+            LeaveLanes<L>();
+        }
+        for (; i < count; ++i) {
+            const uint32_t bits = Kernel::template Run<ScalarLane>(ctx, i, distances + i);
+            out.HitMask[i >> 5] |= bits << (i & 31);
+        }
+    }
+
+    /// Run a kernel with the widest lanes this CPU supports
+    template<typename Kernel, typename Context>
+    void RunBatch(const Context& ctx, size_t count, BatchHitResult& out)
+    {
+#if SPARK_COLLISION_AVX
+        if (g_useAvx) return RunBatchWith<AvxLane, Kernel>(ctx, count, out);
+#endif
+        RunBatchWith<NarrowLane, Kernel>(ctx, count, out);
+    }
+
+    // ------------------------------------------------------------------------
+    // Kernels
+    // ------------------------------------------------------------------------
+
+    struct SphereQueryContext
+    {
+        float cx, cy, cz, radius;
+        const SphereSoA* spheres;
+        const BoxSoA* boxes;
+    };
+
+    struct SphereSphereKernel
+    {
+        template<typename L>
+        static uint32_t Run(const SphereQueryContext& c, size_t i, float* dist)
+        {
+            const SphereSoA& s = *c.spheres;
+            const auto dx = L::Sub(L::Load(&s.CenterX[i]), L::Set(c.cx));
+            const auto dy = L::Sub(L::Load(&s.CenterY[i]), L::Set(c.cy));
+            const auto dz = L::Sub(L::Load(&s.CenterZ[i]), L::Set(c.cz));
+            const auto d = L::Sqrt(L::Add(L::Add(L::Mul(dx, dx), L::Mul(dy, dy)), L::Mul(dz, dz)));
+            const auto rSum = L::Add(L::Set(c.radius), L::Load(&s.Radius[i]));
+            L::Store(dist, L::Sub(d, rSum));
+            return L::Bits(L::LessEq(d, rSum));
+        }
+    };
+
+    struct SphereBoxKernel
+    {
+        template<typename L>
+        static uint32_t Run(const SphereQueryContext& c, size_t i, float* dist)
+        {
+            const BoxSoA& b = *c.boxes;
+            const auto cx = L::Set(c.cx), cy = L::Set(c.cy), cz = L::Set(c.cz);
+
+            // Closest point on the box, as ClosestPointOnBox() computes it with std::clamp
+            const auto px = L::Min(L::Max(cx, L::Load(&b.MinX[i])), L::Load(&b.MaxX[i]));
+            const auto py = L::Min(L::Max(cy, L::Load(&b.MinY[i])), L::Load(&b.MaxY[i]));
+            const auto pz = L::Min(L::Max(cz, L::Load(&b.MinZ[i])), L::Load(&b.MaxZ[i]));
+
+            const auto dx = L::Sub(cx, px), dy = L::Sub(cy, py), dz = L::Sub(cz, pz);
+            const auto d = L::Sqrt(L::Add(L::Add(L::Mul(dx, dx), L::Mul(dy, dy)), L::Mul(dz, dz)));
+            const auto r = L::Set(c.radius);
+            L::Store(dist, L::Sub(d, r));
+            return L::Bits(L::LessEq(d, r));
+        }
+    };
+
+    struct RayContext
+    {
+        float ox, oy, oz;       ///< Ray origin
+        float dx, dy, dz;       ///< Normalized direction
+        float ix, iy, iz;       ///< Reciprocal of the raw direction (box slabs)
+        float a;                ///< dot(d, d) for the sphere quadratic
+        const SphereSoA* spheres;
+        const BoxSoA* boxes;
+        const TriangleSoA* triangles;
+    };
+
+    RayContext MakeRayContext(const Ray& ray)
+    {
+        RayContext c{};
+        c.ox = ray.Origin.x; c.oy = ray.Origin.y; c.oz = ray.Origin.z;
+
+        XMFLOAT3 d = CollisionSystem::Vector3Normalize(ray.Direction);
+        c.dx = d.x; c.dy = d.y; c.dz = d.z;
+        c.a = d.x * d.x + d.y * d.y + d.z * d.z;
+
+        c.ix = 1.0f / ray.Direction.x;
+        c.iy = 1.0f / ray.Direction.y;
+        c.iz = 1.0f / ray.Direction.z;
+        return c;
+    }
+
+    struct RaySphereKernel
+    {
+        template<typename L>
+        static uint32_t Run(const RayContext& c, size_t i, float* dist)
+        {
+            const SphereSoA& s = *c.spheres;
+            const auto ocx = L::Sub(L::Set(c.ox), L::Load(&s.CenterX[i]));
+            const auto ocy = L::Sub(L::Set(c.oy), L::Load(&s.CenterY[i]));
+            const auto ocz = L::Sub(L::Set(c.oz), L::Load(&s.CenterZ[i]));
+            const auto r = L::Load(&s.Radius[i]);
+
+            const auto a = L::Set(c.a);
+            const auto ocDotD = L::Add(L::Add(L::Mul(ocx, L::Set(c.dx)), L::Mul(ocy, L::Set(c.dy))), L::Mul(ocz, L::Set(c.dz)));
+            const auto b = L::Mul(L::Set(2.0f), ocDotD);
+            const auto ocDotOc = L::Add(L::Add(L::Mul(ocx, ocx), L::Mul(ocy, ocy)), L::Mul(ocz, ocz));
+            const auto cc = L::Sub(ocDotOc, L::Mul(r, r));
+            const auto disc = L::Sub(L::Mul(b, b), L::Mul(L::Mul(L::Set(4.0f), a), cc));
+
+            const auto noRoots = L::Less(disc, L::Set(0.0f));
+            const auto sq = L::Sqrt(L::Max(disc, L::Set(0.0f)));
+            const auto twoA = L::Mul(L::Set(2.0f), a);
+            const auto negB = L::Sub(L::Set(0.0f), b);
+            const auto t0 = L::Div(L::Sub(negB, sq), twoA);
+            const auto t1 = L::Div(L::Add(negB, sq), twoA);
+            const auto t = L::Select(L::Greater(t0, L::Set(0.0f)), t0, t1);
+
+            const auto hit = L::Not(L::Or(noRoots, L::Less(t, L::Set(0.0f))));
+            L::Store(dist, L::Select(hit, t, L::Set(FLT_MAX)));
+            return L::Bits(hit);
+        }
+    };
+
+    struct RayBoxKernel
+    {
+        template<typename L>
+        static uint32_t Run(const RayContext& c, size_t i, float* dist)
+        {
+            const BoxSoA& b = *c.boxes;
+
+            auto slab = [&](const float* mn, const float* mx, float o, float inv, auto& tmin, auto& tmax) {
+                const auto t1 = L::Mul(L::Sub(L::Load(mn), L::Set(o)), L::Set(inv));
+                const auto t2 = L::Mul(L::Sub(L::Load(mx), L::Set(o)), L::Set(inv));
+                tmin = L::Min(t1, t2);
+                tmax = L::Max(t1, t2);
+            };
+
+            typename L::Type tminx, tmaxx, tminy, tmaxy, tminz, tmaxz;
+            slab(&b.MinX[i], &b.MaxX[i], c.ox, c.ix, tminx, tmaxx);
+            slab(&b.MinY[i], &b.MaxY[i], c.oy, c.iy, tminy, tmaxy);
+            slab(&b.MinZ[i], &b.MaxZ[i], c.oz, c.iz, tminz, tmaxz);
+
+            // Same reduction order as std::max({ tminx, tminy, tminz, 0 }) in RayVsBox()
+            const auto tmin = L::Max(L::Max(L::Max(tminx, tminy), tminz), L::Set(0.0f));
+            const auto tmax = L::Min(L::Min(L::Min(tmaxx, tmaxy), tmaxz), L::Set(FLT_MAX));
+
+            const auto hit = L::LessEq(tmin, tmax);
+            L::Store(dist, L::Select(hit, tmin, L::Set(FLT_MAX)));
+            return L::Bits(hit);
+        }
+    };
+
+    struct RayTriangleKernel
+    {
+        template<typename L>
+        static uint32_t Run(const RayContext& c, size_t i, float* dist)
+        {
+            const TriangleSoA& tri = *c.triangles;
+            const auto dx = L::Set(c.dx), dy = L::Set(c.dy), dz = L::Set(c.dz);
+            const auto e1x = L::Load(&tri.E1X[i]), e1y = L::Load(&tri.E1Y[i]), e1z = L::Load(&tri.E1Z[i]);
+            const auto e2x = L::Load(&tri.E2X[i]), e2y = L::Load(&tri.E2Y[i]), e2z = L::Load(&tri.E2Z[i]);
+
+            auto dot = [](auto ax, auto ay, auto az, auto bx, auto by, auto bz) {
+                return L::Add(L::Add(L::Mul(ax, bx), L::Mul(ay, by)), L::Mul(az, bz));
+            };
+
+            // h = d x e2
+            const auto hx = L::Sub(L::Mul(dy, e2z), L::Mul(dz, e2y));
+            const auto hy = L::Sub(L::Mul(dz, e2x), L::Mul(dx, e2z));
+            const auto hz = L::Sub(L::Mul(dx, e2y), L::Mul(dy, e2x));
+            const auto a = dot(e1x, e1y, e1z, hx, hy, hz);
+            const auto parallel = L::Less(L::Abs(a), L::Set(1e-6f));
+
+            const auto f = L::Div(L::Set(1.0f), a);
+            const auto sx = L::Sub(L::Set(c.ox), L::Load(&tri.V0X[i]));
+            const auto sy = L::Sub(L::Set(c.oy), L::Load(&tri.V0Y[i]));
+            const auto sz = L::Sub(L::Set(c.oz), L::Load(&tri.V0Z[i]));
+            const auto u = L::Mul(f, dot(sx, sy, sz, hx, hy, hz));
+
+            // q = s x e1
+            const auto qx = L::Sub(L::Mul(sy, e1z), L::Mul(sz, e1y));
+            const auto qy = L::Sub(L::Mul(sz, e1x), L::Mul(sx, e1z));
+            const auto qz = L::Sub(L::Mul(sx, e1y), L::Mul(sy, e1x));
+            const auto v = L::Mul(f, dot(dx, dy, dz, qx, qy, qz));
+            const auto t = L::Mul(f, dot(e2x, e2y, e2z, qx, qy, qz));
+
+            const auto zero = L::Set(0.0f), one = L::Set(1.0f);
+            auto miss = parallel;
+            miss = L::Or(miss, L::Or(L::Less(u, zero), L::Greater(u, one)));
+            miss = L::Or(miss, L::Or(L::Less(v, zero), L::Greater(L::Add(u, v), one)));
+            miss = L::Or(miss, L::LessEq(t, L::Set(1e-6f)));
+
+            const auto hit = L::Not(miss);
+            L::Store(dist, L::Select(hit, t, L::Set(FLT_MAX)));
+            return L::Bits(hit);
+        }
+    };
+
+    // ------------------------------------------------------------------------
+    // Sweep kernels (lanes run across sweeps, the target is broadcast)
+    // ------------------------------------------------------------------------
+
+    struct SweepBoundsContext
+    {
+        float minX, minY, minZ, maxX, maxY, maxZ;   ///< Target bounds
+        const SphereSweepSoA* sweeps;
+        const float* best;                          ///< Earliest impact found so far, per sweep
+    };
+
+    /**
+     * @brief Slab test of each sweep against the target bounds grown by the sweep radius
+     *
+     * Conservative: every sweep that can reach the target before its current
+     * best impact passes, plus some that only clip the corners of the grown box.
+     */
+    struct SweepBoundsKernel
+    {
+        template<typename L>
+        static uint32_t Run(const SweepBoundsContext& c, size_t i)
+        {
+            const SphereSweepSoA& s = *c.sweeps;
+            const auto r = L::Load(&s.Radius[i]);
+
+            auto slab = [&](float mn, float mx, const float* start, const float* inv, auto& tmin, auto& tmax) {
+                const auto o = L::Load(start);
+                const auto iv = L::Load(inv);
+                const auto t1 = L::Mul(L::Sub(L::Sub(L::Set(mn), r), o), iv);
+                const auto t2 = L::Mul(L::Sub(L::Add(L::Set(mx), r), o), iv);
+                tmin = L::Min(t1, t2);
+                tmax = L::Max(t1, t2);
+            };
+
+            typename L::Type tminx, tmaxx, tminy, tmaxy, tminz, tmaxz;
+            slab(c.minX, c.maxX, &s.StartX[i], &s.InvDeltaX[i], tminx, tmaxx);
+            slab(c.minY, c.maxY, &s.StartY[i], &s.InvDeltaY[i], tminy, tmaxy);
+            slab(c.minZ, c.maxZ, &s.StartZ[i], &s.InvDeltaZ[i], tminz, tmaxz);
+
+            const auto tmin = L::Max(L::Max(L::Max(tminx, tminy), tminz), L::Set(0.0f));
+            const auto tmax = L::Min(L::Min(L::Min(tmaxx, tmaxy), tmaxz), L::Load(c.best + i));
+            return L::Bits(L::LessEq(tmin, tmax));
+        }
+    };
+
+    /**
+     * @brief Invoke refine(sweepIndex) for every sweep whose grown-bounds test passes
+     */
+    template<typename L, typename Refine>
+    void ForEachSweepCandidateWith(const SweepBoundsContext& ctx, size_t count, Refine&& refine)
+    {
+        size_t i = 0;
+        if constexpr (L::Width > 1)
+        {
+            for (; i + L::Width <= count; i += L::Width) {
+                const uint32_t bits = SweepBoundsKernel::Run<L>(ctx, i);
+                if (!bits) continue;
+                LeaveLanes<L>();   // refine() runs the scalar time-of-impact tests
+                for (int lane = 0; lane < L::Width; ++lane) {
+                    if ((bits >> lane) & 1u) refine(i + lane);
+                }
+            }
+            LeaveLanes<L>();
+        }
+        for (; i < count; ++i) {
+            if (SweepBoundsKernel::Run<ScalarLane>(ctx, i)) refine(i);
+        }
+    }
+
+    template<typename Refine>
+    void ForEachSweepCandidate(const SweepBoundsContext& ctx, size_t count, Refine&& refine)
+    {
+#if SPARK_COLLISION_AVX
+        if (g_useAvx) return ForEachSweepCandidateWith<AvxLane>(ctx, count, refine);
+#endif
+        ForEachSweepCandidateWith<NarrowLane>(ctx, count, refine);
+    }
+}
+
+// ============================================================================
+// PUBLIC ENTRY POINTS
+// ============================================================================
+
+void CollisionSystem::SphereVsSphereBatch(const BoundingSphere& query, const SphereSoA& spheres, BatchHitResult& out)
+{
+    SphereQueryContext ctx{ query.Center.x, query.Center.y, query.Center.z, query.Radius, &spheres, nullptr };
+    RunBatch<SphereSphereKernel>(ctx, spheres.Size(), out);
+}
+
+void CollisionSystem::SphereVsBoxBatch(const BoundingSphere& query, const BoxSoA& boxes, BatchHitResult& out)
+{
+    SphereQueryContext ctx{ query.Center.x, query.Center.y, query.Center.z, query.Radius, nullptr, &boxes };
+    RunBatch<SphereBoxKernel>(ctx, boxes.Size(), out);
+}
+
+void CollisionSystem::RayVsSphereBatch(const Ray& ray, const SphereSoA& spheres, BatchHitResult& out)
+{
+    RayContext ctx = MakeRayContext(ray);
+    ctx.spheres = &spheres;
+    RunBatch<RaySphereKernel>(ctx, spheres.Size(), out);
+}
+
+void CollisionSystem::RayVsBoxBatch(const Ray& ray, const BoxSoA& boxes, BatchHitResult& out)
+{
+    RayContext ctx = MakeRayContext(ray);
+    ctx.boxes = &boxes;
+    RunBatch<RayBoxKernel>(ctx, boxes.Size(), out);
+}
+
+void CollisionSystem::RayVsTriangleBatch(const Ray& ray, const TriangleSoA& triangles, BatchHitResult& out)
+{
+    RayContext ctx = MakeRayContext(ray);
+    ctx.triangles = &triangles;
+    RunBatch<RayTriangleKernel>(ctx, triangles.Size(), out);
+}
+
+void CollisionSystem::SweepSpheresBatch(const SphereSweepSoA& sweeps, const SweepTargets& targets, std::vector<SweepHit>& out)
+{
+    const size_t count = sweeps.Size();
+    out.assign(count, SweepHit{});
+    if (count == 0) return;
+
+    // Impacts are only searched for within this step
+    std::vector<float> best(count, 1.0f);
+
+    SweepBoundsContext ctx{};
+    ctx.sweeps = &sweeps;
+    ctx.best = best.data();
+
+    auto sweepSphere = [&sweeps](size_t i) {
+        return BoundingSphere(XMFLOAT3(sweeps.StartX[i], sweeps.StartY[i], sweeps.StartZ[i]), sweeps.Radius[i]);
+    };
+    auto sweepDelta = [&sweeps](size_t i) {
+        return XMFLOAT3(sweeps.DeltaX[i], sweeps.DeltaY[i], sweeps.DeltaZ[i]);
+    };
+    auto record = [&](size_t i, const CollisionResult& r, SweepTargetType type, size_t target) {
+        if (!r.Hit || r.Distance >= best[i]) return;
+        best[i] = r.Distance;
+        SweepHit& hit = out[i];
+        hit.Time = r.Distance;
+        hit.Point = r.Point;
+        hit.Normal = r.Normal;
+        hit.Target = type;
+        hit.Index = static_cast<uint32_t>(target);
+    };
+
+    if (const SphereSoA* spheres = targets.Spheres)
+    {
+        for (size_t j = 0; j < spheres->Size(); ++j)
+        {
+            const BoundingSphere target(XMFLOAT3(spheres->CenterX[j], spheres->CenterY[j], spheres->CenterZ[j]),
+                                        spheres->Radius[j]);
+            ctx.minX = target.Center.x - target.Radius; ctx.maxX = target.Center.x + target.Radius;
+            ctx.minY = target.Center.y - target.Radius; ctx.maxY = target.Center.y + target.Radius;
+            ctx.minZ = target.Center.z - target.Radius; ctx.maxZ = target.Center.z + target.Radius;
+            ForEachSweepCandidate(ctx, count, [&](size_t i) {
+                record(i, SweepSphereVsSphere(sweepSphere(i), sweepDelta(i), target), SweepTargetType::Sphere, j);
+            });
+        }
+    }
+
+    if (const BoxSoA* boxes = targets.Boxes)
+    {
+        for (size_t j = 0; j < boxes->Size(); ++j)
+        {
+            const BoundingBox target(XMFLOAT3(boxes->MinX[j], boxes->MinY[j], boxes->MinZ[j]),
+                                     XMFLOAT3(boxes->MaxX[j], boxes->MaxY[j], boxes->MaxZ[j]));
+            ctx.minX = target.Min.x; ctx.maxX = target.Max.x;
+            ctx.minY = target.Min.y; ctx.maxY = target.Max.y;
+            ctx.minZ = target.Min.z; ctx.maxZ = target.Max.z;
+            ForEachSweepCandidate(ctx, count, [&](size_t i) {
+                record(i, SweepSphereVsBox(sweepSphere(i), sweepDelta(i), target), SweepTargetType::Box, j);
+            });
+        }
+    }
+
+    if (const TriangleSoA* triangles = targets.Triangles)
+    {
+        for (size_t j = 0; j < triangles->Size(); ++j)
+        {
+            const XMFLOAT3 v0(triangles->V0X[j], triangles->V0Y[j], triangles->V0Z[j]);
+            const XMFLOAT3 v1(v0.x + triangles->E1X[j], v0.y + triangles->E1Y[j], v0.z + triangles->E1Z[j]);
+            const XMFLOAT3 v2(v0.x + triangles->E2X[j], v0.y + triangles->E2Y[j], v0.z + triangles->E2Z[j]);
+            ctx.minX = std::min({ v0.x, v1.x, v2.x }); ctx.maxX = std::max({ v0.x, v1.x, v2.x });
+            ctx.minY = std::min({ v0.y, v1.y, v2.y }); ctx.maxY = std::max({ v0.y, v1.y, v2.y });
+            ctx.minZ = std::min({ v0.z, v1.z, v2.z }); ctx.maxZ = std::max({ v0.z, v1.z, v2.z });
+            ForEachSweepCandidate(ctx, count, [&](size_t i) {
+                record(i, SweepSphereVsTriangle(sweepSphere(i), sweepDelta(i), v0, v1, v2), SweepTargetType::Triangle, j);
+            });
+        }
+    }
+}
+
+int CollisionSystem::GetBatchWidth()
+{
+#if SPARK_COLLISION_AVX
+    if (g_useAvx) return 8;
+#endif
+    return NarrowLane::Width;
+}
+
+// ============================================================================
+// CONSOLE INTEGRATION
+// ============================================================================
+
+std::string CollisionSystem::Console_CheckBatchKernels(int count)
+{
+    count = std::clamp(count, 8, 1000000);
+    constexpr int RayCount = 16;
+
+    std::mt19937 rng(2024);
+    std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> size(0.1f, 5.0f);
+    auto randomPoint = [&]() { return XMFLOAT3(position(rng), position(rng), position(rng)); };
+
+    SphereSoA spheres;
+    BoxSoA boxes;
+    TriangleSoA triangles;
+    std::vector<BoundingSphere> sphereList;
+    std::vector<BoundingBox> boxList;
+    std::vector<XMFLOAT3> triangleList;
+    for (int i = 0; i < count; ++i)
+    {
+        sphereList.emplace_back(randomPoint(), size(rng));
+        spheres.Add(sphereList.back());
+
+        const XMFLOAT3 lo = randomPoint();
+        boxList.emplace_back(lo, XMFLOAT3(lo.x + size(rng), lo.y + size(rng), lo.z + size(rng)));
+        boxes.Add(boxList.back());
+
+        const XMFLOAT3 v0 = randomPoint();
+        const XMFLOAT3 v1(v0.x + size(rng) * 2.0f, v0.y + size(rng) - 2.5f, v0.z);
+        const XMFLOAT3 v2(v0.x, v0.y + size(rng) - 2.5f, v0.z + size(rng) * 2.0f);
+        triangleList.insert(triangleList.end(), { v0, v1, v2 });
+        triangles.Add(v0, v1, v2);
+    }
+
+    /// Wide and scalar lanes run the same expressions, so they must agree bit for bit
+    auto sameBits = [](const BatchHitResult& a, const BatchHitResult& b) {
+        return a.HitMask == b.HitMask &&
+               std::memcmp(a.Distances.data(), b.Distances.data(), a.Distances.size() * sizeof(float)) == 0;
+    };
+    auto closeEnough = [](float a, float b) { return std::fabs(a - b) <= 1e-4f * std::max(1.0f, std::fabs(b)); };
+
+    struct Tally
+    {
+        size_t tests = 0, hits = 0, laneMismatches = 0, referenceMismatches = 0;
+    };
+    Tally sphereSphere, sphereBox, raySphere, rayBox, rayTriangle;
+
+    auto compare = [&](Tally& tally, const BatchHitResult& simd, const BatchHitResult& scalar, auto&& reference) {
+        tally.tests += simd.Distances.size();
+        tally.hits += simd.CountHits();
+        if (!sameBits(simd, scalar)) ++tally.laneMismatches;
+        for (size_t i = 0; i < simd.Distances.size(); ++i)
+        {
+            float distance = 0.0f;
+            const bool hit = reference(i, distance);
+            if (hit != simd.IsHit(i) || (hit && !closeEnough(simd.Distances[i], distance))) ++tally.referenceMismatches;
+        }
+    };
+
+    BatchHitResult simd, scalar;
+    for (int q = 0; q < RayCount; ++q)
+    {
+        const BoundingSphere query(randomPoint(), size(rng) * 2.0f);
+        const SphereQueryContext sphereCtx{ query.Center.x, query.Center.y, query.Center.z, query.Radius, &spheres, &boxes };
+
+        SphereVsSphereBatch(query, spheres, simd);
+        RunBatchWith<ScalarLane, SphereSphereKernel>(sphereCtx, spheres.Size(), scalar);
+        compare(sphereSphere, simd, scalar, [&](size_t i, float& distance) {
+            distance = simd.Distances[i];
+            return SphereVsSphere(query, sphereList[i]);
+        });
+
+        SphereVsBoxBatch(query, boxes, simd);
+        RunBatchWith<ScalarLane, SphereBoxKernel>(sphereCtx, boxes.Size(), scalar);
+        compare(sphereBox, simd, scalar, [&](size_t i, float& distance) {
+            distance = simd.Distances[i];
+            return SphereVsBox(query, boxList[i]);
+        });
+
+        // Rays from outside the cloud towards a random point inside it
+        const XMFLOAT3 origin(position(rng) * 1.5f, position(rng) * 1.5f, -80.0f);
+        const XMFLOAT3 target = randomPoint();
+        const Ray ray(origin, XMFLOAT3(target.x - origin.x, target.y - origin.y, target.z - origin.z));
+        RayContext rayCtx = MakeRayContext(ray);
+        rayCtx.spheres = &spheres;
+        rayCtx.boxes = &boxes;
+        rayCtx.triangles = &triangles;
+
+        auto rayReference = [&](const CollisionResult& r, float& distance) {
+            distance = r.Distance;
+            return r.Hit;
+        };
+
+        RayVsSphereBatch(ray, spheres, simd);
+        RunBatchWith<ScalarLane, RaySphereKernel>(rayCtx, spheres.Size(), scalar);
+        compare(raySphere, simd, scalar, [&](size_t i, float& distance) {
+            return rayReference(RayVsSphere(ray, sphereList[i]), distance);
+        });
+
+        RayVsBoxBatch(ray, boxes, simd);
+        RunBatchWith<ScalarLane, RayBoxKernel>(rayCtx, boxes.Size(), scalar);
+        compare(rayBox, simd, scalar, [&](size_t i, float& distance) {
+            return rayReference(RayVsBox(ray, boxList[i]), distance);
+        });
+
+        RayVsTriangleBatch(ray, triangles, simd);
+        RunBatchWith<ScalarLane, RayTriangleKernel>(rayCtx, triangles.Size(), scalar);
+        compare(rayTriangle, simd, scalar, [&](size_t i, float& distance) {
+            return rayReference(RayVsTriangle(ray, triangleList[i * 3], triangleList[i * 3 + 1], triangleList[i * 3 + 2]), distance);
+        });
+    }
+
+    // Sweeps: the SIMD filter must never drop a pair the exact tests would hit
+    const size_t sweepCount = std::min<size_t>(count, 2048);
+    const size_t targetCount = std::min<size_t>(count, 64);
+    SphereSweepSoA sweeps;
+    for (size_t i = 0; i < sweepCount; ++i)
+    {
+        const XMFLOAT3 start = randomPoint();
+        sweeps.Add(start, XMFLOAT3(position(rng) * 0.5f, position(rng) * 0.5f, position(rng) * 0.5f), size(rng) * 0.2f);
+    }
+
+    SphereSoA sweepSpheres;
+    BoxSoA sweepBoxes;
+    TriangleSoA sweepTriangles;
+    for (size_t j = 0; j < targetCount; ++j)
+    {
+        sweepSpheres.Add(sphereList[j]);
+        sweepBoxes.Add(boxList[j]);
+        sweepTriangles.Add(triangleList[j * 3], triangleList[j * 3 + 1], triangleList[j * 3 + 2]);
+    }
+
+    SweepTargets targets;
+    targets.Spheres = &sweepSpheres;
+    targets.Boxes = &sweepBoxes;
+    targets.Triangles = &sweepTriangles;
+    std::vector<SweepHit> sweepHits;
+    SweepSpheresBatch(sweeps, targets, sweepHits);
+
+    size_t sweepImpacts = 0, sweepMismatches = 0;
+    for (size_t i = 0; i < sweepCount; ++i)
+    {
+        const BoundingSphere sphere(XMFLOAT3(sweeps.StartX[i], sweeps.StartY[i], sweeps.StartZ[i]), sweeps.Radius[i]);
+        const XMFLOAT3 delta(sweeps.DeltaX[i], sweeps.DeltaY[i], sweeps.DeltaZ[i]);
+
+        // Same target order and tie rule as SweepSpheresBatch()
+        float best = 1.0f;
+        SweepTargetType type = SweepTargetType::None;
+        uint32_t index = 0;
+        auto consider = [&](const CollisionResult& r, SweepTargetType t, size_t j) {
+            if (!r.Hit || r.Distance >= best) return;
+            best = r.Distance;
+            type = t;
+            index = static_cast<uint32_t>(j);
+        };
+        for (size_t j = 0; j < targetCount; ++j)
+            consider(SweepSphereVsSphere(sphere, delta, sphereList[j]), SweepTargetType::Sphere, j);
+        for (size_t j = 0; j < targetCount; ++j)
+            consider(SweepSphereVsBox(sphere, delta, boxList[j]), SweepTargetType::Box, j);
+        for (size_t j = 0; j < targetCount; ++j)
+            consider(SweepSphereVsTriangle(sphere, delta, triangleList[j * 3], triangleList[j * 3 + 1], triangleList[j * 3 + 2]),
+                     SweepTargetType::Triangle, j);
+
+        const SweepHit& hit = sweepHits[i];
+        if (type != SweepTargetType::None) ++sweepImpacts;
+        if (hit.Target != type || (type != SweepTargetType::None && (hit.Index != index || hit.Time != best)))
+            ++sweepMismatches;
+    }
+
+    std::stringstream ss;
+    ss << "=== Collision Batch Check ===\n";
+    ss << count << " primitives per set, " << RayCount << " queries, " << GetBatchWidth() << "-wide kernels ("
+       << (GetBatchWidth() == 8 ? "AVX" : GetBatchWidth() == 4 ? "SSE" : "scalar") << ")\n";
+
+    bool pass = sweepMismatches == 0;
+    auto line = [&](const char* name, const Tally& t) {
+        pass = pass && t.laneMismatches == 0 && t.referenceMismatches == 0;
+        ss << name << t.tests << " tests, " << t.hits << " hits, SIMD matches scalar lanes: "
+           << (t.laneMismatches == 0 ? "yes" : "NO") << ", differs from single-pair: " << t.referenceMismatches << "\n";
+    };
+    line("Sphere vs sphere:   ", sphereSphere);
+    line("Sphere vs box:      ", sphereBox);
+    line("Ray vs sphere:      ", raySphere);
+    line("Ray vs box:         ", rayBox);
+    line("Ray vs triangle:    ", rayTriangle);
+    ss << "Sphere sweeps:      " << sweepCount << " sweeps x " << targetCount * 3 << " targets, " << sweepImpacts
+       << " impacts, differs from single-pair: " << sweepMismatches << "\n";
+    ss << "Result: " << (pass ? "PASS" : "FAIL") << "\n";
+    return ss.str();
+}
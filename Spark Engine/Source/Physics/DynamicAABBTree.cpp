@@ -0,0 +1,509 @@
+/**
+ * @file DynamicAABBTree.cpp
+ * @brief Implementation of the incremental broadphase bounding volume tree
+ * @author Spark Engine Team
+ * @date 2025
+ */
+
+#include "DynamicAABBTree.h"
+#include "Utils/Assert.h"
+#include <algorithm>
+#include <cfloat>
+
+DynamicAABBTree::DynamicAABBTree(float margin, float displacementMultiplier)
+    : m_margin(margin)
+    , m_displacementMultiplier(displacementMultiplier)
+{
+    ASSERT_MSG(margin >= 0.0f, "AABB tree margin must be non-negative");
+}
+
+// ============================================================================
+// NODE POOL
+// ============================================================================
+
+int32_t DynamicAABBTree::AllocateNode()
+{
+    if (m_freeList == NullNode)
+    {
+        // Grow the pool and thread the new nodes onto the free list
+        const int32_t oldCapacity = static_cast<int32_t>(m_nodes.size());
+        const int32_t newCapacity = std::max<int32_t>(16, oldCapacity * 2);
+        m_nodes.resize(newCapacity);
+        for (int32_t i = oldCapacity; i < newCapacity - 1; ++i) {
+            m_nodes[i].parent = i + 1;
+            m_nodes[i].height = -1;
+        }
+        m_nodes[newCapacity - 1].parent = NullNode;
+        m_nodes[newCapacity - 1].height = -1;
+        m_freeList = oldCapacity;
+    }
+
+    const int32_t nodeId = m_freeList;
+    Node& node = m_nodes[nodeId];
+    m_freeList = node.parent;
+    node.parent = NullNode;
+    node.child1 = NullNode;
+    node.child2 = NullNode;
+    node.height = 0;
+    node.userData = nullptr;
+    ++m_nodeCount;
+    return nodeId;
+}
+
+void DynamicAABBTree::FreeNode(int32_t nodeId)
+{
+    ASSERT_MSG(nodeId >= 0 && nodeId < static_cast<int32_t>(m_nodes.size()), "Invalid AABB tree node");
+    ASSERT_MSG(m_nodeCount > 0, "AABB tree node count underflow");
+    m_nodes[nodeId].parent = m_freeList;
+    m_nodes[nodeId].height = -1;
+    m_nodes[nodeId].userData = nullptr;
+    m_freeList = nodeId;
+    --m_nodeCount;
+}
+
+// ============================================================================
+// PROXY MANAGEMENT
+// ============================================================================
+
+int32_t DynamicAABBTree::CreateProxy(const BoundingBox& aabb, void* userData)
+{
+    const int32_t proxyId = AllocateNode();
+    Node& node = m_nodes[proxyId];
+    node.aabb.Min = XMFLOAT3(aabb.Min.x - m_margin, aabb.Min.y - m_margin, aabb.Min.z - m_margin);
+    node.aabb.Max = XMFLOAT3(aabb.Max.x + m_margin, aabb.Max.y + m_margin, aabb.Max.z + m_margin);
+    node.userData = userData;
+    node.height = 0;
+
+    InsertLeaf(proxyId);
+    ++m_proxyCount;
+    return proxyId;
+}
+
+void DynamicAABBTree::DestroyProxy(int32_t proxyId)
+{
+    ASSERT_MSG(proxyId >= 0 && proxyId < static_cast<int32_t>(m_nodes.size()), "Invalid proxy ID");
+    ASSERT_MSG(m_nodes[proxyId].IsLeaf(), "Proxy ID does not refer to a leaf");
+
+    RemoveLeaf(proxyId);
+    FreeNode(proxyId);
+    --m_proxyCount;
+}
+
+bool DynamicAABBTree::MoveProxy(int32_t proxyId, const BoundingBox& aabb, const XMFLOAT3& displacement)
+{
+    ASSERT_MSG(proxyId >= 0 && proxyId < static_cast<int32_t>(m_nodes.size()), "Invalid proxy ID");
+    ASSERT_MSG(m_nodes[proxyId].IsLeaf(), "Proxy ID does not refer to a leaf");
+
+    // Predict where the object is heading so fast movers are not reinserted every frame
+    BoundingBox fat;
+    fat.Min = XMFLOAT3(aabb.Min.x - m_margin, aabb.Min.y - m_margin, aabb.Min.z - m_margin);
+    fat.Max = XMFLOAT3(aabb.Max.x + m_margin, aabb.Max.y + m_margin, aabb.Max.z + m_margin);
+
+    const XMFLOAT3 d(displacement.x * m_displacementMultiplier,
+                     displacement.y * m_displacementMultiplier,
+                     displacement.z * m_displacementMultiplier);
+    if (d.x < 0.0f) fat.Min.x += d.x; else fat.Max.x += d.x;
+    if (d.y < 0.0f) fat.Min.y += d.y; else fat.Max.y += d.y;
+    if (d.z < 0.0f) fat.Min.z += d.z; else fat.Max.z += d.z;
+
+    const BoundingBox& treeAABB = m_nodes[proxyId].aabb;
+    if (Contains(treeAABB, aabb))
+    {
+        // Still enclosed. Only refit if the stored box has become much larger
+        // than needed, otherwise queries would keep reporting stale overlaps.
+        BoundingBox huge;
+        const float m = 4.0f * m_margin;
+        huge.Min = XMFLOAT3(fat.Min.x - m, fat.Min.y - m, fat.Min.z - m);
+        huge.Max = XMFLOAT3(fat.Max.x + m, fat.Max.y + m, fat.Max.z + m);
+        if (Contains(huge, treeAABB)) {
+            return false;
+        }
+    }
+
+    RemoveLeaf(proxyId);
+    m_nodes[proxyId].aabb = fat;
+    InsertLeaf(proxyId);
+    return true;
+}
+
+void DynamicAABBTree::Clear()
+{
+    m_nodes.clear();
+    m_root = NullNode;
+    m_freeList = NullNode;
+    m_nodeCount = 0;
+    m_proxyCount = 0;
+}
+
+void* DynamicAABBTree::GetUserData(int32_t proxyId) const
+{
+    ASSERT_MSG(proxyId >= 0 && proxyId < static_cast<int32_t>(m_nodes.size()), "Invalid proxy ID");
+    return m_nodes[proxyId].userData;
+}
+
+const BoundingBox& DynamicAABBTree::GetFatAABB(int32_t proxyId) const
+{
+    ASSERT_MSG(proxyId >= 0 && proxyId < static_cast<int32_t>(m_nodes.size()), "Invalid proxy ID");
+    return m_nodes[proxyId].aabb;
+}
+
+// ============================================================================
+// INSERTION / REMOVAL
+// ============================================================================
+
+void DynamicAABBTree::InsertLeaf(int32_t leaf)
+{
+    if (m_root == NullNode) {
+        m_root = leaf;
+        m_nodes[leaf].parent = NullNode;
+        return;
+    }
+
+    // Descend towards the sibling that minimizes the increase in total surface area
+    const BoundingBox leafAABB = m_nodes[leaf].aabb;
+    int32_t index = m_root;
+    while (!m_nodes[index].IsLeaf())
+    {
+        const Node& node = m_nodes[index];
+        const int32_t child1 = node.child1;
+        const int32_t child2 = node.child2;
+
+        const float area = SurfaceArea(node.aabb);
+        const float combinedArea = SurfaceArea(Combine(node.aabb, leafAABB));
+
+        // Cost of creating a new parent for this node and the new leaf
+        const float cost = 2.0f * combinedArea;
+        // Minimum cost of pushing the leaf further down the tree
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int32_t child) {
+            const BoundingBox box = Combine(leafAABB, m_nodes[child].aabb);
+            if (m_nodes[child].IsLeaf()) {
+                return SurfaceArea(box) + inheritanceCost;
+            }
+            return (SurfaceArea(box) - SurfaceArea(m_nodes[child].aabb)) + inheritanceCost;
+        };
+
+        const float cost1 = descendCost(child1);
+        const float cost2 = descendCost(child2);
+
+        if (cost < cost1 && cost < cost2) break;
+        index = (cost1 < cost2) ? child1 : child2;
+    }
+
+    const int32_t sibling = index;
+
+    // Splice a new parent between the sibling and its old parent
+    const int32_t oldParent = m_nodes[sibling].parent;
+    const int32_t newParent = AllocateNode();
+    m_nodes[newParent].parent = oldParent;
+    m_nodes[newParent].userData = nullptr;
+    m_nodes[newParent].aabb = Combine(leafAABB, m_nodes[sibling].aabb);
+    m_nodes[newParent].height = m_nodes[sibling].height + 1;
+    m_nodes[newParent].child1 = sibling;
+    m_nodes[newParent].child2 = leaf;
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    if (oldParent != NullNode) {
+        if (m_nodes[oldParent].child1 == sibling) {
+            m_nodes[oldParent].child1 = newParent;
+        } else {
+            m_nodes[oldParent].child2 = newParent;
+        }
+    } else {
+        m_root = newParent;
+    }
+
+    // Walk back up refitting bounds and heights, rebalancing as we go
+    index = m_nodes[leaf].parent;
+    while (index != NullNode)
+    {
+        index = Balance(index);
+
+        const int32_t child1 = m_nodes[index].child1;
+        const int32_t child2 = m_nodes[index].child2;
+        ASSERT_MSG(child1 != NullNode && child2 != NullNode, "Internal node missing children");
+
+        m_nodes[index].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+        m_nodes[index].aabb = Combine(m_nodes[child1].aabb, m_nodes[child2].aabb);
+
+        index = m_nodes[index].parent;
+    }
+}
+
+void DynamicAABBTree::RemoveLeaf(int32_t leaf)
+{
+    if (leaf == m_root) {
+        m_root = NullNode;
+        return;
+    }
+
+    const int32_t parent = m_nodes[leaf].parent;
+    const int32_t grandParent = m_nodes[parent].parent;
+    const int32_t sibling = (m_nodes[parent].child1 == leaf) ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    if (grandParent != NullNode)
+    {
+        // Replace the parent with the sibling and refit the ancestors
+        if (m_nodes[grandParent].child1 == parent) {
+            m_nodes[grandParent].child1 = sibling;
+        } else {
+            m_nodes[grandParent].child2 = sibling;
+        }
+        m_nodes[sibling].parent = grandParent;
+        FreeNode(parent);
+
+        int32_t index = grandParent;
+        while (index != NullNode)
+        {
+            index = Balance(index);
+
+            const int32_t child1 = m_nodes[index].child1;
+            const int32_t child2 = m_nodes[index].child2;
+            m_nodes[index].aabb = Combine(m_nodes[child1].aabb, m_nodes[child2].aabb);
+            m_nodes[index].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+
+            index = m_nodes[index].parent;
+        }
+    }
+    else
+    {
+        m_root = sibling;
+        m_nodes[sibling].parent = NullNode;
+        FreeNode(parent);
+    }
+}
+
+// Perform a left or right rotation if node A is imbalanced.
+// Returns the new root index of the rotated subtree.
+int32_t DynamicAABBTree::Balance(int32_t iA)
+{
+    ASSERT_MSG(iA != NullNode, "Cannot balance a null node");
+
+    Node* A = &m_nodes[iA];
+    if (A->IsLeaf() || A->height < 2) {
+        return iA;
+    }
+
+    const int32_t iB = A->child1;
+    const int32_t iC = A->child2;
+    Node* B = &m_nodes[iB];
+    Node* C = &m_nodes[iC];
+
+    const int32_t balance = C->height - B->height;
+
+    // Rotate C up
+    if (balance > 1)
+    {
+        const int32_t iF = C->child1;
+        const int32_t iG = C->child2;
+        Node* F = &m_nodes[iF];
+        Node* G = &m_nodes[iG];
+
+        C->child1 = iA;
+        C->parent = A->parent;
+        A->parent = iC;
+
+        if (C->parent != NullNode) {
+            if (m_nodes[C->parent].child1 == iA) {
+                m_nodes[C->parent].child1 = iC;
+            } else {
+                m_nodes[C->parent].child2 = iC;
+            }
+        } else {
+            m_root = iC;
+        }
+
+        if (F->height > G->height) {
+            C->child2 = iF;
+            A->child2 = iG;
+            G->parent = iA;
+            A->aabb = Combine(B->aabb, G->aabb);
+            C->aabb = Combine(A->aabb, F->aabb);
+            A->height = 1 + std::max(B->height, G->height);
+            C->height = 1 + std::max(A->height, F->height);
+        } else {
+            C->child2 = iG;
+            A->child2 = iF;
+            F->parent = iA;
+            A->aabb = Combine(B->aabb, F->aabb);
+            C->aabb = Combine(A->aabb, G->aabb);
+            A->height = 1 + std::max(B->height, F->height);
+            C->height = 1 + std::max(A->height, G->height);
+        }
+
+        return iC;
+    }
+
+    // Rotate B up
+    if (balance < -1)
+    {
+        const int32_t iD = B->child1;
+        const int32_t iE = B->child2;
+        Node* D = &m_nodes[iD];
+        Node* E = &m_nodes[iE];
+
+        B->child1 = iA;
+        B->parent = A->parent;
+        A->parent = iB;
+
+        if (B->parent != NullNode) {
+            if (m_nodes[B->parent].child1 == iA) {
+                m_nodes[B->parent].child1 = iB;
+            } else {
+                m_nodes[B->parent].child2 = iB;
+            }
+        } else {
+            m_root = iB;
+        }
+
+        if (D->height > E->height) {
+            B->child2 = iD;
+            A->child1 = iE;
+            E->parent = iA;
+            A->aabb = Combine(C->aabb, E->aabb);
+            B->aabb = Combine(A->aabb, D->aabb);
+            A->height = 1 + std::max(C->height, E->height);
+            B->height = 1 + std::max(A->height, D->height);
+        } else {
+            B->child2 = iE;
+            A->child1 = iD;
+            D->parent = iA;
+            A->aabb = Combine(C->aabb, D->aabb);
+            B->aabb = Combine(A->aabb, E->aabb);
+            A->height = 1 + std::max(C->height, D->height);
+            B->height = 1 + std::max(A->height, E->height);
+        }
+
+        return iB;
+    }
+
+    return iA;
+}
+
+// ============================================================================
+// STATISTICS / VALIDATION
+// ============================================================================
+
+int32_t DynamicAABBTree::GetHeight() const
+{
+    return (m_root == NullNode) ? 0 : m_nodes[m_root].height;
+}
+
+int32_t DynamicAABBTree::GetMaxBalance() const
+{
+    int32_t maxBalance = 0;
+    for (const Node& node : m_nodes)
+    {
+        if (node.height <= 1) continue;
+        const int32_t balance = std::abs(m_nodes[node.child2].height - m_nodes[node.child1].height);
+        maxBalance = std::max(maxBalance, balance);
+    }
+    return maxBalance;
+}
+
+float DynamicAABBTree::GetAreaRatio() const
+{
+    if (m_root == NullNode) return 0.0f;
+
+    const float rootArea = SurfaceArea(m_nodes[m_root].aabb);
+    if (rootArea <= 0.0f) return 0.0f;
+
+    float totalArea = 0.0f;
+    for (const Node& node : m_nodes)
+    {
+        if (node.height < 0) continue;
+        totalArea += SurfaceArea(node.aabb);
+    }
+    return totalArea / rootArea;
+}
+
+int32_t DynamicAABBTree::ComputeHeight(int32_t nodeId) const
+{
+    const Node& node = m_nodes[nodeId];
+    if (node.IsLeaf()) return 0;
+    return 1 + std::max(ComputeHeight(node.child1), ComputeHeight(node.child2));
+}
+
+void DynamicAABBTree::Validate() const
+{
+#if defined(_DEBUG) || defined(DEBUG)
+    ValidateStructure(m_root);
+    ValidateMetrics(m_root);
+
+    int32_t freeCount = 0;
+    for (int32_t freeIndex = m_freeList; freeIndex != NullNode; freeIndex = m_nodes[freeIndex].parent) {
+        ++freeCount;
+    }
+    ASSERT_MSG(GetHeight() == (m_root == NullNode ? 0 : ComputeHeight(m_root)), "AABB tree height mismatch");
+    ASSERT_MSG(m_nodeCount + freeCount == static_cast<int32_t>(m_nodes.size()), "AABB tree node leak");
+#endif
+}
+
+void DynamicAABBTree::ValidateStructure(int32_t index) const
+{
+    if (index == NullNode) return;
+
+    if (index == m_root) {
+        ASSERT_MSG(m_nodes[index].parent == NullNode, "Root must not have a parent");
+    }
+
+    const Node& node = m_nodes[index];
+    if (node.IsLeaf()) {
+        ASSERT_MSG(node.child2 == NullNode, "Leaf has a second child");
+        ASSERT_MSG(node.height == 0, "Leaf height must be zero");
+        return;
+    }
+
+    ASSERT_MSG(m_nodes[node.child1].parent == index, "Broken parent link");
+    ASSERT_MSG(m_nodes[node.child2].parent == index, "Broken parent link");
+    ValidateStructure(node.child1);
+    ValidateStructure(node.child2);
+}
+
+void DynamicAABBTree::ValidateMetrics(int32_t index) const
+{
+    if (index == NullNode) return;
+
+    const Node& node = m_nodes[index];
+    if (node.IsLeaf()) return;
+
+    const int32_t height = 1 + std::max(m_nodes[node.child1].height, m_nodes[node.child2].height);
+    ASSERT_MSG(node.height == height, "Stale node height");
+
+    const BoundingBox box = Combine(m_nodes[node.child1].aabb, m_nodes[node.child2].aabb);
+    ASSERT_MSG(box.Min.x == node.aabb.Min.x && box.Max.x == node.aabb.Max.x &&
+               box.Min.y == node.aabb.Min.y && box.Max.y == node.aabb.Max.y &&
+               box.Min.z == node.aabb.Min.z && box.Max.z == node.aabb.Max.z, "Stale node bounds");
+    (void)height;
+    (void)box;
+
+    ValidateMetrics(node.child1);
+    ValidateMetrics(node.child2);
+}
+
+// ============================================================================
+// BOX HELPERS
+// ============================================================================
+
+BoundingBox DynamicAABBTree::Combine(const BoundingBox& a, const BoundingBox& b)
+{
+    return BoundingBox(
+        XMFLOAT3(std::min(a.Min.x, b.Min.x), std::min(a.Min.y, b.Min.y), std::min(a.Min.z, b.Min.z)),
+        XMFLOAT3(std::max(a.Max.x, b.Max.x), std::max(a.Max.y, b.Max.y), std::max(a.Max.z, b.Max.z)));
+}
+
+bool DynamicAABBTree::Contains(const BoundingBox& outer, const BoundingBox& inner)
+{
+    return outer.Min.x <= inner.Min.x && outer.Min.y <= inner.Min.y && outer.Min.z <= inner.Min.z &&
+           inner.Max.x <= outer.Max.x && inner.Max.y <= outer.Max.y && inner.Max.z <= outer.Max.z;
+}
+
+float DynamicAABBTree::SurfaceArea(const BoundingBox& box)
+{
+    const float dx = box.Max.x - box.Min.x;
+    const float dy = box.Max.y - box.Min.y;
+    const float dz = box.Max.z - box.Min.z;
+    return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
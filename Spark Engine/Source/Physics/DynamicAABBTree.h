@@ -0,0 +1,257 @@
+/**
+ * @file DynamicAABBTree.h
+ * @brief Incrementally updated bounding volume hierarchy for broadphase queries
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * The dynamic AABB tree stores one fat (margin-expanded) bounding box per proxy
+ * in a binary tree that is kept balanced with AVL-style rotations. Proxies can
+ * be inserted, removed and refit individually, so static level geometry pays
+ * nothing per frame and moving bodies only touch the tree when they leave
+ * their fat box. Ray and box queries walk the tree with an explicit stack.
+ */
+
+#pragma once
+
+#include "CollisionSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Dynamic bounding volume tree keyed by integer proxy IDs
+ *
+ * Leaves hold user data (the PhysicsSystem stores PhysicsBody pointers) and a
+ * fat AABB. Internal nodes hold the union of their children. Nodes live in a
+ * contiguous array with an intrusive free list, so proxy IDs stay stable for
+ * the life of the proxy and no per-node heap allocation takes place.
+ *
+ * @note Not thread-safe for mutation; concurrent const queries are fine.
+ */
+class DynamicAABBTree
+{
+public:
+    static constexpr int32_t NullNode = -1;
+
+    /**
+     * @brief Construct an empty tree
+     * @param margin Distance each leaf AABB is expanded by on insertion
+     * @param displacementMultiplier Scale applied to predicted displacement when fattening moving proxies
+     */
+    explicit DynamicAABBTree(float margin = 0.1f, float displacementMultiplier = 4.0f);
+
+    /**
+     * @brief Insert a proxy into the tree
+     * @param aabb Tight bounds of the object
+     * @param userData Opaque pointer returned by GetUserData()
+     * @return Stable proxy ID
+     */
+    int32_t CreateProxy(const BoundingBox& aabb, void* userData);
+
+    /**
+     * @brief Remove a proxy from the tree and recycle its node
+     */
+    void DestroyProxy(int32_t proxyId);
+
+    /**
+     * @brief Update a proxy after its object moved
+     * @param proxyId Proxy returned from CreateProxy()
+     * @param aabb New tight bounds
+     * @param displacement Movement since the last update, used to predict future bounds
+     * @return true if the proxy was reinserted, false if the fat AABB still contained it
+     */
+    bool MoveProxy(int32_t proxyId, const BoundingBox& aabb, const XMFLOAT3& displacement);
+
+    /**
+     * @brief Remove every proxy and release node storage
+     */
+    void Clear();
+
+    void* GetUserData(int32_t proxyId) const;
+    const BoundingBox& GetFatAABB(int32_t proxyId) const;
+
+    /**
+     * @brief Visit every proxy whose fat AABB overlaps the query box
+     * @param aabb Query bounds
+     * @param callback Invoked as bool(int32_t proxyId); return false to stop the query
+     */
+    template<typename Callback>
+    void Query(const BoundingBox& aabb, Callback&& callback) const;
+
+    /**
+     * @brief Visit every proxy whose fat AABB is crossed by the ray segment
+     *
+     * The callback is invoked as float(int32_t proxyId, float maxDistance) and
+     * returns the new clip distance: return maxDistance to keep going, a
+     * smaller value to shorten the ray (closest-hit queries), or 0 to stop.
+     *
+     * @param ray Ray with normalized direction
+     * @param maxDistance Length of the segment to test
+     * @param callback Narrowphase callback
+     */
+    template<typename Callback>
+    void RayCast(const Ray& ray, float maxDistance, Callback&& callback) const;
+
+    // Statistics
+    int32_t GetProxyCount() const { return m_proxyCount; }
+    int32_t GetNodeCount() const { return m_nodeCount; }
+    int32_t GetHeight() const;
+    int32_t GetMaxBalance() const;
+    float   GetAreaRatio() const;
+
+    void  SetMargin(float margin) { m_margin = margin; }
+    float GetMargin() const { return m_margin; }
+
+    /**
+     * @brief Verify parent links, heights and bounds (debug builds only)
+     */
+    void Validate() const;
+
+private:
+    struct Node
+    {
+        BoundingBox aabb;
+        void* userData = nullptr;
+        int32_t parent = NullNode;   ///< Parent index, or next free node while on the free list
+        int32_t child1 = NullNode;
+        int32_t child2 = NullNode;
+        int32_t height = -1;         ///< 0 for leaves, -1 for free nodes
+
+        bool IsLeaf() const { return child1 == NullNode; }
+    };
+
+    /**
+     * @brief Fixed-capacity traversal stack that spills to the heap for very deep trees
+     */
+    class TraversalStack
+    {
+    public:
+        void Push(int32_t value)
+        {
+            if (m_count < InlineCapacity) {
+                m_inline[m_count++] = value;
+            } else {
+                m_overflow.push_back(value);
+                ++m_count;
+            }
+        }
+
+        int32_t Pop()
+        {
+            --m_count;
+            if (m_count < InlineCapacity) return m_inline[m_count];
+            int32_t value = m_overflow.back();
+            m_overflow.pop_back();
+            return value;
+        }
+
+        bool Empty() const { return m_count == 0; }
+
+    private:
+        static constexpr int InlineCapacity = 256;
+        int32_t m_inline[InlineCapacity];
+        std::vector<int32_t> m_overflow;
+        int m_count = 0;
+    };
+
+    int32_t AllocateNode();
+    void    FreeNode(int32_t nodeId);
+    void    InsertLeaf(int32_t leaf);
+    void    RemoveLeaf(int32_t leaf);
+    int32_t Balance(int32_t index);
+    int32_t ComputeHeight(int32_t nodeId) const;
+    void    ValidateStructure(int32_t index) const;
+    void    ValidateMetrics(int32_t index) const;
+
+    static BoundingBox Combine(const BoundingBox& a, const BoundingBox& b);
+    static bool        Contains(const BoundingBox& outer, const BoundingBox& inner);
+    static float       SurfaceArea(const BoundingBox& box);
+
+    std::vector<Node> m_nodes;
+    int32_t m_root = NullNode;
+    int32_t m_freeList = NullNode;
+    int32_t m_nodeCount = 0;
+    int32_t m_proxyCount = 0;
+    float   m_margin;
+    float   m_displacementMultiplier;
+};
+
+// ============================================================================
+// TEMPLATE IMPLEMENTATION
+// ============================================================================
+
+template<typename Callback>
+void DynamicAABBTree::Query(const BoundingBox& aabb, Callback&& callback) const
+{
+    if (m_root == NullNode) return;
+
+    TraversalStack stack;
+    stack.Push(m_root);
+
+    while (!stack.Empty())
+    {
+        const int32_t nodeId = stack.Pop();
+        const Node& node = m_nodes[nodeId];
+
+        if (!CollisionSystem::BoxVsBox(node.aabb, aabb)) continue;
+
+        if (node.IsLeaf()) {
+            if (!callback(nodeId)) return;
+        } else {
+            stack.Push(node.child1);
+            stack.Push(node.child2);
+        }
+    }
+}
+
+template<typename Callback>
+void DynamicAABBTree::RayCast(const Ray& ray, float maxDistance, Callback&& callback) const
+{
+    if (m_root == NullNode || maxDistance <= 0.0f) return;
+
+    // Guard against division by zero; a huge reciprocal keeps the slab test well defined
+    auto safeInverse = [](float d) {
+        return (std::fabs(d) > 1e-12f) ? 1.0f / d : std::copysign(1e30f, d);
+    };
+    const XMFLOAT3 invDir(safeInverse(ray.Direction.x), safeInverse(ray.Direction.y), safeInverse(ray.Direction.z));
+    float clip = maxDistance;
+
+    auto slabTest = [&](const BoundingBox& box) {
+        float t1 = (box.Min.x - ray.Origin.x) * invDir.x;
+        float t2 = (box.Max.x - ray.Origin.x) * invDir.x;
+        float tmin = std::min(t1, t2), tmax = std::max(t1, t2);
+
+        t1 = (box.Min.y - ray.Origin.y) * invDir.y;
+        t2 = (box.Max.y - ray.Origin.y) * invDir.y;
+        tmin = std::max(tmin, std::min(t1, t2));
+        tmax = std::min(tmax, std::max(t1, t2));
+
+        t1 = (box.Min.z - ray.Origin.z) * invDir.z;
+        t2 = (box.Max.z - ray.Origin.z) * invDir.z;
+        tmin = std::max(tmin, std::min(t1, t2));
+        tmax = std::min(tmax, std::max(t1, t2));
+
+        return tmax >= std::max(tmin, 0.0f) && tmin <= clip;
+    };
+
+    TraversalStack stack;
+    stack.Push(m_root);
+
+    while (!stack.Empty())
+    {
+        const int32_t nodeId = stack.Pop();
+        const Node& node = m_nodes[nodeId];
+
+        if (!slabTest(node.aabb)) continue;
+
+        if (node.IsLeaf()) {
+            float value = callback(nodeId, clip);
+            if (value <= 0.0f) return;
+            clip = std::min(clip, value);
+        } else {
+            stack.Push(node.child1);
+            stack.Push(node.child2);
+        }
+    }
+}
@@ -0,0 +1,117 @@
+/**
+ * @file PairHashMap.h
+ * @brief Open-addressing hash map from body-pair keys to manifold slots
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * The contact cache is rebuilt once per substep and then probed once per
+ * candidate pair from every worker thread. A flat linear-probing table keeps
+ * both operations to a few cache lines, with no per-entry allocation and no
+ * pointer chasing.
+ */
+
+#pragma once
+
+#include "Utils/Assert.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Insert-only map from 64-bit pair keys to 32-bit values
+ *
+ * Entries are never erased individually; the table is cleared and refilled
+ * instead. Find() is const and safe to call from many threads while no
+ * thread is inserting.
+ */
+class PairHashMap
+{
+public:
+    static constexpr uint32_t NotFound = 0xFFFFFFFFu;
+
+    /**
+     * @brief Remove every entry and size the table for count entries
+     *
+     * The table stays at most half full, so probe sequences stay short.
+     */
+    void Reset(uint32_t count)
+    {
+        uint32_t capacity = 16;
+        while (capacity < count * 2) capacity <<= 1;
+
+        if (m_slots.size() != capacity) m_slots.resize(capacity);
+        for (Slot& slot : m_slots) slot.key = EmptyKey;
+        m_mask = capacity - 1;
+        m_shift = 64 - Log2(capacity);
+        m_size = 0;
+    }
+
+    /**
+     * @brief Insert a key, or overwrite its value if already present
+     */
+    void Insert(uint64_t key, uint32_t value)
+    {
+        ASSERT_MSG(key != EmptyKey, "Pair key %llu is reserved", static_cast<unsigned long long>(key));
+        ASSERT_MSG((m_size + 1) * 2 <= m_slots.size(), "PairHashMap over capacity (%u entries)", m_size);
+
+        for (uint32_t i = Home(key);; i = (i + 1) & m_mask)
+        {
+            Slot& slot = m_slots[i];
+            if (slot.key == EmptyKey) {
+                slot.key = key;
+                slot.value = value;
+                ++m_size;
+                return;
+            }
+            if (slot.key == key) {
+                slot.value = value;
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Look up a key
+     * @return The stored value, or NotFound
+     */
+    uint32_t Find(uint64_t key) const
+    {
+        if (m_size == 0) return NotFound;
+        for (uint32_t i = Home(key);; i = (i + 1) & m_mask)
+        {
+            const Slot& slot = m_slots[i];
+            if (slot.key == key) return slot.value;
+            if (slot.key == EmptyKey) return NotFound;
+        }
+    }
+
+    uint32_t Size() const { return m_size; }
+    uint32_t Capacity() const { return static_cast<uint32_t>(m_slots.size()); }
+
+private:
+    // Pair keys pack (lower ID << 32 | higher ID), so the all-ones key never occurs
+    static constexpr uint64_t EmptyKey = ~0ull;
+
+    struct Slot
+    {
+        uint64_t key;
+        uint32_t value;
+    };
+
+    /// Fibonacci hashing: spreads sequential body IDs across the table
+    uint32_t Home(uint64_t key) const
+    {
+        return static_cast<uint32_t>((key * 0x9E3779B97F4A7C15ull) >> m_shift) & m_mask;
+    }
+
+    static uint32_t Log2(uint32_t powerOfTwo)
+    {
+        uint32_t bits = 0;
+        while ((1u << bits) < powerOfTwo) ++bits;
+        return bits;
+    }
+
+    std::vector<Slot> m_slots;
+    uint32_t m_mask = 0;
+    uint32_t m_shift = 63;
+    uint32_t m_size = 0;
+};
@@ -7,14 +7,424 @@
 
 #include "PhysicsSystem.h"
 #include "Utils/Assert.h"
+#include "Core/JobSystem.h"
 #include "../Utils/SparkConsole.h"
 #include <iostream>
 #include <sstream>
 #include <algorithm>
 #include <chrono>
+#include <cctype>
+#include <cfloat>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <thread>
+#include <tiny_obj_loader.h>
 
 using namespace DirectX;
 
+namespace
+{
+    /**
+     * @brief World matrix of a body's collision shape (local shape offset, then body transform)
+     */
+    XMMATRIX ShapeWorldMatrix(const PhysicsBodyDesc& desc)
+    {
+        const CollisionShapeDesc& shape = desc.shape;
+        XMMATRIX local = XMMatrixRotationRollPitchYaw(shape.localRotation.x, shape.localRotation.y, shape.localRotation.z) *
+                         XMMatrixTranslation(shape.localOffset.x, shape.localOffset.y, shape.localOffset.z);
+        XMMATRIX body = XMMatrixRotationRollPitchYaw(desc.rotation.x, desc.rotation.y, desc.rotation.z) *
+                        XMMatrixTranslation(desc.position.x, desc.position.y, desc.position.z);
+        return local * body;
+    }
+
+    /**
+     * @brief Conservative bounds of a collision shape in its own local frame
+     */
+    BoundingBox LocalShapeBounds(const CollisionShapeDesc& shape)
+    {
+        const XMFLOAT3 half(shape.dimensions.x * 0.5f, shape.dimensions.y * 0.5f, shape.dimensions.z * 0.5f);
+
+        switch (shape.type)
+        {
+        case CollisionShapeType::Sphere:
+            return BoundingBox(XMFLOAT3(-shape.radius, -shape.radius, -shape.radius),
+                               XMFLOAT3(shape.radius, shape.radius, shape.radius));
+
+        case CollisionShapeType::Capsule:
+        {
+            const float halfHeight = shape.height * 0.5f + shape.radius;
+            return BoundingBox(XMFLOAT3(-shape.radius, -halfHeight, -shape.radius),
+                               XMFLOAT3(shape.radius, halfHeight, shape.radius));
+        }
+
+        case CollisionShapeType::Cylinder:
+        case CollisionShapeType::Cone:
+        {
+            const float halfHeight = shape.height * 0.5f;
+            return BoundingBox(XMFLOAT3(-shape.radius, -halfHeight, -shape.radius),
+                               XMFLOAT3(shape.radius, halfHeight, shape.radius));
+        }
+
+        case CollisionShapeType::Mesh:
+        case CollisionShapeType::ConvexHull:
+            if (!shape.vertices.empty())
+            {
+                BoundingBox bounds(XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX), XMFLOAT3(-FLT_MAX, -FLT_MAX, -FLT_MAX));
+                for (const XMFLOAT3& v : shape.vertices)
+                {
+                    bounds.Min = XMFLOAT3(std::min(bounds.Min.x, v.x), std::min(bounds.Min.y, v.y), std::min(bounds.Min.z, v.z));
+                    bounds.Max = XMFLOAT3(std::max(bounds.Max.x, v.x), std::max(bounds.Max.y, v.y), std::max(bounds.Max.z, v.z));
+                }
+                return bounds;
+            }
+            break;
+
+        default:
+            break;
+        }
+
+        return BoundingBox(XMFLOAT3(-half.x, -half.y, -half.z), half);
+    }
+
+    /**
+     * @brief Quaternion for the engine's (pitch, yaw, roll) Euler convention
+     */
+    XMFLOAT4 EulerToQuaternion(const XMFLOAT3& euler)
+    {
+        XMFLOAT4 q;
+        XMStoreFloat4(&q, XMQuaternionRotationRollPitchYaw(euler.x, euler.y, euler.z));
+        return q;
+    }
+
+    /**
+     * @brief Inverse of EulerToQuaternion, with pitch in [-pi/2, pi/2]
+     */
+    XMFLOAT3 QuaternionToEuler(const XMFLOAT4& q)
+    {
+        // Rows of the rotation matrix are the rotated basis vectors; for R = Rz(roll) * Rx(pitch) * Ry(yaw)
+        // the third row is (sin(yaw)cos(pitch), -sin(pitch), cos(yaw)cos(pitch))
+        XMFLOAT4X4 m;
+        XMStoreFloat4x4(&m, XMMatrixRotationQuaternion(XMLoadFloat4(&q)));
+
+        const float pitch = std::asin(std::clamp(-m._32, -1.0f, 1.0f));
+        if (std::fabs(m._32) > 0.9999f) {
+            // Gimbal lock: yaw and roll share an axis, so fold everything into yaw
+            return XMFLOAT3(pitch, std::atan2(-m._13, m._11), 0.0f);
+        }
+        return XMFLOAT3(pitch, std::atan2(m._31, m._33), std::atan2(m._12, m._22));
+    }
+
+    /**
+     * @brief How the simulation should move a body described by desc
+     */
+    RigidBodyMotion MotionFor(const PhysicsBodyDesc& desc)
+    {
+        if (desc.isKinematic || desc.type == PhysicsBodyType::Kinematic) return RigidBodyMotion::Kinematic;
+        if (desc.type == PhysicsBodyType::Static || desc.mass <= 0.0f) return RigidBodyMotion::Static;
+        return RigidBodyMotion::Dynamic;
+    }
+
+    /**
+     * @brief Translate a PhysicsBody description into a simulation body
+     *
+     * Spheres and boxes are simulated exactly. Capsules, cylinders, cones,
+     * hulls and compounds collide as their local bounding box. Static and
+     * kinematic meshes and heightfields are registered for world queries
+     * only, since the contact generator has no triangle support.
+     */
+    RigidBodyDef MakeRigidBodyDef(const PhysicsBodyDesc& desc)
+    {
+        RigidBodyDef def;
+        def.motion = MotionFor(desc);
+        def.position = desc.position;
+        def.orientation = EulerToQuaternion(desc.rotation);
+        def.linearVelocity = desc.linearVelocity;
+        def.angularVelocity = desc.angularVelocity;
+        def.mass = desc.mass;
+        def.density = desc.material.density;
+        def.friction = desc.material.friction;
+        def.restitution = desc.material.restitution;
+        def.linearDamping = desc.material.linearDamping;
+        def.angularDamping = desc.material.angularDamping;
+        def.isTrigger = desc.isTrigger;
+
+        const CollisionShapeDesc& shape = desc.shape;
+        def.shape.localRotation = EulerToQuaternion(shape.localRotation);
+        def.shape.localOffset = shape.localOffset;
+
+        if (shape.type == CollisionShapeType::Sphere)
+        {
+            def.shape.type = RigidShapeType::Sphere;
+            def.shape.radius = shape.radius;
+            return def;
+        }
+
+        const BoundingBox bounds = LocalShapeBounds(shape);
+        const XMFLOAT3 center = bounds.GetCenter();
+        XMFLOAT3 rotatedCenter;
+        XMStoreFloat3(&rotatedCenter, XMVector3Rotate(XMLoadFloat3(&center), XMLoadFloat4(&def.shape.localRotation)));
+        def.shape.localOffset = XMFLOAT3(shape.localOffset.x + rotatedCenter.x,
+                                         shape.localOffset.y + rotatedCenter.y,
+                                         shape.localOffset.z + rotatedCenter.z);
+        def.shape.halfExtents = bounds.GetExtents();
+
+        const bool triangleShape = shape.type == CollisionShapeType::Mesh || shape.type == CollisionShapeType::Heightfield;
+        def.shape.type = (triangleShape && def.motion != RigidBodyMotion::Dynamic) ? RigidShapeType::QueryOnly
+                                                                                   : RigidShapeType::Box;
+        return def;
+    }
+
+    /**
+     * @brief Slab test against a local-space box that also reports the face normal
+     */
+    bool RayVsLocalBox(const Ray& ray, const BoundingBox& box, float maxDistance, float& outT, XMFLOAT3& outNormal)
+    {
+        const float origin[3] = { ray.Origin.x, ray.Origin.y, ray.Origin.z };
+        const float dir[3] = { ray.Direction.x, ray.Direction.y, ray.Direction.z };
+        const float bmin[3] = { box.Min.x, box.Min.y, box.Min.z };
+        const float bmax[3] = { box.Max.x, box.Max.y, box.Max.z };
+
+        float tmin = 0.0f;
+        float tmax = maxDistance;
+        int hitAxis = -1;
+        float hitSign = 0.0f;
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (std::fabs(dir[axis]) < 1e-8f)
+            {
+                if (origin[axis] < bmin[axis] || origin[axis] > bmax[axis]) return false;
+                continue;
+            }
+
+            const float inv = 1.0f / dir[axis];
+            float t1 = (bmin[axis] - origin[axis]) * inv;
+            float t2 = (bmax[axis] - origin[axis]) * inv;
+            float sign = -1.0f;
+            if (t1 > t2) { std::swap(t1, t2); sign = 1.0f; }
+
+            if (t1 > tmin) { tmin = t1; hitAxis = axis; hitSign = sign; }
+            tmax = std::min(tmax, t2);
+            if (tmin > tmax) return false;
+        }
+
+        outT = tmin;
+        outNormal = XMFLOAT3(0, 0, 0);
+        if (hitAxis == 0) outNormal.x = hitSign;
+        else if (hitAxis == 1) outNormal.y = hitSign;
+        else if (hitAxis == 2) outNormal.z = hitSign;
+        else outNormal = XMFLOAT3(-ray.Direction.x, -ray.Direction.y, -ray.Direction.z); // Origin inside the box
+        return true;
+    }
+
+    /**
+     * @brief Separating-axis test between two oriented boxes given as center, axes and half extents
+     */
+    bool OrientedBoxesOverlap(const XMFLOAT3& centerA, const XMFLOAT3 axesA[3], const XMFLOAT3& halfA,
+                              const XMFLOAT3& centerB, const XMFLOAT3 axesB[3], const XMFLOAT3& halfB)
+    {
+        const float ea[3] = { halfA.x, halfA.y, halfA.z };
+        const float eb[3] = { halfB.x, halfB.y, halfB.z };
+
+        float R[3][3], AbsR[3][3];
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                R[i][j] = CollisionSystem::Vector3Dot(axesA[i], axesB[j]);
+                AbsR[i][j] = std::fabs(R[i][j]) + 1e-6f;
+            }
+        }
+
+        const XMFLOAT3 d(centerB.x - centerA.x, centerB.y - centerA.y, centerB.z - centerA.z);
+        const float t[3] = { CollisionSystem::Vector3Dot(d, axesA[0]),
+                             CollisionSystem::Vector3Dot(d, axesA[1]),
+                             CollisionSystem::Vector3Dot(d, axesA[2]) };
+
+        for (int i = 0; i < 3; ++i) {
+            const float rb = eb[0] * AbsR[i][0] + eb[1] * AbsR[i][1] + eb[2] * AbsR[i][2];
+            if (std::fabs(t[i]) > ea[i] + rb) return false;
+        }
+
+        for (int j = 0; j < 3; ++j) {
+            const float ra = ea[0] * AbsR[0][j] + ea[1] * AbsR[1][j] + ea[2] * AbsR[2][j];
+            const float tj = t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j];
+            if (std::fabs(tj) > ra + eb[j]) return false;
+        }
+
+        for (int i = 0; i < 3; ++i) {
+            const int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+            for (int j = 0; j < 3; ++j) {
+                const int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+                const float ra = ea[i1] * AbsR[i2][j] + ea[i2] * AbsR[i1][j];
+                const float rb = eb[j1] * AbsR[i][j2] + eb[j2] * AbsR[i][j1];
+                const float tl = t[i2] * R[i1][j] - t[i1] * R[i2][j];
+                if (std::fabs(tl) > ra + rb) return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Stack corners of the benchmark scene, as (x, z)
+    const XMFLOAT2 BenchmarkStackOrigins[4] = { {-20.0f, -20.0f}, {20.0f, -20.0f}, {-20.0f, 20.0f}, {20.0f, 20.0f} };
+
+    /**
+     * @brief Populate world with the solver benchmark scene
+     *
+     * Ground, four box stacks in the corners and a walled pit holding a pile
+     * of spheres and randomly oriented boxes. The layout is seeded, so every
+     * call builds the identical scene.
+     *
+     * @return The top box of each stack
+     */
+    std::vector<RigidBodyId> BuildBenchmarkScene(RigidBodyWorld& world, int stackHeight, int pileBodies)
+    {
+        RigidBodyDef ground;
+        ground.motion = RigidBodyMotion::Static;
+        ground.shape.halfExtents = XMFLOAT3(60.0f, 0.5f, 60.0f);
+        ground.position = XMFLOAT3(0.0f, -0.5f, 0.0f);
+        world.CreateBody(ground);
+
+        // Four unit-box stacks in the corners
+        std::vector<RigidBodyId> stackTops;
+        for (const XMFLOAT2& origin : BenchmarkStackOrigins)
+        {
+            RigidBodyDef box;
+            box.shape.halfExtents = XMFLOAT3(0.5f, 0.5f, 0.5f);
+            RigidBodyId top = InvalidRigidBodyId;
+            for (int i = 0; i < stackHeight; ++i) {
+                box.position = XMFLOAT3(origin.x, 0.5f + static_cast<float>(i), origin.y);
+                top = world.CreateBody(box);
+            }
+            stackTops.push_back(top);
+        }
+
+        // Walled pit in the middle; the pile is dropped into it in layers of 8x8
+        const float pitHalf = 6.0f;
+        for (int side = 0; side < 4; ++side)
+        {
+            RigidBodyDef wall;
+            wall.motion = RigidBodyMotion::Static;
+            const bool alongX = side < 2;
+            const float offset = (side % 2 == 0) ? pitHalf + 0.5f : -(pitHalf + 0.5f);
+            wall.shape.halfExtents = alongX ? XMFLOAT3(pitHalf + 1.0f, 5.0f, 0.5f) : XMFLOAT3(0.5f, 5.0f, pitHalf + 1.0f);
+            wall.position = alongX ? XMFLOAT3(0.0f, 5.0f, offset) : XMFLOAT3(offset, 5.0f, 0.0f);
+            world.CreateBody(wall);
+        }
+
+        std::mt19937 rng(4242);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> size(0.25f, 0.45f);
+        for (int i = 0; i < pileBodies; ++i)
+        {
+            const int layer = i / 64, cell = i % 64;
+            RigidBodyDef body;
+            body.position = XMFLOAT3(-4.9f + 1.4f * static_cast<float>(cell % 8) + 0.1f * unit(rng),
+                                     1.0f + 1.2f * static_cast<float>(layer),
+                                     -4.9f + 1.4f * static_cast<float>(cell / 8) + 0.1f * unit(rng));
+            if (i % 2 == 0) {
+                body.shape.type = RigidShapeType::Sphere;
+                body.shape.radius = size(rng);
+            } else {
+                body.shape.halfExtents = XMFLOAT3(size(rng), size(rng), size(rng));
+                body.orientation = EulerToQuaternion(XMFLOAT3(unit(rng) * XM_PI, unit(rng) * XM_PI, unit(rng) * XM_PI));
+            }
+            body.mass = 0.0f;   // Derive from density so spheres and boxes of different sizes mix
+            world.CreateBody(body);
+        }
+
+        return stackTops;
+    }
+
+    /**
+     * @brief FNV-1a hash of every body's position and orientation bits
+     */
+    uint64_t HashWorldState(const RigidBodyWorld& world)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (RigidBodyId id = 0; id < world.GetBodyCount(); ++id)
+        {
+            if (!world.IsValid(id)) continue;
+            const XMFLOAT3 p = world.GetPosition(id);
+            const XMFLOAT4 q = world.GetOrientation(id);
+            const float values[7] = { p.x, p.y, p.z, q.x, q.y, q.z, q.w };
+            const auto* bytes = reinterpret_cast<const unsigned char*>(values);
+            for (size_t i = 0; i < sizeof(values); ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        }
+        return hash;
+    }
+
+    /**
+     * @brief FNV-1a hash of a triangle mesh's vertex and index bytes
+     */
+    uint64_t HashMeshGeometry(const std::vector<XMFLOAT3>& vertices, const std::vector<uint32_t>& indices)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](const void* data, size_t size) {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        };
+        const uint64_t counts[2] = { vertices.size(), indices.size() };
+        mix(counts, sizeof(counts));
+        mix(vertices.data(), vertices.size() * sizeof(XMFLOAT3));
+        mix(indices.data(), indices.size() * sizeof(uint32_t));
+        return hash;
+    }
+
+    /**
+     * @brief Read the triangulated positions of every shape in an OBJ file
+     */
+    bool LoadObjTriangles(const std::filesystem::path& path, std::vector<XMFLOAT3>& vertices, std::vector<uint32_t>& indices)
+    {
+        tinyobj::ObjReader reader;
+        tinyobj::ObjReaderConfig config;
+        config.triangulate = true;
+        config.mtl_search_path = path.parent_path().string();
+        if (!reader.ParseFromFile(path.string(), config)) return false;
+
+        const auto& positions = reader.GetAttrib().vertices;
+        vertices.resize(positions.size() / 3);
+        for (size_t i = 0; i < vertices.size(); ++i)
+            vertices[i] = XMFLOAT3(positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2]);
+
+        indices.clear();
+        for (const auto& shape : reader.GetShapes()) {
+            for (const auto& index : shape.mesh.indices)
+                indices.push_back(static_cast<uint32_t>(index.vertex_index));
+        }
+        indices.resize(indices.size() - indices.size() % 3);
+        return !indices.empty();
+    }
+
+    /**
+     * @brief Rolling heightfield used when no OBJ assets are available
+     */
+    void BuildBenchmarkTerrain(int cells, std::vector<XMFLOAT3>& vertices, std::vector<uint32_t>& indices)
+    {
+        const uint32_t row = static_cast<uint32_t>(cells) + 1;
+        vertices.clear();
+        indices.clear();
+        for (int z = 0; z <= cells; ++z) {
+            for (int x = 0; x <= cells; ++x) {
+                const float height = std::sin(x * 0.11f) * std::cos(z * 0.07f) * 4.0f + std::sin((x + z) * 0.31f) * 0.5f;
+                vertices.push_back(XMFLOAT3(x - cells * 0.5f, height, z - cells * 0.5f));
+            }
+        }
+        for (uint32_t z = 0; z < static_cast<uint32_t>(cells); ++z) {
+            for (uint32_t x = 0; x < static_cast<uint32_t>(cells); ++x) {
+                const uint32_t a = z * row + x;
+                indices.insert(indices.end(), { a, a + row, a + 1, a + 1, a + row, a + row + 1 });
+            }
+        }
+    }
+}
+
 // ============================================================================
 // PHYSICS BODY IMPLEMENTATION (Stub for now)
 // ============================================================================
@@ -38,7 +448,7 @@ XMFLOAT3 PhysicsBody::GetPosition() const
 void PhysicsBody::SetPosition(const XMFLOAT3& position)
 {
     m_desc.position = position;
-    // In real implementation, would update Bullet Physics body
+    PushTransform();
 }
 
 XMFLOAT3 PhysicsBody::GetRotation() const
@@ -49,7 +459,7 @@ XMFLOAT3 PhysicsBody::GetRotation() const
 void PhysicsBody::SetRotation(const XMFLOAT3& rotation)
 {
     m_desc.rotation = rotation;
-    // In real implementation, would update Bullet Physics body
+    PushTransform();
 }
 
 XMMATRIX PhysicsBody::GetTransform() const
@@ -66,10 +476,10 @@ void PhysicsBody::SetTransform(const XMMATRIX& transform)
     
     XMStoreFloat3(&m_desc.position, translation);
     
-    // Convert quaternion to Euler angles (simplified)
     XMFLOAT4 rotQuat;
     XMStoreFloat4(&rotQuat, rotation);
-    m_desc.rotation = {rotQuat.x, rotQuat.y, rotQuat.z}; // Simplified conversion
+    m_desc.rotation = QuaternionToEuler(rotQuat);
+    PushTransform();
 }
 
 XMFLOAT3 PhysicsBody::GetLinearVelocity() const
@@ -80,6 +490,9 @@ XMFLOAT3 PhysicsBody::GetLinearVelocity() const
 void PhysicsBody::SetLinearVelocity(const XMFLOAT3& velocity)
 {
     m_desc.linearVelocity = velocity;
+    if (RigidBodyWorld* world = GetWorld()) {
+        world->SetLinearVelocity(m_bodyId, velocity);
+    }
 }
 
 XMFLOAT3 PhysicsBody::GetAngularVelocity() const
@@ -90,26 +503,40 @@ XMFLOAT3 PhysicsBody::GetAngularVelocity() const
 void PhysicsBody::SetAngularVelocity(const XMFLOAT3& velocity)
 {
     m_desc.angularVelocity = velocity;
+    if (RigidBodyWorld* world = GetWorld()) {
+        world->SetAngularVelocity(m_bodyId, velocity);
+    }
 }
 
 void PhysicsBody::ApplyForce(const XMFLOAT3& force, const XMFLOAT3& relativePos)
 {
-    // Stub implementation - in real version would apply to Bullet Physics body
+    if (RigidBodyWorld* world = GetWorld()) {
+        world->ApplyForce(m_bodyId, force, relativePos);
+    }
 }
 
 void PhysicsBody::ApplyImpulse(const XMFLOAT3& impulse, const XMFLOAT3& relativePos)
 {
-    // Stub implementation - in real version would apply to Bullet Physics body
+    if (RigidBodyWorld* world = GetWorld()) {
+        world->ApplyImpulse(m_bodyId, impulse, relativePos);
+        m_desc.linearVelocity = world->GetLinearVelocity(m_bodyId);
+        m_desc.angularVelocity = world->GetAngularVelocity(m_bodyId);
+    }
 }
 
 void PhysicsBody::ApplyTorque(const XMFLOAT3& torque)
 {
-    // Stub implementation
+    if (RigidBodyWorld* world = GetWorld()) {
+        world->ApplyTorque(m_bodyId, torque);
+    }
 }
 
 void PhysicsBody::ApplyTorqueImpulse(const XMFLOAT3& torque)
 {
-    // Stub implementation
+    if (RigidBodyWorld* world = GetWorld()) {
+        world->ApplyAngularImpulse(m_bodyId, torque);
+        m_desc.angularVelocity = world->GetAngularVelocity(m_bodyId);
+    }
 }
 
 float PhysicsBody::GetMass() const
@@ -120,26 +547,40 @@ float PhysicsBody::GetMass() const
 void PhysicsBody::SetMass(float mass)
 {
     m_desc.mass = mass;
+    if (RigidBodyWorld* world = GetWorld()) {
+        // A dynamic body with zero mass is treated as static
+        world->SetMotion(m_bodyId, MotionFor(m_desc));
+        if (mass > 0.0f) world->SetMass(m_bodyId, mass);
+    }
 }
 
 void PhysicsBody::SetMaterial(const PhysicsMaterial& material)
 {
     m_desc.material = material;
+    if (RigidBodyWorld* world = GetWorld()) {
+        world->SetMaterial(m_bodyId, material.friction, material.restitution, material.linearDamping, material.angularDamping);
+    }
 }
 
 void PhysicsBody::SetActive(bool active)
 {
-    // Stub implementation
+    if (RigidBodyWorld* world = GetWorld()) {
+        world->SetAwake(m_bodyId, active);
+    }
 }
 
 bool PhysicsBody::IsActive() const
 {
-    return true; // Stub implementation
+    const RigidBodyWorld* world = GetWorld();
+    return world ? world->IsAwake(m_bodyId) : false;
 }
 
 void PhysicsBody::SetKinematic(bool kinematic)
 {
     m_desc.isKinematic = kinematic;
+    if (RigidBodyWorld* world = GetWorld()) {
+        world->SetMotion(m_bodyId, MotionFor(m_desc));
+    }
 }
 
 bool PhysicsBody::IsKinematic() const
@@ -150,6 +591,9 @@ bool PhysicsBody::IsKinematic() const
 void PhysicsBody::SetTrigger(bool trigger)
 {
     m_desc.isTrigger = trigger;
+    if (RigidBodyWorld* world = GetWorld()) {
+        world->SetTrigger(m_bodyId, trigger);
+    }
 }
 
 bool PhysicsBody::IsTrigger() const
@@ -160,11 +604,36 @@ bool PhysicsBody::IsTrigger() const
 void PhysicsBody::SetCollisionGroup(uint16_t group)
 {
     m_collisionGroup = group;
+    if (RigidBodyWorld* world = GetWorld()) {
+        world->SetCollisionFilter(m_bodyId, m_collisionGroup, m_collisionMask);
+    }
 }
 
 void PhysicsBody::SetCollisionMask(uint16_t mask)
 {
     m_collisionMask = mask;
+    if (RigidBodyWorld* world = GetWorld()) {
+        world->SetCollisionFilter(m_bodyId, m_collisionGroup, m_collisionMask);
+    }
+}
+
+BoundingBox PhysicsBody::GetWorldBounds() const
+{
+    BoundingBox bounds = LocalShapeBounds(m_desc.shape);
+    bounds.Transform(ShapeWorldMatrix(m_desc));
+    return bounds;
+}
+
+RigidBodyWorld* PhysicsBody::GetWorld() const
+{
+    return m_system ? &m_system->m_world : nullptr;
+}
+
+void PhysicsBody::PushTransform()
+{
+    if (RigidBodyWorld* world = GetWorld()) {
+        world->SetTransform(m_bodyId, m_desc.position, EulerToQuaternion(m_desc.rotation));
+    }
 }
 
 std::string PhysicsBody::GetInfo() const
@@ -185,9 +654,13 @@ void PhysicsBody::Console_SetProperty(const std::string& property, float value)
     if (property == "mass") {
         SetMass(value);
     } else if (property == "friction") {
-        m_desc.material.friction = value;
+        PhysicsMaterial material = m_desc.material;
+        material.friction = value;
+        SetMaterial(material);
     } else if (property == "restitution") {
-        m_desc.material.restitution = value;
+        PhysicsMaterial material = m_desc.material;
+        material.restitution = value;
+        SetMaterial(material);
     }
 }
 
@@ -270,13 +743,28 @@ HRESULT PhysicsSystem::Initialize()
     // m_dynamicsWorld = new btDiscreteDynamicsWorld(m_dispatcher, m_broadphase, m_solver, m_collisionConfig);
     // m_dynamicsWorld->setGravity(btVector3(0, -9.8f, 0));
     
-    Spark::SimpleConsole::GetInstance().LogSuccess("PhysicsSystem initialized successfully (stub implementation)");
+    m_world.Clear();
+    m_accumulator = 0.0f;
+
+    // Solver loops borrow the JobSystem's workers; past 16 the colour sweeps are too short to split
+    m_world.SetThreadCount(16);
+    const int threads = m_world.GetThreadCount();
+
+    Spark::SimpleConsole::GetInstance().LogSuccess("PhysicsSystem initialized successfully (native rigid-body solver, " +
+                                                    std::to_string(threads) + " threads)");
     return S_OK;
 }
 
 void PhysicsSystem::Shutdown()
 {
     // Clear all bodies and constraints
+    for (auto& body : m_bodies) {
+        if (body) {
+            body->m_system = nullptr;
+            body->m_bodyId = InvalidRigidBodyId;
+        }
+    }
+    m_world.Clear();
     m_bodies.clear();
     m_constraints.clear();
     m_namedBodies.clear();
@@ -304,11 +792,28 @@ void PhysicsSystem::Update(float deltaTime)
     }
     
     auto startTime = std::chrono::high_resolution_clock::now();
-    
-    // Note: In real implementation, would step Bullet Physics simulation:
-    // if (m_dynamicsWorld) {
-    //     m_dynamicsWorld->stepSimulation(deltaTime, m_maxSubsteps, m_timeStep);
-    // }
+
+    // Fixed-step accumulator: the solver always sees m_timeStep. A long frame runs
+    // at most m_maxSubsteps steps and drops the remainder instead of spiralling.
+    const int maxSteps = std::max(m_maxSubsteps, 1);
+    m_accumulator += deltaTime;
+    uint32_t steps = 0;
+    float collisionTime = 0.0f;
+    while (m_accumulator >= m_timeStep && steps < static_cast<uint32_t>(maxSteps))
+    {
+        m_world.Step(m_timeStep);
+        m_accumulator -= m_timeStep;
+        ++steps;
+
+        SyncMovedBodies();
+        ProcessCollisions();
+
+        const RigidBodyStepStats& stats = m_world.GetStepStats();
+        collisionTime += stats.broadphaseMs + stats.narrowphaseMs;
+    }
+    if (steps == static_cast<uint32_t>(maxSteps)) {
+        m_accumulator = std::min(m_accumulator, m_timeStep);
+    }
     
     // Update metrics
     auto endTime = std::chrono::high_resolution_clock::now();
@@ -317,34 +822,78 @@ void PhysicsSystem::Update(float deltaTime)
     {
         std::lock_guard<std::mutex> lock(m_metricsMutex);
         m_metrics.simulationTime = duration.count() / 1000.0f; // Convert to milliseconds
-        m_metrics.timeStep = deltaTime;
+        m_metrics.collisionTime = collisionTime;
+        m_metrics.substeps = steps;
+        m_metrics.timeStep = m_timeStep;
         m_metrics.totalRigidBodies = static_cast<uint32_t>(m_bodies.size());
-        m_metrics.activeRigidBodies = static_cast<uint32_t>(m_bodies.size()); // Simplified
+        m_metrics.activeRigidBodies = m_world.GetAwakeBodyCount();
         m_metrics.activeConstraints = static_cast<uint32_t>(m_constraints.size());
+        m_metrics.collisionPairs = m_world.GetStepStats().manifolds;
+        m_metrics.broadphaseProxies = static_cast<uint32_t>(m_world.GetBroadphaseTree().GetProxyCount());
+    }
+}
+
+void PhysicsSystem::SyncMovedBodies()
+{
+    // Mirror the simulated state into each body's description, which the query
+    // and rendering paths read
+    for (RigidBodyId id : m_world.GetMovedBodies())
+    {
+        auto* body = static_cast<PhysicsBody*>(m_world.GetUserData(id));
+        if (!body) continue;
+
+        body->m_desc.position = m_world.GetPosition(id);
+        body->m_desc.rotation = QuaternionToEuler(m_world.GetOrientation(id));
+        body->m_desc.linearVelocity = m_world.GetLinearVelocity(id);
+        body->m_desc.angularVelocity = m_world.GetAngularVelocity(id);
+    }
+}
+
+void PhysicsSystem::ProcessCollisions()
+{
+    if (!m_collisionCallback && !m_triggerCallback) return;
+
+    // Copy first: callbacks may create or remove bodies
+    const std::vector<RigidContactEvent> events = m_world.GetContactEvents();
+    for (const RigidContactEvent& event : events)
+    {
+        if (!m_world.IsValid(event.bodyA) || !m_world.IsValid(event.bodyB)) continue;
+        auto* bodyA = static_cast<PhysicsBody*>(m_world.GetUserData(event.bodyA));
+        auto* bodyB = static_cast<PhysicsBody*>(m_world.GetUserData(event.bodyB));
+        if (!bodyA || !bodyB) continue;
+
+        const bool began = event.type == RigidContactEvent::Type::Begin;
+        if (event.isTrigger) {
+            if (m_triggerCallback) m_triggerCallback(bodyA, bodyB, began);
+        } else if (began && m_collisionCallback) {
+            ContactInfo info;
+            info.bodyA = bodyA;
+            info.bodyB = bodyB;
+            info.contactPoint = event.point;
+            info.contactNormal = event.normal;
+            info.penetrationDepth = event.depth;
+            m_collisionCallback(info);
+        }
     }
 }
 
 void PhysicsSystem::SetGravity(const XMFLOAT3& gravity)
 {
-    // Note: In real implementation:
-    // if (m_dynamicsWorld) {
-    //     m_dynamicsWorld->setGravity(ToBullet(gravity));
-    // }
+    m_world.SetGravity(gravity);
 }
 
 XMFLOAT3 PhysicsSystem::GetGravity() const
 {
-    // Note: In real implementation would get from Bullet Physics world
-    return {0.0f, -9.8f, 0.0f}; // Default gravity
+    return m_world.GetSettings().gravity;
 }
 
 std::shared_ptr<PhysicsBody> PhysicsSystem::CreateBody(const PhysicsBodyDesc& desc)
 {
-    // Note: In real implementation, would create Bullet Physics rigid body
-    btRigidBody* bulletBody = nullptr; // Placeholder
+    btRigidBody* bulletBody = nullptr; // Simulated by m_world
     
     auto body = std::make_shared<PhysicsBody>(desc, bulletBody);
     m_bodies.push_back(body);
+    AddRigidBody(body.get());
     
     if (!desc.name.empty()) {
         m_namedBodies[desc.name] = body;
@@ -367,18 +916,22 @@ void PhysicsSystem::RemoveBody(std::shared_ptr<PhysicsBody> body)
     // Remove from bodies list
     auto it = std::find(m_bodies.begin(), m_bodies.end(), body);
     if (it != m_bodies.end()) {
+        RemoveRigidBody(body.get());
         m_bodies.erase(it);
     }
-    
-    // Note: In real implementation, would remove from Bullet Physics world
 }
 
 void PhysicsSystem::RemoveAllBodies()
 {
+    for (auto& body : m_bodies) {
+        if (body) {
+            body->m_system = nullptr;
+            body->m_bodyId = InvalidRigidBodyId;
+        }
+    }
+    m_world.Clear();
     m_bodies.clear();
     m_namedBodies.clear();
-    
-    // Note: In real implementation, would remove all from Bullet Physics world
 }
 
 std::shared_ptr<PhysicsConstraint> PhysicsSystem::CreateHingeConstraint(
@@ -437,46 +990,257 @@ RaycastHit PhysicsSystem::Raycast(const XMFLOAT3& origin, const XMFLOAT3& direct
 {
     RaycastHit hit;
     hit.hasHit = false;
-    
-    // Note: In real implementation, would perform Bullet Physics raycast
-    // For now, return no hit
-    
-    std::lock_guard<std::mutex> lock(m_metricsMutex);
-    m_metrics.raycastCount++;
-    
+
+    {
+        std::lock_guard<std::mutex> lock(m_metricsMutex);
+        m_metrics.raycastCount++;
+    }
+
+    const XMFLOAT3 dir = CollisionSystem::Vector3Normalize(direction);
+    if (CollisionSystem::Vector3LengthSquared(dir) == 0.0f || maxDistance <= 0.0f) {
+        return hit;
+    }
+
+    // Closest hit: every accepted narrowphase hit clips the remaining ray
+    const Ray ray(origin, dir);
+    m_world.RayCast(ray, maxDistance, [&](RigidBodyId id, float clip) -> float {
+        const auto* body = static_cast<const PhysicsBody*>(m_world.GetUserData(id));
+        RaycastHit candidate;
+        if (!body || body->IsTrigger() || !RaycastBody(*body, ray, clip, candidate)) {
+            return clip;
+        }
+        hit = candidate;
+        return candidate.distance;
+    });
+
     return hit;
 }
 
 std::vector<RaycastHit> PhysicsSystem::RaycastAll(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance)
 {
     std::vector<RaycastHit> hits;
-    
-    // Note: In real implementation, would perform Bullet Physics raycast all
-    
-    std::lock_guard<std::mutex> lock(m_metricsMutex);
-    m_metrics.raycastCount++;
-    
+
+    {
+        std::lock_guard<std::mutex> lock(m_metricsMutex);
+        m_metrics.raycastCount++;
+    }
+
+    const XMFLOAT3 dir = CollisionSystem::Vector3Normalize(direction);
+    if (CollisionSystem::Vector3LengthSquared(dir) == 0.0f || maxDistance <= 0.0f) {
+        return hits;
+    }
+
+    const Ray ray(origin, dir);
+    m_world.RayCast(ray, maxDistance, [&](RigidBodyId id, float clip) -> float {
+        const auto* body = static_cast<const PhysicsBody*>(m_world.GetUserData(id));
+        RaycastHit candidate;
+        if (body && !body->IsTrigger() && RaycastBody(*body, ray, clip, candidate)) {
+            hits.push_back(candidate);
+        }
+        return clip;
+    });
+
+    std::sort(hits.begin(), hits.end(), [](const RaycastHit& a, const RaycastHit& b) {
+        return a.distance < b.distance;
+    });
     return hits;
 }
 
 bool PhysicsSystem::SphereOverlap(const XMFLOAT3& center, float radius, std::vector<PhysicsBody*>& results)
 {
     results.clear();
-    
-    // Note: In real implementation, would perform Bullet Physics sphere overlap test
-    
+    if (radius < 0.0f) return false;
+
+    const BoundingBox queryBox(XMFLOAT3(center.x - radius, center.y - radius, center.z - radius),
+                               XMFLOAT3(center.x + radius, center.y + radius, center.z + radius));
+
+    m_world.QueryAABB(queryBox, [&](RigidBodyId id) -> bool {
+        auto* body = static_cast<PhysicsBody*>(m_world.GetUserData(id));
+        if (!body) return true;
+
+        const PhysicsBodyDesc& desc = body->GetDesc();
+        const XMMATRIX world = ShapeWorldMatrix(desc);
+
+        bool overlaps = false;
+        if (desc.shape.type == CollisionShapeType::Sphere)
+        {
+            XMFLOAT3 shapeCenter;
+            XMStoreFloat3(&shapeCenter, world.r[3]);
+            overlaps = CollisionSystem::SphereVsSphere(BoundingSphere(center, radius),
+                                                       BoundingSphere(shapeCenter, desc.shape.radius));
+        }
+        else
+        {
+            // Move the query sphere into the shape's frame and test against its local box
+            XMFLOAT3 localCenter;
+            XMStoreFloat3(&localCenter, XMVector3TransformCoord(XMLoadFloat3(&center), XMMatrixInverse(nullptr, world)));
+            overlaps = CollisionSystem::SphereVsBox(BoundingSphere(localCenter, radius), LocalShapeBounds(desc.shape));
+        }
+
+        if (overlaps) {
+            results.push_back(body);
+        }
+        return true;
+    });
+
     return !results.empty();
 }
 
 bool PhysicsSystem::BoxOverlap(const XMFLOAT3& center, const XMFLOAT3& halfExtents, std::vector<PhysicsBody*>& results)
 {
     results.clear();
-    
-    // Note: In real implementation, would perform Bullet Physics box overlap test
-    
+
+    const BoundingBox queryBox(XMFLOAT3(center.x - halfExtents.x, center.y - halfExtents.y, center.z - halfExtents.z),
+                               XMFLOAT3(center.x + halfExtents.x, center.y + halfExtents.y, center.z + halfExtents.z));
+    const XMFLOAT3 queryAxes[3] = { XMFLOAT3(1, 0, 0), XMFLOAT3(0, 1, 0), XMFLOAT3(0, 0, 1) };
+
+    m_world.QueryAABB(queryBox, [&](RigidBodyId id) -> bool {
+        auto* body = static_cast<PhysicsBody*>(m_world.GetUserData(id));
+        if (!body) return true;
+
+        const PhysicsBodyDesc& desc = body->GetDesc();
+        const XMMATRIX world = ShapeWorldMatrix(desc);
+
+        bool overlaps = false;
+        if (desc.shape.type == CollisionShapeType::Sphere)
+        {
+            XMFLOAT3 shapeCenter;
+            XMStoreFloat3(&shapeCenter, world.r[3]);
+            overlaps = CollisionSystem::SphereVsBox(BoundingSphere(shapeCenter, desc.shape.radius), queryBox);
+        }
+        else
+        {
+            const BoundingBox local = LocalShapeBounds(desc.shape);
+            const XMFLOAT3 localCenter = local.GetCenter();
+
+            XMFLOAT3 shapeCenter, axes[3];
+            XMStoreFloat3(&shapeCenter, XMVector3TransformCoord(XMLoadFloat3(&localCenter), world));
+            for (int i = 0; i < 3; ++i) {
+                XMStoreFloat3(&axes[i], XMVector3Normalize(world.r[i]));
+            }
+            overlaps = OrientedBoxesOverlap(center, queryAxes, halfExtents, shapeCenter, axes, local.GetExtents());
+        }
+
+        if (overlaps) {
+            results.push_back(body);
+        }
+        return true;
+    });
+
     return !results.empty();
 }
 
+// ============================================================================
+// SIMULATION HELPERS
+// ============================================================================
+
+void PhysicsSystem::AddRigidBody(PhysicsBody* body)
+{
+    ASSERT_NOT_NULL(body);
+    RigidBodyDef def = MakeRigidBodyDef(body->m_desc);
+    def.collisionGroup = body->m_collisionGroup;
+    def.collisionMask = body->m_collisionMask;
+    def.userData = body;
+
+    body->m_system = this;
+    body->m_bodyId = m_world.CreateBody(def);
+
+    const CollisionShapeDesc& shape = body->m_desc.shape;
+    if (shape.type == CollisionShapeType::Mesh && !shape.vertices.empty() && shape.indices.size() >= 3) {
+        body->m_meshBVH = CreateMeshShape(shape.vertices, shape.indices);
+    }
+}
+
+std::shared_ptr<const TriangleBVH> PhysicsSystem::CreateMeshShape(const std::vector<XMFLOAT3>& vertices, const std::vector<uint32_t>& indices)
+{
+    // Bodies that share a mesh (instanced level pieces, props) share one hierarchy,
+    // but only once the geometry itself matches: the 64-bit hash can collide
+    const uint64_t key = HashMeshGeometry(vertices, indices);
+    auto [first, last] = m_meshShapes.equal_range(key);
+    for (auto it = first; it != last; ++it) {
+        auto existing = it->second.lock();
+        if (existing &&
+            existing->vertices.size() == vertices.size() && existing->indices.size() == indices.size() &&
+            std::memcmp(existing->vertices.data(), vertices.data(), vertices.size() * sizeof(XMFLOAT3)) == 0 &&
+            std::memcmp(existing->indices.data(), indices.data(), indices.size() * sizeof(uint32_t)) == 0) {
+            return std::shared_ptr<const TriangleBVH>(existing, &existing->bvh);
+        }
+    }
+
+    auto shape = std::make_shared<MeshShapeData>();
+    shape->vertices = vertices;
+    shape->indices = indices;
+    shape->bvh.Build(vertices, indices, &m_world.GetWorkerPool());
+
+    // Drop entries whose meshes are gone
+    for (auto entry = m_meshShapes.begin(); entry != m_meshShapes.end();) {
+        entry = entry->second.expired() ? m_meshShapes.erase(entry) : std::next(entry);
+    }
+    m_meshShapes.emplace(key, shape);
+    return std::shared_ptr<const TriangleBVH>(shape, &shape->bvh);
+}
+
+void PhysicsSystem::RemoveRigidBody(PhysicsBody* body)
+{
+    ASSERT_NOT_NULL(body);
+    if (body->m_bodyId != InvalidRigidBodyId) {
+        m_world.DestroyBody(body->m_bodyId);
+    }
+    body->m_bodyId = InvalidRigidBodyId;
+    body->m_system = nullptr;
+}
+
+bool PhysicsSystem::RaycastBody(const PhysicsBody& body, const Ray& ray, float maxDistance, RaycastHit& hit) const
+{
+    const PhysicsBodyDesc& desc = body.GetDesc();
+    const XMMATRIX world = ShapeWorldMatrix(desc);
+
+    auto accept = [&](float distance, const XMFLOAT3& normal) {
+        hit.hasHit = true;
+        hit.distance = distance;
+        hit.point = ray.GetPoint(distance);
+        hit.normal = normal;
+        hit.body = const_cast<PhysicsBody*>(&body);
+        hit.userData = body.GetUserData();
+        return true;
+    };
+
+    if (desc.shape.type == CollisionShapeType::Sphere)
+    {
+        XMFLOAT3 center;
+        XMStoreFloat3(&center, world.r[3]);
+        CollisionResult result = CollisionSystem::RayVsSphere(ray, BoundingSphere(center, desc.shape.radius));
+        if (!result.Hit || result.Distance > maxDistance) return false;
+        return accept(result.Distance, result.Normal);
+    }
+
+    // Everything else is tested in the shape's local frame. Rigid transforms
+    // preserve distances, so hit distances carry straight back to world space.
+    const XMMATRIX invWorld = XMMatrixInverse(nullptr, world);
+    Ray localRay;
+    XMStoreFloat3(&localRay.Origin, XMVector3TransformCoord(XMLoadFloat3(&ray.Origin), invWorld));
+    XMStoreFloat3(&localRay.Direction, XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&ray.Direction), invWorld)));
+
+    XMFLOAT3 localNormal;
+    float distance = FLT_MAX;
+
+    if (desc.shape.type == CollisionShapeType::Mesh && body.m_meshBVH)
+    {
+        CollisionResult result = CollisionSystem::RayVsMesh(localRay, *body.m_meshBVH, maxDistance);
+        if (!result.Hit) return false;
+        distance = result.Distance;
+        localNormal = result.Normal;
+    }
+    else if (!RayVsLocalBox(localRay, LocalShapeBounds(desc.shape), maxDistance, distance, localNormal))
+    {
+        return false;
+    }
+
+    XMFLOAT3 worldNormal;
+    XMStoreFloat3(&worldNormal, XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&localNormal), world)));
+    return accept(distance, worldNormal);
+}
+
 void PhysicsSystem::Console_EnableDebugDraw(bool enabled)
 {
     EnableDebugDraw(enabled);
@@ -529,6 +1293,7 @@ void PhysicsSystem::Console_Reset()
     RemoveAllBodies();
     m_constraints.clear();
     SetGravity({0.0f, -9.8f, 0.0f});
+    m_accumulator = 0.0f;
     m_paused = false;
     
     Spark::SimpleConsole::GetInstance().LogSuccess("Physics system reset complete");
@@ -633,6 +1398,552 @@ void PhysicsSystem::Console_ApplyImpulse(const std::string& name, float x, float
     }
 }
 
+std::string PhysicsSystem::Console_BenchmarkQueries(int bodyCount, int queryCount) const
+{
+    bodyCount = std::max(1, bodyCount);
+    queryCount = std::max(1, queryCount);
+
+    // Synthetic level: small static boxes scattered through a large volume
+    std::mt19937 rng(1337);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> size(0.25f, 4.0f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    std::vector<BoundingBox> boxes;
+    boxes.reserve(bodyCount);
+    DynamicAABBTree tree;
+
+    auto buildStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < bodyCount; ++i)
+    {
+        XMFLOAT3 c(position(rng), position(rng) * 0.1f, position(rng));
+        XMFLOAT3 e(size(rng), size(rng), size(rng));
+        boxes.emplace_back(XMFLOAT3(c.x - e.x, c.y - e.y, c.z - e.z), XMFLOAT3(c.x + e.x, c.y + e.y, c.z + e.z));
+        tree.CreateProxy(boxes.back(), reinterpret_cast<void*>(static_cast<intptr_t>(i)));
+    }
+    auto buildEnd = std::chrono::high_resolution_clock::now();
+
+    std::vector<Ray> rays;
+    rays.reserve(queryCount);
+    for (int i = 0; i < queryCount; ++i) {
+        rays.emplace_back(XMFLOAT3(position(rng), 5.0f, position(rng)),
+                          CollisionSystem::Vector3Normalize(XMFLOAT3(unit(rng), unit(rng) * 0.2f, unit(rng))));
+    }
+    const float maxDistance = 250.0f;
+
+    // Tree: closest hit per ray
+    int treeHits = 0;
+    auto treeStart = std::chrono::high_resolution_clock::now();
+    for (const Ray& ray : rays)
+    {
+        float closest = FLT_MAX;
+        tree.RayCast(ray, maxDistance, [&](int32_t proxyId, float clip) -> float {
+            const auto index = static_cast<size_t>(reinterpret_cast<intptr_t>(tree.GetUserData(proxyId)));
+            CollisionResult r = CollisionSystem::RayVsBox(ray, boxes[index]);
+            if (r.Hit && r.Distance <= clip) { closest = r.Distance; return r.Distance; }
+            return clip;
+        });
+        if (closest != FLT_MAX) ++treeHits;
+    }
+    auto treeEnd = std::chrono::high_resolution_clock::now();
+
+    // Linear scan over every collider, as the old query path had to do
+    int linearHits = 0;
+    auto linearStart = std::chrono::high_resolution_clock::now();
+    for (const Ray& ray : rays)
+    {
+        float closest = FLT_MAX;
+        for (const BoundingBox& box : boxes)
+        {
+            CollisionResult r = CollisionSystem::RayVsBox(ray, box);
+            if (r.Hit && r.Distance <= maxDistance && r.Distance < closest) closest = r.Distance;
+        }
+        if (closest != FLT_MAX) ++linearHits;
+    }
+    auto linearEnd = std::chrono::high_resolution_clock::now();
+
+    // Box overlap queries
+    size_t overlapCount = 0;
+    auto overlapStart = std::chrono::high_resolution_clock::now();
+    for (const Ray& ray : rays)
+    {
+        BoundingBox query(XMFLOAT3(ray.Origin.x - 10.0f, -10.0f, ray.Origin.z - 10.0f),
+                          XMFLOAT3(ray.Origin.x + 10.0f, 10.0f, ray.Origin.z + 10.0f));
+        tree.Query(query, [&](int32_t) { ++overlapCount; return true; });
+    }
+    auto overlapEnd = std::chrono::high_resolution_clock::now();
+
+    auto ms = [](auto a, auto b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+    const double treeMs = ms(treeStart, treeEnd);
+    const double linearMs = ms(linearStart, linearEnd);
+    const double overlapMs = ms(overlapStart, overlapEnd);
+
+    std::stringstream ss;
+    ss << "=== Broadphase Query Benchmark ===\n";
+    ss << "Colliders: " << bodyCount << ", Queries: " << queryCount << "\n";
+    ss << "Tree build: " << ms(buildStart, buildEnd) << " ms (height " << tree.GetHeight()
+       << ", area ratio " << tree.GetAreaRatio() << ")\n";
+    ss << "Raycast (tree):   " << treeMs << " ms, " << (queryCount / std::max(treeMs, 1e-6)) << " rays/ms, hits " << treeHits << "\n";
+    ss << "Raycast (linear): " << linearMs << " ms, " << (queryCount / std::max(linearMs, 1e-6)) << " rays/ms, hits " << linearHits << "\n";
+    ss << "Speedup: " << (linearMs / std::max(treeMs, 1e-6)) << "x\n";
+    ss << "Box overlap (tree): " << overlapMs << " ms, " << overlapCount << " candidates\n";
+    return ss.str();
+}
+
+std::string PhysicsSystem::Console_BenchmarkSimulation(int stackHeight, int pileBodies, int steps) const
+{
+    stackHeight = std::clamp(stackHeight, 1, 100);
+    pileBodies = std::max(0, pileBodies);
+    steps = std::max(1, steps);
+    const float dt = 1.0f / 60.0f;
+
+    // Standalone world so the benchmark never disturbs the live scene
+    RigidBodyWorld world(m_world.GetSettings());
+
+    const std::vector<RigidBodyId> stackTops = BuildBenchmarkScene(world, stackHeight, pileBodies);
+
+    double totalMs = 0.0, worstMs = 0.0;
+    uint32_t peakContacts = 0;
+    for (int i = 0; i < steps; ++i)
+    {
+        const auto start = std::chrono::high_resolution_clock::now();
+        world.Step(dt);
+        const double stepMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        totalMs += stepMs;
+        worstMs = std::max(worstMs, stepMs);
+        peakContacts = std::max(peakContacts, world.GetStepStats().contactPoints);
+    }
+
+    // Stack quality: how far each top box wandered sideways and sank
+    float maxDrift = 0.0f, maxSink = 0.0f;
+    for (size_t i = 0; i < stackTops.size(); ++i)
+    {
+        const XMFLOAT3 p = world.GetPosition(stackTops[i]);
+        const float dx = p.x - BenchmarkStackOrigins[i].x, dz = p.z - BenchmarkStackOrigins[i].y;
+        maxDrift = std::max(maxDrift, std::sqrt(dx * dx + dz * dz));
+        maxSink = std::max(maxSink, (static_cast<float>(stackHeight) - 0.5f) - p.y);
+    }
+
+    const RigidBodyStepStats& stats = world.GetStepStats();
+    std::stringstream ss;
+    ss << "=== Rigid-Body Simulation Benchmark ===\n";
+    ss << "Bodies: " << world.GetBodyCount() << " (4 stacks of " << stackHeight << ", pile of " << pileBodies << ")\n";
+    ss << "Steps: " << steps << " at " << dt * 1000.0f << " ms, " << world.GetSettings().substeps << " substeps x "
+       << world.GetSettings().velocityIterations << "+" << world.GetSettings().relaxIterations << " iterations\n";
+    ss << "Total: " << totalMs << " ms, " << (steps / std::max(totalMs / 1000.0, 1e-9)) << " steps/sec\n";
+    ss << "Per step: avg " << (totalMs / steps) << " ms, worst " << worstMs << " ms\n";
+    ss << "Peak contact points: " << peakContacts << "\n";
+    ss << "Final: " << world.GetAwakeBodyCount() << " awake, " << stats.sleepingIslands << " sleeping islands\n";
+    ss << "Stack tops: max drift " << maxDrift << " m, max sink " << maxSink << " m\n";
+    return ss.str();
+}
+
+std::string PhysicsSystem::Console_BenchmarkThreadScaling(int pileBodies, int steps) const
+{
+    pileBodies = std::max(0, pileBodies);
+    steps = std::max(1, steps);
+    const float dt = 1.0f / 60.0f;
+    const int threadCounts[] = { 1, 2, 4, 8, 16 };
+
+    std::stringstream ss;
+    ss << "=== Rigid-Body Thread Scaling Benchmark ===\n";
+    ss << "Scene: 4 stacks of 10, pile of " << pileBodies << ", " << steps << " steps at " << dt * 1000.0f << " ms\n";
+    ss << "Hardware threads: " << std::thread::hardware_concurrency() << ", job system threads: "
+       << JobSystem::GetInstance().GetThreadCount() << "\n";
+
+    double baselineMs = 0.0;
+    uint64_t baselineHash = 0;
+    bool deterministic = true;
+    for (int threads : threadCounts)
+    {
+        // Loops cannot use more threads than the job system has
+        if (threads > 1 && threads > JobSystem::GetInstance().GetThreadCount()) break;
+
+        RigidBodyWorld world(m_world.GetSettings());
+        world.SetThreadCount(threads);
+        BuildBenchmarkScene(world, 10, pileBodies);
+
+        double totalMs = 0.0, worstMs = 0.0;
+        uint32_t peakColors = 0;
+        for (int i = 0; i < steps; ++i)
+        {
+            const auto start = std::chrono::high_resolution_clock::now();
+            world.Step(dt);
+            const double stepMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            totalMs += stepMs;
+            worstMs = std::max(worstMs, stepMs);
+            peakColors = std::max(peakColors, world.GetStepStats().constraintColors);
+        }
+
+        const uint64_t hash = HashWorldState(world);
+        if (threads == 1) {
+            baselineMs = totalMs;
+            baselineHash = hash;
+        }
+        const bool matches = (hash == baselineHash);
+        deterministic = deterministic && matches;
+
+        const double averageMs = totalMs / steps;
+        ss << threads << " threads: avg " << averageMs << " ms, worst " << worstMs << " ms, "
+           << (1000.0 / std::max(averageMs, 1e-9)) << " Hz, speedup " << (baselineMs / std::max(totalMs, 1e-9)) << "x, "
+           << peakColors << " colours, state " << (matches ? "identical" : "DIVERGED") << "\n";
+    }
+
+    ss << "Determinism across thread counts: " << (deterministic ? "PASS" : "FAIL") << "\n";
+    return ss.str();
+}
+
+std::string PhysicsSystem::Console_BenchmarkContactCache(int stackHeight, int steps) const
+{
+    stackHeight = std::clamp(stackHeight, 1, 100);
+    steps = std::max(1, steps);
+    const float dt = 1.0f / 60.0f;
+    const int iterationCounts[] = { 1, 2, 4, 8 };
+
+    struct CacheMode
+    {
+        const char* name;
+        bool warmStarting;
+        bool manifoldReuse;
+    };
+    const CacheMode modes[] = {
+        { "warm start + reuse", true, true },
+        { "warm start only   ", true, false },
+        { "no cache          ", false, false },
+    };
+
+    std::stringstream ss;
+    ss << "=== Contact Cache Convergence Benchmark ===\n";
+    ss << "Scene: 4 stacks of " << stackHeight << ", " << steps << " steps at " << dt * 1000.0f << " ms, sleeping off\n";
+    ss << "sink/drift = top box error, jitter = fastest body at the end\n";
+
+    for (int iterations : iterationCounts)
+    {
+        ss << "-- " << iterations << " velocity iterations --\n";
+        for (const CacheMode& mode : modes)
+        {
+            RigidBodyWorldSettings settings = m_world.GetSettings();
+            settings.velocityIterations = iterations;
+            settings.enableSleeping = false;
+            settings.enableWarmStarting = mode.warmStarting;
+            settings.enableManifoldReuse = mode.manifoldReuse;
+
+            RigidBodyWorld world(settings);
+            world.SetThreadCount(1);
+            const std::vector<RigidBodyId> stackTops = BuildBenchmarkScene(world, stackHeight, 0);
+
+            double narrowphaseMs = 0.0, solverMs = 0.0;
+            uint64_t reusedManifolds = 0, manifolds = 0, warmPoints = 0, points = 0;
+            for (int i = 0; i < steps; ++i)
+            {
+                world.Step(dt);
+                const RigidBodyStepStats& stats = world.GetStepStats();
+                narrowphaseMs += stats.narrowphaseMs;
+                solverMs += stats.solverMs;
+                reusedManifolds += stats.reusedManifolds;
+                manifolds += stats.manifolds;
+                warmPoints += stats.warmStartedPoints;
+                points += stats.contactPoints;
+            }
+
+            float maxDrift = 0.0f, maxSink = 0.0f, jitter = 0.0f;
+            for (size_t i = 0; i < stackTops.size(); ++i)
+            {
+                const XMFLOAT3 p = world.GetPosition(stackTops[i]);
+                const float dx = p.x - BenchmarkStackOrigins[i].x, dz = p.z - BenchmarkStackOrigins[i].y;
+                maxDrift = std::max(maxDrift, std::sqrt(dx * dx + dz * dz));
+                maxSink = std::max(maxSink, (static_cast<float>(stackHeight) - 0.5f) - p.y);
+            }
+            for (RigidBodyId id = 0; id < world.GetBodyCount(); ++id) {
+                if (!world.IsValid(id)) continue;
+                const XMFLOAT3 v = world.GetLinearVelocity(id);
+                jitter = std::max(jitter, std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z));
+            }
+
+            ss << mode.name << ": sink " << maxSink << ", drift " << maxDrift << ", jitter " << jitter
+               << " m/s, narrowphase " << narrowphaseMs / steps << " ms, solver " << solverMs / steps << " ms, reused "
+               << (manifolds ? 100.0 * reusedManifolds / manifolds : 0.0) << "%, warm points "
+               << (points ? 100.0 * warmPoints / points : 0.0) << "%\n";
+        }
+    }
+    return ss.str();
+}
+
+std::string PhysicsSystem::Console_BenchmarkSweeps(int sweepCount, int targetCount) const
+{
+    sweepCount = std::max(1, sweepCount);
+    targetCount = std::max(1, targetCount);
+    auto ms = [](auto a, auto b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+
+    std::stringstream ss;
+    ss << "=== Swept Sphere Benchmark ===\n";
+
+    // Tunnelling regression: 2 cm wall, 5 cm rounds at 900 m/s (15 m per 60 Hz tick)
+    {
+        const float dt = 1.0f / 60.0f, speed = 900.0f, radius = 0.05f;
+        const BoundingBox wall(XMFLOAT3(-5.0f, -5.0f, 20.0f), XMFLOAT3(5.0f, 5.0f, 20.02f));
+        BoxSoA walls;
+        walls.Add(wall);
+        const SweepTargets targets{ nullptr, &walls, nullptr };
+
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> spread(-4.5f, 4.5f);
+        std::uniform_real_distribution<float> offset(0.0f, 15.0f);
+        std::vector<XMFLOAT3> positions;
+        for (int i = 0; i < sweepCount; ++i) positions.emplace_back(spread(rng), spread(rng), offset(rng));
+
+        int discreteHits = 0, sweptHits = 0, sweptTunnelled = 0;
+        std::vector<XMFLOAT3> discrete = positions, swept = positions;
+        std::vector<bool> discreteAlive(positions.size(), true), sweptAlive(positions.size(), true);
+        SphereSweepSoA sweeps;
+        std::vector<SweepHit> hits;
+        for (int step = 0; step < 4; ++step)
+        {
+            sweeps.Clear();
+            for (size_t i = 0; i < positions.size(); ++i)
+            {
+                if (discreteAlive[i]) {
+                    discrete[i].z += speed * dt;
+                    if (CollisionSystem::SphereVsBox(BoundingSphere(discrete[i], radius), wall)) {
+                        discreteAlive[i] = false;
+                        ++discreteHits;
+                    }
+                }
+                sweeps.Add(swept[i], XMFLOAT3(0.0f, 0.0f, sweptAlive[i] ? speed * dt : 0.0f), radius);
+            }
+            CollisionSystem::SweepSpheresBatch(sweeps, targets, hits);
+            for (size_t i = 0; i < positions.size(); ++i)
+            {
+                if (!sweptAlive[i]) continue;
+                if (hits[i].IsHit()) {
+                    swept[i].z += speed * dt * hits[i].Time;
+                    sweptAlive[i] = false;
+                    ++sweptHits;
+                } else {
+                    swept[i].z += speed * dt;
+                }
+            }
+        }
+        for (size_t i = 0; i < positions.size(); ++i) {
+            if (sweptAlive[i] && swept[i].z > wall.Max.z) ++sweptTunnelled;
+        }
+
+        ss << "Tunnelling (" << sweepCount << " rounds at " << speed << " m/s through a 2 cm wall)\n";
+        ss << "  discrete: " << discreteHits << " hits, " << (sweepCount - discreteHits) << " tunnelled\n";
+        ss << "  swept:    " << sweptHits << " hits, " << sweptTunnelled << " tunnelled -> "
+           << (sweptTunnelled == 0 && sweptHits == sweepCount ? "PASS" : "FAIL") << "\n";
+    }
+
+    // Throughput: a volley of sweeps against a cluttered level
+    {
+        std::mt19937 rng(1337);
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> size(0.1f, 3.0f);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+        SphereSoA spheres;
+        BoxSoA boxes;
+        TriangleSoA triangles;
+        for (int i = 0; i < targetCount; ++i)
+        {
+            const XMFLOAT3 c(position(rng), position(rng) * 0.1f, position(rng));
+            const float e = size(rng);
+            spheres.Add(BoundingSphere(XMFLOAT3(position(rng), position(rng) * 0.1f, position(rng)), size(rng)));
+            boxes.Add(BoundingBox(XMFLOAT3(c.x - e, c.y - size(rng), c.z - 0.05f), XMFLOAT3(c.x + e, c.y + size(rng), c.z + 0.05f)));
+            const XMFLOAT3 t(position(rng), position(rng) * 0.1f, position(rng));
+            triangles.Add(t, XMFLOAT3(t.x + size(rng) * 2.0f, t.y, t.z), XMFLOAT3(t.x, t.y + size(rng) * 2.0f, t.z + unit(rng)));
+        }
+
+        SphereSweepSoA sweeps;
+        sweeps.Reserve(sweepCount);
+        for (int i = 0; i < sweepCount; ++i) {
+            const XMFLOAT3 start(position(rng), position(rng) * 0.1f, position(rng));
+            const XMFLOAT3 delta = CollisionSystem::Vector3Normalize(XMFLOAT3(unit(rng), unit(rng) * 0.1f, unit(rng)));
+            sweeps.Add(start, XMFLOAT3(delta.x * 15.0f, delta.y * 15.0f, delta.z * 15.0f), 0.05f);
+        }
+        const SweepTargets targets{ &spheres, &boxes, &triangles };
+
+        std::vector<SweepHit> hits;
+        auto batchStart = std::chrono::high_resolution_clock::now();
+        CollisionSystem::SweepSpheresBatch(sweeps, targets, hits);
+        auto batchEnd = std::chrono::high_resolution_clock::now();
+
+        // Scalar reference: every exact test for every pair
+        int mismatches = 0, batchHits = 0;
+        auto scalarStart = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < sweepCount; ++i)
+        {
+            const BoundingSphere sphere(XMFLOAT3(sweeps.StartX[i], sweeps.StartY[i], sweeps.StartZ[i]), sweeps.Radius[i]);
+            const XMFLOAT3 delta(sweeps.DeltaX[i], sweeps.DeltaY[i], sweeps.DeltaZ[i]);
+            float best = 1.0f;
+            for (size_t j = 0; j < spheres.Size(); ++j) {
+                CollisionResult r = CollisionSystem::SweepSphereVsSphere(sphere, delta,
+                    BoundingSphere(XMFLOAT3(spheres.CenterX[j], spheres.CenterY[j], spheres.CenterZ[j]), spheres.Radius[j]));
+                if (r.Hit && r.Distance < best) best = r.Distance;
+            }
+            for (size_t j = 0; j < boxes.Size(); ++j) {
+                CollisionResult r = CollisionSystem::SweepSphereVsBox(sphere, delta,
+                    BoundingBox(XMFLOAT3(boxes.MinX[j], boxes.MinY[j], boxes.MinZ[j]), XMFLOAT3(boxes.MaxX[j], boxes.MaxY[j], boxes.MaxZ[j])));
+                if (r.Hit && r.Distance < best) best = r.Distance;
+            }
+            for (size_t j = 0; j < triangles.Size(); ++j) {
+                const XMFLOAT3 v0(triangles.V0X[j], triangles.V0Y[j], triangles.V0Z[j]);
+                CollisionResult r = CollisionSystem::SweepSphereVsTriangle(sphere, delta, v0,
+                    XMFLOAT3(v0.x + triangles.E1X[j], v0.y + triangles.E1Y[j], v0.z + triangles.E1Z[j]),
+                    XMFLOAT3(v0.x + triangles.E2X[j], v0.y + triangles.E2Y[j], v0.z + triangles.E2Z[j]));
+                if (r.Hit && r.Distance < best) best = r.Distance;
+            }
+            if (hits[i].IsHit()) ++batchHits;
+            if (hits[i].Time != best) ++mismatches;
+        }
+        auto scalarEnd = std::chrono::high_resolution_clock::now();
+
+        const double batchMs = ms(batchStart, batchEnd);
+        const double scalarMs = ms(scalarStart, scalarEnd);
+        ss << "Throughput (" << sweepCount << " sweeps vs " << targetCount * 3 << " targets, "
+           << CollisionSystem::GetBatchWidth() << "-wide lanes)\n";
+        ss << "  batched: " << batchMs << " ms, " << (sweepCount / std::max(batchMs, 1e-6)) << " sweeps/ms, hits " << batchHits << "\n";
+        ss << "  scalar:  " << scalarMs << " ms, " << (sweepCount / std::max(scalarMs, 1e-6)) << " sweeps/ms\n";
+        ss << "  speedup: " << (scalarMs / std::max(batchMs, 1e-6)) << "x, mismatches " << mismatches << "\n";
+    }
+    return ss.str();
+}
+
+std::string PhysicsSystem::Console_BenchmarkMeshRaycast(int rayCount, const std::string& directory) const
+{
+    rayCount = std::max(1, rayCount);
+    const int verifyCount = std::min(rayCount, 1000);
+    const int threads = std::min(JobSystem::GetInstance().GetThreadCount(), 16);
+
+    // Collect the meshes to test
+    struct BenchMesh
+    {
+        std::string name;
+        std::vector<XMFLOAT3> vertices;
+        std::vector<uint32_t> indices;
+    };
+    std::vector<BenchMesh> meshes;
+
+    std::vector<std::filesystem::path> searchPaths;
+    if (!directory.empty()) {
+        searchPaths.push_back(directory);
+    } else {
+        searchPaths = { "Assets/Models", "../Assets/Models" };
+    }
+
+    std::error_code error;
+    for (const auto& searchPath : searchPaths)
+    {
+        if (!std::filesystem::is_directory(searchPath, error)) continue;
+        std::vector<std::filesystem::path> files;
+        for (const auto& entry : std::filesystem::directory_iterator(searchPath, error)) {
+            std::string extension = entry.path().extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(),
+                [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            if (entry.is_regular_file() && extension == ".obj") files.push_back(entry.path());
+        }
+        std::sort(files.begin(), files.end());
+
+        for (const auto& file : files) {
+            BenchMesh mesh;
+            mesh.name = file.filename().string();
+            if (LoadObjTriangles(file, mesh.vertices, mesh.indices)) meshes.push_back(std::move(mesh));
+        }
+        if (!meshes.empty()) break;
+    }
+
+    if (meshes.empty()) {
+        BenchMesh terrain;
+        terrain.name = "generated terrain 384x384";
+        BuildBenchmarkTerrain(384, terrain.vertices, terrain.indices);
+        meshes.push_back(std::move(terrain));
+    }
+
+    std::stringstream ss;
+    ss << "=== Mesh BVH Raycast Benchmark ===\n";
+    ss << rayCount << " rays per mesh, " << verifyCount << " checked against a linear scan, "
+       << threads << " build threads\n";
+
+    PhysicsWorkerPool pool(threads);
+    for (const BenchMesh& mesh : meshes)
+    {
+        TriangleBVH serial;
+        serial.Build(mesh.vertices, mesh.indices);
+        TriangleBVH bvh;
+        bvh.Build(mesh.vertices, mesh.indices, &pool);
+        if (bvh.IsEmpty()) {
+            ss << mesh.name << ": no valid triangles\n";
+            continue;
+        }
+
+        const TriangleBVHStats& stats = bvh.GetStats();
+        const bool identical = serial.GetNodes().size() == bvh.GetNodes().size() &&
+            std::equal(serial.GetNodes().begin(), serial.GetNodes().end(), bvh.GetNodes().begin(),
+                [](const TriangleBVHNode& a, const TriangleBVHNode& b) {
+                    return a.leftFirst == b.leftFirst && a.triangleCount == b.triangleCount;
+                });
+
+        // Rays start on a sphere around the mesh and aim at random points inside it
+        const BoundingBox bounds = bvh.GetBounds();
+        const XMFLOAT3 center = bounds.GetCenter();
+        const XMFLOAT3 extents = bounds.GetExtents();
+        const float radius = std::max(std::sqrt(extents.x * extents.x + extents.y * extents.y + extents.z * extents.z), 0.01f) * 1.5f;
+
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::vector<Ray> rays(rayCount);
+        for (Ray& ray : rays)
+        {
+            XMVECTOR onSphere;
+            do {
+                onSphere = XMVectorSet(unit(rng), unit(rng), unit(rng), 0.0f);
+            } while (XMVectorGetX(XMVector3LengthSq(onSphere)) < 1e-4f);
+            onSphere = XMVector3Normalize(onSphere);
+            const XMVECTOR origin = XMVectorAdd(XMLoadFloat3(&center), XMVectorScale(onSphere, radius));
+            const XMVECTOR target = XMVectorSet(center.x + unit(rng) * extents.x, center.y + unit(rng) * extents.y,
+                                                center.z + unit(rng) * extents.z, 0.0f);
+            XMStoreFloat3(&ray.Origin, origin);
+            XMStoreFloat3(&ray.Direction, XMVector3Normalize(XMVectorSubtract(target, origin)));
+        }
+
+        int hits = 0;
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (const Ray& ray : rays) {
+            TriangleBVHHit hit;
+            if (bvh.Raycast(ray, FLT_MAX, hit)) ++hits;
+        }
+        const double bvhMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+        int mismatches = 0;
+        const auto linearStart = std::chrono::high_resolution_clock::now();
+        for (int r = 0; r < verifyCount; ++r)
+        {
+            float closest = FLT_MAX;
+            for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+                const uint32_t a = mesh.indices[i], b = mesh.indices[i + 1], c = mesh.indices[i + 2];
+                if (a >= mesh.vertices.size() || b >= mesh.vertices.size() || c >= mesh.vertices.size()) continue;
+                const CollisionResult result = CollisionSystem::RayVsTriangle(rays[r], mesh.vertices[a], mesh.vertices[b], mesh.vertices[c]);
+                if (result.Hit) closest = std::min(closest, result.Distance);
+            }
+            TriangleBVHHit hit;
+            const bool bvhHit = bvh.Raycast(rays[r], FLT_MAX, hit);
+            if (bvhHit != (closest != FLT_MAX) || (bvhHit && std::fabs(hit.distance - closest) > 1e-4f * std::max(1.0f, closest)))
+                ++mismatches;
+        }
+        const double linearMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - linearStart).count();
+
+        const double bvhRate = rayCount / std::max(bvhMs * 0.001, 1e-9);
+        const double linearRate = verifyCount / std::max(linearMs * 0.001, 1e-9);
+        ss << mesh.name << ": " << stats.triangles << " tris, " << stats.nodes << " nodes, depth " << stats.maxDepth
+           << ", SAH " << stats.sahCost << "\n";
+        ss << "  build " << serial.GetStats().buildMs << " ms serial, " << stats.buildMs << " ms on " << threads
+           << " threads (" << stats.subtreeTasks << " subtrees, layout " << (identical ? "identical" : "DIFFERS") << ")\n";
+        ss << "  BVH " << bvhRate / 1.0e6 << " Mrays/s (" << hits << " hits), linear " << linearRate / 1.0e6
+           << " Mrays/s, speedup " << bvhRate / std::max(linearRate, 1e-9) << "x, mismatches " << mismatches << "\n";
+    }
+    return ss.str();
+}
+
 void PhysicsSystem::RegisterMaterial(const std::string& name, const PhysicsMaterial& material)
 {
     m_materials[name] = material;
@@ -12,6 +12,8 @@
 #pragma once
 
 #include "Utils/Assert.h"
+#include "RigidBodyWorld.h"
+#include "TriangleBVH.h"
 #include <DirectXMath.h>
 #include <string>
 #include <vector>
@@ -92,7 +94,7 @@ struct PhysicsMaterial
 struct CollisionShapeDesc
 {
     CollisionShapeType type = CollisionShapeType::Box;
-    XMFLOAT3 dimensions = {1.0f, 1.0f, 1.0f}; ///< Shape dimensions
+    XMFLOAT3 dimensions = {1.0f, 1.0f, 1.0f}; ///< Shape dimensions (full extents along each local axis)
     float radius = 0.5f;                  ///< Radius for sphere/capsule/cylinder
     float height = 1.0f;                  ///< Height for capsule/cylinder/cone
     std::string meshPath;                 ///< Mesh file path for mesh shapes
@@ -202,9 +204,18 @@ public:
     void* GetUserData() const { return m_desc.userData; }
     const std::string& GetName() const { return m_desc.name; }
 
+    // Bounds
+    BoundingBox GetWorldBounds() const;
+
     // Internal
     btRigidBody* GetBulletBody() const { return m_bulletBody; }
     const PhysicsBodyDesc& GetDesc() const { return m_desc; }
+    RigidBodyId GetBodyId() const { return m_bodyId; }
+
+    /**
+     * @brief Triangle hierarchy of a mesh collider (null for other shapes)
+     */
+    const TriangleBVH* GetMeshBVH() const { return m_meshBVH.get(); }
 
     // Console integration
     std::string GetInfo() const;
@@ -212,10 +223,20 @@ public:
     void Console_ApplyForce(float x, float y, float z);
 
 private:
+    friend class PhysicsSystem;
+
+    RigidBodyWorld* GetWorld() const;
+    void PushTransform();
+
     PhysicsBodyDesc m_desc;
     btRigidBody* m_bulletBody;
     uint16_t m_collisionGroup = 1;
     uint16_t m_collisionMask = 0xFFFF;
+
+    // Simulation registration (owned by PhysicsSystem)
+    class PhysicsSystem* m_system = nullptr;
+    RigidBodyId m_bodyId = InvalidRigidBodyId;
+    std::shared_ptr<const TriangleBVH> m_meshBVH; ///< Shared between bodies using the same mesh
 };
 
 /**
@@ -289,6 +310,8 @@ public:
     float GetTimeStep() const { return m_timeStep; }
     void SetMaxSubsteps(int maxSubsteps) { m_maxSubsteps = maxSubsteps; }
     int GetMaxSubsteps() const { return m_maxSubsteps; }
+    void SetWorkerThreadCount(int threadCount) { m_world.SetThreadCount(threadCount); }
+    int GetWorkerThreadCount() const { return m_world.GetThreadCount(); }
 
     // Body management
     std::shared_ptr<PhysicsBody> CreateBody(const PhysicsBodyDesc& desc);
@@ -315,6 +338,12 @@ public:
     bool SphereOverlap(const XMFLOAT3& center, float radius, std::vector<PhysicsBody*>& results);
     bool BoxOverlap(const XMFLOAT3& center, const XMFLOAT3& halfExtents, std::vector<PhysicsBody*>& results);
 
+    // Broadphase and simulation core
+    const DynamicAABBTree& GetBroadphaseTree() const { return m_world.GetBroadphaseTree(); }
+    void SetBroadphaseMargin(float margin) { m_world.SetBroadphaseMargin(margin); }
+    RigidBodyWorld& GetWorld() { return m_world; }
+    const RigidBodyWorld& GetWorld() const { return m_world; }
+
     // Collision callbacks
     void SetCollisionCallback(std::function<void(const ContactInfo&)> callback) { m_collisionCallback = callback; }
     void SetTriggerCallback(std::function<void(PhysicsBody*, PhysicsBody*, bool)> callback) { m_triggerCallback = callback; }
@@ -408,7 +437,69 @@ public:
      */
     void Console_Reset();
 
+    /**
+     * @brief Benchmark broadphase ray and box queries against a linear scan
+     * @param bodyCount Number of synthetic static colliders
+     * @param queryCount Number of ray and box queries to time
+     */
+    std::string Console_BenchmarkQueries(int bodyCount, int queryCount) const;
+
+    /**
+     * @brief Benchmark the rigid-body solver on box stacks and a mixed pile
+     * @param stackHeight Boxes per stack (four stacks are built)
+     * @param pileBodies Number of spheres and boxes dropped into the pile
+     * @param steps Number of fixed steps to simulate
+     */
+    std::string Console_BenchmarkSimulation(int stackHeight, int pileBodies, int steps) const;
+
+    /**
+     * @brief Time the simulation benchmark scene at 1, 2, 4, 8 and 16 solver threads
+     *
+     * Also checks that every thread count ends in exactly the same state.
+     *
+     * @param pileBodies Number of debris bodies in the pile
+     * @param steps Number of fixed steps to simulate per thread count
+     */
+    std::string Console_BenchmarkThreadScaling(int pileBodies, int steps) const;
+
+    /**
+     * @brief Benchmark BVH ray casts against the OBJ meshes in a directory
+     *
+     * Builds each mesh serially and on the worker threads, then times closest-hit
+     * rays per second and checks a sample of them against a linear triangle scan.
+     * Falls back to a generated terrain when the directory holds no OBJ files.
+     *
+     * @param rayCount Number of rays cast per mesh
+     * @param directory Directory searched for .obj files (empty = Assets/Models)
+     */
+    std::string Console_BenchmarkMeshRaycast(int rayCount, const std::string& directory) const;
+
+    /**
+     * @brief Compare stack convergence with and without the persistent contact cache
+     *
+     * Runs the box stacks (sleeping disabled) with warm starting and manifold
+     * reuse, warm starting only, and neither, at several solver iteration counts.
+     *
+     * @param stackHeight Boxes per stack (four stacks are built)
+     * @param steps Number of fixed steps to simulate per configuration
+     */
+    std::string Console_BenchmarkContactCache(int stackHeight, int steps) const;
+
+    /**
+     * @brief Check projectile tunnelling and benchmark batched sphere sweeps
+     *
+     * Fires fast rounds at a thin wall with discrete end-of-step overlap tests
+     * and with swept tests (the swept run must report zero tunnelled rounds),
+     * then times batched sweeps against a scalar per-pair loop.
+     *
+     * @param sweepCount Number of moving spheres per batch
+     * @param targetCount Number of boxes, spheres and triangles each in the scene
+     */
+    std::string Console_BenchmarkSweeps(int sweepCount, int targetCount) const;
+
 private:
+    friend class PhysicsBody;
+
     // Bullet Physics world
     btDiscreteDynamicsWorld* m_dynamicsWorld;
     btDefaultCollisionConfiguration* m_collisionConfig;
@@ -421,9 +512,30 @@ private:
     std::vector<std::shared_ptr<PhysicsConstraint>> m_constraints;
     std::unordered_map<std::string, std::shared_ptr<PhysicsBody>> m_namedBodies;
 
+    // Rigid-body simulation; its broadphase tree also backs all world queries
+    RigidBodyWorld m_world;
+    float m_accumulator = 0.0f;
+
     // Collision shapes cache
     std::unordered_map<size_t, btCollisionShape*> m_shapeCache;
 
+    /**
+     * @brief A mesh collider hierarchy together with the geometry it was built from
+     *
+     * Bodies hold the hierarchy through an aliasing pointer to this, so the
+     * copy of the geometry lives exactly as long as the shared hierarchy and
+     * lets a hash match be confirmed before the hierarchy is shared.
+     */
+    struct MeshShapeData
+    {
+        std::vector<XMFLOAT3> vertices;
+        std::vector<uint32_t> indices;
+        TriangleBVH bvh;
+    };
+
+    // Mesh collider hierarchies keyed by a hash of their geometry; colliding hashes keep separate entries
+    std::unordered_multimap<uint64_t, std::weak_ptr<const MeshShapeData>> m_meshShapes;
+
     // Materials
     std::unordered_map<std::string, PhysicsMaterial> m_materials;
     PhysicsMaterial m_defaultMaterial;
@@ -450,11 +562,17 @@ private:
     btCollisionShape* CreateBoxShape(const XMFLOAT3& dimensions);
     btCollisionShape* CreateSphereShape(float radius);
     btCollisionShape* CreateCapsuleShape(float radius, float height);
-    btCollisionShape* CreateMeshShape(const std::vector<XMFLOAT3>& vertices, const std::vector<uint32_t>& indices);
+    std::shared_ptr<const TriangleBVH> CreateMeshShape(const std::vector<XMFLOAT3>& vertices, const std::vector<uint32_t>& indices);
     btCollisionShape* CreateConvexHullShape(const std::vector<XMFLOAT3>& vertices);
 
     void UpdateMetrics();
     void ProcessCollisions();
+
+    // Simulation helpers
+    void AddRigidBody(PhysicsBody* body);
+    void RemoveRigidBody(PhysicsBody* body);
+    void SyncMovedBodies();
+    bool RaycastBody(const PhysicsBody& body, const Ray& ray, float maxDistance, RaycastHit& hit) const;
     size_t HashShape(const CollisionShapeDesc& desc);
     
     // Bullet conversion helpers
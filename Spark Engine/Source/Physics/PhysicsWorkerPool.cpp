@@ -0,0 +1,65 @@
+/**
+ * @file PhysicsWorkerPool.cpp
+ * @brief Implementation of the physics fork-join loops on the JobSystem
+ * @author Spark Engine Team
+ * @date 2025
+ */
+
+#include "PhysicsWorkerPool.h"
+#include "Core/JobSystem.h"
+#include <algorithm>
+
+PhysicsWorkerPool::PhysicsWorkerPool(int threadCount)
+{
+    SetThreadCount(threadCount);
+}
+
+void PhysicsWorkerPool::SetThreadCount(int threadCount)
+{
+    m_threadCount = std::clamp(threadCount, 1, MaxThreads);
+}
+
+int PhysicsWorkerPool::GetThreadCount() const
+{
+    // Resolved per call so a pool built before the JobSystem starts does not create it off the main thread
+    return m_threadCount == 1 ? 1 : std::min(m_threadCount, JobSystem::GetInstance().GetThreadCount());
+}
+
+// ============================================================================
+// DISPATCH
+// ============================================================================
+
+void PhysicsWorkerPool::Dispatch(uint32_t count, uint32_t grain, RangeFunction function, void* context)
+{
+    m_function = function;
+    m_context = context;
+    m_count = count;
+    m_grain = grain;
+    m_chunkCount = (count + grain - 1) / grain;
+    m_nextChunk.store(0, std::memory_order_relaxed);
+
+    // Helpers claim chunks from the shared counter, so one that starts late finds
+    // nothing left and returns; High priority keeps the step ahead of frame jobs
+    JobSystem& jobs = JobSystem::GetInstance();
+    const uint32_t helpers = std::min(static_cast<uint32_t>(GetThreadCount() - 1), m_chunkCount - 1);
+    JobCounter counter;
+    for (uint32_t i = 0; i < helpers; ++i) {
+        jobs.Run([this]() { RunChunks(); }, &counter, JobPriority::High);
+    }
+
+    RunChunks();
+    jobs.Wait(counter);
+}
+
+void PhysicsWorkerPool::RunChunks()
+{
+    for (;;)
+    {
+        const uint32_t chunk = m_nextChunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= m_chunkCount) return;
+
+        const uint32_t begin = chunk * m_grain;
+        const uint32_t end = std::min(begin + m_grain, m_count);
+        m_function(m_context, begin, end);
+    }
+}
@@ -0,0 +1,102 @@
+/**
+ * @file PhysicsWorkerPool.h
+ * @brief Fork-join loops for the data-parallel stages of a physics step
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * The pool owns no threads: each loop borrows up to N-1 workers of the
+ * engine's JobSystem as helper jobs that claim chunks alongside the calling
+ * thread, so physics shares the cores with every other subsystem instead of
+ * oversubscribing them. A physics step issues many short loops back to back
+ * (one per solver colour per iteration), so a loop submits one helper per
+ * thread rather than one job per chunk.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief Blocking parallel-for loops run on the engine's JobSystem workers
+ *
+ * Work is split into fixed-size chunks that workers claim from an atomic
+ * counter. Chunk boundaries depend only on the item count and grain size, so
+ * a loop whose iterations write disjoint data produces the same result for
+ * every thread count.
+ *
+ * @note ParallelFor() must only be called from one thread at a time and must
+ *       not be nested.
+ */
+class PhysicsWorkerPool
+{
+public:
+    /**
+     * @brief Create the pool
+     * @param threadCount Total threads taking part in a loop, including the caller
+     */
+    explicit PhysicsWorkerPool(int threadCount = 1);
+
+    PhysicsWorkerPool(const PhysicsWorkerPool&) = delete;
+    PhysicsWorkerPool& operator=(const PhysicsWorkerPool&) = delete;
+
+    /**
+     * @brief Limit how many threads take part in a loop
+     * @param threadCount Total threads including the caller; clamped to [1, MaxThreads]
+     */
+    void SetThreadCount(int threadCount);
+
+    /**
+     * @brief Threads a loop actually uses: the requested count, capped by the JobSystem's threads
+     */
+    int GetThreadCount() const;
+
+    /**
+     * @brief Run func(begin, end) over [0, count) in chunks of grain items
+     *
+     * Returns once every chunk has finished. Runs inline when the pool has a
+     * single thread or the range fits in one chunk.
+     */
+    template<typename Func>
+    void ParallelFor(uint32_t count, uint32_t grain, Func&& func);
+
+    static constexpr int MaxThreads = 64;
+
+private:
+    using RangeFunction = void (*)(void* context, uint32_t begin, uint32_t end);
+
+    void Dispatch(uint32_t count, uint32_t grain, RangeFunction function, void* context);
+    void RunChunks();
+
+    int m_threadCount = 1;
+    std::atomic<uint32_t> m_nextChunk{ 0 };
+
+    // Current loop; written before the helper jobs are submitted
+    RangeFunction m_function = nullptr;
+    void* m_context = nullptr;
+    uint32_t m_count = 0;
+    uint32_t m_grain = 1;
+    uint32_t m_chunkCount = 0;
+};
+
+// ============================================================================
+// TEMPLATE IMPLEMENTATION
+// ============================================================================
+
+template<typename Func>
+void PhysicsWorkerPool::ParallelFor(uint32_t count, uint32_t grain, Func&& func)
+{
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+
+    if (m_threadCount == 1 || count <= grain) {
+        func(0u, count);
+        return;
+    }
+
+    auto trampoline = [](void* context, uint32_t begin, uint32_t end) {
+        (*static_cast<std::remove_reference_t<Func>*>(context))(begin, end);
+    };
+    Dispatch(count, grain, trampoline, const_cast<void*>(static_cast<const void*>(&func)));
+}
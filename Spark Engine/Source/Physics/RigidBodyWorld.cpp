@@ -0,0 +1,1866 @@
+/**
+ * @file RigidBodyWorld.cpp
+ * @brief Rigid-body integration, contact generation, impulse solver and sleeping
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * Step order (one fixed step):
+ *   1. Pair search: awake bodies query the broadphase with their fat bounds
+ *   2. Narrowphase: contact manifolds at the current positions, with
+ *      accumulated impulses carried over from matching points of last step
+ *   3. Velocity integration (gravity, forces, damping)
+ *   4. Sequential impulses: warm start, then N velocity iterations
+ *   5. Position integration and broadphase refit
+ *   6. Island building and sleeping
+ *
+ * Dense body columns are partitioned so the awake bodies occupy
+ * [0, m_awakeCount). Every per-step loop runs over that prefix only, so
+ * sleeping islands and static geometry cost nothing until they are touched.
+ */
+
+#include "RigidBodyWorld.h"
+#include "Utils/Assert.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+    constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+    // Box clipping keeps vertices this close to (or outside) the reference face. Stacked
+    // boxes of equal size otherwise flip incident vertices in and out on rounding noise,
+    // which changes the feature IDs every step and defeats warm starting.
+    constexpr float ContactSkin = 0.005f;
+
+    // ------------------------------------------------------------------------
+    // Vector and quaternion helpers (inline to keep the solver loops tight)
+    // ------------------------------------------------------------------------
+
+    inline XMFLOAT3 Add(const XMFLOAT3& a, const XMFLOAT3& b) { return XMFLOAT3(a.x + b.x, a.y + b.y, a.z + b.z); }
+    inline XMFLOAT3 Sub(const XMFLOAT3& a, const XMFLOAT3& b) { return XMFLOAT3(a.x - b.x, a.y - b.y, a.z - b.z); }
+    inline XMFLOAT3 Scale(const XMFLOAT3& a, float s) { return XMFLOAT3(a.x * s, a.y * s, a.z * s); }
+    inline XMFLOAT3 MulAdd(const XMFLOAT3& a, const XMFLOAT3& b, float s) { return XMFLOAT3(a.x + b.x * s, a.y + b.y * s, a.z + b.z * s); }
+    inline float Dot(const XMFLOAT3& a, const XMFLOAT3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    inline float LengthSq(const XMFLOAT3& a) { return Dot(a, a); }
+
+    inline XMFLOAT3 Cross(const XMFLOAT3& a, const XMFLOAT3& b)
+    {
+        return XMFLOAT3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+    }
+
+    inline XMFLOAT3 Normalize(const XMFLOAT3& a, const XMFLOAT3& fallback)
+    {
+        const float len = std::sqrt(LengthSq(a));
+        return (len > 1e-9f) ? Scale(a, 1.0f / len) : fallback;
+    }
+
+    inline float Component(const XMFLOAT3& v, int axis) { return axis == 0 ? v.x : (axis == 1 ? v.y : v.z); }
+
+    /// Hamilton product: the rotation b followed by a
+    inline XMFLOAT4 QuatMul(const XMFLOAT4& a, const XMFLOAT4& b)
+    {
+        return XMFLOAT4(a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                        a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                        a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+                        a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z);
+    }
+
+    inline XMFLOAT4 QuatConjugate(const XMFLOAT4& q) { return XMFLOAT4(-q.x, -q.y, -q.z, q.w); }
+
+    inline XMFLOAT4 QuatNormalize(const XMFLOAT4& q)
+    {
+        const float len = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+        if (len < 1e-9f) return XMFLOAT4(0, 0, 0, 1);
+        const float inv = 1.0f / len;
+        return XMFLOAT4(q.x * inv, q.y * inv, q.z * inv, q.w * inv);
+    }
+
+    inline XMFLOAT3 Rotate(const XMFLOAT4& q, const XMFLOAT3& v)
+    {
+        const XMFLOAT3 u(q.x, q.y, q.z);
+        const XMFLOAT3 t = Scale(Cross(u, v), 2.0f);
+        return Add(MulAdd(v, t, q.w), Cross(u, t));
+    }
+
+    inline XMFLOAT3 Mul(const RigidBodyWorld::Mat3& m, const XMFLOAT3& v)
+    {
+        return XMFLOAT3(m.c0.x * v.x + m.c1.x * v.y + m.c2.x * v.z,
+                        m.c0.y * v.x + m.c1.y * v.y + m.c2.y * v.z,
+                        m.c0.z * v.x + m.c1.z * v.y + m.c2.z * v.z);
+    }
+
+    // ------------------------------------------------------------------------
+    // Contact generation
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief World-space placement of a shape
+     */
+    struct ShapePose
+    {
+        XMFLOAT3 center;
+        XMFLOAT3 axes[3];
+    };
+
+    ShapePose MakePose(const XMFLOAT3& position, const XMFLOAT4& orientation, const RigidShape& shape)
+    {
+        ShapePose pose;
+        pose.center = Add(position, Rotate(orientation, shape.localOffset));
+        const XMFLOAT4 q = QuatMul(orientation, shape.localRotation);
+        pose.axes[0] = Rotate(q, XMFLOAT3(1, 0, 0));
+        pose.axes[1] = Rotate(q, XMFLOAT3(0, 1, 0));
+        pose.axes[2] = Rotate(q, XMFLOAT3(0, 0, 1));
+        return pose;
+    }
+
+    /**
+     * @brief Raw contact output; box clipping may produce up to eight points before reduction
+     */
+    struct ContactOutput
+    {
+        static constexpr int Capacity = 8;
+
+        XMFLOAT3 normal = XMFLOAT3(0, 1, 0);   ///< From the first shape towards the second
+        int count = 0;
+        XMFLOAT3 points[Capacity];
+        float depths[Capacity];
+        uint32_t features[Capacity];
+
+        void Push(const XMFLOAT3& point, float depth, uint32_t feature)
+        {
+            if (count < Capacity) {
+                points[count] = point;
+                depths[count] = depth;
+                features[count] = feature;
+                ++count;
+            }
+        }
+    };
+
+    bool CollideSpheres(const XMFLOAT3& centerA, float radiusA, const XMFLOAT3& centerB, float radiusB, ContactOutput& out)
+    {
+        const XMFLOAT3 d = Sub(centerB, centerA);
+        const float radiusSum = radiusA + radiusB;
+        const float distSq = LengthSq(d);
+        if (distSq > radiusSum * radiusSum) return false;
+
+        const float dist = std::sqrt(distSq);
+        out.normal = (dist > 1e-6f) ? Scale(d, 1.0f / dist) : XMFLOAT3(0, 1, 0);
+        const float depth = radiusSum - dist;
+        out.Push(MulAdd(centerA, out.normal, radiusA - depth * 0.5f), depth, 0);
+        return true;
+    }
+
+    /**
+     * @brief Oriented box against sphere; the normal points from the box to the sphere
+     */
+    bool CollideBoxSphere(const ShapePose& box, const XMFLOAT3& extents, const XMFLOAT3& center, float radius, ContactOutput& out)
+    {
+        const XMFLOAT3 d = Sub(center, box.center);
+        const float e[3] = { extents.x, extents.y, extents.z };
+        float local[3], clamped[3];
+        bool inside = true;
+        for (int i = 0; i < 3; ++i) {
+            local[i] = Dot(d, box.axes[i]);
+            clamped[i] = std::clamp(local[i], -e[i], e[i]);
+            inside = inside && (clamped[i] == local[i]);
+        }
+
+        if (!inside)
+        {
+            XMFLOAT3 closest = box.center;
+            for (int i = 0; i < 3; ++i) closest = MulAdd(closest, box.axes[i], clamped[i]);
+
+            const XMFLOAT3 delta = Sub(center, closest);
+            const float distSq = LengthSq(delta);
+            if (distSq > radius * radius) return false;
+
+            const float dist = std::sqrt(distSq);
+            out.normal = (dist > 1e-6f) ? Scale(delta, 1.0f / dist) : box.axes[1];
+            const float depth = radius - dist;
+            out.Push(MulAdd(closest, out.normal, -depth * 0.5f), depth, 0);
+            return true;
+        }
+
+        // Centre inside the box: push out through the nearest face
+        int axis = 0;
+        float minGap = e[0] - std::fabs(local[0]);
+        for (int i = 1; i < 3; ++i) {
+            const float gap = e[i] - std::fabs(local[i]);
+            if (gap < minGap) { minGap = gap; axis = i; }
+        }
+        const float sign = (local[axis] >= 0.0f) ? 1.0f : -1.0f;
+        out.normal = Scale(box.axes[axis], sign);
+        const float depth = radius + minGap;
+        out.Push(MulAdd(center, out.normal, (minGap - radius) * 0.5f), depth, 0x100u | static_cast<uint32_t>(axis));
+        return true;
+    }
+
+    /**
+     * @brief Sutherland-Hodgman clip of a polygon against the half-space dot(n, p) <= d
+     */
+    int ClipPolygon(const XMFLOAT3* in, const uint32_t* inIds, int count,
+                    const XMFLOAT3& n, float d, uint32_t plane,
+                    XMFLOAT3* out, uint32_t* outIds)
+    {
+        int outCount = 0;
+        for (int k = 0; k < count; ++k)
+        {
+            const int next = (k + 1) % count;
+            const float da = Dot(n, in[k]) - d;
+            const float db = Dot(n, in[next]) - d;
+
+            if (da <= 0.0f) {
+                out[outCount] = in[k];
+                outIds[outCount++] = inIds[k];
+            }
+            if ((da <= 0.0f) != (db <= 0.0f)) {
+                const float t = da / (da - db);
+                out[outCount] = MulAdd(in[k], Sub(in[next], in[k]), t);
+                outIds[outCount++] = (((plane + 1) << 12) ^ (inIds[k] << 4) ^ inIds[next]) & 0xFFFFu;
+            }
+        }
+        return outCount;
+    }
+
+    /**
+     * @brief Keep the four points that best preserve the contact area
+     *
+     * Deepest point first, then the point farthest from it, then the point
+     * spanning the largest triangle, then the point farthest outside that triangle.
+     */
+    void ReduceContacts(ContactOutput& c)
+    {
+        if (c.count <= 4) return;
+
+        int keep[4];
+        int kept = 0;
+
+        int best = 0;
+        for (int i = 1; i < c.count; ++i) if (c.depths[i] > c.depths[best]) best = i;
+        keep[kept++] = best;
+
+        best = -1;
+        float bestValue = -1.0f;
+        for (int i = 0; i < c.count; ++i) {
+            const float value = LengthSq(Sub(c.points[i], c.points[keep[0]]));
+            if (value > bestValue) { bestValue = value; best = i; }
+        }
+        keep[kept++] = best;
+
+        const XMFLOAT3& p0 = c.points[keep[0]];
+        const XMFLOAT3& p1 = c.points[keep[1]];
+        best = -1;
+        bestValue = 0.0f;
+        float winding = 1.0f;
+        for (int i = 0; i < c.count; ++i) {
+            const float area = Dot(Cross(Sub(p1, p0), Sub(c.points[i], p0)), c.normal);
+            if (std::fabs(area) > bestValue) { bestValue = std::fabs(area); best = i; winding = area >= 0.0f ? 1.0f : -1.0f; }
+        }
+        if (best >= 0) keep[kept++] = best;
+
+        if (kept == 3)
+        {
+            const XMFLOAT3* tri[3] = { &c.points[keep[0]], &c.points[keep[1]], &c.points[keep[2]] };
+            best = -1;
+            bestValue = 0.0f;
+            for (int i = 0; i < c.count; ++i) {
+                for (int e = 0; e < 3; ++e) {
+                    const XMFLOAT3& a = *tri[e];
+                    const XMFLOAT3& b = *tri[(e + 1) % 3];
+                    const float outside = -winding * Dot(Cross(Sub(b, a), Sub(c.points[i], a)), c.normal);
+                    if (outside > bestValue) { bestValue = outside; best = i; }
+                }
+            }
+            if (best >= 0) keep[kept++] = best;
+        }
+
+        ContactOutput reduced;
+        reduced.normal = c.normal;
+        for (int k = 0; k < kept; ++k) reduced.Push(c.points[keep[k]], c.depths[keep[k]], c.features[keep[k]]);
+        c = reduced;
+    }
+
+    /**
+     * @brief Oriented box against oriented box using the separating axis test
+     *
+     * Face contacts clip the incident face against the reference face's side
+     * planes; edge contacts use the closest points between the two edges.
+     * Face axes are preferred over edge axes (and A over B) unless the other
+     * axis separates noticeably more, which keeps resting contacts from
+     * flickering between features.
+     */
+    bool CollideBoxes(const ShapePose& a, const XMFLOAT3& extentsA, const ShapePose& b, const XMFLOAT3& extentsB, ContactOutput& out)
+    {
+        const float ea[3] = { extentsA.x, extentsA.y, extentsA.z };
+        const float eb[3] = { extentsB.x, extentsB.y, extentsB.z };
+        const XMFLOAT3 t = Sub(b.center, a.center);
+
+        float R[3][3], absR[3][3];
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                R[i][j] = Dot(a.axes[i], b.axes[j]);
+                absR[i][j] = std::fabs(R[i][j]) + 1e-6f;
+            }
+        }
+
+        float tA[3], tB[3];
+        for (int i = 0; i < 3; ++i) {
+            tA[i] = Dot(t, a.axes[i]);
+            tB[i] = Dot(t, b.axes[i]);
+        }
+
+        float faceASep = -FLT_MAX, faceBSep = -FLT_MAX, edgeSep = -FLT_MAX;
+        int faceAAxis = 0, faceBAxis = 0, edgeA = -1, edgeB = -1;
+        XMFLOAT3 edgeNormal(0, 1, 0);
+
+        for (int i = 0; i < 3; ++i) {
+            const float s = std::fabs(tA[i]) - (ea[i] + eb[0] * absR[i][0] + eb[1] * absR[i][1] + eb[2] * absR[i][2]);
+            if (s > 0.0f) return false;
+            if (s > faceASep) { faceASep = s; faceAAxis = i; }
+        }
+
+        for (int j = 0; j < 3; ++j) {
+            const float s = std::fabs(tB[j]) - (eb[j] + ea[0] * absR[0][j] + ea[1] * absR[1][j] + ea[2] * absR[2][j]);
+            if (s > 0.0f) return false;
+            if (s > faceBSep) { faceBSep = s; faceBAxis = j; }
+        }
+
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                XMFLOAT3 axis = Cross(a.axes[i], b.axes[j]);
+                const float len = std::sqrt(LengthSq(axis));
+                if (len < 1e-5f) continue;   // Parallel edges: covered by the face axes
+                axis = Scale(axis, 1.0f / len);
+
+                float ra = 0.0f, rb = 0.0f;
+                for (int k = 0; k < 3; ++k) {
+                    ra += ea[k] * std::fabs(Dot(a.axes[k], axis));
+                    rb += eb[k] * std::fabs(Dot(b.axes[k], axis));
+                }
+                const float dist = Dot(t, axis);
+                const float s = std::fabs(dist) - (ra + rb);
+                if (s > 0.0f) return false;
+                if (s > edgeSep) {
+                    edgeSep = s;
+                    edgeA = i;
+                    edgeB = j;
+                    edgeNormal = (dist >= 0.0f) ? axis : Scale(axis, -1.0f);
+                }
+            }
+        }
+
+        constexpr float relTol = 0.95f;
+        constexpr float absTol = 0.01f;
+        const bool referenceIsB = faceBSep > relTol * faceASep + absTol;
+        const float faceSep = referenceIsB ? faceBSep : faceASep;
+
+        if (edgeA >= 0 && edgeSep > relTol * faceSep + absTol)
+        {
+            // Supporting edge on each box along the contact normal
+            XMFLOAT3 pA = a.center, pB = b.center;
+            for (int k = 0; k < 3; ++k) {
+                if (k != edgeA) pA = MulAdd(pA, a.axes[k], Dot(a.axes[k], edgeNormal) >= 0.0f ? ea[k] : -ea[k]);
+                if (k != edgeB) pB = MulAdd(pB, b.axes[k], Dot(b.axes[k], edgeNormal) >= 0.0f ? -eb[k] : eb[k]);
+            }
+            const XMFLOAT3& dA = a.axes[edgeA];
+            const XMFLOAT3& dB = b.axes[edgeB];
+
+            // Closest points between the two edge segments
+            const XMFLOAT3 r = Sub(pA, pB);
+            const float bDot = Dot(dA, dB);
+            const float c = Dot(dA, r);
+            const float f = Dot(dB, r);
+            const float denom = 1.0f - bDot * bDot;
+            float s = (denom > 1e-6f) ? (bDot * f - c) / denom : 0.0f;
+            s = std::clamp(s, -ea[edgeA], ea[edgeA]);
+            float u = std::clamp(bDot * s + f, -eb[edgeB], eb[edgeB]);
+            s = std::clamp(bDot * u - c, -ea[edgeA], ea[edgeA]);
+
+            const XMFLOAT3 cpA = MulAdd(pA, dA, s);
+            const XMFLOAT3 cpB = MulAdd(pB, dB, u);
+            out.normal = edgeNormal;
+            out.Push(Scale(Add(cpA, cpB), 0.5f), -edgeSep, 0x40000000u | (static_cast<uint32_t>(edgeA) << 4) | static_cast<uint32_t>(edgeB));
+            return true;
+        }
+
+        // Face contact: reference face on one box, incident face on the other
+        const ShapePose& ref = referenceIsB ? b : a;
+        const ShapePose& inc = referenceIsB ? a : b;
+        const float* eRef = referenceIsB ? eb : ea;
+        const float* eInc = referenceIsB ? ea : eb;
+        const int refAxis = referenceIsB ? faceBAxis : faceAAxis;
+
+        // Reference normal points from the reference box towards the incident box
+        const float towards = referenceIsB ? -tB[refAxis] : tA[refAxis];
+        const float refSign = (towards >= 0.0f) ? 1.0f : -1.0f;
+        const XMFLOAT3 n = Scale(ref.axes[refAxis], refSign);
+
+        int incAxis = 0;
+        float incDot = 0.0f;
+        for (int j = 0; j < 3; ++j) {
+            const float dj = Dot(inc.axes[j], n);
+            if (std::fabs(dj) > std::fabs(incDot)) { incDot = dj; incAxis = j; }
+        }
+        const float incSign = (incDot > 0.0f) ? -1.0f : 1.0f;
+        const int k1 = (incAxis + 1) % 3, k2 = (incAxis + 2) % 3;
+        const XMFLOAT3 faceCenter = MulAdd(inc.center, inc.axes[incAxis], incSign * eInc[incAxis]);
+        const XMFLOAT3 u1 = Scale(inc.axes[k1], eInc[k1]);
+        const XMFLOAT3 u2 = Scale(inc.axes[k2], eInc[k2]);
+
+        XMFLOAT3 polyA[ContactOutput::Capacity], polyB[ContactOutput::Capacity];
+        uint32_t idsA[ContactOutput::Capacity], idsB[ContactOutput::Capacity];
+        polyA[0] = Add(Add(faceCenter, u1), u2);
+        polyA[1] = Add(Sub(faceCenter, u1), u2);
+        polyA[2] = Sub(Sub(faceCenter, u1), u2);
+        polyA[3] = Sub(Add(faceCenter, u1), u2);
+        for (uint32_t k = 0; k < 4; ++k) idsA[k] = k;
+        int count = 4;
+
+        // Clip against the four side planes of the reference face
+        const int s1 = (refAxis + 1) % 3, s2 = (refAxis + 2) % 3;
+        const XMFLOAT3 sideAxes[2] = { ref.axes[s1], ref.axes[s2] };
+        const float sideExtents[2] = { eRef[s1], eRef[s2] };
+        XMFLOAT3* src = polyA; uint32_t* srcIds = idsA;
+        XMFLOAT3* dst = polyB; uint32_t* dstIds = idsB;
+        uint32_t plane = 0;
+        for (int s = 0; s < 2 && count > 0; ++s) {
+            const float centerDist = Dot(ref.center, sideAxes[s]);
+            for (float dir = 1.0f; dir >= -1.0f && count > 0; dir -= 2.0f) {
+                const XMFLOAT3 planeNormal = Scale(sideAxes[s], dir);
+                count = ClipPolygon(src, srcIds, count, planeNormal, dir * centerDist + sideExtents[s] + ContactSkin, plane++, dst, dstIds);
+                std::swap(src, dst);
+                std::swap(srcIds, dstIds);
+            }
+        }
+
+        const float refOffset = Dot(ref.center, n) + eRef[refAxis];
+        const uint32_t refFace = static_cast<uint32_t>(refAxis * 2 + (refSign < 0.0f ? 1 : 0));
+        const uint32_t incFace = static_cast<uint32_t>(incAxis * 2 + (incSign < 0.0f ? 1 : 0));
+        const uint32_t featureBase = (referenceIsB ? 0x80000000u : 0u) | (refFace << 24) | (incFace << 16);
+
+        out.normal = referenceIsB ? Scale(n, -1.0f) : n;
+        for (int k = 0; k < count; ++k) {
+            const float separation = Dot(src[k], n) - refOffset;
+            if (separation <= ContactSkin) {
+                out.Push(MulAdd(src[k], n, -separation * 0.5f), -separation, featureBase | srcIds[k]);
+            }
+        }
+
+        ReduceContacts(out);
+        return out.count > 0;
+    }
+
+    // ------------------------------------------------------------------------
+    // Solver helpers
+    // ------------------------------------------------------------------------
+
+    void TangentBasis(const XMFLOAT3& n, XMFLOAT3& t0, XMFLOAT3& t1)
+    {
+        if (std::fabs(n.x) >= 0.57735f) {
+            t0 = Normalize(XMFLOAT3(n.y, -n.x, 0.0f), XMFLOAT3(0, 1, 0));
+        } else {
+            t0 = Normalize(XMFLOAT3(0.0f, n.z, -n.y), XMFLOAT3(1, 0, 0));
+        }
+        t1 = Cross(n, t0);
+    }
+
+    inline float EffectiveMass(float invMassA, float invMassB, const RigidBodyWorld::Mat3& invIA, const RigidBodyWorld::Mat3& invIB,
+                               const XMFLOAT3& rA, const XMFLOAT3& rB, const XMFLOAT3& axis)
+    {
+        const XMFLOAT3 rnA = Cross(rA, axis);
+        const XMFLOAT3 rnB = Cross(rB, axis);
+        const float k = invMassA + invMassB + Dot(rnA, Mul(invIA, rnA)) + Dot(rnB, Mul(invIB, rnB));
+        return (k > 0.0f) ? 1.0f / k : 0.0f;
+    }
+
+    float ElapsedMs(std::chrono::high_resolution_clock::time_point start)
+    {
+        return std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+}
+
+// ============================================================================
+// CONSTRUCTION AND BODY LIFETIME
+// ============================================================================
+
+RigidBodyWorld::RigidBodyWorld(const RigidBodyWorldSettings& settings)
+    : m_settings(settings)
+{
+}
+
+template<typename Func>
+void RigidBodyWorld::ForEachColumn(Func&& func)
+{
+    func(m_ids);
+    func(m_positions);
+    func(m_orientations);
+    func(m_linearVelocities);
+    func(m_angularVelocities);
+    func(m_forces);
+    func(m_torques);
+    func(m_masses);
+    func(m_inverseMasses);
+    func(m_inverseInertiaLocal);
+    func(m_inverseInertiaWorld);
+    func(m_linearDamping);
+    func(m_angularDamping);
+    func(m_friction);
+    func(m_restitution);
+    func(m_densities);
+    func(m_sleepTimes);
+    func(m_shapes);
+    func(m_motions);
+    func(m_flags);
+    func(m_groups);
+    func(m_masks);
+    func(m_proxies);
+    func(m_islands);
+    func(m_userData);
+}
+
+RigidBodyId RigidBodyWorld::CreateBody(const RigidBodyDef& def)
+{
+    RigidBodyId id;
+    if (!m_freeIds.empty()) {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    } else {
+        id = static_cast<RigidBodyId>(m_idToIndex.size());
+        m_idToIndex.push_back(InvalidIndex);
+    }
+
+    const uint32_t index = static_cast<uint32_t>(m_ids.size());
+    ForEachColumn([](auto& column) { column.emplace_back(); });
+    m_idToIndex[id] = index;
+
+    m_ids[index] = id;
+    m_positions[index] = def.position;
+    m_orientations[index] = QuatNormalize(def.orientation);
+    m_linearVelocities[index] = def.linearVelocity;
+    m_angularVelocities[index] = def.angularVelocity;
+    m_forces[index] = XMFLOAT3(0, 0, 0);
+    m_torques[index] = XMFLOAT3(0, 0, 0);
+    m_masses[index] = def.mass;
+    m_densities[index] = def.density;
+    m_linearDamping[index] = def.linearDamping;
+    m_angularDamping[index] = def.angularDamping;
+    m_friction[index] = def.friction;
+    m_restitution[index] = def.restitution;
+    m_sleepTimes[index] = 0.0f;
+    m_shapes[index] = def.shape;
+    m_motions[index] = def.motion;
+    m_flags[index] = static_cast<uint8_t>((def.isTrigger ? FlagTrigger : 0) | (def.allowSleep ? FlagAllowSleep : 0));
+    m_groups[index] = def.collisionGroup;
+    m_masks[index] = def.collisionMask;
+    m_islands[index] = NoIsland;
+    m_userData[index] = def.userData;
+
+    UpdateMassProperties(index);
+    UpdateWorldInertia(index);
+    m_proxies[index] = m_tree.CreateProxy(ComputeBounds(index), reinterpret_cast<void*>(static_cast<uintptr_t>(id)));
+
+    // Kinematic bodies always simulate; dynamic ones may start asleep
+    if (def.motion == RigidBodyMotion::Kinematic || (def.motion == RigidBodyMotion::Dynamic && def.startAwake)) {
+        MoveToAwake(index);
+    }
+    return id;
+}
+
+void RigidBodyWorld::DestroyBody(RigidBodyId id)
+{
+    uint32_t index = IndexOf(id);
+
+    // Anything resting on this body has to re-evaluate its support
+    if (m_islands[index] != NoIsland) {
+        WakeIsland(m_islands[index]);
+        index = IndexOf(id);
+    }
+    WakeTouching(m_tree.GetFatAABB(m_proxies[index]));
+    index = IndexOf(id);
+
+    RemoveManifoldsOf(id);
+    m_tree.DestroyProxy(m_proxies[index]);
+
+    if (index < m_awakeCount) {
+        SwapBodies(index, m_awakeCount - 1);
+        index = --m_awakeCount;
+    }
+    const uint32_t last = static_cast<uint32_t>(m_ids.size() - 1);
+    SwapBodies(index, last);
+    ForEachColumn([](auto& column) { column.pop_back(); });
+
+    m_idToIndex[id] = InvalidIndex;
+    m_freeIds.push_back(id);
+}
+
+void RigidBodyWorld::Clear()
+{
+    ForEachColumn([](auto& column) { column.clear(); });
+    m_idToIndex.clear();
+    m_freeIds.clear();
+    m_awakeCount = 0;
+    m_tree.Clear();
+    m_movingBodies.clear();
+    m_pairs.clear();
+    m_manifolds.clear();
+    m_previousManifolds.clear();
+    m_manifoldCache.Reset(0);
+    m_pairResults.clear();
+    m_constraints.clear();
+    m_constraintManifolds.clear();
+    m_sleepingIslands.clear();
+    m_freeIslands.clear();
+    m_events.clear();
+    m_movedBodies.clear();
+    m_stats = RigidBodyStepStats();
+}
+
+bool RigidBodyWorld::IsValid(RigidBodyId id) const
+{
+    return id < m_idToIndex.size() && m_idToIndex[id] != InvalidIndex;
+}
+
+uint32_t RigidBodyWorld::IndexOf(RigidBodyId id) const
+{
+    ASSERT_MSG(IsValid(id), "Invalid rigid body id %u", id);
+    return m_idToIndex[id];
+}
+
+void RigidBodyWorld::SwapBodies(uint32_t a, uint32_t b)
+{
+    if (a == b) return;
+    ForEachColumn([a, b](auto& column) { std::swap(column[a], column[b]); });
+    m_idToIndex[m_ids[a]] = a;
+    m_idToIndex[m_ids[b]] = b;
+}
+
+void RigidBodyWorld::MoveToAwake(uint32_t index)
+{
+    if (index >= m_awakeCount) {
+        SwapBodies(index, m_awakeCount);
+        ++m_awakeCount;
+    }
+}
+
+void RigidBodyWorld::MoveToAsleep(uint32_t index)
+{
+    if (index < m_awakeCount) {
+        --m_awakeCount;
+        SwapBodies(index, m_awakeCount);
+    }
+}
+
+// ============================================================================
+// BODY ACCESS
+// ============================================================================
+
+XMFLOAT3 RigidBodyWorld::GetPosition(RigidBodyId id) const
+{
+    return m_positions[IndexOf(id)];
+}
+
+XMFLOAT4 RigidBodyWorld::GetOrientation(RigidBodyId id) const
+{
+    return m_orientations[IndexOf(id)];
+}
+
+void RigidBodyWorld::SetTransform(RigidBodyId id, const XMFLOAT3& position, const XMFLOAT4& orientation)
+{
+    uint32_t index = IndexOf(id);
+
+    // Teleporting a body wakes whatever it leaves and whatever it lands in
+    WakeTouching(m_tree.GetFatAABB(m_proxies[index]));
+    index = IndexOf(id);
+
+    m_positions[index] = position;
+    m_orientations[index] = QuatNormalize(orientation);
+    UpdateWorldInertia(index);
+
+    const BoundingBox bounds = ComputeBounds(index);
+    m_tree.MoveProxy(m_proxies[index], bounds, XMFLOAT3(0, 0, 0));
+    WakeTouching(bounds);
+    WakeBody(IndexOf(id));
+}
+
+XMFLOAT3 RigidBodyWorld::GetLinearVelocity(RigidBodyId id) const
+{
+    return m_linearVelocities[IndexOf(id)];
+}
+
+void RigidBodyWorld::SetLinearVelocity(RigidBodyId id, const XMFLOAT3& velocity)
+{
+    const uint32_t index = IndexOf(id);
+    if (m_motions[index] == RigidBodyMotion::Static) return;
+    WakeBody(index);
+    m_linearVelocities[IndexOf(id)] = velocity;
+}
+
+XMFLOAT3 RigidBodyWorld::GetAngularVelocity(RigidBodyId id) const
+{
+    return m_angularVelocities[IndexOf(id)];
+}
+
+void RigidBodyWorld::SetAngularVelocity(RigidBodyId id, const XMFLOAT3& velocity)
+{
+    const uint32_t index = IndexOf(id);
+    if (m_motions[index] == RigidBodyMotion::Static) return;
+    WakeBody(index);
+    m_angularVelocities[IndexOf(id)] = velocity;
+}
+
+void RigidBodyWorld::ApplyForce(RigidBodyId id, const XMFLOAT3& force, const XMFLOAT3& relativePos)
+{
+    uint32_t index = IndexOf(id);
+    if (m_motions[index] != RigidBodyMotion::Dynamic) return;
+    WakeBody(index);
+    index = IndexOf(id);
+    m_forces[index] = Add(m_forces[index], force);
+    m_torques[index] = Add(m_torques[index], Cross(relativePos, force));
+}
+
+void RigidBodyWorld::ApplyImpulse(RigidBodyId id, const XMFLOAT3& impulse, const XMFLOAT3& relativePos)
+{
+    uint32_t index = IndexOf(id);
+    if (m_motions[index] != RigidBodyMotion::Dynamic) return;
+    WakeBody(index);
+    index = IndexOf(id);
+    m_linearVelocities[index] = MulAdd(m_linearVelocities[index], impulse, m_inverseMasses[index]);
+    m_angularVelocities[index] = Add(m_angularVelocities[index], Mul(m_inverseInertiaWorld[index], Cross(relativePos, impulse)));
+}
+
+void RigidBodyWorld::ApplyTorque(RigidBodyId id, const XMFLOAT3& torque)
+{
+    uint32_t index = IndexOf(id);
+    if (m_motions[index] != RigidBodyMotion::Dynamic) return;
+    WakeBody(index);
+    index = IndexOf(id);
+    m_torques[index] = Add(m_torques[index], torque);
+}
+
+void RigidBodyWorld::ApplyAngularImpulse(RigidBodyId id, const XMFLOAT3& impulse)
+{
+    uint32_t index = IndexOf(id);
+    if (m_motions[index] != RigidBodyMotion::Dynamic) return;
+    WakeBody(index);
+    index = IndexOf(id);
+    m_angularVelocities[index] = Add(m_angularVelocities[index], Mul(m_inverseInertiaWorld[index], impulse));
+}
+
+float RigidBodyWorld::GetMass(RigidBodyId id) const
+{
+    const uint32_t index = IndexOf(id);
+    return (m_motions[index] == RigidBodyMotion::Dynamic) ? m_masses[index] : 0.0f;
+}
+
+void RigidBodyWorld::SetMass(RigidBodyId id, float mass)
+{
+    const uint32_t index = IndexOf(id);
+    m_masses[index] = mass;
+    UpdateMassProperties(index);
+    UpdateWorldInertia(index);
+    WakeBody(index);
+}
+
+RigidBodyMotion RigidBodyWorld::GetMotion(RigidBodyId id) const
+{
+    return m_motions[IndexOf(id)];
+}
+
+void RigidBodyWorld::SetMotion(RigidBodyId id, RigidBodyMotion motion)
+{
+    uint32_t index = IndexOf(id);
+    if (m_motions[index] == motion) return;
+
+    if (m_islands[index] != NoIsland) {
+        WakeIsland(m_islands[index]);
+    }
+    WakeTouching(m_tree.GetFatAABB(m_proxies[IndexOf(id)]));
+    index = IndexOf(id);
+
+    m_motions[index] = motion;
+    UpdateMassProperties(index);
+    UpdateWorldInertia(index);
+    m_sleepTimes[index] = 0.0f;
+
+    if (motion == RigidBodyMotion::Static) {
+        m_linearVelocities[index] = XMFLOAT3(0, 0, 0);
+        m_angularVelocities[index] = XMFLOAT3(0, 0, 0);
+        MoveToAsleep(index);
+    } else {
+        MoveToAwake(index);
+    }
+}
+
+void RigidBodyWorld::SetMaterial(RigidBodyId id, float friction, float restitution, float linearDamping, float angularDamping)
+{
+    const uint32_t index = IndexOf(id);
+    m_friction[index] = friction;
+    m_restitution[index] = restitution;
+    m_linearDamping[index] = linearDamping;
+    m_angularDamping[index] = angularDamping;
+}
+
+void RigidBodyWorld::SetTrigger(RigidBodyId id, bool trigger)
+{
+    const uint32_t index = IndexOf(id);
+    if (trigger) m_flags[index] |= FlagTrigger;
+    else m_flags[index] &= static_cast<uint8_t>(~FlagTrigger);
+    WakeBody(index);
+}
+
+bool RigidBodyWorld::IsTrigger(RigidBodyId id) const
+{
+    return (m_flags[IndexOf(id)] & FlagTrigger) != 0;
+}
+
+void RigidBodyWorld::SetCollisionFilter(RigidBodyId id, uint16_t group, uint16_t mask)
+{
+    const uint32_t index = IndexOf(id);
+    m_groups[index] = group;
+    m_masks[index] = mask;
+    WakeBody(index);
+}
+
+void RigidBodyWorld::SetAwake(RigidBodyId id, bool awake)
+{
+    const uint32_t index = IndexOf(id);
+    if (awake) {
+        WakeBody(index);
+    } else if (index < m_awakeCount && m_motions[index] == RigidBodyMotion::Dynamic) {
+        // Request sleep; the island goes to sleep once every member agrees
+        m_sleepTimes[index] = m_settings.timeToSleep;
+        m_linearVelocities[index] = XMFLOAT3(0, 0, 0);
+        m_angularVelocities[index] = XMFLOAT3(0, 0, 0);
+    }
+}
+
+bool RigidBodyWorld::IsAwake(RigidBodyId id) const
+{
+    return IndexOf(id) < m_awakeCount;
+}
+
+void* RigidBodyWorld::GetUserData(RigidBodyId id) const
+{
+    return m_userData[IndexOf(id)];
+}
+
+void RigidBodyWorld::SetUserData(RigidBodyId id, void* userData)
+{
+    m_userData[IndexOf(id)] = userData;
+}
+
+BoundingBox RigidBodyWorld::GetWorldBounds(RigidBodyId id) const
+{
+    return ComputeBounds(IndexOf(id));
+}
+
+void RigidBodyWorld::SetGravity(const XMFLOAT3& gravity)
+{
+    m_settings.gravity = gravity;
+
+    // Resting piles need to feel the new gravity
+    for (uint32_t i = 0; i < m_sleepingIslands.size(); ++i) {
+        if (!m_sleepingIslands[i].bodies.empty()) WakeIsland(i);
+    }
+}
+
+// ============================================================================
+// MASS AND BOUNDS
+// ============================================================================
+
+void RigidBodyWorld::UpdateMassProperties(uint32_t index)
+{
+    if (m_motions[index] != RigidBodyMotion::Dynamic)
+    {
+        m_inverseMasses[index] = 0.0f;
+        m_inverseInertiaLocal[index] = XMFLOAT3(0, 0, 0);
+        return;
+    }
+
+    const RigidShape& shape = m_shapes[index];
+    const XMFLOAT3& e = shape.halfExtents;
+    const bool isSphere = shape.type == RigidShapeType::Sphere;
+    const float volume = isSphere ? (4.0f / 3.0f) * DirectX::XM_PI * shape.radius * shape.radius * shape.radius
+                                  : 8.0f * e.x * e.y * e.z;
+
+    float mass = m_masses[index];
+    if (mass <= 0.0f) {
+        mass = std::max(m_densities[index] * volume, 1e-3f);
+        m_masses[index] = mass;
+    }
+
+    XMFLOAT3 inertia;
+    if (isSphere) {
+        const float i = 0.4f * mass * shape.radius * shape.radius;
+        inertia = XMFLOAT3(i, i, i);
+    } else {
+        inertia = XMFLOAT3(mass / 3.0f * (e.y * e.y + e.z * e.z),
+                           mass / 3.0f * (e.x * e.x + e.z * e.z),
+                           mass / 3.0f * (e.x * e.x + e.y * e.y));
+    }
+
+    m_inverseMasses[index] = 1.0f / mass;
+    m_inverseInertiaLocal[index] = XMFLOAT3(inertia.x > 0.0f ? 1.0f / inertia.x : 0.0f,
+                                            inertia.y > 0.0f ? 1.0f / inertia.y : 0.0f,
+                                            inertia.z > 0.0f ? 1.0f / inertia.z : 0.0f);
+}
+
+void RigidBodyWorld::UpdateWorldInertia(uint32_t index)
+{
+    // I_world^-1 = R * diag(I_local^-1) * R^T
+    const XMFLOAT4& q = m_orientations[index];
+    const XMFLOAT3 axes[3] = { Rotate(q, XMFLOAT3(1, 0, 0)), Rotate(q, XMFLOAT3(0, 1, 0)), Rotate(q, XMFLOAT3(0, 0, 1)) };
+    const XMFLOAT3& d = m_inverseInertiaLocal[index];
+    const float diag[3] = { d.x, d.y, d.z };
+
+    XMFLOAT3 columns[3];
+    for (int c = 0; c < 3; ++c) {
+        XMFLOAT3 column(0, 0, 0);
+        for (int m = 0; m < 3; ++m) column = MulAdd(column, axes[m], diag[m] * Component(axes[m], c));
+        columns[c] = column;
+    }
+    m_inverseInertiaWorld[index] = Mat3{ columns[0], columns[1], columns[2] };
+}
+
+BoundingBox RigidBodyWorld::ComputeBounds(uint32_t index) const
+{
+    const RigidShape& shape = m_shapes[index];
+    const ShapePose pose = MakePose(m_positions[index], m_orientations[index], shape);
+
+    XMFLOAT3 extent;
+    if (shape.type == RigidShapeType::Sphere) {
+        extent = XMFLOAT3(shape.radius, shape.radius, shape.radius);
+    } else {
+        const XMFLOAT3& e = shape.halfExtents;
+        extent = XMFLOAT3(
+            e.x * std::fabs(pose.axes[0].x) + e.y * std::fabs(pose.axes[1].x) + e.z * std::fabs(pose.axes[2].x),
+            e.x * std::fabs(pose.axes[0].y) + e.y * std::fabs(pose.axes[1].y) + e.z * std::fabs(pose.axes[2].y),
+            e.x * std::fabs(pose.axes[0].z) + e.y * std::fabs(pose.axes[1].z) + e.z * std::fabs(pose.axes[2].z));
+    }
+    return BoundingBox(Sub(pose.center, extent), Add(pose.center, extent));
+}
+
+uint32_t RigidBodyWorld::GetAwakeBodyCount() const
+{
+    return m_awakeCount;
+}
+
+// ============================================================================
+// STEP
+// ============================================================================
+
+void RigidBodyWorld::Step(float dt)
+{
+    if (dt <= 0.0f) return;
+
+    const auto stepStart = std::chrono::high_resolution_clock::now();
+    m_events.clear();
+    m_movedBodies.clear();
+    m_stats = RigidBodyStepStats();
+
+    // Short substeps stiffen tall stacks far more cheaply than extra iterations
+    const int substeps = std::max(m_settings.substeps, 1);
+    const float h = dt / static_cast<float>(substeps);
+    for (int i = 0; i < substeps; ++i) Substep(h);
+
+    // A body that moved in several substeps is reported once
+    if (substeps > 1) {
+        std::sort(m_movedBodies.begin(), m_movedBodies.end());
+        m_movedBodies.erase(std::unique(m_movedBodies.begin(), m_movedBodies.end()), m_movedBodies.end());
+    }
+
+    m_stats.bodies = static_cast<uint32_t>(m_ids.size());
+    m_stats.awakeBodies = m_awakeCount;
+    m_stats.sleepingIslands = static_cast<uint32_t>(m_sleepingIslands.size() - m_freeIslands.size());
+    m_stats.manifolds = static_cast<uint32_t>(m_manifolds.size());
+    m_stats.threads = static_cast<uint32_t>(m_workerPool.GetThreadCount());
+    m_stats.totalMs = ElapsedMs(stepStart);
+}
+
+// ============================================================================
+// COLLISION
+// ============================================================================
+
+void RigidBodyWorld::Substep(float dt)
+{
+    auto phaseStart = std::chrono::high_resolution_clock::now();
+    FindPairs();
+    m_stats.broadphaseMs += ElapsedMs(phaseStart);
+
+    phaseStart = std::chrono::high_resolution_clock::now();
+    FinishContacts();
+    m_stats.narrowphaseMs += ElapsedMs(phaseStart);
+
+    phaseStart = std::chrono::high_resolution_clock::now();
+    IntegrateVelocities(dt);
+    PrepareContacts(dt);
+    if (m_settings.enableWarmStarting) WarmStart();
+    for (int i = 0; i < m_settings.velocityIterations; ++i) SolveVelocities(true);
+    m_stats.solverMs += ElapsedMs(phaseStart);
+
+    phaseStart = std::chrono::high_resolution_clock::now();
+    IntegratePositions(dt);
+    m_stats.integrateMs += ElapsedMs(phaseStart);
+
+    // Relax without the push-out bias so position correction does not leave kinetic energy behind
+    phaseStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < m_settings.relaxIterations; ++i) SolveVelocities(false);
+    StoreImpulses();
+    m_stats.solverMs += ElapsedMs(phaseStart);
+
+    phaseStart = std::chrono::high_resolution_clock::now();
+    SynchronizeBroadphase(dt);
+    UpdateSleep(dt);
+    m_stats.integrateMs += ElapsedMs(phaseStart);
+
+    for (RigidBodyId id : m_movingBodies) {
+        m_flags[m_idToIndex[id]] &= static_cast<uint8_t>(~FlagMoving);
+    }
+}
+
+uint64_t RigidBodyWorld::PairKey(RigidBodyId a, RigidBodyId b)
+{
+    return (static_cast<uint64_t>(std::min(a, b)) << 32) | static_cast<uint64_t>(std::max(a, b));
+}
+
+bool RigidBodyWorld::ShouldCollide(uint32_t indexA, uint32_t indexB) const
+{
+    if (m_shapes[indexA].type == RigidShapeType::QueryOnly || m_shapes[indexB].type == RigidShapeType::QueryOnly) {
+        return false;
+    }
+
+    const bool triggerA = (m_flags[indexA] & FlagTrigger) != 0;
+    const bool triggerB = (m_flags[indexB] & FlagTrigger) != 0;
+    if (triggerA && triggerB) return false;
+
+    // Two infinite-mass bodies only interact through triggers
+    if (!triggerA && !triggerB &&
+        m_motions[indexA] != RigidBodyMotion::Dynamic && m_motions[indexB] != RigidBodyMotion::Dynamic) {
+        return false;
+    }
+
+    return (m_groups[indexA] & m_masks[indexB]) != 0 && (m_groups[indexB] & m_masks[indexA]) != 0;
+}
+
+void RigidBodyWorld::FindPairs()
+{
+    m_movingBodies.clear();
+    m_pairs.clear();
+
+    for (uint32_t i = 0; i < m_awakeCount; ++i) {
+        if (m_shapes[i].type == RigidShapeType::QueryOnly) continue;
+        m_flags[i] |= FlagMoving;
+        m_movingBodies.push_back(m_ids[i]);
+    }
+
+    // Every moving body queries with its fat box. A pair of two moving bodies
+    // is reported only by the lower ID so each pair appears once. Each chunk
+    // of bodies fills its own list; joining the lists in chunk order keeps the
+    // pair order independent of the thread count.
+    const uint32_t movingCount = static_cast<uint32_t>(m_movingBodies.size());
+    const uint32_t chunkCount = (movingCount + BodyGrain - 1) / BodyGrain;
+    if (m_pairChunks.size() < chunkCount) m_pairChunks.resize(chunkCount);
+
+    m_workerPool.ParallelFor(movingCount, BodyGrain, [&](uint32_t begin, uint32_t end) {
+        auto& pairs = m_pairChunks[begin / BodyGrain];
+        pairs.clear();
+        for (uint32_t k = begin; k < end; ++k)
+        {
+            const RigidBodyId id = m_movingBodies[k];
+            const uint32_t i = m_idToIndex[id];
+            m_tree.Query(m_tree.GetFatAABB(m_proxies[i]), [&](int32_t proxyId) -> bool {
+                const auto otherId = static_cast<RigidBodyId>(reinterpret_cast<uintptr_t>(m_tree.GetUserData(proxyId)));
+                if (otherId == id) return true;
+
+                const uint32_t j = m_idToIndex[otherId];
+                if ((m_flags[j] & FlagMoving) && otherId < id) return true;
+                if (!ShouldCollide(i, j)) return true;
+
+                pairs.emplace_back(id, otherId);
+                return true;
+            });
+        }
+    });
+
+    for (uint32_t c = 0; c < chunkCount; ++c) {
+        m_pairs.insert(m_pairs.end(), m_pairChunks[c].begin(), m_pairChunks[c].end());
+    }
+
+    m_stats.candidatePairs = static_cast<uint32_t>(m_pairs.size());
+}
+
+void RigidBodyWorld::FinishContacts()
+{
+    // Last step's manifolds become the warm-start source for this step
+    m_previousManifolds.swap(m_manifolds);
+    m_manifolds.clear();
+    RebuildManifoldCache();
+
+    // Narrowphase in parallel; every pair writes only its own result slot.
+    // Resting pairs refresh their cached manifold instead of colliding again.
+    const uint32_t pairCount = static_cast<uint32_t>(m_pairs.size());
+    m_pairResults.resize(pairCount);
+    m_workerPool.ParallelFor(pairCount, PairGrain, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            const auto& pair = m_pairs[i];
+            PairResult& result = m_pairResults[i];
+            result.previous = m_manifoldCache.Find(PairKey(pair.first, pair.second));
+            const Manifold* previous = (result.previous != NoManifold) ? &m_previousManifolds[result.previous] : nullptr;
+
+            result.reused = previous && m_settings.enableManifoldReuse && RefreshManifold(*previous, result.manifold);
+            result.touching = result.reused ||
+                Collide(std::min(pair.first, pair.second), std::max(pair.first, pair.second), previous, result.manifold);
+        }
+    });
+
+    // Merge in pair order so manifolds, events and island wake-ups are deterministic
+    std::vector<uint8_t> consumed(m_previousManifolds.size(), 0);
+    uint32_t reused = 0;
+    for (const PairResult& result : m_pairResults)
+    {
+        if (!result.touching) continue;
+        const Manifold& m = result.manifold;
+        if (result.reused) ++reused;
+        if (result.previous != NoManifold) {
+            consumed[result.previous] = 1;
+        } else {
+            int deepest = 0;
+            for (int k = 1; k < m.pointCount; ++k) {
+                if (m.points[k].depth > m.points[deepest].depth) deepest = k;
+            }
+
+            RigidContactEvent event;
+            event.type = RigidContactEvent::Type::Begin;
+            event.isTrigger = m.isTrigger;
+            event.bodyA = m.bodyA;
+            event.bodyB = m.bodyB;
+            event.point = m.points[deepest].point;
+            event.normal = m.normal;
+            event.depth = m.points[deepest].depth;
+            m_events.push_back(event);
+        }
+
+        m_manifolds.push_back(m);
+
+        // A solid touch wakes a sleeping island (its manifolds join m_manifolds)
+        if (!m.isTrigger) {
+            const uint32_t islandA = m_islands[m_idToIndex[m.bodyA]];
+            if (islandA != NoIsland) WakeIsland(islandA);
+            const uint32_t islandB = m_islands[m_idToIndex[m.bodyB]];
+            if (islandB != NoIsland) WakeIsland(islandB);
+        }
+    }
+
+    // Pairs nobody searched this step (both bodies asleep or static) persist
+    // untouched; the rest stopped touching.
+    for (size_t i = 0; i < m_previousManifolds.size(); ++i)
+    {
+        if (consumed[i]) continue;
+        const Manifold& m = m_previousManifolds[i];
+        if (m.bodyA == InvalidRigidBodyId) continue;
+
+        const bool movingA = (m_flags[m_idToIndex[m.bodyA]] & FlagMoving) != 0;
+        const bool movingB = (m_flags[m_idToIndex[m.bodyB]] & FlagMoving) != 0;
+        if (!movingA && !movingB) {
+            m_manifolds.push_back(m);
+            continue;
+        }
+
+        RigidContactEvent event;
+        event.type = RigidContactEvent::Type::End;
+        event.isTrigger = m.isTrigger;
+        event.bodyA = m.bodyA;
+        event.bodyB = m.bodyB;
+        m_events.push_back(event);
+    }
+
+    uint32_t points = 0, warmStarted = 0;
+    for (const Manifold& m : m_manifolds)
+    {
+        if (m.isTrigger) continue;
+        points += static_cast<uint32_t>(m.pointCount);
+        for (int k = 0; k < m.pointCount; ++k) {
+            if (m.points[k].normalImpulse != 0.0f) ++warmStarted;
+        }
+    }
+    m_stats.contactPoints = points;
+    m_stats.reusedManifolds = reused;
+    m_stats.warmStartedPoints = warmStarted;
+}
+
+bool RigidBodyWorld::Collide(RigidBodyId idA, RigidBodyId idB, const Manifold* previous, Manifold& m) const
+{
+    const uint32_t a = m_idToIndex[idA];
+    const uint32_t b = m_idToIndex[idB];
+    const RigidShape& shapeA = m_shapes[a];
+    const RigidShape& shapeB = m_shapes[b];
+    const ShapePose poseA = MakePose(m_positions[a], m_orientations[a], shapeA);
+    const ShapePose poseB = MakePose(m_positions[b], m_orientations[b], shapeB);
+
+    ContactOutput out;
+    bool hit = false;
+    if (shapeA.type == RigidShapeType::Sphere && shapeB.type == RigidShapeType::Sphere) {
+        hit = CollideSpheres(poseA.center, shapeA.radius, poseB.center, shapeB.radius, out);
+    } else if (shapeA.type == RigidShapeType::Box && shapeB.type == RigidShapeType::Sphere) {
+        hit = CollideBoxSphere(poseA, shapeA.halfExtents, poseB.center, shapeB.radius, out);
+    } else if (shapeA.type == RigidShapeType::Sphere && shapeB.type == RigidShapeType::Box) {
+        hit = CollideBoxSphere(poseB, shapeB.halfExtents, poseA.center, shapeA.radius, out);
+        out.normal = Scale(out.normal, -1.0f);
+    } else {
+        hit = CollideBoxes(poseA, shapeA.halfExtents, poseB, shapeB.halfExtents, out);
+    }
+    if (!hit || out.count == 0) return false;
+
+    const XMFLOAT4 inverseA = QuatConjugate(m_orientations[a]);
+    const XMFLOAT4 inverseB = QuatConjugate(m_orientations[b]);
+
+    m.key = PairKey(idA, idB);
+    m.bodyA = idA;
+    m.bodyB = idB;
+    m.normal = out.normal;
+    m.localNormal = Rotate(inverseA, out.normal);
+    m.relativePosition = Rotate(inverseA, Sub(m_positions[b], m_positions[a]));
+    m.relativeOrientation = QuatMul(inverseA, m_orientations[b]);
+    m.friction = std::sqrt(m_friction[a] * m_friction[b]);
+    m.restitution = std::max(m_restitution[a], m_restitution[b]);
+    m.isTrigger = ((m_flags[a] | m_flags[b]) & FlagTrigger) != 0;
+    m.pointCount = std::min(out.count, 4);
+
+    for (int k = 0; k < m.pointCount; ++k)
+    {
+        ManifoldPoint& p = m.points[k];
+        p.point = out.points[k];
+        p.depth = out.depths[k];
+        p.feature = out.features[k];
+        p.localA = Rotate(inverseA, Sub(MulAdd(p.point, out.normal, p.depth * 0.5f), m_positions[a]));
+        p.localB = Rotate(inverseB, Sub(MulAdd(p.point, out.normal, -p.depth * 0.5f), m_positions[b]));
+        p.normalImpulse = 0.0f;
+        p.tangentImpulse[0] = p.tangentImpulse[1] = 0.0f;
+    }
+
+    if (previous && m_settings.enableWarmStarting) MatchContacts(*previous, m);
+    return true;
+}
+
+bool RigidBodyWorld::RefreshManifold(const Manifold& previous, Manifold& m) const
+{
+    const uint32_t a = m_idToIndex[previous.bodyA];
+    const uint32_t b = m_idToIndex[previous.bodyB];
+    const XMFLOAT4& qA = m_orientations[a];
+    const XMFLOAT4& qB = m_orientations[b];
+    const XMFLOAT4 inverseA = QuatConjugate(qA);
+
+    // Only reuse while B sits where it was, relative to A, when the points were generated
+    const XMFLOAT3 relativePosition = Rotate(inverseA, Sub(m_positions[b], m_positions[a]));
+    const float maxDistance = m_settings.manifoldReuseDistance;
+    if (LengthSq(Sub(relativePosition, previous.relativePosition)) > maxDistance * maxDistance) return false;
+
+    const XMFLOAT4 relativeOrientation = QuatMul(inverseA, qB);
+    const XMFLOAT4& q0 = previous.relativeOrientation;
+    const float cosHalfAngle = std::fabs(relativeOrientation.x * q0.x + relativeOrientation.y * q0.y +
+                                         relativeOrientation.z * q0.z + relativeOrientation.w * q0.w);
+    if (cosHalfAngle < std::cos(m_settings.manifoldReuseAngle * 0.5f)) return false;
+
+    // Rebuild every point from its body-local anchors; drop points that slid or separated
+    m = previous;
+    m.normal = Rotate(qA, previous.localNormal);
+    m.friction = std::sqrt(m_friction[a] * m_friction[b]);
+    m.restitution = std::max(m_restitution[a], m_restitution[b]);
+    m.isTrigger = ((m_flags[a] | m_flags[b]) & FlagTrigger) != 0;
+    m.pointCount = 0;
+    const float maxSlide = m_settings.contactMatchDistance;
+    for (int k = 0; k < previous.pointCount; ++k)
+    {
+        const ManifoldPoint& cached = previous.points[k];
+        const XMFLOAT3 pointA = Add(m_positions[a], Rotate(qA, cached.localA));
+        const XMFLOAT3 pointB = Add(m_positions[b], Rotate(qB, cached.localB));
+        const XMFLOAT3 delta = Sub(pointA, pointB);
+        const float depth = Dot(delta, m.normal);
+        if (depth < -ContactSkin) continue;
+        if (LengthSq(MulAdd(delta, m.normal, -depth)) > maxSlide * maxSlide) continue;
+
+        ManifoldPoint& p = m.points[m.pointCount++];
+        p = cached;
+        p.point = Scale(Add(pointA, pointB), 0.5f);
+        p.depth = depth;
+        if (!m_settings.enableWarmStarting) {
+            p.normalImpulse = 0.0f;
+            p.tangentImpulse[0] = p.tangentImpulse[1] = 0.0f;
+        }
+    }
+    return m.pointCount > 0;
+}
+
+void RigidBodyWorld::MatchContacts(const Manifold& previous, Manifold& current) const
+{
+    auto inherit = [](ManifoldPoint& p, const ManifoldPoint& from) {
+        p.normalImpulse = from.normalImpulse;
+        p.tangentImpulse[0] = from.tangentImpulse[0];
+        p.tangentImpulse[1] = from.tangentImpulse[1];
+    };
+
+    bool matched[4] = {};
+    bool used[4] = {};
+
+    // Same feature pair: the same contact even if it moved
+    for (int k = 0; k < current.pointCount; ++k) {
+        for (int j = 0; j < previous.pointCount; ++j) {
+            if (!used[j] && previous.points[j].feature == current.points[k].feature) {
+                inherit(current.points[k], previous.points[j]);
+                matched[k] = used[j] = true;
+                break;
+            }
+        }
+    }
+
+    // Feature IDs change when clipping picks a different edge for the same
+    // corner; fall back to the closest unclaimed point in A's frame, but only
+    // while the normal is unchanged so the impulses still point the right way
+    if (Dot(current.localNormal, previous.localNormal) < 0.95f) return;
+    const float maxDistanceSq = m_settings.contactMatchDistance * m_settings.contactMatchDistance;
+    for (int k = 0; k < current.pointCount; ++k)
+    {
+        if (matched[k]) continue;
+        int best = -1;
+        float bestDistanceSq = maxDistanceSq;
+        for (int j = 0; j < previous.pointCount; ++j) {
+            if (used[j]) continue;
+            const float distanceSq = LengthSq(Sub(current.points[k].localA, previous.points[j].localA));
+            if (distanceSq <= bestDistanceSq) {
+                bestDistanceSq = distanceSq;
+                best = j;
+            }
+        }
+        if (best >= 0) {
+            inherit(current.points[k], previous.points[best]);
+            matched[k] = used[best] = true;
+        }
+    }
+}
+
+void RigidBodyWorld::RemoveManifoldsOf(RigidBodyId id)
+{
+    m_manifolds.erase(std::remove_if(m_manifolds.begin(), m_manifolds.end(),
+        [id](const Manifold& m) { return m.bodyA == id || m.bodyB == id; }), m_manifolds.end());
+}
+
+void RigidBodyWorld::RebuildManifoldCache()
+{
+    m_manifoldCache.Reset(static_cast<uint32_t>(m_previousManifolds.size()));
+    for (uint32_t i = 0; i < m_previousManifolds.size(); ++i) {
+        m_manifoldCache.Insert(m_previousManifolds[i].key, i);
+    }
+}
+
+// ============================================================================
+// SOLVER
+// ============================================================================
+
+void RigidBodyWorld::IntegrateVelocities(float dt)
+{
+    const XMFLOAT3 gravity = m_settings.gravity;
+
+    m_workerPool.ParallelFor(m_awakeCount, BodyGrain, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            if (m_motions[i] != RigidBodyMotion::Dynamic) continue;
+
+            XMFLOAT3 v = m_linearVelocities[i];
+            XMFLOAT3 w = m_angularVelocities[i];
+            v = MulAdd(v, Add(gravity, Scale(m_forces[i], m_inverseMasses[i])), dt);
+            w = MulAdd(w, Mul(m_inverseInertiaWorld[i], m_torques[i]), dt);
+
+            // Pade approximation of exp(-c dt); stable for any damping
+            m_linearVelocities[i] = Scale(v, 1.0f / (1.0f + dt * m_linearDamping[i]));
+            m_angularVelocities[i] = Scale(w, 1.0f / (1.0f + dt * m_angularDamping[i]));
+            m_forces[i] = XMFLOAT3(0, 0, 0);
+            m_torques[i] = XMFLOAT3(0, 0, 0);
+        }
+    });
+}
+
+void RigidBodyWorld::PrepareContacts(float dt)
+{
+    ColorConstraints();
+    const float inverseDt = 1.0f / dt;
+
+    // Soft contact (mass-spring-damper) coefficients. The stiffness is capped at a quarter
+    // of the substep rate so the implicit spring never outruns the integrator.
+    const float hertz = std::min(m_settings.contactHertz, 0.25f * inverseDt);
+    const float omega = 2.0f * DirectX::XM_PI * hertz;
+    const float zeta = m_settings.contactDampingRatio;
+    const float a1 = 2.0f * zeta + dt * omega;
+    const float a2 = dt * omega * a1;
+    const float biasRate = omega / a1;
+    const float massScale = a2 / (1.0f + a2);
+    const float impulseScale = 1.0f / (1.0f + a2);
+
+    auto prepare = [&](uint32_t slot)
+    {
+        const uint32_t mi = m_constraintManifolds[slot];
+        const Manifold& m = m_manifolds[mi];
+        const uint32_t a = m_idToIndex[m.bodyA];
+        const uint32_t b = m_idToIndex[m.bodyB];
+
+        ContactConstraint& c = m_constraints[slot];
+        c.indexA = a;
+        c.indexB = b;
+        c.manifold = mi;
+        c.normal = m.normal;
+        TangentBasis(m.normal, c.tangent[0], c.tangent[1]);
+        c.friction = m.friction;
+        c.massScale = massScale;
+        c.impulseScale = impulseScale;
+        c.pointCount = m.pointCount;
+
+        const float invMassA = m_inverseMasses[a], invMassB = m_inverseMasses[b];
+        const Mat3& invIA = m_inverseInertiaWorld[a];
+        const Mat3& invIB = m_inverseInertiaWorld[b];
+        const XMFLOAT3 vA = m_linearVelocities[a], wA = m_angularVelocities[a];
+        const XMFLOAT3 vB = m_linearVelocities[b], wB = m_angularVelocities[b];
+
+        for (int k = 0; k < m.pointCount; ++k)
+        {
+            const ManifoldPoint& mp = m.points[k];
+            ContactConstraintPoint& cp = c.points[k];
+            cp.rA = Sub(mp.point, m_positions[a]);
+            cp.rB = Sub(mp.point, m_positions[b]);
+            cp.normalMass = EffectiveMass(invMassA, invMassB, invIA, invIB, cp.rA, cp.rB, c.normal);
+            cp.tangentMass[0] = EffectiveMass(invMassA, invMassB, invIA, invIB, cp.rA, cp.rB, c.tangent[0]);
+            cp.tangentMass[1] = EffectiveMass(invMassA, invMassB, invIA, invIB, cp.rA, cp.rB, c.tangent[1]);
+            cp.normalImpulse = m_settings.enableWarmStarting ? mp.normalImpulse : 0.0f;
+            cp.tangentImpulse[0] = m_settings.enableWarmStarting ? mp.tangentImpulse[0] : 0.0f;
+            cp.tangentImpulse[1] = m_settings.enableWarmStarting ? mp.tangentImpulse[1] : 0.0f;
+
+            // Target separating velocity. Points still apart (beyond the slop) are speculative
+            // and only stop the approach that would close the gap; penetrating points are
+            // pushed out softly in the biased pass and held at rest in the relax pass.
+            const float separation = m_settings.linearSlop - mp.depth;
+            if (separation > 0.0f) {
+                cp.biasedTarget = cp.relaxTarget = -separation * inverseDt;
+            } else {
+                cp.biasedTarget = std::min(-biasRate * separation, m_settings.maxCorrectionVelocity);
+                cp.relaxTarget = 0.0f;
+
+                // Restitution from the approach speed before the solve
+                const XMFLOAT3 dv = Sub(Add(vB, Cross(wB, cp.rB)), Add(vA, Cross(wA, cp.rA)));
+                const float vn = Dot(dv, c.normal);
+                if (vn < -m_settings.restitutionThreshold) cp.relaxTarget = -m.restitution * vn;
+            }
+        }
+    };
+
+    m_workerPool.ParallelFor(static_cast<uint32_t>(m_constraints.size()), ConstraintGrain, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t slot = begin; slot < end; ++slot) prepare(slot);
+    });
+}
+
+void RigidBodyWorld::ColorConstraints()
+{
+    // Greedy graph colouring: each contact takes the first colour in which
+    // neither of its dynamic bodies is already claimed. Static and kinematic
+    // bodies are never written by the solver, so they do not block a colour.
+    // Contacts that fit nowhere land in the overflow colour, solved serially.
+    const uint32_t bodyWords = (static_cast<uint32_t>(m_ids.size()) + 63) / 64;
+    m_colorBodyMasks.assign(static_cast<size_t>(ConstraintColorCount) * bodyWords, 0);
+    m_colorStarts.assign(ConstraintColorCount + 2, 0);
+    m_constraintManifolds.clear();
+
+    std::vector<uint8_t>& colors = m_constraintColors;
+    colors.clear();
+
+    for (uint32_t mi = 0; mi < m_manifolds.size(); ++mi)
+    {
+        const Manifold& m = m_manifolds[mi];
+        if (m.isTrigger) continue;
+
+        const uint32_t a = m_idToIndex[m.bodyA];
+        const uint32_t b = m_idToIndex[m.bodyB];
+        if (a >= m_awakeCount && b >= m_awakeCount) continue;
+        if (m_inverseMasses[a] == 0.0f && m_inverseMasses[b] == 0.0f) continue;
+
+        const bool dynamicA = m_inverseMasses[a] > 0.0f;
+        const bool dynamicB = m_inverseMasses[b] > 0.0f;
+        const uint64_t bitA = 1ull << (a & 63), bitB = 1ull << (b & 63);
+
+        uint32_t color = ConstraintColorCount;
+        for (uint32_t k = 0; k < ConstraintColorCount; ++k)
+        {
+            uint64_t* mask = &m_colorBodyMasks[static_cast<size_t>(k) * bodyWords];
+            if ((dynamicA && (mask[a >> 6] & bitA)) || (dynamicB && (mask[b >> 6] & bitB))) continue;
+            if (dynamicA) mask[a >> 6] |= bitA;
+            if (dynamicB) mask[b >> 6] |= bitB;
+            color = k;
+            break;
+        }
+
+        m_constraintManifolds.push_back(mi);
+        colors.push_back(static_cast<uint8_t>(color));
+        ++m_colorStarts[color + 1];
+    }
+
+    // Counting sort into colour-major slots, keeping manifold order inside a colour
+    for (uint32_t k = 1; k < m_colorStarts.size(); ++k) m_colorStarts[k] += m_colorStarts[k - 1];
+
+    const uint32_t count = static_cast<uint32_t>(m_constraintManifolds.size());
+    std::vector<uint32_t>& sorted = m_constraintSortScratch;
+    sorted.resize(count);
+    std::vector<uint32_t> cursor(m_colorStarts.begin(), m_colorStarts.end() - 1);
+    for (uint32_t i = 0; i < count; ++i) sorted[cursor[colors[i]]++] = m_constraintManifolds[i];
+    m_constraintManifolds.swap(sorted);
+    m_constraints.resize(count);
+
+    uint32_t used = 0;
+    for (uint32_t k = 0; k < ConstraintColorCount; ++k) {
+        if (m_colorStarts[k + 1] > m_colorStarts[k]) ++used;
+    }
+    m_stats.constraintColors = used;
+    m_stats.overflowConstraints += m_colorStarts[ConstraintColorCount + 1] - m_colorStarts[ConstraintColorCount];
+}
+
+void RigidBodyWorld::WarmStart()
+{
+    for (uint32_t color = 0; color <= ConstraintColorCount; ++color)
+    {
+        const uint32_t first = m_colorStarts[color];
+        const uint32_t count = m_colorStarts[color + 1] - first;
+        const uint32_t grain = (color == ConstraintColorCount) ? count : ConstraintGrain;
+        m_workerPool.ParallelFor(count, grain, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = first + begin; i < first + end; ++i) WarmStartConstraint(m_constraints[i]);
+        });
+    }
+}
+
+void RigidBodyWorld::SolveVelocities(bool useBias)
+{
+    // Colours run one after another; the constraints inside a colour touch
+    // disjoint dynamic bodies and run in parallel
+    for (uint32_t color = 0; color <= ConstraintColorCount; ++color)
+    {
+        const uint32_t first = m_colorStarts[color];
+        const uint32_t count = m_colorStarts[color + 1] - first;
+        const uint32_t grain = (color == ConstraintColorCount) ? count : ConstraintGrain;
+        m_workerPool.ParallelFor(count, grain, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = first + begin; i < first + end; ++i) SolveConstraint(m_constraints[i], useBias);
+        });
+    }
+}
+
+void RigidBodyWorld::WarmStartConstraint(const ContactConstraint& c)
+{
+    const uint32_t a = c.indexA, b = c.indexB;
+    XMFLOAT3 vA = m_linearVelocities[a], wA = m_angularVelocities[a];
+    XMFLOAT3 vB = m_linearVelocities[b], wB = m_angularVelocities[b];
+
+    for (int k = 0; k < c.pointCount; ++k)
+    {
+        const ContactConstraintPoint& cp = c.points[k];
+        XMFLOAT3 P = Scale(c.normal, cp.normalImpulse);
+        P = MulAdd(P, c.tangent[0], cp.tangentImpulse[0]);
+        P = MulAdd(P, c.tangent[1], cp.tangentImpulse[1]);
+
+        vA = MulAdd(vA, P, -m_inverseMasses[a]);
+        wA = Sub(wA, Mul(m_inverseInertiaWorld[a], Cross(cp.rA, P)));
+        vB = MulAdd(vB, P, m_inverseMasses[b]);
+        wB = Add(wB, Mul(m_inverseInertiaWorld[b], Cross(cp.rB, P)));
+    }
+
+    // Bodies of infinite mass may be shared across a colour; never write them
+    if (m_inverseMasses[a] > 0.0f) {
+        m_linearVelocities[a] = vA;
+        m_angularVelocities[a] = wA;
+    }
+    if (m_inverseMasses[b] > 0.0f) {
+        m_linearVelocities[b] = vB;
+        m_angularVelocities[b] = wB;
+    }
+}
+
+void RigidBodyWorld::SolveConstraint(ContactConstraint& c, bool useBias)
+{
+    const uint32_t a = c.indexA, b = c.indexB;
+    const float invMassA = m_inverseMasses[a], invMassB = m_inverseMasses[b];
+    const Mat3& invIA = m_inverseInertiaWorld[a];
+    const Mat3& invIB = m_inverseInertiaWorld[b];
+    const float massScale = useBias ? c.massScale : 1.0f;
+    const float impulseScale = useBias ? c.impulseScale : 0.0f;
+    XMFLOAT3 vA = m_linearVelocities[a], wA = m_angularVelocities[a];
+    XMFLOAT3 vB = m_linearVelocities[b], wB = m_angularVelocities[b];
+
+    auto applyImpulse = [&](const ContactConstraintPoint& cp, const XMFLOAT3& P) {
+        vA = MulAdd(vA, P, -invMassA);
+        wA = Sub(wA, Mul(invIA, Cross(cp.rA, P)));
+        vB = MulAdd(vB, P, invMassB);
+        wB = Add(wB, Mul(invIB, Cross(cp.rB, P)));
+    };
+
+    // Friction first so the normal impulse has the final say on penetration
+    for (int k = 0; k < c.pointCount; ++k)
+    {
+        ContactConstraintPoint& cp = c.points[k];
+        const float maxFriction = c.friction * cp.normalImpulse;
+        for (int t = 0; t < 2; ++t)
+        {
+            const XMFLOAT3 dv = Sub(Add(vB, Cross(wB, cp.rB)), Add(vA, Cross(wA, cp.rA)));
+            const float lambda = -cp.tangentMass[t] * Dot(dv, c.tangent[t]);
+            const float newImpulse = std::clamp(cp.tangentImpulse[t] + lambda, -maxFriction, maxFriction);
+            const float delta = newImpulse - cp.tangentImpulse[t];
+            cp.tangentImpulse[t] = newImpulse;
+            applyImpulse(cp, Scale(c.tangent[t], delta));
+        }
+    }
+
+    for (int k = 0; k < c.pointCount; ++k)
+    {
+        ContactConstraintPoint& cp = c.points[k];
+        const XMFLOAT3 dv = Sub(Add(vB, Cross(wB, cp.rB)), Add(vA, Cross(wA, cp.rA)));
+        const float vn = Dot(dv, c.normal);
+        const float target = useBias ? cp.biasedTarget : cp.relaxTarget;
+        const float lambda = -cp.normalMass * massScale * (vn - target) - impulseScale * cp.normalImpulse;
+        const float newImpulse = std::max(cp.normalImpulse + lambda, 0.0f);
+        const float delta = newImpulse - cp.normalImpulse;
+        cp.normalImpulse = newImpulse;
+        applyImpulse(cp, Scale(c.normal, delta));
+    }
+
+    if (invMassA > 0.0f) {
+        m_linearVelocities[a] = vA;
+        m_angularVelocities[a] = wA;
+    }
+    if (invMassB > 0.0f) {
+        m_linearVelocities[b] = vB;
+        m_angularVelocities[b] = wB;
+    }
+}
+
+void RigidBodyWorld::StoreImpulses()
+{
+    m_workerPool.ParallelFor(static_cast<uint32_t>(m_constraints.size()), ConstraintGrain, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            const ContactConstraint& c = m_constraints[i];
+            Manifold& m = m_manifolds[c.manifold];
+            for (int k = 0; k < c.pointCount; ++k) {
+                m.points[k].normalImpulse = c.points[k].normalImpulse;
+                m.points[k].tangentImpulse[0] = c.points[k].tangentImpulse[0];
+                m.points[k].tangentImpulse[1] = c.points[k].tangentImpulse[1];
+            }
+        }
+    });
+}
+
+// ============================================================================
+// INTEGRATION AND BROADPHASE
+// ============================================================================
+
+void RigidBodyWorld::IntegratePositions(float dt)
+{
+    const float maxTranslation = m_settings.maxTranslationPerStep;
+    const float maxRotation = m_settings.maxRotationPerStep;
+
+    m_workerPool.ParallelFor(m_awakeCount, BodyGrain, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            XMFLOAT3& v = m_linearVelocities[i];
+            XMFLOAT3& w = m_angularVelocities[i];
+
+            // Clamp extreme velocities so a single bad contact cannot explode a body
+            const float translationSq = LengthSq(v) * dt * dt;
+            if (translationSq > maxTranslation * maxTranslation) v = Scale(v, maxTranslation / std::sqrt(translationSq));
+            const float rotationSq = LengthSq(w) * dt * dt;
+            if (rotationSq > maxRotation * maxRotation) w = Scale(w, maxRotation / std::sqrt(rotationSq));
+
+            m_positions[i] = MulAdd(m_positions[i], v, dt);
+
+            // q' = q + 0.5 * dt * (w, 0) * q
+            const XMFLOAT4& q = m_orientations[i];
+            const XMFLOAT4 spin = QuatMul(XMFLOAT4(w.x, w.y, w.z, 0.0f), q);
+            const float h = 0.5f * dt;
+            m_orientations[i] = QuatNormalize(XMFLOAT4(q.x + spin.x * h, q.y + spin.y * h, q.z + spin.z * h, q.w + spin.w * h));
+
+            if (m_motions[i] == RigidBodyMotion::Dynamic) UpdateWorldInertia(i);
+        }
+    });
+}
+
+void RigidBodyWorld::SynchronizeBroadphase(float dt)
+{
+    for (uint32_t i = 0; i < m_awakeCount; ++i)
+    {
+        m_tree.MoveProxy(m_proxies[i], ComputeBounds(i), Scale(m_linearVelocities[i], dt));
+        m_movedBodies.push_back(m_ids[i]);
+    }
+}
+
+// ============================================================================
+// ISLANDS AND SLEEPING
+// ============================================================================
+
+void RigidBodyWorld::UpdateSleep(float dt)
+{
+    m_stats.islands = 0;
+    const uint32_t awake = m_awakeCount;
+    const float linTolSq = m_settings.sleepLinearVelocity * m_settings.sleepLinearVelocity;
+    const float angTolSq = m_settings.sleepAngularVelocity * m_settings.sleepAngularVelocity;
+
+    for (uint32_t i = 0; i < awake; ++i)
+    {
+        if (m_motions[i] != RigidBodyMotion::Dynamic || !(m_flags[i] & FlagAllowSleep) || !m_settings.enableSleeping ||
+            LengthSq(m_linearVelocities[i]) > linTolSq || LengthSq(m_angularVelocities[i]) > angTolSq) {
+            m_sleepTimes[i] = 0.0f;
+        } else {
+            m_sleepTimes[i] += dt;
+        }
+    }
+
+    // Union-find over solid contacts between awake dynamic bodies. Statics do
+    // not join islands; touching a kinematic body keeps an island awake.
+    std::vector<uint32_t>& parent = m_unionParent;
+    parent.resize(awake);
+    for (uint32_t i = 0; i < awake; ++i) parent[i] = i;
+
+    auto find = [&parent](uint32_t i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+
+    for (const Manifold& m : m_manifolds)
+    {
+        if (m.isTrigger) continue;
+        const uint32_t a = m_idToIndex[m.bodyA];
+        const uint32_t b = m_idToIndex[m.bodyB];
+        const bool dynamicA = a < awake && m_motions[a] == RigidBodyMotion::Dynamic;
+        const bool dynamicB = b < awake && m_motions[b] == RigidBodyMotion::Dynamic;
+
+        if (dynamicA && dynamicB) {
+            const uint32_t ra = find(a), rb = find(b);
+            if (ra != rb) parent[std::max(ra, rb)] = std::min(ra, rb);
+        } else if (dynamicA && m_motions[b] == RigidBodyMotion::Kinematic) {
+            m_sleepTimes[a] = 0.0f;
+        } else if (dynamicB && m_motions[a] == RigidBodyMotion::Kinematic) {
+            m_sleepTimes[b] = 0.0f;
+        }
+    }
+
+    // Islands whose slowest member has rested long enough go to sleep together
+    std::vector<float> islandTime(awake, FLT_MAX);
+    for (uint32_t i = 0; i < awake; ++i) {
+        if (m_motions[i] != RigidBodyMotion::Dynamic) continue;
+        const uint32_t root = find(i);
+        islandTime[root] = std::min(islandTime[root], m_sleepTimes[i]);
+        if (root == i) ++m_stats.islands;
+    }
+
+    if (!m_settings.enableSleeping) return;
+
+    std::vector<uint32_t> bodyIsland(awake, NoIsland);
+    std::vector<uint32_t> rootIsland(awake, NoIsland);
+    std::vector<uint32_t> newIslands;
+    for (uint32_t i = 0; i < awake; ++i)
+    {
+        if (m_motions[i] != RigidBodyMotion::Dynamic) continue;
+        const uint32_t root = find(i);
+        if (islandTime[root] < m_settings.timeToSleep) continue;
+
+        if (rootIsland[root] == NoIsland) {
+            uint32_t slot;
+            if (!m_freeIslands.empty()) {
+                slot = m_freeIslands.back();
+                m_freeIslands.pop_back();
+            } else {
+                slot = static_cast<uint32_t>(m_sleepingIslands.size());
+                m_sleepingIslands.emplace_back();
+            }
+            rootIsland[root] = slot;
+            newIslands.push_back(slot);
+        }
+        bodyIsland[i] = rootIsland[root];
+        m_sleepingIslands[bodyIsland[i]].bodies.push_back(m_ids[i]);
+    }
+    if (newIslands.empty()) return;
+
+    // Solid manifolds of sleeping islands move out of the per-step list
+    size_t write = 0;
+    for (size_t r = 0; r < m_manifolds.size(); ++r)
+    {
+        const Manifold& m = m_manifolds[r];
+        uint32_t island = NoIsland;
+        if (!m.isTrigger) {
+            const uint32_t a = m_idToIndex[m.bodyA];
+            const uint32_t b = m_idToIndex[m.bodyB];
+            if (a < awake) island = bodyIsland[a];
+            if (island == NoIsland && b < awake) island = bodyIsland[b];
+        }
+
+        if (island != NoIsland) {
+            m_sleepingIslands[island].manifolds.push_back(m);
+        } else {
+            m_manifolds[write++] = m;
+        }
+    }
+    m_manifolds.resize(write);
+
+    for (uint32_t slot : newIslands)
+    {
+        for (RigidBodyId id : m_sleepingIslands[slot].bodies)
+        {
+            const uint32_t index = m_idToIndex[id];
+            m_linearVelocities[index] = XMFLOAT3(0, 0, 0);
+            m_angularVelocities[index] = XMFLOAT3(0, 0, 0);
+            m_forces[index] = XMFLOAT3(0, 0, 0);
+            m_torques[index] = XMFLOAT3(0, 0, 0);
+            m_islands[index] = slot;
+            MoveToAsleep(index);
+        }
+    }
+}
+
+void RigidBodyWorld::WakeIsland(uint32_t islandIndex)
+{
+    SleepingIsland& island = m_sleepingIslands[islandIndex];
+    for (RigidBodyId id : island.bodies)
+    {
+        const uint32_t index = m_idToIndex[id];
+        m_islands[index] = NoIsland;
+        m_sleepTimes[index] = 0.0f;
+        MoveToAwake(index);
+    }
+    m_manifolds.insert(m_manifolds.end(), island.manifolds.begin(), island.manifolds.end());
+
+    island.bodies.clear();
+    island.manifolds.clear();
+    m_freeIslands.push_back(islandIndex);
+}
+
+void RigidBodyWorld::WakeBody(uint32_t index)
+{
+    if (m_islands[index] != NoIsland) {
+        WakeIsland(m_islands[index]);
+        return;
+    }
+    if (m_motions[index] != RigidBodyMotion::Static) {
+        m_sleepTimes[index] = 0.0f;
+        MoveToAwake(index);
+    }
+}
+
+void RigidBodyWorld::WakeTouching(const BoundingBox& bounds)
+{
+    std::vector<uint32_t> islands;
+    m_tree.Query(bounds, [&](int32_t proxyId) -> bool {
+        const auto id = static_cast<RigidBodyId>(reinterpret_cast<uintptr_t>(m_tree.GetUserData(proxyId)));
+        const uint32_t island = m_islands[m_idToIndex[id]];
+        if (island != NoIsland) islands.push_back(island);
+        return true;
+    });
+
+    for (uint32_t island : islands) {
+        if (!m_sleepingIslands[island].bodies.empty()) WakeIsland(island);
+    }
+}
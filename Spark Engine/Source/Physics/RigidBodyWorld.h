@@ -0,0 +1,496 @@
+/**
+ * @file RigidBodyWorld.h
+ * @brief Native rigid-body simulation core behind PhysicsSystem
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * RigidBodyWorld is a self-contained CPU rigid-body pipeline: body state lives
+ * in contiguous structure-of-arrays storage, velocities and positions are
+ * advanced with semi-implicit Euler, and contacts are resolved with a
+ * sequential-impulse solver that warm starts from the previous step's
+ * accumulated impulses. Contacts are soft (a mass-spring model tuned by
+ * contactHertz and contactDampingRatio) and each Step is split into substeps,
+ * each ending with an unbiased relax pass so penetration recovery never
+ * injects energy into stacks. Resting bodies are grouped into simulation islands
+ * that go to sleep together; a sleeping island is removed from every per-step
+ * loop until something touches it.
+ *
+ * Contact manifolds persist across steps in a pair-keyed cache. Points are
+ * matched to their predecessors by feature ID, or by proximity when the
+ * feature changed, and inherit their impulses. A pair whose relative pose has
+ * barely moved since its points were generated skips the narrowphase and
+ * refreshes the cached points from their body-local anchors.
+ *
+ * Pair finding, narrowphase, integration and the contact solve run on a
+ * worker pool. Contacts are graph-coloured so that no two constraints of one
+ * colour share a dynamic body; each colour is then solved in parallel without
+ * locks. Every parallel stage writes disjoint data and results are merged in
+ * a fixed order, so a step is bit-for-bit identical for any thread count.
+ *
+ * The world depends only on DirectXMath and the collision primitives, so it
+ * runs headless (no device, no window) on every platform the engine builds on.
+ */
+
+#pragma once
+
+#include "DynamicAABBTree.h"
+#include "PairHashMap.h"
+#include "PhysicsWorkerPool.h"
+#include <DirectXMath.h>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using DirectX::XMFLOAT4;
+
+/**
+ * @brief Stable handle to a body in a RigidBodyWorld
+ *
+ * Handles survive the swap-remove compaction of the dense body arrays and are
+ * recycled after the body is destroyed.
+ */
+using RigidBodyId = uint32_t;
+constexpr RigidBodyId InvalidRigidBodyId = 0xFFFFFFFFu;
+
+/**
+ * @brief How a body is moved by the simulation
+ */
+enum class RigidBodyMotion : uint8_t
+{
+    Static,        ///< Never moves; infinite mass
+    Kinematic,     ///< Moved by its velocity only; infinite mass
+    Dynamic        ///< Moved by forces and contacts
+};
+
+/**
+ * @brief Collision geometry understood by the contact generator
+ */
+enum class RigidShapeType : uint8_t
+{
+    Sphere,        ///< Sphere of the given radius
+    Box,           ///< Oriented box with the given half extents
+    QueryOnly      ///< Box bounds for world queries; never generates contacts
+};
+
+/**
+ * @brief Shape attached to a rigid body
+ *
+ * The shape may be offset and rotated from the body origin. The body's centre
+ * of mass stays at its origin.
+ */
+struct RigidShape
+{
+    RigidShapeType type = RigidShapeType::Box;
+    XMFLOAT3 halfExtents = { 0.5f, 0.5f, 0.5f };    ///< Box and QueryOnly half extents
+    float radius = 0.5f;                            ///< Sphere radius
+    XMFLOAT3 localOffset = { 0, 0, 0 };             ///< Shape centre in body space
+    XMFLOAT4 localRotation = { 0, 0, 0, 1 };        ///< Shape orientation in body space
+};
+
+/**
+ * @brief Creation parameters for a rigid body
+ */
+struct RigidBodyDef
+{
+    RigidBodyMotion motion = RigidBodyMotion::Dynamic;
+    RigidShape shape;
+    XMFLOAT3 position = { 0, 0, 0 };
+    XMFLOAT4 orientation = { 0, 0, 0, 1 };          ///< Unit quaternion
+    XMFLOAT3 linearVelocity = { 0, 0, 0 };
+    XMFLOAT3 angularVelocity = { 0, 0, 0 };
+    float mass = 1.0f;                              ///< Dynamic bodies only; <= 0 derives mass from density
+    float density = 1.0f;
+    float friction = 0.5f;
+    float restitution = 0.1f;
+    float linearDamping = 0.1f;
+    float angularDamping = 0.1f;
+    bool isTrigger = false;                         ///< Reports overlaps without contact response
+    bool allowSleep = true;
+    bool startAwake = true;
+    uint16_t collisionGroup = 1;
+    uint16_t collisionMask = 0xFFFF;
+    void* userData = nullptr;
+};
+
+/**
+ * @brief Solver and sleeping parameters
+ */
+struct RigidBodyWorldSettings
+{
+    XMFLOAT3 gravity = { 0.0f, -9.8f, 0.0f };
+    int   substeps = 2;                      ///< Full collide/solve passes per Step(); stiffens tall stacks
+    int   velocityIterations = 6;            ///< Biased sequential-impulse sweeps per substep
+    int   relaxIterations = 2;               ///< Unbiased sweeps after the position update
+    float contactHertz = 30.0f;              ///< Stiffness of the soft penetration recovery
+    float contactDampingRatio = 10.0f;
+    float linearSlop = 0.005f;               ///< Penetration allowed before position correction kicks in
+    float maxCorrectionVelocity = 3.0f;      ///< Clamp on the position-correction bias velocity
+    float restitutionThreshold = 1.0f;       ///< Closing speed below which contacts do not bounce
+    float maxTranslationPerStep = 2.0f;
+    float maxRotationPerStep = 0.25f * DirectX::XM_PI;
+    bool  enableWarmStarting = true;
+    bool  enableManifoldReuse = true;        ///< Refresh cached contacts instead of re-colliding resting pairs
+    float manifoldReuseDistance = 0.005f;    ///< Relative translation allowed before a pair is re-collided
+    float manifoldReuseAngle = 0.01f;        ///< Relative rotation (radians) allowed before a pair is re-collided
+    float contactMatchDistance = 0.05f;      ///< Radius for matching contact points whose feature IDs changed
+    bool  enableSleeping = true;
+    float sleepLinearVelocity = 0.05f;
+    float sleepAngularVelocity = 0.05f;
+    float timeToSleep = 0.5f;                ///< Seconds an island must stay below the thresholds
+};
+
+/**
+ * @brief Touch begin/end notification produced by Step()
+ */
+struct RigidContactEvent
+{
+    enum class Type : uint8_t { Begin, End };
+
+    Type type = Type::Begin;
+    bool isTrigger = false;
+    RigidBodyId bodyA = InvalidRigidBodyId;
+    RigidBodyId bodyB = InvalidRigidBodyId;
+    XMFLOAT3 point = { 0, 0, 0 };            ///< Deepest contact point (Begin only)
+    XMFLOAT3 normal = { 0, 1, 0 };           ///< From A towards B (Begin only)
+    float depth = 0.0f;
+};
+
+/**
+ * @brief Counters and timings from the most recent Step()
+ */
+struct RigidBodyStepStats
+{
+    uint32_t bodies = 0;
+    uint32_t awakeBodies = 0;
+    uint32_t sleepingIslands = 0;
+    uint32_t islands = 0;                    ///< Awake islands built this step
+    uint32_t candidatePairs = 0;
+    uint32_t manifolds = 0;
+    uint32_t contactPoints = 0;
+    uint32_t reusedManifolds = 0;            ///< Pairs refreshed from the cache instead of re-collided
+    uint32_t warmStartedPoints = 0;          ///< Contact points that inherited last step's impulses
+    uint32_t constraintColors = 0;           ///< Colours used by the parallel solver (last substep)
+    uint32_t overflowConstraints = 0;        ///< Constraints that fit no colour and were solved serially
+    uint32_t threads = 1;
+    float broadphaseMs = 0.0f;
+    float narrowphaseMs = 0.0f;
+    float solverMs = 0.0f;
+    float integrateMs = 0.0f;
+    float totalMs = 0.0f;
+};
+
+/**
+ * @brief Rigid-body simulation world
+ *
+ * @note Not thread-safe; Step() and all mutators must run on one thread.
+ *       Step() fans work out to JobSystem workers through the world's pool internally.
+ */
+class RigidBodyWorld
+{
+public:
+    /**
+     * @brief Column-major 3x3 matrix used for world-space inverse inertia tensors
+     */
+    struct Mat3
+    {
+        XMFLOAT3 c0, c1, c2;
+    };
+
+    explicit RigidBodyWorld(const RigidBodyWorldSettings& settings = RigidBodyWorldSettings());
+
+    // Body lifetime
+    RigidBodyId CreateBody(const RigidBodyDef& def);
+    void DestroyBody(RigidBodyId id);
+    void Clear();
+    bool IsValid(RigidBodyId id) const;
+
+    /**
+     * @brief Advance the simulation by one fixed step
+     * @param dt Step length in seconds
+     */
+    void Step(float dt);
+
+    // Transform
+    XMFLOAT3 GetPosition(RigidBodyId id) const;
+    XMFLOAT4 GetOrientation(RigidBodyId id) const;
+    void SetTransform(RigidBodyId id, const XMFLOAT3& position, const XMFLOAT4& orientation);
+
+    // Velocity
+    XMFLOAT3 GetLinearVelocity(RigidBodyId id) const;
+    void SetLinearVelocity(RigidBodyId id, const XMFLOAT3& velocity);
+    XMFLOAT3 GetAngularVelocity(RigidBodyId id) const;
+    void SetAngularVelocity(RigidBodyId id, const XMFLOAT3& velocity);
+
+    // Forces (relative positions are world-space offsets from the body origin)
+    void ApplyForce(RigidBodyId id, const XMFLOAT3& force, const XMFLOAT3& relativePos);
+    void ApplyImpulse(RigidBodyId id, const XMFLOAT3& impulse, const XMFLOAT3& relativePos);
+    void ApplyTorque(RigidBodyId id, const XMFLOAT3& torque);
+    void ApplyAngularImpulse(RigidBodyId id, const XMFLOAT3& impulse);
+
+    // Properties
+    float GetMass(RigidBodyId id) const;
+    void SetMass(RigidBodyId id, float mass);
+    RigidBodyMotion GetMotion(RigidBodyId id) const;
+    void SetMotion(RigidBodyId id, RigidBodyMotion motion);
+    void SetMaterial(RigidBodyId id, float friction, float restitution, float linearDamping, float angularDamping);
+    void SetTrigger(RigidBodyId id, bool trigger);
+    bool IsTrigger(RigidBodyId id) const;
+    void SetCollisionFilter(RigidBodyId id, uint16_t group, uint16_t mask);
+    void SetAwake(RigidBodyId id, bool awake);
+    bool IsAwake(RigidBodyId id) const;
+    void* GetUserData(RigidBodyId id) const;
+    void SetUserData(RigidBodyId id, void* userData);
+    BoundingBox GetWorldBounds(RigidBodyId id) const;
+
+    // World settings
+    const RigidBodyWorldSettings& GetSettings() const { return m_settings; }
+    void SetSettings(const RigidBodyWorldSettings& settings) { m_settings = settings; }
+    void SetGravity(const XMFLOAT3& gravity);
+
+    /**
+     * @brief Set how many threads Step() uses, including the calling thread
+     * @note Results do not depend on the thread count
+     */
+    void SetThreadCount(int threadCount) { m_workerPool.SetThreadCount(threadCount); }
+    int GetThreadCount() const { return m_workerPool.GetThreadCount(); }
+
+    /**
+     * @brief Solver worker pool, shared with other physics jobs such as mesh BVH builds
+     * @note Must not be used while Step() is running
+     */
+    PhysicsWorkerPool& GetWorkerPool() { return m_workerPool; }
+
+    // Broadphase access for world queries
+    const DynamicAABBTree& GetBroadphaseTree() const { return m_tree; }
+    void SetBroadphaseMargin(float margin) { m_tree.SetMargin(margin); }
+
+    /**
+     * @brief Visit every body whose fat bounds overlap the box
+     * @param callback Invoked as bool(RigidBodyId); return false to stop
+     */
+    template<typename Callback>
+    void QueryAABB(const BoundingBox& aabb, Callback&& callback) const;
+
+    /**
+     * @brief Visit bodies whose fat bounds are crossed by the ray segment
+     * @param callback Invoked as float(RigidBodyId, float clip); see DynamicAABBTree::RayCast
+     */
+    template<typename Callback>
+    void RayCast(const Ray& ray, float maxDistance, Callback&& callback) const;
+
+    // Step output
+    const std::vector<RigidContactEvent>& GetContactEvents() const { return m_events; }
+    const std::vector<RigidBodyId>& GetMovedBodies() const { return m_movedBodies; }
+    const RigidBodyStepStats& GetStepStats() const { return m_stats; }
+    uint32_t GetBodyCount() const { return static_cast<uint32_t>(m_ids.size()); }
+    uint32_t GetAwakeBodyCount() const;
+
+private:
+    struct ManifoldPoint
+    {
+        XMFLOAT3 point;                 ///< World-space contact point (midway between the surfaces)
+        float depth;                    ///< Penetration depth, positive when overlapping
+        uint32_t feature;               ///< Geometric feature key used to match points across steps
+        XMFLOAT3 localA;                ///< Deepest point of A's surface, in A's body frame
+        XMFLOAT3 localB;                ///< Deepest point of B's surface, in B's body frame
+        float normalImpulse;
+        float tangentImpulse[2];
+    };
+
+    struct Manifold
+    {
+        uint64_t key;                   ///< Ordered body-pair key
+        RigidBodyId bodyA;              ///< Lower ID of the pair
+        RigidBodyId bodyB;
+        XMFLOAT3 normal;                ///< From A towards B
+        XMFLOAT3 localNormal;           ///< Normal in A's body frame
+        XMFLOAT3 relativePosition;      ///< B's position in A's frame when the points were generated
+        XMFLOAT4 relativeOrientation;   ///< B's orientation in A's frame when the points were generated
+        float friction;
+        float restitution;
+        bool isTrigger;
+        int pointCount;
+        ManifoldPoint points[4];
+    };
+
+    struct ContactConstraintPoint
+    {
+        XMFLOAT3 rA, rB;
+        float normalMass;
+        float tangentMass[2];
+        float biasedTarget;             ///< Separating velocity aimed for while pushing out
+        float relaxTarget;              ///< Separating velocity aimed for in the relax pass
+        float normalImpulse;
+        float tangentImpulse[2];
+    };
+
+    struct ContactConstraint
+    {
+        uint32_t indexA, indexB;        ///< Dense body indices
+        uint32_t manifold;
+        XMFLOAT3 normal;
+        XMFLOAT3 tangent[2];
+        float friction;
+        float massScale, impulseScale;  ///< Soft-contact coefficients for the biased pass
+        int pointCount;
+        ContactConstraintPoint points[4];
+    };
+
+    /**
+     * @brief Narrowphase output for one candidate pair, merged serially in pair order
+     */
+    struct PairResult
+    {
+        Manifold manifold;
+        uint32_t previous;              ///< Index into m_previousManifolds, or NoManifold
+        bool touching;
+        bool reused;                    ///< Refreshed from the previous manifold without a narrowphase test
+    };
+
+    struct SleepingIsland
+    {
+        std::vector<RigidBodyId> bodies;
+        std::vector<Manifold> manifolds;
+    };
+
+    enum BodyFlags : uint8_t
+    {
+        FlagTrigger    = 1 << 0,
+        FlagAllowSleep = 1 << 1,
+        FlagMoving     = 1 << 2,        ///< Searched for pairs this step
+    };
+
+    static constexpr uint32_t NoIsland = 0xFFFFFFFFu;
+    static constexpr uint32_t NoManifold = 0xFFFFFFFFu;
+    static constexpr uint32_t ConstraintColorCount = 16;    ///< The overflow colour follows the last one
+
+    // Items per parallel chunk for each stage
+    static constexpr uint32_t BodyGrain = 128;
+    static constexpr uint32_t PairGrain = 32;
+    static constexpr uint32_t ConstraintGrain = 32;
+
+    // Pipeline stages
+    void Substep(float dt);
+    void FindPairs();
+    bool Collide(RigidBodyId idA, RigidBodyId idB, const Manifold* previous, Manifold& out) const;
+    bool RefreshManifold(const Manifold& previous, Manifold& out) const;
+    void MatchContacts(const Manifold& previous, Manifold& current) const;
+    void FinishContacts();
+    void IntegrateVelocities(float dt);
+    void PrepareContacts(float dt);
+    void ColorConstraints();
+    void WarmStart();
+    void SolveVelocities(bool useBias);
+    void WarmStartConstraint(const ContactConstraint& c);
+    void SolveConstraint(ContactConstraint& c, bool useBias);
+    void StoreImpulses();
+    void IntegratePositions(float dt);
+    void SynchronizeBroadphase(float dt);
+    void UpdateSleep(float dt);
+
+    // Islands
+    void WakeIsland(uint32_t islandIndex);
+    void WakeBody(uint32_t index);
+    void WakeTouching(const BoundingBox& bounds);
+
+    // Helpers
+    uint32_t IndexOf(RigidBodyId id) const;
+    void SwapBodies(uint32_t a, uint32_t b);
+    void MoveToAwake(uint32_t index);
+    void MoveToAsleep(uint32_t index);
+    bool ShouldCollide(uint32_t indexA, uint32_t indexB) const;
+    void UpdateMassProperties(uint32_t index);
+    void UpdateWorldInertia(uint32_t index);
+    BoundingBox ComputeBounds(uint32_t index) const;
+    void RemoveManifoldsOf(RigidBodyId id);
+    void RebuildManifoldCache();
+
+    template<typename Func>
+    void ForEachColumn(Func&& func);
+
+    static uint64_t PairKey(RigidBodyId a, RigidBodyId b);
+
+    RigidBodyWorldSettings m_settings;
+
+    // Handle table
+    std::vector<uint32_t> m_idToIndex;
+    std::vector<RigidBodyId> m_freeIds;
+
+    // Dense body columns (index-aligned); awake bodies occupy [0, m_awakeCount)
+    uint32_t m_awakeCount = 0;
+    std::vector<RigidBodyId> m_ids;
+    std::vector<XMFLOAT3> m_positions;
+    std::vector<XMFLOAT4> m_orientations;
+    std::vector<XMFLOAT3> m_linearVelocities;
+    std::vector<XMFLOAT3> m_angularVelocities;
+    std::vector<XMFLOAT3> m_forces;
+    std::vector<XMFLOAT3> m_torques;
+    std::vector<float> m_masses;
+    std::vector<float> m_inverseMasses;
+    std::vector<XMFLOAT3> m_inverseInertiaLocal;
+    std::vector<Mat3> m_inverseInertiaWorld;
+    std::vector<float> m_linearDamping;
+    std::vector<float> m_angularDamping;
+    std::vector<float> m_friction;
+    std::vector<float> m_restitution;
+    std::vector<float> m_densities;
+    std::vector<float> m_sleepTimes;
+    std::vector<RigidShape> m_shapes;
+    std::vector<RigidBodyMotion> m_motions;
+    std::vector<uint8_t> m_flags;
+    std::vector<uint16_t> m_groups;
+    std::vector<uint16_t> m_masks;
+    std::vector<int32_t> m_proxies;
+    std::vector<uint32_t> m_islands;            ///< Sleeping island index, or NoIsland
+    std::vector<void*> m_userData;
+
+    // Broadphase
+    DynamicAABBTree m_tree;
+    std::vector<RigidBodyId> m_movingBodies;
+    std::vector<std::pair<RigidBodyId, RigidBodyId>> m_pairs;
+    std::vector<std::vector<std::pair<RigidBodyId, RigidBodyId>>> m_pairChunks;
+
+    // Contacts (m_manifolds holds every awake pair; sleeping pairs live in their island)
+    std::vector<Manifold> m_manifolds;
+    std::vector<Manifold> m_previousManifolds;
+    PairHashMap m_manifoldCache;                      ///< Pair key -> index into m_previousManifolds
+    std::vector<PairResult> m_pairResults;
+    std::vector<ContactConstraint> m_constraints;     ///< Grouped by colour
+    std::vector<uint32_t> m_constraintManifolds;      ///< Source manifold of each constraint slot
+    std::vector<uint32_t> m_colorStarts;              ///< ConstraintColorCount + 2 offsets into m_constraints
+    std::vector<uint64_t> m_colorBodyMasks;           ///< Per-colour bitsets of claimed dynamic bodies
+    std::vector<uint8_t> m_constraintColors;          ///< Colouring scratch, in manifold order
+    std::vector<uint32_t> m_constraintSortScratch;
+
+    // Islands
+    std::vector<SleepingIsland> m_sleepingIslands;
+    std::vector<uint32_t> m_freeIslands;
+    std::vector<uint32_t> m_unionParent;
+
+    // Step output
+    std::vector<RigidContactEvent> m_events;
+    std::vector<RigidBodyId> m_movedBodies;
+    RigidBodyStepStats m_stats;
+
+    PhysicsWorkerPool m_workerPool;
+};
+
+// ============================================================================
+// TEMPLATE IMPLEMENTATION
+// ============================================================================
+
+template<typename Callback>
+void RigidBodyWorld::QueryAABB(const BoundingBox& aabb, Callback&& callback) const
+{
+    m_tree.Query(aabb, [&](int32_t proxyId) -> bool {
+        return callback(static_cast<RigidBodyId>(reinterpret_cast<uintptr_t>(m_tree.GetUserData(proxyId))));
+    });
+}
+
+template<typename Callback>
+void RigidBodyWorld::RayCast(const Ray& ray, float maxDistance, Callback&& callback) const
+{
+    m_tree.RayCast(ray, maxDistance, [&](int32_t proxyId, float clip) -> float {
+        return callback(static_cast<RigidBodyId>(reinterpret_cast<uintptr_t>(m_tree.GetUserData(proxyId))), clip);
+    });
+}
@@ -0,0 +1,632 @@
+/**
+ * @file TriangleBVH.cpp
+ * @brief Binned SAH build and stack-based traversal of the triangle BVH
+ * @author Spark Engine Team
+ * @date 2025
+ */
+
+#include "TriangleBVH.h"
+#include "PhysicsWorkerPool.h"
+#include "Utils/Assert.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+    // SAH cost of visiting an interior node relative to one triangle test
+    constexpr float TraversalCost = 1.0f;
+
+    // Items per chunk for the parallel parts of the build
+    constexpr uint32_t PrimitiveGrain = 4096;
+    constexpr uint32_t BinChunk = 16384;
+
+    struct Aabb
+    {
+        XMFLOAT3 min{ FLT_MAX, FLT_MAX, FLT_MAX };
+        XMFLOAT3 max{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+        void Grow(const XMFLOAT3& p)
+        {
+            min.x = std::min(min.x, p.x); min.y = std::min(min.y, p.y); min.z = std::min(min.z, p.z);
+            max.x = std::max(max.x, p.x); max.y = std::max(max.y, p.y); max.z = std::max(max.z, p.z);
+        }
+
+        void Grow(const Aabb& b)
+        {
+            Grow(b.min);
+            Grow(b.max);
+        }
+
+        float HalfArea() const
+        {
+            if (min.x > max.x) return 0.0f;
+            const float dx = max.x - min.x, dy = max.y - min.y, dz = max.z - min.z;
+            return dx * dy + dy * dz + dz * dx;
+        }
+    };
+
+    struct Bin
+    {
+        Aabb bounds;
+        uint32_t count = 0;
+    };
+
+    struct RangeBounds
+    {
+        Aabb bounds;
+        Aabb centroids;
+    };
+
+    float Axis(const XMFLOAT3& v, int axis)
+    {
+        return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+    }
+
+    XMFLOAT3 Sub(const XMFLOAT3& a, const XMFLOAT3& b) { return XMFLOAT3(a.x - b.x, a.y - b.y, a.z - b.z); }
+    XMFLOAT3 Cross(const XMFLOAT3& a, const XMFLOAT3& b)
+    {
+        return XMFLOAT3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+    }
+    float Dot(const XMFLOAT3& a, const XMFLOAT3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+    /**
+     * @brief Entry distance of a ray into a node, or FLT_MAX when it misses or starts beyond maxDistance
+     */
+    float IntersectNode(const TriangleBVHNode& node, const XMFLOAT3& origin, const XMFLOAT3& invDir, float maxDistance)
+    {
+        const float tx1 = (node.boundsMin.x - origin.x) * invDir.x, tx2 = (node.boundsMax.x - origin.x) * invDir.x;
+        const float ty1 = (node.boundsMin.y - origin.y) * invDir.y, ty2 = (node.boundsMax.y - origin.y) * invDir.y;
+        const float tz1 = (node.boundsMin.z - origin.z) * invDir.z, tz2 = (node.boundsMax.z - origin.z) * invDir.z;
+        const float tmin = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::max(std::min(tz1, tz2), 0.0f));
+        const float tmax = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::max(tz1, tz2));
+        return (tmax >= tmin && tmin <= maxDistance) ? tmin : FLT_MAX;
+    }
+
+    /**
+     * @brief Normalized direction and its reciprocal; false for a zero-length direction
+     */
+    bool PrepareRay(const Ray& ray, XMFLOAT3& direction, XMFLOAT3& invDir)
+    {
+        const XMFLOAT3& d = ray.Direction;
+        const float length = std::sqrt(Dot(d, d));
+        if (!(length > 0.0f) || !std::isfinite(length)) return false;
+
+        direction = XMFLOAT3(d.x / length, d.y / length, d.z / length);
+        // Axis-parallel rays get a huge finite reciprocal so 0 * inf never produces NaN
+        auto reciprocal = [](float c) { return std::fabs(c) > 1e-20f ? 1.0f / c : std::copysign(1e30f, c); };
+        invDir = XMFLOAT3(reciprocal(direction.x), reciprocal(direction.y), reciprocal(direction.z));
+        return true;
+    }
+}
+
+// ============================================================================
+// BUILDER
+// ============================================================================
+
+/**
+ * @brief Scratch state of one Build() call
+ */
+class TriangleBVH::Builder
+{
+public:
+    struct Task
+    {
+        uint32_t node;
+        uint32_t begin;
+        uint32_t end;
+        uint32_t depth;
+    };
+
+    Builder(uint32_t triangleCount, PhysicsWorkerPool* pool)
+        : m_pool(pool)
+        , m_triMin(triangleCount)
+        , m_triMax(triangleCount)
+        , m_centroid(triangleCount)
+        , m_refs(triangleCount)
+    {
+    }
+
+    void SetTriangle(uint32_t ref, const XMFLOAT3& a, const XMFLOAT3& b, const XMFLOAT3& c)
+    {
+        m_triMin[ref] = XMFLOAT3(std::min({ a.x, b.x, c.x }), std::min({ a.y, b.y, c.y }), std::min({ a.z, b.z, c.z }));
+        m_triMax[ref] = XMFLOAT3(std::max({ a.x, b.x, c.x }), std::max({ a.y, b.y, c.y }), std::max({ a.z, b.z, c.z }));
+        m_centroid[ref] = XMFLOAT3((m_triMin[ref].x + m_triMax[ref].x) * 0.5f,
+                                   (m_triMin[ref].y + m_triMax[ref].y) * 0.5f,
+                                   (m_triMin[ref].z + m_triMax[ref].z) * 0.5f);
+        m_refs[ref] = ref;
+    }
+
+    /**
+     * @brief Split a node; with a task list, nodes small enough are deferred instead of built
+     */
+    void BuildNode(std::vector<TriangleBVHNode>& nodes, uint32_t nodeIndex, uint32_t begin, uint32_t end,
+                   uint32_t depth, std::vector<Task>* deferred, bool parallel)
+    {
+        const uint32_t count = end - begin;
+        const RangeBounds range = ComputeBounds(begin, end, parallel);
+
+        nodes[nodeIndex].boundsMin = range.bounds.min;
+        nodes[nodeIndex].boundsMax = range.bounds.max;
+
+        auto makeLeaf = [&]() {
+            nodes[nodeIndex].leftFirst = begin;
+            nodes[nodeIndex].triangleCount = count;
+        };
+
+        if (count <= 1 || depth + 2 >= MaxDepth) {
+            makeLeaf();
+            return;
+        }
+
+        if (deferred && count <= SubtreeTaskTriangles) {
+            deferred->push_back({ nodeIndex, begin, end, depth });
+            return;
+        }
+
+        int axis = -1;
+        uint32_t splitBin = 0;
+        float splitCost = FLT_MAX;
+        FindSplit(range, begin, end, parallel, axis, splitBin, splitCost);
+
+        const float leafCost = static_cast<float>(count);
+        uint32_t mid = begin;
+        if (axis >= 0)
+        {
+            if (leafCost <= splitCost && count <= MaxLeafTriangles) {
+                makeLeaf();
+                return;
+            }
+
+            const float cmin = Axis(range.centroids.min, axis);
+            const float scale = BinCount / (Axis(range.centroids.max, axis) - cmin);
+            mid = static_cast<uint32_t>(std::partition(m_refs.begin() + begin, m_refs.begin() + end,
+                [&](uint32_t ref) { return BinIndex(Axis(m_centroid[ref], axis), cmin, scale) < splitBin; })
+                - m_refs.begin());
+        }
+
+        if (mid == begin || mid == end)
+        {
+            // Coincident centroids: SAH cannot separate them, so only split to bound leaf size
+            if (count <= MaxLeafTriangles) {
+                makeLeaf();
+                return;
+            }
+            mid = begin + count / 2;
+        }
+
+        const uint32_t left = static_cast<uint32_t>(nodes.size());
+        nodes.resize(nodes.size() + 2);
+        nodes[nodeIndex].leftFirst = left;
+        nodes[nodeIndex].triangleCount = 0;
+
+        BuildNode(nodes, left, begin, mid, depth + 1, deferred, parallel);
+        BuildNode(nodes, left + 1, mid, end, depth + 1, deferred, parallel);
+    }
+
+    const std::vector<uint32_t>& GetRefs() const { return m_refs; }
+    PhysicsWorkerPool* GetPool() const { return m_pool; }
+
+private:
+    static uint32_t BinIndex(float c, float cmin, float scale)
+    {
+        const int bin = static_cast<int>((c - cmin) * scale);
+        return static_cast<uint32_t>(std::clamp(bin, 0, static_cast<int>(BinCount) - 1));
+    }
+
+    bool UsePool(uint32_t count, bool parallel) const
+    {
+        return parallel && m_pool && m_pool->GetThreadCount() > 1 && count >= ParallelBinTriangles;
+    }
+
+    RangeBounds ComputeBounds(uint32_t begin, uint32_t end, bool parallel) const
+    {
+        auto accumulate = [this](uint32_t first, uint32_t last, RangeBounds& out) {
+            for (uint32_t i = first; i < last; ++i) {
+                const uint32_t ref = m_refs[i];
+                out.bounds.Grow(m_triMin[ref]);
+                out.bounds.Grow(m_triMax[ref]);
+                out.centroids.Grow(m_centroid[ref]);
+            }
+        };
+
+        RangeBounds result;
+        const uint32_t count = end - begin;
+        if (!UsePool(count, parallel)) {
+            accumulate(begin, end, result);
+            return result;
+        }
+
+        // Min/max merges are exact, so chunk order cannot change the result
+        const uint32_t chunks = (count + BinChunk - 1) / BinChunk;
+        std::vector<RangeBounds> partial(chunks);
+        m_pool->ParallelFor(chunks, 1, [&](uint32_t first, uint32_t last) {
+            for (uint32_t c = first; c < last; ++c) {
+                const uint32_t from = begin + c * BinChunk;
+                accumulate(from, std::min(from + BinChunk, end), partial[c]);
+            }
+        });
+        for (const RangeBounds& p : partial) {
+            result.bounds.Grow(p.bounds);
+            result.centroids.Grow(p.centroids);
+        }
+        return result;
+    }
+
+    void FindSplit(const RangeBounds& range, uint32_t begin, uint32_t end, bool parallel,
+                   int& bestAxis, uint32_t& bestBin, float& bestCost) const
+    {
+        const uint32_t count = end - begin;
+        const float parentArea = range.bounds.HalfArea();
+        if (!(parentArea > 0.0f)) return;
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const float cmin = Axis(range.centroids.min, axis);
+            const float extent = Axis(range.centroids.max, axis) - cmin;
+            if (!(extent > 0.0f)) continue;
+            const float scale = BinCount / extent;
+
+            Bin bins[BinCount];
+            auto binRange = [&](uint32_t first, uint32_t last, Bin* out) {
+                for (uint32_t i = first; i < last; ++i) {
+                    const uint32_t ref = m_refs[i];
+                    Bin& bin = out[BinIndex(Axis(m_centroid[ref], axis), cmin, scale)];
+                    bin.bounds.Grow(m_triMin[ref]);
+                    bin.bounds.Grow(m_triMax[ref]);
+                    ++bin.count;
+                }
+            };
+
+            if (UsePool(count, parallel))
+            {
+                const uint32_t chunks = (count + BinChunk - 1) / BinChunk;
+                std::vector<Bin> partial(static_cast<size_t>(chunks) * BinCount);
+                m_pool->ParallelFor(chunks, 1, [&](uint32_t first, uint32_t last) {
+                    for (uint32_t c = first; c < last; ++c) {
+                        const uint32_t from = begin + c * BinChunk;
+                        binRange(from, std::min(from + BinChunk, end), &partial[static_cast<size_t>(c) * BinCount]);
+                    }
+                });
+                for (uint32_t c = 0; c < chunks; ++c) {
+                    for (uint32_t b = 0; b < BinCount; ++b) {
+                        bins[b].bounds.Grow(partial[static_cast<size_t>(c) * BinCount + b].bounds);
+                        bins[b].count += partial[static_cast<size_t>(c) * BinCount + b].count;
+                    }
+                }
+            }
+            else
+            {
+                binRange(begin, end, bins);
+            }
+
+            // Sweep from the left and right to get the area/count of every split plane
+            float leftArea[BinCount - 1], rightArea[BinCount - 1];
+            uint32_t leftCount[BinCount - 1], rightCount[BinCount - 1];
+            Aabb leftBox, rightBox;
+            uint32_t leftSum = 0, rightSum = 0;
+            for (uint32_t i = 0; i < BinCount - 1; ++i)
+            {
+                leftSum += bins[i].count;
+                leftCount[i] = leftSum;
+                leftBox.Grow(bins[i].bounds);
+                leftArea[i] = leftBox.HalfArea();
+
+                rightSum += bins[BinCount - 1 - i].count;
+                rightCount[BinCount - 2 - i] = rightSum;
+                rightBox.Grow(bins[BinCount - 1 - i].bounds);
+                rightArea[BinCount - 2 - i] = rightBox.HalfArea();
+            }
+
+            for (uint32_t i = 0; i < BinCount - 1; ++i)
+            {
+                if (leftCount[i] == 0 || rightCount[i] == 0) continue;
+                const float cost = TraversalCost +
+                    (leftCount[i] * leftArea[i] + rightCount[i] * rightArea[i]) / parentArea;
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = i + 1;
+                }
+            }
+        }
+    }
+
+    PhysicsWorkerPool* m_pool;
+    std::vector<XMFLOAT3> m_triMin;
+    std::vector<XMFLOAT3> m_triMax;
+    std::vector<XMFLOAT3> m_centroid;
+    std::vector<uint32_t> m_refs;
+};
+
+// ============================================================================
+// BUILD
+// ============================================================================
+
+void TriangleBVH::Clear()
+{
+    m_nodes.clear();
+    m_triangles.clear();
+    m_sourceTriangle.clear();
+    m_slotOfTriangle.clear();
+    m_stats = TriangleBVHStats();
+}
+
+void TriangleBVH::Build(const std::vector<XMFLOAT3>& vertices, const std::vector<uint32_t>& indices,
+                        PhysicsWorkerPool* pool)
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+    Clear();
+
+    ASSERT_MSG(indices.size() % 3 == 0, "Triangle index count must be a multiple of 3 (got %zu)", indices.size());
+    const uint32_t sourceCount = static_cast<uint32_t>(indices.size() / 3);
+    const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+
+    std::vector<uint32_t> valid;
+    valid.reserve(sourceCount);
+    for (uint32_t t = 0; t < sourceCount; ++t) {
+        if (indices[t * 3] < vertexCount && indices[t * 3 + 1] < vertexCount && indices[t * 3 + 2] < vertexCount)
+            valid.push_back(t);
+    }
+    m_slotOfTriangle.assign(sourceCount, UINT32_MAX);
+    if (valid.empty()) return;
+
+    const uint32_t triangleCount = static_cast<uint32_t>(valid.size());
+    Builder builder(triangleCount, pool);
+
+    auto fillBounds = [&](uint32_t first, uint32_t last) {
+        for (uint32_t ref = first; ref < last; ++ref) {
+            const uint32_t t = valid[ref];
+            builder.SetTriangle(ref, vertices[indices[t * 3]], vertices[indices[t * 3 + 1]], vertices[indices[t * 3 + 2]]);
+        }
+    };
+    if (pool) pool->ParallelFor(triangleCount, PrimitiveGrain, fillBounds);
+    else fillBounds(0, triangleCount);
+
+    // Top of the tree: serial splits, parallel binning of the big nodes
+    std::vector<Builder::Task> tasks;
+    m_nodes.reserve(static_cast<size_t>(triangleCount) * 2);
+    m_nodes.resize(1);
+    builder.BuildNode(m_nodes, 0, 0, triangleCount, 0, &tasks, true);
+
+    // Bottom of the tree: each deferred subtree builds into its own array...
+    std::vector<std::vector<TriangleBVHNode>> subtrees(tasks.size());
+    auto buildSubtrees = [&](uint32_t first, uint32_t last) {
+        for (uint32_t i = first; i < last; ++i) {
+            std::vector<TriangleBVHNode>& local = subtrees[i];
+            local.reserve(static_cast<size_t>(tasks[i].end - tasks[i].begin) * 2);
+            local.resize(1);
+            builder.BuildNode(local, 0, tasks[i].begin, tasks[i].end, tasks[i].depth, nullptr, false);
+        }
+    };
+    if (pool) pool->ParallelFor(static_cast<uint32_t>(tasks.size()), 1, buildSubtrees);
+    else buildSubtrees(0, static_cast<uint32_t>(tasks.size()));
+
+    // ...and is spliced in task order, so the layout never depends on scheduling
+    for (size_t i = 0; i < tasks.size(); ++i)
+    {
+        const std::vector<TriangleBVHNode>& local = subtrees[i];
+        const uint32_t base = static_cast<uint32_t>(m_nodes.size());
+        auto remap = [base](TriangleBVHNode node) {
+            if (!node.IsLeaf()) node.leftFirst = base + node.leftFirst - 1;
+            return node;
+        };
+        m_nodes[tasks[i].node] = remap(local[0]);
+        for (size_t n = 1; n < local.size(); ++n)
+            m_nodes.push_back(remap(local[n]));
+    }
+    m_nodes.shrink_to_fit();
+
+    // Copy triangles into leaf order
+    const std::vector<uint32_t>& refs = builder.GetRefs();
+    m_triangles.resize(triangleCount);
+    m_sourceTriangle.resize(triangleCount);
+    for (uint32_t slot = 0; slot < triangleCount; ++slot)
+    {
+        const uint32_t t = valid[refs[slot]];
+        const XMFLOAT3& v0 = vertices[indices[t * 3]];
+        m_triangles[slot].v0 = v0;
+        m_triangles[slot].edge1 = Sub(vertices[indices[t * 3 + 1]], v0);
+        m_triangles[slot].edge2 = Sub(vertices[indices[t * 3 + 2]], v0);
+        m_sourceTriangle[slot] = t;
+        m_slotOfTriangle[t] = slot;
+    }
+
+    // Statistics
+    m_stats.triangles = triangleCount;
+    m_stats.nodes = static_cast<uint32_t>(m_nodes.size());
+    m_stats.subtreeTasks = static_cast<uint32_t>(tasks.size());
+
+    Aabb root;
+    root.min = m_nodes[0].boundsMin;
+    root.max = m_nodes[0].boundsMax;
+    const float rootArea = std::max(root.HalfArea(), FLT_MIN);
+
+    std::vector<std::pair<uint32_t, uint32_t>> stack{ { 0u, 0u } };
+    while (!stack.empty())
+    {
+        const auto [index, depth] = stack.back();
+        stack.pop_back();
+        const TriangleBVHNode& node = m_nodes[index];
+
+        Aabb box;
+        box.min = node.boundsMin;
+        box.max = node.boundsMax;
+        const float relativeArea = box.HalfArea() / rootArea;
+        m_stats.maxDepth = std::max(m_stats.maxDepth, depth);
+
+        if (node.IsLeaf()) {
+            ++m_stats.leaves;
+            m_stats.maxLeafTriangles = std::max(m_stats.maxLeafTriangles, node.triangleCount);
+            m_stats.sahCost += relativeArea * node.triangleCount;
+        } else {
+            m_stats.sahCost += relativeArea * TraversalCost;
+            stack.push_back({ node.leftFirst, depth + 1 });
+            stack.push_back({ node.leftFirst + 1, depth + 1 });
+        }
+    }
+
+    m_stats.buildMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+bool TriangleBVH::IntersectTriangle(uint32_t slot, const XMFLOAT3& origin, const XMFLOAT3& direction,
+                                    float maxDistance, float& distance, float& u, float& v) const
+{
+    // Moller-Trumbore with the same tolerances as CollisionSystem::RayVsTriangle
+    const Triangle& tri = m_triangles[slot];
+    const XMFLOAT3 h = Cross(direction, tri.edge2);
+    const float a = Dot(tri.edge1, h);
+    if (std::fabs(a) < 1e-6f) return false;
+
+    const float f = 1.0f / a;
+    const XMFLOAT3 s = Sub(origin, tri.v0);
+    const float bu = f * Dot(s, h);
+    if (bu < 0.0f || bu > 1.0f) return false;
+
+    const XMFLOAT3 q = Cross(s, tri.edge1);
+    const float bv = f * Dot(direction, q);
+    if (bv < 0.0f || bu + bv > 1.0f) return false;
+
+    const float t = f * Dot(tri.edge2, q);
+    if (t <= 1e-6f || t > maxDistance) return false;
+
+    distance = t;
+    u = bu;
+    v = bv;
+    return true;
+}
+
+bool TriangleBVH::Raycast(const Ray& ray, float maxDistance, TriangleBVHHit& hit) const
+{
+    hit = TriangleBVHHit();
+    XMFLOAT3 direction, invDir;
+    if (m_nodes.empty() || !PrepareRay(ray, direction, invDir)) return false;
+
+    const XMFLOAT3& origin = ray.Origin;
+    float best = maxDistance;
+    uint32_t bestSlot = UINT32_MAX;
+
+    uint32_t stack[MaxDepth];
+    float stackDistance[MaxDepth];
+    uint32_t stackSize = 0;
+
+    uint32_t index = 0;
+    if (IntersectNode(m_nodes[0], origin, invDir, best) == FLT_MAX) return false;
+
+    for (;;)
+    {
+        const TriangleBVHNode& node = m_nodes[index];
+        if (node.IsLeaf())
+        {
+            for (uint32_t i = 0; i < node.triangleCount; ++i)
+            {
+                float t, u, v;
+                if (IntersectTriangle(node.leftFirst + i, origin, direction, best, t, u, v) &&
+                    (t < best || bestSlot == UINT32_MAX)) {
+                    best = t;
+                    bestSlot = node.leftFirst + i;
+                    hit.u = u;
+                    hit.v = v;
+                }
+            }
+        }
+        else
+        {
+            // Descend into the nearer child first; the far one waits on the stack
+            uint32_t nearChild = node.leftFirst, farChild = node.leftFirst + 1;
+            float nearT = IntersectNode(m_nodes[nearChild], origin, invDir, best);
+            float farT = IntersectNode(m_nodes[farChild], origin, invDir, best);
+            if (farT < nearT) {
+                std::swap(nearChild, farChild);
+                std::swap(nearT, farT);
+            }
+
+            if (nearT != FLT_MAX)
+            {
+                if (farT != FLT_MAX) {
+                    stack[stackSize] = farChild;
+                    stackDistance[stackSize++] = farT;
+                }
+                index = nearChild;
+                continue;
+            }
+        }
+
+        // Pop the next subtree that can still hold a closer hit
+        bool found = false;
+        while (stackSize > 0) {
+            --stackSize;
+            if (stackDistance[stackSize] <= best) {
+                index = stack[stackSize];
+                found = true;
+                break;
+            }
+        }
+        if (!found) break;
+    }
+
+    if (bestSlot == UINT32_MAX) return false;
+
+    const Triangle& tri = m_triangles[bestSlot];
+    XMFLOAT3 normal = Cross(tri.edge1, tri.edge2);
+    const float length = std::sqrt(Dot(normal, normal));
+    if (length > 0.0f) normal = XMFLOAT3(normal.x / length, normal.y / length, normal.z / length);
+
+    hit.hit = true;
+    hit.distance = best;
+    hit.triangle = m_sourceTriangle[bestSlot];
+    hit.point = XMFLOAT3(origin.x + direction.x * best, origin.y + direction.y * best, origin.z + direction.z * best);
+    hit.normal = normal;
+    return true;
+}
+
+bool TriangleBVH::RaycastAny(const Ray& ray, float maxDistance) const
+{
+    XMFLOAT3 direction, invDir;
+    if (m_nodes.empty() || !PrepareRay(ray, direction, invDir)) return false;
+
+    const XMFLOAT3& origin = ray.Origin;
+    uint32_t stack[MaxDepth];
+    uint32_t stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0)
+    {
+        const TriangleBVHNode& node = m_nodes[stack[--stackSize]];
+        if (IntersectNode(node, origin, invDir, maxDistance) == FLT_MAX) continue;
+
+        if (node.IsLeaf())
+        {
+            for (uint32_t i = 0; i < node.triangleCount; ++i) {
+                float t, u, v;
+                if (IntersectTriangle(node.leftFirst + i, origin, direction, maxDistance, t, u, v)) return true;
+            }
+        }
+        else
+        {
+            stack[stackSize++] = node.leftFirst + 1;
+            stack[stackSize++] = node.leftFirst;
+        }
+    }
+    return false;
+}
+
+void TriangleBVH::GetTriangle(uint32_t triangle, XMFLOAT3& v0, XMFLOAT3& v1, XMFLOAT3& v2) const
+{
+    ASSERT_MSG(triangle < m_slotOfTriangle.size() && m_slotOfTriangle[triangle] != UINT32_MAX,
+               "Triangle %u is not part of the BVH", triangle);
+    const Triangle& tri = m_triangles[m_slotOfTriangle[triangle]];
+    v0 = tri.v0;
+    v1 = XMFLOAT3(tri.v0.x + tri.edge1.x, tri.v0.y + tri.edge1.y, tri.v0.z + tri.edge1.z);
+    v2 = XMFLOAT3(tri.v0.x + tri.edge2.x, tri.v0.y + tri.edge2.y, tri.v0.z + tri.edge2.z);
+}
+
+BoundingBox TriangleBVH::GetBounds() const
+{
+    if (m_nodes.empty()) return BoundingBox(XMFLOAT3(0, 0, 0), XMFLOAT3(0, 0, 0));
+    return BoundingBox(m_nodes[0].boundsMin, m_nodes[0].boundsMax);
+}
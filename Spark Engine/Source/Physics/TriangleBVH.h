@@ -0,0 +1,202 @@
+/**
+ * @file TriangleBVH.h
+ * @brief Static bounding volume hierarchy over triangle meshes for ray and overlap queries
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * Level geometry and other detailed meshes are far too large to test triangle
+ * by triangle. The BVH is built once per mesh with a binned surface area
+ * heuristic (SAH) and stored as a flat array of 32-byte nodes, so a ray only
+ * touches the handful of nodes and triangles along its path.
+ */
+
+#pragma once
+
+#include "CollisionSystem.h"
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+
+class PhysicsWorkerPool;
+
+/**
+ * @brief Compact BVH node (two per cache line)
+ *
+ * Interior nodes store the index of their left child; the right child always
+ * follows it. Leaves store the first triangle of a contiguous run.
+ */
+struct TriangleBVHNode
+{
+    XMFLOAT3 boundsMin;
+    uint32_t leftFirst = 0;     ///< Left child index (interior) or first triangle (leaf)
+    XMFLOAT3 boundsMax;
+    uint32_t triangleCount = 0; ///< 0 for interior nodes
+
+    bool IsLeaf() const { return triangleCount != 0; }
+};
+
+static_assert(sizeof(TriangleBVHNode) == 32, "TriangleBVHNode must stay 32 bytes");
+
+/**
+ * @brief Closest-hit result of a BVH ray query
+ */
+struct TriangleBVHHit
+{
+    bool hit = false;
+    float distance = FLT_MAX;   ///< Distance along the normalized ray direction
+    uint32_t triangle = 0;      ///< Index of the triangle in the source index buffer (index / 3)
+    XMFLOAT3 point = { 0, 0, 0 };
+    XMFLOAT3 normal = { 0, 0, 0 }; ///< Geometric normal, winding order (v1 - v0) x (v2 - v0)
+    float u = 0.0f;             ///< Barycentric weight of v1
+    float v = 0.0f;             ///< Barycentric weight of v2
+};
+
+/**
+ * @brief Shape statistics of a built hierarchy
+ */
+struct TriangleBVHStats
+{
+    uint32_t triangles = 0;
+    uint32_t nodes = 0;
+    uint32_t leaves = 0;
+    uint32_t maxDepth = 0;
+    uint32_t maxLeafTriangles = 0;
+    uint32_t subtreeTasks = 0;  ///< Independent subtrees handed to worker threads
+    float sahCost = 0.0f;       ///< Expected traversal cost relative to the root area
+    double buildMs = 0.0;
+};
+
+/**
+ * @brief Immutable triangle BVH with closest-hit, any-hit and box queries
+ *
+ * Build() copies the triangles into traversal order, so the source buffers
+ * may be released afterwards. Queries are const and safe to run from any
+ * number of threads at once.
+ *
+ * The build splits the top of the tree serially (binning large nodes in
+ * parallel) and then finishes the independent subtrees on the worker pool.
+ * Every decision depends only on the input, so the resulting tree is
+ * identical for every thread count.
+ */
+class TriangleBVH
+{
+public:
+    static constexpr uint32_t BinCount = 16;
+    static constexpr uint32_t MaxLeafTriangles = 8;
+    static constexpr uint32_t MaxDepth = 64;          ///< Also the traversal stack size
+    static constexpr uint32_t SubtreeTaskTriangles = 4096;
+    static constexpr uint32_t ParallelBinTriangles = 65536;
+
+    /**
+     * @brief Build the hierarchy from an indexed triangle list
+     * @param vertices Vertex positions
+     * @param indices Three indices per triangle; triangles with out-of-range indices are skipped
+     * @param pool Optional worker pool used for large meshes
+     */
+    void Build(const std::vector<XMFLOAT3>& vertices, const std::vector<uint32_t>& indices,
+               PhysicsWorkerPool* pool = nullptr);
+
+    void Clear();
+
+    /**
+     * @brief Find the closest triangle hit by a ray
+     * @param ray Ray to cast; the direction does not need to be normalized
+     * @param maxDistance Hits further than this are ignored
+     * @param hit Closest hit, filled in when the function returns true
+     */
+    bool Raycast(const Ray& ray, float maxDistance, TriangleBVHHit& hit) const;
+
+    /**
+     * @brief Test whether any triangle blocks a ray (line-of-sight queries)
+     */
+    bool RaycastAny(const Ray& ray, float maxDistance) const;
+
+    /**
+     * @brief Report every triangle whose bounds overlap a box
+     * @param box Query box in mesh space
+     * @param callback Invoked as callback(uint32_t triangle) with source triangle indices
+     */
+    template<typename Callback>
+    void QueryAABB(const BoundingBox& box, Callback&& callback) const;
+
+    /**
+     * @brief Fetch a triangle by its source index
+     */
+    void GetTriangle(uint32_t triangle, XMFLOAT3& v0, XMFLOAT3& v1, XMFLOAT3& v2) const;
+
+    bool IsEmpty() const { return m_nodes.empty(); }
+    uint32_t GetTriangleCount() const { return static_cast<uint32_t>(m_triangles.size()); }
+    BoundingBox GetBounds() const;
+    const std::vector<TriangleBVHNode>& GetNodes() const { return m_nodes; }
+    const TriangleBVHStats& GetStats() const { return m_stats; }
+
+private:
+    /**
+     * @brief Triangle in traversal order, stored as one vertex and two edges
+     */
+    struct Triangle
+    {
+        XMFLOAT3 v0;
+        XMFLOAT3 edge1;
+        XMFLOAT3 edge2;
+    };
+
+    class Builder;
+
+    bool IntersectTriangle(uint32_t slot, const XMFLOAT3& origin, const XMFLOAT3& direction,
+                           float maxDistance, float& distance, float& u, float& v) const;
+
+    std::vector<TriangleBVHNode> m_nodes;
+    std::vector<Triangle> m_triangles;         ///< Traversal order
+    std::vector<uint32_t> m_sourceTriangle;    ///< Traversal slot -> source triangle index
+    std::vector<uint32_t> m_slotOfTriangle;    ///< Source triangle index -> traversal slot
+    TriangleBVHStats m_stats;
+};
+
+// ============================================================================
+// TEMPLATE IMPLEMENTATION
+// ============================================================================
+
+template<typename Callback>
+void TriangleBVH::QueryAABB(const BoundingBox& box, Callback&& callback) const
+{
+    if (m_nodes.empty()) return;
+
+    uint32_t stack[MaxDepth];
+    uint32_t stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0)
+    {
+        const TriangleBVHNode& node = m_nodes[stack[--stackSize]];
+        if (node.boundsMin.x > box.Max.x || node.boundsMax.x < box.Min.x ||
+            node.boundsMin.y > box.Max.y || node.boundsMax.y < box.Min.y ||
+            node.boundsMin.z > box.Max.z || node.boundsMax.z < box.Min.z)
+            continue;
+
+        if (node.IsLeaf())
+        {
+            for (uint32_t i = 0; i < node.triangleCount; ++i)
+            {
+                const uint32_t slot = node.leftFirst + i;
+                const Triangle& t = m_triangles[slot];
+                const float x1 = t.v0.x + t.edge1.x, x2 = t.v0.x + t.edge2.x;
+                const float y1 = t.v0.y + t.edge1.y, y2 = t.v0.y + t.edge2.y;
+                const float z1 = t.v0.z + t.edge1.z, z2 = t.v0.z + t.edge2.z;
+                if ((t.v0.x > box.Max.x && x1 > box.Max.x && x2 > box.Max.x) ||
+                    (t.v0.x < box.Min.x && x1 < box.Min.x && x2 < box.Min.x) ||
+                    (t.v0.y > box.Max.y && y1 > box.Max.y && y2 > box.Max.y) ||
+                    (t.v0.y < box.Min.y && y1 < box.Min.y && y2 < box.Min.y) ||
+                    (t.v0.z > box.Max.z && z1 > box.Max.z && z2 > box.Max.z) ||
+                    (t.v0.z < box.Min.z && z1 < box.Min.z && z2 < box.Min.z))
+                    continue;
+                callback(m_sourceTriangle[slot]);
+            }
+        }
+        else
+        {
+            stack[stackSize++] = node.leftFirst + 1;
+            stack[stackSize++] = node.leftFirst;
+        }
+    }
+}
@@ -61,13 +61,23 @@ void Grenade::Render(const XMMATRIX& view, const XMMATRIX& projection)
     Projectile::Render(view, projection);
 }
 
+void Grenade::OnRoundExpired(uint32_t owner, const XMFLOAT3& position)
+{
+    // Pooled rounds expire at GetMaxLifeTime(); only a burnt fuse explodes
+    if (m_fuseTime <= m_maxLifeTime)
+        Detonate(position);
+}
+
 void Grenade::Explode()
 {
     ASSERT_MSG(!m_hasExploded, "Grenade exploded multiple times");
     m_hasExploded = true;
+    Detonate(GetPosition());
+    Deactivate();
+}
 
-    // TODO: spawn explosion effect at current position
+void Grenade::Detonate(const XMFLOAT3& position) const
+{
+    // TODO: spawn explosion effect at `position`
     // TODO: apply area damage using m_explosionRadius
-
-    Deactivate();
 }
\ No newline at end of file
@@ -18,8 +18,13 @@ public:
     void    Update(float deltaTime) override;
     void    Render(const XMMATRIX& view, const XMMATRIX& projection) override;
 
+    float   GetMaxLifeTime() const override { return m_fuseTime < m_maxLifeTime ? m_fuseTime : m_maxLifeTime; }
+
+    void    OnRoundExpired(uint32_t owner, const XMFLOAT3& position) override;
+
 private:
     void Explode();
+    void Detonate(const XMFLOAT3& position) const;
 
     float m_fuseTime;
     float m_explosionRadius;
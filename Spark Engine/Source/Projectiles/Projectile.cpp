@@ -60,9 +60,6 @@ void Projectile::Update(float deltaTime)
         return;
     }
 
-    // Collision
-    CheckCollisions();
-
     // Update transform
     GameObject::Update(deltaTime);
 
@@ -76,12 +73,20 @@ void Projectile::Render(const XMMATRIX& view, const XMMATRIX& projection)
     GameObject::Render(view, projection);
 }
 
+void Projectile::RenderAt(const XMFLOAT3& position, const XMMATRIX& view, const XMMATRIX& projection)
+{
+    SetPosition(position);
+    ResetInterpolation();
+    GameObject::Render(view, projection);
+}
+
 void Projectile::Fire(const XMFLOAT3& startPosition,
     const XMFLOAT3& direction,
     float speed)
 {
     ASSERT_MSG(speed >= 0, "Speed must be non-negative");
     SetPosition(startPosition);
+    ResetInterpolation();
     m_speed = speed;
 
     XMVECTOR dirV = XMVector3Normalize(XMLoadFloat3(&direction));
@@ -145,15 +150,6 @@ void Projectile::CreateMesh()
         m_mesh->CreateSphere(0.1f, 8, 8);
 }
 
-void Projectile::CheckCollisions()
-{
-    // Example: ground plane at y=0
-    if (GetPosition().y < 0.0f)
-    {
-        OnHitWorld(GetPosition(), XMFLOAT3{ 0,1,0 });
-    }
-}
-
 void Projectile::UpdatePhysics(float deltaTime)
 {
     if (m_hasGravity)
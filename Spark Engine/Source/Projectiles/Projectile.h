@@ -26,11 +26,14 @@
  * 
  * Features include:
  * - Physics-based movement with velocity and optional gravity
- * - Collision detection using bounding spheres
+ * - Continuous (swept-sphere) collision against the world, reported by
+ *   ProjectilePool through OnRoundHitWorld() and OnRoundExpired()
  * - Automatic lifetime management and deactivation
  * - Damage system integration
  * - Object pooling support for performance
  * 
+ * @note ProjectilePool does not simulate Projectile instances; it stores live rounds
+ *       as flat arrays and uses one instance per type for tuning and rendering
  * @note This class inherits from GameObject and implements the collision callbacks
  * @warning Derived classes should call the base class methods when overriding
  */
@@ -73,6 +76,11 @@ public:
 
     /**
      * @brief Update projectile physics and lifetime
+     *
+     * Moves the projectile by a full step. World collision for the step is
+     * resolved afterwards by the owning pool with a swept test from the
+     * previous position, see OnRoundHitWorld().
+     *
      * @param deltaTime Time elapsed since last frame in seconds
      */
     void    Update(float deltaTime) override;
@@ -118,6 +126,26 @@ public:
     void OnHitWorld(const DirectX::XMFLOAT3& hitPoint,
         const DirectX::XMFLOAT3& normal) override;
 
+    /**
+     * @brief A pooled round of this type hit world geometry and is being despawned
+     *
+     * Called by ProjectilePool on the type's prototype, which stands in for
+     * every round of the type, so overrides must not change the prototype.
+     * @param owner Owner ID passed to ProjectilePool::FireProjectile()
+     * @param center Sphere center at the time of impact
+     * @param hitPoint Contact point on the world surface
+     * @param normal Surface normal at the contact
+     */
+    virtual void OnRoundHitWorld(uint32_t owner, const DirectX::XMFLOAT3& center,
+        const DirectX::XMFLOAT3& hitPoint, const DirectX::XMFLOAT3& normal) {}
+
+    /**
+     * @brief A pooled round of this type reached GetMaxLifeTime() and is being despawned
+     *
+     * Called on the type's prototype, like OnRoundHitWorld().
+     */
+    virtual void OnRoundExpired(uint32_t owner, const DirectX::XMFLOAT3& position) {}
+
     /**
      * @brief Configure gravity settings for the projectile
      * @param enabled Whether gravity should affect this projectile
@@ -155,6 +183,30 @@ public:
      */
     const BoundingSphere& GetBoundingSphere() const { return m_boundingSphere; }
 
+    /**
+     * @brief Time after firing at which the projectile expires
+     *
+     * Types with a fuse report the fuse time when it is shorter.
+     */
+    virtual float       GetMaxLifeTime() const { return m_maxLifeTime; }
+
+    /**
+     * @brief Gravity multiplier, 0 when gravity is disabled
+     */
+    float               GetEffectiveGravityScale() const { return m_hasGravity ? m_gravityScale : 0.0f; }
+
+    /**
+     * @brief Draw this projectile's mesh at a given position without changing its state
+     *
+     * Used by ProjectilePool, which keeps one instance per type as a render
+     * prototype and draws every live round of that type through it.
+     *
+     * @param position World position to draw at
+     * @param view Camera view matrix
+     * @param projection Camera projection matrix
+     */
+    void RenderAt(const DirectX::XMFLOAT3& position, const DirectX::XMMATRIX& view, const DirectX::XMMATRIX& projection);
+
     /**
      * @brief Set the damage amount
      * @param damage New damage value (must be non-negative)
@@ -176,11 +228,6 @@ protected:
      */
     void CreateMesh() override;
 
-    /**
-     * @brief Check for collisions with world and other objects
-     */
-    void CheckCollisions();
-
     /**
      * @brief Update physics simulation
      * @param deltaTime Time step for physics integration
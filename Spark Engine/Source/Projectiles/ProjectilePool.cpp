@@ -5,8 +5,12 @@
 #include "Grenade.h"
 #include "Utils/Assert.h"
 #include "../Utils/ConsoleProcessManager.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <memory>
+#include <random>
+#include <sstream>
 
 using namespace DirectX;
 
@@ -32,12 +36,61 @@ using namespace DirectX;
 #define LOG_TO_CONSOLE(msg, type) LOG_TO_CONSOLE_RATE_LIMITED(msg, type)
 #define LOG_TO_CONSOLE_IMMEDIATE(msg, type) Spark::ConsoleProcessManager::GetInstance().Log(msg, type)
 
+namespace
+{
+    /// Matches the per-update damping Projectile::UpdatePhysics applies
+    constexpr float DefaultDrag = 0.98f;
+    constexpr float Gravity = -9.8f;
+
+    XMVECTOR Load4(const std::vector<float>& v, size_t i) { return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&v[i])); }
+    void Store4(std::vector<float>& v, size_t i, FXMVECTOR x) { XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&v[i]), x); }
+}
+
 ProjectilePool::ProjectilePool(size_t poolSize)
     : m_poolSize(poolSize)
 {
     LOG_TO_CONSOLE_IMMEDIATE(L"ProjectilePool constructed with size " + std::to_wstring(poolSize), L"INFO");
-    ASSERT_MSG(poolSize > 0, "ProjectilePool size must be positive");
-    m_projectiles.reserve(poolSize);
+    ASSERT_MSG(poolSize > 0, "ProjectilePool size must be positive (got %zu)", poolSize);
+
+    // The type subclasses are the source of truth for tuning and later draw every round of their type
+    m_prototypes[static_cast<size_t>(ProjectileType::BULLET)] = std::make_unique<Bullet>();
+    m_prototypes[static_cast<size_t>(ProjectileType::ROCKET)] = std::make_unique<Rocket>();
+    m_prototypes[static_cast<size_t>(ProjectileType::GRENADE)] = std::make_unique<Grenade>();
+    for (size_t t = 0; t < ProjectileTypeCount; ++t)
+    {
+        const Projectile& proto = *m_prototypes[t];
+        ProjectileTypeParams& params = m_typeParams[t];
+        params.damage = proto.GetDamage();
+        params.maxLifeTime = proto.GetMaxLifeTime();
+        params.gravityScale = proto.GetEffectiveGravityScale();
+        params.drag = DefaultDrag;
+        params.radius = proto.GetBoundingSphere().Radius;
+    }
+
+    // Capacity split: 50% bullets, 25% rockets, remainder grenades
+    m_typeCapacity[static_cast<size_t>(ProjectileType::BULLET)] = poolSize / 2;
+    m_typeCapacity[static_cast<size_t>(ProjectileType::ROCKET)] = poolSize / 4;
+    m_typeCapacity[static_cast<size_t>(ProjectileType::GRENADE)] = poolSize - poolSize / 2 - poolSize / 4;
+
+    // Each type owns a contiguous ID range; free lists pop the lowest ID first
+    uint32_t base = 0;
+    for (size_t t = 0; t < ProjectileTypeCount; ++t)
+    {
+        const uint32_t capacity = static_cast<uint32_t>(m_typeCapacity[t]);
+        m_freeRounds[t].reserve(capacity);
+        for (uint32_t i = capacity; i > 0; --i)
+            m_freeRounds[t].push_back(base + i - 1);
+        base += capacity;
+    }
+    m_denseOfRound.assign(poolSize, InvalidRound);
+
+    for (auto* v : { &m_posX, &m_posY, &m_posZ, &m_prevX, &m_prevY, &m_prevZ, &m_velX, &m_velY, &m_velZ,
+                     &m_age, &m_maxAge, &m_gravity, &m_drag })
+        v->reserve(poolSize);
+    m_types.reserve(poolSize);
+    m_owners.reserve(poolSize);
+    m_roundOfDense.reserve(poolSize);
+    m_sweeps.Reserve(poolSize);
 }
 
 ProjectilePool::~ProjectilePool()
@@ -55,58 +108,140 @@ HRESULT ProjectilePool::Initialize(ID3D11Device* device, ID3D11DeviceContext* co
     m_device = device;
     m_context = context;
 
-    // Create projectiles based on pool size distribution
-    size_t bulletsCount = m_poolSize / 2;     // 50% bullets
-    size_t rocketsCount = m_poolSize / 4;     // 25% rockets
-    size_t grenadesCount = m_poolSize - bulletsCount - rocketsCount; // remainder
-
-    // Helper lambda
-    auto makeAndStore = [&](auto TypeFactory, size_t count) {
-        for (size_t i = 0; i < count; ++i)
+    for (auto& proto : m_prototypes)
+    {
+        ASSERT_MSG(proto != nullptr, "Projectile prototype missing (pool size %zu)", m_poolSize);
+        HRESULT hr = proto->Initialize(m_device, m_context);
+        if (FAILED(hr))
         {
-            auto p = TypeFactory();
-            ASSERT_MSG(p != nullptr, "Failed to create projectile");
-            if (SUCCEEDED(p->Initialize(m_device, m_context)))
-            {
-                m_availableProjectiles.push(p.get());
-                m_projectiles.push_back(std::move(p));
-            }
+            LOG_TO_CONSOLE_IMMEDIATE(L"ProjectilePool prototype initialization failed.", L"ERROR");
+            return hr;
         }
-        };
-
-    makeAndStore([] { return std::make_unique<Bullet>(); }, bulletsCount);
-    makeAndStore([] { return std::make_unique<Rocket>(); }, rocketsCount);
-    makeAndStore([] { return std::make_unique<Grenade>(); }, grenadesCount);
-
-    ASSERT_MSG(m_projectiles.size() == m_poolSize, "Some projectiles failed to initialize");
+    }
 
-    LOG_TO_CONSOLE_IMMEDIATE(L"ProjectilePool created " + std::to_wstring(m_projectiles.size()) + L" projectiles.", L"INFO");
+    LOG_TO_CONSOLE_IMMEDIATE(L"ProjectilePool ready: " + std::to_wstring(m_typeCapacity[0]) + L" bullets, " +
+        std::to_wstring(m_typeCapacity[1]) + L" rockets, " + std::to_wstring(m_typeCapacity[2]) + L" grenades.", L"INFO");
     return S_OK;
 }
 
 void ProjectilePool::Update(float deltaTime)
 {
     // **FIXED: Remove per-frame logging completely**
-    ASSERT_MSG(deltaTime >= 0.0f && std::isfinite(deltaTime), "Invalid deltaTime in ProjectilePool::Update");
+    ASSERT_MSG(deltaTime >= 0.0f && std::isfinite(deltaTime), "Invalid deltaTime in ProjectilePool::Update (%f)", deltaTime);
+
+    m_lastImpactCount = 0;
+    m_sweeps.Clear();
+    if (m_types.empty()) return;
+
+    // Sweep before expiring so a round's last step still collides
+    Integrate(deltaTime);
+    ResolveCollisions();
+    ExpireRounds();
+}
+
+void ProjectilePool::Integrate(float deltaTime)
+{
+    const size_t count = m_types.size();
+
+    // The pre-step positions are the sweep starts and the render interpolation source
+    std::copy(m_posX.begin(), m_posX.end(), m_prevX.begin());
+    std::copy(m_posY.begin(), m_posY.end(), m_prevY.begin());
+    std::copy(m_posZ.begin(), m_posZ.end(), m_prevZ.begin());
 
-    for (auto& up : m_projectiles)
+    // Same order as Projectile::UpdatePhysics: gravity, drag, then move
+    const XMVECTOR gravityStep = XMVectorReplicate(Gravity * deltaTime);
+    const XMVECTOR dt = XMVectorReplicate(deltaTime);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const XMVECTOR drag = Load4(m_drag, i);
+        const XMVECTOR vx = XMVectorMultiply(Load4(m_velX, i), drag);
+        const XMVECTOR vy = XMVectorMultiply(XMVectorMultiplyAdd(Load4(m_gravity, i), gravityStep, Load4(m_velY, i)), drag);
+        const XMVECTOR vz = XMVectorMultiply(Load4(m_velZ, i), drag);
+        Store4(m_velX, i, vx);
+        Store4(m_velY, i, vy);
+        Store4(m_velZ, i, vz);
+        Store4(m_posX, i, XMVectorMultiplyAdd(vx, dt, Load4(m_posX, i)));
+        Store4(m_posY, i, XMVectorMultiplyAdd(vy, dt, Load4(m_posY, i)));
+        Store4(m_posZ, i, XMVectorMultiplyAdd(vz, dt, Load4(m_posZ, i)));
+        Store4(m_age, i, XMVectorAdd(Load4(m_age, i), dt));
+    }
+    for (; i < count; ++i)
+    {
+        m_velY[i] += m_gravity[i] * Gravity * deltaTime;
+        m_velX[i] *= m_drag[i];
+        m_velY[i] *= m_drag[i];
+        m_velZ[i] *= m_drag[i];
+        m_posX[i] += m_velX[i] * deltaTime;
+        m_posY[i] += m_velY[i] * deltaTime;
+        m_posZ[i] += m_velZ[i] * deltaTime;
+        m_age[i] += deltaTime;
+    }
+}
+
+void ProjectilePool::ExpireRounds()
+{
+    // Walk backwards so a swapped-in round has already been checked
+    for (size_t i = m_types.size(); i-- > 0;)
+    {
+        if (m_age[i] < m_maxAge[i]) continue;
+
+        if (Projectile* proto = m_prototypes[static_cast<size_t>(m_types[i])].get())
+            proto->OnRoundExpired(m_owners[i], XMFLOAT3(m_posX[i], m_posY[i], m_posZ[i]));
+        RemoveAt(i);
+    }
+}
+
+void ProjectilePool::ResolveCollisions()
+{
+    const size_t count = m_types.size();
+    if (count == 0 || GetWorldColliderCount() == 0) return;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        m_sweeps.Add(XMFLOAT3(m_prevX[i], m_prevY[i], m_prevZ[i]),
+                     XMFLOAT3(m_posX[i] - m_prevX[i], m_posY[i] - m_prevY[i], m_posZ[i] - m_prevZ[i]),
+                     m_typeParams[static_cast<size_t>(m_types[i])].radius);
+    }
+
+    // Resolve the whole volley against the world in one batched pass
+    const SweepTargets targets{ &m_worldSpheres, &m_worldBoxes, &m_worldTriangles };
+    CollisionSystem::SweepSpheresBatch(m_sweeps, targets, m_sweepHits);
+
+    // Backwards for the same swap-remove reason as ExpireRounds()
+    for (size_t i = count; i-- > 0;)
     {
-        if (up->IsActive())
+        const SweepHit& hit = m_sweepHits[i];
+        if (!hit.IsHit()) continue;
+
+        ++m_lastImpactCount;
+        if (Projectile* proto = m_prototypes[static_cast<size_t>(m_types[i])].get())
         {
-            up->Update(deltaTime);
-            if (!up->IsActive())
-                ReturnProjectile(up.get());
+            const XMFLOAT3 center(m_sweeps.StartX[i] + m_sweeps.DeltaX[i] * hit.Time,
+                                  m_sweeps.StartY[i] + m_sweeps.DeltaY[i] * hit.Time,
+                                  m_sweeps.StartZ[i] + m_sweeps.DeltaZ[i] * hit.Time);
+            proto->OnRoundHitWorld(m_owners[i], center, hit.Point, hit.Normal);
         }
+        RemoveAt(i);
     }
 }
 
 void ProjectilePool::Render(const DirectX::XMMATRIX& view, const DirectX::XMMATRIX& projection)
 {
     // **FIXED: Remove per-frame logging completely**
-    for (auto& up : m_projectiles)
+    if (!m_device) return;
+
+    const float alpha = GameObject::GetInterpolationAlpha();
+    for (size_t i = 0; i < m_types.size(); ++i)
     {
-        if (up->IsActive())
-            up->Render(view, projection);
+        Projectile* proto = m_prototypes[static_cast<size_t>(m_types[i])].get();
+        if (!proto) continue;
+
+        const XMFLOAT3 position(m_prevX[i] + (m_posX[i] - m_prevX[i]) * alpha,
+                                m_prevY[i] + (m_posY[i] - m_prevY[i]) * alpha,
+                                m_prevZ[i] + (m_posZ[i] - m_prevZ[i]) * alpha);
+        proto->RenderAt(position, view, projection);
     }
 }
 
@@ -114,103 +249,247 @@ void ProjectilePool::Shutdown()
 {
     LOG_TO_CONSOLE_IMMEDIATE(L"ProjectilePool::Shutdown called.", L"OPERATION");
 
-    m_projectiles.clear();
-    std::queue<Projectile*> empty;
-    std::swap(m_availableProjectiles, empty);
+    Clear();
+    for (auto& proto : m_prototypes)
+        proto.reset();
+    m_device = nullptr;
+    m_context = nullptr;
 
     LOG_TO_CONSOLE_IMMEDIATE(L"ProjectilePool shutdown complete.", L"INFO");
 }
 
-Projectile* ProjectilePool::GetProjectile()
+void ProjectilePool::Clear()
 {
-    // **FIXED: Rate-limited logging for projectile acquisition**
-    LOG_TO_CONSOLE(L"ProjectilePool::GetProjectile called.", L"OPERATION");
-    if (m_availableProjectiles.empty()) {
-        LOG_TO_CONSOLE(L"ProjectilePool: No available projectiles!", L"WARNING");
-        return nullptr;
-    }
-    Projectile* p = m_availableProjectiles.front();
-    m_availableProjectiles.pop();
-    return p;
+    while (!m_types.empty())
+        RemoveAt(m_types.size() - 1);
+    m_lastImpactCount = 0;
+    m_sweeps.Clear();
 }
 
-void ProjectilePool::ReturnProjectile(Projectile* p)
+void ProjectilePool::RemoveAt(size_t dense)
 {
-    // **FIXED: Rate-limited logging for projectile return**
-    LOG_TO_CONSOLE(L"ProjectilePool::ReturnProjectile called.", L"OPERATION");
-    ASSERT(p != nullptr);
-    if (p)
+    const size_t last = m_types.size() - 1;
+    ASSERT_MSG(dense <= last, "Dense index %zu out of range", dense);
+
+    const uint32_t round = m_roundOfDense[dense];
+    m_freeRounds[static_cast<size_t>(m_types[dense])].push_back(round);
+    m_denseOfRound[round] = InvalidRound;
+
+    if (dense != last)
     {
-        p->SetActive(false);
-        m_availableProjectiles.push(p);
+        for (auto* v : { &m_posX, &m_posY, &m_posZ, &m_prevX, &m_prevY, &m_prevZ, &m_velX, &m_velY, &m_velZ,
+                         &m_age, &m_maxAge, &m_gravity, &m_drag })
+            (*v)[dense] = (*v)[last];
+        m_types[dense] = m_types[last];
+        m_owners[dense] = m_owners[last];
+        m_roundOfDense[dense] = m_roundOfDense[last];
+        m_denseOfRound[m_roundOfDense[dense]] = static_cast<uint32_t>(dense);
     }
+
+    for (auto* v : { &m_posX, &m_posY, &m_posZ, &m_prevX, &m_prevY, &m_prevZ, &m_velX, &m_velY, &m_velZ,
+                     &m_age, &m_maxAge, &m_gravity, &m_drag })
+        v->pop_back();
+    m_types.pop_back();
+    m_owners.pop_back();
+    m_roundOfDense.pop_back();
+}
+
+bool ProjectilePool::Despawn(uint32_t round)
+{
+    if (!IsLive(round)) return false;
+    RemoveAt(m_denseOfRound[round]);
+    return true;
+}
+
+XMFLOAT3 ProjectilePool::GetPosition(uint32_t round) const
+{
+    ASSERT_MSG(IsLive(round), "Round %u is not live", round);
+    if (!IsLive(round)) return XMFLOAT3(0.0f, 0.0f, 0.0f);
+    const uint32_t i = m_denseOfRound[round];
+    return XMFLOAT3(m_posX[i], m_posY[i], m_posZ[i]);
 }
 
 void ProjectilePool::FireBullet(const XMFLOAT3& pos, const XMFLOAT3& dir, float speed)
 {
-    LOG_TO_CONSOLE(L"ProjectilePool::FireBullet called. speed=" + std::to_wstring(speed), L"OPERATION");
-    ASSERT_MSG(speed >= 0.0f, "Speed must be non-negative in FireBullet");
-    if (auto p = GetProjectile()) {
-        p->Fire(pos, dir, speed);
-    }
+    ASSERT_MSG(speed >= 0.0f, "Speed must be non-negative in FireBullet (%f)", speed);
+    FireProjectile(ProjectileType::BULLET, pos, dir, speed);
 }
 
 void ProjectilePool::FireRocket(const XMFLOAT3& pos, const XMFLOAT3& dir, float speed)
 {
-    LOG_TO_CONSOLE(L"ProjectilePool::FireRocket called. speed=" + std::to_wstring(speed), L"OPERATION");
-    ASSERT_MSG(speed >= 0.0f, "Speed must be non-negative in FireRocket");
-    if (auto p = GetProjectile()) {
-        p->Fire(pos, dir, speed);
-    }
+    ASSERT_MSG(speed >= 0.0f, "Speed must be non-negative in FireRocket (%f)", speed);
+    FireProjectile(ProjectileType::ROCKET, pos, dir, speed);
 }
 
 void ProjectilePool::FireGrenade(const XMFLOAT3& pos, const XMFLOAT3& dir, float speed)
 {
-    LOG_TO_CONSOLE(L"ProjectilePool::FireGrenade called. speed=" + std::to_wstring(speed), L"OPERATION");
-    ASSERT_MSG(speed >= 0.0f, "Speed must be non-negative in FireGrenade");
-    if (auto p = GetProjectile()) {
-        p->SetGravity(true, 1.0f);
-        p->Fire(pos, dir, speed);
-    }
+    ASSERT_MSG(speed >= 0.0f, "Speed must be non-negative in FireGrenade (%f)", speed);
+    FireProjectile(ProjectileType::GRENADE, pos, dir, speed);
 }
 
-void ProjectilePool::FireProjectile(ProjectileType type, const XMFLOAT3& pos, const XMFLOAT3& dir, float speed)
+uint32_t ProjectilePool::FireProjectile(ProjectileType type, const XMFLOAT3& pos, const XMFLOAT3& dir,
+                                        float speed, uint32_t owner)
 {
-    // **FIXED: Rate-limited logging for weapon firing**
-    static auto lastFireLog = std::chrono::steady_clock::now();
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - lastFireLog).count();
-    
-    switch (type)
+    const size_t t = static_cast<size_t>(type);
+    if (t >= ProjectileTypeCount)
     {
-    case ProjectileType::BULLET:  FireBullet(pos, dir, speed); break;
-    case ProjectileType::ROCKET:  FireRocket(pos, dir, speed); break;
-    case ProjectileType::GRENADE: FireGrenade(pos, dir, speed); break;
-    default:
         LOG_TO_CONSOLE_IMMEDIATE(L"Unknown ProjectileType in FireProjectile", L"ERROR");
-        ASSERT_MSG(false, "Unknown ProjectileType in FireProjectile");
+        ASSERT_MSG(false, "Unknown ProjectileType %d in FireProjectile", static_cast<int>(type));
+        return InvalidRound;
     }
-    
-    // Only log firing every 3 seconds to avoid spam
-    if (elapsed >= 3) {
-        LOG_TO_CONSOLE(L"ProjectilePool: Projectile fired.", L"INFO");
-        lastFireLog = now;
+    if (m_freeRounds[t].empty())
+    {
+        LOG_TO_CONSOLE(L"ProjectilePool: No available projectiles of the requested type!", L"WARNING");
+        return InvalidRound;
     }
+
+    const uint32_t round = m_freeRounds[t].back();
+    m_freeRounds[t].pop_back();
+    m_denseOfRound[round] = static_cast<uint32_t>(m_types.size());
+    m_roundOfDense.push_back(round);
+
+    const XMFLOAT3 direction = CollisionSystem::Vector3Normalize(dir);
+    const ProjectileTypeParams& params = m_typeParams[t];
+    m_posX.push_back(pos.x); m_posY.push_back(pos.y); m_posZ.push_back(pos.z);
+    m_prevX.push_back(pos.x); m_prevY.push_back(pos.y); m_prevZ.push_back(pos.z);
+    m_velX.push_back(direction.x * speed); m_velY.push_back(direction.y * speed); m_velZ.push_back(direction.z * speed);
+    m_age.push_back(0.0f);
+    m_maxAge.push_back(params.maxLifeTime);
+    m_gravity.push_back(params.gravityScale);
+    m_drag.push_back(params.drag);
+    m_types.push_back(type);
+    m_owners.push_back(owner);
+    return round;
 }
 
-size_t ProjectilePool::GetActiveCount() const
+size_t ProjectilePool::GetActiveCount(ProjectileType type) const
 {
-    // **FIXED: Rate-limited logging for count queries**
-    LOG_TO_CONSOLE(L"ProjectilePool::GetActiveCount called.", L"OPERATION");
-    size_t count = 0;
-    for (const auto& up : m_projectiles)
-        if (up->IsActive()) ++count;
-    return count;
+    const size_t t = static_cast<size_t>(type);
+    return m_typeCapacity[t] - m_freeRounds[t].size();
 }
 
 size_t ProjectilePool::GetAvailableCount() const
 {
-    // **FIXED: Rate-limited logging for count queries**
-    LOG_TO_CONSOLE(L"ProjectilePool::GetAvailableCount called.", L"OPERATION");
-    return m_availableProjectiles.size();
-}
\ No newline at end of file
+    size_t available = 0;
+    for (const auto& freeList : m_freeRounds)
+        available += freeList.size();
+    return available;
+}
+
+void ProjectilePool::ClearWorldColliders()
+{
+    m_worldBoxes.Clear();
+    m_worldSpheres.Clear();
+    m_worldTriangles.Clear();
+}
+
+uint32_t ProjectilePool::AddWorldBox(const BoundingBox& box)
+{
+    ASSERT_MSG(box.Min.x <= box.Max.x && box.Min.y <= box.Max.y && box.Min.z <= box.Max.z,
+        "World box min must not exceed max (min.x=%f)", box.Min.x);
+    m_worldBoxes.Add(box);
+    return static_cast<uint32_t>(m_worldBoxes.Size() - 1);
+}
+
+void ProjectilePool::SetWorldBox(uint32_t index, const BoundingBox& box)
+{
+    ASSERT_MSG(box.Min.x <= box.Max.x && box.Min.y <= box.Max.y && box.Min.z <= box.Max.z,
+        "World box min must not exceed max (min.x=%f)", box.Min.x);
+    m_worldBoxes.Set(index, box);
+}
+
+void ProjectilePool::AddWorldSphere(const BoundingSphere& sphere)
+{
+    ASSERT_MSG(sphere.Radius >= 0.0f, "World sphere radius must be non-negative (%f)", sphere.Radius);
+    m_worldSpheres.Add(sphere);
+}
+
+void ProjectilePool::AddWorldTriangle(const XMFLOAT3& v0, const XMFLOAT3& v1, const XMFLOAT3& v2)
+{
+    m_worldTriangles.Add(v0, v1, v2);
+}
+
+std::string ProjectilePool::Console_Benchmark(int rounds, int ticks)
+{
+    rounds = std::max(4, rounds);
+    ticks = std::max(1, ticks);
+    const float dt = 1.0f / 60.0f;
+    auto ms = [](auto a, auto b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+
+    ProjectilePool pool(static_cast<size_t>(rounds));
+
+    // An arena of walls so a share of every volley hits something
+    for (int i = 0; i < 16; ++i)
+    {
+        const float angle = i * (XM_2PI / 16.0f);
+        const XMFLOAT3 c(std::cos(angle) * 60.0f, 2.0f, std::sin(angle) * 60.0f);
+        pool.AddWorldBox(BoundingBox(XMFLOAT3(c.x - 8.0f, c.y - 4.0f, c.z - 8.0f), XMFLOAT3(c.x + 8.0f, c.y + 4.0f, c.z + 8.0f)));
+    }
+    pool.AddWorldBox(BoundingBox(XMFLOAT3(-200.0f, -1.1f, -200.0f), XMFLOAT3(200.0f, -1.0f, 200.0f)));
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    auto fireVolley = [&](size_t& spawned) {
+        // Top each type up to its share, as a mixed minigun/rocket/grenade fight would
+        for (size_t t = 0; t < ProjectileTypeCount; ++t)
+        {
+            const ProjectileType type = static_cast<ProjectileType>(t);
+            const float speed = type == ProjectileType::BULLET ? 400.0f : (type == ProjectileType::ROCKET ? 60.0f : 20.0f);
+            while (pool.GetAvailableCount(type) > 0)
+            {
+                const XMFLOAT3 dir(unit(rng), unit(rng) * 0.3f + 0.2f, unit(rng));
+                pool.FireProjectile(type, XMFLOAT3(unit(rng), 1.5f, unit(rng)), dir, speed, static_cast<uint32_t>(t));
+                ++spawned;
+            }
+        }
+    };
+
+    size_t spawned = 0, impacts = 0, updated = 0;
+    double spawnMs = 0.0, updateMs = 0.0;
+    for (int tick = 0; tick < ticks; ++tick)
+    {
+        auto spawnStart = std::chrono::high_resolution_clock::now();
+        fireVolley(spawned);
+        auto spawnEnd = std::chrono::high_resolution_clock::now();
+        spawnMs += ms(spawnStart, spawnEnd);
+
+        updated += pool.GetActiveCount();
+        auto updateStart = std::chrono::high_resolution_clock::now();
+        pool.Update(dt);
+        auto updateEnd = std::chrono::high_resolution_clock::now();
+        updateMs += ms(updateStart, updateEnd);
+        impacts += pool.GetLastImpactCount();
+    }
+    const size_t expired = spawned - impacts - pool.GetActiveCount();
+
+    // Despawn through the public handle path, in scattered order
+    fireVolley(spawned);
+    std::vector<uint32_t> live;
+    for (uint32_t round = 0; round < static_cast<uint32_t>(rounds); ++round)
+        if (pool.IsLive(round)) live.push_back(round);
+    std::shuffle(live.begin(), live.end(), rng);
+    auto despawnStart = std::chrono::high_resolution_clock::now();
+    for (uint32_t round : live) pool.Despawn(round);
+    auto despawnEnd = std::chrono::high_resolution_clock::now();
+    const double despawnMs = ms(despawnStart, despawnEnd);
+
+    // A bullet whose lifetime runs out on the tick it reaches a wall must still hit it
+    ProjectilePool lastTick(4);
+    lastTick.AddWorldBox(BoundingBox(XMFLOAT3(5.0f, -1000.0f, -1000.0f), XMFLOAT3(6.0f, 1000.0f, 1000.0f)));
+    lastTick.FireProjectile(ProjectileType::BULLET, XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), 10.0f, 0);
+    lastTick.Update(lastTick.GetTypeParams(ProjectileType::BULLET).maxLifeTime + 0.5f);
+    const bool lastTickHit = lastTick.GetLastImpactCount() == 1 && lastTick.GetActiveCount() == 0;
+
+    std::stringstream ss;
+    ss << "=== Projectile Pool Benchmark ===\n";
+    ss << "Capacity: " << rounds << " (" << pool.GetCapacity(ProjectileType::BULLET) << " bullets, "
+       << pool.GetCapacity(ProjectileType::ROCKET) << " rockets, " << pool.GetCapacity(ProjectileType::GRENADE)
+       << " grenades), " << ticks << " ticks, " << pool.GetWorldColliderCount() << " world colliders\n";
+    ss << "Spawn:   " << spawnMs << " ms, " << (spawned / std::max(spawnMs, 1e-6)) << " rounds/ms (" << spawned << " spawned)\n";
+    ss << "Update:  " << updateMs / ticks << " ms/tick, " << (updated / std::max(updateMs, 1e-6))
+       << " rounds/ms (integrate + swept collision + expiry)\n";
+    ss << "Despawn: " << despawnMs << " ms, " << (live.size() / std::max(despawnMs, 1e-6)) << " rounds/ms\n";
+    ss << "Impacts: " << impacts << ", expired: " << expired << "\n";
+    ss << "Final-tick sweep: " << (lastTickHit ? "PASS" : "FAIL") << "\n";
+    return ss.str();
+}
@@ -1,12 +1,14 @@
 ﻿/**
  * @file ProjectilePool.h
- * @brief Object pool system for efficient projectile management
+ * @brief Data-oriented pool that simulates every live projectile in flat arrays
  * @author Spark Engine Team
  * @date 2025
- * 
- * This class provides an efficient object pool for managing projectiles to avoid
- * frequent memory allocations and deallocations during gameplay. It supports
- * multiple projectile types and provides convenient firing methods.
+ *
+ * Minigun and shotgun-heavy matches spawn thousands of rounds per second.
+ * Instead of one heap object per round with a virtual Update(), the pool keeps
+ * live rounds packed in structure-of-arrays storage: the integrate, lifetime
+ * and collision passes stream through contiguous floats, spawning appends to
+ * the end and despawning swaps the last round into the hole.
  */
 
 #pragma once
@@ -14,8 +16,9 @@
 #include "Utils/Assert.h"
 #include <d3d11.h>
 #include <DirectXMath.h>
+#include <array>
 #include <memory>
-#include <queue>
+#include <string>
 #include <vector>
 #include "Projectile.h"
 
@@ -29,28 +32,57 @@ enum class ProjectileType
     GRENADE   ///< Lobbed explosive projectiles with gravity
 };
 
+/// Number of ProjectileType values
+constexpr size_t ProjectileTypeCount = 3;
+
+/**
+ * @brief Per-type tuning shared by every round of that type
+ *
+ * Read from the type's Projectile subclass (Bullet, Rocket, Grenade) when the
+ * pool is constructed, so the subclasses stay the single place to tune them.
+ */
+struct ProjectileTypeParams
+{
+    float damage = 0.0f;
+    float maxLifeTime = 1.0f;   ///< Seconds until the round expires (fuse time for grenades)
+    float gravityScale = 0.0f;  ///< 0 for rounds that fly straight
+    float drag = 0.98f;         ///< Velocity multiplier applied every update
+    float radius = 0.1f;        ///< Collision sphere radius
+};
+
 /**
  * @brief Object pool for efficient projectile management
- * 
- * The ProjectilePool manages a fixed pool of projectile objects to avoid
- * memory allocation overhead during gameplay. It handles creation, updating,
- * rendering, and recycling of projectiles automatically.
- * 
- * Features include:
- * - Pre-allocated pool of reusable projectile objects
- * - Factory methods for different projectile types
- * - Automatic lifecycle management
- * - Performance tracking with active/available counts
- * 
+ *
+ * Capacity is split per type (50% bullets, 25% rockets, the rest grenades).
+ * Each type owns a range of stable round IDs and a free list of the unused
+ * ones, so one weapon cannot starve the others and spawning is O(1).
+ *
+ * Live rounds are stored densely in parallel arrays (position, previous
+ * position, velocity, lifetime, type, owner); dense index i of every array
+ * describes the same round. Despawning is an O(1) swap-remove, and the
+ * ID <-> dense index maps keep IDs valid while rounds move.
+ *
+ * Every Update():
+ * - integrates gravity and drag four rounds at a time,
+ * - sweeps each round's motion against the registered world colliders in a
+ *   single batch,
+ * - expires the surviving rounds that outlived their type's lifetime.
+ *
+ * Expired rounds and hits are handed to the type's prototype through
+ * Projectile::OnRoundExpired() and Projectile::OnRoundHitWorld() before the
+ * round is despawned, so rockets explode on impact and grenades at the fuse.
+ *
  * @note Pool size should be large enough to handle peak projectile usage
- * @warning Initialize() must be called before firing any projectiles
+ * @warning Initialize() must be called before Render(); simulation works without it
  */
 class ProjectilePool
 {
 public:
+    static constexpr uint32_t InvalidRound = 0xFFFFFFFFu;
+
     /**
      * @brief Constructor with pool size specification
-     * @param poolSize Maximum number of simultaneous projectiles
+     * @param poolSize Maximum number of simultaneous projectiles, split across types
      */
     ProjectilePool(size_t poolSize);
 
@@ -60,7 +92,7 @@ public:
     ~ProjectilePool();
 
     /**
-     * @brief Initialize the projectile pool with DirectX resources
+     * @brief Initialize the per-type render prototypes with DirectX resources
      * @param device DirectX 11 device for projectile creation
      * @param context DirectX 11 device context for rendering
      * @return HRESULT indicating success or failure
@@ -68,34 +100,36 @@ public:
     HRESULT Initialize(ID3D11Device* device, ID3D11DeviceContext* context);
 
     /**
-     * @brief Update all active projectiles
+     * @brief Update all active projectiles and resolve their world collisions
+     *
+     * Each round integrates a full step first; the motions are then swept
+     * against the world colliders together and rounds that hit something are
+     * moved back to their time of impact, passed to their type and despawned.
+     *
      * @param deltaTime Time elapsed since last frame in seconds
      */
     void    Update(float deltaTime);
 
     /**
      * @brief Render all active projectiles
+     *
+     * Positions are blended between the last two updates with
+     * GameObject::GetInterpolationAlpha().
+     *
      * @param view Camera view matrix
      * @param proj Camera projection matrix
      */
     void    Render(const DirectX::XMMATRIX& view, const DirectX::XMMATRIX& proj);
 
     /**
-     * @brief Shutdown and clean up all resources
+     * @brief Despawn every round and release the render prototypes
      */
     void    Shutdown();
 
     /**
-     * @brief Get an available projectile from the pool
-     * @return Pointer to available projectile, or nullptr if pool is full
+     * @brief Despawn every round, keeping capacity and prototypes
      */
-    Projectile* GetProjectile();
-
-    /**
-     * @brief Return a projectile to the available pool
-     * @param p Pointer to the projectile to return
-     */
-    void        ReturnProjectile(Projectile* p);
+    void    Clear();
 
     /**
      * @brief Fire a bullet projectile
@@ -127,14 +161,29 @@ public:
      * @param pos Starting position
      * @param dir Direction vector (should be normalized)
      * @param speed Initial speed
+     * @param owner Caller-defined owner ID passed back to the type's hit and expiry callbacks
+     * @return Round ID, or InvalidRound if this type's share of the pool is exhausted
+     */
+    uint32_t FireProjectile(ProjectileType type, const DirectX::XMFLOAT3& pos, const DirectX::XMFLOAT3& dir,
+                            float speed, uint32_t owner = 0);
+
+    /**
+     * @brief Remove a live round
+     * @param round ID returned by FireProjectile()
+     * @return false if the round is not live
+     */
+    bool Despawn(uint32_t round);
+
+    /**
+     * @brief Check whether a round ID refers to a live round
      */
-    void FireProjectile(ProjectileType type, const DirectX::XMFLOAT3& pos, const DirectX::XMFLOAT3& dir, float speed);
+    bool IsLive(uint32_t round) const { return round < m_denseOfRound.size() && m_denseOfRound[round] != InvalidRound; }
 
     /**
      * @brief Get the number of currently active projectiles
      * @return Number of projectiles in use
      */
-    size_t GetActiveCount()    const;
+    size_t GetActiveCount()    const { return m_types.size(); }
 
     /**
      * @brief Get the number of available projectiles in the pool
@@ -142,15 +191,112 @@ public:
      */
     size_t GetAvailableCount() const;
 
+    size_t GetActiveCount(ProjectileType type) const;
+    size_t GetAvailableCount(ProjectileType type) const { return m_freeRounds[static_cast<size_t>(type)].size(); }
+    size_t GetCapacity(ProjectileType type) const { return m_typeCapacity[static_cast<size_t>(type)]; }
+
+    const ProjectileTypeParams& GetTypeParams(ProjectileType type) const { return m_typeParams[static_cast<size_t>(type)]; }
+
+    /**
+     * @brief Current position of a live round
+     */
+    DirectX::XMFLOAT3 GetPosition(uint32_t round) const;
+
+    // ========================================================================
+    // WORLD COLLIDERS
+    // ========================================================================
+
+    /**
+     * @brief Remove every static world collider
+     */
+    void ClearWorldColliders();
+
+    /**
+     * @brief Register static geometry that projectiles collide with
+     * @return Index of the box for SetWorldBox()
+     */
+    uint32_t AddWorldBox(const BoundingBox& box);
+
+    /**
+     * @brief Move a box registered by AddWorldBox() since the last ClearWorldColliders()
+     */
+    void SetWorldBox(uint32_t index, const BoundingBox& box);
+    void AddWorldSphere(const BoundingSphere& sphere);
+    void AddWorldTriangle(const DirectX::XMFLOAT3& v0, const DirectX::XMFLOAT3& v1, const DirectX::XMFLOAT3& v2);
+
+    size_t GetWorldColliderCount() const { return m_worldBoxes.Size() + m_worldSpheres.Size() + m_worldTriangles.Size(); }
+
+    /**
+     * @brief Number of projectile sweeps resolved by the last Update()
+     */
+    size_t GetLastSweepCount() const { return m_sweeps.Size(); }
+
+    /**
+     * @brief Number of sweeps that hit world geometry in the last Update()
+     */
+    size_t GetLastImpactCount() const { return m_lastImpactCount; }
+
+    // ========================================================================
+    // CONSOLE INTEGRATION
+    // ========================================================================
+
+    /**
+     * @brief Measure spawn, update and despawn throughput on a headless pool
+     * @param rounds Pool capacity, kept full by spawning a volley every tick
+     * @param ticks Number of simulated ticks
+     */
+    static std::string Console_Benchmark(int rounds, int ticks);
+
 private:
     /**
-     * @brief Create all projectile objects for the pool
+     * @brief Remove the round at a dense index by moving the last round into it
      */
-    void CreateProjectiles();
+    void RemoveAt(size_t dense);
 
-    size_t                          m_poolSize;    ///< Maximum pool size
-    ID3D11Device* m_device;                        ///< DirectX device reference
-    ID3D11DeviceContext* m_context;                ///< DirectX context reference
-    std::vector<std::unique_ptr<Projectile>> m_projectiles;      ///< All projectile objects
-    std::queue<Projectile*>         m_availableProjectiles;      ///< Queue of available projectiles
-};
\ No newline at end of file
+    /**
+     * @brief Gravity, drag and position integration over the dense arrays
+     */
+    void Integrate(float deltaTime);
+
+    /**
+     * @brief Swap-remove every round whose lifetime ran out, after telling its type
+     * @note Runs after ResolveCollisions() so the final step of an expiring round is still swept
+     */
+    void ExpireRounds();
+
+    /**
+     * @brief Sweep this update's motions against the world, pass the hits to their type and despawn them
+     */
+    void ResolveCollisions();
+
+    size_t                          m_poolSize;                  ///< Maximum pool size
+    ID3D11Device* m_device{ nullptr };                           ///< DirectX device reference
+    ID3D11DeviceContext* m_context{ nullptr };                   ///< DirectX context reference
+
+    // Per-type configuration
+    std::array<std::unique_ptr<Projectile>, ProjectileTypeCount> m_prototypes;   ///< Tuning source and render proxy
+    std::array<ProjectileTypeParams, ProjectileTypeCount>        m_typeParams;
+    std::array<size_t, ProjectileTypeCount>                      m_typeCapacity{};
+    std::array<std::vector<uint32_t>, ProjectileTypeCount>       m_freeRounds;   ///< Unused round IDs per type
+
+    // Live rounds, dense: index i of every array is the same round
+    std::vector<float>              m_posX, m_posY, m_posZ;
+    std::vector<float>              m_prevX, m_prevY, m_prevZ;   ///< Position before the last update
+    std::vector<float>              m_velX, m_velY, m_velZ;
+    std::vector<float>              m_age;                       ///< Seconds since firing
+    std::vector<float>              m_maxAge;                    ///< Copied from the type for the expiry pass
+    std::vector<float>              m_gravity;                   ///< Copied from the type for the integrate pass
+    std::vector<float>              m_drag;                      ///< Copied from the type for the integrate pass
+    std::vector<ProjectileType>     m_types;
+    std::vector<uint32_t>           m_owners;
+    std::vector<uint32_t>           m_roundOfDense;              ///< Dense index -> round ID
+    std::vector<uint32_t>           m_denseOfRound;              ///< Round ID -> dense index, or InvalidRound
+
+    // Continuous collision
+    BoxSoA                          m_worldBoxes;                ///< Static world boxes
+    SphereSoA                       m_worldSpheres;              ///< Static world spheres
+    TriangleSoA                     m_worldTriangles;            ///< Static world triangles
+    SphereSweepSoA                  m_sweeps;                    ///< This update's motions, in dense order
+    std::vector<SweepHit>           m_sweepHits;                 ///< Earliest impact per sweep
+    size_t                          m_lastImpactCount{ 0 };      ///< Hits found by the last Update()
+};
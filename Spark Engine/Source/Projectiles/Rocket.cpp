@@ -62,13 +62,23 @@ void Rocket::OnHitWorld(const XMFLOAT3& hitPoint, const XMFLOAT3& normal)
         Explode(hitPoint);
 }
 
+void Rocket::OnRoundHitWorld(uint32_t owner, const XMFLOAT3& center, const XMFLOAT3& hitPoint, const XMFLOAT3& normal)
+{
+    ASSERT_MSG(std::isfinite(hitPoint.x) && std::isfinite(hitPoint.y) && std::isfinite(hitPoint.z),
+        "Invalid hitPoint in Rocket::OnRoundHitWorld (owner %u)", owner);
+    Detonate(hitPoint);
+}
+
 void Rocket::Explode(const XMFLOAT3& position)
 {
     ASSERT_MSG(!m_hasExploded, "Rocket exploded multiple times");
     m_hasExploded = true;
+    Detonate(position);
+    Deactivate();
+}
 
+void Rocket::Detonate(const XMFLOAT3& position) const
+{
     // TODO: spawn explosion effect at `position`
     // TODO: apply area damage using m_explosionRadius
-
-    Deactivate();
 }
\ No newline at end of file
@@ -20,9 +20,11 @@ public:
 
     void OnHit(GameObject* target) override;
     void OnHitWorld(const XMFLOAT3& hitPoint, const XMFLOAT3& normal) override;
+    void OnRoundHitWorld(uint32_t owner, const XMFLOAT3& center, const XMFLOAT3& hitPoint, const XMFLOAT3& normal) override;
 
 private:
     void Explode(const XMFLOAT3& position);
+    void Detonate(const XMFLOAT3& position) const;
 
     float m_explosionRadius;
     bool  m_hasExploded;
@@ -0,0 +1,638 @@
+/**
+ * @file SceneOctree.cpp
+ * @brief Implementation of the loose octree scene index
+ * @author Spark Engine Team
+ * @date 2025
+ */
+
+#include "SceneOctree.h"
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+using namespace DirectX;
+
+SceneOctree::SceneOctree(float minHalfSize, float initialHalfSize)
+    : m_minHalfSize(std::max(minHalfSize, 0.01f))
+    , m_initialHalfSize(std::max(initialHalfSize, m_minHalfSize))
+{
+    m_root = AllocateNode(XMFLOAT3(0.0f, 0.0f, 0.0f), m_initialHalfSize, NullNode);
+}
+
+// ============================================================================
+// NODES
+// ============================================================================
+
+int32_t SceneOctree::AllocateNode(const XMFLOAT3& center, float halfSize, int32_t parent)
+{
+    int32_t index;
+    if (!m_freeNodes.empty()) {
+        index = m_freeNodes.back();
+        m_freeNodes.pop_back();
+    } else {
+        index = static_cast<int32_t>(m_nodes.size());
+        m_nodes.emplace_back();
+    }
+
+    // Free nodes keep their entry list capacity, so cells that empty and refill don't reallocate
+    Node& node = m_nodes[index];
+    node.center = center;
+    node.halfSize = halfSize;
+    node.parent = parent;
+    std::fill(std::begin(node.children), std::end(node.children), NullNode);
+    node.subtreeCount = 0;
+    node.entries.clear();
+    return index;
+}
+
+void SceneOctree::FreeNode(int32_t node)
+{
+    ASSERT_MSG(m_nodes[node].subtreeCount == 0, "Freeing octree node %d that still holds objects", node);
+    m_nodes[node].halfSize = -1.0f;
+    m_freeNodes.push_back(node);
+}
+
+bool SceneOctree::Fits(const XMFLOAT3& center, float halfSize, const XMFLOAT3& minimum, const XMFLOAT3& maximum)
+{
+    const float loose = halfSize * 2.0f;
+    const float cx = (minimum.x + maximum.x) * 0.5f;
+    const float cy = (minimum.y + maximum.y) * 0.5f;
+    const float cz = (minimum.z + maximum.z) * 0.5f;
+    return std::fabs(cx - center.x) <= halfSize && std::fabs(cy - center.y) <= halfSize &&
+           std::fabs(cz - center.z) <= halfSize &&
+           minimum.x >= center.x - loose && maximum.x <= center.x + loose &&
+           minimum.y >= center.y - loose && maximum.y <= center.y + loose &&
+           minimum.z >= center.z - loose && maximum.z <= center.z + loose;
+}
+
+bool SceneOctree::GrowRoot(const XMFLOAT3& minimum, const XMFLOAT3& maximum)
+{
+    const XMFLOAT3 center((minimum.x + maximum.x) * 0.5f, (minimum.y + maximum.y) * 0.5f, (minimum.z + maximum.z) * 0.5f);
+    const float extent = std::max({ maximum.x - minimum.x, maximum.y - minimum.y, maximum.z - minimum.z }) * 0.5f;
+
+    // An empty root has no children left, so it can simply move to the object
+    if (m_nodes[m_root].subtreeCount == 0) {
+        float halfSize = m_initialHalfSize;
+        while (halfSize < extent && halfSize <= MaxRootHalfSize) halfSize *= 2.0f;
+        if (halfSize > MaxRootHalfSize) return false;
+        m_nodes[m_root].center = center;
+        m_nodes[m_root].halfSize = halfSize;
+        return Fits(center, halfSize, minimum, maximum);
+    }
+
+    // Otherwise double towards the object; the old root becomes one octant of the new one
+    while (!Fits(m_nodes[m_root].center, m_nodes[m_root].halfSize, minimum, maximum))
+    {
+        const Node& root = m_nodes[m_root];
+        const float halfSize = root.halfSize;
+        if (halfSize * 2.0f > MaxRootHalfSize) return false;
+
+        const float sx = center.x >= root.center.x ? 1.0f : -1.0f;
+        const float sy = center.y >= root.center.y ? 1.0f : -1.0f;
+        const float sz = center.z >= root.center.z ? 1.0f : -1.0f;
+        const XMFLOAT3 grownCenter(root.center.x + sx * halfSize, root.center.y + sy * halfSize, root.center.z + sz * halfSize);
+        const int octant = (sx < 0.0f ? 1 : 0) | (sy < 0.0f ? 2 : 0) | (sz < 0.0f ? 4 : 0);
+        const uint32_t count = root.subtreeCount;
+
+        const int32_t grown = AllocateNode(grownCenter, halfSize * 2.0f, NullNode);
+        m_nodes[grown].children[octant] = m_root;
+        m_nodes[grown].subtreeCount = count;
+        m_nodes[m_root].parent = grown;
+        m_root = grown;
+    }
+    return true;
+}
+
+int32_t SceneOctree::FindNode(const XMFLOAT3& minimum, const XMFLOAT3& maximum)
+{
+    if (!std::isfinite(minimum.x) || !std::isfinite(minimum.y) || !std::isfinite(minimum.z) ||
+        !std::isfinite(maximum.x) || !std::isfinite(maximum.y) || !std::isfinite(maximum.z))
+        return NullNode;
+    if (!Fits(m_nodes[m_root].center, m_nodes[m_root].halfSize, minimum, maximum) && !GrowRoot(minimum, maximum))
+        return NullNode;
+
+    const float cx = (minimum.x + maximum.x) * 0.5f;
+    const float cy = (minimum.y + maximum.y) * 0.5f;
+    const float cz = (minimum.z + maximum.z) * 0.5f;
+
+    // Descend while the octant holding the centre still fits the whole box
+    int32_t node = m_root;
+    for (;;)
+    {
+        const float childHalf = m_nodes[node].halfSize * 0.5f;
+        if (childHalf < m_minHalfSize) break;
+
+        const XMFLOAT3& center = m_nodes[node].center;
+        const int octant = (cx >= center.x ? 1 : 0) | (cy >= center.y ? 2 : 0) | (cz >= center.z ? 4 : 0);
+        const XMFLOAT3 childCenter(center.x + ((octant & 1) ? childHalf : -childHalf),
+                                   center.y + ((octant & 2) ? childHalf : -childHalf),
+                                   center.z + ((octant & 4) ? childHalf : -childHalf));
+        if (!Fits(childCenter, childHalf, minimum, maximum)) break;
+
+        int32_t child = m_nodes[node].children[octant];
+        if (child == NullNode) {
+            child = AllocateNode(childCenter, childHalf, node);
+            m_nodes[node].children[octant] = child;
+        }
+        node = child;
+    }
+    return node;
+}
+
+void SceneOctree::Link(Handle handle, int32_t node)
+{
+    Entry& entry = m_entries[handle];
+    entry.node = node;
+    if (node == NullNode) {
+        entry.slot = static_cast<uint32_t>(m_outside.size());
+        m_outside.push_back(handle);
+        return;
+    }
+
+    entry.slot = static_cast<uint32_t>(m_nodes[node].entries.size());
+    m_nodes[node].entries.push_back(handle);
+    for (int32_t n = node; n != NullNode; n = m_nodes[n].parent)
+        ++m_nodes[n].subtreeCount;
+}
+
+void SceneOctree::Unlink(Handle handle)
+{
+    const Entry& entry = m_entries[handle];
+    const int32_t node = entry.node;
+    std::vector<Handle>& list = node == NullNode ? m_outside : m_nodes[node].entries;
+
+    const Handle last = list.back();
+    list[entry.slot] = last;
+    m_entries[last].slot = entry.slot;
+    list.pop_back();
+    if (node == NullNode) return;
+
+    for (int32_t n = node; n != NullNode; n = m_nodes[n].parent)
+        --m_nodes[n].subtreeCount;
+
+    // Drop cells left empty; a cell with no objects below it has no children either
+    int32_t n = node;
+    while (n != m_root && m_nodes[n].subtreeCount == 0)
+    {
+        const int32_t parent = m_nodes[n].parent;
+        for (int32_t& child : m_nodes[parent].children)
+            if (child == n) child = NullNode;
+        FreeNode(n);
+        n = parent;
+    }
+}
+
+// ============================================================================
+// OBJECTS
+// ============================================================================
+
+SceneOctree::Handle SceneOctree::Insert(void* userData)
+{
+    Handle handle;
+    if (!m_freeHandles.empty()) {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    } else {
+        handle = static_cast<Handle>(m_entries.size());
+        m_entries.emplace_back();
+    }
+
+    Entry& entry = m_entries[handle];
+    entry = Entry();
+    entry.userData = userData;
+    entry.live = true;
+    Link(handle, NullNode);
+    ++m_liveCount;
+    return handle;
+}
+
+void SceneOctree::Remove(Handle handle)
+{
+    ASSERT_MSG(IsValid(handle), "Removing invalid octree handle %u", handle);
+    Unlink(handle);
+    m_entries[handle].live = false;
+    m_entries[handle].userData = nullptr;
+    m_freeHandles.push_back(handle);
+    --m_liveCount;
+}
+
+bool SceneOctree::SetBounds(Handle handle, const XMFLOAT3& minimum, const XMFLOAT3& maximum)
+{
+    ASSERT_MSG(IsValid(handle), "Setting bounds of invalid octree handle %u", handle);
+    ASSERT_MSG(minimum.x <= maximum.x && minimum.y <= maximum.y && minimum.z <= maximum.z,
+               "Octree bounds of handle %u are inverted", handle);
+    ++m_updates;
+
+    Entry& entry = m_entries[handle];
+    const bool wasBounded = entry.bounded;
+    entry.minimum = minimum;
+    entry.maximum = maximum;
+    entry.bounded = true;
+
+    // The common case: still inside the loose bounds of its cell
+    if (wasBounded && entry.node != NullNode) {
+        const Node& node = m_nodes[entry.node];
+        if (Fits(node.center, node.halfSize, minimum, maximum)) return false;
+    }
+
+    Unlink(handle);
+    Link(handle, FindNode(minimum, maximum));
+    if (wasBounded) ++m_relocations;
+    return true;
+}
+
+void SceneOctree::SetUnbounded(Handle handle)
+{
+    ASSERT_MSG(IsValid(handle), "Clearing bounds of invalid octree handle %u", handle);
+    Entry& entry = m_entries[handle];
+    entry.bounded = false;
+    if (entry.node != NullNode) {
+        Unlink(handle);
+        Link(handle, NullNode);
+    }
+}
+
+void SceneOctree::Clear()
+{
+    m_nodes.clear();
+    m_freeNodes.clear();
+    m_entries.clear();
+    m_freeHandles.clear();
+    m_outside.clear();
+    m_liveCount = 0;
+    m_root = AllocateNode(XMFLOAT3(0.0f, 0.0f, 0.0f), m_initialHalfSize, NullNode);
+}
+
+void* SceneOctree::GetUserData(Handle handle) const
+{
+    ASSERT_MSG(IsValid(handle), "Invalid octree handle %u", handle);
+    return m_entries[handle].userData;
+}
+
+bool SceneOctree::GetBounds(Handle handle, XMFLOAT3& minimum, XMFLOAT3& maximum) const
+{
+    ASSERT_MSG(IsValid(handle), "Invalid octree handle %u", handle);
+    const Entry& entry = m_entries[handle];
+    minimum = entry.minimum;
+    maximum = entry.maximum;
+    return entry.bounded;
+}
+
+bool SceneOctree::RayBox(const float origin[3], const float direction[3], const XMFLOAT3& minimum,
+                         const XMFLOAT3& maximum, float maxDistance, float& distance)
+{
+    const float lo[3] = { minimum.x, minimum.y, minimum.z };
+    const float hi[3] = { maximum.x, maximum.y, maximum.z };
+    float enter = 0.0f;
+    float exit = maxDistance;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (std::fabs(direction[axis]) < 1e-12f) {
+            if (origin[axis] < lo[axis] || origin[axis] > hi[axis]) return false;
+            continue;
+        }
+        const float inverse = 1.0f / direction[axis];
+        float t0 = (lo[axis] - origin[axis]) * inverse;
+        float t1 = (hi[axis] - origin[axis]) * inverse;
+        if (t0 > t1) std::swap(t0, t1);
+        enter = std::max(enter, t0);
+        exit = std::min(exit, t1);
+        if (enter > exit) return false;
+    }
+    distance = enter;
+    return true;
+}
+
+// ============================================================================
+// STATISTICS
+// ============================================================================
+
+int SceneOctree::GetDepth() const
+{
+    int depth = 0;
+    std::vector<std::pair<int32_t, int>> stack{ { m_root, 1 } };
+    while (!stack.empty())
+    {
+        const auto [node, level] = stack.back();
+        stack.pop_back();
+        depth = std::max(depth, level);
+        for (int32_t child : m_nodes[node].children)
+            if (child != NullNode) stack.push_back({ child, level + 1 });
+    }
+    return depth;
+}
+
+bool SceneOctree::Validate() const
+{
+    size_t inTree = 0;
+    for (Handle handle = 0; handle < m_entries.size(); ++handle)
+    {
+        const Entry& entry = m_entries[handle];
+        if (!entry.live) continue;
+        if (entry.node == NullNode) {
+            if (entry.slot >= m_outside.size() || m_outside[entry.slot] != handle) return false;
+            continue;
+        }
+        const Node& node = m_nodes[entry.node];
+        if (node.halfSize < 0.0f || !entry.bounded) return false;
+        if (entry.slot >= node.entries.size() || node.entries[entry.slot] != handle) return false;
+        if (!Fits(node.center, node.halfSize, entry.minimum, entry.maximum)) return false;
+        ++inTree;
+    }
+    if (inTree + m_outside.size() != m_liveCount || m_nodes[m_root].parent != NullNode) return false;
+
+    size_t liveNodes = 0;
+    for (int32_t index = 0; index < static_cast<int32_t>(m_nodes.size()); ++index)
+    {
+        const Node& node = m_nodes[index];
+        if (node.halfSize < 0.0f) continue;
+        ++liveNodes;
+
+        uint32_t count = static_cast<uint32_t>(node.entries.size());
+        for (int octant = 0; octant < 8; ++octant)
+        {
+            const int32_t child = node.children[octant];
+            if (child == NullNode) continue;
+            const Node& c = m_nodes[child];
+            if (c.halfSize != node.halfSize * 0.5f || c.parent != index || c.subtreeCount == 0) return false;
+            if ((c.center.x >= node.center.x) != ((octant & 1) != 0) || (c.center.y >= node.center.y) != ((octant & 2) != 0) ||
+                (c.center.z >= node.center.z) != ((octant & 4) != 0))
+                return false;
+            count += c.subtreeCount;
+        }
+        if (count != node.subtreeCount) return false;
+    }
+    return liveNodes == GetNodeCount() && m_nodes[m_root].subtreeCount == inTree;
+}
+
+// ============================================================================
+// CONSOLE INTEGRATION
+// ============================================================================
+
+std::string SceneOctree::Console_GetStats() const
+{
+    std::stringstream ss;
+    ss << GetCount() << " objects (" << GetUnboundedCount() << " beside the tree), " << GetNodeCount() << " cells, depth "
+       << GetDepth() << ", root half size " << GetRootHalfSize() << ", " << m_relocations << " relocations in "
+       << m_updates << " bounds updates";
+    return ss.str();
+}
+
+namespace
+{
+    struct CityObject
+    {
+        XMFLOAT3 minimum;
+        XMFLOAT3 maximum;
+        XMFLOAT3 velocity;      ///< Zero for static geometry
+    };
+
+    bool BoxesOverlap(const XMFLOAT3& aMin, const XMFLOAT3& aMax, const XMFLOAT3& bMin, const XMFLOAT3& bMax)
+    {
+        return aMin.x <= bMax.x && aMax.x >= bMin.x && aMin.y <= bMax.y && aMax.y >= bMin.y &&
+               aMin.z <= bMax.z && aMax.z >= bMin.z;
+    }
+
+    bool BoxInSphere(const XMFLOAT3& minimum, const XMFLOAT3& maximum, const XMFLOAT3& center, float radius)
+    {
+        const float dx = std::max({ minimum.x - center.x, 0.0f, center.x - maximum.x });
+        const float dy = std::max({ minimum.y - center.y, 0.0f, center.y - maximum.y });
+        const float dz = std::max({ minimum.z - center.z, 0.0f, center.z - maximum.z });
+        return dx * dx + dy * dy + dz * dz <= radius * radius;
+    }
+
+    bool BoxInFrustum(const XMFLOAT3& minimum, const XMFLOAT3& maximum, const Frustum& frustum)
+    {
+        for (const XMFLOAT4& plane : frustum.planes)
+        {
+            const float furthest = plane.x * (plane.x >= 0.0f ? maximum.x : minimum.x) +
+                                   plane.y * (plane.y >= 0.0f ? maximum.y : minimum.y) +
+                                   plane.z * (plane.z >= 0.0f ? maximum.z : minimum.z) + plane.w;
+            if (furthest < 0.0f) return false;
+        }
+        return true;
+    }
+
+    /**
+     * A square city of blocks separated by streets: buildings fill the
+     * blocks, street furniture and parked clutter lines them, and traffic
+     * drives along the streets. Roughly 15000 objects per square kilometre.
+     */
+    std::vector<CityObject> BuildCity(int objectCount, float& citySize)
+    {
+        constexpr float Block = 80.0f;
+        constexpr float Street = 20.0f;
+        constexpr float Pitch = Block + Street;
+        citySize = std::max(Pitch, std::round(8.0f * std::sqrt(static_cast<float>(objectCount)) / Pitch) * Pitch);
+
+        std::mt19937 rng(2025);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::vector<CityObject> objects;
+        objects.reserve(objectCount);
+
+        const int buildings = objectCount * 15 / 100;
+        const int vehicles = objectCount * 15 / 100;
+        for (int i = 0; i < objectCount; ++i)
+        {
+            // Snap a random point into a block or onto a street
+            const float blockX = std::floor(unit(rng) * citySize / Pitch) * Pitch;
+            const float blockZ = std::floor(unit(rng) * citySize / Pitch) * Pitch;
+            CityObject object{};
+            if (i < buildings) {
+                const float width = 8.0f + unit(rng) * 22.0f, depth = 8.0f + unit(rng) * 22.0f;
+                const float height = 6.0f + unit(rng) * unit(rng) * 114.0f;
+                const float x = blockX + unit(rng) * (Block - width), z = blockZ + unit(rng) * (Block - depth);
+                object.minimum = XMFLOAT3(x, 0.0f, z);
+                object.maximum = XMFLOAT3(x + width, height, z + depth);
+            } else if (i < buildings + vehicles) {
+                // Half the traffic runs along x, half along z, in the street after the block
+                const bool alongX = (i & 1) != 0;
+                const float speed = (5.0f + unit(rng) * 15.0f) * (unit(rng) < 0.5f ? -1.0f : 1.0f);
+                const float along = unit(rng) * (citySize - 5.0f);
+                const float lane = Block + 3.0f + unit(rng) * (Street - 8.0f);
+                const float x = alongX ? along : blockX + lane, z = alongX ? blockZ + lane : along;
+                object.minimum = XMFLOAT3(x, 0.0f, z);
+                object.maximum = XMFLOAT3(x + (alongX ? 4.5f : 1.8f), 1.5f, z + (alongX ? 1.8f : 4.5f));
+                object.velocity = alongX ? XMFLOAT3(speed, 0.0f, 0.0f) : XMFLOAT3(0.0f, 0.0f, speed);
+            } else {
+                const float size = 0.3f + unit(rng) * 2.7f;
+                const float x = blockX + unit(rng) * Pitch, z = blockZ + unit(rng) * Pitch;
+                const float y = unit(rng) < 0.2f ? unit(rng) * 30.0f : 0.0f;  // signs and balconies
+                object.minimum = XMFLOAT3(x, y, z);
+                object.maximum = XMFLOAT3(x + size * 0.5f, y + size, z + size * 0.5f);
+            }
+            objects.push_back(object);
+        }
+        return objects;
+    }
+}
+
+std::string SceneOctree::Console_Benchmark(int objectCount)
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto elapsedMs = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+    objectCount = std::clamp(objectCount, 1000, 2000000);
+
+    float citySize = 0.0f;
+    std::vector<CityObject> city = BuildCity(objectCount, citySize);
+
+    // Insert
+    SceneOctree octree;
+    std::vector<Handle> handles(city.size());
+    auto start = Clock::now();
+    for (size_t i = 0; i < city.size(); ++i) {
+        handles[i] = octree.Insert(&city[i]);
+        octree.SetBounds(handles[i], city[i].minimum, city[i].maximum);
+    }
+    const double insertMs = elapsedMs(start);
+    bool valid = octree.Validate();
+    const size_t nodesAfterInsert = octree.GetNodeCount();
+
+    // Move: one second of traffic, wrapping at the city edge
+    constexpr int MoveFrames = 60;
+    constexpr float FrameTime = 1.0f / 60.0f;
+    const uint64_t relocationsBefore = octree.GetRelocationCount();
+    size_t moved = 0;
+    start = Clock::now();
+    for (int frame = 0; frame < MoveFrames; ++frame)
+    {
+        for (size_t i = 0; i < city.size(); ++i)
+        {
+            CityObject& object = city[i];
+            if (object.velocity.x == 0.0f && object.velocity.z == 0.0f) continue;
+            float dx = object.velocity.x * FrameTime, dz = object.velocity.z * FrameTime;
+            if (object.maximum.x + dx > citySize || object.minimum.x + dx < 0.0f) dx -= std::copysign(citySize - 5.0f, dx);
+            if (object.maximum.z + dz > citySize || object.minimum.z + dz < 0.0f) dz -= std::copysign(citySize - 5.0f, dz);
+            object.minimum.x += dx; object.maximum.x += dx;
+            object.minimum.z += dz; object.maximum.z += dz;
+            octree.SetBounds(handles[i], object.minimum, object.maximum);
+            ++moved;
+        }
+    }
+    const double moveMs = elapsedMs(start) / MoveFrames;
+    const uint64_t relocations = octree.GetRelocationCount() - relocationsBefore;
+    valid = valid && octree.Validate();
+
+    // Queries, each checked against a flat walk over every object
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> ground(0.0f, citySize);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<Handle> treeResult, flatResult;
+    bool matches = true;
+
+    struct Timing { double treeMs = 0.0, flatMs = 0.0; size_t results = 0; int queries = 0; };
+    auto run = [&](Timing& timing, auto&& treeQuery, auto&& flatTest) {
+        treeResult.clear();
+        flatResult.clear();
+        auto queryStart = Clock::now();
+        treeQuery();
+        timing.treeMs += elapsedMs(queryStart);
+
+        queryStart = Clock::now();
+        for (size_t i = 0; i < city.size(); ++i)
+            if (flatTest(city[i])) flatResult.push_back(handles[i]);
+        timing.flatMs += elapsedMs(queryStart);
+
+        std::sort(treeResult.begin(), treeResult.end());
+        std::sort(flatResult.begin(), flatResult.end());
+        matches = matches && treeResult == flatResult;
+        timing.results += treeResult.size();
+        ++timing.queries;
+    };
+    auto collect = [&](Handle handle) { treeResult.push_back(handle); return true; };
+
+    // Street-level cameras looking along the city
+    Timing frustumTiming;
+    const XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.1f, 1000.0f);
+    for (int i = 0; i < 16; ++i)
+    {
+        const float yaw = unit(rng) * XM_2PI;
+        const XMMATRIX view = XMMatrixLookToLH(XMVectorSet(ground(rng), 1.8f, ground(rng), 1.0f),
+                                               XMVectorSet(std::sin(yaw), -0.05f, std::cos(yaw), 0.0f),
+                                               XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+        const Frustum frustum = Frustum::FromViewProjection(XMMatrixMultiply(view, projection));
+        run(frustumTiming, [&]() { octree.QueryFrustum(frustum, collect); },
+            [&](const CityObject& object) { return BoxInFrustum(object.minimum, object.maximum, frustum); });
+    }
+
+    // Gameplay radius queries (explosions, AI senses) and editor box selection
+    Timing sphereTiming, boxTiming;
+    for (int i = 0; i < 200; ++i)
+    {
+        const XMFLOAT3 center(ground(rng), 1.0f, ground(rng));
+        run(sphereTiming, [&]() { octree.QuerySphere(center, 25.0f, collect); },
+            [&](const CityObject& object) { return BoxInSphere(object.minimum, object.maximum, center, 25.0f); });
+
+        const XMFLOAT3 boxMin(center.x - 30.0f, 0.0f, center.z - 30.0f), boxMax(center.x + 30.0f, 20.0f, center.z + 30.0f);
+        run(boxTiming, [&]() { octree.QueryAABB(boxMin, boxMax, collect); },
+            [&](const CityObject& object) { return BoxesOverlap(object.minimum, object.maximum, boxMin, boxMax); });
+    }
+
+    // Picking: closest box along rays from eye height
+    Timing rayTiming;
+    for (int i = 0; i < 200; ++i)
+    {
+        const float yaw = unit(rng) * XM_2PI, pitch = -unit(rng) * 0.5f;
+        const float origin[3] = { ground(rng), 1.8f, ground(rng) };
+        const float direction[3] = { std::cos(pitch) * std::sin(yaw), std::sin(pitch), std::cos(pitch) * std::cos(yaw) };
+        constexpr float Range = 500.0f;
+
+        Handle treeHit = InvalidHandle, flatHit = InvalidHandle;
+        float treeDistance = Range, flatDistance = Range;
+        auto queryStart = Clock::now();
+        octree.RayCast(XMFLOAT3(origin[0], origin[1], origin[2]), XMFLOAT3(direction[0], direction[1], direction[2]), Range,
+            [&](Handle handle, float distance, float) {
+                if (distance < treeDistance) {
+                    treeDistance = distance;
+                    treeHit = handle;
+                }
+                return treeDistance;
+            });
+        rayTiming.treeMs += elapsedMs(queryStart);
+
+        queryStart = Clock::now();
+        for (size_t j = 0; j < city.size(); ++j)
+        {
+            float distance = 0.0f;
+            if (RayBox(origin, direction, city[j].minimum, city[j].maximum, flatDistance, distance) &&
+                distance < flatDistance) {
+                flatDistance = distance;
+                flatHit = handles[j];
+            }
+        }
+        rayTiming.flatMs += elapsedMs(queryStart);
+
+        // Several boxes can share the closest distance (a ray starting inside two of them), so compare distances
+        matches = matches && (treeHit == InvalidHandle) == (flatHit == InvalidHandle) && treeDistance == flatDistance;
+        rayTiming.results += treeHit != InvalidHandle ? 1 : 0;
+        ++rayTiming.queries;
+    }
+
+    // Remove: every other object, then the index must still agree with its contents
+    for (size_t i = 0; i < handles.size(); i += 2) octree.Remove(handles[i]);
+    valid = valid && octree.Validate() && octree.GetCount() == handles.size() / 2;
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "=== Scene Octree Benchmark ===\n";
+    ss << city.size() << " objects in a " << citySize << " m city, " << nodesAfterInsert << " cells, depth "
+       << octree.GetDepth() << "\n";
+    ss << "Insert: " << insertMs << " ms\n";
+    ss << "Move:   " << moveMs << " ms/frame for " << moved / MoveFrames << " vehicles, " << relocations
+       << " relocations over " << MoveFrames << " frames\n";
+    auto report = [&](const char* name, const Timing& timing, const char* unitName) {
+        const double treeMs = timing.treeMs / timing.queries, flatMs = timing.flatMs / timing.queries;
+        ss << name << treeMs << " ms vs flat " << flatMs << " ms (" << flatMs / std::max(treeMs, 1e-6) << "x), "
+           << static_cast<double>(timing.results) / timing.queries << " " << unitName << "/query\n";
+    };
+    report("Frustum: ", frustumTiming, "objects");
+    report("Sphere:  ", sphereTiming, "objects");
+    report("Box:     ", boxTiming, "objects");
+    report("Ray:     ", rayTiming, "hits");
+    ss << "Results match flat walk: " << (matches ? "yes" : "NO") << ", structure valid: " << (valid ? "yes" : "NO")
+       << "\n";
+    return ss.str();
+}
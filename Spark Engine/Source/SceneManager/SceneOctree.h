@@ -0,0 +1,365 @@
+/**
+ * @file SceneOctree.h
+ * @brief Loose octree indexing scene objects by world bounds
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * Every renderable is filed in the smallest cell whose loose bounds (the
+ * cell expanded to twice its size) contain its world box; the object's
+ * centre picks the cell at each level. Because the loose bounds leave room
+ * to move, an object only changes cell when its centre crosses into a
+ * neighbour or it grows, so static geometry never touches the tree and
+ * moving objects relocate rarely.
+ *
+ * Frustum, sphere, box and ray queries reject whole cells at a time. A cell
+ * that lies completely inside a volume query reports its subtree without
+ * testing the objects, since their boxes are contained in the cell's loose
+ * bounds. The root grows outwards as objects are added beyond it.
+ */
+
+#pragma once
+
+#include "Graphics/CullingSystem.h"
+#include "Utils/Assert.h"
+#include <DirectXMath.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Loose octree over world-space AABBs keyed by stable handles
+ *
+ * Objects without usable bounds (SetUnbounded) sit in a list beside the tree;
+ * they overlap every volume query and are never hit by rays.
+ *
+ * @note Not thread-safe for mutation; concurrent const queries are fine.
+ */
+class SceneOctree
+{
+public:
+    using Handle = uint32_t;
+    static constexpr Handle InvalidHandle = 0xFFFFFFFFu;
+    static constexpr int32_t NullNode = -1;
+
+    /// Objects further out than this stay beside the tree instead of growing it
+    static constexpr float MaxRootHalfSize = 1.0e6f;
+
+    /**
+     * @param minHalfSize Cells are never split below this half size
+     * @param initialHalfSize Half size of the root before it grows
+     */
+    explicit SceneOctree(float minHalfSize = 8.0f, float initialHalfSize = 64.0f);
+
+    // ========================================================================
+    // OBJECTS
+    // ========================================================================
+
+    /**
+     * @brief Add an object; it is unbounded until SetBounds()
+     * @param userData Returned by GetUserData() for the handle
+     */
+    Handle Insert(void* userData);
+    void Remove(Handle handle);
+
+    /**
+     * @brief Update an object's world box, moving it to another cell only if it no longer fits its own
+     * @return true if the object changed cell
+     */
+    bool SetBounds(Handle handle, const DirectX::XMFLOAT3& minimum, const DirectX::XMFLOAT3& maximum);
+    void SetUnbounded(Handle handle);
+
+    /**
+     * @brief Remove every object and cell
+     */
+    void Clear();
+
+    bool IsValid(Handle handle) const { return handle < m_entries.size() && m_entries[handle].live; }
+    void* GetUserData(Handle handle) const;
+    bool GetBounds(Handle handle, DirectX::XMFLOAT3& minimum, DirectX::XMFLOAT3& maximum) const;
+
+    // ========================================================================
+    // QUERIES
+    // ========================================================================
+
+    /**
+     * @brief Visit every object whose box overlaps the query box
+     * @param callback Invoked as bool(Handle); return false to stop the query
+     */
+    template<typename Callback>
+    void QueryAABB(const DirectX::XMFLOAT3& minimum, const DirectX::XMFLOAT3& maximum, Callback&& callback) const;
+
+    /**
+     * @brief Visit every object whose box is within radius of centre
+     */
+    template<typename Callback>
+    void QuerySphere(const DirectX::XMFLOAT3& center, float radius, Callback&& callback) const;
+
+    /**
+     * @brief Visit every object whose box is not completely outside one of the frustum planes
+     */
+    template<typename Callback>
+    void QueryFrustum(const Frustum& frustum, Callback&& callback) const;
+
+    /**
+     * @brief Visit every object whose box is crossed by the ray segment
+     *
+     * The callback is invoked as float(Handle, float boxDistance, float
+     * maxDistance) and returns the new clip distance, as in
+     * DynamicAABBTree::RayCast(): maxDistance to keep going, boxDistance for
+     * closest-hit picking against the boxes, or 0 to stop.
+     *
+     * @param direction Normalized ray direction
+     */
+    template<typename Callback>
+    void RayCast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance,
+                 Callback&& callback) const;
+
+    // ========================================================================
+    // STATISTICS
+    // ========================================================================
+
+    size_t GetCount() const { return m_liveCount; }
+    size_t GetUnboundedCount() const { return m_outside.size(); }
+    size_t GetNodeCount() const { return m_nodes.size() - m_freeNodes.size(); }
+    int GetDepth() const;
+    float GetRootHalfSize() const { return m_nodes[m_root].halfSize; }
+    uint64_t GetUpdateCount() const { return m_updates; }
+    uint64_t GetRelocationCount() const { return m_relocations; }
+
+    /**
+     * @brief Check cell membership, loose containment, subtree counts and links
+     * @return false on the first inconsistency
+     */
+    bool Validate() const;
+
+    // ========================================================================
+    // CONSOLE INTEGRATION
+    // ========================================================================
+
+    std::string Console_GetStats() const;
+
+    /**
+     * @brief Build a synthetic city, move its traffic and time queries against flat walks
+     *
+     * Every query result is compared with a brute-force walk over the same boxes.
+     * @param objectCount Buildings, props and vehicles in the city
+     */
+    static std::string Console_Benchmark(int objectCount);
+
+private:
+    enum class Overlap : uint8_t { Outside, Partial, Inside };
+
+    struct Entry
+    {
+        DirectX::XMFLOAT3 minimum{};
+        DirectX::XMFLOAT3 maximum{};
+        void* userData = nullptr;
+        int32_t node = NullNode;    ///< Owning cell, NullNode while beside the tree
+        uint32_t slot = 0;          ///< Index in the owning list
+        bool live = false;
+        bool bounded = false;
+    };
+
+    struct Node
+    {
+        DirectX::XMFLOAT3 center{};
+        float halfSize = -1.0f;     ///< Tight half size; negative for free nodes
+        int32_t parent = NullNode;
+        int32_t children[8] = { NullNode, NullNode, NullNode, NullNode, NullNode, NullNode, NullNode, NullNode };
+        uint32_t subtreeCount = 0;  ///< Objects in this cell and below
+        std::vector<Handle> entries;
+    };
+
+    static constexpr int MaxStack = 256;
+
+    int32_t AllocateNode(const DirectX::XMFLOAT3& center, float halfSize, int32_t parent);
+    void FreeNode(int32_t node);
+
+    /// Box centre lies in the tight cell and the box in the loose cell
+    static bool Fits(const DirectX::XMFLOAT3& center, float halfSize, const DirectX::XMFLOAT3& minimum,
+                     const DirectX::XMFLOAT3& maximum);
+
+    /// Cell the box belongs in, growing the root or creating cells as needed; NullNode if it stays beside the tree
+    int32_t FindNode(const DirectX::XMFLOAT3& minimum, const DirectX::XMFLOAT3& maximum);
+    bool GrowRoot(const DirectX::XMFLOAT3& minimum, const DirectX::XMFLOAT3& maximum);
+
+    void Link(Handle handle, int32_t node);
+    void Unlink(Handle handle);
+
+    static void LooseBounds(const Node& node, DirectX::XMFLOAT3& minimum, DirectX::XMFLOAT3& maximum)
+    {
+        const float loose = node.halfSize * 2.0f;
+        minimum = { node.center.x - loose, node.center.y - loose, node.center.z - loose };
+        maximum = { node.center.x + loose, node.center.y + loose, node.center.z + loose };
+    }
+
+    /// Slab test; distance is 0 when the origin is inside the box
+    static bool RayBox(const float origin[3], const float direction[3], const DirectX::XMFLOAT3& minimum,
+                       const DirectX::XMFLOAT3& maximum, float maxDistance, float& distance);
+
+    template<typename NodeTest, typename EntryTest, typename Callback>
+    void QueryVolume(NodeTest&& nodeTest, EntryTest&& entryTest, Callback&& callback) const;
+
+    std::vector<Node> m_nodes;
+    std::vector<int32_t> m_freeNodes;
+    int32_t m_root = NullNode;
+    float m_minHalfSize = 8.0f;
+    float m_initialHalfSize = 64.0f;
+
+    std::vector<Entry> m_entries;
+    std::vector<Handle> m_freeHandles;
+    std::vector<Handle> m_outside;  ///< Unbounded or out-of-range objects
+    size_t m_liveCount = 0;
+
+    uint64_t m_updates = 0;
+    uint64_t m_relocations = 0;
+};
+
+// ============================================================================
+// TEMPLATE IMPLEMENTATION
+// ============================================================================
+
+template<typename NodeTest, typename EntryTest, typename Callback>
+void SceneOctree::QueryVolume(NodeTest&& nodeTest, EntryTest&& entryTest, Callback&& callback) const
+{
+    for (Handle handle : m_outside) {
+        const Entry& entry = m_entries[handle];
+        if ((!entry.bounded || entryTest(entry.minimum, entry.maximum)) && !callback(handle)) return;
+    }
+    if (m_nodes[m_root].subtreeCount == 0) return;
+
+    // Cells found inside the volume pass their flag down so nothing below them is tested
+    struct Item { int32_t node; bool inside; };
+    Item stack[MaxStack];
+    int count = 0;
+    stack[count++] = { m_root, false };
+
+    while (count > 0)
+    {
+        const Item item = stack[--count];
+        const Node& node = m_nodes[item.node];
+        bool inside = item.inside;
+        if (!inside) {
+            DirectX::XMFLOAT3 looseMin, looseMax;
+            LooseBounds(node, looseMin, looseMax);
+            const Overlap overlap = nodeTest(looseMin, looseMax);
+            if (overlap == Overlap::Outside) continue;
+            inside = overlap == Overlap::Inside;
+        }
+
+        for (Handle handle : node.entries) {
+            const Entry& entry = m_entries[handle];
+            if ((inside || entryTest(entry.minimum, entry.maximum)) && !callback(handle)) return;
+        }
+        for (int32_t child : node.children) {
+            if (child == NullNode) continue;
+            ASSERT_MSG(count < MaxStack, "Octree traversal stack overflow (%d)", count);
+            stack[count++] = { child, inside };
+        }
+    }
+}
+
+template<typename Callback>
+void SceneOctree::QueryAABB(const DirectX::XMFLOAT3& minimum, const DirectX::XMFLOAT3& maximum, Callback&& callback) const
+{
+    auto overlaps = [&](const DirectX::XMFLOAT3& lo, const DirectX::XMFLOAT3& hi) {
+        return lo.x <= maximum.x && hi.x >= minimum.x && lo.y <= maximum.y && hi.y >= minimum.y &&
+               lo.z <= maximum.z && hi.z >= minimum.z;
+    };
+    QueryVolume(
+        [&](const DirectX::XMFLOAT3& lo, const DirectX::XMFLOAT3& hi) {
+            if (!overlaps(lo, hi)) return Overlap::Outside;
+            const bool inside = lo.x >= minimum.x && hi.x <= maximum.x && lo.y >= minimum.y && hi.y <= maximum.y &&
+                                lo.z >= minimum.z && hi.z <= maximum.z;
+            return inside ? Overlap::Inside : Overlap::Partial;
+        },
+        overlaps, callback);
+}
+
+template<typename Callback>
+void SceneOctree::QuerySphere(const DirectX::XMFLOAT3& center, float radius, Callback&& callback) const
+{
+    const float radiusSq = radius * radius;
+    auto nearestSq = [&](const DirectX::XMFLOAT3& lo, const DirectX::XMFLOAT3& hi) {
+        const float dx = std::max({ lo.x - center.x, 0.0f, center.x - hi.x });
+        const float dy = std::max({ lo.y - center.y, 0.0f, center.y - hi.y });
+        const float dz = std::max({ lo.z - center.z, 0.0f, center.z - hi.z });
+        return dx * dx + dy * dy + dz * dz;
+    };
+    QueryVolume(
+        [&](const DirectX::XMFLOAT3& lo, const DirectX::XMFLOAT3& hi) {
+            if (nearestSq(lo, hi) > radiusSq) return Overlap::Outside;
+            const float dx = std::max(center.x - lo.x, hi.x - center.x);
+            const float dy = std::max(center.y - lo.y, hi.y - center.y);
+            const float dz = std::max(center.z - lo.z, hi.z - center.z);
+            return dx * dx + dy * dy + dz * dz <= radiusSq ? Overlap::Inside : Overlap::Partial;
+        },
+        [&](const DirectX::XMFLOAT3& lo, const DirectX::XMFLOAT3& hi) { return nearestSq(lo, hi) <= radiusSq; },
+        callback);
+}
+
+template<typename Callback>
+void SceneOctree::QueryFrustum(const Frustum& frustum, Callback&& callback) const
+{
+    // Per plane, the corner furthest along the normal decides rejection and the nearest decides containment
+    auto test = [&](const DirectX::XMFLOAT3& lo, const DirectX::XMFLOAT3& hi) {
+        Overlap result = Overlap::Inside;
+        for (const DirectX::XMFLOAT4& plane : frustum.planes) {
+            const float furthest = plane.x * (plane.x >= 0.0f ? hi.x : lo.x) + plane.y * (plane.y >= 0.0f ? hi.y : lo.y) +
+                              plane.z * (plane.z >= 0.0f ? hi.z : lo.z) + plane.w;
+            if (furthest < 0.0f) return Overlap::Outside;
+            const float nearest = plane.x * (plane.x >= 0.0f ? lo.x : hi.x) + plane.y * (plane.y >= 0.0f ? lo.y : hi.y) +
+                               plane.z * (plane.z >= 0.0f ? lo.z : hi.z) + plane.w;
+            if (nearest < 0.0f) result = Overlap::Partial;
+        }
+        return result;
+    };
+    QueryVolume(test,
+        [&](const DirectX::XMFLOAT3& lo, const DirectX::XMFLOAT3& hi) { return test(lo, hi) != Overlap::Outside; },
+        callback);
+}
+
+template<typename Callback>
+void SceneOctree::RayCast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance,
+                          Callback&& callback) const
+{
+    ASSERT_MSG(std::fabs(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z - 1.0f) < 1e-3f,
+               "Ray direction must be normalized (length %f)",
+               std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z));
+    const float o[3] = { origin.x, origin.y, origin.z };
+    const float d[3] = { direction.x, direction.y, direction.z };
+
+    auto visit = [&](Handle handle) {
+        const Entry& entry = m_entries[handle];
+        float distance = 0.0f;
+        if (entry.bounded && RayBox(o, d, entry.minimum, entry.maximum, maxDistance, distance))
+            maxDistance = callback(handle, distance, maxDistance);
+        return maxDistance > 0.0f;
+    };
+
+    for (Handle handle : m_outside)
+        if (!visit(handle)) return;
+    if (m_nodes[m_root].subtreeCount == 0) return;
+
+    int32_t stack[MaxStack];
+    int count = 0;
+    stack[count++] = m_root;
+    while (count > 0)
+    {
+        const Node& node = m_nodes[stack[--count]];
+        DirectX::XMFLOAT3 looseMin, looseMax;
+        LooseBounds(node, looseMin, looseMax);
+        float distance = 0.0f;
+        if (!RayBox(o, d, looseMin, looseMax, maxDistance, distance)) continue;
+
+        for (Handle handle : node.entries)
+            if (!visit(handle)) return;
+        for (int32_t child : node.children) {
+            if (child == NullNode) continue;
+            ASSERT_MSG(count < MaxStack, "Octree traversal stack overflow (%d)", count);
+            stack[count++] = child;
+        }
+    }
+}
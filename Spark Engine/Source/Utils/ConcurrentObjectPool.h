@@ -0,0 +1,304 @@
+﻿/**
+ * @file ConcurrentObjectPool.h
+ * @brief Lock-free object pool for objects acquired and released on different threads
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * Asset loaders, audio callbacks and gameplay jobs routinely hand pooled
+ * objects to each other: one thread acquires, another releases. ObjectPool's
+ * per-thread magazines only help when the same thread does both, so here the
+ * free list itself is a lock-free stack. Its head packs the top slot index,
+ * the free count and a modification tag into one 64-bit word; the tag changes
+ * on every push and pop, so a compare-and-swap can never succeed against a
+ * head that was popped and pushed back in between (the ABA problem).
+ */
+
+#pragma once
+
+#include "Utils/Assert.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+
+/**
+ * @brief Fixed-capacity pool whose Acquire() and Release() never block
+ *
+ * Storage for every object is reserved up front in one contiguous array;
+ * objects are constructed lazily the first time their slot is handed out,
+ * with the constructor callback (which must then be thread safe) or T's
+ * default constructor. Release() calls T::Reset() when the type provides one.
+ *
+ * Handles use the same layout as ObjectPool::Handle: a 20-bit slot index and
+ * a 12-bit generation that is bumped on every release.
+ */
+template<typename T>
+class ConcurrentObjectPool
+{
+public:
+    using Handle = uint32_t;
+
+    static constexpr uint32_t IndexBits      = 20;
+    static constexpr uint32_t GenerationBits = 32 - IndexBits;
+    static constexpr uint32_t MaxObjects     = (1u << IndexBits) - 1;   ///< Last index marks an empty stack
+    static constexpr Handle   InvalidHandle  = 0;
+
+    /// Constructs one T in place at the given slot storage, as ObjectPool::Constructor
+    using Constructor = std::function<void(void* storage)>;
+
+    explicit ConcurrentObjectPool(size_t maxSize = 100)
+        : m_slots(std::make_unique<Slot[]>(maxSize))
+        , m_maxSize(static_cast<uint32_t>(maxSize))
+    {
+        ASSERT_MSG(maxSize > 0, "ConcurrentObjectPool maxSize must be positive (got %zu)", maxSize);
+        ASSERT_MSG(maxSize <= MaxObjects, "ConcurrentObjectPool maxSize %zu exceeds handle range", maxSize);
+    }
+
+    ConcurrentObjectPool(size_t maxSize, Constructor constructor)
+        : ConcurrentObjectPool(maxSize)
+    {
+        ASSERT_MSG(constructor != nullptr, "ConcurrentObjectPool constructor must not be null (maxSize %zu)", maxSize);
+        m_constructor = std::move(constructor);
+
+        // Pre-allocate objects
+        for (size_t i = 0; i < maxSize; ++i)
+            Push(Construct());
+    }
+
+    ~ConcurrentObjectPool()
+    {
+        const uint32_t constructed = GetConstructed();
+        for (uint32_t i = 0; i < constructed; ++i)
+            ObjectAt(i)->~T();
+    }
+
+    ConcurrentObjectPool(const ConcurrentObjectPool&) = delete;
+    ConcurrentObjectPool& operator=(const ConcurrentObjectPool&) = delete;
+
+    // ========================================================================
+    // ACQUIRE / RELEASE
+    // ========================================================================
+
+    /**
+     * @brief Take an object from the pool; safe from any thread
+     * @return nullptr when all maxSize objects are in use
+     */
+    T* Acquire()
+    {
+        const uint32_t index = AcquireIndex();
+        return index == NilIndex ? nullptr : ObjectAt(index);
+    }
+
+    /**
+     * @brief Return an object to the pool from any thread, calling Reset() on it if available
+     */
+    void Release(T* obj)
+    {
+        if (!obj) return;
+
+        const uint32_t index = IndexOf(obj);
+        ASSERT_MSG(index < m_maxSize, "ConcurrentObjectPool::Release given an object from another pool (slot %u)", index);
+        Slot& slot = m_slots[index];
+        const uint32_t state = slot.state.load(std::memory_order_relaxed);
+        ASSERT_MSG((state & InUseBit) != 0, "ConcurrentObjectPool slot %u released twice", index);
+
+        // Reset object if it supports Reset()
+        if constexpr (requires { obj->Reset(); })
+        {
+            obj->Reset();
+        }
+
+        slot.state.store(NextGeneration(state >> 1) << 1, std::memory_order_release);
+        Push(index);
+    }
+
+    // ========================================================================
+    // GENERATIONAL HANDLES
+    // ========================================================================
+
+    Handle AcquireHandle()
+    {
+        const uint32_t index = AcquireIndex();
+        return index == NilIndex ? InvalidHandle : MakeHandle(index, m_slots[index].state.load(std::memory_order_relaxed) >> 1);
+    }
+
+    Handle GetHandle(const T* obj) const
+    {
+        if (!obj) return InvalidHandle;
+        const uint32_t index = IndexOf(obj);
+        const uint32_t state = m_slots[index].state.load(std::memory_order_acquire);
+        return (state & InUseBit) ? MakeHandle(index, state >> 1) : InvalidHandle;
+    }
+
+    /**
+     * @brief Resolve a handle
+     * @return The object, or nullptr if it was released since the handle was issued
+     */
+    T* Get(Handle handle) const
+    {
+        return IsValid(handle) ? ObjectAt(handle & IndexMask) : nullptr;
+    }
+
+    bool IsValid(Handle handle) const
+    {
+        const uint32_t index = handle & IndexMask;
+        if (handle == InvalidHandle || index >= m_maxSize) return false;
+        return m_slots[index].state.load(std::memory_order_acquire) == (((handle >> IndexBits) << 1) | InUseBit);
+    }
+
+    /**
+     * @brief Release the object behind a handle
+     * @return false if the handle was stale
+     * @note Two threads releasing the same live handle at once is still a double release
+     */
+    bool ReleaseHandle(Handle handle)
+    {
+        T* obj = Get(handle);
+        if (!obj) return false;
+        Release(obj);
+        return true;
+    }
+
+    // Stats (approximate while other threads are active)
+    size_t GetTotalSize()      const { return GetConstructed(); }
+    size_t GetAvailableCount() const { return CountOf(m_head.load(std::memory_order_relaxed)); }
+    size_t GetUsedCount()      const { return GetTotalSize() - GetAvailableCount(); }
+    size_t GetMaxSize()        const { return m_maxSize; }
+
+private:
+    static constexpr uint32_t NilIndex       = MaxObjects;
+    static constexpr uint32_t IndexMask      = (1u << IndexBits) - 1;
+    static constexpr uint32_t GenerationMask = (1u << GenerationBits) - 1;
+    static constexpr uint32_t InUseBit       = 1;
+
+    // Stack head layout: [tag:24][free count:20][top index:20]
+    static constexpr uint32_t CountShift     = IndexBits;
+    static constexpr uint32_t TagShift       = IndexBits * 2;
+
+    struct Slot
+    {
+        alignas(T) unsigned char storage[sizeof(T)];
+        std::atomic<uint32_t> next{ NilIndex };    ///< Intrusive stack link, read by racing pops
+        std::atomic<uint32_t> state{ 0 };          ///< (generation << 1) | in-use; 0 until constructed
+    };
+
+    static Handle MakeHandle(uint32_t index, uint32_t generation) { return (generation << IndexBits) | index; }
+    static uint32_t NextGeneration(uint32_t generation) { return generation >= GenerationMask ? 1 : generation + 1; }
+
+    static uint32_t TopOf(uint64_t head) { return static_cast<uint32_t>(head) & IndexMask; }
+    static uint32_t CountOf(uint64_t head) { return static_cast<uint32_t>(head >> CountShift) & IndexMask; }
+    static uint64_t Pack(uint32_t index, uint32_t count, uint64_t previousHead)
+    {
+        const uint64_t tag = (previousHead >> TagShift) + 1;
+        return (tag << TagShift) | (static_cast<uint64_t>(count) << CountShift) | index;
+    }
+
+    T* ObjectAt(uint32_t index) const
+    {
+        return std::launder(reinterpret_cast<T*>(const_cast<unsigned char*>(m_slots[index].storage)));
+    }
+
+    uint32_t IndexOf(const T* obj) const
+    {
+        return static_cast<uint32_t>(reinterpret_cast<const Slot*>(obj) - m_slots.get());
+    }
+
+    uint32_t GetConstructed() const
+    {
+        const uint32_t claimed = m_nextUnconstructed.load(std::memory_order_relaxed);
+        return claimed < m_maxSize ? claimed : m_maxSize;
+    }
+
+    uint32_t AcquireIndex()
+    {
+        uint32_t index = Pop();
+        if (index == NilIndex)
+        {
+            // Stack empty: claim a slot that has never been handed out
+            if (m_nextUnconstructed.load(std::memory_order_relaxed) >= m_maxSize) return NilIndex;
+            index = Construct();
+            if (index == NilIndex) return NilIndex;
+        }
+
+        Slot& slot = m_slots[index];
+        slot.state.store(slot.state.load(std::memory_order_relaxed) | InUseBit, std::memory_order_release);
+        return index;
+    }
+
+    void Push(uint32_t index)
+    {
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        uint64_t newHead;
+        do
+        {
+            m_slots[index].next.store(TopOf(head), std::memory_order_relaxed);
+            newHead = Pack(index, CountOf(head) + 1, head);
+        }
+        while (!m_head.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    uint32_t Pop()
+    {
+        uint64_t head = m_head.load(std::memory_order_acquire);
+        while (TopOf(head) != NilIndex)
+        {
+            // A racing pop may already have reused this slot; the tag makes the CAS fail then
+            const uint32_t next = m_slots[TopOf(head)].next.load(std::memory_order_relaxed);
+            if (m_head.compare_exchange_weak(head, Pack(next, CountOf(head) - 1, head),
+                                             std::memory_order_acquire, std::memory_order_acquire))
+                return TopOf(head);
+        }
+        return NilIndex;
+    }
+
+    /// Construct a never-used slot; returns NilIndex once every slot was claimed
+    uint32_t Construct()
+    {
+        const uint32_t index = m_nextUnconstructed.fetch_add(1, std::memory_order_relaxed);
+        if (index >= m_maxSize) return NilIndex;
+
+        Slot& slot = m_slots[index];
+        if (m_constructor)
+        {
+            m_constructor(static_cast<void*>(slot.storage));
+        }
+        else if constexpr (std::is_default_constructible_v<T>)
+        {
+            ::new (static_cast<void*>(slot.storage)) T();
+        }
+        else
+        {
+            ASSERT_ALWAYS_MSG(false, "ConcurrentObjectPool needs a constructor for types without a default constructor (slot %u)", index);
+        }
+
+        slot.state.store(1u << 1, std::memory_order_release);
+        return index;
+    }
+
+    std::unique_ptr<Slot[]>                m_slots;
+    Constructor                            m_constructor;
+    uint32_t                               m_maxSize;
+
+    alignas(64) std::atomic<uint64_t>      m_head{ NilIndex };           ///< Empty stack, count 0, tag 0
+    alignas(64) std::atomic<uint32_t>      m_nextUnconstructed{ 0 };
+};
+
+// ============================================================================
+// CONSOLE INTEGRATION
+// ============================================================================
+
+/**
+ * @brief Hammer a ConcurrentObjectPool with cross-thread acquire/release
+ *
+ * Threads trade objects through a shared exchange table with random yields
+ * mixed in to vary the interleaving, checking that no object is ever handed
+ * to two owners, that released handles go stale and that the pool's counts
+ * add up once every thread has finished.
+ *
+ * @param threads Worker threads
+ * @param operations Acquire/release pairs per thread
+ */
+std::string StressConcurrentObjectPool(int threads, int operations);
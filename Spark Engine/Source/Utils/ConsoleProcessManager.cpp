@@ -20,9 +20,7 @@ ConsoleProcessManager& GetConsoleProcessManagerInstance() {
 }
 
 ConsoleProcessManager::ConsoleProcessManager() 
-    : m_commandRegistry(std::make_unique<CommandRegistry>()) 
-    , m_consoleThread()
-    , m_shouldStopThread(false) {
+    : m_commandRegistry(std::make_unique<CommandRegistry>()) {
     
     // Register default commands
     m_commandRegistry->RegisterCommand("help", 
@@ -213,17 +211,17 @@ bool ConsoleProcessManager::Initialize(const std::wstring& consolePath) {
     m_initialized = true;
     
     if (success) {
-        // **NEW: Start the background console management thread**
-        m_shouldStopThread = false;
-        m_consoleThread = std::thread(&ConsoleProcessManager::ConsoleThreadMain, this);
+        // Console I/O runs in pump jobs on the JobSystem
+        m_shouldStopPump = false;
+        KickPump();
         
         OutputDebugStringW(L"=== EXTERNAL CONSOLE INITIALIZED ===\n");
         Log(L"External console system initialized successfully", L"SUCCESS");
-        Log(L"Console management thread started", L"INFO");
+        Log(L"Console pump scheduled on the job system", L"INFO");
         Log(L"Assert and crash logging integrated with external console", L"INFO");
         Log(L"SparkConsole.exe launched from: " + actualPath, L"INFO");
         Log(L"You should see a separate SparkConsole.exe window", L"INFO");
-        OutputDebugStringW(L"SUCCESS: External console system initialized with multithreading\n");
+        OutputDebugStringW(L"SUCCESS: External console system initialized\n");
         OutputDebugStringW(L"===================================\n");
     } else {
         OutputDebugStringW(L"=== EXTERNAL CONSOLE LAUNCH FAILED ===\n");
@@ -243,20 +241,19 @@ void ConsoleProcessManager::Shutdown() {
         return;
     }
     
-    // **NEW: Stop the background thread first**
-    m_shouldStopThread = true;
-    if (m_consoleThread.joinable()) {
-        m_consoleThread.join();
-        Log(L"Console management thread stopped", L"INFO");
-    }
-    
-    m_consoleRunning = false;
+    // Stop scheduling pumps and let one that is still queued finish
+    m_shouldStopPump = true;
+    JobSystem::GetInstance().Wait(m_pumpJobs);
     
-    // Send shutdown message to console
-    if (m_stdInWrite) {
+    // Send shutdown message to console, flushing what the pump left behind
+    if (m_consoleRunning && m_stdInWrite) {
+        Log(L"Console pump stopped", L"INFO");
         Log(L"Shutting down external console connection...", L"INFO");
+        ProcessQueuedMessages();
     }
     
+    m_consoleRunning = false;
+    
     // Close pipe handles in correct order
     if (m_stdInWrite) {
         CloseHandle(m_stdInWrite);
@@ -321,11 +318,12 @@ void ConsoleProcessManager::Log(const std::wstring& message, const std::wstring&
     
     // Also try to send to external console if running
     if (m_consoleRunning && m_stdInWrite) {
-        // Queue log message for background thread to send
+        // Queue log message for the pump job to send
         {
             std::lock_guard<std::mutex> lock(m_messageMutex);
             m_messageQueue.push(formattedMessage);
         }
+        KickPump();
     }
 }
 
@@ -348,7 +346,10 @@ void ConsoleProcessManager::ProcessCommands() {
         return;
     }
     
-    // **NEW: Process commands from background thread queue (non-blocking)**
+    // Poll the pipe for new commands; they arrive in m_commandQueue next frame
+    KickPump();
+    
+    // Process commands read by the pump job (non-blocking)
     std::queue<std::string> commandsToProcess;
     {
         std::lock_guard<std::mutex> lock(m_commandMutex);
@@ -399,38 +400,41 @@ void ConsoleProcessManager::RegisterCommand(const std::string& name,
     }
 }
 
-// **NEW: Background thread main function**
-void ConsoleProcessManager::ConsoleThreadMain() {
-    OutputDebugStringW(L"Console management thread started\n");
-    
-    while (!m_shouldStopThread && m_consoleRunning) {
-        // Read commands from console (blocking operations are OK in background thread)
-        if (ReadFromConsole()) {
-            // Successfully read a command - continue immediately to check for more
-            continue;
-        }
-        
-        // Send queued log messages to console
-        ProcessQueuedMessages();
-        
-        // Check if console process is still alive
-        if (m_processHandle) {
-            DWORD exitCode;
-            if (GetExitCodeProcess(m_processHandle, &exitCode) && exitCode != STILL_ACTIVE) {
-                m_consoleRunning = false;
-                OutputDebugStringW(L"Console process has terminated\n");
-                break;
-            }
-        }
-        
-        // Short sleep to prevent excessive CPU usage
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+void ConsoleProcessManager::KickPump() {
+    if (m_shouldStopPump || !m_consoleRunning || m_pumpQueued.exchange(true)) {
+        return;
+    }
+    
+    // Low priority: pipe writes can block while the console is busy
+    JobSystem::GetInstance().Run([this]() { PumpConsole(); }, &m_pumpJobs, JobPriority::Low);
+}
+
+void ConsoleProcessManager::PumpConsole() {
+    // Cleared first so a Log() racing with this pass schedules another one
+    m_pumpQueued = false;
+    
+    if (m_shouldStopPump || !m_consoleRunning) {
+        return;
     }
     
-    OutputDebugStringW(L"Console management thread terminated\n");
+    // Read every command that has arrived
+    while (ReadFromConsole()) {
+    }
+    
+    // Send queued log messages to console
+    ProcessQueuedMessages();
+    
+    // Check if console process is still alive
+    if (m_processHandle) {
+        DWORD exitCode;
+        if (GetExitCodeProcess(m_processHandle, &exitCode) && exitCode != STILL_ACTIVE) {
+            m_consoleRunning = false;
+            OutputDebugStringW(L"Console process has terminated\n");
+        }
+    }
 }
 
-// **NEW: Process queued messages (runs in background thread)**
+// Process queued messages (runs in the pump job)
 void ConsoleProcessManager::ProcessQueuedMessages() {
     std::queue<std::wstring> messagesToSend;
     {
@@ -9,7 +9,7 @@
 #include <atomic>
 #include <mutex>
 #include <queue>
-#include <thread>
+#include "Core/JobSystem.h"
 
 namespace Spark {
 
@@ -22,7 +22,9 @@ class CommandRegistry;
  * redirecting log messages to it, and receiving commands from it.
  * Serves as a replacement for standard output logging.
  * 
- * **NEW: Now uses multithreading to prevent blocking the main engine loop**
+ * Pipe I/O never runs on the calling thread: Log() queues the message and
+ * schedules a pump job on the JobSystem, and ProcessCommands() schedules one
+ * every frame to pick up commands typed into the console.
  */
 class ConsoleProcessManager {
 public:
@@ -90,14 +92,16 @@ private:
     // Launch the console process
     bool LaunchConsoleProcess(const std::wstring& path);
     
-    // Read from console process (blocking - runs in background thread)
+    // Read from console process (runs in the pump job)
     bool ReadFromConsole();
     
-    // Write to console process (blocking - runs in background thread)
+    // Write to console process (runs in the pump job)
     bool WriteToConsole(const std::wstring& message);
     
-    // **NEW: Background thread methods**
-    void ConsoleThreadMain();
+    // Schedule a pump job unless one is already queued
+    void KickPump();
+    // One pump pass: read pending commands, flush queued messages, check the process
+    void PumpConsole();
     void ProcessQueuedMessages();
     
     // Process handles
@@ -117,9 +121,10 @@ private:
     std::atomic<bool> m_initialized{false};
     std::atomic<bool> m_consoleRunning{false};
     
-    // **NEW: Multithreading support**
-    std::thread m_consoleThread;
-    std::atomic<bool> m_shouldStopThread{false};
+    // Pump jobs on the JobSystem
+    JobCounter m_pumpJobs;
+    std::atomic<bool> m_pumpQueued{false};
+    std::atomic<bool> m_shouldStopPump{false};
     
     // Thread safety for message queue
     std::mutex m_messageMutex;
@@ -0,0 +1,76 @@
+/**
+ * @file FixedTimestep.cpp
+ * @brief Implementation of the fixed-rate simulation clock
+ * @author Spark Engine Team
+ * @date 2025
+ */
+
+#include "FixedTimestep.h"
+#include "Utils/Assert.h"
+#include <algorithm>
+#include <cmath>
+
+FixedTimestep::FixedTimestep(double tickRate, int maxStepsPerFrame)
+    : m_tickRate(DefaultTickRate)
+    , m_stepSize(1.0 / DefaultTickRate)
+    , m_maxStepsPerFrame(DefaultMaxStepsPerFrame)
+{
+    SetTickRate(tickRate);
+    SetMaxStepsPerFrame(maxStepsPerFrame);
+}
+
+void FixedTimestep::SetTickRate(double tickRate)
+{
+    ASSERT_MSG(std::isfinite(tickRate) && tickRate > 0.0, "Tick rate must be positive (got %f)", tickRate);
+    if (!std::isfinite(tickRate)) tickRate = DefaultTickRate;
+
+    // Keep the same fraction of a tick pending so interpolation does not jump
+    const double alpha = m_accumulator / m_stepSize;
+    m_tickRate = std::clamp(tickRate, MinTickRate, MaxTickRate);
+    m_stepSize = 1.0 / m_tickRate;
+    m_accumulator = alpha * m_stepSize;
+}
+
+void FixedTimestep::SetMaxStepsPerFrame(int maxSteps)
+{
+    ASSERT_MSG(maxSteps >= 1, "At least one step per frame is required (got %d)", maxSteps);
+    m_maxStepsPerFrame = std::max(maxSteps, 1);
+}
+
+void FixedTimestep::Reset()
+{
+    m_accumulator = 0.0;
+    m_tickCount = 0;
+    m_frameCount = 0;
+    m_clampedFrames = 0;
+    m_droppedTicks = 0;
+    m_lastFrameSteps = 0;
+}
+
+int FixedTimestep::BeginFrame(double frameSeconds)
+{
+    ++m_frameCount;
+    if (!std::isfinite(frameSeconds) || frameSeconds < 0.0) frameSeconds = 0.0;
+
+    m_accumulator += frameSeconds;
+    double due = std::floor(m_accumulator / m_stepSize);
+
+    // Spiral-of-death clamp: drop whole ticks beyond the budget, keep the fraction
+    if (due > static_cast<double>(m_maxStepsPerFrame))
+    {
+        const double dropped = due - static_cast<double>(m_maxStepsPerFrame);
+        m_accumulator -= dropped * m_stepSize;
+        m_droppedTicks += static_cast<uint64_t>(dropped);
+        ++m_clampedFrames;
+        due = static_cast<double>(m_maxStepsPerFrame);
+    }
+
+    const int steps = static_cast<int>(due);
+    m_accumulator = std::max(m_accumulator - due * m_stepSize, 0.0);
+
+    // Guard against the remainder rounding up to a full tick
+    if (m_accumulator >= m_stepSize) m_accumulator = std::nextafter(m_stepSize, 0.0);
+
+    m_lastFrameSteps = steps;
+    return steps;
+}
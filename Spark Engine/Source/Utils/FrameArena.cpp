@@ -0,0 +1,283 @@
+/**
+ * @file FrameArena.cpp
+ * @brief Implementation of the per-frame bump allocators
+ * @author Spark Engine Team
+ * @date 2025
+ */
+
+#include "FrameArena.h"
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+// ============================================================================
+// LINEAR ARENA
+// ============================================================================
+
+LinearArena::LinearArena(size_t initialCapacity)
+{
+    AddBlock(std::max<size_t>(initialCapacity, 1024));
+}
+
+void LinearArena::AddBlock(size_t minimumSize)
+{
+    Block block;
+    block.size = m_blocks.empty() ? minimumSize : std::max(minimumSize, m_blocks.back().size * 2);
+    block.memory = std::make_unique<std::byte[]>(block.size);
+    m_blocks.push_back(std::move(block));
+    ++m_blockAllocations;
+}
+
+void* LinearArena::Allocate(size_t size, size_t alignment)
+{
+    ASSERT_MSG(alignment != 0 && (alignment & (alignment - 1)) == 0, "Alignment %zu is not a power of two", alignment);
+    if (size == 0) size = 1;
+    ++m_allocations;
+
+    for (;;)
+    {
+        Block& block = m_blocks[m_current];
+        const uintptr_t base = reinterpret_cast<uintptr_t>(block.memory.get());
+        const uintptr_t aligned = (base + m_offset + alignment - 1) & ~(uintptr_t(alignment) - 1);
+        const size_t end = static_cast<size_t>(aligned - base) + size;
+        if (end <= block.size) {
+            m_offset = end;
+            m_peak = std::max(m_peak, GetUsed());
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        // Move on to the next block, adding one if this frame is the largest yet
+        m_usedInPreviousBlocks += m_offset;
+        m_offset = 0;
+        if (++m_current == m_blocks.size()) AddBlock(size + alignment);
+    }
+}
+
+void LinearArena::Reset()
+{
+    if (m_blocks.size() > 1) {
+        // Coalesce, so the next frame of the same size fits in one block
+        size_t total = 0;
+        for (const Block& block : m_blocks) total += block.size;
+        m_blocks.clear();
+        AddBlock(total);
+    }
+    m_current = 0;
+    m_offset = 0;
+    m_usedInPreviousBlocks = 0;
+}
+
+size_t LinearArena::GetCapacity() const
+{
+    size_t total = 0;
+    for (const Block& block : m_blocks) total += block.size;
+    return total;
+}
+
+// ============================================================================
+// FRAME ARENA
+// ============================================================================
+
+FrameArena::FrameArena(uint32_t bufferCount, size_t bytesPerThread)
+    : m_bufferCount(std::max(bufferCount, 1u))
+{
+    m_threadSlots = static_cast<uint32_t>(JobSystem::GetInstance().GetThreadCount()) + 1;
+    m_arenas.reserve(static_cast<size_t>(m_bufferCount) * m_threadSlots);
+    for (uint32_t i = 0; i < m_bufferCount * m_threadSlots; ++i)
+        m_arenas.push_back(std::make_unique<ThreadArena>(bytesPerThread));
+}
+
+FrameArena::~FrameArena() = default;
+
+FrameArena& FrameArena::GetFrame()
+{
+    // Leaked like the JobSystem: containers may still be released during static destruction
+    static FrameArena* arena = new FrameArena(1);
+    return *arena;
+}
+
+FrameArena& FrameArena::GetInFlight()
+{
+    static FrameArena* arena = new FrameArena(2);
+    return *arena;
+}
+
+void FrameArena::BeginFrame()
+{
+    ++m_frame;
+    m_currentBuffer = (m_currentBuffer + 1) % m_bufferCount;
+
+    std::lock_guard<std::mutex> lock(m_sharedMutex);
+    for (uint32_t slot = 0; slot < m_threadSlots; ++slot)
+        m_arenas[m_currentBuffer * m_threadSlots + slot]->arena.Reset();
+}
+
+FrameArena::ThreadArena& FrameArena::CurrentThreadArena(bool& shared)
+{
+    const int worker = JobSystem::GetInstance().GetCurrentWorker();
+    shared = worker < 0 || static_cast<uint32_t>(worker) + 1 >= m_threadSlots;
+    const uint32_t slot = shared ? m_threadSlots - 1 : static_cast<uint32_t>(worker);
+    return *m_arenas[m_currentBuffer * m_threadSlots + slot];
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment)
+{
+    bool shared = false;
+    ThreadArena& threadArena = CurrentThreadArena(shared);
+    if (!shared) return threadArena.arena.Allocate(size, alignment);
+
+    std::lock_guard<std::mutex> lock(m_sharedMutex);
+    return threadArena.arena.Allocate(size, alignment);
+}
+
+FrameArenaStats FrameArena::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_sharedMutex);
+
+    FrameArenaStats stats;
+    stats.frame = m_frame;
+    for (uint32_t i = 0; i < m_arenas.size(); ++i)
+    {
+        const LinearArena& arena = m_arenas[i]->arena;
+        if (i / m_threadSlots == m_currentBuffer) stats.usedBytes += arena.GetUsed();
+        stats.capacityBytes += arena.GetCapacity();
+        stats.peakBytes = std::max(stats.peakBytes, arena.GetPeak());
+        stats.allocations += arena.GetAllocationCount();
+        stats.blockAllocations += arena.GetBlockAllocations();
+    }
+    return stats;
+}
+
+// ============================================================================
+// CONSOLE INTEGRATION
+// ============================================================================
+
+std::string FrameArena::Console_GetStats() const
+{
+    const FrameArenaStats stats = GetStats();
+    std::stringstream ss;
+    ss << "frame " << stats.frame << ", " << m_bufferCount << " buffer(s) x " << m_threadSlots << " thread slots, used "
+       << stats.usedBytes << " B, capacity " << stats.capacityBytes << " B, peak/thread " << stats.peakBytes
+       << " B, allocations " << stats.allocations << ", heap blocks " << stats.blockAllocations;
+    return ss.str();
+}
+
+namespace
+{
+    std::atomic<uint64_t> g_benchHeapAllocations{ 0 };
+
+    /// std::allocator that counts its calls, standing in for the global heap
+    template<typename T>
+    struct CountingHeapAllocator
+    {
+        using value_type = T;
+        CountingHeapAllocator() = default;
+        template<typename U>
+        CountingHeapAllocator(const CountingHeapAllocator<U>&) noexcept {}
+
+        T* allocate(size_t count)
+        {
+            g_benchHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+            return std::allocator<T>().allocate(count);
+        }
+        void deallocate(T* pointer, size_t count) noexcept { std::allocator<T>().deallocate(pointer, count); }
+
+        template<typename U>
+        bool operator==(const CountingHeapAllocator<U>&) const noexcept { return true; }
+        template<typename U>
+        bool operator!=(const CountingHeapAllocator<U>&) const noexcept { return false; }
+    };
+
+    /**
+     * Stand-in for one frame of Game::Render and RenderScene: gather the
+     * renderable objects, cull them into a second list, name a few of them
+     * (long enough to defeat the small-string buffer) and let culling jobs
+     * keep per-chunk scratch lists.
+     */
+    template<template<typename> class Alloc, typename MakeAlloc>
+    size_t SimulateFrame(const std::vector<int>& objects, MakeAlloc makeAlloc)
+    {
+        using IntVector = std::vector<const int*, Alloc<const int*>>;
+        using String = std::basic_string<char, std::char_traits<char>, Alloc<char>>;
+
+        IntVector renderable(makeAlloc.template operator()<const int*>());
+        for (const int& object : objects)
+            if (object % 7 != 0) renderable.push_back(&object);
+
+        IntVector visible(makeAlloc.template operator()<const int*>());
+        for (const int* object : renderable)
+            if (*object % 3 != 0) visible.push_back(object);
+
+        size_t checksum = visible.size();
+        for (size_t i = 0; i < visible.size(); i += 64)
+        {
+            String label("render_object_with_a_long_name_", makeAlloc.template operator()<char>());
+            label += std::to_string(*visible[i]);
+            checksum += label.size();
+        }
+
+        std::atomic<size_t> chunkTotal{ 0 };
+        JobSystem::GetInstance().ParallelFor(static_cast<uint32_t>(visible.size()), 256,
+            [&](uint32_t begin, uint32_t end) {
+                IntVector scratch(makeAlloc.template operator()<const int*>());
+                for (uint32_t i = begin; i < end; ++i)
+                    if (*visible[i] & 1) scratch.push_back(visible[i]);
+                chunkTotal.fetch_add(scratch.size(), std::memory_order_relaxed);
+            });
+        return checksum + chunkTotal.load();
+    }
+}
+
+std::string FrameArena::Console_Benchmark(int frames)
+{
+    using Clock = std::chrono::high_resolution_clock;
+    frames = std::clamp(frames, 1, 100000);
+
+    std::vector<int> objects(5000);
+    for (size_t i = 0; i < objects.size(); ++i) objects[i] = static_cast<int>(i);
+
+    // Heap: every container allocates and frees through the counting allocator
+    g_benchHeapAllocations.store(0);
+    size_t heapChecksum = 0;
+    auto heapStart = Clock::now();
+    for (int frame = 0; frame < frames; ++frame)
+        heapChecksum += SimulateFrame<CountingHeapAllocator>(objects,
+            []<typename T>() { return CountingHeapAllocator<T>(); });
+    auto heapEnd = Clock::now();
+    const uint64_t heapAllocations = g_benchHeapAllocations.load();
+
+    // Arena: the only heap traffic is the arena growing its own blocks
+    FrameArena arena(1);
+    size_t arenaChecksum = 0;
+    uint64_t warmupBlocks = 0;
+    auto arenaStart = Clock::now();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        arena.BeginFrame();
+        arenaChecksum += SimulateFrame<FrameAllocator>(objects,
+            [&arena]<typename T>() { return FrameAllocator<T>(arena); });
+        if (frame == 0) warmupBlocks = arena.GetStats().blockAllocations;
+    }
+    auto arenaEnd = Clock::now();
+    const FrameArenaStats stats = arena.GetStats();
+
+    const double heapMs = std::chrono::duration<double, std::milli>(heapEnd - heapStart).count();
+    const double arenaMs = std::chrono::duration<double, std::milli>(arenaEnd - arenaStart).count();
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "=== Frame Arena Benchmark ===\n";
+    ss << frames << " frames of " << objects.size() << " objects, " << JobSystem::GetInstance().GetThreadCount()
+       << " job threads\n";
+    ss << "Heap:  " << heapMs / frames << " ms/frame, " << static_cast<double>(heapAllocations) / frames
+       << " heap allocations/frame\n";
+    ss << "Arena: " << arenaMs / frames << " ms/frame, " << static_cast<double>(stats.allocations) / frames
+       << " arena allocations/frame, " << stats.blockAllocations - warmupBlocks
+       << " heap allocations after the first frame (" << warmupBlocks << " during warm-up)\n";
+    ss << "Peak per thread: " << stats.peakBytes << " B, results " << (heapChecksum == arenaChecksum ? "match" : "DIFFER")
+       << "\n";
+    return ss.str();
+}
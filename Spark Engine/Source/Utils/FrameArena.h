@@ -0,0 +1,206 @@
+/**
+ * @file FrameArena.h
+ * @brief Per-frame bump allocators for transient render and update data
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * Render lists, culling output and similar scratch data live for exactly one
+ * frame. Allocating them from the heap every frame costs a lock in the
+ * allocator and fragments it; a FrameArena instead hands out memory by
+ * bumping a pointer and forgets everything at once when the frame begins.
+ *
+ * Every job worker gets its own arena, so allocating from jobs never
+ * contends. Threads outside the JobSystem share one locked arena. An arena
+ * created with two buffers alternates between them, so memory allocated in
+ * one frame stays valid until the end of the next (one frame in flight).
+ *
+ * FrameAllocator adapts an arena to the standard containers; FrameVector
+ * and FrameString are the usual aliases. deallocate() is a no-op, so reserve
+ * capacity up front where the size is known.
+ */
+
+#pragma once
+
+#include "Utils/Assert.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Single-threaded bump allocator over a list of blocks
+ *
+ * When a frame overflows the first block, more blocks are chained on; the
+ * next Reset() replaces them with one block large enough for the whole
+ * frame, so a steady workload stops touching the heap after one frame.
+ */
+class LinearArena
+{
+public:
+    explicit LinearArena(size_t initialCapacity);
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    void* Allocate(size_t size, size_t alignment);
+
+    /**
+     * @brief Forget every allocation
+     */
+    void Reset();
+
+    size_t GetUsed() const { return m_usedInPreviousBlocks + m_offset; }
+    size_t GetCapacity() const;
+    size_t GetPeak() const { return m_peak; }
+    uint64_t GetAllocationCount() const { return m_allocations; }
+    uint64_t GetBlockAllocations() const { return m_blockAllocations; }   ///< Heap allocations made by the arena itself
+
+private:
+    struct Block
+    {
+        std::unique_ptr<std::byte[]> memory;
+        size_t size = 0;
+    };
+
+    void AddBlock(size_t minimumSize);
+
+    std::vector<Block> m_blocks;
+    size_t m_current = 0;                   ///< Block being bumped
+    size_t m_offset = 0;                    ///< Bytes used in m_blocks[m_current]
+    size_t m_usedInPreviousBlocks = 0;
+    size_t m_peak = 0;
+    uint64_t m_allocations = 0;
+    uint64_t m_blockAllocations = 0;
+};
+
+/**
+ * @brief Frame arena statistics, summed over all threads
+ */
+struct FrameArenaStats
+{
+    uint64_t frame = 0;             ///< BeginFrame() calls so far
+    size_t usedBytes = 0;           ///< Allocated in the current buffer
+    size_t capacityBytes = 0;       ///< Reserved across all buffers and threads
+    size_t peakBytes = 0;           ///< Largest single-thread frame seen
+    uint64_t allocations = 0;       ///< Allocate() calls since creation
+    uint64_t blockAllocations = 0;  ///< Heap allocations made by the arenas themselves
+};
+
+/**
+ * @brief Thread-aware, optionally multi-buffered per-frame bump allocator
+ *
+ * BeginFrame() must be called from one thread while no other thread is
+ * allocating from or reading this arena's oldest buffer. Background jobs that
+ * outlive a frame (streaming, file I/O) must not allocate from it.
+ */
+class FrameArena
+{
+public:
+    static constexpr size_t DefaultBytesPerThread = 256 * 1024;
+
+    /**
+     * @param bufferCount 1 for memory valid until the next BeginFrame(), 2 for one frame in flight
+     * @param bytesPerThread Initial capacity of each thread's arena per buffer
+     */
+    explicit FrameArena(uint32_t bufferCount = 1, size_t bytesPerThread = DefaultBytesPerThread);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * @brief Engine-wide arena reset at every GraphicsEngine::BeginFrame()
+     */
+    static FrameArena& GetFrame();
+
+    /**
+     * @brief Engine-wide double-buffered arena: memory lives through the following frame
+     */
+    static FrameArena& GetInFlight();
+
+    /**
+     * @brief Start a new frame: switch to the next buffer and reset it
+     */
+    void BeginFrame();
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Uninitialised storage for count objects of type T
+     */
+    template<typename T>
+    T* AllocateArray(size_t count)
+    {
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    uint32_t GetBufferCount() const { return m_bufferCount; }
+    FrameArenaStats GetStats() const;
+
+    // ========================================================================
+    // CONSOLE INTEGRATION
+    // ========================================================================
+
+    std::string Console_GetStats() const;
+
+    /**
+     * @brief Build per-frame render lists with the heap and with a frame arena
+     *
+     * Counts heap allocations on both paths and times them.
+     * @param frames Simulated frames per path
+     */
+    static std::string Console_Benchmark(int frames);
+
+private:
+    struct alignas(64) ThreadArena
+    {
+        explicit ThreadArena(size_t capacity) : arena(capacity) {}
+        LinearArena arena;
+    };
+
+    ThreadArena& CurrentThreadArena(bool& shared);
+
+    uint32_t m_bufferCount = 1;
+    uint32_t m_threadSlots = 1;         ///< Job workers plus one shared slot for other threads
+    uint32_t m_currentBuffer = 0;
+    uint64_t m_frame = 0;
+    std::vector<std::unique_ptr<ThreadArena>> m_arenas;    ///< [buffer * m_threadSlots + slot]
+    mutable std::mutex m_sharedMutex;                     ///< Guards the shared slot
+};
+
+/**
+ * @brief Standard allocator drawing from a FrameArena; deallocation is a no-op
+ */
+template<typename T>
+class FrameAllocator
+{
+public:
+    using value_type = T;
+
+    /// Uses the engine-wide per-frame arena
+    FrameAllocator() noexcept : m_arena(&FrameArena::GetFrame()) {}
+    explicit FrameAllocator(FrameArena& arena) noexcept : m_arena(&arena) {}
+
+    template<typename U>
+    FrameAllocator(const FrameAllocator<U>& other) noexcept : m_arena(other.GetArena()) {}
+
+    T* allocate(size_t count) { return m_arena->AllocateArray<T>(count); }
+    void deallocate(T*, size_t) noexcept {}
+
+    FrameArena* GetArena() const noexcept { return m_arena; }
+
+    template<typename U>
+    bool operator==(const FrameAllocator<U>& other) const noexcept { return m_arena == other.GetArena(); }
+    template<typename U>
+    bool operator!=(const FrameAllocator<U>& other) const noexcept { return m_arena != other.GetArena(); }
+
+private:
+    FrameArena* m_arena;
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
@@ -0,0 +1,415 @@
+﻿// ObjectPool.cpp
+#include "ObjectPool.h"
+#include "ConcurrentObjectPool.h"
+#include <algorithm>
+#include <chrono>
+#include <queue>
+#include <random>
+#include <set>
+#include <sstream>
+#include <thread>
+
+// ============================================================================
+// THREAD SLOTS
+// ============================================================================
+
+namespace
+{
+    std::mutex g_threadSlotMutex;
+    uint64_t   g_threadSlotsInUse = 0;   ///< One bit per slot
+
+    static_assert(ObjectPoolDetail::MaxThreadSlots <= 64, "Thread slots are tracked in a 64-bit mask");
+
+    /// Claims a slot on a thread's first pool call and returns it when the thread exits
+    struct ThreadSlotOwner
+    {
+        uint32_t slot = ObjectPoolDetail::NoThreadSlot;
+
+        ThreadSlotOwner()
+        {
+            std::lock_guard<std::mutex> lock(g_threadSlotMutex);
+            for (uint32_t i = 0; i < ObjectPoolDetail::MaxThreadSlots; ++i)
+            {
+                if ((g_threadSlotsInUse & (1ull << i)) == 0)
+                {
+                    g_threadSlotsInUse |= 1ull << i;
+                    slot = i;
+                    break;
+                }
+            }
+        }
+
+        ~ThreadSlotOwner()
+        {
+            if (slot == ObjectPoolDetail::NoThreadSlot) return;
+            std::lock_guard<std::mutex> lock(g_threadSlotMutex);
+            g_threadSlotsInUse &= ~(1ull << slot);
+        }
+    };
+}
+
+uint32_t ObjectPoolDetail::CurrentThreadSlot()
+{
+    thread_local ThreadSlotOwner owner;
+    return owner.slot;
+}
+
+// ============================================================================
+// BENCHMARK
+// ============================================================================
+
+namespace
+{
+    /// Typical pooled payload: a few cache lines of state with a Reset()
+    struct BenchObject
+    {
+        float    data[24] = {};
+        uint32_t uses = 0;
+
+        void Reset() { data[0] = 0.0f; }
+    };
+
+    /**
+     * @brief The pool as it was before slabs: one heap object each, queue free list
+     *
+     * Kept here only as the baseline for BenchmarkObjectPools(). It has no
+     * locking of its own, so the contended run guards it with a mutex.
+     */
+    class QueueObjectPool
+    {
+    public:
+        explicit QueueObjectPool(size_t maxSize) : m_maxSize(maxSize) { m_objects.reserve(maxSize); }
+
+        BenchObject* Acquire()
+        {
+            if (m_available.empty())
+            {
+                if (m_objects.size() < m_maxSize)
+                {
+                    m_objects.push_back(std::make_unique<BenchObject>());
+                    return m_objects.back().get();
+                }
+                return nullptr;
+            }
+
+            BenchObject* obj = m_available.front();
+            m_available.pop();
+            return obj;
+        }
+
+        void Release(BenchObject* obj)
+        {
+            if (!obj) return;
+            obj->Reset();
+            m_available.push(obj);
+        }
+
+    private:
+        std::vector<std::unique_ptr<BenchObject>> m_objects;
+        std::queue<BenchObject*>                  m_available;
+        size_t                                    m_maxSize;
+    };
+
+    /// Shares a single-threaded pool between threads the only way it can be: one lock
+    template<typename Pool>
+    struct LockedPool
+    {
+        Pool       pool;
+        std::mutex mutex;
+
+        explicit LockedPool(size_t maxSize) : pool(maxSize) {}
+
+        BenchObject* Acquire() { std::lock_guard<std::mutex> lock(mutex); return pool.Acquire(); }
+        void Release(BenchObject* obj) { std::lock_guard<std::mutex> lock(mutex); pool.Release(obj); }
+    };
+
+    constexpr int WorkingSet = 16;   ///< Objects each thread holds before releasing them
+
+    /**
+     * @brief Run acquire/release churn on every thread and return nanoseconds per pair
+     *
+     * Each thread repeatedly acquires a working set, touches it and releases it
+     * in reverse order, like a system spawning and retiring effects per frame.
+     */
+    template<typename Pool>
+    double Churn(Pool& pool, int threads, int operations)
+    {
+        const int rounds = std::max(1, operations / WorkingSet);
+        auto body = [&pool, rounds]() {
+            BenchObject* held[WorkingSet];
+            for (int r = 0; r < rounds; ++r)
+            {
+                for (int i = 0; i < WorkingSet; ++i)
+                {
+                    held[i] = pool.Acquire();
+                    if (held[i]) held[i]->uses++;
+                }
+                for (int i = WorkingSet - 1; i >= 0; --i)
+                    pool.Release(held[i]);
+            }
+        };
+
+        auto start = std::chrono::high_resolution_clock::now();
+        if (threads == 1)
+        {
+            body();
+        }
+        else
+        {
+            std::vector<std::thread> workers;
+            workers.reserve(threads);
+            for (int t = 0; t < threads; ++t) workers.emplace_back(body);
+            for (std::thread& worker : workers) worker.join();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        const double pairs = static_cast<double>(rounds) * WorkingSet * threads;
+        return std::chrono::duration<double, std::nano>(end - start).count() / pairs;
+    }
+
+    /**
+     * @brief Cross-thread traffic: acquire here, release whatever another thread left
+     *
+     * Every thread acquires an object and swaps it into a random cell of a
+     * shared table, then releases the object it got back, which was almost
+     * always acquired by a different thread. Returns nanoseconds per pair.
+     */
+    template<typename Pool>
+    double Trade(Pool& pool, int threads, int operations, size_t tableSize)
+    {
+        std::vector<std::atomic<BenchObject*>> table(tableSize);
+        for (auto& cell : table) cell.store(nullptr, std::memory_order_relaxed);
+
+        auto body = [&pool, &table, operations](uint32_t seed) {
+            std::minstd_rand rng(seed);
+            for (int op = 0; op < operations; ++op)
+            {
+                BenchObject* obj = pool.Acquire();
+                if (obj) obj->uses++;
+                BenchObject* previous = table[rng() % table.size()].exchange(obj, std::memory_order_acq_rel);
+                pool.Release(previous);
+            }
+        };
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (int t = 0; t < threads; ++t) workers.emplace_back(body, static_cast<uint32_t>(t + 1));
+        for (std::thread& worker : workers) worker.join();
+        auto end = std::chrono::high_resolution_clock::now();
+
+        for (auto& cell : table) pool.Release(cell.exchange(nullptr));
+
+        return std::chrono::duration<double, std::nano>(end - start).count() / (static_cast<double>(operations) * threads);
+    }
+}
+
+std::string BenchmarkObjectPools(int threads, int operations)
+{
+    threads = std::clamp(threads, 1, 64);
+    operations = std::max(WorkingSet, operations);
+
+    std::ostringstream oss;
+    oss.setf(std::ios::fixed);
+    oss.precision(1);
+    oss << "=== OBJECT POOL BENCHMARK ===\n";
+    oss << operations << " acquire/release pairs per thread, working set " << WorkingSet << "\n";
+
+    for (int threadCount : { 1, threads })
+    {
+        const size_t capacity = static_cast<size_t>(threadCount) * WorkingSet * 2;
+
+        double queueNs = 0.0, slabNs = 0.0;
+        if (threadCount == 1)
+        {
+            QueueObjectPool queue(capacity);
+            queueNs = Churn(queue, 1, operations);
+            ObjectPool<BenchObject> slab(capacity);
+            slabNs = Churn(slab, 1, operations);
+        }
+        else
+        {
+            LockedPool<QueueObjectPool> queue(capacity);
+            queueNs = Churn(queue, threadCount, operations);
+            LockedPool<ObjectPool<BenchObject>> slab(capacity);
+            slabNs = Churn(slab, threadCount, operations);
+        }
+
+        ObjectPool<BenchObject> cached(capacity);
+        cached.SetThreadCaching(true);
+        const double cachedNs = Churn(cached, threadCount, operations);
+
+        ConcurrentObjectPool<BenchObject> lockFree(capacity);
+        const double lockFreeNs = Churn(lockFree, threadCount, operations);
+
+        oss << "\n" << threadCount << (threadCount == 1 ? " thread" : " threads") << " (ns per pair):\n";
+        const char* lock = threadCount == 1 ? "        " : " + mutex";
+        oss << "  Queue pool" << lock << "  " << queueNs << "\n";
+        oss << "  Slab pool" << lock << "   " << slabNs << "  (" << queueNs / slabNs << "x)\n";
+        oss << "  Slab + thread cache " << cachedNs << "  (" << queueNs / cachedNs << "x)\n";
+        oss << "  Lock-free pool      " << lockFreeNs << "  (" << queueNs / lockFreeNs << "x)\n";
+
+        if (threadCount == threads) break;
+    }
+
+    // Objects released on a different thread than the one that acquired them
+    {
+        const int tradeThreads = std::max(2, threads);
+        const size_t tableSize = static_cast<size_t>(tradeThreads) * WorkingSet;
+        const size_t capacity = tableSize + tradeThreads;
+
+        LockedPool<ObjectPool<BenchObject>> locked(capacity);
+        const double lockedNs = Trade(locked, tradeThreads, operations, tableSize);
+
+        ObjectPool<BenchObject> cached(capacity);
+        cached.SetThreadCaching(true);
+        const double cachedNs = Trade(cached, tradeThreads, operations, tableSize);
+
+        ConcurrentObjectPool<BenchObject> lockFree(capacity);
+        const double lockFreeNs = Trade(lockFree, tradeThreads, operations, tableSize);
+
+        oss << "\nCross-thread release, " << tradeThreads << " threads (ns per pair):\n";
+        oss << "  Slab pool + mutex   " << lockedNs << "\n";
+        oss << "  Slab + thread cache " << cachedNs << "  (" << lockedNs / cachedNs << "x)\n";
+        oss << "  Lock-free pool      " << lockFreeNs << "  (" << lockedNs / lockFreeNs << "x)\n";
+    }
+
+    // Stale handles must be rejected after release and reuse
+    ObjectPool<BenchObject> pool(4);
+    const ObjectPool<BenchObject>::Handle first = pool.AcquireHandle();
+    const BenchObject* firstObject = pool.Get(first);
+    pool.ReleaseHandle(first);
+    const ObjectPool<BenchObject>::Handle second = pool.AcquireHandle();
+    const bool staleRejected = !pool.IsValid(first) && pool.Get(first) == nullptr && !pool.ReleaseHandle(first);
+    const bool reuseValid = pool.IsValid(second) && pool.Get(second) == firstObject;
+    oss << "\nStale handle check: " << (staleRejected && reuseValid ? "PASS" : "FAIL") << "\n";
+
+    // Constructor callbacks build each object directly in its slot
+    ObjectPool<BenchObject> built(4, [](void* storage) { ::new (storage) BenchObject{ { 1.0f }, 7 }; });
+    BenchObject* builtObject = built.Acquire();
+    const bool constructedInPlace = built.GetTotalSize() == 4 && builtObject && builtObject->uses == 7 &&
+                                    builtObject->data[0] == 1.0f;
+    oss << "Constructor check: " << (constructedInPlace ? "PASS" : "FAIL") << "\n";
+
+    return oss.str();
+}
+
+// ============================================================================
+// STRESS TEST
+// ============================================================================
+
+namespace
+{
+    struct StressObject
+    {
+        std::atomic<uint32_t> owner{ 0 };   ///< Thread holding the object, 0 while pooled
+        uint32_t              payload = 0;  ///< Written by the owner, cleared by Reset()
+
+        void Reset() { payload = 0; }
+    };
+}
+
+std::string StressConcurrentObjectPool(int threads, int operations)
+{
+    threads = std::clamp(threads, 2, 64);
+    operations = std::max(1, operations);
+
+    using Pool = ConcurrentObjectPool<StressObject>;
+
+    // Fewer objects than table cells plus threads, so exhaustion is exercised too
+    const size_t tableSize = static_cast<size_t>(threads) * 8;
+    const size_t capacity = tableSize / 2;
+    Pool pool(capacity);
+
+    std::vector<std::atomic<Pool::Handle>> table(tableSize);
+    for (auto& cell : table) cell.store(Pool::InvalidHandle, std::memory_order_relaxed);
+
+    std::atomic<uint64_t> acquired{ 0 }, exhausted{ 0 }, doubleOwned{ 0 }, notReset{ 0 };
+    std::atomic<uint64_t> lostHandles{ 0 }, staleAccepted{ 0 };
+
+    auto body = [&](uint32_t thread) {
+        std::minstd_rand rng(thread * 7919u + 1);
+        uint64_t localAcquired = 0, localExhausted = 0;
+
+        for (int op = 0; op < operations; ++op)
+        {
+            const Pool::Handle handle = pool.AcquireHandle();
+            if (handle == Pool::InvalidHandle)
+            {
+                ++localExhausted;
+            }
+            else
+            {
+                ++localAcquired;
+                StressObject* obj = pool.Get(handle);
+                if (!obj || obj->owner.exchange(thread, std::memory_order_acq_rel) != 0) doubleOwned++;
+                if (obj && obj->payload != 0) notReset++;
+                if (obj) obj->payload = thread;
+            }
+
+            // Shake up the interleaving between acquire, hand-off and release
+            if ((rng() & 15) == 0) std::this_thread::yield();
+
+            const Pool::Handle previous = table[rng() % tableSize].exchange(handle, std::memory_order_acq_rel);
+            if (previous == Pool::InvalidHandle) continue;
+
+            StressObject* obj = pool.Get(previous);
+            if (!obj)
+            {
+                lostHandles++;
+                continue;
+            }
+            obj->owner.store(0, std::memory_order_release);
+            if (!pool.ReleaseHandle(previous)) lostHandles++;
+            if (pool.ReleaseHandle(previous)) staleAccepted++;
+        }
+
+        acquired += localAcquired;
+        exhausted += localExhausted;
+    };
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (int t = 0; t < threads; ++t) workers.emplace_back(body, static_cast<uint32_t>(t + 1));
+    for (std::thread& worker : workers) worker.join();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    for (auto& cell : table)
+    {
+        const Pool::Handle handle = cell.exchange(Pool::InvalidHandle);
+        if (StressObject* obj = pool.Get(handle))
+        {
+            obj->owner.store(0, std::memory_order_relaxed);
+            pool.ReleaseHandle(handle);
+        }
+    }
+
+    // Once idle, every object must be back and handed out exactly once more
+    const bool countsMatch = pool.GetUsedCount() == 0 && pool.GetAvailableCount() == pool.GetTotalSize();
+    std::set<StressObject*> distinct;
+    while (StressObject* obj = pool.Acquire()) distinct.insert(obj);
+    const bool drainOk = distinct.size() == capacity && pool.GetUsedCount() == capacity;
+
+    // Constructor callbacks build non-movable objects straight into their slots
+    int constructorCalls = 0;
+    Pool built(4, [&constructorCalls](void* storage) { ::new (storage) StressObject(); ++constructorCalls; });
+    const bool constructorOk = constructorCalls == 4 && built.GetAvailableCount() == 4 && built.Acquire() != nullptr;
+
+    const bool pass = countsMatch && drainOk && constructorOk && doubleOwned == 0 && notReset == 0 &&
+                      lostHandles == 0 && staleAccepted == 0;
+
+    std::ostringstream oss;
+    oss << "=== CONCURRENT POOL STRESS ===\n";
+    oss << threads << " threads x " << operations << " ops, " << capacity << " objects, "
+        << tableSize << " exchange cells\n";
+    oss << "Acquired: " << acquired.load() << ", exhausted: " << exhausted.load() << "\n";
+    oss << "Double owned: " << doubleOwned.load() << ", not reset: " << notReset.load()
+        << ", lost handles: " << lostHandles.load() << ", stale accepted: " << staleAccepted.load() << "\n";
+    oss << "Counts after join: " << (countsMatch ? "consistent" : "INCONSISTENT")
+        << ", drain: " << distinct.size() << "/" << capacity << "\n";
+    oss << "Constructor callback: " << (constructorOk ? "in place" : "FAILED") << "\n";
+    oss << "Time: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+    oss << "Result: " << (pass ? "PASS" : "FAIL") << "\n";
+    return oss.str();
+}
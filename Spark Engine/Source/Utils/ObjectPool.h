@@ -1,115 +1,562 @@
-﻿// ObjectPool.h
+﻿/**
+ * @file ObjectPool.h
+ * @brief Slab-backed object pool with generational handles and per-thread caches
+ * @author Spark Engine Team
+ * @date 2025
+ *
+ * Objects live in fixed-size slabs of contiguous slots that are never moved
+ * or freed until the pool is cleared, so pointers stay valid and neighbouring
+ * objects share cache lines. Free slots sit on a stack of slot pointers sized
+ * for the whole pool, so acquire and release are an index bump with no
+ * dependent load through the freed object.
+ *
+ * Every slot carries a generation counter that is bumped on release. A
+ * 32-bit Handle packs the slot index with the generation it was issued at, so
+ * code holding on to an object across frames can detect that it was released
+ * (and possibly reused) with a single compare.
+ *
+ * By default the pool is single-threaded, like the queue-based pool it
+ * replaced, and that path is small enough to inline at the call site; the
+ * thread-cache and construction paths are kept out of line. Enabling thread
+ * caching makes it safe to share: each thread owns a small magazine of free
+ * slots and only takes the shared lock to refill or drain it in batches.
+ */
+
 #pragma once
 
 #include "Utils/Assert.h"
-#include <vector>
-#include <queue>
-#include <memory>
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
 
+// Keeps the thread-cache and construction paths out of the inlined fast path
+#ifdef _MSC_VER
+#  define OBJECT_POOL_NOINLINE __declspec(noinline)
+#else
+#  define OBJECT_POOL_NOINLINE __attribute__((noinline))
+#endif
+
+namespace ObjectPoolDetail
+{
+    constexpr uint32_t MaxThreadSlots = 64;
+    constexpr uint32_t NoThreadSlot = 0xFFFFFFFFu;
+
+    /**
+     * @brief Small ID of the calling thread, unique among live threads
+     *
+     * IDs are returned when a thread exits and handed to the next new thread.
+     * @return A value below MaxThreadSlots, or NoThreadSlot if all are taken
+     */
+    uint32_t CurrentThreadSlot();
+}
+
+/**
+ * @brief Fixed-capacity pool of reusable T objects
+ *
+ * Objects are constructed lazily on first Acquire() (through the constructor
+ * callback if one is set, otherwise with T's default constructor) and are kept
+ * alive between uses. Release() calls T::Reset() when the type provides one.
+ *
+ * Without thread caching the pool must only be used from one thread at a
+ * time. With it, Acquire(), Release() and the handle functions may be called
+ * from any thread; Clear(), PreAllocate(), SetThreadCaching() and iteration
+ * must still not overlap with any other call.
+ *
+ * @note Statistics are exact when the pool is idle and approximate while
+ *       other threads are acquiring and releasing.
+ */
 template<typename T>
 class ObjectPool
 {
-private:
-    std::vector<std::unique_ptr<T>>        m_objects;
-    std::queue<T*>                         m_available;
-    std::function<std::unique_ptr<T>()>    m_factory;
-    size_t                                 m_maxSize;
-
 public:
+    /// Slot index in the low bits, generation in the high bits; 0 is never issued
+    using Handle = uint32_t;
+
+    static constexpr uint32_t IndexBits      = 20;
+    static constexpr uint32_t GenerationBits = 32 - IndexBits;
+    static constexpr uint32_t MaxObjects     = 1u << IndexBits;
+    static constexpr Handle   InvalidHandle  = 0;
+
+    static constexpr uint32_t SlabSize       = 64;   ///< Slots per slab
+    static constexpr uint32_t MagazineSize   = 32;   ///< Free slots cached per thread
+    static constexpr uint32_t MaxMagazines   = ObjectPoolDetail::MaxThreadSlots;   ///< Further threads use the shared list
+
+    /**
+     * @brief Constructs one T in place at the given slot storage
+     *
+     * Storage is sized and aligned for exactly T, so the callback must
+     * placement-new a T itself, never a type derived from it.
+     */
+    using Constructor = std::function<void(void* storage)>;
+
     explicit ObjectPool(size_t maxSize = 100)
         : m_maxSize(maxSize)
     {
-        ASSERT_MSG(maxSize > 0, "ObjectPool maxSize must be positive");
-        m_objects.reserve(maxSize);
+        ASSERT_MSG(maxSize > 0, "ObjectPool maxSize must be positive (got %zu)", maxSize);
+        ASSERT_MSG(maxSize <= MaxObjects, "ObjectPool maxSize %zu exceeds handle range", maxSize);
+        m_slabs.reserve(SlabCountFor(maxSize));
+        m_freeStack = std::make_unique<Slot*[]>(maxSize);
     }
 
-    ObjectPool(size_t maxSize, std::function<std::unique_ptr<T>()> factory)
-        : m_maxSize(maxSize)
-        , m_factory(factory)
+    ObjectPool(size_t maxSize, Constructor constructor)
+        : ObjectPool(maxSize)
     {
-        ASSERT_MSG(maxSize > 0, "ObjectPool maxSize must be positive");
-        ASSERT_MSG(factory != nullptr, "ObjectPool factory must not be null");
-        m_objects.reserve(maxSize);
-
-        // Pre-allocate objects
-        for (size_t i = 0; i < maxSize; ++i)
-        {
-            auto obj = m_factory();
-            ASSERT_MSG(obj != nullptr, "Factory returned null object");
-            m_available.push(obj.get());
-            m_objects.push_back(std::move(obj));
-        }
+        ASSERT_MSG(constructor != nullptr, "ObjectPool constructor must not be null (maxSize %zu)", maxSize);
+        PreAllocate(maxSize, std::move(constructor));
     }
 
-    ~ObjectPool() = default;
+    ~ObjectPool() { Clear(); }
 
-    // Acquire an object from the pool
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // ========================================================================
+    // ACQUIRE / RELEASE
+    // ========================================================================
+
+    /**
+     * @brief Take an object from the pool
+     * @return nullptr when all maxSize objects are in use
+     */
     T* Acquire()
     {
-        if (m_available.empty())
-        {
-            if (m_objects.size() < m_maxSize && m_factory)
-            {
-                auto obj = m_factory();
-                ASSERT_MSG(obj != nullptr, "Factory returned null object");
-                T* ptr = obj.get();
-                m_objects.push_back(std::move(obj));
-                return ptr;
-            }
-            return nullptr; // Pool exhausted
-        }
-
-        T* obj = m_available.front();
-        m_available.pop();
-        ASSERT_NOT_NULL(obj);
-        return obj;
+        Slot* slot = AcquireSlot();
+        return slot ? ObjectOf(*slot) : nullptr;
     }
 
-    // Return an object to the pool
+    /**
+     * @brief Return an object to the pool, calling Reset() on it if available
+     */
     void Release(T* obj)
     {
         if (!obj) return;
+
+        Slot& slot = SlotOf(obj);
+        const uint32_t state = slot.state.load(std::memory_order_relaxed);
+        ASSERT_MSG(slot.index < m_constructed.load(std::memory_order_relaxed) && &SlotAt(slot.index) == &slot,
+                   "ObjectPool::Release given an object from another pool (slot %u)", slot.index);
+        ASSERT_MSG((state & InUseBit) != 0, "ObjectPool slot %u released twice", slot.index);
+
         // Reset object if it supports Reset()
         if constexpr (requires { obj->Reset(); })
         {
             obj->Reset();
         }
-        m_available.push(obj);
+
+        // Retire the generation before the slot becomes visible to other threads
+        slot.state.store(NextGeneration(state >> 1) << 1, std::memory_order_release);
+        PushFree(&slot);
+    }
+
+    // ========================================================================
+    // GENERATIONAL HANDLES
+    // ========================================================================
+
+    /**
+     * @brief Acquire an object and return a handle to it instead of a pointer
+     * @return InvalidHandle when the pool is exhausted
+     */
+    Handle AcquireHandle()
+    {
+        Slot* slot = AcquireSlot();
+        return slot ? MakeHandle(slot->index, slot->state.load(std::memory_order_relaxed) >> 1) : InvalidHandle;
+    }
+
+    /**
+     * @brief Handle for an object currently acquired from this pool
+     */
+    Handle GetHandle(const T* obj) const
+    {
+        if (!obj) return InvalidHandle;
+        const Slot& slot = SlotOf(obj);
+        const uint32_t state = slot.state.load(std::memory_order_acquire);
+        return (state & InUseBit) ? MakeHandle(slot.index, state >> 1) : InvalidHandle;
+    }
+
+    /**
+     * @brief Resolve a handle
+     * @return The object, or nullptr if it was released since the handle was issued
+     */
+    T* Get(Handle handle) const
+    {
+        return IsValid(handle) ? ObjectAt(handle & IndexMask) : nullptr;
     }
 
+    /**
+     * @brief Check that a handle still refers to the object it was issued for
+     */
+    bool IsValid(Handle handle) const
+    {
+        const uint32_t index = handle & IndexMask;
+        if (handle == InvalidHandle || index >= m_constructed.load(std::memory_order_acquire)) return false;
+        return SlotAt(index).state.load(std::memory_order_acquire) == (((handle >> IndexBits) << 1) | InUseBit);
+    }
+
+    /**
+     * @brief Release the object behind a handle
+     * @return false if the handle was stale, in which case nothing is released
+     */
+    bool ReleaseHandle(Handle handle)
+    {
+        T* obj = Get(handle);
+        if (!obj) return false;
+        Release(obj);
+        return true;
+    }
+
+    // ========================================================================
+    // THREAD CACHING
+    // ========================================================================
+
+    /**
+     * @brief Enable or disable per-thread magazines of free slots
+     *
+     * Required when several threads acquire and release concurrently; a pool
+     * used from one thread is faster without. Disabling returns every cached
+     * slot to the shared free list.
+     */
+    void SetThreadCaching(bool enable)
+    {
+        if (enable == (m_magazines != nullptr)) return;
+
+        if (enable)
+        {
+            m_magazines = std::make_unique<Magazine[]>(MaxMagazines);
+            return;
+        }
+
+        FlushMagazines();
+        m_magazines.reset();
+    }
+
+    bool IsThreadCaching() const { return m_magazines != nullptr; }
+
     // Stats
-    size_t GetTotalSize()      const { return m_objects.size(); }
-    size_t GetAvailableCount() const { return m_available.size(); }
-    size_t GetUsedCount()      const { return m_objects.size() - m_available.size(); }
+    size_t GetTotalSize()      const { return m_constructed.load(std::memory_order_relaxed); }
+    size_t GetAvailableCount() const
+    {
+        size_t available = m_freeCount.load(std::memory_order_relaxed);
+        if (m_magazines)
+        {
+            for (uint32_t i = 0; i < MaxMagazines; ++i)
+                available += m_magazines[i].count.load(std::memory_order_relaxed);
+        }
+        return available;
+    }
+    size_t GetUsedCount()      const { return GetTotalSize() - GetAvailableCount(); }
     size_t GetMaxSize()        const { return m_maxSize; }
+    size_t GetSlabCount()      const { return m_slabs.size(); }
 
-    // Clear all objects
+    /**
+     * @brief Destroy every object and free the slabs
+     *
+     * Every handle issued so far becomes invalid; outstanding pointers dangle.
+     */
     void Clear()
     {
-        m_objects.clear();
-        std::queue<T*> empty;
-        std::swap(m_available, empty);
+        const uint32_t constructed = m_constructed.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < constructed; ++i)
+            ObjectAt(i)->~T();
+
+        m_slabs.clear();
+        m_constructed.store(0, std::memory_order_relaxed);
+        m_freeCount.store(0, std::memory_order_relaxed);
+
+        if (m_magazines)
+        {
+            for (uint32_t i = 0; i < MaxMagazines; ++i)
+                m_magazines[i].count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Construct objects up front with a constructor callback
+     *
+     * The callback also constructs any objects created later by Acquire().
+     */
+    void PreAllocate(size_t count, Constructor constructor)
+    {
+        ASSERT_MSG(constructor != nullptr, "PreAllocate constructor must not be null (count %zu)", count);
+        m_constructor = std::move(constructor);
+
+        for (size_t i = 0; i < count && m_constructed.load(std::memory_order_relaxed) < m_maxSize; ++i)
+            PushShared(&Construct());
+    }
+
+    // ========================================================================
+    // ITERATION
+    // ========================================================================
+
+    /**
+     * @brief Forward iterator over every constructed object, used or free
+     */
+    template<typename Pool, typename Value>
+    class BasicIterator
+    {
+    public:
+        BasicIterator(Pool* pool, uint32_t index) : m_pool(pool), m_index(index) {}
+
+        Value& operator*() const { return *m_pool->ObjectAt(m_index); }
+        Value* operator->() const { return m_pool->ObjectAt(m_index); }
+        BasicIterator& operator++() { ++m_index; return *this; }
+        bool operator==(const BasicIterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const BasicIterator& other) const { return m_index != other.m_index; }
+
+    private:
+        Pool*    m_pool;
+        uint32_t m_index;
+    };
+
+    using Iterator      = BasicIterator<ObjectPool, T>;
+    using ConstIterator = BasicIterator<const ObjectPool, const T>;
+
+    // Iterators over all objects
+    Iterator      begin()       { return Iterator(this, 0); }
+    Iterator      end()         { return Iterator(this, m_constructed.load(std::memory_order_relaxed)); }
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+    ConstIterator end()   const { return ConstIterator(this, m_constructed.load(std::memory_order_relaxed)); }
+
+private:
+    static constexpr uint32_t IndexMask      = (1u << IndexBits) - 1;
+    static constexpr uint32_t GenerationMask = (1u << GenerationBits) - 1;
+    static constexpr uint32_t InUseBit       = 1;
+
+    /**
+     * @brief Object storage plus its index and generation
+     *
+     * The object comes first so a T* converts straight back to its slot.
+     */
+    struct Slot
+    {
+        alignas(T) unsigned char storage[sizeof(T)];
+        uint32_t              index = 0;           ///< Position in the pool, fixed at construction
+        std::atomic<uint32_t> state{ 0 };          ///< (generation << 1) | in-use
+    };
+
+    /**
+     * @brief Stack of free slots owned by one thread slot
+     *
+     * Only the owning thread touches the slots; count is atomic so statistics can
+     * be read from elsewhere.
+     */
+    struct alignas(64) Magazine
+    {
+        std::atomic<uint32_t> count{ 0 };
+        Slot*                 items[MagazineSize];
+    };
+
+    static size_t SlabCountFor(size_t objects) { return (objects + SlabSize - 1) / SlabSize; }
+
+    static Handle MakeHandle(uint32_t index, uint32_t generation) { return (generation << IndexBits) | index; }
+
+    /// Generations run 1..GenerationMask so a handle is never 0
+    static uint32_t NextGeneration(uint32_t generation) { return generation >= GenerationMask ? 1 : generation + 1; }
+
+    Slot&       SlotAt(uint32_t index)       { return m_slabs[index / SlabSize][index % SlabSize]; }
+    const Slot& SlotAt(uint32_t index) const { return m_slabs[index / SlabSize][index % SlabSize]; }
+
+    static T* ObjectOf(const Slot& slot)
+    {
+        return std::launder(reinterpret_cast<T*>(const_cast<unsigned char*>(slot.storage)));
+    }
+
+    T* ObjectAt(uint32_t index) const { return ObjectOf(SlotAt(index)); }
+
+    static Slot&       SlotOf(T* obj)       { return *reinterpret_cast<Slot*>(obj); }
+    static const Slot& SlotOf(const T* obj) { return *reinterpret_cast<const Slot*>(obj); }
+
+    Slot* AcquireSlot()
+    {
+        // Single-threaded pool with a free slot: kept small so it inlines into Acquire()
+        const uint32_t count = m_freeCount.load(std::memory_order_relaxed);
+        if (!m_magazines && count != 0)
+        {
+            Slot* slot = m_freeStack[count - 1];
+            m_freeCount.store(count - 1, std::memory_order_relaxed);
+            slot->state.store(slot->state.load(std::memory_order_relaxed) | InUseBit, std::memory_order_release);
+            return slot;
+        }
+        return AcquireSlotSlow();
+    }
+
+    /// Acquire through the thread caches, or construct a new object
+    OBJECT_POOL_NOINLINE Slot* AcquireSlotSlow()
+    {
+        Slot* slot = nullptr;
+
+        if (!m_magazines)
+        {
+            slot = PopShared();
+        }
+        else if (const uint32_t thread = ObjectPoolDetail::CurrentThreadSlot(); thread != ObjectPoolDetail::NoThreadSlot)
+        {
+            slot = PopMagazine(m_magazines[thread]);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            slot = PopShared();
+        }
+
+        if (slot)
+            slot->state.store(slot->state.load(std::memory_order_relaxed) | InUseBit, std::memory_order_release);
+        return slot;
     }
 
-    // Pre-allocate with factory
-    void PreAllocate(size_t count, std::function<std::unique_ptr<T>()> factory)
+    void PushFree(Slot* slot)
     {
-        ASSERT_MSG(factory != nullptr, "PreAllocate factory must not be null");
-        m_factory = factory;
+        if (!m_magazines)
+        {
+            PushShared(slot);
+        }
+        else
+        {
+            PushFreeCached(slot);
+        }
+    }
 
-        for (size_t i = 0; i < count && m_objects.size() < m_maxSize; ++i)
+    /// Release into the calling thread's magazine, or the shared list if it has none
+    OBJECT_POOL_NOINLINE void PushFreeCached(Slot* slot)
+    {
+        if (const uint32_t thread = ObjectPoolDetail::CurrentThreadSlot(); thread != ObjectPoolDetail::NoThreadSlot)
+        {
+            PushMagazine(m_magazines[thread], slot);
+        }
+        else
         {
-            auto obj = m_factory();
-            ASSERT_MSG(obj != nullptr, "Factory returned null object");
-            m_available.push(obj.get());
-            m_objects.push_back(std::move(obj));
+            std::lock_guard<std::mutex> lock(m_mutex);
+            PushShared(slot);
         }
     }
 
-    // Iterators over all objects
-    auto begin() { return m_objects.begin(); }
-    auto end() { return m_objects.end(); }
-    auto begin() const { return m_objects.begin(); }
-    auto end()   const { return m_objects.end(); }
+    /// Pop from a magazine, refilling half of it from the shared list when empty
+    Slot* PopMagazine(Magazine& magazine)
+    {
+        uint32_t count = magazine.count.load(std::memory_order_relaxed);
+        if (count == 0)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            while (count < MagazineSize / 2)
+            {
+                Slot* slot = PopShared();
+                if (!slot) break;
+                magazine.items[count++] = slot;
+            }
+            if (count == 0) return nullptr;
+        }
+
+        magazine.count.store(count - 1, std::memory_order_relaxed);
+        return magazine.items[count - 1];
+    }
+
+    /// Push to a magazine, draining half of it to the shared list when full
+    void PushMagazine(Magazine& magazine, Slot* slot)
+    {
+        uint32_t count = magazine.count.load(std::memory_order_relaxed);
+        if (count == MagazineSize)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            while (count > MagazineSize / 2)
+                PushShared(magazine.items[--count]);
+        }
+
+        magazine.items[count] = slot;
+        magazine.count.store(count + 1, std::memory_order_relaxed);
+    }
+
+    void FlushMagazines()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (uint32_t i = 0; i < MaxMagazines; ++i)
+        {
+            Magazine& magazine = m_magazines[i];
+            const uint32_t count = magazine.count.load(std::memory_order_relaxed);
+            for (uint32_t j = 0; j < count; ++j)
+                PushShared(magazine.items[j]);
+            magazine.count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // The shared free list: callers hold m_mutex whenever thread caching is on
+
+    void PushShared(Slot* slot)
+    {
+        const uint32_t count = m_freeCount.load(std::memory_order_relaxed);
+        m_freeStack[count] = slot;
+        m_freeCount.store(count + 1, std::memory_order_relaxed);
+    }
+
+    /// Pop the top free slot, constructing a new object if the list is empty
+    Slot* PopShared()
+    {
+        const uint32_t count = m_freeCount.load(std::memory_order_relaxed);
+        if (count == 0)
+            return m_constructed.load(std::memory_order_relaxed) < m_maxSize ? &Construct() : nullptr;
+
+        m_freeCount.store(count - 1, std::memory_order_relaxed);
+        return m_freeStack[count - 1];
+    }
+
+    /// Construct the next object, allocating a slab when the last one is full
+    Slot& Construct()
+    {
+        const uint32_t index = m_constructed.load(std::memory_order_relaxed);
+        if (index % SlabSize == 0)
+            m_slabs.push_back(std::make_unique<Slot[]>(SlabSize));
+
+        Slot& slot = SlotAt(index);
+        if (m_constructor)
+        {
+            m_constructor(static_cast<void*>(slot.storage));
+        }
+        else if constexpr (std::is_default_constructible_v<T>)
+        {
+            ::new (static_cast<void*>(slot.storage)) T();
+        }
+        else
+        {
+            ASSERT_ALWAYS_MSG(false, "ObjectPool needs a constructor for types without a default constructor (slot %u)", index);
+        }
+
+        slot.index = index;
+        slot.state.store(1u << 1, std::memory_order_relaxed);
+
+        // Publish the slot to IsValid() callers on other threads
+        m_constructed.store(index + 1, std::memory_order_release);
+        return slot;
+    }
+
+    std::vector<std::unique_ptr<Slot[]>>   m_slabs;          ///< Reserved up front so slab pointers never move
+    Constructor                            m_constructor;
+    size_t                                 m_maxSize;
+
+    std::mutex                             m_mutex;          ///< Guards the shared free list while thread caching is on
+    std::unique_ptr<Slot*[]>               m_freeStack;
+    std::atomic<uint32_t>                  m_freeCount{ 0 };
+    std::atomic<uint32_t>                  m_constructed{ 0 };
+    std::unique_ptr<Magazine[]>            m_magazines;      ///< Null unless thread caching is on
 };
+
+// ============================================================================
+// CONSOLE INTEGRATION
+// ============================================================================
+
+/**
+ * @brief Compare the slab pool against the previous queue-based pool
+ *
+ * Runs an acquire/release churn at one thread and at the requested thread
+ * count, for the slab pool with and without thread caching, the lock-free
+ * ConcurrentObjectPool and the old design (one heap allocation per object,
+ * std::queue free list, guarded by a mutex when shared between threads),
+ * then a cross-thread run where objects are released by other threads.
+ *
+ * @param threads Worker threads for the contended run
+ * @param operations Acquire/release pairs per thread
+ */
+std::string BenchmarkObjectPools(int threads, int operations);
@@ -59,10 +59,11 @@ void Timer::UpdateTime()
     ASSERT_MSG(diff.count() >= 0.0f, "Time difference must be non-negative");
     m_deltaTime = diff.count();
 
-    // Cap delta time to prevent large jumps
-    if (m_deltaTime > 0.05f)
+    // Cap delta time to prevent large jumps; the game's fixed-step clock
+    // limits catch-up ticks itself, so only real stalls are clipped here
+    if (m_deltaTime > 0.25f)
     {
-        m_deltaTime = 0.05f;
+        m_deltaTime = 0.25f;
     }
 
     m_lastTime += std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(diff);